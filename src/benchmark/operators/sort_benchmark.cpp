@@ -7,6 +7,8 @@
 #include "operators/limit.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/immediate_execution_scheduler.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_translator.hpp"
 #include "synthetic_table_generator.hpp"
@@ -16,16 +18,13 @@
 namespace opossum {
 
 static std::shared_ptr<Table> generate_custom_table(const size_t row_count, const DataType data_type = DataType::Int,
-                                                    const float null_ratio = 0.0f) {
+                                                    const float null_ratio = 0.0f, const size_t column_count = 2) {
   const auto table_generator = std::make_shared<SyntheticTableGenerator>();
 
-  constexpr auto NUM_COLUMNS = 2;
   constexpr auto LARGEST_VALUE = 10'000;
 
-  const std::vector<DataType> column_data_types = {NUM_COLUMNS, data_type};
-
   std::vector<ColumnSpecification> column_specifications = std::vector(
-      NUM_COLUMNS, ColumnSpecification(ColumnDataDistribution::make_uniform_config(0.0, LARGEST_VALUE), data_type,
+      column_count, ColumnSpecification(ColumnDataDistribution::make_uniform_config(0.0, LARGEST_VALUE), data_type,
                                        SegmentEncodingSpec{EncodingType::Unencoded}, std::nullopt, null_ratio));
 
   return table_generator->generate_table(column_specifications, row_count);
@@ -89,11 +88,42 @@ static void BM_SortWithStrings(benchmark::State& state) {
   BM_Sort(state, row_count, DataType::String);
 }
 
+// Sorts by the first column_count columns with alternating sort modes. As the normalized keys are sorted in parallel,
+// the benchmark uses the NodeQueueScheduler.
+static void BM_SortMultipleColumns(benchmark::State& state) {
+  micro_benchmark_clear_cache();
+
+  const size_t row_count = state.range(0);
+  const size_t column_count = state.range(1);
+
+  const auto input_table = generate_custom_table(row_count, DataType::Int, 0.0f, column_count);
+  const auto input_operator = std::make_shared<TableWrapper>(input_table);
+  input_operator->execute();
+
+  auto sort_definitions = std::vector<SortColumnDefinition>{};
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto sort_mode = column_id % 2 == 0 ? SortMode::Ascending : SortMode::Descending;
+    sort_definitions.emplace_back(column_id, sort_mode);
+  }
+
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+  for (auto _ : state) {
+    auto sort = std::make_shared<Sort>(input_operator, sort_definitions);
+    sort->execute();
+  }
+  Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
+}
+
 BENCHMARK(BM_Sort)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortTwoColumns)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithNullValues)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithReferenceSegments)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithReferenceSegmentsTwoColumns)->RangeMultiplier(100)->Range(100, 1'000'000);
 BENCHMARK(BM_SortWithStrings)->RangeMultiplier(100)->Range(100, 1'000'000);
+BENCHMARK(BM_SortMultipleColumns)
+    ->Args({100'000'000, 1})
+    ->Args({100'000'000, 3})
+    ->Args({100'000'000, 5})
+    ->Unit(benchmark::kMillisecond);
 
 }  // namespace opossum
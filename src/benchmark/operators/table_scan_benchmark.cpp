@@ -1,10 +1,13 @@
 #include <memory>
+#include <random>
 
 #include "../micro_benchmark_basic_fixture.hpp"
 #include "benchmark/benchmark.h"
 #include "expression/expression_functional.hpp"
+#include "micro_benchmark_utils.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/load_table.hpp"
 
@@ -12,6 +15,32 @@ using namespace opossum::expression_functional;  // NOLINT
 
 namespace opossum {
 
+namespace {
+
+// Creates a nullable int column with 1'000 distinct values (i.e., 10-bit value IDs), which is dictionary-encoded using
+// the given vector compression.
+std::shared_ptr<TableWrapper> create_dictionary_table(const VectorCompressionType vector_compression_type) {
+  constexpr auto ROW_COUNT = 10'000'000;
+
+  const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}};
+  const auto table = std::make_shared<Table>(column_definitions, TableType::Data, Chunk::DEFAULT_SIZE);
+
+  auto generator = std::mt19937{42};
+  auto distribution = std::uniform_int_distribution<int32_t>{0, 999};
+  for (auto row = 0; row < ROW_COUNT; ++row) {
+    table->append({row % 100 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{distribution(generator)}});
+  }
+  table->last_chunk()->finalize();
+
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::Dictionary, vector_compression_type});
+
+  auto table_wrapper = std::make_shared<TableWrapper>(table);
+  table_wrapper->execute();
+  return table_wrapper;
+}
+
+}  // namespace
+
 void benchmark_tablescan_impl(benchmark::State& state, const std::shared_ptr<const AbstractOperator> in,
                               ColumnID left_column_id, const PredicateCondition predicate_condition,
                               const AllParameterVariant right_parameter) {
@@ -83,4 +112,45 @@ BENCHMARK_F(MicroBenchmarkBasicFixture, BM_TableScan_Like)(benchmark::State& sta
   }
 }
 
+// Compares dictionary scans for the different vector compressions of the attribute vector. Scans on bit-packed value
+// IDs evaluate the predicates on the packed data (see BitPackingVector::match_range).
+void BM_TableScanDictionaryVectorCompression(benchmark::State& state,
+                                             const VectorCompressionType vector_compression_type,
+                                             const PredicateCondition predicate_condition) {
+  micro_benchmark_clear_cache();
+  const auto table_wrapper = create_dictionary_table(vector_compression_type);
+  const auto column = pqp_column_(ColumnID{0}, DataType::Int, true, "a");
+
+  auto predicate = std::shared_ptr<AbstractExpression>{};
+  if (is_between_predicate_condition(predicate_condition)) {
+    predicate = between_inclusive_(column, value_(250), value_(499));
+  } else {
+    predicate = std::make_shared<BinaryPredicateExpression>(predicate_condition, column, value_(500));
+  }
+
+  for (auto _ : state) {
+    auto table_scan = std::make_shared<TableScan>(table_wrapper, predicate);
+    table_scan->execute();
+  }
+}
+
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, FixedSizeByteAligned_Equals,
+                  VectorCompressionType::FixedSizeByteAligned, PredicateCondition::Equals);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, SimdBp128_Equals, VectorCompressionType::SimdBp128,
+                  PredicateCondition::Equals);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, BitPacking_Equals, VectorCompressionType::BitPacking,
+                  PredicateCondition::Equals);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, FixedSizeByteAligned_LessThan,
+                  VectorCompressionType::FixedSizeByteAligned, PredicateCondition::LessThan);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, SimdBp128_LessThan, VectorCompressionType::SimdBp128,
+                  PredicateCondition::LessThan);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, BitPacking_LessThan, VectorCompressionType::BitPacking,
+                  PredicateCondition::LessThan);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, FixedSizeByteAligned_Between,
+                  VectorCompressionType::FixedSizeByteAligned, PredicateCondition::BetweenInclusive);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, SimdBp128_Between, VectorCompressionType::SimdBp128,
+                  PredicateCondition::BetweenInclusive);
+BENCHMARK_CAPTURE(BM_TableScanDictionaryVectorCompression, BitPacking_Between, VectorCompressionType::BitPacking,
+                  PredicateCondition::BetweenInclusive);
+
 }  // namespace opossum
@@ -0,0 +1,62 @@
+#include <atomic>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "logical_query_plan/dummy_table_node.hpp"
+#include "sql/sql_plan_cache.hpp"
+
+namespace opossum {
+
+/**
+ * Concurrent lookups in a plan cache by multiple clients. Most lookups hit a small set of hot queries, the remaining
+ * ones are spread across more queries than the cache can hold and thus cause misses, insertions, and evictions.
+ */
+template <typename PlanCache>
+static void BM_PlanCache(benchmark::State& state) {  // NOLINT
+  constexpr auto HOT_QUERY_COUNT = size_t{100};
+  constexpr auto QUERY_COUNT = size_t{10'000};
+  constexpr auto HOT_QUERY_RATIO = 0.9;
+
+  // The cache and the queries are shared by all threads and all runs of the benchmark.
+  static const auto lqp = std::shared_ptr<AbstractLQPNode>{DummyTableNode::make()};
+  static const auto queries = [] {
+    auto queries = std::vector<std::string>{};
+    for (auto query_id = size_t{0}; query_id < QUERY_COUNT; ++query_id) {
+      queries.emplace_back("SELECT * FROM customer WHERE c_id = " + std::to_string(query_id));
+    }
+    return queries;
+  }();
+  static const auto cache = [] {
+    auto cache = std::make_shared<PlanCache>();
+    for (auto query_id = size_t{0}; query_id < HOT_QUERY_COUNT; ++query_id) {
+      cache->set(queries[query_id], lqp);
+    }
+    return cache;
+  }();
+  static auto next_seed = std::atomic<uint32_t>{0};
+
+  auto random_engine = std::minstd_rand{++next_seed};
+  auto hot_query_distribution = std::bernoulli_distribution{HOT_QUERY_RATIO};
+  auto hot_query_id_distribution = std::uniform_int_distribution<size_t>{0, HOT_QUERY_COUNT - 1};
+  auto cold_query_id_distribution = std::uniform_int_distribution<size_t>{HOT_QUERY_COUNT, QUERY_COUNT - 1};
+
+  for (auto _ : state) {
+    const auto query_id = hot_query_distribution(random_engine) ? hot_query_id_distribution(random_engine)
+                                                                : cold_query_id_distribution(random_engine);
+    const auto& query = queries[query_id];
+    auto cached_lqp = cache->try_get(query);
+    if (!cached_lqp) {
+      cache->set(query, lqp);
+    }
+    benchmark::DoNotOptimize(cached_lqp);
+  }
+
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK_TEMPLATE(BM_PlanCache, SQLLogicalPlanCache)->ThreadRange(1, 64)->UseRealTime();
+BENCHMARK_TEMPLATE(BM_PlanCache, ShardedSQLLogicalPlanCache)->ThreadRange(1, 64)->UseRealTime();
+
+}  // namespace opossum
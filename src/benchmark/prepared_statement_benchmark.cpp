@@ -0,0 +1,117 @@
+#include <arpa/inet.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+#include "hyrise.hpp"
+#include "micro_benchmark_basic_fixture.hpp"
+#include "server/message_stream.hpp"
+#include "server/session.hpp"
+#include "synthetic_table_generator.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+std::string int16_message_field(const uint16_t value) {
+  const auto network_value = htons(value);
+  return std::string(reinterpret_cast<const char*>(&network_value), sizeof(network_value));
+}
+
+std::string int32_message_field(const uint32_t value) {
+  const auto network_value = htonl(value);
+  return std::string(reinterpret_cast<const char*>(&network_value), sizeof(network_value));
+}
+
+std::string message(const char type, const std::string& body) {
+  return type + int32_message_field(static_cast<uint32_t>(sizeof(uint32_t) + body.size())) + body;
+}
+
+std::string parse_message(const std::string& statement_name, const std::string& query) {
+  return message('P', statement_name + '\0' + query + '\0' + int16_message_field(0));
+}
+
+// Binds the statement with text parameters to the unnamed portal and executes it.
+std::string bind_and_execute_messages(const std::string& statement_name, const std::vector<std::string>& parameters) {
+  auto bind_body = std::string{"\0", 1} + statement_name + '\0' + int16_message_field(0) +
+                   int16_message_field(static_cast<uint16_t>(parameters.size()));
+  for (const auto& parameter : parameters) {
+    bind_body += int32_message_field(static_cast<uint32_t>(parameter.size())) + parameter;
+  }
+  bind_body += int16_message_field(0);
+  return message('B', bind_body) + message('E', std::string{"\0", 1} + int32_message_field(0));
+}
+
+}  // namespace
+
+namespace opossum {
+
+// Measures the server-side throughput of prepared statements that are sent as pipelines of Bind/Execute messages
+// followed by a single Sync. The session runs on an in-memory stream so that the network is not measured.
+class PreparedStatementBenchmarkFixture : public MicroBenchmarkBasicFixture {
+ public:
+  void SetUp(::benchmark::State& /*state*/) override {
+    const auto column_specification =
+        ColumnSpecification{ColumnDataDistribution::make_uniform_config(0.0, ROW_COUNT), DataType::Int};
+    const auto table = SyntheticTableGenerator::generate_table({column_specification, column_specification}, ROW_COUNT,
+                                                               CHUNK_SIZE, UseMvcc::Yes);
+    Hyrise::get().storage_manager.add_table("benchmark_table", table);
+
+    _stream = std::make_shared<MessageStream>();
+    _session = std::make_shared<Session<MessageStream>>(_stream, SendExecutionInfo::No);
+
+    const auto startup_body = std::string{"user\0hyrise\0\0", 13};
+    const auto startup_packet =
+        int32_message_field(static_cast<uint32_t>(2 * sizeof(uint32_t) + startup_body.size())) +
+        int32_message_field(196608) + startup_body;
+    _stream->append_input(startup_packet.data(), startup_packet.size());
+    _session->establish_connection();
+
+    _handle_messages(parse_message("select", "SELECT * FROM benchmark_table WHERE column_1 = ?") +
+                     parse_message("insert", "INSERT INTO benchmark_table VALUES (?, ?)") + message('S', ""));
+  }
+
+ protected:
+  static constexpr auto ROW_COUNT = size_t{100'000};
+  static constexpr auto CHUNK_SIZE = ChunkOffset{10'000};
+
+  void _handle_messages(const std::string& messages) {
+    _stream->append_input(messages.data(), messages.size());
+    while (_stream->unread_input_size() > 0) {
+      _session->handle_request();
+    }
+    benchmark::DoNotOptimize(_stream->take_output());
+  }
+
+  void _run_pipelines(::benchmark::State& state, const std::string& statement_name, const size_t parameter_count) {
+    const auto pipeline_depth = static_cast<size_t>(state.range(0));
+    auto pipeline = std::string{};
+    for (auto execution_idx = size_t{0}; execution_idx < pipeline_depth; ++execution_idx) {
+      const auto value = std::to_string(execution_idx * 997 % ROW_COUNT);
+      pipeline += bind_and_execute_messages(statement_name, std::vector<std::string>(parameter_count, value));
+    }
+    pipeline += message('S', "");
+
+    for (auto _ : state) {
+      _handle_messages(pipeline);
+    }
+    state.SetItemsProcessed(static_cast<int64_t>(state.iterations() * pipeline_depth));
+  }
+
+  std::shared_ptr<MessageStream> _stream;
+  std::shared_ptr<Session<MessageStream>> _session;
+};
+
+BENCHMARK_DEFINE_F(PreparedStatementBenchmarkFixture, BM_PreparedSelectPipeline)(benchmark::State& state) {
+  _run_pipelines(state, "select", 1);
+}
+BENCHMARK_REGISTER_F(PreparedStatementBenchmarkFixture, BM_PreparedSelectPipeline)->Arg(1)->Arg(8)->Arg(64);
+
+BENCHMARK_DEFINE_F(PreparedStatementBenchmarkFixture, BM_PreparedInsertPipeline)(benchmark::State& state) {
+  _run_pipelines(state, "insert", 2);
+}
+BENCHMARK_REGISTER_F(PreparedStatementBenchmarkFixture, BM_PreparedInsertPipeline)->Arg(1)->Arg(8)->Arg(64);
+
+}  // namespace opossum
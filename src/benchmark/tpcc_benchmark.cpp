@@ -1,12 +1,17 @@
 #include "tpcc/tpcc_table_generator.hpp"
 
 #include <algorithm>
+#include <chrono>
+#include <filesystem>
 
 #include "benchmark_runner.hpp"
 #include "cli_config_parser.hpp"
+#include "hyrise.hpp"
+#include "logging/write_ahead_log.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "tpcc/constants.hpp"
 #include "tpcc/tpcc_benchmark_item_runner.hpp"
+#include "utils/format_duration.hpp"
 
 using namespace opossum;  // NOLINT
 
@@ -17,9 +22,12 @@ using namespace opossum;  // NOLINT
  * the de facto standard.
  *
  * Other limitations (that may be removed in the future):
- *  - No primary / foreign keys are used as they are currently unsupported
+ *  - Primary keys are not enforced and foreign keys are not used. By default, the primary keys are backed by key
+ *    indexes (see TableKeyIndex), which turn the point lookups of the procedures into KeyIndexLookups. Use
+ *    --key_indexes=false to execute them as table scans instead
  *  - Values that are "retrieved" by the terminal are just selected, but not necessarily materialized
- *  - Data is not persisted as logging is currently unsupported; this means that the durability tests are not executed
+ *  - The durability tests are not executed. Write-ahead logging can be enabled with --wal to measure its cost, but
+ *    the benchmark does not recover from the log
  *  - As decimals are not supported, we use floats instead
  *  - The delivery transaction is not executed in a "deferred" mode; as such, no delivery result file is written
  *  - We do not execute the isolation tests, as we consider our MVCC tests to be sufficient
@@ -32,6 +40,7 @@ using namespace opossum;  // NOLINT
 
 namespace {
 void check_consistency(const size_t num_warehouses);
+void print_write_ahead_log_statistics(const WriteAheadLog& write_ahead_log);
 }
 
 int main(int argc, char* argv[]) {
@@ -41,12 +50,16 @@ int main(int argc, char* argv[]) {
   cli_options.add_options()
     // We use -s instead of -w for consistency with the options of our other TPC-x binaries.
     ("s,scale", "Scale factor (warehouses)", cxxopts::value<size_t>()->default_value("1")) // NOLINT
-    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")); // NOLINT
+    ("consistency_checks", "Run TPC-C consistency checks after benchmark (included with --verify)", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("key_indexes", "Create key indexes for the primary keys and use them for point lookups", cxxopts::value<bool>()->default_value("true")) // NOLINT
+    ("wal", "Log committed transactions to the given file (which is overwritten) and report commit throughput and latency", cxxopts::value<std::string>()->default_value("")) // NOLINT
+    ("wal_group_commit_delay", "Time in microseconds that the write-ahead log waits for further commits before syncing", cxxopts::value<uint32_t>()->default_value("0")); // NOLINT
   // clang-format on
 
   std::shared_ptr<BenchmarkConfig> config;
   size_t num_warehouses;
   bool consistency_checks;
+  std::string wal_path;
 
   // Parse command line args
   const auto cli_parse_result = cli_options.parse(argc, argv);
@@ -55,8 +68,10 @@ int main(int argc, char* argv[]) {
 
   num_warehouses = cli_parse_result["scale"].as<size_t>();
   consistency_checks = cli_parse_result["consistency_checks"].as<bool>();
+  wal_path = cli_parse_result["wal"].as<std::string>();
 
   config = std::make_shared<BenchmarkConfig>(CLIConfigParser::parse_cli_options(cli_parse_result));
+  config->key_indexes = cli_parse_result["key_indexes"].as<bool>();
 
   // As TPC-C procedures may run into conflicts on both the Hyrise and the SQLite side, we cannot guarantee that the
   // two databases stay in sync.
@@ -68,6 +83,24 @@ int main(int argc, char* argv[]) {
 
   // Add TPC-C-specific information
   context.emplace("scale_factor", num_warehouses);
+  context.emplace("key_indexes", config->key_indexes);
+
+  if (config->key_indexes) {
+    std::cout << "- Creating key indexes for the primary keys" << std::endl;
+  } else {
+    std::cout << "- Not creating key indexes, point lookups are executed as table scans" << std::endl;
+  }
+
+  if (!wal_path.empty()) {
+    // The generated tables are not logged, only the transactions executed by the benchmark are.
+    std::filesystem::remove(wal_path);
+    const auto group_commit_delay =
+        std::chrono::microseconds{cli_parse_result["wal_group_commit_delay"].as<uint32_t>()};
+    std::cout << "- Logging committed transactions to " << wal_path << " (group commit delay: "
+              << group_commit_delay.count() << " µs)" << std::endl;
+    Hyrise::get().write_ahead_log = std::make_shared<WriteAheadLog>(wal_path, group_commit_delay);
+    context.emplace("write_ahead_log", wal_path);
+  }
 
   // Run the benchmark
   auto item_runner = std::make_unique<TPCCBenchmarkItemRunner>(config, num_warehouses);
@@ -75,6 +108,11 @@ int main(int argc, char* argv[]) {
                   context)
       .run();
 
+  if (Hyrise::get().write_ahead_log) {
+    Hyrise::get().write_ahead_log->flush();
+    print_write_ahead_log_statistics(*Hyrise::get().write_ahead_log);
+  }
+
   if (consistency_checks || config->verify) {
     std::cout << "- Running consistency checks at the end of the benchmark" << std::endl;
     check_consistency(num_warehouses);
@@ -90,6 +128,30 @@ bool floats_near(T a, T b) {
   return std::max(a, b) / std::min(a, b) <= 1.001;
 }
 
+void print_write_ahead_log_statistics(const WriteAheadLog& write_ahead_log) {
+  auto statistics = write_ahead_log.statistics();
+  std::cout << "- Write-ahead log statistics" << std::endl;
+  if (statistics.commit_count == 0) {
+    std::cout << "  -> No transaction was logged" << std::endl;
+    return;
+  }
+
+  const auto duration =
+      std::chrono::duration<double>{statistics.last_flush_time - statistics.first_append_time}.count();
+
+  auto& latencies = statistics.commit_latencies;
+  const auto p99_index =
+      std::min(latencies.size() - 1, static_cast<size_t>(static_cast<double>(latencies.size()) * 0.99));
+  std::nth_element(latencies.begin(), latencies.begin() + p99_index, latencies.end());
+
+  std::cout << "  -> " << statistics.commit_count << " commits in " << statistics.flush_count << " syncs ("
+            << static_cast<double>(statistics.commit_count) / static_cast<double>(statistics.flush_count)
+            << " commits per sync, " << statistics.bytes_written / 1'000'000 << " MB written)" << std::endl;
+  std::cout << "  -> Commit throughput: " << static_cast<double>(statistics.commit_count) / duration << " commits/s"
+            << std::endl;
+  std::cout << "  -> p99 latency until commits are durable: " << format_duration(latencies[p99_index]) << std::endl;
+}
+
 void check_consistency(const size_t num_warehouses) {
   // new_order_counts[5-1][2-1] will hold the number of new_orders for W_ID 5, D_ID 2.
   // Filled as a byproduct of check 2, validated in check 3.
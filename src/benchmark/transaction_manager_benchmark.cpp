@@ -0,0 +1,56 @@
+#include <memory>
+#include <vector>
+
+#include "benchmark/benchmark.h"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+
+namespace opossum {
+
+/**
+ * Begins and commits empty transactions on an increasing number of threads. Without further work per transaction,
+ * this measures how well registering and deregistering snapshot commit ids as well as handing out commit ids in the
+ * TransactionManager scale.
+ */
+static void BM_TransactionManagerBeginCommit(benchmark::State& state) {  // NOLINT
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  for (auto _ : state) {
+    const auto transaction_context = transaction_manager.new_transaction_context(AutoCommit::Yes);
+    transaction_context->commit();
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransactionManagerBeginCommit)->ThreadRange(1, 128)->UseRealTime();
+
+// Read-only transactions end without a commit and only register and deregister their snapshot commit id.
+static void BM_TransactionManagerBeginEnd(benchmark::State& state) {  // NOLINT
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  for (auto _ : state) {
+    const auto transaction_context = transaction_manager.new_transaction_context(AutoCommit::Yes);
+    benchmark::DoNotOptimize(transaction_context->snapshot_commit_id());
+  }
+
+  state.SetItemsProcessed(state.iterations());
+}
+BENCHMARK(BM_TransactionManagerBeginEnd)->ThreadRange(1, 128)->UseRealTime();
+
+// The MvccDeletePlugin and the TableKeyIndex request the lowest active snapshot commit id, which checks all slots.
+static void BM_TransactionManagerLowestActiveSnapshotCommitID(benchmark::State& state) {  // NOLINT
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+
+  auto transaction_contexts = std::vector<std::shared_ptr<TransactionContext>>{};
+  for (auto transaction_index = int64_t{0}; transaction_index < state.range(0); ++transaction_index) {
+    transaction_contexts.emplace_back(transaction_manager.new_transaction_context(AutoCommit::No));
+  }
+
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(transaction_manager.get_lowest_active_snapshot_commit_id());
+  }
+}
+BENCHMARK(BM_TransactionManagerLowestActiveSnapshotCommitID)->Arg(0)->Arg(128);
+
+}  // namespace opossum
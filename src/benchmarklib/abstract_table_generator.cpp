@@ -1,5 +1,7 @@
 #include "abstract_table_generator.hpp"
 
+#include <algorithm>
+
 #include "benchmark_config.hpp"
 #include "benchmark_table_encoder.hpp"
 #include "hyrise.hpp"
@@ -323,6 +325,33 @@ void AbstractTableGenerator::generate_and_store() {
   } else {
     std::cout << "- No indexes created as --indexes was not specified or set to false" << std::endl;
   }
+
+  /**
+   * Create key indexes for the PRIMARY KEY and UNIQUE constraints if requested by the benchmark
+   */
+  if (_benchmark_config->key_indexes) {
+    std::cout << "- Creating key indexes" << std::endl;
+    for (const auto& [table_name, table_info] : table_info_by_name) {
+      const auto& table = table_info.table;
+      for (const auto& key_constraint : table->soft_key_constraints()) {
+        auto column_ids = std::vector<ColumnID>{key_constraint.columns().begin(), key_constraint.columns().end()};
+        std::sort(column_ids.begin(), column_ids.end());
+
+        std::cout << "-  Creating key index on " << table_name << " [ ";
+        for (const auto column_id : column_ids) {
+          std::cout << table->column_name(column_id) << " ";
+        }
+        std::cout << "] " << std::flush;
+        Timer per_index_timer;
+
+        table->create_key_index(column_ids);
+
+        std::cout << "(" << per_index_timer.lap_formatted() << ")" << std::endl;
+      }
+    }
+    metrics.index_duration += timer.lap();
+    std::cout << "- Creating key indexes done" << std::endl;
+  }
 }
 
 std::shared_ptr<BenchmarkConfig> AbstractTableGenerator::create_benchmark_config_with_chunk_size(
@@ -9,7 +9,11 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode init_benchmark_mode, const
                                  const std::optional<std::string>& init_output_file_path,
                                  const bool init_enable_scheduler, const uint32_t init_cores,
                                  const uint32_t init_clients, const bool init_enable_visualization,
-                                 const bool init_verify, const bool init_cache_binary_tables, const bool init_metrics)
+                                 const bool init_verify, const bool init_cache_binary_tables, const bool init_metrics,
+                                 const SchedulerType init_scheduler_type,
+                                 const uint32_t init_fake_numa_workers_per_node,
+                                 const std::optional<NumaPlacementPolicy>& init_numa_placement_policy,
+                                 const PlanCacheType init_plan_cache_type)
     : benchmark_mode(init_benchmark_mode),
       chunk_size(init_chunk_size),
       encoding_config(init_encoding_config),
@@ -24,7 +28,11 @@ BenchmarkConfig::BenchmarkConfig(const BenchmarkMode init_benchmark_mode, const
       enable_visualization(init_enable_visualization),
       verify(init_verify),
       cache_binary_tables(init_cache_binary_tables),
-      metrics(init_metrics) {}
+      metrics(init_metrics),
+      scheduler_type(init_scheduler_type),
+      fake_numa_workers_per_node(init_fake_numa_workers_per_node),
+      numa_placement_policy(init_numa_placement_policy),
+      plan_cache_type(init_plan_cache_type) {}
 
 BenchmarkConfig BenchmarkConfig::get_default_config() { return BenchmarkConfig(); }
 
@@ -3,7 +3,9 @@
 #include <chrono>
 
 #include "encoding_config.hpp"
+#include "sql/sql_plan_cache.hpp"
 #include "storage/chunk.hpp"
+#include "storage/numa_placement.hpp"
 
 namespace opossum {
 
@@ -13,6 +15,11 @@ namespace opossum {
  */
 enum class BenchmarkMode { Ordered, Shuffled };
 
+/**
+ * Scheduler implementation used if the scheduler is enabled, see NodeQueueScheduler and WorkStealingScheduler
+ */
+enum class SchedulerType { NodeQueue, WorkStealing };
+
 using Duration = std::chrono::high_resolution_clock::duration;
 using TimePoint = std::chrono::high_resolution_clock::time_point;
 
@@ -23,7 +30,11 @@ class BenchmarkConfig {
                   const Duration& init_max_duration, const Duration& init_warmup_duration,
                   const std::optional<std::string>& init_output_file_path, const bool init_enable_scheduler,
                   const uint32_t init_cores, const uint32_t init_clients, const bool init_enable_visualization,
-                  const bool init_verify, const bool init_cache_binary_tables, const bool init_metrics);
+                  const bool init_verify, const bool init_cache_binary_tables, const bool init_metrics,
+                  const SchedulerType init_scheduler_type = SchedulerType::NodeQueue,
+                  const uint32_t init_fake_numa_workers_per_node = 0,
+                  const std::optional<NumaPlacementPolicy>& init_numa_placement_policy = std::nullopt,
+                  const PlanCacheType init_plan_cache_type = PlanCacheType::GDFS);
 
   static BenchmarkConfig get_default_config();
 
@@ -42,6 +53,16 @@ class BenchmarkConfig {
   bool verify = false;
   bool cache_binary_tables = false;  // Defaults to false for internal use, but the CLI sets it to true by default
   bool metrics = false;
+  SchedulerType scheduler_type = SchedulerType::NodeQueue;
+  // If not zero, the scheduler uses a fake NUMA topology with the given number of workers per node (see
+  // Topology::use_fake_numa_topology). This allows measuring NUMA-aware scheduling on machines without NUMA.
+  uint32_t fake_numa_workers_per_node = 0;
+  // If set, the chunks of the generated tables are distributed across the NUMA nodes (see place_chunks_on_numa_nodes)
+  std::optional<NumaPlacementPolicy> numa_placement_policy = std::nullopt;
+  // Implementation of Hyrise::default_pqp_cache and Hyrise::default_lqp_cache
+  PlanCacheType plan_cache_type = PlanCacheType::GDFS;
+  // If set, a TableKeyIndex is created for each PRIMARY KEY and UNIQUE constraint of the generated tables
+  bool key_indexes = false;
 
  private:
   BenchmarkConfig() = default;
@@ -18,6 +18,7 @@
 #include "scheduler/job_task.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "storage/chunk.hpp"
+#include "storage/numa_placement.hpp"
 #include "tpch/tpch_table_generator.hpp"
 #include "utils/format_duration.hpp"
 #include "utils/sqlite_wrapper.hpp"
@@ -33,12 +34,15 @@ BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config,
       _benchmark_item_runner(std::move(benchmark_item_runner)),
       _table_generator(std::move(table_generator)),
       _context(context) {
-  Hyrise::get().default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
-  Hyrise::get().default_lqp_cache = std::make_shared<SQLLogicalPlanCache>();
+  set_default_plan_caches(config.plan_cache_type);
 
   // Initialise the scheduler if the benchmark was requested to run multi-threaded
   if (config.enable_scheduler) {
-    Hyrise::get().topology.use_default_topology(config.cores);
+    if (config.fake_numa_workers_per_node > 0) {
+      Hyrise::get().topology.use_fake_numa_topology(config.cores, config.fake_numa_workers_per_node);
+    } else {
+      Hyrise::get().topology.use_default_topology(config.cores);
+    }
     std::cout << "- Multi-threaded Topology:" << std::endl;
     std::cout << Hyrise::get().topology;
 
@@ -49,12 +53,21 @@ BenchmarkRunner::BenchmarkRunner(const BenchmarkConfig& config,
     }
     _context.push_back({"utilized_cores_per_numa_node", numa_cores_per_node});
 
-    const auto scheduler = std::make_shared<NodeQueueScheduler>();
-    Hyrise::get().set_scheduler(scheduler);
+    if (config.scheduler_type == SchedulerType::WorkStealing) {
+      Hyrise::get().set_scheduler(std::make_shared<WorkStealingScheduler>());
+    } else {
+      Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+    }
   }
 
   _table_generator->generate_and_store();
 
+  if (config.numa_placement_policy) {
+    Timer timer;
+    place_all_tables_on_numa_nodes(*config.numa_placement_policy);
+    std::cout << "- Chunks placed on NUMA nodes (" << timer.lap_formatted() << ")" << std::endl;
+  }
+
   _benchmark_item_runner->on_tables_loaded();
 
   // SQLite data is only loaded if the dedicated result set is not complete, i.e,
@@ -442,6 +455,12 @@ void BenchmarkRunner::write_report_to_file() const {
       {"table_size_in_bytes", table_size},
       {"total_duration", std::chrono::duration_cast<std::chrono::nanoseconds>(total_duration).count()}};
 
+  if (_config.enable_scheduler) {
+    // Number of executed tasks with a preferred NUMA node that ran on (local) or off (remote) that node
+    summary["numa_local_task_count"] = Hyrise::get().scheduler()->numa_local_task_count();
+    summary["numa_remote_task_count"] = Hyrise::get().scheduler()->numa_remote_task_count();
+  }
+
   const auto benchmark_start_ns =
       std::chrono::duration_cast<std::chrono::nanoseconds>(_benchmark_start.time_since_epoch()).count();
   auto log_json = _sql_to_json(std::string{"SELECT \"timestamp\" - "} + std::to_string(benchmark_start_ns) +
@@ -495,7 +514,11 @@ cxxopts::Options BenchmarkRunner::get_basic_cli_options(const std::string& bench
     ("compression", "Specify vector compression as a string. Options: " + compression_strings_option, cxxopts::value<std::string>()->default_value(""))  // NOLINT
     ("indexes", "Create indexes (where defined by benchmark)", cxxopts::value<bool>()->default_value("false"))  // NOLINT
     ("scheduler", "Enable or disable the scheduler", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("scheduler_type", "Scheduler implementation used if the scheduler is enabled: NodeQueue or WorkStealing", cxxopts::value<std::string>()->default_value("NodeQueue")) // NOLINT
     ("cores", "Specify the number of cores used by the scheduler (if active). 0 means all available cores", cxxopts::value<uint32_t>()->default_value("0")) // NOLINT
+    ("fake_numa_workers_per_node", "Use a fake NUMA topology with the given number of workers per node (if the scheduler is active). 0 means the real topology", cxxopts::value<uint32_t>()->default_value("0")) // NOLINT
+    ("numa_placement", "Distribute the chunks of all tables across the NUMA nodes: None, RoundRobin, or Hotness", cxxopts::value<std::string>()->default_value("None")) // NOLINT
+    ("plan_cache", "Implementation of the SQL plan caches: GDFS or Sharded (scales better with many clients)", cxxopts::value<std::string>()->default_value("GDFS")) // NOLINT
     ("clients", "Specify how many items should run in parallel if the scheduler is active", cxxopts::value<uint32_t>()->default_value("1")) // NOLINT
     ("visualize", "Create a visualization image of one LQP and PQP for each query, do not properly run the benchmark", cxxopts::value<bool>()->default_value("false")) // NOLINT
     ("verify", "Verify each query by comparing it with the SQLite result", cxxopts::value<bool>()->default_value("false")) // NOLINT
@@ -536,7 +559,12 @@ nlohmann::json BenchmarkRunner::create_context(const BenchmarkConfig& config) {
       {"max_duration", std::chrono::duration_cast<std::chrono::nanoseconds>(config.max_duration).count()},
       {"warmup_duration", std::chrono::duration_cast<std::chrono::nanoseconds>(config.warmup_duration).count()},
       {"using_scheduler", config.enable_scheduler},
+      {"scheduler_type", magic_enum::enum_name(config.scheduler_type)},
       {"cores", config.cores},
+      {"fake_numa_workers_per_node", config.fake_numa_workers_per_node},
+      {"numa_placement",
+       config.numa_placement_policy ? std::string{magic_enum::enum_name(*config.numa_placement_policy)} : "None"},
+      {"plan_cache", magic_enum::enum_name(config.plan_cache_type)},
       {"clients", config.clients},
       {"verify", config.verify},
       {"time_unit", "ns"},
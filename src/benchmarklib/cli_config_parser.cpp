@@ -30,14 +30,60 @@ BenchmarkConfig CLIConfigParser::parse_cli_options(const cxxopts::ParseResult& p
   std::cout << "- Running in " + std::string(enable_scheduler ? "multi" : "single") + "-threaded mode" << core_info
             << std::endl;
 
+  const auto scheduler_type_str = parse_result["scheduler_type"].as<std::string>();
+  auto scheduler_type = SchedulerType::NodeQueue;
+  if (scheduler_type_str == "NodeQueue") {
+    scheduler_type = SchedulerType::NodeQueue;
+  } else if (scheduler_type_str == "WorkStealing") {
+    scheduler_type = SchedulerType::WorkStealing;
+  } else {
+    throw std::runtime_error("Invalid scheduler type: '" + scheduler_type_str + "'");
+  }
+  if (enable_scheduler) {
+    std::cout << "- Using the " << scheduler_type_str << " scheduler" << std::endl;
+  }
+
+  const auto fake_numa_workers_per_node = parse_result["fake_numa_workers_per_node"].as<uint32_t>();
+  if (enable_scheduler && fake_numa_workers_per_node > 0) {
+    std::cout << "- Using a fake NUMA topology with " << fake_numa_workers_per_node << " workers per node" << std::endl;
+  }
+
+  const auto numa_placement_str = parse_result["numa_placement"].as<std::string>();
+  auto numa_placement_policy = std::optional<NumaPlacementPolicy>{};
+  if (numa_placement_str == "RoundRobin") {
+    numa_placement_policy = NumaPlacementPolicy::RoundRobin;
+  } else if (numa_placement_str == "Hotness") {
+    numa_placement_policy = NumaPlacementPolicy::Hotness;
+  } else if (numa_placement_str != "None") {
+    throw std::runtime_error("Invalid NUMA placement policy: '" + numa_placement_str + "'");
+  }
+  if (numa_placement_policy) {
+    std::cout << "- Placing chunks on NUMA nodes using the " << numa_placement_str << " policy" << std::endl;
+  }
+
+  const auto plan_cache_str = parse_result["plan_cache"].as<std::string>();
+  auto plan_cache_type = PlanCacheType::GDFS;
+  if (plan_cache_str == "GDFS") {
+    plan_cache_type = PlanCacheType::GDFS;
+  } else if (plan_cache_str == "Sharded") {
+    plan_cache_type = PlanCacheType::Sharded;
+  } else {
+    throw std::runtime_error("Invalid plan cache: '" + plan_cache_str + "'");
+  }
+  std::cout << "- Using the " << plan_cache_str << " plan cache" << std::endl;
+
   const auto clients = parse_result["clients"].as<uint32_t>();
   std::cout << "- " + std::to_string(clients) + " simulated ";
   std::cout << (clients == 1 ? "client is " : "clients are ") << "scheduling items";
   std::cout << (clients > 1 ? " in parallel" : "") << std::endl;
 
-  if (cores != default_config.cores || clients != default_config.clients) {
+  if (cores != default_config.cores || clients != default_config.clients ||
+      scheduler_type != default_config.scheduler_type ||
+      fake_numa_workers_per_node != default_config.fake_numa_workers_per_node) {
     if (!enable_scheduler) {
-      PerformanceWarning("'--cores' or '--clients' specified but ignored, because '--scheduler' is false");
+      PerformanceWarning(
+          "'--cores', '--clients', '--scheduler_type', or '--fake_numa_workers_per_node' specified but ignored, "
+          "because '--scheduler' is false");
     }
   }
 
@@ -135,7 +181,8 @@ BenchmarkConfig CLIConfigParser::parse_cli_options(const cxxopts::ParseResult& p
   return BenchmarkConfig{
       benchmark_mode,  chunk_size,          *encoding_config, indexes, max_runs, timeout_duration,
       warmup_duration, output_file_path,    enable_scheduler, cores,   clients,  enable_visualization,
-      verify,          cache_binary_tables, metrics};
+      verify,          cache_binary_tables, metrics,          scheduler_type, fake_numa_workers_per_node,
+      numa_placement_policy, plan_cache_type};
 }
 
 EncodingConfig CLIConfigParser::parse_encoding_config(const std::string& encoding_file_str) {
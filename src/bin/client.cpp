@@ -1,6 +1,196 @@
 #include "client.hpp"
 
+#include <algorithm>
+#include <cstring>
+#include <iostream>
+#include <numeric>
+#include <thread>
+
+#include "cxxopts.hpp"
+
+#include "utils/assert.hpp"
+
 // Files in the /bin folder are not tested. Everything that can be tested should be in the /lib folder and this file
 // should be as short as possible.
+//
+// hyriseClient is a load generator for the server. It opens the given number of connections and lets each of them run
+// the query until the time is up. This allows measuring how the server scales with the number of connections, e.g.,
+// `./hyriseClient --connections 5000 --query "SELECT * FROM nation WHERE n_nationkey = 5"` against a server started
+// with `--server_mode Async` and with `--server_mode ThreadPerSession`.
+
+namespace {
+
+constexpr auto PROTOCOL_VERSION_3 = uint32_t{196608};
+constexpr auto LENGTH_FIELD_SIZE = uint32_t{4};
+
+std::string length_field(const uint32_t length) {
+  const auto network_value = htonl(length);
+  return std::string(reinterpret_cast<const char*>(&network_value), sizeof(network_value));
+}
+
+}  // namespace
+
+namespace opossum {
+
+LoadGeneratorConnection::LoadGeneratorConnection(boost::asio::io_service& io_service, const std::string& query,
+                                                 const std::chrono::steady_clock::time_point deadline)
+    : _socket(io_service), _deadline(deadline) {
+  // Simple query message: type, length, and the null-terminated query
+  _query_message = "Q" + length_field(static_cast<uint32_t>(LENGTH_FIELD_SIZE + query.size() + 1)) + query + '\0';
+}
+
+void LoadGeneratorConnection::start(const boost::asio::ip::tcp::endpoint& endpoint) {
+  _socket.async_connect(endpoint, [self = shared_from_this()](const boost::system::error_code& error) {
+    if (error) return self->_close();
+    self->_is_connected = true;
+    self->_socket.set_option(boost::asio::ip::tcp::no_delay(true));
+    self->_send_startup_packet();
+  });
+}
+
+const std::vector<std::chrono::nanoseconds>& LoadGeneratorConnection::latencies() const { return _latencies; }
+
+size_t LoadGeneratorConnection::error_count() const { return _error_count; }
+
+bool LoadGeneratorConnection::is_connected() const { return _is_connected; }
+
+void LoadGeneratorConnection::_send_startup_packet() {
+  const auto parameters = std::string{"user\0hyrise\0\0", 13};
+  _startup_packet = length_field(static_cast<uint32_t>(2 * LENGTH_FIELD_SIZE + parameters.size())) +
+                    length_field(PROTOCOL_VERSION_3) + parameters;
+  boost::asio::async_write(_socket, boost::asio::buffer(_startup_packet),
+                           [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                             if (error) return self->_close();
+                             self->_read_message();
+                           });
+}
+
+void LoadGeneratorConnection::_send_query() {
+  if (std::chrono::steady_clock::now() >= _deadline) {
+    // Terminate message
+    static const auto terminate_message = "X" + length_field(LENGTH_FIELD_SIZE);
+    boost::asio::async_write(_socket, boost::asio::buffer(terminate_message),
+                             [self = shared_from_this()](const boost::system::error_code&, size_t) { self->_close(); });
+    return;
+  }
+
+  _query_begin = std::chrono::steady_clock::now();
+  _is_query_running = true;
+  boost::asio::async_write(_socket, boost::asio::buffer(_query_message),
+                           [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+                             if (error) return self->_close();
+                             self->_read_message();
+                           });
+}
+
+void LoadGeneratorConnection::_read_message() {
+  boost::asio::async_read(
+      _socket, boost::asio::buffer(_header),
+      [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+        if (error) return self->_close();
+
+        auto network_length = uint32_t{0};
+        std::memcpy(&network_length, self->_header.data() + 1, sizeof(network_length));
+        self->_body.resize(ntohl(network_length) - LENGTH_FIELD_SIZE);
+
+        boost::asio::async_read(self->_socket, boost::asio::buffer(self->_body),
+                                [self](const boost::system::error_code& error, size_t) {
+                                  if (error) return self->_close();
+
+                                  const auto message_type = self->_header[0];
+                                  if (message_type == 'E') ++self->_error_count;
+                                  if (message_type != 'Z') return self->_read_message();
+
+                                  // ReadyForQuery: The previous query (or the connection setup) is complete.
+                                  if (self->_is_query_running) {
+                                    self->_latencies.emplace_back(std::chrono::steady_clock::now() -
+                                                                  self->_query_begin);
+                                    self->_is_query_running = false;
+                                  }
+                                  self->_send_query();
+                                });
+      });
+}
+
+void LoadGeneratorConnection::_close() {
+  auto error = boost::system::error_code{};
+  _socket.close(error);
+}
+
+}  // namespace opossum
+
+int main(int argc, char** argv) {
+  auto cli_options = cxxopts::Options{"./hyriseClient", "Load generator for the Hyrise server"};
+
+  // clang-format off
+  cli_options.add_options()
+    ("help", "Display this help and exit") // NOLINT
+    ("address", "Address of the server", cxxopts::value<std::string>()->default_value("127.0.0.1")) // NOLINT
+    ("p,port", "Port of the server", cxxopts::value<uint16_t>()->default_value("5432")) // NOLINT
+    ("c,connections", "Number of concurrent connections", cxxopts::value<uint32_t>()->default_value("100")) // NOLINT
+    ("t,time", "Runtime in seconds", cxxopts::value<uint32_t>()->default_value("10")) // NOLINT
+    ("q,query", "Query that each connection runs repeatedly", cxxopts::value<std::string>()->default_value("SELECT 1;")) // NOLINT
+    ("threads", "Number of client threads", cxxopts::value<uint32_t>()->default_value("1")) // NOLINT
+    ;  // NOLINT
+  // clang-format on
+
+  const auto parsed_options = cli_options.parse(argc, argv);
+  if (parsed_options.count("help")) {
+    std::cout << cli_options.help() << std::endl;
+    return 0;
+  }
+
+  const auto connection_count = parsed_options["connections"].as<uint32_t>();
+  const auto runtime = std::chrono::seconds{parsed_options["time"].as<uint32_t>()};
+  const auto thread_count = parsed_options["threads"].as<uint32_t>();
+  Assert(connection_count > 0 && thread_count > 0, "At least one connection and one thread are required");
+
+  const auto address = boost::asio::ip::make_address(parsed_options["address"].as<std::string>());
+  const auto endpoint = boost::asio::ip::tcp::endpoint{address, parsed_options["port"].as<uint16_t>()};
+
+  auto io_service = boost::asio::io_service{};
+  const auto begin = std::chrono::steady_clock::now();
+  auto connections = std::vector<std::shared_ptr<opossum::LoadGeneratorConnection>>{};
+  for (auto connection_id = uint32_t{0}; connection_id < connection_count; ++connection_id) {
+    connections.emplace_back(std::make_shared<opossum::LoadGeneratorConnection>(
+        io_service, parsed_options["query"].as<std::string>(), begin + runtime));
+    connections.back()->start(endpoint);
+  }
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = uint32_t{1}; thread_id < thread_count; ++thread_id) {
+    threads.emplace_back([&]() { io_service.run(); });
+  }
+  io_service.run();
+  for (auto& thread : threads) {
+    thread.join();
+  }
+  const auto duration = std::chrono::duration<double>(std::chrono::steady_clock::now() - begin);
+
+  auto latencies = std::vector<std::chrono::nanoseconds>{};
+  auto error_count = size_t{0};
+  auto failed_connection_count = size_t{0};
+  for (const auto& connection : connections) {
+    latencies.insert(latencies.end(), connection->latencies().begin(), connection->latencies().end());
+    error_count += connection->error_count();
+    if (!connection->is_connected()) ++failed_connection_count;
+  }
+  std::sort(latencies.begin(), latencies.end());
+
+  const auto to_ms = [](const std::chrono::nanoseconds latency) {
+    return std::chrono::duration<double, std::milli>(latency).count();
+  };
+
+  std::cout << "Connections:        " << connection_count << " (" << failed_connection_count << " failed)" << std::endl;
+  std::cout << "Queries:            " << latencies.size() << " (" << error_count << " errors)" << std::endl;
+  std::cout << "Throughput:         " << static_cast<double>(latencies.size()) / duration.count() << " queries/s"
+            << std::endl;
+  if (!latencies.empty()) {
+    const auto latency_sum = std::accumulate(latencies.begin(), latencies.end(), std::chrono::nanoseconds{0});
+    std::cout << "Mean latency:       " << to_ms(latency_sum / latencies.size()) << " ms" << std::endl;
+    std::cout << "Median latency:     " << to_ms(latencies[latencies.size() / 2]) << " ms" << std::endl;
+    std::cout << "99th pct. latency:  " << to_ms(latencies[latencies.size() * 99 / 100]) << " ms" << std::endl;
+  }
 
-int main(int argc, char** argv) { return 0; }
+  return 0;
+}
@@ -1 +1,48 @@
 #pragma once
+
+#include <array>
+#include <chrono>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+namespace opossum {
+
+// Connection of the hyriseClient load generator. Once connected, it sends the same query over and over again using the
+// simple query protocol of PostgreSQL and records the latency of each query until the deadline is reached. All
+// operations are asynchronous, so that a few threads can drive thousands of connections.
+class LoadGeneratorConnection : public std::enable_shared_from_this<LoadGeneratorConnection> {
+ public:
+  LoadGeneratorConnection(boost::asio::io_service& io_service, const std::string& query,
+                          const std::chrono::steady_clock::time_point deadline);
+
+  void start(const boost::asio::ip::tcp::endpoint& endpoint);
+
+  const std::vector<std::chrono::nanoseconds>& latencies() const;
+  size_t error_count() const;
+  bool is_connected() const;
+
+ private:
+  void _send_startup_packet();
+  void _send_query();
+  void _read_message();
+  void _close();
+
+  boost::asio::ip::tcp::socket _socket;
+  std::string _query_message;
+  const std::chrono::steady_clock::time_point _deadline;
+
+  std::string _startup_packet;
+  std::array<char, 5> _header{};
+  std::vector<char> _body;
+
+  bool _is_connected{false};
+  std::chrono::steady_clock::time_point _query_begin;
+  bool _is_query_running{false};
+  std::vector<std::chrono::nanoseconds> _latencies;
+  size_t _error_count{0};
+};
+
+}  // namespace opossum
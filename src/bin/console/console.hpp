@@ -152,8 +152,8 @@ class Console : public Singleton<Console> {
 
   std::unique_ptr<SQLPipeline> _sql_pipeline;
   std::shared_ptr<TransactionContext> _explicitly_created_transaction_context;
-  std::shared_ptr<SQLPhysicalPlanCache> _pqp_cache;
-  std::shared_ptr<SQLLogicalPlanCache> _lqp_cache;
+  std::shared_ptr<AbstractSQLPhysicalPlanCache> _pqp_cache;
+  std::shared_ptr<AbstractSQLLogicalPlanCache> _lqp_cache;
 };
 
 }  // namespace opossum
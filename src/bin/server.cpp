@@ -1,10 +1,17 @@
 #include "cxxopts.hpp"
 
+#include <filesystem>
+
 #include <boost/algorithm/string.hpp>
 #include <boost/lexical_cast.hpp>
 
 #include "benchmark_config.hpp"
 #include "cli_config_parser.hpp"
+#include "hyrise.hpp"
+#include "logging/checkpoint_loader.hpp"
+#include "logging/checkpoint_writer.hpp"
+#include "logging/wal_recovery.hpp"
+#include "logging/write_ahead_log.hpp"
 #include "server/server.hpp"
 #include "tpcc/tpcc_table_generator.hpp"
 #include "tpcds/tpcds_table_generator.hpp"
@@ -63,6 +70,14 @@ cxxopts::Options get_server_cli_options() {
                        "TPC-DS, and TPC-H. The sizing factor determines the scale factor in TPC-DS and TPC-H, and the "
                        "warehouse count in TPC-C.", cxxopts::value<std::string>()) // NOLINT
     ("execution_info", "Send execution information after statement execution", cxxopts::value<bool>()->default_value("false")) // NOLINT
+    ("checkpoint", "Optional: if the given checkpoint file exists, restore the tables from it. Otherwise, write the "
+                   "tables (e.g., generated with benchmark_data) to it.", cxxopts::value<std::string>()) // NOLINT
+    ("server_mode", "ThreadPerSession (each client is served by a thread of its own) or Async (clients share a pool of I/O threads, queries are executed by the scheduler)", cxxopts::value<std::string>()->default_value("ThreadPerSession")) // NOLINT
+    ("io_threads", "Number of I/O threads in the Async server mode", cxxopts::value<uint32_t>()->default_value("2")) // NOLINT
+    ("plan_cache", "Implementation of the SQL plan caches: GDFS or Sharded (scales better with many clients)", cxxopts::value<std::string>()->default_value("GDFS")) // NOLINT
+    ("wal", "Optional: log committed transactions to the given file. If the file exists, it is recovered first, which "
+            "requires the logged tables to be in their initial state (e.g., generated with benchmark_data) or to be "
+            "restored from a checkpoint.", cxxopts::value<std::string>()) // NOLINT
     ;  // NOLINT
   // clang-format on
 
@@ -87,8 +102,27 @@ int main(int argc, char* argv[]) {
     * We do not plan on exposing other parameters, such as the encoding or the chunk size via this facility. You can
     * change the modify the config object as needed.
     */
-  if (parsed_options.count("benchmark_data")) {
-    generate_benchmark_data(parsed_options["benchmark_data"].as<std::string>());
+  const auto checkpoint_path =
+      parsed_options.count("checkpoint") ? parsed_options["checkpoint"].as<std::string>() : std::string{};
+  if (!checkpoint_path.empty() && std::filesystem::exists(checkpoint_path)) {
+    const auto commit_id = opossum::CheckpointLoader::load(checkpoint_path);
+    std::cout << "Restored tables from " << checkpoint_path << " (commit id " << commit_id << ")" << std::endl;
+  } else {
+    if (parsed_options.count("benchmark_data")) {
+      generate_benchmark_data(parsed_options["benchmark_data"].as<std::string>());
+    }
+
+    if (!checkpoint_path.empty()) {
+      opossum::CheckpointWriter::write(checkpoint_path);
+      std::cout << "Wrote checkpoint to " << checkpoint_path << std::endl;
+    }
+  }
+
+  if (parsed_options.count("wal")) {
+    const auto wal_path = parsed_options["wal"].as<std::string>();
+    const auto recovered_commit_count = opossum::WalRecovery::recover(wal_path);
+    std::cout << "Recovered " << recovered_commit_count << " transactions from " << wal_path << std::endl;
+    opossum::Hyrise::get().write_ahead_log = std::make_shared<opossum::WriteAheadLog>(wal_path);
   }
 
   const auto execution_info = parsed_options["execution_info"].as<bool>();
@@ -99,7 +133,20 @@ int main(int argc, char* argv[]) {
 
   Assert(!error, "Not a valid IPv4 address: " + parsed_options["address"].as<std::string>() + ", terminating...");
 
-  auto server = opossum::Server{address, port, static_cast<opossum::SendExecutionInfo>(execution_info)};
+  const auto plan_cache_str = parsed_options["plan_cache"].as<std::string>();
+  Assert(plan_cache_str == "GDFS" || plan_cache_str == "Sharded", "Invalid plan cache: " + plan_cache_str);
+  const auto plan_cache_type =
+      plan_cache_str == "Sharded" ? opossum::PlanCacheType::Sharded : opossum::PlanCacheType::GDFS;
+
+  const auto server_mode_str = parsed_options["server_mode"].as<std::string>();
+  Assert(server_mode_str == "ThreadPerSession" || server_mode_str == "Async", "Invalid server mode: " + server_mode_str);
+  const auto server_mode =
+      server_mode_str == "Async" ? opossum::ServerMode::Async : opossum::ServerMode::ThreadPerSession;
+
+  const auto io_thread_count = parsed_options["io_threads"].as<uint32_t>();
+
+  auto server = opossum::Server{address,         port,        static_cast<opossum::SendExecutionInfo>(execution_info),
+                                plan_cache_type, server_mode, io_thread_count};
   server.run();
 
   return 0;
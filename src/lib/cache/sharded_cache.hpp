@@ -0,0 +1,291 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <functional>
+#include <mutex>
+#include <shared_mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "abstract_cache.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+/**
+ * Approximate access frequencies of hashed keys (a count-min sketch as used by TinyLFU). Each key is counted in one
+ * 4-bit counter of each of the four rows. The estimated frequency is the minimum of these counters. Once the number of
+ * recorded accesses reaches ten times the number of counters per row, all counters are halved, so that the sketch
+ * adapts to changing workloads. Counters are updated with relaxed atomics. Concurrent updates may get lost, which is
+ * acceptable for an approximation.
+ */
+class FrequencySketch {
+ public:
+  static constexpr auto MAX_FREQUENCY = uint8_t{15};
+
+  explicit FrequencySketch(const size_t expected_key_count)
+      : _row_width(std::bit_ceil(std::max(expected_key_count, size_t{16}))),
+        _counters(ROW_COUNT * _row_width),
+        _aging_threshold(10 * _row_width) {}
+
+  void record_access(const size_t hash) {
+    for (auto row = size_t{0}; row < ROW_COUNT; ++row) {
+      auto& counter = _counters[_counter_index(hash, row)];
+      if (counter.load(std::memory_order_relaxed) < MAX_FREQUENCY) counter.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    if (_access_count.fetch_add(1, std::memory_order_relaxed) + 1 == _aging_threshold) {
+      _access_count.store(0, std::memory_order_relaxed);
+      for (auto& counter : _counters) {
+        counter.store(counter.load(std::memory_order_relaxed) / 2, std::memory_order_relaxed);
+      }
+    }
+  }
+
+  uint8_t estimate_frequency(const size_t hash) const {
+    auto frequency = MAX_FREQUENCY;
+    for (auto row = size_t{0}; row < ROW_COUNT; ++row) {
+      frequency = std::min(frequency, _counters[_counter_index(hash, row)].load(std::memory_order_relaxed));
+    }
+    return frequency;
+  }
+
+ protected:
+  static constexpr auto ROW_COUNT = size_t{4};
+
+  // Derives one index per row from the hash using double hashing. As std::hash is the identity for integers, the hash
+  // is mixed first.
+  size_t _counter_index(const size_t hash, const size_t row) const {
+    const auto mixed_hash = (hash ^ (hash >> 31)) * size_t{0x9E3779B97F4A7C15};
+    const auto row_hash = mixed_hash + row * ((mixed_hash >> 32) | 1);
+    return row * _row_width + (row_hash & (_row_width - 1));
+  }
+
+  const size_t _row_width;
+  std::vector<std::atomic<uint8_t>> _counters;
+  const size_t _aging_threshold;
+  std::atomic<size_t> _access_count{0};
+};
+
+/**
+ * Cache implementation for many concurrent clients (see PlanCacheType). GDFSCache updates its priority queue on every
+ * hit and thus takes an exclusive lock for each lookup. In contrast, this cache
+ *  - partitions the entries into shards by the hash of their key, each protected by its own lock,
+ *  - only takes a shared lock for lookups and updates the frequency and the GDFS priority of the entry with atomics,
+ *  - determines the entries with the lowest GDFS priority only when a shard is full and then evicts a batch of them,
+ *  - uses a TinyLFU-style admission policy: The access frequency of all requested keys, including the ones that are
+ *    not cached, is approximated by a FrequencySketch. A new entry only displaces cached entries if its key was
+ *    requested at least as often as the key of the entry with the lowest priority. Thus, entries that are used only
+ *    once do not displace frequently used ones.
+ *
+ * The number of shards is fixed at construction so that each shard holds at least MIN_SHARD_CAPACITY entries. The
+ * capacity is split across the shards. Thus, entries might be evicted before the cache as a whole is full.
+ */
+template <typename Key, typename Value>
+class ShardedCache : public AbstractCache<Key, Value> {
+ public:
+  using SnapshotEntry = typename AbstractCache<Key, Value>::SnapshotEntry;
+
+  static constexpr auto MIN_SHARD_CAPACITY = size_t{32};
+  static constexpr auto MAX_SHARD_COUNT = size_t{64};
+
+  // Fraction of a shard's capacity that is evicted at once
+  static constexpr auto EVICTION_BATCH_RATIO = 0.1;
+
+  explicit ShardedCache(size_t capacity = DEFAULT_CACHE_CAPACITY)
+      : AbstractCache<Key, Value>(capacity),
+        _shards(std::clamp(std::bit_floor(capacity / MIN_SHARD_CAPACITY), size_t{1}, MAX_SHARD_COUNT)),
+        _sketch(capacity) {
+    _distribute_capacity(capacity);
+  }
+
+  void set(const Key& key, const Value& value, double cost = 1.0, double size = 1.0) final {
+    const auto hash = std::hash<Key>{}(key);
+    auto& shard = _shard(hash);
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.capacity == 0) return;
+
+    const auto iter = shard.map.find(key);
+    if (iter != shard.map.end()) {
+      auto& entry = iter->second;
+      entry.value = value;
+      entry.size = size;
+      entry.frequency.fetch_add(1, std::memory_order_relaxed);
+      entry.inflation.store(shard.inflation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+      return;
+    }
+
+    if (shard.map.size() >= shard.capacity) {
+      auto victims = _lowest_priority_entries(shard, _eviction_batch_size(shard));
+
+      // TinyLFU admission: Do not displace entries whose keys are requested more often than the new key.
+      const auto& first_victim_key = victims.front()->first;
+      if (_sketch.estimate_frequency(hash) < _sketch.estimate_frequency(std::hash<Key>{}(first_victim_key))) return;
+
+      _evict_entries(shard, victims);
+    }
+
+    shard.map.try_emplace(key, value, size, shard.inflation.load(std::memory_order_relaxed));
+  }
+
+  std::optional<Value> try_get(const Key& key) final {
+    const auto hash = std::hash<Key>{}(key);
+    _sketch.record_access(hash);
+
+    auto& shard = _shard(hash);
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    const auto iter = shard.map.find(key);
+    if (iter == shard.map.end()) return std::nullopt;
+
+    auto& entry = iter->second;
+    entry.frequency.fetch_add(1, std::memory_order_relaxed);
+    entry.inflation.store(shard.inflation.load(std::memory_order_relaxed), std::memory_order_relaxed);
+    return entry.value;
+  }
+
+  bool has(const Key& key) const final {
+    const auto& shard = _shard(std::hash<Key>{}(key));
+    std::shared_lock<std::shared_mutex> lock(shard.mutex);
+    return shard.map.contains(key);
+  }
+
+  size_t size() const final {
+    auto size = size_t{0};
+    for (const auto& shard : _shards) {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      size += shard.map.size();
+    }
+    return size;
+  }
+
+  void clear() final {
+    for (auto& shard : _shards) {
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      shard.map.clear();
+    }
+  }
+
+  void resize(size_t capacity) final {
+    _distribute_capacity(capacity);
+    this->_capacity = capacity;
+  }
+
+  std::unordered_map<Key, SnapshotEntry> snapshot() const final {
+    std::unordered_map<Key, SnapshotEntry> map_copy;
+    for (const auto& shard : _shards) {
+      std::shared_lock<std::shared_mutex> lock(shard.mutex);
+      for (const auto& [key, entry] : shard.map) {
+        map_copy.emplace(key, SnapshotEntry{entry.value, entry.frequency.load(std::memory_order_relaxed)});
+      }
+    }
+    return map_copy;
+  }
+
+  size_t shard_count() const { return _shards.size(); }
+
+ protected:
+  struct Entry {
+    Entry(const Value& init_value, const double init_size, const double init_inflation)
+        : value(init_value), size(init_size), inflation(init_inflation) {}
+
+    // GDFS priority, see GDFSCache
+    double priority() const {
+      return inflation.load(std::memory_order_relaxed) +
+             static_cast<double>(frequency.load(std::memory_order_relaxed)) / size;
+    }
+
+    Value value;
+    double size;
+    std::atomic<size_t> frequency{1};
+    // Inflation of the shard at the last access of the entry
+    std::atomic<double> inflation;
+  };
+
+  using EntryMap = std::unordered_map<Key, Entry>;
+
+  struct alignas(64) Shard {
+    mutable std::shared_mutex mutex;
+    EntryMap map;
+    size_t capacity{0};
+
+    // Set to the priority of the last evicted entry. Atomic as hits read it while holding a shared lock only.
+    std::atomic<double> inflation{0.0};
+  };
+
+  Shard& _shard(const size_t hash) { return _shards[hash % _shards.size()]; }
+
+  const Shard& _shard(const size_t hash) const { return _shards[hash % _shards.size()]; }
+
+  static size_t _eviction_batch_size(const Shard& shard) {
+    return std::max(size_t{1}, static_cast<size_t>(static_cast<double>(shard.capacity) * EVICTION_BATCH_RATIO));
+  }
+
+  // Returns the given number of entries with the lowest priority, the one with the lowest priority first. Requires an
+  // exclusive lock on the shard.
+  static std::vector<typename EntryMap::iterator> _lowest_priority_entries(Shard& shard, const size_t count) {
+    auto entries = std::vector<std::pair<double, typename EntryMap::iterator>>{};
+    entries.reserve(shard.map.size());
+    for (auto iter = shard.map.begin(); iter != shard.map.end(); ++iter) {
+      entries.emplace_back(iter->second.priority(), iter);
+    }
+
+    const auto victim_count = std::min(count, entries.size());
+    const auto compare_priority = [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; };
+    std::nth_element(entries.begin(), entries.begin() + victim_count - 1, entries.end(), compare_priority);
+    std::sort(entries.begin(), entries.begin() + victim_count, compare_priority);
+
+    auto victims = std::vector<typename EntryMap::iterator>(victim_count);
+    for (auto victim_idx = size_t{0}; victim_idx < victim_count; ++victim_idx) {
+      victims[victim_idx] = entries[victim_idx].second;
+    }
+    return victims;
+  }
+
+  // Requires an exclusive lock on the shard.
+  static void _evict_entries(Shard& shard, const std::vector<typename EntryMap::iterator>& victims) {
+    shard.inflation.store(victims.back()->second.priority(), std::memory_order_relaxed);
+    for (const auto& victim : victims) {
+      shard.map.erase(victim);
+    }
+  }
+
+  void _distribute_capacity(const size_t capacity) {
+    const auto shard_count = _shards.size();
+    for (auto shard_idx = size_t{0}; shard_idx < shard_count; ++shard_idx) {
+      auto& shard = _shards[shard_idx];
+      std::unique_lock<std::shared_mutex> lock(shard.mutex);
+      shard.capacity = capacity / shard_count + (shard_idx < capacity % shard_count ? 1 : 0);
+      if (shard.map.size() > shard.capacity) {
+        _evict_entries(shard, _lowest_priority_entries(shard, shard.map.size() - shard.capacity));
+      }
+    }
+  }
+
+  // Evicts a batch of entries from the fullest shard. The sizes of the shards are read under their locks, but they may
+  // change before the fullest shard is locked exclusively. The batch might then be evicted from a shard that is no
+  // longer the fullest, which is acceptable.
+  void _evict() final {
+    auto fullest_shard_idx = size_t{0};
+    auto fullest_shard_size = size_t{0};
+    for (auto shard_idx = size_t{0}; shard_idx < _shards.size(); ++shard_idx) {
+      std::shared_lock<std::shared_mutex> lock(_shards[shard_idx].mutex);
+      if (_shards[shard_idx].map.size() > fullest_shard_size) {
+        fullest_shard_idx = shard_idx;
+        fullest_shard_size = _shards[shard_idx].map.size();
+      }
+    }
+
+    auto& shard = _shards[fullest_shard_idx];
+    std::unique_lock<std::shared_mutex> lock(shard.mutex);
+    if (shard.map.empty()) return;
+    _evict_entries(shard, _lowest_priority_entries(shard, _eviction_batch_size(shard)));
+  }
+
+  std::vector<Shard> _shards;
+  FrequencySketch _sketch;
+};
+
+}  // namespace opossum
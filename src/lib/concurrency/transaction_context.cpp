@@ -5,6 +5,8 @@
 
 #include "commit_context.hpp"
 #include "hyrise.hpp"
+#include "logging/wal_commit_record.hpp"
+#include "logging/write_ahead_log.hpp"
 #include "operators/abstract_read_write_operator.hpp"
 #include "utils/assert.hpp"
 
@@ -14,11 +16,10 @@ TransactionContext::TransactionContext(const TransactionID transaction_id, const
                                        const AutoCommit is_auto_commit)
     : _transaction_id{transaction_id},
       _snapshot_commit_id{snapshot_commit_id},
+      _snapshot_commit_id_slot{Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id)},
       _is_auto_commit{is_auto_commit},
       _phase{TransactionPhase::Active},
-      _num_active_operators{0} {
-  Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id);
-}
+      _num_active_operators{0} {}
 
 TransactionContext::~TransactionContext() {
   DebugAssert(([this]() {
@@ -51,7 +52,7 @@ TransactionContext::~TransactionContext() {
    * Tell the TransactionManager, which keeps track of active snapshot-commit-ids,
    * that this transaction has finished.
    */
-  Hyrise::get().transaction_manager._deregister_transaction(_snapshot_commit_id);
+  Hyrise::get().transaction_manager._deregister_transaction(_snapshot_commit_id, _snapshot_commit_id_slot);
 }
 
 TransactionID TransactionContext::transaction_id() const { return _transaction_id; }
@@ -93,6 +94,23 @@ void TransactionContext::commit_async(const std::function<void(TransactionID)>&
     op->commit_records(commit_id());
   }
 
+  const auto& write_ahead_log = Hyrise::get().write_ahead_log;
+  if (write_ahead_log) {
+    auto record_writer = WalCommitRecordWriter{commit_id()};
+    for (const auto& op : _read_write_operators) {
+      op->log_records(record_writer);
+    }
+
+    if (!record_writer.empty()) {
+      // The commit is only made visible once its record is durable (see WriteAheadLog). Until then, the flush thread
+      // holds on to this context.
+      write_ahead_log->append(record_writer.finish(), [context = shared_from_this(), callback]() {
+        context->_mark_as_pending_and_try_commit(callback);
+      });
+      return;
+    }
+  }
+
   _mark_as_pending_and_try_commit(callback);
 }
 
@@ -198,6 +198,8 @@ class TransactionContext : public std::enable_shared_from_this<TransactionContex
  private:
   const TransactionID _transaction_id;
   const CommitID _snapshot_commit_id;
+  // Slot of the snapshot commit id in the TransactionManager, see TransactionManager::_register_transaction
+  const size_t _snapshot_commit_id_slot;
   const AutoCommit _is_auto_commit;
 
   std::vector<std::shared_ptr<AbstractReadWriteOperator>> _read_write_operators;
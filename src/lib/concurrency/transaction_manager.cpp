@@ -1,19 +1,44 @@
 #include "transaction_manager.hpp"
 
+#include <algorithm>
+
 #include "commit_context.hpp"
 #include "storage/mvcc_data.hpp"
 #include "transaction_context.hpp"
 #include "utils/assert.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+constexpr auto SLOTS_PER_CACHE_LINE = 64 / sizeof(CommitID);
+
+// Threads start searching for a free snapshot-commit-id slot at different cache lines so that concurrently beginning
+// transactions do not contend for the same cache line. Afterwards, a thread starts at the slot it used last, which is
+// usually free again, as most transactions end on the thread that began them.
+size_t initial_slot_hint() {
+  static auto next_cache_line = std::atomic_size_t{0};
+  return (next_cache_line++ * SLOTS_PER_CACHE_LINE) % TransactionManager::SNAPSHOT_COMMIT_ID_SLOT_COUNT;
+}
+
+thread_local auto slot_hint = initial_slot_hint();
+
+}  // namespace
+
 namespace opossum {
 
 TransactionManager::TransactionManager()
     : _next_transaction_id{INITIAL_TRANSACTION_ID},
       _last_commit_id{INITIAL_COMMIT_ID},
-      _last_commit_context{std::make_shared<CommitContext>(INITIAL_COMMIT_ID)} {}
+      _last_commit_context{std::make_shared<CommitContext>(INITIAL_COMMIT_ID)},
+      _overflowing_snapshot_commit_id_count{0} {
+  for (auto& slot : _snapshot_commit_id_slots) {
+    slot = FREE_SNAPSHOT_COMMIT_ID_SLOT;
+  }
+}
 
 TransactionManager::~TransactionManager() {
-  Assert(_active_snapshot_commit_ids.empty(),
+  Assert(_active_snapshot_commit_ids().empty(),
          "Some transactions do not seem to have finished yet as they are still registered as active.");
 }
 
@@ -21,7 +46,11 @@ TransactionManager& TransactionManager::operator=(TransactionManager&& transacti
   _next_transaction_id = transaction_manager._next_transaction_id.load();
   _last_commit_id = transaction_manager._last_commit_id.load();
   _last_commit_context = transaction_manager._last_commit_context;
-  _active_snapshot_commit_ids = transaction_manager._active_snapshot_commit_ids;
+  for (auto slot = size_t{0}; slot < SNAPSHOT_COMMIT_ID_SLOT_COUNT; ++slot) {
+    _snapshot_commit_id_slots[slot] = transaction_manager._snapshot_commit_id_slots[slot].load();
+  }
+  _overflowing_snapshot_commit_ids = transaction_manager._overflowing_snapshot_commit_ids;
+  _overflowing_snapshot_commit_id_count = transaction_manager._overflowing_snapshot_commit_id_count.load();
   return *this;
 }
 
@@ -32,36 +61,85 @@ std::shared_ptr<TransactionContext> TransactionManager::new_transaction_context(
   return std::make_shared<TransactionContext>(_next_transaction_id++, snapshot_commit_id, auto_commit);
 }
 
-void TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
-  _active_snapshot_commit_ids.insert(snapshot_commit_id);
-}
+size_t TransactionManager::_register_transaction(const CommitID snapshot_commit_id) {
+  DebugAssert(snapshot_commit_id != FREE_SNAPSHOT_COMMIT_ID_SLOT, "Invalid snapshot-commit-id");
+
+  for (auto offset = size_t{0}; offset < SNAPSHOT_COMMIT_ID_SLOT_COUNT; ++offset) {
+    const auto slot = (slot_hint + offset) % SNAPSHOT_COMMIT_ID_SLOT_COUNT;
+    auto& slot_commit_id = _snapshot_commit_id_slots[slot];
 
-void TransactionManager::_deregister_transaction(const CommitID snapshot_commit_id) {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
+    // Only try to claim slots that appear to be free so that we do not write to cache lines used by other threads.
+    auto expected = FREE_SNAPSHOT_COMMIT_ID_SLOT;
+    if (slot_commit_id.load(std::memory_order_relaxed) == FREE_SNAPSHOT_COMMIT_ID_SLOT &&
+        slot_commit_id.compare_exchange_strong(expected, snapshot_commit_id)) {
+      slot_hint = slot;
+      return slot;
+    }
+  }
 
-  auto it = std::find(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end(), snapshot_commit_id);
+  std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+  _overflowing_snapshot_commit_ids.insert(snapshot_commit_id);
+  ++_overflowing_snapshot_commit_id_count;
+  return OVERFLOW_SNAPSHOT_COMMIT_ID_SLOT;
+}
 
-  if (it != _active_snapshot_commit_ids.end()) {
-    _active_snapshot_commit_ids.erase(it);
+void TransactionManager::_deregister_transaction(const CommitID snapshot_commit_id, const size_t slot) {
+  if (slot != OVERFLOW_SNAPSHOT_COMMIT_ID_SLOT) {
+    DebugAssert(slot < SNAPSHOT_COMMIT_ID_SLOT_COUNT && _snapshot_commit_id_slots[slot] == snapshot_commit_id,
+                "Snapshot-commit-id was not registered in the given slot.");
+    _snapshot_commit_id_slots[slot] = FREE_SNAPSHOT_COMMIT_ID_SLOT;
     return;
   }
 
-  Assert(
-      it == _active_snapshot_commit_ids.end(),
-      "Could not find snapshot_commit_id in TransactionManager's _active_snapshot_commit_ids. Therefore, the removal "
-      "failed and the function should not have been called.");
+  std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+
+  const auto it = _overflowing_snapshot_commit_ids.find(snapshot_commit_id);
+  Assert(it != _overflowing_snapshot_commit_ids.end(),
+         "Could not find snapshot_commit_id in TransactionManager's _overflowing_snapshot_commit_ids. Therefore, the "
+         "removal failed and the function should not have been called.");
+  _overflowing_snapshot_commit_ids.erase(it);
+  --_overflowing_snapshot_commit_id_count;
+}
+
+std::unordered_multiset<CommitID> TransactionManager::_active_snapshot_commit_ids() const {
+  auto active_snapshot_commit_ids = std::unordered_multiset<CommitID>{};
+  for (const auto& slot : _snapshot_commit_id_slots) {
+    const auto snapshot_commit_id = slot.load();
+    if (snapshot_commit_id != FREE_SNAPSHOT_COMMIT_ID_SLOT) active_snapshot_commit_ids.insert(snapshot_commit_id);
+  }
+
+  std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+  active_snapshot_commit_ids.insert(_overflowing_snapshot_commit_ids.cbegin(), _overflowing_snapshot_commit_ids.cend());
+  return active_snapshot_commit_ids;
 }
 
 std::optional<CommitID> TransactionManager::get_lowest_active_snapshot_commit_id() const {
-  std::unique_lock<std::mutex> lock(_mutex_active_snapshot_commit_ids);
+  // FREE_SNAPSHOT_COMMIT_ID_SLOT is larger than any snapshot-commit-id.
+  auto lowest_snapshot_commit_id = FREE_SNAPSHOT_COMMIT_ID_SLOT;
+  for (const auto& slot : _snapshot_commit_id_slots) {
+    lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, slot.load());
+  }
+
+  if (_overflowing_snapshot_commit_id_count > 0) {
+    std::lock_guard<std::mutex> lock(_mutex_overflowing_snapshot_commit_ids);
+    for (const auto snapshot_commit_id : _overflowing_snapshot_commit_ids) {
+      lowest_snapshot_commit_id = std::min(lowest_snapshot_commit_id, snapshot_commit_id);
+    }
+  }
 
-  if (_active_snapshot_commit_ids.empty()) {
+  if (lowest_snapshot_commit_id == FREE_SNAPSHOT_COMMIT_ID_SLOT) {
     return std::nullopt;
   }
 
-  auto it = std::min_element(_active_snapshot_commit_ids.begin(), _active_snapshot_commit_ids.end());
-  return *it;
+  return lowest_snapshot_commit_id;
+}
+
+void TransactionManager::_reset_last_commit_id(const CommitID commit_id) {
+  Assert(!get_lowest_active_snapshot_commit_id(), "Cannot reset the last commit ID while transactions are active.");
+  Assert(commit_id >= _last_commit_id, "Commit IDs must not decrease.");
+
+  _last_commit_id = commit_id;
+  std::atomic_store(&_last_commit_context, std::make_shared<CommitContext>(commit_id));
 }
 
 /**
@@ -1,9 +1,12 @@
 #pragma once
 
+#include <array>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <optional>
 #include <unordered_set>
 
 #include "types.hpp"
@@ -62,30 +65,44 @@ class TransactionManager : public Noncopyable {
   std::shared_ptr<TransactionContext> new_transaction_context(const AutoCommit auto_commit);
 
   /**
-   * Returns the lowest snapshot-commit-id currently used by a transaction.
+   * Returns the lowest snapshot-commit-id currently used by a transaction. Does not block transactions from beginning
+   * or ending, but takes O(SNAPSHOT_COMMIT_ID_SLOT_COUNT).
    */
   std::optional<CommitID> get_lowest_active_snapshot_commit_id() const;
 
+  // Number of transactions whose snapshot-commit-ids can be tracked without taking a lock
+  static constexpr auto SNAPSHOT_COMMIT_ID_SLOT_COUNT = size_t{1024};
+
  private:
   TransactionManager();
   ~TransactionManager();
 
+  friend class CheckpointLoader;
   friend class Hyrise;
   friend class TransactionContext;
+  friend class WalRecovery;
 
   TransactionManager& operator=(TransactionManager&& transaction_manager) noexcept;
 
   std::shared_ptr<CommitContext> _new_commit_context();
   void _try_increment_last_commit_id(const std::shared_ptr<CommitContext>& context);
 
+  // Continues with the commit IDs following `commit_id` after the write-ahead log has been recovered. Must not be
+  // called while transactions are active.
+  void _reset_last_commit_id(const CommitID commit_id);
+
   /**
-   * The TransactionManager keeps track of issued snapshot-commit-ids,
-   * which are in use by unfinished transactions.
-   * The following two functions are used to keep the multiset of active
-   * snapshot-commit-ids up to date.
+   * The TransactionManager keeps track of issued snapshot-commit-ids, which are in use by unfinished transactions.
+   * Beginning and ending transactions must not serialize on a lock. Thus, each transaction claims one of the
+   * _snapshot_commit_id_slots with a compare-and-swap. The slot is returned by _register_transaction and has to be
+   * passed to _deregister_transaction. Only if all slots are occupied, the snapshot-commit-id is stored in the
+   * mutex-protected _overflowing_snapshot_commit_ids and OVERFLOW_SNAPSHOT_COMMIT_ID_SLOT is returned.
    */
-  void _register_transaction(CommitID snapshot_commit_id);
-  void _deregister_transaction(CommitID snapshot_commit_id);
+  size_t _register_transaction(CommitID snapshot_commit_id);
+  void _deregister_transaction(CommitID snapshot_commit_id, size_t slot);
+
+  // Collects all snapshot-commit-ids of unfinished transactions. Not thread-safe, used for tests and checks.
+  std::unordered_multiset<CommitID> _active_snapshot_commit_ids() const;
 
   std::atomic<TransactionID> _next_transaction_id;
 
@@ -96,7 +113,15 @@ class TransactionManager : public Noncopyable {
 
   std::shared_ptr<CommitContext> _last_commit_context;
 
-  mutable std::mutex _mutex_active_snapshot_commit_ids;
-  std::unordered_multiset<CommitID> _active_snapshot_commit_ids;
+  static constexpr auto FREE_SNAPSHOT_COMMIT_ID_SLOT = std::numeric_limits<CommitID>::max();
+  static constexpr auto OVERFLOW_SNAPSHOT_COMMIT_ID_SLOT = std::numeric_limits<size_t>::max();
+
+  // Each slot holds the snapshot-commit-id of an unfinished transaction or FREE_SNAPSHOT_COMMIT_ID_SLOT.
+  alignas(64) std::array<std::atomic<CommitID>, SNAPSHOT_COMMIT_ID_SLOT_COUNT> _snapshot_commit_id_slots;
+
+  mutable std::mutex _mutex_overflowing_snapshot_commit_ids;
+  std::unordered_multiset<CommitID> _overflowing_snapshot_commit_ids;
+  // Allows get_lowest_active_snapshot_commit_id to skip the mutex if no transaction overflowed.
+  std::atomic_size_t _overflowing_snapshot_commit_id_count;
 };
 }  // namespace opossum
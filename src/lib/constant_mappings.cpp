@@ -43,7 +43,11 @@ const boost::bimap<EncodingType, std::string> encoding_type_to_string = make_bim
 });
 
 const boost::bimap<FileType, std::string> file_type_to_string = make_bimap<FileType, std::string>(
-    {{FileType::Tbl, "Tbl"}, {FileType::Csv, "Csv"}, {FileType::Binary, "Binary"}, {FileType::Auto, "Auto"}});
+    {{FileType::Tbl, "Tbl"},
+     {FileType::Csv, "Csv"},
+     {FileType::Binary, "Binary"},
+     {FileType::Parquet, "Parquet"},
+     {FileType::Auto, "Auto"}});
 
 const boost::bimap<LogLevel, std::string> log_level_to_string = make_bimap<LogLevel, std::string>(
     {{LogLevel::Debug, "Debug"}, {LogLevel::Info, "Info"}, {LogLevel::Warning, "Warning"}});
@@ -52,6 +56,7 @@ const boost::bimap<VectorCompressionType, std::string> vector_compression_type_t
     make_bimap<VectorCompressionType, std::string>({
         {VectorCompressionType::FixedSizeByteAligned, "Fixed-size byte-aligned"},
         {VectorCompressionType::SimdBp128, "SIMD-BP128"},
+        {VectorCompressionType::BitPacking, "Bit-packing"},
     });
 
 std::ostream& operator<<(std::ostream& stream, const AggregateFunction aggregate_function) {
@@ -100,6 +105,10 @@ std::ostream& operator<<(std::ostream& stream, const CompressedVectorType compre
       stream << "SimdBp128";
       break;
     }
+    case CompressedVectorType::BitPacking: {
+      stream << "BitPacking";
+      break;
+    }
     default:
       break;
   }
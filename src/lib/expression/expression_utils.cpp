@@ -271,6 +271,26 @@ void expressions_set_transaction_context(const std::vector<std::shared_ptr<Abstr
   }
 }
 
+void expression_set_memory_budget_resource(const std::shared_ptr<AbstractExpression>& expression,
+                                           const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {
+  visit_expression(expression, [&](auto& sub_expression) {
+    if (sub_expression->type != ExpressionType::PQPSubquery) return ExpressionVisitation::VisitArguments;
+
+    const auto pqp_subquery_expression = std::dynamic_pointer_cast<PQPSubqueryExpression>(sub_expression);
+    Assert(pqp_subquery_expression, "Expected a PQPSubqueryExpression here");
+    pqp_subquery_expression->pqp->set_memory_budget_resource_recursively(memory_budget_resource);
+
+    return ExpressionVisitation::DoNotVisitArguments;
+  });
+}
+
+void expressions_set_memory_budget_resource(const std::vector<std::shared_ptr<AbstractExpression>>& expressions,
+                                            const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {
+  for (const auto& expression : expressions) {
+    expression_set_memory_budget_resource(expression, memory_budget_resource);
+  }
+}
+
 bool expression_contains_placeholder(const std::shared_ptr<AbstractExpression>& expression) {
   auto placeholder_found = false;
 
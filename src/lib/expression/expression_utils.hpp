@@ -165,6 +165,14 @@ void expression_set_transaction_context(const std::shared_ptr<AbstractExpression
 void expressions_set_transaction_context(const std::vector<std::shared_ptr<AbstractExpression>>& expressions,
                                          const std::weak_ptr<TransactionContext>& transaction_context);
 
+/**
+ * Traverse the expression(s) for subqueries and set the memory budget resource in them
+ */
+void expression_set_memory_budget_resource(const std::shared_ptr<AbstractExpression>& expression,
+                                           const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource);
+void expressions_set_memory_budget_resource(const std::vector<std::shared_ptr<AbstractExpression>>& expressions,
+                                            const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource);
+
 bool expression_contains_placeholder(const std::shared_ptr<AbstractExpression>& expression);
 bool expression_contains_correlated_parameter(const std::shared_ptr<AbstractExpression>& expression);
 
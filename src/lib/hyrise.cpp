@@ -1,5 +1,7 @@
 #include "hyrise.hpp"
 
+#include "logging/write_ahead_log.hpp"
+
 namespace opossum {
 
 Hyrise::Hyrise() {
@@ -20,11 +22,16 @@ Hyrise::Hyrise() {
   settings_manager = SettingsManager{};
   log_manager = LogManager{};
   topology = Topology{};
+  unparameterizable_sql = std::make_shared<UnparameterizableSQLSet>();
   _scheduler = std::make_shared<ImmediateExecutionScheduler>();
 }
 
 void Hyrise::reset() {
   Hyrise::get().scheduler()->finish();
+
+  // Make pending commits durable (and visible) before the TransactionManager is replaced.
+  Hyrise::get().write_ahead_log = nullptr;
+
   get() = Hyrise{};
 }
 
@@ -17,6 +17,7 @@ namespace opossum {
 
 class AbstractScheduler;
 class BenchmarkRunner;
+class WriteAheadLog;
 
 // This should be the only singleton in the src/lib world. It provides a unified way of accessing components like the
 // storage manager, the transaction manager, and more. Encapsulating this in one class avoids the static initialization
@@ -50,8 +51,14 @@ class Hyrise : public Singleton<Hyrise> {
 
   // Plan caches used by the SQLPipelineBuilder if `with_{l/p}qp_cache()` are not used. Both default caches can be
   // nullptr themselves. If both default_{l/p}qp_cache and _{l/p}qp_cache are nullptr, no plan caching is used.
-  std::shared_ptr<SQLPhysicalPlanCache> default_pqp_cache;
-  std::shared_ptr<SQLLogicalPlanCache> default_lqp_cache;
+  std::shared_ptr<AbstractSQLPhysicalPlanCache> default_pqp_cache;
+  std::shared_ptr<AbstractSQLLogicalPlanCache> default_lqp_cache;
+
+  // Statements that cannot use parameterized plans, shared by all SQLPipelines independent of their plan caches.
+  std::shared_ptr<UnparameterizableSQLSet> unparameterizable_sql;
+
+  // If set, committed transactions are made durable in this log before they become visible (see WriteAheadLog).
+  std::shared_ptr<WriteAheadLog> write_ahead_log;
 
   // The BenchmarkRunner is available here so that non-benchmark components can add information to the benchmark
   // result JSON.
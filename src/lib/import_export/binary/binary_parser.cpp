@@ -1,7 +1,12 @@
 #include "binary_parser.hpp"
 
+#include <lz4.h>
+#include <zstd.h>
+
+#include <array>
 #include <cstdint>
-#include <fstream>
+#include <cstring>
+#include <istream>
 #include <memory>
 #include <numeric>
 #include <optional>
@@ -11,6 +16,7 @@
 #include "constant_mappings.hpp"
 #include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/chunk.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/vector_compression/fixed_size_byte_aligned/fixed_size_byte_aligned_vector.hpp"
@@ -18,24 +24,90 @@
 #include "storage/vector_compression/simd_bp128/simd_bp128_vector.hpp"
 
 #include "utils/assert.hpp"
+#include "utils/memory_mapped_file.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Returns the decompressed block or nullptr if the block is not compressed and can be read from the file directly.
+std::unique_ptr<char[]> decompress_block(const char* block_data, const size_t block_size,
+                                         const size_t uncompressed_block_size,
+                                         const BlockCompression block_compression) {
+  if (block_compression == BlockCompression::None) return nullptr;
+
+  auto uncompressed_block = std::make_unique_for_overwrite<char[]>(uncompressed_block_size);
+  switch (block_compression) {
+    case BlockCompression::LZ4: {
+      const auto uncompressed_size = LZ4_decompress_safe(block_data, uncompressed_block.get(),
+                                                         static_cast<int>(block_size),
+                                                         static_cast<int>(uncompressed_block_size));
+      Assert(uncompressed_size >= 0 && static_cast<size_t>(uncompressed_size) == uncompressed_block_size,
+             "LZ4 block decompression failed");
+      break;
+    }
+    case BlockCompression::Zstd: {
+      const auto uncompressed_size =
+          ZSTD_decompress(uncompressed_block.get(), uncompressed_block_size, block_data, block_size);
+      Assert(!ZSTD_isError(uncompressed_size) && uncompressed_size == uncompressed_block_size,
+             "zstd block decompression failed");
+      break;
+    }
+    default:
+      Fail("Invalid BlockCompression");
+  }
+  return uncompressed_block;
+}
+
+}  // namespace
 
 namespace opossum {
 
 std::shared_ptr<Table> BinaryParser::parse(const std::string& filename) {
-  std::ifstream file;
-  file.open(filename, std::ios::binary);
-  file.exceptions(std::ifstream::failbit | std::ifstream::badbit);
+  // Reading from the mapped file avoids the intermediate buffer of an std::ifstream.
+  const auto mapped_file = MemoryMappedFile{filename};
+  auto file = MemoryInputStream{mapped_file.data(), mapped_file.size()};
+  file.exceptions(std::istream::failbit | std::istream::badbit);
 
   auto [table, chunk_count] = _read_header(file);
-  for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
-    _import_chunk(file, table);
+
+  const auto directory = _read_directory(mapped_file.data(), mapped_file.size(), chunk_count);
+  if (!directory) {
+    for (ChunkID chunk_id{0}; chunk_id < chunk_count; ++chunk_id) {
+      _import_chunk(file, table);
+    }
+    return table;
+  }
+
+  const auto& [chunk_blocks, block_compression] = *directory;
+  auto chunks = std::vector<std::pair<Segments, std::vector<SortColumnDefinition>>>(chunk_count);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+      const auto& chunk_block = chunk_blocks[chunk_id];
+      mapped_file.will_need(chunk_block.offset, chunk_block.size);
+
+      const auto* const block_data = mapped_file.data() + chunk_block.offset;
+      const auto uncompressed_block =
+          decompress_block(block_data, chunk_block.size, chunk_block.uncompressed_size, block_compression);
+      auto block = uncompressed_block ? MemoryInputStream{uncompressed_block.get(), chunk_block.uncompressed_size}
+                                      : MemoryInputStream{block_data, chunk_block.size};
+      block.exceptions(std::istream::failbit | std::istream::badbit);
+      chunks[chunk_id] = _read_chunk(block, *table);
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  for (const auto& [segments, sorted_columns] : chunks) {
+    _append_chunk(*table, segments, sorted_columns);
   }
 
   return table;
 }
 
 template <typename T>
-pmr_vector<T> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<T> BinaryParser::_read_values(std::istream& file, const size_t count) {
   pmr_vector<T> values(count);
   file.read(reinterpret_cast<char*>(values.data()), values.size() * sizeof(T));
   return values;
@@ -43,19 +115,19 @@ pmr_vector<T> BinaryParser::_read_values(std::ifstream& file, const size_t count
 
 // specialized implementation for string values
 template <>
-pmr_vector<pmr_string> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_values(std::istream& file, const size_t count) {
   return _read_string_values(file, count);
 }
 
 // specialized implementation for bool values
 template <>
-pmr_vector<bool> BinaryParser::_read_values(std::ifstream& file, const size_t count) {
+pmr_vector<bool> BinaryParser::_read_values(std::istream& file, const size_t count) {
   pmr_vector<BoolAsByteType> readable_bools(count);
   file.read(reinterpret_cast<char*>(readable_bools.data()), readable_bools.size() * sizeof(BoolAsByteType));
   return pmr_vector<bool>(readable_bools.begin(), readable_bools.end());
 }
 
-pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, const size_t count) {
+pmr_vector<pmr_string> BinaryParser::_read_string_values(std::istream& file, const size_t count) {
   const auto string_lengths = _read_values<size_t>(file, count);
   const auto total_length = std::accumulate(string_lengths.cbegin(), string_lengths.cend(), static_cast<size_t>(0));
   const auto buffer = _read_values<char>(file, total_length);
@@ -72,13 +144,13 @@ pmr_vector<pmr_string> BinaryParser::_read_string_values(std::ifstream& file, co
 }
 
 template <typename T>
-T BinaryParser::_read_value(std::ifstream& file) {
+T BinaryParser::_read_value(std::istream& file) {
   T result;
   file.read(reinterpret_cast<char*>(&result), sizeof(T));
   return result;
 }
 
-std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstream& file) {
+std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::istream& file) {
   const auto chunk_size = _read_value<ChunkOffset>(file);
   const auto chunk_count = _read_value<ChunkID>(file);
   const auto column_count = _read_value<ColumnID>(file);
@@ -98,7 +170,55 @@ std::pair<std::shared_ptr<Table>, ChunkID> BinaryParser::_read_header(std::ifstr
   return std::make_pair(table, chunk_count);
 }
 
-void BinaryParser::_import_chunk(std::ifstream& file, std::shared_ptr<Table>& table) {
+std::optional<std::pair<std::vector<BinaryParser::ChunkBlock>, BlockCompression>> BinaryParser::_read_directory(
+    const char* data, const size_t size, const ChunkID chunk_count) {
+  if (size < BinaryWriter::FOOTER_SIZE) return std::nullopt;
+
+  auto footer = MemoryInputStream{data + size - BinaryWriter::FOOTER_SIZE, BinaryWriter::FOOTER_SIZE};
+  footer.exceptions(std::istream::failbit | std::istream::badbit);
+  const auto directory_offset = _read_value<uint64_t>(footer);
+  const auto block_compression = _read_value<BlockCompression>(footer);
+  const auto format_version = _read_value<uint32_t>(footer);
+  auto magic = std::array<char, sizeof(BinaryWriter::MAGIC)>{};
+  footer.read(magic.data(), magic.size());
+  if (std::memcmp(magic.data(), BinaryWriter::MAGIC, magic.size()) != 0) return std::nullopt;
+
+  Assert(format_version == BinaryWriter::FORMAT_VERSION,
+         "Binary format version " + std::to_string(format_version) + " is not supported");
+  const auto directory_size = size_t{3} * chunk_count * sizeof(uint64_t);
+  Assert(directory_offset + directory_size + BinaryWriter::FOOTER_SIZE == size, "Invalid chunk directory");
+
+  auto directory = MemoryInputStream{data + directory_offset, directory_size};
+  directory.exceptions(std::istream::failbit | std::istream::badbit);
+  const auto block_offsets = _read_values<uint64_t>(directory, chunk_count);
+  const auto block_sizes = _read_values<uint64_t>(directory, chunk_count);
+  const auto uncompressed_block_sizes = _read_values<uint64_t>(directory, chunk_count);
+
+  auto chunk_blocks = std::vector<ChunkBlock>(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    chunk_blocks[chunk_id] = ChunkBlock{block_offsets[chunk_id], block_sizes[chunk_id],
+                                        uncompressed_block_sizes[chunk_id]};
+    Assert(block_offsets[chunk_id] + block_sizes[chunk_id] <= directory_offset, "Binary file is truncated");
+  }
+
+  return std::make_pair(std::move(chunk_blocks), block_compression);
+}
+
+void BinaryParser::_import_chunk(std::istream& file, std::shared_ptr<Table>& table) {
+  const auto [segments, sorted_columns] = _read_chunk(file, *table);
+  _append_chunk(*table, segments, sorted_columns);
+}
+
+void BinaryParser::_append_chunk(Table& table, const Segments& segments,
+                                 const std::vector<SortColumnDefinition>& sorted_columns) {
+  const auto mvcc_data = std::make_shared<MvccData>(segments.front()->size(), CommitID{0});
+  table.append_chunk(segments, mvcc_data);
+  table.last_chunk()->finalize();
+  if (!sorted_columns.empty()) table.last_chunk()->set_individually_sorted_by(sorted_columns);
+}
+
+std::pair<Segments, std::vector<SortColumnDefinition>> BinaryParser::_read_chunk(std::istream& file,
+                                                                                 const Table& table) {
   const auto row_count = _read_value<ChunkOffset>(file);
 
   // Import sort column definitions
@@ -111,18 +231,15 @@ void BinaryParser::_import_chunk(std::ifstream& file, std::shared_ptr<Table>& ta
   }
 
   Segments output_segments;
-  for (ColumnID column_id{0}; column_id < table->column_count(); ++column_id) {
+  for (ColumnID column_id{0}; column_id < table.column_count(); ++column_id) {
     output_segments.push_back(
-        _import_segment(file, row_count, table->column_data_type(column_id), table->column_is_nullable(column_id)));
+        _import_segment(file, row_count, table.column_data_type(column_id), table.column_is_nullable(column_id)));
   }
 
-  const auto mvcc_data = std::make_shared<MvccData>(row_count, CommitID{0});
-  table->append_chunk(output_segments, mvcc_data);
-  table->last_chunk()->finalize();
-  if (num_sorted_columns > 0) table->last_chunk()->set_individually_sorted_by(sorted_columns);
+  return {std::move(output_segments), std::move(sorted_columns)};
 }
 
-std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::istream& file, ChunkOffset row_count,
                                                                DataType data_type, bool column_is_nullable) {
   std::shared_ptr<AbstractSegment> result;
   resolve_data_type(data_type, [&](auto type) {
@@ -134,7 +251,7 @@ std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& fi
 }
 
 template <typename ColumnDataType>
-std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::istream& file, ChunkOffset row_count,
                                                                bool column_is_nullable) {
   const auto column_type = _read_value<EncodingType>(file);
 
@@ -167,7 +284,7 @@ std::shared_ptr<AbstractSegment> BinaryParser::_import_segment(std::ifstream& fi
 }
 
 template <typename T>
-std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstream& file, ChunkOffset row_count,
+std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::istream& file, ChunkOffset row_count,
                                                                      bool column_is_nullable) {
   if (column_is_nullable) {
     const auto segment_is_nullable = _read_value<bool>(file);
@@ -183,7 +300,7 @@ std::shared_ptr<ValueSegment<T>> BinaryParser::_import_value_segment(std::ifstre
 }
 
 template <typename T>
-std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(std::ifstream& file,
+std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(std::istream& file,
                                                                                ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto dictionary_size = _read_value<ValueID>(file);
@@ -195,7 +312,7 @@ std::shared_ptr<DictionarySegment<T>> BinaryParser::_import_dictionary_segment(s
 }
 
 std::shared_ptr<FixedStringDictionarySegment<pmr_string>> BinaryParser::_import_fixed_string_dictionary_segment(
-    std::ifstream& file, ChunkOffset row_count) {
+    std::istream& file, ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto dictionary_size = _read_value<ValueID>(file);
   auto dictionary = _import_fixed_string_vector(file, dictionary_size);
@@ -205,7 +322,7 @@ std::shared_ptr<FixedStringDictionarySegment<pmr_string>> BinaryParser::_import_
 }
 
 template <typename T>
-std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(std::ifstream& file,
+std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(std::istream& file,
                                                                               ChunkOffset row_count) {
   const auto size = _read_value<uint32_t>(file);
   const auto values = std::make_shared<pmr_vector<T>>(_read_values<T>(file, size));
@@ -216,7 +333,7 @@ std::shared_ptr<RunLengthSegment<T>> BinaryParser::_import_run_length_segment(st
 }
 
 template <typename T>
-std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(std::ifstream& file,
+std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_reference_segment(std::istream& file,
                                                                                              ChunkOffset row_count) {
   const auto attribute_vector_width = _read_value<AttributeVectorWidth>(file);
   const auto block_count = _read_value<uint32_t>(file);
@@ -234,7 +351,7 @@ std::shared_ptr<FrameOfReferenceSegment<T>> BinaryParser::_import_frame_of_refer
 }
 
 template <typename T>
-std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream& file, ChunkOffset row_count) {
+std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::istream& file, ChunkOffset row_count) {
   const auto num_elements = _read_value<uint32_t>(file);
   const auto block_count = _read_value<uint32_t>(file);
   const auto block_size = _read_value<uint32_t>(file);
@@ -284,7 +401,7 @@ std::shared_ptr<LZ4Segment<T>> BinaryParser::_import_lz4_segment(std::ifstream&
 }
 
 std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
-    std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
+    std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
   switch (attribute_vector_width) {
     case 1:
       return std::make_shared<FixedSizeByteAlignedVector<uint8_t>>(_read_values<uint8_t>(file, row_count));
@@ -298,7 +415,7 @@ std::shared_ptr<BaseCompressedVector> BinaryParser::_import_attribute_vector(
 }
 
 std::unique_ptr<const BaseCompressedVector> BinaryParser::_import_offset_value_vector(
-    std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
+    std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width) {
   switch (attribute_vector_width) {
     case 1:
       return std::make_unique<FixedSizeByteAlignedVector<uint8_t>>(_read_values<uint8_t>(file, row_count));
@@ -311,7 +428,7 @@ std::unique_ptr<const BaseCompressedVector> BinaryParser::_import_offset_value_v
   }
 }
 
-std::shared_ptr<FixedStringVector> BinaryParser::_import_fixed_string_vector(std::ifstream& file, const size_t count) {
+std::shared_ptr<FixedStringVector> BinaryParser::_import_fixed_string_vector(std::istream& file, const size_t count) {
   const auto string_length = _read_value<uint32_t>(file);
   pmr_vector<char> values(string_length * count);
   file.read(values.data(), values.size());
@@ -1,12 +1,13 @@
 #pragma once
 
-#include <fstream>
+#include <istream>
 #include <memory>
 #include <optional>
 #include <string>
 #include <utility>
 #include <vector>
 
+#include "import_export/binary/binary_writer.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/dictionary_segment.hpp"
 #include "storage/encoding_type.hpp"
@@ -24,9 +25,13 @@ namespace opossum {
  * Documentation of the file formats can be found in BinaryWriter header file.
  */
 class BinaryParser {
+  friend class CheckpointLoader;
+
  public:
   /*
-   * Reads the given binary file. The file must be in the following form:
+   * Reads the given binary file (see BinaryWriter::write). The chunk blocks of files with a chunk directory are
+   * decompressed and parsed by parallel jobs. Files of format version 1 must be in the following form and are parsed
+   * sequentially:
    *
    * --------------
    * |   Header   |
@@ -39,73 +44,93 @@ class BinaryParser {
   static std::shared_ptr<Table> parse(const std::string& filename);
 
  private:
+  struct ChunkBlock {
+    uint64_t offset;
+    uint64_t size;
+    uint64_t uncompressed_size;
+  };
+
+  // Reads the chunk directory if the file ends with the footer of format version 2 (see
+  // BinaryWriter::_write_directory).
+  static std::optional<std::pair<std::vector<ChunkBlock>, BlockCompression>> _read_directory(const char* data,
+                                                                                             const size_t size,
+                                                                                             const ChunkID chunk_count);
+
+  static void _append_chunk(Table& table, const Segments& segments,
+                            const std::vector<SortColumnDefinition>& sorted_columns);
+
   /*
    * Reads the header from the given file.
    * Creates an empty table from the extracted information and
    * returns that table and the number of chunks.
    */
-  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(std::ifstream& file);
+  static std::pair<std::shared_ptr<Table>, ChunkID> _read_header(std::istream& file);
 
   /*
    * Creates a chunk from chunk information from the given file and adds it to the given table.
    * The chunk information has the following form:
    *
-   * ----------------
-   * |  Row count   |
-   * |--------------|
-   * |  Segments¹   |
-   * ----------------
+   * ------------------
+   * |   Row count    |
+   * |----------------|
+   * | Sorted columns |
+   * |----------------|
+   * |   Segments¹    |
+   * ------------------
    *
    * ¹Number of columns is provided in the binary header
    */
-  static void _import_chunk(std::ifstream& file, std::shared_ptr<Table>& table);
+  static void _import_chunk(std::istream& file, std::shared_ptr<Table>& table);
+
+  // Reads the information of a single chunk (see _import_chunk) and returns its segments and sort order.
+  static std::pair<Segments, std::vector<SortColumnDefinition>> _read_chunk(std::istream& file, const Table& table);
 
   // Calls the right _import_column<ColumnDataType> depending on the given data_type.
-  static std::shared_ptr<AbstractSegment> _import_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<AbstractSegment> _import_segment(std::istream& file, ChunkOffset row_count,
                                                           DataType data_type, bool column_is_nullable);
 
   template <typename ColumnDataType>
   // Reads the column type from the given file and chooses a segment import function from it.
-  static std::shared_ptr<AbstractSegment> _import_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<AbstractSegment> _import_segment(std::istream& file, ChunkOffset row_count,
                                                           bool column_is_nullable);
 
   template <typename T>
-  static std::shared_ptr<ValueSegment<T>> _import_value_segment(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<ValueSegment<T>> _import_value_segment(std::istream& file, ChunkOffset row_count,
                                                                 bool column_is_nullable);
   template <typename T>
-  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<DictionarySegment<T>> _import_dictionary_segment(std::istream& file, ChunkOffset row_count);
 
   static std::shared_ptr<FixedStringDictionarySegment<pmr_string>> _import_fixed_string_dictionary_segment(
-      std::ifstream& file, ChunkOffset row_count);
+      std::istream& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<RunLengthSegment<T>> _import_run_length_segment(std::istream& file, ChunkOffset row_count);
 
   template <typename T>
-  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(std::ifstream& file,
+  static std::shared_ptr<FrameOfReferenceSegment<T>> _import_frame_of_reference_segment(std::istream& file,
                                                                                         ChunkOffset row_count);
   template <typename T>
-  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(std::ifstream& file, ChunkOffset row_count);
+  static std::shared_ptr<LZ4Segment<T>> _import_lz4_segment(std::istream& file, ChunkOffset row_count);
 
   // Calls the _import_attribute_vector<uintX_t> function that corresponds to the given attribute_vector_width.
-  static std::shared_ptr<BaseCompressedVector> _import_attribute_vector(std::ifstream& file, ChunkOffset row_count,
+  static std::shared_ptr<BaseCompressedVector> _import_attribute_vector(std::istream& file, ChunkOffset row_count,
                                                                         AttributeVectorWidth attribute_vector_width);
 
   static std::unique_ptr<const BaseCompressedVector> _import_offset_value_vector(
-      std::ifstream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width);
+      std::istream& file, ChunkOffset row_count, AttributeVectorWidth attribute_vector_width);
 
-  static std::shared_ptr<FixedStringVector> _import_fixed_string_vector(std::ifstream& file, const size_t count);
+  static std::shared_ptr<FixedStringVector> _import_fixed_string_vector(std::istream& file, const size_t count);
 
   // Reads row_count many values from type T and returns them in a vector
   template <typename T>
-  static pmr_vector<T> _read_values(std::ifstream& file, const size_t count);
+  static pmr_vector<T> _read_values(std::istream& file, const size_t count);
 
   // Reads row_count many strings from input file. String lengths are encoded in type T.
-  static pmr_vector<pmr_string> _read_string_values(std::ifstream& file, const size_t count);
+  static pmr_vector<pmr_string> _read_string_values(std::istream& file, const size_t count);
 
   // Reads a single value of type T from the input file.
   template <typename T>
-  static T _read_value(std::ifstream& file);
+  static T _read_value(std::istream& file);
 };
 
 }  // namespace opossum
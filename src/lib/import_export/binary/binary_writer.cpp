@@ -1,8 +1,15 @@
 #include "binary_writer.hpp"
 
+#include <fcntl.h>
+#include <lz4.h>
+#include <unistd.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <cerrno>
 #include <cstring>
-#include <fstream>
 #include <memory>
+#include <sstream>
 #include <string>
 #include <vector>
 
@@ -13,25 +20,27 @@
 #include "storage/vector_compression/fixed_size_byte_aligned/fixed_size_byte_aligned_vector.hpp"
 
 #include "constant_mappings.hpp"
+#include "hyrise.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
 #include "types.hpp"
 
 namespace {
 
 using namespace opossum;  // NOLINT
 
-// Writes the content of the vector to the ofstream
+// Writes the content of the vector to the ostream
 template <typename T, typename Alloc>
-void export_values(std::ofstream& ofstream, const std::vector<T, Alloc>& values);
+void export_values(std::ostream& ostream, const std::vector<T, Alloc>& values);
 
-/* Writes the given strings to the ofstream. First an array of string lengths is written. After that the strings are
+/* Writes the given strings to the ostream. First an array of string lengths is written. After that the strings are
  * written without any gaps between them.
  * In order to reduce the number of memory allocations we iterate twice over the string vector.
  * After the first iteration we know the number of byte that must be written to the file and can construct a buffer of
  * this size.
  * This approach is indeed faster than a dynamic approach with a stringstream.
  */
-void export_string_values(std::ofstream& ofstream, const pmr_vector<pmr_string>& values) {
+void export_string_values(std::ostream& ostream, const pmr_vector<pmr_string>& values) {
   pmr_vector<size_t> string_lengths(values.size());
   size_t total_length = 0;
 
@@ -41,7 +50,7 @@ void export_string_values(std::ofstream& ofstream, const pmr_vector<pmr_string>&
     total_length += values[i].size();
   }
 
-  export_values(ofstream, string_lengths);
+  export_values(ostream, string_lengths);
 
   // We do not have to iterate over values if all strings are empty.
   if (total_length == 0) return;
@@ -54,59 +63,149 @@ void export_string_values(std::ofstream& ofstream, const pmr_vector<pmr_string>&
     start += str.size();
   }
 
-  export_values(ofstream, buffer);
+  export_values(ostream, buffer);
 }
 
 template <typename T, typename Alloc>
-void export_values(std::ofstream& ofstream, const std::vector<T, Alloc>& values) {
-  ofstream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
+void export_values(std::ostream& ostream, const std::vector<T, Alloc>& values) {
+  ostream.write(reinterpret_cast<const char*>(values.data()), values.size() * sizeof(T));
 }
 
-void export_values(std::ofstream& ofstream, const FixedStringVector& values) {
-  ofstream.write(values.data(), values.size() * values.string_length());
+void export_values(std::ostream& ostream, const FixedStringVector& values) {
+  ostream.write(values.data(), values.size() * values.string_length());
 }
 
 // specialized implementation for string values
 template <>
-void export_values(std::ofstream& ofstream, const pmr_vector<pmr_string>& values) {
-  export_string_values(ofstream, values);
+void export_values(std::ostream& ostream, const pmr_vector<pmr_string>& values) {
+  export_string_values(ostream, values);
 }
 
 // specialized implementation for bool values
 template <typename Alloc>
-void export_values(std::ofstream& ofstream, const std::vector<bool, Alloc>& values) {
+void export_values(std::ostream& ostream, const std::vector<bool, Alloc>& values) {
   // Cast to fixed-size format used in binary file
   const auto writable_bools = pmr_vector<BoolAsByteType>(values.begin(), values.end());
-  export_values(ofstream, writable_bools);
+  export_values(ostream, writable_bools);
 }
 
-// Writes a shallow copy of the given value to the ofstream
+// Writes a shallow copy of the given value to the ostream
 template <typename T>
-void export_value(std::ofstream& ofstream, const T& value) {
-  ofstream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+void export_value(std::ostream& ostream, const T& value) {
+  ostream.write(reinterpret_cast<const char*>(&value), sizeof(T));
 }
 
+std::string compress_block(std::string block, const BlockCompression block_compression) {
+  switch (block_compression) {
+    case BlockCompression::None:
+      return block;
+
+    case BlockCompression::LZ4: {
+      Assert(block.size() <= LZ4_MAX_INPUT_SIZE, "Chunk is too large for LZ4 block compression");
+      const auto block_size = static_cast<int>(block.size());
+      auto compressed_block = std::string(static_cast<size_t>(LZ4_compressBound(block_size)), '\0');
+      const auto compressed_size = LZ4_compress_default(block.data(), compressed_block.data(), block_size,
+                                                        static_cast<int>(compressed_block.size()));
+      Assert(compressed_size > 0, "LZ4 block compression failed");
+      compressed_block.resize(static_cast<size_t>(compressed_size));
+      return compressed_block;
+    }
+
+    case BlockCompression::Zstd: {
+      auto compressed_block = std::string(ZSTD_compressBound(block.size()), '\0');
+      const auto compressed_size = ZSTD_compress(compressed_block.data(), compressed_block.size(), block.data(),
+                                                 block.size(), ZSTD_CLEVEL_DEFAULT);
+      Assert(!ZSTD_isError(compressed_size),
+             "zstd block compression failed: " + std::string{ZSTD_getErrorName(compressed_size)});
+      compressed_block.resize(compressed_size);
+      return compressed_block;
+    }
+  }
+  Fail("Invalid BlockCompression");
+}
+
+// Writes the data at the given position of the file and returns the position after it. As the position is passed
+// explicitly, jobs can write different parts of the file concurrently.
+uint64_t write_at(const int file_descriptor, const std::string& data, const uint64_t offset) {
+  auto written_size = size_t{0};
+  while (written_size < data.size()) {
+    const auto result = pwrite(file_descriptor, data.data() + written_size, data.size() - written_size,
+                               static_cast<off_t>(offset + written_size));
+    Assert(result != -1, "Could not write binary file: " + std::string{std::strerror(errno)});
+    written_size += static_cast<size_t>(result);
+  }
+  return offset + data.size();
+}
+
+// Closes the file descriptor when leaving the scope, also if writing the file failed.
+struct FileCloser {
+  ~FileCloser() { close(file_descriptor); }
+
+  const int file_descriptor;
+};
+
 }  // namespace
 
 namespace opossum {
 
-void BinaryWriter::write(const Table& table, const std::string& filename) {
-  std::ofstream ofstream;
-  ofstream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
-  ofstream.open(filename, std::ios::binary);
+void BinaryWriter::write(const Table& table, const std::string& filename, const BlockCompression block_compression) {
+  const auto file_descriptor = open(filename.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  Assert(file_descriptor != -1, "Could not open '" + filename + "': " + std::string{std::strerror(errno)});
+  const auto file_closer = FileCloser{file_descriptor};
+
+  auto header = std::ostringstream{};
+  _write_header(table, header);
+  auto file_size = write_at(file_descriptor, std::move(header).str(), 0);
+
+  const auto chunk_count = static_cast<size_t>(table.chunk_count());
+  auto block_offsets = std::vector<uint64_t>(chunk_count);
+  auto block_sizes = std::vector<uint64_t>(chunk_count);
+  auto uncompressed_block_sizes = std::vector<uint64_t>(chunk_count);
+
+  for (auto batch_begin = size_t{0}; batch_begin < chunk_count; batch_begin += WRITE_BATCH_CHUNK_COUNT) {
+    const auto batch_end = std::min(batch_begin + WRITE_BATCH_CHUNK_COUNT, chunk_count);
+    auto blocks = std::vector<std::string>(batch_end - batch_begin);
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(blocks.size());
+    for (auto chunk_id = batch_begin; chunk_id < batch_end; ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        const auto chunk = table.get_chunk(ChunkID{static_cast<ChunkID::base_type>(chunk_id)});
+        Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+        auto chunk_stream = std::ostringstream{};
+        chunk_stream.exceptions(std::ostream::failbit | std::ostream::badbit);
+        _write_chunk(table, *chunk, chunk_stream);
+        auto block = std::move(chunk_stream).str();
+        uncompressed_block_sizes[chunk_id] = block.size();
+        blocks[chunk_id - batch_begin] = compress_block(std::move(block), block_compression);
+      }));
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 
-  _write_header(table, ofstream);
+    jobs.clear();
+    for (auto chunk_id = batch_begin; chunk_id < batch_end; ++chunk_id) {
+      block_offsets[chunk_id] = file_size;
+      block_sizes[chunk_id] = blocks[chunk_id - batch_begin].size();
+      file_size += block_sizes[chunk_id];
 
-  for (ChunkID chunk_id{0}; chunk_id < table.chunk_count(); chunk_id++) {
-    _write_chunk(table, ofstream, chunk_id);
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        write_at(file_descriptor, blocks[chunk_id - batch_begin], block_offsets[chunk_id]);
+      }));
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
   }
+
+  auto directory = std::ostringstream{};
+  _write_directory(directory, file_size, block_compression, block_offsets, block_sizes, uncompressed_block_sizes);
+  write_at(file_descriptor, std::move(directory).str(), file_size);
 }
 
-void BinaryWriter::_write_header(const Table& table, std::ofstream& ofstream) {
+void BinaryWriter::_write_header(const Table& table, std::ostream& ostream) {
   const auto target_chunk_size = table.type() == TableType::Data ? table.target_chunk_size() : Chunk::DEFAULT_SIZE;
-  export_value(ofstream, static_cast<ChunkOffset>(target_chunk_size));
-  export_value(ofstream, static_cast<ChunkID::base_type>(table.chunk_count()));
-  export_value(ofstream, static_cast<ColumnID::base_type>(table.column_count()));
+  export_value(ostream, static_cast<ChunkOffset>(target_chunk_size));
+  export_value(ostream, static_cast<ChunkID::base_type>(table.chunk_count()));
+  export_value(ostream, static_cast<ColumnID::base_type>(table.column_count()));
 
   pmr_vector<pmr_string> column_types(table.column_count());
   pmr_vector<pmr_string> column_names(table.column_count());
@@ -118,53 +217,51 @@ void BinaryWriter::_write_header(const Table& table, std::ofstream& ofstream) {
     column_names[column_id] = table.column_name(column_id);
     columns_are_nullable[column_id] = table.column_is_nullable(column_id);
   }
-  export_values(ofstream, column_types);
-  export_values(ofstream, columns_are_nullable);
-  export_string_values(ofstream, column_names);
+  export_values(ostream, column_types);
+  export_values(ostream, columns_are_nullable);
+  export_string_values(ostream, column_names);
 }
 
-void BinaryWriter::_write_chunk(const Table& table, std::ofstream& ofstream, const ChunkID& chunk_id) {
-  const auto chunk = table.get_chunk(chunk_id);
-  Assert(chunk, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
-  export_value(ofstream, static_cast<ChunkOffset>(chunk->size()));
+void BinaryWriter::_write_chunk(const Table& table, const Chunk& chunk, std::ostream& ostream) {
+  export_value(ostream, static_cast<ChunkOffset>(chunk.size()));
 
   // Export sort column definitions
-  const auto& sorted_columns = chunk->individually_sorted_by();
-  export_value(ofstream, static_cast<uint32_t>(sorted_columns.size()));
+  const auto& sorted_columns = chunk.individually_sorted_by();
+  export_value(ostream, static_cast<uint32_t>(sorted_columns.size()));
   for (const auto& [column, sort_mode] : sorted_columns) {
-    export_value(ofstream, column);
-    export_value(ofstream, sort_mode);
+    export_value(ostream, column);
+    export_value(ostream, sort_mode);
   }
 
   // Iterating over all segments of this chunk and exporting them
-  for (ColumnID column_id{0}; column_id < chunk->column_count(); column_id++) {
-    resolve_data_and_segment_type(*chunk->get_segment(column_id),
+  for (ColumnID column_id{0}; column_id < chunk.column_count(); column_id++) {
+    resolve_data_and_segment_type(*chunk.get_segment(column_id),
                                   [&](const auto data_type_t, const auto& resolved_segment) {
-                                    _write_segment(resolved_segment, table.column_is_nullable(column_id), ofstream);
+                                    _write_segment(resolved_segment, table.column_is_nullable(column_id), ostream);
                                   });
   }
 }
 
 template <typename T>
 void BinaryWriter::_write_segment(const ValueSegment<T>& value_segment, bool column_is_nullable,
-                                  std::ofstream& ofstream) {
-  export_value(ofstream, EncodingType::Unencoded);
+                                  std::ostream& ostream) {
+  export_value(ostream, EncodingType::Unencoded);
 
   if (column_is_nullable) {
-    export_value(ofstream, value_segment.is_nullable());
+    export_value(ostream, value_segment.is_nullable());
   }
 
   if (value_segment.is_nullable()) {
-    export_values(ofstream, value_segment.null_values());
+    export_values(ostream, value_segment.null_values());
   }
 
-  export_values(ofstream, value_segment.values());
+  export_values(ostream, value_segment.values());
 }
 
 void BinaryWriter::_write_segment(const ReferenceSegment& reference_segment, bool column_is_nullable,
-                                  std::ofstream& ofstream) {
+                                  std::ostream& ostream) {
   // We materialize reference segments and save them as value segments
-  export_value(ofstream, EncodingType::Unencoded);
+  export_value(ostream, EncodingType::Unencoded);
 
   if (reference_segment.size() == 0) return;
   resolve_data_type(reference_segment.data_type(), [&](auto type) {
@@ -181,154 +278,169 @@ void BinaryWriter::_write_segment(const ReferenceSegment& reference_segment, boo
         values << value.value();
       });
 
-      export_values(ofstream, string_lengths);
-      ofstream << values.rdbuf();
+      export_values(ostream, string_lengths);
+      ostream << values.rdbuf();
 
     } else {
       // Unfortunately, we have to iterate over all values of the reference segment
       // to materialize its contents. Then we can write them to the file
-      iterable.for_each([&](const auto& value) { export_value(ofstream, value.value()); });
+      iterable.for_each([&](const auto& value) { export_value(ostream, value.value()); });
     }
   });
 }
 
 template <typename T>
 void BinaryWriter::_write_segment(const DictionarySegment<T>& dictionary_segment, bool column_is_nullable,
-                                  std::ofstream& ofstream) {
-  export_value(ofstream, EncodingType::Dictionary);
+                                  std::ostream& ostream) {
+  export_value(ostream, EncodingType::Dictionary);
 
   // Write attribute vector width
   const auto attribute_vector_width = _compressed_vector_width<T>(dictionary_segment);
-  export_value(ofstream, static_cast<AttributeVectorWidth>(attribute_vector_width));
+  export_value(ostream, static_cast<AttributeVectorWidth>(attribute_vector_width));
 
   // Write the dictionary size and dictionary
-  export_value(ofstream, static_cast<ValueID::base_type>(dictionary_segment.dictionary()->size()));
-  export_values(ofstream, *dictionary_segment.dictionary());
+  export_value(ostream, static_cast<ValueID::base_type>(dictionary_segment.dictionary()->size()));
+  export_values(ostream, *dictionary_segment.dictionary());
 
   // Write attribute vector
-  _export_compressed_vector(ofstream, *dictionary_segment.compressed_vector_type(),
+  _export_compressed_vector(ostream, *dictionary_segment.compressed_vector_type(),
                             *dictionary_segment.attribute_vector());
 }
 
 template <typename T>
 void BinaryWriter::_write_segment(const FixedStringDictionarySegment<T>& fixed_string_dictionary_segment,
-                                  bool column_is_nullable, std::ofstream& ofstream) {
-  export_value(ofstream, EncodingType::FixedStringDictionary);
+                                  bool column_is_nullable, std::ostream& ostream) {
+  export_value(ostream, EncodingType::FixedStringDictionary);
 
   // Write attribute vector width
   const auto attribute_vector_width = _compressed_vector_width<T>(fixed_string_dictionary_segment);
-  export_value(ofstream, static_cast<AttributeVectorWidth>(attribute_vector_width));
+  export_value(ostream, static_cast<AttributeVectorWidth>(attribute_vector_width));
 
   // Write the dictionary size, string length and dictionary
   const auto dictionary_size = fixed_string_dictionary_segment.fixed_string_dictionary()->size();
   const auto string_length = fixed_string_dictionary_segment.fixed_string_dictionary()->string_length();
-  export_value(ofstream, static_cast<ValueID::base_type>(dictionary_size));
-  export_value(ofstream, static_cast<uint32_t>(string_length));
-  export_values(ofstream, *fixed_string_dictionary_segment.fixed_string_dictionary());
+  export_value(ostream, static_cast<ValueID::base_type>(dictionary_size));
+  export_value(ostream, static_cast<uint32_t>(string_length));
+  export_values(ostream, *fixed_string_dictionary_segment.fixed_string_dictionary());
 
   // Write attribute vector
-  _export_compressed_vector(ofstream, *fixed_string_dictionary_segment.compressed_vector_type(),
+  _export_compressed_vector(ostream, *fixed_string_dictionary_segment.compressed_vector_type(),
                             *fixed_string_dictionary_segment.attribute_vector());
 }
 
 template <typename T>
 void BinaryWriter::_write_segment(const RunLengthSegment<T>& run_length_segment, bool column_is_nullable,
-                                  std::ofstream& ofstream) {
-  export_value(ofstream, EncodingType::RunLength);
+                                  std::ostream& ostream) {
+  export_value(ostream, EncodingType::RunLength);
 
   // Write size and values
-  export_value(ofstream, static_cast<uint32_t>(run_length_segment.values()->size()));
-  export_values(ofstream, *run_length_segment.values());
+  export_value(ostream, static_cast<uint32_t>(run_length_segment.values()->size()));
+  export_values(ostream, *run_length_segment.values());
 
   // Write NULL values
-  export_values(ofstream, *run_length_segment.null_values());
+  export_values(ostream, *run_length_segment.null_values());
 
   // Write end positions
-  export_values(ofstream, *run_length_segment.end_positions());
+  export_values(ostream, *run_length_segment.end_positions());
 }
 
 template <>
 void BinaryWriter::_write_segment(const FrameOfReferenceSegment<int32_t>& frame_of_reference_segment,
-                                  bool column_is_nullable, std::ofstream& ofstream) {
-  export_value(ofstream, EncodingType::FrameOfReference);
+                                  bool column_is_nullable, std::ostream& ostream) {
+  export_value(ostream, EncodingType::FrameOfReference);
 
   // Write attribute vector width
   const auto offset_value_vector_width = _compressed_vector_width<int32_t>(frame_of_reference_segment);
-  export_value(ofstream, static_cast<AttributeVectorWidth>(offset_value_vector_width));
+  export_value(ostream, static_cast<AttributeVectorWidth>(offset_value_vector_width));
 
   // Write number of blocks and block minima
-  export_value(ofstream, static_cast<uint32_t>(frame_of_reference_segment.block_minima().size()));
-  export_values(ofstream, frame_of_reference_segment.block_minima());
+  export_value(ostream, static_cast<uint32_t>(frame_of_reference_segment.block_minima().size()));
+  export_values(ostream, frame_of_reference_segment.block_minima());
 
   // Write flag if optional NULL value vector is written
-  export_value(ofstream, static_cast<BoolAsByteType>(frame_of_reference_segment.null_values().has_value()));
+  export_value(ostream, static_cast<BoolAsByteType>(frame_of_reference_segment.null_values().has_value()));
   if (frame_of_reference_segment.null_values()) {
     // Write NULL values
-    export_values(ofstream, *frame_of_reference_segment.null_values());
+    export_values(ostream, *frame_of_reference_segment.null_values());
   }
 
   // Write offset values
-  _export_compressed_vector(ofstream, *frame_of_reference_segment.compressed_vector_type(),
+  _export_compressed_vector(ostream, *frame_of_reference_segment.compressed_vector_type(),
                             frame_of_reference_segment.offset_values());
 }
 
 template <typename T>
-void BinaryWriter::_write_segment(const LZ4Segment<T>& lz4_segment, bool column_is_nullable, std::ofstream& ofstream) {
-  export_value(ofstream, EncodingType::LZ4);
+void BinaryWriter::_write_segment(const LZ4Segment<T>& lz4_segment, bool column_is_nullable, std::ostream& ostream) {
+  export_value(ostream, EncodingType::LZ4);
 
   // Write num elements (rows in segment)
-  export_value(ofstream, static_cast<uint32_t>(lz4_segment.size()));
+  export_value(ostream, static_cast<uint32_t>(lz4_segment.size()));
 
   // Write number of blocks
-  export_value(ofstream, static_cast<uint32_t>(lz4_segment.lz4_blocks().size()));
+  export_value(ostream, static_cast<uint32_t>(lz4_segment.lz4_blocks().size()));
 
   // Write block size
-  export_value(ofstream, static_cast<uint32_t>(lz4_segment.block_size()));
+  export_value(ostream, static_cast<uint32_t>(lz4_segment.block_size()));
 
   // Write last block size
-  export_value(ofstream, static_cast<uint32_t>(lz4_segment.last_block_size()));
+  export_value(ostream, static_cast<uint32_t>(lz4_segment.last_block_size()));
 
   // Write compressed size for each LZ4 Block
   for (const auto& lz4_block : lz4_segment.lz4_blocks()) {
-    export_value(ofstream, static_cast<uint32_t>(lz4_block.size()));
+    export_value(ostream, static_cast<uint32_t>(lz4_block.size()));
   }
 
   // Write LZ4 Blocks
   for (const auto& lz4_block : lz4_segment.lz4_blocks()) {
-    export_values(ofstream, lz4_block);
+    export_values(ostream, lz4_block);
   }
 
   if (lz4_segment.null_values()) {
     // Write NULL value size
-    export_value(ofstream, static_cast<uint32_t>(lz4_segment.null_values()->size()));
+    export_value(ostream, static_cast<uint32_t>(lz4_segment.null_values()->size()));
     // Write NULL values
-    export_values(ofstream, *lz4_segment.null_values());
+    export_values(ostream, *lz4_segment.null_values());
   } else {
     // No NULL values
-    export_value(ofstream, uint32_t{0});
+    export_value(ostream, uint32_t{0});
   }
 
   // Write dictionary size
-  export_value(ofstream, static_cast<uint32_t>(lz4_segment.dictionary().size()));
+  export_value(ostream, static_cast<uint32_t>(lz4_segment.dictionary().size()));
 
   // Write dictionary
-  export_values(ofstream, lz4_segment.dictionary());
+  export_values(ostream, lz4_segment.dictionary());
 
   if (lz4_segment.string_offsets()) {
     // Write string_offset size
-    export_value(ofstream, static_cast<uint32_t>(lz4_segment.string_offsets()->size()));
+    export_value(ostream, static_cast<uint32_t>(lz4_segment.string_offsets()->size()));
     // Write string_offset data_size
-    export_value(ofstream,
+    export_value(ostream,
                  static_cast<uint32_t>(
                      dynamic_cast<const SimdBp128Vector&>(*lz4_segment.string_offsets()).data().size()));
     // Write string offsets
-    _export_compressed_vector(ofstream, *lz4_segment.compressed_vector_type(), *(lz4_segment.string_offsets()));
+    _export_compressed_vector(ostream, *lz4_segment.compressed_vector_type(), *(lz4_segment.string_offsets()));
   } else {
     // Write string_offset size = 0
-    export_value(ofstream, uint32_t{0});
+    export_value(ostream, uint32_t{0});
   }
 }
 
+void BinaryWriter::_write_directory(std::ostream& ostream, const uint64_t directory_offset,
+                                    const BlockCompression block_compression,
+                                    const std::vector<uint64_t>& block_offsets,
+                                    const std::vector<uint64_t>& block_sizes,
+                                    const std::vector<uint64_t>& uncompressed_block_sizes) {
+  export_values(ostream, block_offsets);
+  export_values(ostream, block_sizes);
+  export_values(ostream, uncompressed_block_sizes);
+
+  export_value(ostream, directory_offset);
+  export_value(ostream, block_compression);
+  export_value(ostream, FORMAT_VERSION);
+  ostream.write(MAGIC, sizeof(MAGIC));
+}
+
 template <typename T>
 uint32_t BinaryWriter::_compressed_vector_width(const AbstractEncodedSegment& abstract_encoded_segment) {
   uint32_t vector_width = 0u;
@@ -351,20 +463,20 @@ uint32_t BinaryWriter::_compressed_vector_width(const AbstractEncodedSegment& ab
   return vector_width;
 }
 
-void BinaryWriter::_export_compressed_vector(std::ofstream& ofstream, const CompressedVectorType type,
+void BinaryWriter::_export_compressed_vector(std::ostream& ostream, const CompressedVectorType type,
                                              const BaseCompressedVector& compressed_vector) {
   switch (type) {
     case CompressedVectorType::FixedSize4ByteAligned:
-      export_values(ofstream, dynamic_cast<const FixedSizeByteAlignedVector<uint32_t>&>(compressed_vector).data());
+      export_values(ostream, dynamic_cast<const FixedSizeByteAlignedVector<uint32_t>&>(compressed_vector).data());
       return;
     case CompressedVectorType::FixedSize2ByteAligned:
-      export_values(ofstream, dynamic_cast<const FixedSizeByteAlignedVector<uint16_t>&>(compressed_vector).data());
+      export_values(ostream, dynamic_cast<const FixedSizeByteAlignedVector<uint16_t>&>(compressed_vector).data());
       return;
     case CompressedVectorType::FixedSize1ByteAligned:
-      export_values(ofstream, dynamic_cast<const FixedSizeByteAlignedVector<uint8_t>&>(compressed_vector).data());
+      export_values(ostream, dynamic_cast<const FixedSizeByteAlignedVector<uint8_t>&>(compressed_vector).data());
       return;
     case CompressedVectorType::SimdBp128:
-      export_values(ofstream, dynamic_cast<const SimdBp128Vector&>(compressed_vector).data());
+      export_values(ostream, dynamic_cast<const SimdBp128Vector&>(compressed_vector).data());
       return;
     default:
       Fail("Any other type should have been caught before.");
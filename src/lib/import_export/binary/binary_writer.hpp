@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <ostream>
 #include <string>
 #include <vector>
 
@@ -18,13 +19,46 @@ namespace opossum {
 class BaseCompressedVector;
 enum class CompressedVectorType : uint8_t;
 
+// Compression of the chunk blocks of a binary file, independent of the encoding of the segments. zstd achieves higher
+// compression ratios, which is useful for rarely loaded tables, while LZ4 decompresses faster.
+enum class BlockCompression : uint8_t { None, LZ4, Zstd };
+
 class BinaryWriter {
+  friend class CheckpointWriter;
+
  public:
-  static void write(const Table& table, const std::string& filename);
+  static constexpr char MAGIC[8] = {'H', 'Y', 'R', 'T', 'A', 'B', 'L', '\0'};
+  static constexpr uint32_t FORMAT_VERSION = 2;
+  static constexpr auto FOOTER_SIZE = sizeof(uint64_t) + sizeof(BlockCompression) + sizeof(uint32_t) + sizeof(MAGIC);
+
+  // Maximum number of serialized chunks that are held in memory at once while writing
+  static constexpr auto WRITE_BATCH_CHUNK_COUNT = size_t{64};
+
+  /**
+   * Writes the table into a binary file of the following form:
+   *
+   * ---------------------
+   * |  Header           |
+   * |-------------------|
+   * |  Chunk blocks¹    |
+   * |-------------------|
+   * |  Chunk directory  |
+   * |-------------------|
+   * |  Footer           |
+   * ---------------------
+   *
+   * ¹ Each block contains one chunk as written by _write_chunk, compressed according to block_compression.
+   *
+   * The chunks are serialized and compressed by parallel jobs. As soon as the sizes of a batch of blocks are known, the
+   * blocks are written to their positions in the file in parallel, too. Files of format version 1 only consisted of
+   * the header and the uncompressed chunks. BinaryParser still reads them.
+   */
+  static void write(const Table& table, const std::string& filename,
+                    const BlockCompression block_compression = BlockCompression::None);
 
  private:
   /**
-   * This methods writes the header of this table into the given ofstream.
+   * This methods writes the header of this table into the given ostream.
    *
    * Description                 | Type                                | Size in bytes
    * --------------------------------------------------------------------------------------------------------
@@ -36,10 +70,10 @@ class BinaryWriter {
    * Column name lengths         | size_t array                        | Column Count * 1
    * Column names                | std::string array                   | Sum of lengths of all names
    */
-  static void _write_header(const Table& table, std::ofstream& ofstream);
+  static void _write_header(const Table& table, std::ostream& ostream);
 
   /**
-   * Writes the contents of the chunk into the given ofstream.
+   * Writes the contents of the chunk into the given ostream.
    * First, it creates a chunk header with the following contents:
    *
    * Description                 | Type                                | Size in bytes
@@ -50,8 +84,10 @@ class BinaryWriter {
    *
    * Next, it dumps the contents of the segments in the respective format (depending on the type
    * of the segment, such as ValueSegment, ReferenceSegment, DictionarySegment, RunLengthSegment).
+   *
+   * The chunk does not need to be part of the table, which only provides the column definitions.
    */
-  static void _write_chunk(const Table& table, std::ofstream& ofstream, const ChunkID& chunk_id);
+  static void _write_chunk(const Table& table, const Chunk& chunk, std::ostream& ostream);
 
   /**
    * ValueSegments are dumped with the following layout:
@@ -74,7 +110,7 @@ class BinaryWriter {
    * ^: These fields are only written if the type of the column IS a string.
    */
   template <typename T>
-  static void _write_segment(const ValueSegment<T>& value_segment, bool column_is_nullable, std::ofstream& ofstream);
+  static void _write_segment(const ValueSegment<T>& value_segment, bool column_is_nullable, std::ostream& ostream);
 
   /**
    * ReferenceSegments are dumped with the following layout, which is similar to value segments:
@@ -93,7 +129,7 @@ class BinaryWriter {
    * °: This field is writen if the type of the column is NOT a string
    */
   static void _write_segment(const ReferenceSegment& reference_segment, bool column_is_nullable,
-                             std::ofstream& ofstream);
+                             std::ostream& ostream);
 
   /**
    * DictionarySegments are dumped with the following layout:
@@ -116,7 +152,7 @@ class BinaryWriter {
    */
   template <typename T>
   static void _write_segment(const DictionarySegment<T>& dictionary_segment, bool column_is_nullable,
-                             std::ofstream& ofstream);
+                             std::ostream& ostream);
 
   /**
    * FixedStringDictionarySegments are dumped with the following layout:
@@ -135,7 +171,7 @@ class BinaryWriter {
    */
   template <typename T>
   static void _write_segment(const FixedStringDictionarySegment<T>& fixed_string_dictionary_segment,
-                             bool column_is_nullable, std::ofstream& ofstream);
+                             bool column_is_nullable, std::ostream& ostream);
 
   /**
    * RunLengthSegments are dumped with the following layout:
@@ -153,7 +189,7 @@ class BinaryWriter {
    */
   template <typename T>
   static void _write_segment(const RunLengthSegment<T>& run_length_segment, bool column_is_nullable,
-                             std::ofstream& ofstream);
+                             std::ostream& ostream);
 
   /**
    * FrameOfReferenceSegments are dumped with the following layout:
@@ -175,7 +211,7 @@ class BinaryWriter {
    */
   template <typename T>
   static void _write_segment(const FrameOfReferenceSegment<T>& frame_of_reference_segment, bool column_is_nullable,
-                             std::ofstream& ofstream);
+                             std::ostream& ostream);
 
   /**
    * LZ4Segments are dumped with the following layout:
@@ -204,13 +240,31 @@ class BinaryWriter {
    * ²: These fields are only written if string offset size is not 0
    */
   template <typename T>
-  static void _write_segment(const LZ4Segment<T>& lz4_segment, bool column_is_nullable, std::ofstream& ofstream);
+  static void _write_segment(const LZ4Segment<T>& lz4_segment, bool column_is_nullable, std::ostream& ostream);
+
+  /**
+   * Writes the chunk directory, which allows to read the chunk blocks independently of each other, and the footer:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Block offsets               | uint64_t array                      | Chunk count * 8
+   * Block sizes                 | uint64_t array                      | Chunk count * 8
+   * Uncompressed block sizes    | uint64_t array                      | Chunk count * 8
+   * Chunk directory offset      | uint64_t                            | 8
+   * Block compression           | BlockCompression                    | 1
+   * Format version              | uint32_t                            | 4
+   * Magic                       | char array                          | 8
+   */
+  static void _write_directory(std::ostream& ostream, const uint64_t directory_offset,
+                               const BlockCompression block_compression, const std::vector<uint64_t>& block_offsets,
+                               const std::vector<uint64_t>& block_sizes,
+                               const std::vector<uint64_t>& uncompressed_block_sizes);
 
   template <typename T>
   static uint32_t _compressed_vector_width(const AbstractEncodedSegment& abstract_encoded_segment);
 
   // Chooses the right Compressed Vector depending on the CompressedVectorType and exports it.
-  static void _export_compressed_vector(std::ofstream& ofstream, const CompressedVectorType type,
+  static void _export_compressed_vector(std::ostream& ostream, const CompressedVectorType type,
                                         const BaseCompressedVector& compressed_vector);
 
   template <typename T>
@@ -1,15 +1,20 @@
 #pragma once
 
 #include <algorithm>
+#include <cctype>
+#include <charconv>
 #include <cstdlib>
-#include <functional>
 #include <memory>
 #include <string>
+#include <string_view>
+#include <type_traits>
 #include <utility>
 
 #include <boost/algorithm/string.hpp>
 
+#include "constant_mappings.hpp"
 #include "csv_meta.hpp"
+#include "resolve_type.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/value_segment.hpp"
 #include "types.hpp"
@@ -18,8 +23,8 @@
 namespace opossum {
 
 /*
- * CsvConverter is a helper class that creates a ValueSegment by converting the given null terminated strings and placing
- * them at the given position.
+ * CsvConverter is a helper class that creates a ValueSegment by converting the given CSV fields and placing them at the
+ * given position.
  * The base class BaseCsvConverter allows us to handle different types of columns uniformly.
  */
 
@@ -27,8 +32,9 @@ class BaseCsvConverter {
  public:
   virtual ~BaseCsvConverter() = default;
 
-  // Converts value to the underlying data type and saves it at the given position.
-  virtual void insert(std::string& value, ChunkOffset position) = 0;
+  // Converts value to the underlying data type and saves it at the given position. Only quoted fields are copied for
+  // unescaping, all other fields are converted in place.
+  virtual void insert(std::string_view value, ChunkOffset position) = 0;
 
   // Returns the segment that contains the previously converted values.
   // After the call of finish, no other operation should be called.
@@ -49,13 +55,13 @@ class CsvConverter : public BaseCsvConverter {
   explicit CsvConverter(ChunkOffset size, const ParseConfig& config = {}, bool is_nullable = false)
       : _parsed_values(size), _null_values(size, false), _is_nullable(is_nullable), _config(config) {}
 
-  void insert(std::string& value, ChunkOffset position) override {
-    if (_is_nullable && value.length() == 0) {
+  void insert(std::string_view value, ChunkOffset position) override {
+    if (_is_nullable && value.empty()) {
       _null_values[position] = true;
       return;
     }
 
-    if (boost::to_lower_copy(value) == ParseConfig::NULL_STRING) {
+    if (boost::iequals(value, ParseConfig::NULL_STRING)) {
       Assert(_config.null_handling != NullHandling::RejectNullStrings,
              "Unquoted null found in CSV file. Quote it for string literal \"null\", leave field empty for null "
              "value, or set 'null_handling' to the appropriate strategy in parse config.");
@@ -65,20 +71,19 @@ class CsvConverter : public BaseCsvConverter {
       }
     }
 
-    // clang-format off
-    if constexpr(std::is_same_v<T, pmr_string>) {
-      unescape(value, _config);
-    } else {  // NOLINT
-      // clang-format on
-      if (_config.reject_quoted_nonstrings) {
-        Assert(value == unescape_copy(value, _config),
-               "Unexpected quoted string " + value + " encountered in non-string column");
-      } else {
-        unescape(value, _config);
-      }
+    if (value.empty() || value.front() != _config.quote) {
+      _parsed_values[position] = _convert(value);
+      return;
     }
 
-    _parsed_values[position] = _get_conversion_function()(value);
+    if constexpr (!std::is_same_v<T, pmr_string>) {
+      Assert(!_config.reject_quoted_nonstrings,
+             "Unexpected quoted string " + std::string{value} + " encountered in non-string column");
+    }
+
+    auto unescaped_value = std::string{value};
+    unescape(unescaped_value, _config);
+    _parsed_values[position] = _convert(unescaped_value);
   }
 
   std::unique_ptr<AbstractSegment> finish() override {
@@ -91,61 +96,61 @@ class CsvConverter : public BaseCsvConverter {
 
  private:
   /*
-   * Returns a conversion function that converts from a string to type T.
-   * This function is defined for each type that can be stored in a ValueSegment.
+   * Converts an unescaped field to type T. Numbers are parsed with std::from_chars, which neither allocates nor
+   * depends on the locale.
    * The assumption is that only csv fields of type string must be unescaped because other types cannot contain special
    * csv characters.
    */
-  std::function<T(const std::string&)> _get_conversion_function();
+  static T _convert(std::string_view value);
+
   pmr_vector<T> _parsed_values;
   pmr_vector<bool> _null_values;
   const bool _is_nullable;
   ParseConfig _config;
 };
 
-template <>
-inline std::function<int32_t(const std::string&)> CsvConverter<int32_t>::_get_conversion_function() {
-  return [](const std::string& str) {
-    size_t pos;
-    auto converted = std::stoi(str, &pos);
-    Assert(pos == str.size(), "Unprocessed characters found while converting to int: " + str);
-    return converted;
-  };
-}
-
-template <>
-inline std::function<int64_t(const std::string&)> CsvConverter<int64_t>::_get_conversion_function() {
-  return [](const std::string& str) {
-    size_t pos;
-    auto converted = static_cast<int64_t>(std::stoll(str, &pos));
-    Assert(pos == str.size(), "Unprocessed characters found while converting to long: " + str);
-    return converted;
-  };
-}
-
-template <>
-inline std::function<float(const std::string&)> CsvConverter<float>::_get_conversion_function() {
-  return [](const std::string& str) {
-    size_t pos;
-    auto converted = std::stof(str, &pos);
-    Assert(pos == str.size(), "Unprocessed characters found while converting to float: " + str);
-    return converted;
-  };
-}
-
-template <>
-inline std::function<double(const std::string&)> CsvConverter<double>::_get_conversion_function() {
-  return [](const std::string& str) {
-    size_t pos;
-    auto converted = std::stod(str, &pos);
-    Assert(pos == str.size(), "Unprocessed characters found while converting to double: " + str);
-    return converted;
-  };
+template <typename T>
+inline T CsvConverter<T>::_convert(std::string_view value) {
+  const auto& type_name = data_type_to_string.left.at(data_type_from_type<T>());
+
+  // Unlike the std::sto* functions, std::from_chars does not accept leading whitespace or a leading plus sign.
+  const auto first_character = std::find_if_not(value.begin(), value.end(), [](const char character) {
+    return std::isspace(static_cast<unsigned char>(character));
+  });
+  value.remove_prefix(static_cast<size_t>(first_character - value.begin()));
+  if (value.size() > 1 && value[0] == '+' && value[1] != '-') value.remove_prefix(1);
+
+  // Some standard libraries, e.g., libc++ on macOS, do not implement std::from_chars for floating-point numbers.
+#ifdef __cpp_lib_to_chars
+  constexpr auto use_from_chars = true;
+#else
+  constexpr auto use_from_chars = !std::is_floating_point_v<T>;
+#endif
+
+  auto converted = T{};
+  if constexpr (use_from_chars) {
+    const auto [end, error] = std::from_chars(value.data(), value.data() + value.size(), converted);
+    Assert(error == std::errc{}, "Could not convert to " + type_name + ": " + std::string{value});
+    Assert(end == value.data() + value.size(),
+           "Unprocessed characters found while converting to " + type_name + ": " + std::string{value});
+  } else {
+    const auto string = std::string{value};
+    auto* end = static_cast<char*>(nullptr);
+    if constexpr (std::is_same_v<T, float>) {
+      converted = std::strtof(string.c_str(), &end);
+    } else {
+      converted = std::strtod(string.c_str(), &end);
+    }
+    Assert(end != string.c_str(), "Could not convert to " + type_name + ": " + string);
+    Assert(end == string.c_str() + string.size(),
+           "Unprocessed characters found while converting to " + type_name + ": " + string);
+  }
+  return converted;
 }
 
 template <>
-inline std::function<pmr_string(const std::string&)> CsvConverter<pmr_string>::_get_conversion_function() {
-  return [](const std::string& str) { return pmr_string{str}; };
+inline pmr_string CsvConverter<pmr_string>::_convert(std::string_view value) {
+  return pmr_string{value};
 }
 
 }  // namespace opossum
@@ -1,6 +1,7 @@
 #include "csv_parser.hpp"
 
-#include <fstream>
+#include <algorithm>
+#include <cstring>
 #include <list>
 #include <memory>
 #include <optional>
@@ -15,14 +16,36 @@
 #include "import_export/csv/csv_meta.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/job_task.hpp"
+#include "storage/chunk_encoder.hpp"
 #include "storage/table.hpp"
 #include "utils/assert.hpp"
-#include "utils/load_table.hpp"
+#include "utils/memory_mapped_file.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Whether one of the eight bytes of the word equals the given byte (see "Determine if a word has a byte equal to n" in
+// Sean Eron Anderson's Bit Twiddling Hacks). This allows the search for row ends to skip eight characters at once.
+bool contains_byte(const uint64_t word, const char byte) {
+  constexpr auto LOW_BITS = uint64_t{0x0101010101010101};
+  constexpr auto HIGH_BITS = uint64_t{0x8080808080808080};
+  const auto difference = word ^ (LOW_BITS * static_cast<uint8_t>(byte));
+  return ((difference - LOW_BITS) & ~difference & HIGH_BITS) != 0;
+}
+
+// Make sure to "toggle" the quote state ONLY if the quotes are not part of the string (i.e. escaped)
+bool is_escaped_quote(std::string_view csv_content, const size_t position, const ParseConfig& config) {
+  return config.quote != config.escape && position != 0 && csv_content[position - 1] == config.escape;
+}
+
+}  // namespace
 
 namespace opossum {
 
 std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const ChunkOffset chunk_size,
-                                        const std::optional<CsvMeta>& csv_meta) {
+                                        const std::optional<CsvMeta>& csv_meta,
+                                        const std::optional<ChunkEncodingSpec>& chunk_encoding_spec) {
   // If no meta info is given as a parameter, look for a json file
   CsvMeta meta;
   if (csv_meta == std::nullopt) {
@@ -34,67 +57,118 @@ std::shared_ptr<Table> CsvParser::parse(const std::string& filename, const Chunk
   auto escaped_linebreak = std::string(1, meta.config.delimiter_escape) + std::string(1, meta.config.delimiter);
 
   auto table = _create_table_from_meta(chunk_size, meta);
+  Assert(!chunk_encoding_spec || chunk_encoding_spec->size() == table->column_count(),
+         "Number of segment encodings does not match number of columns.");
 
-  std::ifstream csvfile{filename};
+  const auto csv_file = MemoryMappedFile{filename};
+  const auto csv_content = std::string_view{csv_file.data(), csv_file.size()};
 
   // return empty table if input file is empty
-  if (!csvfile || csvfile.peek() == EOF || csvfile.peek() == '\r' || csvfile.peek() == '\n') return table;
-
-  {
-    std::string line;
-    std::getline(csvfile, line);
-    Assert(line.find('\r') == std::string::npos, "Windows encoding is not supported, use dos2unix");
-  }
+  if (csv_content.empty() || csv_content.front() == '\r' || csv_content.front() == '\n') return table;
 
-  /**
-   * Load the whole file(!) into a std::string using the, hopefully, fastest method to do so.
-   * TODO(anybody) Maybe use mmap() in the future. The current approach needs to have the entire file in RAM, mmap might
-   *               be cleverer, dunno.
-   */
-  csvfile.seekg(0, std::ios::end);
-  const auto csvfile_size = csvfile.tellg();
-  std::string content(csvfile_size, ' ');
-  csvfile.seekg(0);
-  csvfile.read(content.data(), csvfile_size);
+  Assert(csv_content.substr(0, csv_content.find('\n')).find('\r') == std::string_view::npos,
+         "Windows encoding is not supported, use dos2unix");
 
-  // make sure content ends with a delimiter for better row processing later
-  if (content.back() != meta.config.delimiter) content.push_back(meta.config.delimiter);
+  const auto target_chunk_size = static_cast<size_t>(table->target_chunk_size());
 
-  std::string_view content_view{content.c_str(), content.size()};
+  // Row ends that are not assigned to a chunk yet and the start of the first of these rows
+  auto pending_row_ends = std::vector<size_t>{};
+  auto chunk_begin = size_t{0};
+  auto in_quotes = false;
 
-  // Save chunks in list to avoid memory relocation
+  // Save chunks in list to avoid memory relocation. The parsing tasks of a window finish while the row ends of the
+  // next window are searched. Only then, their chunks are appended and their part of the file is released.
   std::list<Segments> segments_by_chunks;
-  std::vector<std::shared_ptr<AbstractTask>> tasks;
-  std::vector<size_t> field_ends;
-  std::mutex append_chunk_mutex;
-  while (_find_fields_in_chunk(content_view, *table, field_ends, meta)) {
-    // create empty chunk
-    segments_by_chunks.emplace_back();
-    auto& segments = segments_by_chunks.back();
-
-    // Only pass the part of the string that is actually needed to the parsing task
-    std::string_view relevant_content = content_view.substr(0, field_ends.back());
-
-    // Remove processed part of the csv content
-    content_view = content_view.substr(field_ends.back() + 1);
-
-    // create and start parsing task to fill chunk
-    tasks.emplace_back(std::make_shared<JobTask>([relevant_content, field_ends, &table, &segments, &meta,
-                                                  &escaped_linebreak, &append_chunk_mutex]() {
-      _parse_into_chunk(relevant_content, field_ends, *table, segments, meta, escaped_linebreak, append_chunk_mutex);
-    }));
-    tasks.back()->schedule();
-  }
+  auto parse_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto previous_parse_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto released_end = size_t{0};
+  auto parsed_end = size_t{0};
+
+  const auto append_parsed_chunks = [&]() {
+    Hyrise::get().scheduler()->wait_for_tasks(previous_parse_tasks);
+    for (auto chunk_idx = size_t{0}; chunk_idx < previous_parse_tasks.size(); ++chunk_idx) {
+      auto& segments = segments_by_chunks.front();
+      DebugAssert(!segments.empty(), "Empty chunks shouldn't occur when importing CSV");
+      const auto mvcc_data = std::make_shared<MvccData>(segments.front()->size(), CommitID{0});
+      table->append_chunk(segments, mvcc_data);
+      table->last_chunk()->finalize();
+      segments_by_chunks.pop_front();
+    }
+
+    csv_file.dont_need(released_end, parsed_end - released_end);
+    released_end = parsed_end;
+    previous_parse_tasks = std::move(parse_tasks);
+    parse_tasks.clear();
+
+    // If the last row does not end with a delimiter, chunk_begin is one past the end of the file.
+    parsed_end = std::min(chunk_begin, csv_content.size());
+  };
+
+  for (auto window_begin = size_t{0}; window_begin < csv_content.size(); window_begin += WINDOW_SIZE) {
+    const auto window_end = std::min(window_begin + WINDOW_SIZE, csv_content.size());
+    csv_file.will_need(window_begin, window_end - window_begin);
+
+    // Search the row ends of all blocks of the window in parallel.
+    const auto block_count = (window_end - window_begin + BLOCK_SIZE - 1) / BLOCK_SIZE;
+    auto row_ends_by_block = std::vector<BlockRowEnds>(block_count);
+    auto search_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+    search_tasks.reserve(block_count);
+    for (auto block_id = size_t{0}; block_id < block_count; ++block_id) {
+      const auto block_begin = window_begin + block_id * BLOCK_SIZE;
+      const auto block_end = std::min(block_begin + BLOCK_SIZE, window_end);
+      search_tasks.emplace_back(std::make_shared<JobTask>([&, block_id, block_begin, block_end]() {
+        row_ends_by_block[block_id] = _find_row_ends_in_block(csv_content, block_begin, block_end, meta);
+      }));
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(search_tasks);
+
+    for (const auto& block_row_ends : row_ends_by_block) {
+      const auto& row_ends =
+          in_quotes ? block_row_ends.row_ends_inside_quotes : block_row_ends.row_ends_outside_quotes;
+      pending_row_ends.insert(pending_row_ends.end(), row_ends.begin(), row_ends.end());
+      in_quotes ^= block_row_ends.has_odd_quote_count;
+    }
 
-  Hyrise::get().scheduler()->wait_for_tasks(tasks);
+    // The last row does not need to end with a delimiter.
+    const auto is_last_window = window_end == csv_content.size();
+    if (is_last_window && csv_content.back() != meta.config.delimiter) pending_row_ends.push_back(csv_content.size());
+
+    // Create a parsing task for each complete chunk. Remaining rows are part of the next window's first chunk, unless
+    // this is the last window.
+    auto row_idx = size_t{0};
+    while (pending_row_ends.size() - row_idx >= target_chunk_size ||
+           (is_last_window && row_idx < pending_row_ends.size())) {
+      const auto row_count = std::min(target_chunk_size, pending_row_ends.size() - row_idx);
+      const auto chunk_end = pending_row_ends[row_idx + row_count - 1];
+
+      // Only pass the part of the file that is actually needed to the parsing task, with row ends relative to it.
+      const auto csv_chunk = csv_content.substr(chunk_begin, chunk_end - chunk_begin);
+      auto row_ends = std::vector<size_t>(row_count);
+      for (auto chunk_offset = size_t{0}; chunk_offset < row_count; ++chunk_offset) {
+        row_ends[chunk_offset] = pending_row_ends[row_idx + chunk_offset] - chunk_begin;
+      }
+      row_idx += row_count;
+      chunk_begin = chunk_end + 1;
+
+      // create empty chunk
+      segments_by_chunks.emplace_back();
+      auto& segments = segments_by_chunks.back();
+
+      // create and start parsing task to fill chunk
+      parse_tasks.emplace_back(std::make_shared<JobTask>([csv_chunk, row_ends = std::move(row_ends), &table,
+                                                          &segments, &meta, &escaped_linebreak,
+                                                          &chunk_encoding_spec]() {
+        _parse_into_chunk(csv_chunk, row_ends, *table, segments, meta, escaped_linebreak, chunk_encoding_spec);
+      }));
+      parse_tasks.back()->schedule();
+    }
+    pending_row_ends.erase(pending_row_ends.begin(), pending_row_ends.begin() + static_cast<int64_t>(row_idx));
 
-  for (auto& segments : segments_by_chunks) {
-    DebugAssert(!segments.empty(), "Empty chunks shouldn't occur when importing CSV");
-    const auto mvcc_data = std::make_shared<MvccData>(segments.front()->size(), CommitID{0});
-    table->append_chunk(segments, mvcc_data);
-    table->last_chunk()->finalize();
+    append_parsed_chunks();
   }
 
+  append_parsed_chunks();
+
   return table;
 }
 
@@ -121,65 +195,50 @@ std::shared_ptr<Table> CsvParser::_create_table_from_meta(const ChunkOffset chun
   return std::make_shared<Table>(column_definitions, TableType::Data, chunk_size, UseMvcc::Yes);
 }
 
-bool CsvParser::_find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends,
-                                      const CsvMeta& meta) {
-  field_ends.clear();
-  if (csv_content.empty()) {
-    return false;
-  }
-
-  std::string search_for{meta.config.separator, meta.config.delimiter, meta.config.quote};
-
-  size_t from = 0;
-  unsigned int rows = 0;
-  unsigned int field_count = 1;
-  bool in_quotes = false;
-  while (rows < table.target_chunk_size()) {
-    // Find either of row separator, column delimiter, quote identifier
-    auto pos = csv_content.find_first_of(search_for, from);
-    if (std::string::npos == pos) {
-      break;
-    }
-    from = pos + 1;
-    const char elem = csv_content[pos];
-
-    // Make sure to "toggle" in_quotes ONLY if the quotes are not part of the string (i.e. escaped)
-    if (elem == meta.config.quote) {
-      bool quote_is_escaped = false;
-      if (meta.config.quote != meta.config.escape) {
-        quote_is_escaped = pos != 0 && csv_content[pos - 1] == meta.config.escape;
-      }
-      if (!quote_is_escaped) {
-        in_quotes = !in_quotes;
+CsvParser::BlockRowEnds CsvParser::_find_row_ends_in_block(std::string_view csv_content, const size_t begin,
+                                                           const size_t end, const CsvMeta& meta) {
+  auto block_row_ends = BlockRowEnds{};
+  const auto& config = meta.config;
+
+  auto position = begin;
+  while (position < end) {
+    // Skip words that contain neither a quote nor a delimiter.
+    if (position + sizeof(uint64_t) <= end) {
+      auto word = uint64_t{};
+      std::memcpy(&word, csv_content.data() + position, sizeof(word));
+      if (!contains_byte(word, config.quote) && !contains_byte(word, config.delimiter)) {
+        position += sizeof(uint64_t);
+        continue;
       }
     }
 
-    // Determine if delimiter marks end of row or is part of the (string) value
-    if (elem == meta.config.delimiter && !in_quotes) {
-      DebugAssert(field_count == static_cast<size_t>(table.column_count()),
-                  "Number of CSV fields does not match number of columns.");
-      ++rows;
-      field_count = 0;
-    }
-
-    // Determine if separator marks end of field or is part of the (string) value
-    if (in_quotes || elem == meta.config.quote) {
-      continue;
+    const auto word_end = std::min(position + sizeof(uint64_t), end);
+    for (; position < word_end; ++position) {
+      const auto character = csv_content[position];
+      if (character == config.quote) {
+        if (!is_escaped_quote(csv_content, position, config)) {
+          block_row_ends.has_odd_quote_count = !block_row_ends.has_odd_quote_count;
+        }
+      } else if (character == config.delimiter) {
+        // Determine if delimiter marks end of row or is part of the (string) value, depending on the quote state at
+        // the start of the block.
+        auto& row_ends = block_row_ends.has_odd_quote_count ? block_row_ends.row_ends_inside_quotes
+                                                            : block_row_ends.row_ends_outside_quotes;
+        row_ends.push_back(position);
+      }
     }
-
-    ++field_count;
-    field_ends.push_back(pos);
   }
 
-  return true;
+  return block_row_ends;
 }
 
-size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends,
+size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& row_ends,
                                     const Table& table, Segments& segments, const CsvMeta& meta,
-                                    const std::string& escaped_linebreak, std::mutex& append_chunk_mutex) {
+                                    const std::string& escaped_linebreak,
+                                    const std::optional<ChunkEncodingSpec>& chunk_encoding_spec) {
   // For each csv column, create a CsvConverter which builds up a ValueSegment
   const auto column_count = table.column_count();
-  const auto row_count = field_ends.size() / column_count;
+  const auto row_count = row_ends.size();
   std::vector<std::unique_ptr<BaseCsvConverter>> converters;
 
   for (ColumnID column_id{0}; column_id < column_count; ++column_id) {
@@ -193,39 +252,60 @@ size_t CsvParser::_parse_into_chunk(std::string_view csv_chunk, const std::vecto
     });
   }
 
-  Assert(field_ends.size() == row_count * column_count, "Unexpected number of fields");
-
-  size_t start = 0;
   size_t row_id = 0;
-  size_t field_idx = 0;
   ColumnID column_id{0};
 
+  const auto insert_field = [&](const size_t begin, const size_t end) {
+    Assert(column_id < column_count, "Number of CSV fields does not match number of columns.");
+    const auto field = csv_chunk.substr(begin, end - begin);
+
+    // CSV fields not following RFC 4810 might need some preprocessing
+    if (!meta.config.rfc_mode && field.find(escaped_linebreak) != std::string_view::npos) {
+      auto sanitized_field = std::string{field};
+      _sanitize_field(sanitized_field, meta, escaped_linebreak);
+      converters[column_id]->insert(sanitized_field, static_cast<ChunkOffset>(row_id));
+    } else {
+      converters[column_id]->insert(field, static_cast<ChunkOffset>(row_id));
+    }
+    ++column_id;
+  };
+
   try {
+    auto row_begin = size_t{0};
     for (; row_id < row_count; ++row_id) {
-      for (column_id = ColumnID{0}; column_id < column_count; ++column_id, ++field_idx) {
-        const auto end = field_ends[field_idx];
-        auto field = std::string{csv_chunk.substr(start, end - start)};
-        start = end + 1;
-
-        if (!meta.config.rfc_mode) {
-          // CSV fields not following RFC 4810 might need some preprocessing
-          _sanitize_field(field, meta, escaped_linebreak);
+      const auto row_end = row_ends[row_id];
+      column_id = ColumnID{0};
+
+      // Determine if separator marks end of field or is part of the (string) value
+      auto field_begin = row_begin;
+      auto in_quotes = false;
+      for (auto position = row_begin; position < row_end; ++position) {
+        const auto character = csv_chunk[position];
+        if (character == meta.config.quote) {
+          if (!is_escaped_quote(csv_chunk, position, meta.config)) in_quotes = !in_quotes;
+        } else if (character == meta.config.separator && !in_quotes) {
+          insert_field(field_begin, position);
+          field_begin = position + 1;
         }
-
-        converters[column_id]->insert(field, static_cast<ChunkOffset>(row_id));
       }
+      insert_field(field_begin, row_end);
+      Assert(column_id == column_count, "Number of CSV fields does not match number of columns.");
+
+      row_begin = row_end + 1;
     }
   } catch (const std::exception& exception) {
     throw std::logic_error("Exception while parsing CSV, row " + std::to_string(row_id) + ", column " +
                            std::to_string(column_id) + ":\n" + exception.what());
   }
 
-  // Transform the field_offsets to segments and add segments to chunk.
-  {
-    std::lock_guard<std::mutex> lock(append_chunk_mutex);
-    for (auto& converter : converters) {
-      segments.push_back(converter->finish());
+  // Transform the converted values to segments, encode them if requested, and add segments to chunk.
+  for (auto segment_column_id = ColumnID{0}; segment_column_id < column_count; ++segment_column_id) {
+    auto segment = std::shared_ptr<AbstractSegment>{converters[segment_column_id]->finish()};
+    if (chunk_encoding_spec) {
+      segment = ChunkEncoder::encode_segment(segment, table.column_data_type(segment_column_id),
+                                             (*chunk_encoding_spec)[segment_column_id]);
     }
+    segments.push_back(segment);
   }
 
   return row_count;
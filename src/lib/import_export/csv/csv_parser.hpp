@@ -7,6 +7,7 @@
 #include <vector>
 
 #include "import_export/csv/csv_meta.hpp"
+#include "storage/encoding_type.hpp"
 
 namespace opossum {
 
@@ -21,48 +22,67 @@ class Chunk;
  * For non-RFC 4180, all linebreaks within quoted strings are further escaped with an escape character.
  * For the structure of the meta csv file see export_csv.hpp
  *
- * This parser reads the whole csv file and iterates over it to separate the data into chunks that are aligned with the
- * csv rows.
- * Each data chunk is parsed and converted into a opossum chunk. In the end all chunks are combined to the final table.
+ * The csv file is memory-mapped and processed in windows of WINDOW_SIZE bytes, so that the file is never loaded into
+ * RAM as a whole:
+ *  1. The row ends of a window are searched in parallel in blocks of BLOCK_SIZE bytes. As a block might start within a
+ *     quoted field, each block records the row ends for both cases together with whether it contains an odd number of
+ *     quotes. The blocks are then combined in order, which determines the quote state at the start of each block.
+ *  2. Each chunk's rows are parsed by a separate task that writes the fields directly into ValueSegments and, if
+ *     requested, encodes them.
+ *  3. Once the tasks of a window have finished, its pages are released.
+ * In the end all chunks are combined to the final table.
  */
 class CsvParser {
  public:
+  static constexpr auto WINDOW_SIZE = size_t{64} * 1024 * 1024;
+  static constexpr auto BLOCK_SIZE = size_t{1024} * 1024;
+
   /*
-   * @param filename      Path to the input file.
-   * @param csv_meta      Custom csv meta information which will be used instead of the default "filename" + ".json" meta.
-   * @returns             The table that was created from the csv file.
+   * @param filename             Path to the input file.
+   * @param csv_meta             Custom csv meta information which will be used instead of the default "filename" +
+   *                             ".json" meta.
+   * @param chunk_encoding_spec  Optional encoding of the segments, applied while the chunks are parsed.
+   * @returns                    The table that was created from the csv file.
    */
   static std::shared_ptr<Table> parse(const std::string& filename, const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE,
-                                      const std::optional<CsvMeta>& csv_meta = std::nullopt);
+                                      const std::optional<CsvMeta>& csv_meta = std::nullopt,
+                                      const std::optional<ChunkEncodingSpec>& chunk_encoding_spec = std::nullopt);
   static std::shared_ptr<Table> create_table_from_meta_file(const std::string& filename,
                                                             const ChunkOffset chunk_size = Chunk::DEFAULT_SIZE);
 
  protected:
+  // Row ends that were found in a block of BLOCK_SIZE bytes for both possible quote states at the block's start
+  struct BlockRowEnds {
+    std::vector<size_t> row_ends_outside_quotes;
+    std::vector<size_t> row_ends_inside_quotes;
+    bool has_odd_quote_count{false};
+  };
+
   /*
    * Use the meta information stored in _meta to create a new table with according column description.
    */
   static std::shared_ptr<Table> _create_table_from_meta(const ChunkOffset chunk_size, const CsvMeta& meta);
 
   /*
-   * @param      csv_content String_view on the remaining content of the CSV.
-   * @param      table       Empty table created by _process_meta_file.
-   * @param[out] field_ends  Empty vector, to be filled with positions of the field ends for one chunk found in \p
-   * csv_content.
-   * @returns                False if \p csv_content is empty or chunk_size set to 0, True otherwise.
+   * @param csv_content  The complete content of the CSV. Characters before \p begin are only read to detect escaped
+   *                     quotes.
+   * @param begin        Start of the block.
+   * @param end          End of the block.
+   * @returns            The positions of the unquoted delimiters in [begin, end).
    */
-  static bool _find_fields_in_chunk(std::string_view csv_content, const Table& table, std::vector<size_t>& field_ends,
-                                    const CsvMeta& meta);
+  static BlockRowEnds _find_row_ends_in_block(std::string_view csv_content, const size_t begin, const size_t end,
+                                              const CsvMeta& meta);
 
   /*
-   * @param      csv_chunk  String_view on one chunk of the CSV.
-   * @param      field_ends Positions of the field ends of the given \p csv_chunk.
+   * @param      csv_chunk  String_view on the rows of one chunk, starting at the chunk's first row.
+   * @param      row_ends   Positions of the row ends of the given \p csv_chunk.
    * @param      table      Empty table created by _process_meta_file.
    * @param[out] segments   The segments of the chunk, to be populated with data
    * @returns               The number of rows in the chunk
    */
-  static size_t _parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& field_ends, const Table& table,
+  static size_t _parse_into_chunk(std::string_view csv_chunk, const std::vector<size_t>& row_ends, const Table& table,
                                   Segments& segments, const CsvMeta& meta, const std::string& escaped_linebreak,
-                                  std::mutex& append_chunk_mutex);
+                                  const std::optional<ChunkEncodingSpec>& chunk_encoding_spec);
 
   /*
    * @param field The field that needs to be modified to be RFC 4180 compliant.
@@ -29,6 +29,8 @@ FileType file_type_from_filename(const std::string& filename) {
     return FileType::Tbl;
   } else if (extension == ".bin") {
     return FileType::Binary;
+  } else if (extension == ".parquet") {
+    return FileType::Parquet;
   }
   Fail("Unknown file extension " + extension);
 }
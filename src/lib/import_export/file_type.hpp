@@ -4,7 +4,7 @@
 
 namespace opossum {
 
-enum class FileType { Csv, Tbl, Binary, Auto };
+enum class FileType { Csv, Tbl, Binary, Parquet, Auto };
 
 FileType import_type_to_file_type(const hsql::ImportType import_type);
 
@@ -0,0 +1,461 @@
+#include "parquet_metadata.hpp"
+
+#include <algorithm>
+#include <cstring>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <utility>
+
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+constexpr auto PARQUET_MAGIC = std::string_view{"PAR1"};
+
+// Field types of the Thrift compact protocol
+enum class ThriftType : uint8_t {
+  Stop = 0,
+  BooleanTrue = 1,
+  BooleanFalse = 2,
+  Byte = 3,
+  I16 = 4,
+  I32 = 5,
+  I64 = 6,
+  Double = 7,
+  Binary = 8,
+  List = 9,
+  Set = 10,
+  Map = 11,
+  Struct = 12
+};
+
+/*
+ * Decodes values serialized with the Thrift compact protocol (see
+ * https://github.com/apache/thrift/blob/master/doc/specs/thrift-compact-protocol.md). Structs are read field by field:
+ * read_struct passes the ID and type of each field to a callback, which either reads the value or skips it.
+ */
+class ThriftCompactReader {
+ public:
+  ThriftCompactReader(const char* data, const size_t size) : _position(data), _end(data + size), _begin(data) {}
+
+  size_t bytes_read() const { return static_cast<size_t>(_position - _begin); }
+
+  template <typename Functor>
+  void read_struct(const Functor& field_functor) {
+    auto last_field_id = int16_t{0};
+    while (true) {
+      const auto header = _read_byte();
+      const auto type = ThriftType{static_cast<uint8_t>(header & 0x0F)};
+      if (type == ThriftType::Stop) return;
+
+      const auto field_id_delta = static_cast<int16_t>(header >> 4);
+      const auto field_id =
+          field_id_delta != 0 ? static_cast<int16_t>(last_field_id + field_id_delta) : static_cast<int16_t>(read_int());
+      last_field_id = field_id;
+
+      // Boolean fields carry their value in the type.
+      if (type == ThriftType::BooleanTrue || type == ThriftType::BooleanFalse) {
+        _last_boolean = type == ThriftType::BooleanTrue;
+      }
+      field_functor(field_id, type);
+    }
+  }
+
+  // Reads the header of a list and calls the functor once for each element, which has to read or skip it.
+  template <typename Functor>
+  void read_list(const Functor& element_functor) {
+    const auto header = _read_byte();
+    const auto element_type = ThriftType{static_cast<uint8_t>(header & 0x0F)};
+    auto size = static_cast<size_t>(header >> 4);
+    if (size == 15) size = _read_varint();
+
+    for (auto element_index = size_t{0}; element_index < size; ++element_index) {
+      element_functor(element_type);
+    }
+  }
+
+  // Reads a zigzag-encoded integer of type i16, i32, or i64.
+  int64_t read_int() {
+    const auto value = _read_varint();
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+  }
+
+  template <typename Enum>
+  Enum read_enum() {
+    return Enum{static_cast<std::underlying_type_t<Enum>>(read_int())};
+  }
+
+  std::string read_binary() {
+    const auto size = _read_varint();
+    Assert(size <= static_cast<size_t>(_end - _position), "Unexpected end of Parquet metadata");
+    auto value = std::string(_position, size);
+    _position += size;
+    return value;
+  }
+
+  // Returns the value of the last boolean field.
+  bool read_boolean() const { return _last_boolean; }
+
+  void skip(const ThriftType type, const bool in_collection = false) {
+    switch (type) {
+      case ThriftType::BooleanTrue:
+      case ThriftType::BooleanFalse:
+        // Booleans in lists, sets, and maps take a byte, boolean fields do not take any.
+        if (in_collection) _read_byte();
+        return;
+      case ThriftType::Byte:
+        _read_byte();
+        return;
+      case ThriftType::I16:
+      case ThriftType::I32:
+      case ThriftType::I64:
+        _read_varint();
+        return;
+      case ThriftType::Double:
+        Assert(_end - _position >= 8, "Unexpected end of Parquet metadata");
+        _position += 8;
+        return;
+      case ThriftType::Binary:
+        read_binary();
+        return;
+      case ThriftType::List:
+      case ThriftType::Set:
+        read_list([&](const auto element_type) { skip(element_type, true); });
+        return;
+      case ThriftType::Map: {
+        const auto size = _read_varint();
+        if (size == 0) return;
+        const auto types = _read_byte();
+        for (auto entry_index = size_t{0}; entry_index < size; ++entry_index) {
+          skip(ThriftType{static_cast<uint8_t>(types >> 4)}, true);
+          skip(ThriftType{static_cast<uint8_t>(types & 0x0F)}, true);
+        }
+        return;
+      }
+      case ThriftType::Struct:
+        read_struct([&](const auto /*field_id*/, const auto field_type) { skip(field_type); });
+        return;
+      case ThriftType::Stop:
+        break;
+    }
+    Fail("Invalid Thrift type in Parquet metadata");
+  }
+
+ private:
+  uint8_t _read_byte() {
+    Assert(_position < _end, "Unexpected end of Parquet metadata");
+    return static_cast<uint8_t>(*_position++);
+  }
+
+  uint64_t _read_varint() {
+    auto value = uint64_t{0};
+    for (auto shift = 0; shift < 64; shift += 7) {
+      const auto byte = _read_byte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return value;
+    }
+    Fail("Invalid varint in Parquet metadata");
+  }
+
+  const char* _position;
+  const char* const _end;
+  const char* const _begin;
+  bool _last_boolean{false};
+};
+
+ParquetStatistics read_statistics(ThriftCompactReader& reader) {
+  auto statistics = ParquetStatistics{};
+  // The deprecated fields max (1) and min (2) are only used if max_value (5) and min_value (6) are not present.
+  auto deprecated_min = std::optional<std::string>{};
+  auto deprecated_max = std::optional<std::string>{};
+  reader.read_struct([&](const auto field_id, const auto type) {
+    switch (field_id) {
+      case 1:
+        deprecated_max = reader.read_binary();
+        break;
+      case 2:
+        deprecated_min = reader.read_binary();
+        break;
+      case 3:
+        statistics.null_count = reader.read_int();
+        break;
+      case 4:
+        statistics.distinct_count = reader.read_int();
+        break;
+      case 5:
+        statistics.max = reader.read_binary();
+        break;
+      case 6:
+        statistics.min = reader.read_binary();
+        break;
+      default:
+        reader.skip(type);
+    }
+  });
+
+  if (!statistics.min && !statistics.max) {
+    statistics.min = std::move(deprecated_min);
+    statistics.max = std::move(deprecated_max);
+    statistics.min_max_are_deprecated = statistics.min || statistics.max;
+  }
+  return statistics;
+}
+
+ParquetColumnChunk read_column_metadata(ThriftCompactReader& reader) {
+  auto column_chunk = ParquetColumnChunk{};
+  reader.read_struct([&](const auto field_id, const auto type) {
+    switch (field_id) {
+      case 4:
+        column_chunk.codec = reader.read_enum<ParquetCodec>();
+        break;
+      case 5:
+        column_chunk.value_count = reader.read_int();
+        break;
+      case 7:
+        column_chunk.total_compressed_size = reader.read_int();
+        break;
+      case 9:
+        column_chunk.data_page_offset = reader.read_int();
+        break;
+      case 11:
+        column_chunk.dictionary_page_offset = reader.read_int();
+        break;
+      case 12:
+        column_chunk.statistics = read_statistics(reader);
+        break;
+      default:
+        reader.skip(type);
+    }
+  });
+  return column_chunk;
+}
+
+ParquetColumnChunk read_column_chunk(ThriftCompactReader& reader) {
+  auto column_chunk = std::optional<ParquetColumnChunk>{};
+  reader.read_struct([&](const auto field_id, const auto type) {
+    switch (field_id) {
+      case 1:
+        Fail("Parquet column chunks in separate files are not supported");
+      case 3:
+        column_chunk = read_column_metadata(reader);
+        break;
+      default:
+        reader.skip(type);
+    }
+  });
+  Assert(column_chunk, "Parquet column chunk without metadata");
+  return *column_chunk;
+}
+
+ParquetRowGroup read_row_group(ThriftCompactReader& reader) {
+  auto row_group = ParquetRowGroup{};
+  reader.read_struct([&](const auto field_id, const auto type) {
+    switch (field_id) {
+      case 1:
+        reader.read_list([&](const auto /*element_type*/) {
+          row_group.column_chunks.emplace_back(read_column_chunk(reader));
+        });
+        break;
+      case 3:
+        row_group.row_count = reader.read_int();
+        break;
+      default:
+        reader.skip(type);
+    }
+  });
+  return row_group;
+}
+
+struct SchemaElement {
+  std::string name;
+  std::optional<ParquetPhysicalType> type;
+  ParquetRepetition repetition{ParquetRepetition::Required};
+  int32_t child_count{0};
+};
+
+SchemaElement read_schema_element(ThriftCompactReader& reader) {
+  auto schema_element = SchemaElement{};
+  reader.read_struct([&](const auto field_id, const auto type) {
+    switch (field_id) {
+      case 1:
+        schema_element.type = reader.read_enum<ParquetPhysicalType>();
+        break;
+      case 3:
+        schema_element.repetition = reader.read_enum<ParquetRepetition>();
+        break;
+      case 4:
+        schema_element.name = reader.read_binary();
+        break;
+      case 5:
+        schema_element.child_count = static_cast<int32_t>(reader.read_int());
+        break;
+      default:
+        reader.skip(type);
+    }
+  });
+  return schema_element;
+}
+
+// The schema is a tree in depth-first order. Its root is the first element. We only support flat schemas, where all
+// other elements are primitive children of the root.
+std::vector<ParquetColumn> columns_from_schema(const std::vector<SchemaElement>& schema) {
+  Assert(!schema.empty(), "Parquet schema is empty");
+  Assert(static_cast<size_t>(schema.front().child_count) + 1 == schema.size(),
+         "Nested Parquet schemas are not supported");
+
+  auto columns = std::vector<ParquetColumn>{};
+  columns.reserve(schema.size() - 1);
+  for (auto element_iter = schema.begin() + 1; element_iter != schema.end(); ++element_iter) {
+    Assert(element_iter->type && element_iter->child_count == 0, "Nested Parquet schemas are not supported");
+    Assert(element_iter->repetition != ParquetRepetition::Repeated,
+           "Repeated Parquet column " + element_iter->name + " is not supported");
+    const auto nullable = element_iter->repetition == ParquetRepetition::Optional;
+    columns.emplace_back(ParquetColumn{element_iter->name, *element_iter->type, nullable});
+  }
+  return columns;
+}
+
+}  // namespace
+
+namespace opossum {
+
+int64_t ParquetColumnChunk::first_page_offset() const {
+  // Some writers set the dictionary page offset to zero if there is no dictionary page.
+  if (dictionary_page_offset && *dictionary_page_offset > 0) return std::min(*dictionary_page_offset, data_page_offset);
+  return data_page_offset;
+}
+
+ParquetFileMetadata read_parquet_file_metadata(const char* data, const size_t size) {
+  // A Parquet file starts with the magic bytes and ends with the metadata, its size (4 bytes), and the magic bytes.
+  const auto footer_size = sizeof(uint32_t) + PARQUET_MAGIC.size();
+  Assert(size >= PARQUET_MAGIC.size() + footer_size && std::string_view(data, PARQUET_MAGIC.size()) == PARQUET_MAGIC &&
+             std::string_view(data + size - PARQUET_MAGIC.size(), PARQUET_MAGIC.size()) == PARQUET_MAGIC,
+         "File is not a Parquet file");
+
+  auto metadata_size = uint32_t{0};
+  std::memcpy(&metadata_size, data + size - footer_size, sizeof(metadata_size));
+  Assert(metadata_size <= size - PARQUET_MAGIC.size() - footer_size, "Invalid Parquet metadata size");
+
+  auto reader = ThriftCompactReader{data + size - footer_size - metadata_size, metadata_size};
+  auto metadata = ParquetFileMetadata{};
+  auto schema = std::vector<SchemaElement>{};
+  reader.read_struct([&](const auto field_id, const auto type) {
+    switch (field_id) {
+      case 2:
+        reader.read_list([&](const auto /*element_type*/) { schema.emplace_back(read_schema_element(reader)); });
+        break;
+      case 3:
+        metadata.row_count = reader.read_int();
+        break;
+      case 4:
+        reader.read_list(
+            [&](const auto /*element_type*/) { metadata.row_groups.emplace_back(read_row_group(reader)); });
+        break;
+      default:
+        reader.skip(type);
+    }
+  });
+
+  metadata.columns = columns_from_schema(schema);
+  for (const auto& row_group : metadata.row_groups) {
+    Assert(row_group.column_chunks.size() == metadata.columns.size(),
+           "Number of Parquet column chunks does not match the schema");
+  }
+  return metadata;
+}
+
+std::pair<ParquetPageHeader, size_t> read_parquet_page_header(const char* data, const size_t size) {
+  auto reader = ThriftCompactReader{data, size};
+  auto page_header = ParquetPageHeader{};
+
+  const auto read_data_page_header = [&]() {
+    reader.read_struct([&](const auto field_id, const auto type) {
+      switch (field_id) {
+        case 1:
+          page_header.value_count = static_cast<int32_t>(reader.read_int());
+          break;
+        case 2:
+          page_header.encoding = reader.read_enum<ParquetEncoding>();
+          break;
+        case 3:
+          page_header.definition_level_encoding = reader.read_enum<ParquetEncoding>();
+          break;
+        default:
+          reader.skip(type);
+      }
+    });
+  };
+
+  const auto read_dictionary_page_header = [&]() {
+    reader.read_struct([&](const auto field_id, const auto type) {
+      switch (field_id) {
+        case 1:
+          page_header.value_count = static_cast<int32_t>(reader.read_int());
+          break;
+        case 2:
+          page_header.encoding = reader.read_enum<ParquetEncoding>();
+          break;
+        default:
+          reader.skip(type);
+      }
+    });
+  };
+
+  const auto read_data_page_header_v2 = [&]() {
+    reader.read_struct([&](const auto field_id, const auto type) {
+      switch (field_id) {
+        case 1:
+          page_header.value_count = static_cast<int32_t>(reader.read_int());
+          break;
+        case 4:
+          page_header.encoding = reader.read_enum<ParquetEncoding>();
+          break;
+        case 5:
+          page_header.definition_levels_size = static_cast<int32_t>(reader.read_int());
+          break;
+        case 6:
+          page_header.repetition_levels_size = static_cast<int32_t>(reader.read_int());
+          break;
+        case 7:
+          page_header.values_are_compressed = reader.read_boolean();
+          break;
+        default:
+          reader.skip(type);
+      }
+    });
+  };
+
+  reader.read_struct([&](const auto field_id, const auto type) {
+    switch (field_id) {
+      case 1:
+        page_header.type = reader.read_enum<ParquetPageType>();
+        break;
+      case 2:
+        page_header.uncompressed_size = static_cast<int32_t>(reader.read_int());
+        break;
+      case 3:
+        page_header.compressed_size = static_cast<int32_t>(reader.read_int());
+        break;
+      case 5:
+        read_data_page_header();
+        break;
+      case 7:
+        read_dictionary_page_header();
+        break;
+      case 8:
+        read_data_page_header_v2();
+        break;
+      default:
+        reader.skip(type);
+    }
+  });
+
+  Assert(page_header.compressed_size >= 0 && page_header.uncompressed_size >= 0, "Invalid Parquet page header");
+  return {page_header, reader.bytes_read()};
+}
+
+}  // namespace opossum
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace opossum {
+
+/*
+ * Subset of the metadata of Apache Parquet files (see https://github.com/apache/parquet-format) that is needed to read
+ * files with a flat schema. Parquet serializes its metadata with the Thrift compact protocol. The functions below
+ * decode it without depending on Thrift and skip all fields that are not represented here. Enum values match those of
+ * the Parquet specification.
+ */
+
+enum class ParquetPhysicalType : int32_t {
+  Boolean = 0,
+  Int32 = 1,
+  Int64 = 2,
+  Int96 = 3,
+  Float = 4,
+  Double = 5,
+  ByteArray = 6,
+  FixedLenByteArray = 7
+};
+
+enum class ParquetRepetition : int32_t { Required = 0, Optional = 1, Repeated = 2 };
+
+enum class ParquetCodec : int32_t {
+  Uncompressed = 0,
+  Snappy = 1,
+  Gzip = 2,
+  Lzo = 3,
+  Brotli = 4,
+  Lz4 = 5,
+  Zstd = 6,
+  Lz4Raw = 7
+};
+
+enum class ParquetEncoding : int32_t {
+  Plain = 0,
+  PlainDictionary = 2,
+  Rle = 3,
+  BitPacked = 4,
+  DeltaBinaryPacked = 5,
+  DeltaLengthByteArray = 6,
+  DeltaByteArray = 7,
+  RleDictionary = 8,
+  ByteStreamSplit = 9
+};
+
+enum class ParquetPageType : int32_t { DataPage = 0, IndexPage = 1, DictionaryPage = 2, DataPageV2 = 3 };
+
+// Minimum and maximum are PLAIN-encoded values without the length prefix of byte arrays.
+struct ParquetStatistics {
+  std::optional<std::string> min;
+  std::optional<std::string> max;
+  std::optional<int64_t> null_count;
+  std::optional<int64_t> distinct_count;
+
+  // Set if minimum and maximum stem from the deprecated fields, which used a signed byte order for byte arrays.
+  bool min_max_are_deprecated{false};
+};
+
+struct ParquetColumnChunk {
+  ParquetCodec codec{ParquetCodec::Uncompressed};
+  int64_t value_count{0};
+  int64_t total_compressed_size{0};
+  int64_t data_page_offset{0};
+  std::optional<int64_t> dictionary_page_offset;
+  ParquetStatistics statistics;
+
+  // Offset of the first page of the column chunk, which is the dictionary page if there is one.
+  int64_t first_page_offset() const;
+};
+
+struct ParquetRowGroup {
+  int64_t row_count{0};
+  std::vector<ParquetColumnChunk> column_chunks;
+};
+
+struct ParquetColumn {
+  std::string name;
+  ParquetPhysicalType type{ParquetPhysicalType::Int32};
+  bool nullable{false};
+};
+
+struct ParquetFileMetadata {
+  int64_t row_count{0};
+  std::vector<ParquetColumn> columns;
+  std::vector<ParquetRowGroup> row_groups;
+};
+
+struct ParquetPageHeader {
+  ParquetPageType type{ParquetPageType::DataPage};
+  int32_t uncompressed_size{0};
+  int32_t compressed_size{0};
+
+  // Number of values of the page, including NULLs, or number of entries of a dictionary page
+  int32_t value_count{0};
+  ParquetEncoding encoding{ParquetEncoding::Plain};
+  ParquetEncoding definition_level_encoding{ParquetEncoding::Rle};
+
+  // Only set for pages of type DataPageV2, whose levels are stored uncompressed in front of the values.
+  int32_t definition_levels_size{0};
+  int32_t repetition_levels_size{0};
+  bool values_are_compressed{true};
+};
+
+// Reads the metadata from the footer of the file that was mapped to [data, data + size).
+ParquetFileMetadata read_parquet_file_metadata(const char* data, const size_t size);
+
+// Reads the page header that starts at data and returns it together with its size in bytes.
+std::pair<ParquetPageHeader, size_t> read_parquet_page_header(const char* data, const size_t size);
+
+}  // namespace opossum
@@ -0,0 +1,752 @@
+#include "parquet_parser.hpp"
+
+#include <lz4.h>
+#include <zstd.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <numeric>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <magic_enum.hpp>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/generic_histogram.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/null_value_ratio_statistics.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/foreign_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/value_segment.hpp"
+#include "storage/vector_compression/vector_compression.hpp"
+#include "utils/assert.hpp"
+#include "utils/memory_mapped_file.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Run of rows that share the same value, given as an index into DecodedColumnChunk::values, or that are NULL
+struct ValueRun {
+  uint32_t value_index;
+  ChunkOffset length;
+};
+
+constexpr auto NULL_VALUE_INDEX = std::numeric_limits<uint32_t>::max();
+
+void append_run(std::vector<ValueRun>& runs, const uint32_t value_index, const ChunkOffset length) {
+  if (!runs.empty() && runs.back().value_index == value_index) {
+    runs.back().length += length;
+  } else {
+    runs.emplace_back(ValueRun{value_index, length});
+  }
+}
+
+// Values and rows of a column chunk. The values hold the dictionary of the column chunk (if there is one), followed by
+// the values of PLAIN-encoded pages. The rows are represented as runs of indexes into the values.
+template <typename T>
+struct DecodedColumnChunk {
+  pmr_vector<T> values;
+  size_t dictionary_size{0};
+  bool has_plain_pages{false};
+  std::vector<ValueRun> runs;
+};
+
+uint64_t read_varint(const char*& data, const char* end) {
+  auto value = uint64_t{0};
+  for (auto shift = 0; shift < 64; shift += 7) {
+    Assert(data < end, "Unexpected end of Parquet page");
+    const auto byte = static_cast<uint8_t>(*data++);
+    value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+    if ((byte & 0x80) == 0) return value;
+  }
+  Fail("Invalid varint in Parquet page");
+}
+
+// Decompresses data in the raw Snappy format (see https://github.com/google/snappy/blob/main/format_description.txt),
+// which Parquet uses without the framing format. The data consists of literals and copies of earlier output.
+void snappy_decompress(const char* data, const size_t size, char* output, const size_t output_size) {
+  const auto* const end = data + size;
+  Assert(read_varint(data, end) == output_size, "Unexpected uncompressed size of Snappy data");
+
+  auto output_position = size_t{0};
+  while (data < end) {
+    const auto tag = static_cast<uint8_t>(*data++);
+    if ((tag & 0x03) == 0) {
+      // Literals of up to 60 bytes store their length in the tag, longer ones in the following one to four bytes.
+      auto length = static_cast<size_t>(tag >> 2) + 1;
+      if (length > 60) {
+        const auto length_byte_count = length - 60;
+        Assert(static_cast<size_t>(end - data) >= length_byte_count, "Invalid Snappy data");
+        length = 0;
+        for (auto byte_index = size_t{0}; byte_index < length_byte_count; ++byte_index) {
+          length |= static_cast<size_t>(static_cast<uint8_t>(data[byte_index])) << (8 * byte_index);
+        }
+        length += 1;
+        data += length_byte_count;
+      }
+      Assert(static_cast<size_t>(end - data) >= length && output_size - output_position >= length,
+             "Invalid Snappy data");
+      std::memcpy(output + output_position, data, length);
+      data += length;
+      output_position += length;
+      continue;
+    }
+
+    auto length = size_t{0};
+    auto offset = size_t{0};
+    const auto offset_byte_count = (tag & 0x03) == 1 ? size_t{1} : (tag & 0x03) == 2 ? size_t{2} : size_t{4};
+    Assert(static_cast<size_t>(end - data) >= offset_byte_count, "Invalid Snappy data");
+    for (auto byte_index = size_t{0}; byte_index < offset_byte_count; ++byte_index) {
+      offset |= static_cast<size_t>(static_cast<uint8_t>(data[byte_index])) << (8 * byte_index);
+    }
+    data += offset_byte_count;
+    if ((tag & 0x03) == 1) {
+      // Copies with a one-byte offset store three further bits of the offset and the length (4 to 11) in the tag.
+      length = static_cast<size_t>((tag >> 2) & 0x07) + 4;
+      offset |= static_cast<size_t>(tag >> 5) << 8;
+    } else {
+      length = static_cast<size_t>(tag >> 2) + 1;
+    }
+
+    Assert(offset > 0 && offset <= output_position && output_size - output_position >= length, "Invalid Snappy data");
+    // The source and the destination overlap if the offset is smaller than the length, e.g., to repeat a byte. Thus,
+    // the bytes are copied one by one.
+    for (auto byte_index = size_t{0}; byte_index < length; ++byte_index) {
+      output[output_position + byte_index] = output[output_position - offset + byte_index];
+    }
+    output_position += length;
+  }
+  Assert(output_position == output_size, "Invalid Snappy data");
+}
+
+// Returns the uncompressed data of a page. If it needs to be decompressed, it is decompressed into the buffer.
+std::string_view decompress_page(const ParquetCodec codec, const char* data, const size_t size,
+                                 const size_t uncompressed_size, std::vector<char>& buffer) {
+  if (codec == ParquetCodec::Uncompressed) {
+    Assert(size == uncompressed_size, "Size of uncompressed Parquet page does not match");
+    return {data, size};
+  }
+
+  buffer.resize(uncompressed_size);
+  switch (codec) {
+    case ParquetCodec::Snappy:
+      snappy_decompress(data, size, buffer.data(), uncompressed_size);
+      break;
+    case ParquetCodec::Lz4Raw: {
+      const auto decompressed_size = LZ4_decompress_safe(data, buffer.data(), static_cast<int>(size),
+                                                         static_cast<int>(uncompressed_size));
+      Assert(decompressed_size >= 0 && static_cast<size_t>(decompressed_size) == uncompressed_size,
+             "LZ4 page decompression failed");
+      break;
+    }
+    case ParquetCodec::Zstd: {
+      const auto decompressed_size = ZSTD_decompress(buffer.data(), uncompressed_size, data, size);
+      Assert(!ZSTD_isError(decompressed_size) && decompressed_size == uncompressed_size,
+             "zstd page decompression failed");
+      break;
+    }
+    default:
+      Fail("Parquet compression codec " + std::string{magic_enum::enum_name(codec)} + " is not supported");
+  }
+  return {buffer.data(), uncompressed_size};
+}
+
+/*
+ * Decodes value_count values of the RLE/bit-packed hybrid encoding, which Parquet uses for definition levels and
+ * dictionary indexes, and passes them to run_functor(value, length). The encoding consists of runs that repeat a value
+ * and of groups of eight bit-packed values. Bit-packed values are passed as runs of length one.
+ */
+template <typename Functor>
+void decode_rle_bit_packed_hybrid(const char* data, const char* end, const uint32_t bit_width, size_t value_count,
+                                  const Functor& run_functor) {
+  Assert(bit_width <= 32, "Invalid bit width in Parquet page");
+  const auto value_byte_count = static_cast<size_t>((bit_width + 7) / 8);
+  const auto value_mask = (uint64_t{1} << bit_width) - 1;
+
+  while (value_count > 0) {
+    const auto header = read_varint(data, end);
+    const auto count = static_cast<size_t>(header >> 1);
+    Assert(count > 0, "Empty run in Parquet page");
+
+    if ((header & 1) == 0) {
+      // Repeated value, stored little-endian in the smallest number of bytes
+      Assert(static_cast<size_t>(end - data) >= value_byte_count, "Unexpected end of Parquet page");
+      auto value = uint32_t{0};
+      std::memcpy(&value, data, value_byte_count);
+      data += value_byte_count;
+
+      const auto run_length = std::min(count, value_count);
+      run_functor(value, static_cast<ChunkOffset>(run_length));
+      value_count -= run_length;
+      continue;
+    }
+
+    // The count is the number of groups. The last group might be padded.
+    const auto byte_count = count * bit_width;
+    Assert(static_cast<size_t>(end - data) >= byte_count, "Unexpected end of Parquet page");
+    const auto bit_packed_value_count = std::min(count * 8, value_count);
+
+    const auto* byte = data;
+    auto buffer = uint64_t{0};
+    auto buffered_bit_count = uint32_t{0};
+    for (auto value_index = size_t{0}; value_index < bit_packed_value_count; ++value_index) {
+      while (buffered_bit_count < bit_width) {
+        buffer |= static_cast<uint64_t>(static_cast<uint8_t>(*byte++)) << buffered_bit_count;
+        buffered_bit_count += 8;
+      }
+      run_functor(static_cast<uint32_t>(buffer & value_mask), ChunkOffset{1});
+      buffer >>= bit_width;
+      buffered_bit_count -= bit_width;
+    }
+
+    data += byte_count;
+    value_count -= bit_packed_value_count;
+  }
+}
+
+// Appends count PLAIN-encoded values. Numbers are stored little-endian, byte arrays are prefixed with their length.
+template <typename T>
+void decode_plain_values(const char* data, const char* end, const size_t count, pmr_vector<T>& values) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    values.reserve(values.size() + count);
+    for (auto value_index = size_t{0}; value_index < count; ++value_index) {
+      auto length = uint32_t{0};
+      Assert(static_cast<size_t>(end - data) >= sizeof(length), "Unexpected end of Parquet page");
+      std::memcpy(&length, data, sizeof(length));
+      data += sizeof(length);
+      Assert(static_cast<size_t>(end - data) >= length, "Unexpected end of Parquet page");
+      values.emplace_back(data, length);
+      data += length;
+    }
+  } else {
+    Assert(static_cast<size_t>(end - data) >= count * sizeof(T), "Unexpected end of Parquet page");
+    const auto previous_size = values.size();
+    values.resize(previous_size + count);
+    std::memcpy(values.data() + previous_size, data, count * sizeof(T));
+  }
+}
+
+template <typename T>
+void decode_dictionary_page(const ParquetPageHeader& page_header, const std::string_view page,
+                            DecodedColumnChunk<T>& column_chunk) {
+  Assert(page_header.encoding == ParquetEncoding::Plain || page_header.encoding == ParquetEncoding::PlainDictionary,
+         "Parquet dictionary pages must be PLAIN-encoded");
+  Assert(column_chunk.values.empty(), "Parquet column chunks must not have more than one dictionary page");
+  const auto dictionary_size = static_cast<size_t>(page_header.value_count);
+  Assert(dictionary_size < NULL_VALUE_INDEX, "Parquet dictionary is too large");
+
+  decode_plain_values(page.data(), page.data() + page.size(), dictionary_size, column_chunk.values);
+  column_chunk.dictionary_size = dictionary_size;
+}
+
+template <typename T>
+void decode_data_page(const ParquetPageHeader& page_header, const char* page_data, const ParquetColumn& column,
+                      const ParquetCodec codec, std::vector<char>& buffer, DecodedColumnChunk<T>& column_chunk) {
+  const auto value_count = static_cast<size_t>(page_header.value_count);
+  const auto compressed_size = static_cast<size_t>(page_header.compressed_size);
+  const auto uncompressed_size = static_cast<size_t>(page_header.uncompressed_size);
+
+  // As the schema is flat, there are no repetition levels. Definition levels are only stored for nullable columns.
+  // They are 0 for NULLs and 1 for values.
+  auto definition_levels = std::string_view{};
+  auto values = std::string_view{};
+  if (page_header.type == ParquetPageType::DataPageV2) {
+    // The levels precede the values and are not compressed.
+    Assert(page_header.repetition_levels_size == 0, "Unexpected repetition levels in Parquet page");
+    const auto levels_size = static_cast<size_t>(page_header.definition_levels_size);
+    Assert(levels_size <= compressed_size && levels_size <= uncompressed_size, "Invalid Parquet page header");
+    definition_levels = {page_data, levels_size};
+    values = page_header.values_are_compressed
+                 ? decompress_page(codec, page_data + levels_size, compressed_size - levels_size,
+                                   uncompressed_size - levels_size, buffer)
+                 : std::string_view{page_data + levels_size, compressed_size - levels_size};
+  } else {
+    // The levels are prefixed with their size.
+    values = decompress_page(codec, page_data, compressed_size, uncompressed_size, buffer);
+    if (column.nullable) {
+      Assert(page_header.definition_level_encoding == ParquetEncoding::Rle,
+             "Only RLE-encoded definition levels are supported");
+      auto levels_size = uint32_t{0};
+      Assert(values.size() >= sizeof(levels_size), "Unexpected end of Parquet page");
+      std::memcpy(&levels_size, values.data(), sizeof(levels_size));
+      Assert(levels_size <= values.size() - sizeof(levels_size), "Unexpected end of Parquet page");
+      definition_levels = values.substr(sizeof(levels_size), levels_size);
+      values.remove_prefix(sizeof(levels_size) + levels_size);
+    }
+  }
+
+  auto level_runs = std::vector<ValueRun>{};
+  if (column.nullable) {
+    decode_rle_bit_packed_hybrid(definition_levels.data(), definition_levels.data() + definition_levels.size(), 1,
+                                 value_count, [&](const auto level, const auto length) {
+                                   append_run(level_runs, level == 0 ? NULL_VALUE_INDEX : 0, length);
+                                 });
+  } else {
+    level_runs.emplace_back(ValueRun{0, static_cast<ChunkOffset>(value_count)});
+  }
+
+  auto non_null_count = size_t{0};
+  for (const auto& level_run : level_runs) {
+    if (level_run.value_index != NULL_VALUE_INDEX) non_null_count += level_run.length;
+  }
+
+  auto value_runs = std::vector<ValueRun>{};
+  switch (page_header.encoding) {
+    case ParquetEncoding::Plain: {
+      const auto first_value_index = column_chunk.values.size();
+      decode_plain_values(values.data(), values.data() + values.size(), non_null_count, column_chunk.values);
+      Assert(column_chunk.values.size() < NULL_VALUE_INDEX, "Parquet column chunk is too large");
+      column_chunk.has_plain_pages = true;
+
+      value_runs.resize(non_null_count);
+      for (auto value_index = size_t{0}; value_index < non_null_count; ++value_index) {
+        value_runs[value_index] = ValueRun{static_cast<uint32_t>(first_value_index + value_index), 1};
+      }
+      break;
+    }
+    case ParquetEncoding::PlainDictionary:
+    case ParquetEncoding::RleDictionary: {
+      // The indexes are prefixed with their bit width.
+      Assert(!values.empty() || non_null_count == 0, "Unexpected end of Parquet page");
+      if (non_null_count == 0) break;
+      const auto bit_width = static_cast<uint32_t>(static_cast<uint8_t>(values.front()));
+      decode_rle_bit_packed_hybrid(values.data() + 1, values.data() + values.size(), bit_width, non_null_count,
+                                   [&](const auto dictionary_index, const auto length) {
+                                     Assert(dictionary_index < column_chunk.dictionary_size,
+                                            "Invalid dictionary index in Parquet page");
+                                     append_run(value_runs, dictionary_index, length);
+                                   });
+      break;
+    }
+    default:
+      Fail("Parquet encoding " + std::string{magic_enum::enum_name(page_header.encoding)} + " is not supported");
+  }
+
+  // Combine the runs of the definition levels and the values.
+  auto value_run_iter = value_runs.cbegin();
+  auto value_run_offset = ChunkOffset{0};
+  for (const auto& level_run : level_runs) {
+    if (level_run.value_index == NULL_VALUE_INDEX) {
+      append_run(column_chunk.runs, NULL_VALUE_INDEX, level_run.length);
+      continue;
+    }
+
+    auto remaining_length = level_run.length;
+    while (remaining_length > 0) {
+      Assert(value_run_iter != value_runs.cend(), "Fewer values than definition levels");
+      const auto length = std::min(remaining_length, value_run_iter->length - value_run_offset);
+      append_run(column_chunk.runs, value_run_iter->value_index, length);
+      remaining_length -= length;
+      value_run_offset += length;
+      if (value_run_offset == value_run_iter->length) {
+        ++value_run_iter;
+        value_run_offset = ChunkOffset{0};
+      }
+    }
+  }
+}
+
+template <typename T>
+std::shared_ptr<AbstractSegment> create_value_segment(DecodedColumnChunk<T>&& column_chunk, const ChunkOffset row_count,
+                                                      const bool nullable) {
+  const auto has_nulls = std::any_of(column_chunk.runs.cbegin(), column_chunk.runs.cend(),
+                                     [](const auto& run) { return run.value_index == NULL_VALUE_INDEX; });
+
+  // Without a dictionary and NULLs, the values are stored in the order of the rows.
+  if (column_chunk.dictionary_size == 0 && !has_nulls) {
+    if (!nullable) return std::make_shared<ValueSegment<T>>(std::move(column_chunk.values));
+    return std::make_shared<ValueSegment<T>>(std::move(column_chunk.values), pmr_vector<bool>(row_count, false));
+  }
+
+  auto values = pmr_vector<T>(row_count);
+  auto null_values = pmr_vector<bool>(nullable ? row_count : 0, false);
+  auto row_index = size_t{0};
+  for (const auto& run : column_chunk.runs) {
+    if (run.value_index == NULL_VALUE_INDEX) {
+      std::fill_n(null_values.begin() + row_index, run.length, true);
+    } else {
+      std::fill_n(values.begin() + row_index, run.length, column_chunk.values[run.value_index]);
+    }
+    row_index += run.length;
+  }
+
+  if (!nullable) return std::make_shared<ValueSegment<T>>(std::move(values));
+  return std::make_shared<ValueSegment<T>>(std::move(values), std::move(null_values));
+}
+
+template <typename T>
+std::shared_ptr<AbstractSegment> create_run_length_segment(const DecodedColumnChunk<T>& column_chunk) {
+  const auto run_count = column_chunk.runs.size();
+  auto values = std::make_shared<pmr_vector<T>>(run_count);
+  auto null_values = std::make_shared<pmr_vector<bool>>(run_count, false);
+  auto end_positions = std::make_shared<pmr_vector<ChunkOffset>>(run_count);
+
+  auto end_position = ChunkOffset{0};
+  for (auto run_index = size_t{0}; run_index < run_count; ++run_index) {
+    const auto& run = column_chunk.runs[run_index];
+    if (run.value_index == NULL_VALUE_INDEX) {
+      (*null_values)[run_index] = true;
+    } else {
+      (*values)[run_index] = column_chunk.values[run.value_index];
+    }
+    end_position += run.length;
+    (*end_positions)[run_index] = end_position - 1;
+  }
+
+  return std::make_shared<RunLengthSegment<T>>(values, null_values, end_positions);
+}
+
+// Parquet dictionaries are not sorted. The dictionary of the segment is the sorted Parquet dictionary without
+// duplicates. The dictionary indexes of the runs are mapped to the corresponding value IDs.
+template <typename T>
+std::shared_ptr<AbstractSegment> create_dictionary_segment(const DecodedColumnChunk<T>& column_chunk,
+                                                           const ChunkOffset row_count) {
+  const auto& parquet_dictionary = column_chunk.values;
+  auto sorted_indexes = std::vector<uint32_t>(column_chunk.dictionary_size);
+  std::iota(sorted_indexes.begin(), sorted_indexes.end(), uint32_t{0});
+  std::sort(sorted_indexes.begin(), sorted_indexes.end(), [&](const auto lhs, const auto rhs) {
+    return parquet_dictionary[lhs] < parquet_dictionary[rhs];
+  });
+
+  auto dictionary = std::make_shared<pmr_vector<T>>();
+  dictionary->reserve(column_chunk.dictionary_size);
+  auto value_ids = std::vector<uint32_t>(column_chunk.dictionary_size);
+  for (const auto index : sorted_indexes) {
+    if (dictionary->empty() || dictionary->back() != parquet_dictionary[index]) {
+      dictionary->emplace_back(parquet_dictionary[index]);
+    }
+    value_ids[index] = static_cast<uint32_t>(dictionary->size() - 1);
+  }
+
+  const auto null_value_id = static_cast<uint32_t>(dictionary->size());
+  auto attribute_vector = pmr_vector<uint32_t>(row_count);
+  auto row_index = size_t{0};
+  for (const auto& run : column_chunk.runs) {
+    const auto value_id = run.value_index == NULL_VALUE_INDEX ? null_value_id : value_ids[run.value_index];
+    std::fill_n(attribute_vector.begin() + row_index, run.length, value_id);
+    row_index += run.length;
+  }
+
+  const auto compressed_attribute_vector = std::shared_ptr<const BaseCompressedVector>(
+      compress_vector(attribute_vector, VectorCompressionType::FixedSizeByteAligned, {}, {null_value_id}));
+  return std::make_shared<DictionarySegment<T>>(dictionary, compressed_attribute_vector);
+}
+
+// Decodes a PLAIN-encoded value of the column chunk statistics.
+template <typename T>
+std::optional<T> decode_statistics_value(const std::optional<std::string>& encoded_value,
+                                         const bool min_max_are_deprecated) {
+  if (!encoded_value) return std::nullopt;
+
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    // The deprecated statistics of byte arrays were determined with a signed byte order.
+    if (min_max_are_deprecated) return std::nullopt;
+    return pmr_string{*encoded_value};
+  } else {
+    if (encoded_value->size() != sizeof(T)) return std::nullopt;
+    auto value = T{};
+    std::memcpy(&value, encoded_value->data(), sizeof(T));
+    if constexpr (std::is_floating_point_v<T>) {
+      if (std::isnan(value)) return std::nullopt;
+    }
+    return value;
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+// The mapped file and its metadata, which the ForeignSegments of an attached file share
+struct ParquetParser::ParquetFile {
+  explicit ParquetFile(const std::string& filename)
+      : mapped_file(filename), metadata(read_parquet_file_metadata(mapped_file.data(), mapped_file.size())) {}
+
+  const MemoryMappedFile mapped_file;
+  const ParquetFileMetadata metadata;
+};
+
+std::shared_ptr<Table> ParquetParser::parse(const std::string& filename) {
+  const auto file = ParquetFile{filename};
+  const auto& metadata = file.metadata;
+  const auto column_count = static_cast<ColumnID::base_type>(metadata.columns.size());
+  const auto row_group_count = metadata.row_groups.size();
+
+  auto segments_per_row_group = std::vector<Segments>(row_group_count, Segments(column_count));
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(row_group_count * column_count);
+  for (auto row_group_index = size_t{0}; row_group_index < row_group_count; ++row_group_index) {
+    if (metadata.row_groups[row_group_index].row_count == 0) continue;
+
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, row_group_index, column_id]() {
+        segments_per_row_group[row_group_index][column_id] = _load_column_chunk(file, row_group_index, column_id);
+      }));
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  auto chunks = std::vector<std::shared_ptr<Chunk>>{};
+  chunks.reserve(row_group_count);
+  for (auto row_group_index = size_t{0}; row_group_index < row_group_count; ++row_group_index) {
+    if (metadata.row_groups[row_group_index].row_count == 0) continue;
+
+    // If the file lacks statistics for a column, the StorageManager generates the pruning statistics of the chunk.
+    chunks.emplace_back(_create_chunk(std::move(segments_per_row_group[row_group_index]),
+                                      _pruning_statistics(metadata, row_group_index, true)));
+  }
+
+  return std::make_shared<Table>(_column_definitions(metadata), TableType::Data, std::move(chunks), UseMvcc::Yes);
+}
+
+std::shared_ptr<Table> ParquetParser::attach(const std::string& filename) {
+  const auto file = std::make_shared<const ParquetFile>(filename);
+  const auto& metadata = file->metadata;
+  const auto column_definitions = _column_definitions(metadata);
+  const auto column_count = static_cast<ColumnID::base_type>(column_definitions.size());
+
+  auto chunks = std::vector<std::shared_ptr<Chunk>>{};
+  chunks.reserve(metadata.row_groups.size());
+  for (auto row_group_index = size_t{0}; row_group_index < metadata.row_groups.size(); ++row_group_index) {
+    const auto row_count = static_cast<ChunkOffset>(metadata.row_groups[row_group_index].row_count);
+    if (row_count == 0) continue;
+
+    auto segments = Segments(column_count);
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      segments[column_id] = std::make_shared<ForeignSegment>(column_definitions[column_id].data_type, row_count,
+                                                             [file, row_group_index, column_id]() {
+                                                               return _load_column_chunk(*file, row_group_index,
+                                                                                         column_id);
+                                                             });
+    }
+    chunks.emplace_back(_create_chunk(std::move(segments), _pruning_statistics(metadata, row_group_index, false)));
+  }
+
+  const auto table =
+      std::make_shared<Table>(column_definitions, TableType::Data, std::move(chunks), UseMvcc::Yes);
+  // Generating the statistics from the data would read the entire file.
+  table->set_table_statistics(_table_statistics(metadata));
+  return table;
+}
+
+TableColumnDefinitions ParquetParser::_column_definitions(const ParquetFileMetadata& metadata) {
+  auto column_definitions = TableColumnDefinitions{};
+  for (const auto& column : metadata.columns) {
+    column_definitions.emplace_back(column.name, _data_type(column), column.nullable);
+  }
+  return column_definitions;
+}
+
+DataType ParquetParser::_data_type(const ParquetColumn& column) {
+  switch (column.type) {
+    case ParquetPhysicalType::Int32:
+      return DataType::Int;
+    case ParquetPhysicalType::Int64:
+      return DataType::Long;
+    case ParquetPhysicalType::Float:
+      return DataType::Float;
+    case ParquetPhysicalType::Double:
+      return DataType::Double;
+    case ParquetPhysicalType::ByteArray:
+      return DataType::String;
+    default:
+      Fail("Parquet column " + column.name + " has the unsupported type " +
+           std::string{magic_enum::enum_name(column.type)});
+  }
+}
+
+std::shared_ptr<AbstractSegment> ParquetParser::_load_column_chunk(const ParquetFile& file,
+                                                                   const size_t row_group_index,
+                                                                   const ColumnID column_id) {
+  auto segment = std::shared_ptr<AbstractSegment>{};
+  resolve_data_type(_data_type(file.metadata.columns[column_id]), [&](auto type) {
+    using ColumnDataType = typename decltype(type)::type;
+    segment = _load_column_chunk<ColumnDataType>(file, row_group_index, column_id);
+  });
+  return segment;
+}
+
+template <typename T>
+std::shared_ptr<AbstractSegment> ParquetParser::_load_column_chunk(const ParquetFile& file,
+                                                                   const size_t row_group_index,
+                                                                   const ColumnID column_id) {
+  const auto& column = file.metadata.columns[column_id];
+  const auto& row_group = file.metadata.row_groups[row_group_index];
+  const auto& column_chunk_metadata = row_group.column_chunks[column_id];
+  Assert(row_group.row_count <= Chunk::MAX_SIZE, "Parquet row group exceeds the maximum chunk size");
+  const auto row_count = static_cast<ChunkOffset>(row_group.row_count);
+
+  const auto begin = static_cast<size_t>(column_chunk_metadata.first_page_offset());
+  const auto size = static_cast<size_t>(column_chunk_metadata.total_compressed_size);
+  Assert(begin <= file.mapped_file.size() && size <= file.mapped_file.size() - begin,
+         "Parquet column chunk exceeds the file");
+  file.mapped_file.will_need(begin, size);
+
+  const auto* position = file.mapped_file.data() + begin;
+  const auto* const end = position + size;
+  auto column_chunk = DecodedColumnChunk<T>{};
+  auto buffer = std::vector<char>{};
+  auto decoded_row_count = size_t{0};
+  while (decoded_row_count < row_count) {
+    Assert(position < end, "Parquet column chunk ends before all rows were read");
+    const auto [page_header, header_size] = read_parquet_page_header(position, static_cast<size_t>(end - position));
+    const auto* const page_data = position + header_size;
+    Assert(static_cast<size_t>(page_header.compressed_size) <= static_cast<size_t>(end - page_data),
+           "Parquet page exceeds the column chunk");
+
+    switch (page_header.type) {
+      case ParquetPageType::DictionaryPage:
+        decode_dictionary_page(page_header,
+                               decompress_page(column_chunk_metadata.codec, page_data,
+                                               static_cast<size_t>(page_header.compressed_size),
+                                               static_cast<size_t>(page_header.uncompressed_size), buffer),
+                               column_chunk);
+        break;
+      case ParquetPageType::DataPage:
+      case ParquetPageType::DataPageV2:
+        decode_data_page(page_header, page_data, column, column_chunk_metadata.codec, buffer, column_chunk);
+        decoded_row_count += static_cast<size_t>(page_header.value_count);
+        break;
+      case ParquetPageType::IndexPage:
+        break;
+    }
+    position = page_data + page_header.compressed_size;
+  }
+  Assert(decoded_row_count == row_count, "Parquet column chunk contains more values than its row group");
+
+  if (column_chunk.has_plain_pages || column_chunk.dictionary_size == 0) {
+    return create_value_segment(std::move(column_chunk), row_count, column.nullable);
+  }
+  if (column_chunk.runs.size() * MIN_AVERAGE_RUN_LENGTH <= row_count) {
+    return create_run_length_segment(column_chunk);
+  }
+  return create_dictionary_segment(column_chunk, row_count);
+}
+
+std::optional<ChunkPruningStatistics> ParquetParser::_pruning_statistics(const ParquetFileMetadata& metadata,
+                                                                         const size_t row_group_index,
+                                                                         const bool with_all_columns) {
+  const auto& row_group = metadata.row_groups[row_group_index];
+  const auto column_count = metadata.columns.size();
+  auto pruning_statistics = ChunkPruningStatistics(column_count);
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto& statistics = row_group.column_chunks[column_id].statistics;
+    auto has_statistics = true;
+    resolve_data_type(_data_type(metadata.columns[column_id]), [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      const auto segment_statistics = std::make_shared<AttributeStatistics<ColumnDataType>>();
+      const auto min = decode_statistics_value<ColumnDataType>(statistics.min, statistics.min_max_are_deprecated);
+      const auto max = decode_statistics_value<ColumnDataType>(statistics.max, statistics.min_max_are_deprecated);
+      if (min && max) {
+        // Same statistics objects as those of generate_chunk_pruning_statistics
+        if constexpr (std::is_arithmetic_v<ColumnDataType>) {
+          segment_statistics->set_statistics_object(
+              std::make_shared<RangeFilter<ColumnDataType>>(std::vector{std::pair{*min, *max}}));
+        } else {
+          segment_statistics->set_statistics_object(std::make_shared<MinMaxFilter<ColumnDataType>>(*min, *max));
+        }
+      } else {
+        // A segment that contains only NULLs does not have a filter either.
+        has_statistics = statistics.null_count && *statistics.null_count == row_group.row_count;
+      }
+      pruning_statistics[column_id] = segment_statistics;
+    });
+
+    if (with_all_columns && !has_statistics) return std::nullopt;
+  }
+  return pruning_statistics;
+}
+
+std::shared_ptr<TableStatistics> ParquetParser::_table_statistics(const ParquetFileMetadata& metadata) {
+  const auto column_definitions = _column_definitions(metadata);
+  const auto column_count = column_definitions.size();
+  const auto row_count = static_cast<Cardinality>(metadata.row_count);
+
+  auto column_statistics = std::vector<std::shared_ptr<BaseAttributeStatistics>>(column_count);
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(column_definitions[column_id].data_type, [&](auto type) {
+      using ColumnDataType = typename decltype(type)::type;
+
+      // The histogram consists of a single bin from the smallest minimum to the largest maximum of the column chunks.
+      auto min = std::optional<ColumnDataType>{};
+      auto max = std::optional<ColumnDataType>{};
+      auto has_min_max = true;
+      auto null_count = Cardinality{0};
+      auto distinct_count = std::optional<Cardinality>{Cardinality{0}};
+      for (const auto& row_group : metadata.row_groups) {
+        const auto& statistics = row_group.column_chunks[column_id].statistics;
+        null_count += statistics.null_count ? static_cast<Cardinality>(*statistics.null_count) : Cardinality{0};
+        if (statistics.null_count && *statistics.null_count == row_group.row_count) continue;
+
+        if (distinct_count && statistics.distinct_count) {
+          *distinct_count += static_cast<Cardinality>(*statistics.distinct_count);
+        } else {
+          distinct_count = std::nullopt;
+        }
+
+        const auto row_group_min =
+            decode_statistics_value<ColumnDataType>(statistics.min, statistics.min_max_are_deprecated);
+        const auto row_group_max =
+            decode_statistics_value<ColumnDataType>(statistics.max, statistics.min_max_are_deprecated);
+        if (!row_group_min || !row_group_max) {
+          has_min_max = false;
+          continue;
+        }
+        min = min ? std::min(*min, *row_group_min) : *row_group_min;
+        max = max ? std::max(*max, *row_group_max) : *row_group_max;
+      }
+
+      const auto output_column_statistics = std::make_shared<AttributeStatistics<ColumnDataType>>();
+      const auto value_count = std::max(row_count - null_count, Cardinality{0});
+      output_column_statistics->set_statistics_object(
+          std::make_shared<NullValueRatioStatistics>(row_count == 0 ? 0.0f : null_count / row_count));
+
+      auto histogram_is_valid = has_min_max && min && max && value_count > 0;
+      if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+        // String histograms only support the characters of their domain.
+        const auto domain = HistogramDomain<pmr_string>{};
+        histogram_is_valid = histogram_is_valid && domain.contains(*min) && domain.contains(*max);
+      }
+
+      if (histogram_is_valid) {
+        // Without distinct counts in the file, we assume that all values are distinct.
+        auto histogram_distinct_count = std::min(distinct_count.value_or(value_count), value_count);
+        if constexpr (std::is_integral_v<ColumnDataType>) {
+          histogram_distinct_count =
+              std::min(histogram_distinct_count, static_cast<Cardinality>(static_cast<double>(*max) -
+                                                                          static_cast<double>(*min) + 1.0));
+        }
+        output_column_statistics->set_statistics_object(
+            GenericHistogram<ColumnDataType>::with_single_bin(*min, *max, value_count, histogram_distinct_count));
+      }
+
+      column_statistics[column_id] = output_column_statistics;
+    });
+  }
+
+  return std::make_shared<TableStatistics>(std::move(column_statistics), row_count);
+}
+
+std::shared_ptr<Chunk> ParquetParser::_create_chunk(Segments&& segments,
+                                                    const std::optional<ChunkPruningStatistics>& pruning_statistics) {
+  const auto row_count = segments.front()->size();
+  const auto chunk = std::make_shared<Chunk>(std::move(segments), std::make_shared<MvccData>(row_count, CommitID{0}));
+  chunk->finalize();
+  chunk->set_pruning_statistics(pruning_statistics);
+  return chunk;
+}
+
+}  // namespace opossum
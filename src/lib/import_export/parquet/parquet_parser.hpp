@@ -0,0 +1,70 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+
+#include "import_export/parquet/parquet_metadata.hpp"
+#include "storage/chunk.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class TableStatistics;
+
+/*
+ * This parser reads Apache Parquet files with a flat schema. Each row group becomes a chunk. The following subset of
+ * the format is supported:
+ *  - columns of the physical types INT32 (read as Int), INT64 (Long), FLOAT, DOUBLE, and BYTE_ARRAY (String), which
+ *    are REQUIRED or OPTIONAL,
+ *  - data pages of version 1 and 2 that are PLAIN- or dictionary-encoded (PLAIN_DICTIONARY or RLE_DICTIONARY), and
+ *  - the compression codecs UNCOMPRESSED, SNAPPY, LZ4_RAW, and ZSTD.
+ *
+ * Dictionary-encoded column chunks are not materialized. Their dictionary indexes are read as runs, which makes
+ * them either a RunLengthSegment (if the runs are long) or a DictionarySegment, whose dictionary is the sorted Parquet
+ * dictionary. Other column chunks become ValueSegments. The min/max statistics of the column chunks become the pruning
+ * statistics of the chunks.
+ */
+class ParquetParser {
+ public:
+  // Dictionary-encoded column chunks become RunLengthSegments if their runs have at least this length on average.
+  static constexpr auto MIN_AVERAGE_RUN_LENGTH = size_t{8};
+
+  // Reads all row groups of the file. Column chunks are decoded in parallel.
+  static std::shared_ptr<Table> parse(const std::string& filename);
+
+  /*
+   * Creates a foreign table for the file without reading any column chunk. Its segments are ForeignSegments, which
+   * GetTable only loads for the chunks and columns that were not pruned. Thus, queries read only the row groups and
+   * columns that they need from the file. The table statistics for the optimizer are derived from the statistics of
+   * the column chunks. The file must not be changed while the table exists.
+   */
+  static std::shared_ptr<Table> attach(const std::string& filename);
+
+ protected:
+  struct ParquetFile;
+
+  static TableColumnDefinitions _column_definitions(const ParquetFileMetadata& metadata);
+
+  static DataType _data_type(const ParquetColumn& column);
+
+  // Decodes the column chunk of the given row group and column.
+  static std::shared_ptr<AbstractSegment> _load_column_chunk(const ParquetFile& file, const size_t row_group_index,
+                                                             const ColumnID column_id);
+
+  template <typename T>
+  static std::shared_ptr<AbstractSegment> _load_column_chunk(const ParquetFile& file, const size_t row_group_index,
+                                                             const ColumnID column_id);
+
+  // Returns nullopt if with_all_columns is set and statistics are missing for a column.
+  static std::optional<ChunkPruningStatistics> _pruning_statistics(const ParquetFileMetadata& metadata,
+                                                                   const size_t row_group_index,
+                                                                   const bool with_all_columns);
+
+  static std::shared_ptr<TableStatistics> _table_statistics(const ParquetFileMetadata& metadata);
+
+  static std::shared_ptr<Chunk> _create_chunk(Segments&& segments,
+                                              const std::optional<ChunkPruningStatistics>& pruning_statistics);
+};
+
+}  // namespace opossum
@@ -0,0 +1,274 @@
+#include "checkpoint_loader.hpp"
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+#include <memory>
+#include <optional>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "import_export/binary/binary_parser.hpp"
+#include "logging/checkpoint_writer.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/job_task.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/null_value_ratio_statistics.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/chunk.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+#include "utils/memory_mapped_file.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+T read_value(std::istream& stream) {
+  auto value = T{};
+  stream.read(reinterpret_cast<char*>(&value), sizeof(T));
+  return value;
+}
+
+template <>
+pmr_string read_value(std::istream& stream) {
+  auto value = pmr_string(read_value<uint64_t>(stream), '\0');
+  stream.read(value.data(), static_cast<std::streamsize>(value.size()));
+  return value;
+}
+
+template <typename T>
+std::vector<T> read_values(std::istream& stream, const size_t count) {
+  auto values = std::vector<T>(count);
+  stream.read(reinterpret_cast<char*>(values.data()), static_cast<std::streamsize>(count * sizeof(T)));
+  return values;
+}
+
+struct ChunkBlock {
+  uint64_t offset;
+  uint64_t size;
+};
+
+struct CheckpointedTable {
+  std::string name;
+  std::shared_ptr<Table> table;
+  std::vector<ChunkBlock> chunk_blocks;
+};
+
+// Everything needed to append a restored chunk to its table
+struct RestoredChunk {
+  Segments segments;
+  std::vector<SortColumnDefinition> sorted_by;
+  std::shared_ptr<MvccData> mvcc_data;
+  bool is_mutable{false};
+  ChunkOffset invalid_row_count{0};
+  std::optional<ChunkPruningStatistics> pruning_statistics;
+};
+
+// Inserts into mutable chunks require ValueSegments that have the capacity for the table's target chunk size.
+template <typename T>
+std::shared_ptr<AbstractSegment> make_appendable(ValueSegment<T>& segment, const ChunkOffset capacity) {
+  auto values = std::move(segment.values());
+  values.reserve(capacity);
+  if (!segment.is_nullable()) return std::make_shared<ValueSegment<T>>(std::move(values));
+
+  auto null_values = segment.null_values();
+  null_values.reserve(capacity);
+  return std::make_shared<ValueSegment<T>>(std::move(values), std::move(null_values));
+}
+
+template <typename T>
+std::shared_ptr<BaseAttributeStatistics> read_attribute_statistics(std::istream& stream) {
+  const auto flags = read_value<uint8_t>(stream);
+  const auto has = [&](const PruningStatisticsFlag flag) { return (flags & static_cast<uint8_t>(flag)) != 0; };
+
+  const auto attribute_statistics = std::make_shared<AttributeStatistics<T>>();
+  if (has(PruningStatisticsFlag::MinMaxFilter)) {
+    auto min = read_value<T>(stream);
+    auto max = read_value<T>(stream);
+    attribute_statistics->set_statistics_object(std::make_shared<MinMaxFilter<T>>(std::move(min), std::move(max)));
+  }
+
+  if constexpr (std::is_arithmetic_v<T>) {
+    if (has(PruningStatisticsFlag::RangeFilter)) {
+      auto ranges = std::vector<std::pair<T, T>>(read_value<uint64_t>(stream));
+      for (auto& [range_min, range_max] : ranges) {
+        range_min = read_value<T>(stream);
+        range_max = read_value<T>(stream);
+      }
+      attribute_statistics->set_statistics_object(std::make_shared<RangeFilter<T>>(std::move(ranges)));
+    }
+  }
+
+  if (has(PruningStatisticsFlag::NullValueRatio)) {
+    attribute_statistics->set_statistics_object(
+        std::make_shared<NullValueRatioStatistics>(read_value<float>(stream)));
+  }
+
+  return attribute_statistics;
+}
+
+// Reads the part of a chunk block that follows the segments (see CheckpointWriter::_write_chunk)
+RestoredChunk restore_chunk(std::istream& stream, const Table& table, Segments&& segments,
+                            std::vector<SortColumnDefinition>&& sorted_by) {
+  auto restored_chunk = RestoredChunk{};
+  restored_chunk.segments = std::move(segments);
+  restored_chunk.sorted_by = std::move(sorted_by);
+  const auto row_count = restored_chunk.segments.front()->size();
+
+  restored_chunk.is_mutable = static_cast<bool>(read_value<BoolAsByteType>(stream));
+  if (restored_chunk.is_mutable) {
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+        auto& segment = static_cast<ValueSegment<ColumnDataType>&>(*restored_chunk.segments[column_id]);
+        restored_chunk.segments[column_id] = make_appendable(segment, table.target_chunk_size());
+      });
+    }
+  }
+
+  if (table.uses_mvcc() == UseMvcc::Yes) {
+    // MvccData cannot grow, so mutable chunks need entries for all rows that might be appended later.
+    const auto mvcc_size = restored_chunk.is_mutable ? table.target_chunk_size() : std::max(row_count, ChunkOffset{1});
+    restored_chunk.mvcc_data = std::make_shared<MvccData>(mvcc_size, MvccData::MAX_COMMIT_ID);
+
+    const auto begin_cids = read_values<CommitID>(stream, row_count);
+    const auto end_cids = read_values<CommitID>(stream, row_count);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+      restored_chunk.mvcc_data->set_begin_cid(chunk_offset, begin_cids[chunk_offset]);
+      restored_chunk.mvcc_data->set_end_cid(chunk_offset, end_cids[chunk_offset]);
+    }
+
+    if (!restored_chunk.is_mutable && row_count > 0) {
+      // Usually set by Chunk::finalize(). Rows that committed after the checkpoint have no begin cid yet. In that
+      // case, max_begin_cid is MAX_COMMIT_ID, which does not allow Validate to skip the chunk.
+      restored_chunk.mvcc_data->max_begin_cid = *std::max_element(begin_cids.cbegin(), begin_cids.cend());
+    }
+  }
+  restored_chunk.invalid_row_count = read_value<ChunkOffset>(stream);
+
+  const auto has_pruning_statistics = static_cast<bool>(read_value<BoolAsByteType>(stream));
+  if (has_pruning_statistics) {
+    auto pruning_statistics = ChunkPruningStatistics(table.column_count());
+    for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+      resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+        pruning_statistics[column_id] = read_attribute_statistics<ColumnDataType>(stream);
+      });
+    }
+    restored_chunk.pruning_statistics = std::move(pruning_statistics);
+  }
+
+  return restored_chunk;
+}
+
+}  // namespace
+
+namespace opossum {
+
+CommitID CheckpointLoader::load(const std::filesystem::path& path) {
+  const auto file = MemoryMappedFile{path};
+
+  auto header = MemoryInputStream{file.data(), file.size()};
+  header.exceptions(std::istream::failbit | std::istream::badbit);
+
+  auto magic = std::array<char, sizeof(CheckpointWriter::MAGIC)>{};
+  header.read(magic.data(), magic.size());
+  Assert(std::memcmp(magic.data(), CheckpointWriter::MAGIC, magic.size()) == 0,
+         "'" + path.string() + "' is not a checkpoint");
+  const auto format_version = read_value<uint32_t>(header);
+  Assert(format_version == CheckpointWriter::FORMAT_VERSION,
+         "Checkpoint format version " + std::to_string(format_version) + " is not supported");
+  read_value<uint32_t>(header);  // Page size, only relevant for the layout of the file
+  const auto commit_id = read_value<CommitID>(header);
+  const auto table_count = read_value<uint32_t>(header);
+  const auto directory_offset = read_value<uint64_t>(header);
+  const auto directory_size = read_value<uint64_t>(header);
+  Assert(directory_offset + directory_size <= file.size(), "Checkpoint file is truncated");
+
+  auto directory = MemoryInputStream{file.data() + directory_offset, directory_size};
+  directory.exceptions(std::istream::failbit | std::istream::badbit);
+  auto tables = std::vector<CheckpointedTable>{};
+  for (auto table_index = uint32_t{0}; table_index < table_count; ++table_index) {
+    auto name = std::string{read_value<pmr_string>(directory)};
+    const auto uses_mvcc = static_cast<bool>(read_value<BoolAsByteType>(directory));
+
+    auto table = BinaryParser::_read_header(directory).first;
+    if (!uses_mvcc) {
+      table = std::make_shared<Table>(table->column_definitions(), TableType::Data, table->target_chunk_size(),
+                                      UseMvcc::No);
+    }
+
+    const auto chunk_count = read_value<ChunkID::base_type>(directory);
+    const auto block_offsets = read_values<uint64_t>(directory, chunk_count);
+    const auto block_sizes = read_values<uint64_t>(directory, chunk_count);
+
+    auto chunk_blocks = std::vector<ChunkBlock>(chunk_count);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      chunk_blocks[chunk_id] = ChunkBlock{block_offsets[chunk_id], block_sizes[chunk_id]};
+    }
+
+    tables.emplace_back(CheckpointedTable{std::move(name), std::move(table), std::move(chunk_blocks)});
+  }
+
+  auto& storage_manager = Hyrise::get().storage_manager;
+  for (const auto& checkpointed_table : tables) {
+    Assert(!storage_manager.has_table(checkpointed_table.name),
+           "Cannot load checkpoint: Table '" + checkpointed_table.name + "' already exists");
+  }
+
+  // Restore all chunks in parallel. Each job reads its chunk block from the mapping, which loads the block's pages.
+  auto restored_chunks = std::vector<std::vector<RestoredChunk>>(tables.size());
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto table_index = size_t{0}; table_index < tables.size(); ++table_index) {
+    const auto& checkpointed_table = tables[table_index];
+    restored_chunks[table_index].resize(checkpointed_table.chunk_blocks.size());
+
+    for (auto chunk_id = ChunkID{0}; chunk_id < checkpointed_table.chunk_blocks.size(); ++chunk_id) {
+      const auto chunk_block = checkpointed_table.chunk_blocks[chunk_id];
+      Assert(chunk_block.offset + chunk_block.size <= file.size(), "Checkpoint file is truncated");
+
+      jobs.emplace_back(std::make_shared<JobTask>([&, table_index, chunk_id, chunk_block]() {
+        file.will_need(chunk_block.offset, chunk_block.size);
+
+        auto block = MemoryInputStream{file.data() + chunk_block.offset, chunk_block.size};
+        block.exceptions(std::istream::failbit | std::istream::badbit);
+        const auto& table = *tables[table_index].table;
+        auto [segments, sorted_by] = BinaryParser::_read_chunk(block, table);
+        restored_chunks[table_index][chunk_id] =
+            restore_chunk(block, table, std::move(segments), std::move(sorted_by));
+      }));
+    }
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  for (auto table_index = size_t{0}; table_index < tables.size(); ++table_index) {
+    const auto& table = tables[table_index].table;
+    for (auto& restored_chunk : restored_chunks[table_index]) {
+      table->append_chunk(restored_chunk.segments, restored_chunk.mvcc_data);
+
+      const auto chunk = table->last_chunk();
+      if (restored_chunk.invalid_row_count > 0) chunk->increase_invalid_row_count(restored_chunk.invalid_row_count);
+      if (restored_chunk.is_mutable) continue;
+
+      // Sort orders and pruning statistics can only be set for immutable chunks.
+      chunk->finalize();
+      if (!restored_chunk.sorted_by.empty()) chunk->set_individually_sorted_by(restored_chunk.sorted_by);
+      if (restored_chunk.pruning_statistics) chunk->set_pruning_statistics(restored_chunk.pruning_statistics);
+    }
+
+    storage_manager.add_table(tables[table_index].name, table);
+  }
+
+  Hyrise::get().transaction_manager._reset_last_commit_id(commit_id);
+
+  return commit_id;
+}
+
+}  // namespace opossum
@@ -0,0 +1,25 @@
+#pragma once
+
+#include <filesystem>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Restores the tables of a checkpoint written by CheckpointWriter and adds them to the StorageManager.
+ *
+ * The checkpoint file is memory-mapped. Its chunk blocks are independent of each other and are restored in parallel
+ * by the scheduler, with each segment being read directly from the mapping. Encoded segments are restored in their
+ * encoding, so that they do not need to be encoded again. MVCC data and pruning statistics are restored as well.
+ * Afterwards, the TransactionManager continues with the commit ids following the one of the checkpoint. Transactions
+ * that committed after the checkpoint was taken can be recovered from a write-ahead log (see WalRecovery).
+ */
+class CheckpointLoader {
+ public:
+  // Returns the commit id the checkpoint is consistent with. Must be called before transactions are started. The
+  // StorageManager must not contain tables with the same names as the checkpointed ones.
+  static CommitID load(const std::filesystem::path& path);
+};
+
+}  // namespace opossum
@@ -0,0 +1,286 @@
+#include "checkpoint_writer.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "import_export/binary/binary_writer.hpp"
+#include "resolve_type.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/null_value_ratio_statistics.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/chunk.hpp"
+#include "storage/foreign_segment.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Writes a shallow copy of the given value to the ofstream
+template <typename T>
+void export_value(std::ofstream& ofstream, const T& value) {
+  ofstream.write(reinterpret_cast<const char*>(&value), sizeof(T));
+}
+
+template <>
+void export_value(std::ofstream& ofstream, const pmr_string& value) {
+  export_value(ofstream, static_cast<uint64_t>(value.size()));
+  ofstream.write(value.data(), static_cast<std::streamsize>(value.size()));
+}
+
+template <typename T>
+void export_values(std::ofstream& ofstream, const std::vector<T>& values) {
+  ofstream.write(reinterpret_cast<const char*>(values.data()), static_cast<std::streamsize>(values.size() * sizeof(T)));
+}
+
+// Pads the file with zeros up to the next multiple of the page size
+void pad_to_page_boundary(std::ofstream& ofstream, const size_t page_size) {
+  const auto position = static_cast<size_t>(ofstream.tellp());
+  const auto padding = (page_size - position % page_size) % page_size;
+  const auto zeros = std::vector<char>(padding, 0);
+  ofstream.write(zeros.data(), static_cast<std::streamsize>(padding));
+}
+
+// Copies the first `row_count` rows of a ValueSegment, as rows beyond that might be appended concurrently.
+template <typename T>
+std::shared_ptr<AbstractSegment> copy_rows(const ValueSegment<T>& segment, const ChunkOffset row_count) {
+  const auto& values = segment.values();
+  auto copied_values = pmr_vector<T>(values.begin(), values.begin() + row_count);
+  if (!segment.is_nullable()) return std::make_shared<ValueSegment<T>>(std::move(copied_values));
+
+  const auto& null_values = segment.null_values();
+  auto copied_null_values = pmr_vector<bool>(null_values.begin(), null_values.begin() + row_count);
+  return std::make_shared<ValueSegment<T>>(std::move(copied_values), std::move(copied_null_values));
+}
+
+void sync_file(const std::filesystem::path& path) {
+  const auto file_descriptor = open(path.c_str(), O_RDONLY);
+  Assert(file_descriptor != -1, "Could not open '" + path.string() + "': " + std::string{std::strerror(errno)});
+  const auto sync_result = fsync(file_descriptor);
+  close(file_descriptor);
+  Assert(sync_result == 0, "Could not sync '" + path.string() + "': " + std::string{std::strerror(errno)});
+}
+
+}  // namespace
+
+namespace opossum {
+
+CommitID CheckpointWriter::write(const std::filesystem::path& path) {
+  // All transactions up to this commit id have completed committing, so their effects are stable.
+  const auto commit_id = Hyrise::get().transaction_manager.last_commit_id();
+  const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+
+  // Sort the tables by name so that checkpoints of the same data are identical.
+  auto tables = std::vector<std::pair<std::string, std::shared_ptr<Table>>>{};
+  for (const auto& table : Hyrise::get().storage_manager.tables()) {
+    tables.emplace_back(table);
+  }
+  std::sort(tables.begin(), tables.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  auto temporary_path = path;
+  temporary_path += ".tmp";
+
+  {
+    std::ofstream ofstream;
+    ofstream.exceptions(std::ofstream::failbit | std::ofstream::badbit);
+    ofstream.open(temporary_path, std::ios::binary | std::ios::trunc);
+
+    // The header is written last, once the position of the directory is known. Reserve its page.
+    _write_header(ofstream, commit_id, 0, 0, 0);
+    pad_to_page_boundary(ofstream, page_size);
+
+    auto block_offsets_per_table = std::vector<std::vector<uint64_t>>(tables.size());
+    auto block_sizes_per_table = std::vector<std::vector<uint64_t>>(tables.size());
+    for (auto table_index = size_t{0}; table_index < tables.size(); ++table_index) {
+      const auto& table = *tables[table_index].second;
+      Assert(table.type() == TableType::Data, "Only data tables can be checkpointed");
+
+      const auto chunk_count = table.chunk_count();
+      for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+        const auto chunk = table.get_chunk(chunk_id);
+        // Skipping physically deleted chunks would change the RowIDs of the following chunks, which the write-ahead
+        // log relies on.
+        Assert(chunk, "Cannot checkpoint tables with physically deleted chunks");
+
+        const auto block_offset = static_cast<uint64_t>(ofstream.tellp());
+        _write_chunk(ofstream, table, *chunk, commit_id);
+        block_offsets_per_table[table_index].emplace_back(block_offset);
+        block_sizes_per_table[table_index].emplace_back(static_cast<uint64_t>(ofstream.tellp()) - block_offset);
+        pad_to_page_boundary(ofstream, page_size);
+      }
+    }
+
+    const auto directory_offset = static_cast<uint64_t>(ofstream.tellp());
+    for (auto table_index = size_t{0}; table_index < tables.size(); ++table_index) {
+      _write_directory_entry(ofstream, tables[table_index].first, *tables[table_index].second,
+                             block_offsets_per_table[table_index], block_sizes_per_table[table_index]);
+    }
+    const auto directory_size = static_cast<uint64_t>(ofstream.tellp()) - directory_offset;
+
+    ofstream.seekp(0);
+    _write_header(ofstream, commit_id, static_cast<uint32_t>(tables.size()), directory_offset, directory_size);
+  }
+
+  // Only replace the previous checkpoint once the new one is durable. Otherwise, a crash could leave no valid
+  // checkpoint behind.
+  sync_file(temporary_path);
+  std::filesystem::rename(temporary_path, path);
+  sync_file(path.has_parent_path() ? path.parent_path() : std::filesystem::current_path());
+
+  return commit_id;
+}
+
+void CheckpointWriter::_write_header(std::ofstream& ofstream, const CommitID commit_id, const uint32_t table_count,
+                                     const uint64_t directory_offset, const uint64_t directory_size) {
+  ofstream.write(MAGIC, sizeof(MAGIC));
+  export_value(ofstream, FORMAT_VERSION);
+  export_value(ofstream, static_cast<uint32_t>(sysconf(_SC_PAGESIZE)));
+  export_value(ofstream, commit_id);
+  export_value(ofstream, table_count);
+  export_value(ofstream, directory_offset);
+  export_value(ofstream, directory_size);
+}
+
+void CheckpointWriter::_write_chunk(std::ofstream& ofstream, const Table& table, const Chunk& chunk,
+                                    const CommitID commit_id) {
+  // Check for mutability first: Once a chunk is immutable, all of its rows are completely written.
+  const auto is_mutable = chunk.is_mutable();
+  const auto row_count = chunk.size();
+
+  // Rows that were updated in place (see RowVersions) are written with the values of their newest version committed
+  // at or before commit_id. The versions are retrieved before the segments, as merge_row_versions might replace them.
+  const auto row_versions = table.uses_mvcc() == UseMvcc::Yes ? chunk.mvcc_data()->row_versions() : nullptr;
+  const auto versions =
+      row_versions ? row_versions->visible_versions(INVALID_TRANSACTION_ID, commit_id) : RowVersions::VersionList{};
+  const auto changed_column_ids = RowVersions::changed_column_ids(versions);
+
+  // The segments of foreign tables (see ForeignSegment) are loaded from their file and written like other segments.
+  // Thus, the restored table does not depend on the file, and rows inserted into or deleted from it are kept.
+  const auto is_foreign =
+      static_cast<bool>(std::dynamic_pointer_cast<const ForeignSegment>(chunk.get_segment(ColumnID{0})));
+
+  if (is_mutable || is_foreign || !versions.empty()) {
+    auto segments = Segments{};
+    for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+      auto segment = chunk.get_segment(column_id);
+      if (is_foreign) segment = std::static_pointer_cast<const ForeignSegment>(segment)->load();
+
+      if (is_mutable) {
+        // Mutable chunks consist of ValueSegments, which concurrent Insert operators may grow.
+        resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+          using ColumnDataType = typename decltype(data_type_t)::type;
+          const auto value_segment = std::dynamic_pointer_cast<ValueSegment<ColumnDataType>>(segment);
+          Assert(value_segment, "Mutable chunks are expected to consist of ValueSegments");
+          segment = copy_rows(*value_segment, row_count);
+        });
+      }
+
+      if (std::binary_search(changed_column_ids.begin(), changed_column_ids.end(), column_id)) {
+        segment = apply_row_versions(*segment, column_id, table.column_is_nullable(column_id), versions);
+      }
+
+      segments.emplace_back(segment);
+    }
+    BinaryWriter::_write_chunk(table, Chunk{segments}, ofstream);
+  } else {
+    BinaryWriter::_write_chunk(table, chunk, ofstream);
+  }
+
+  export_value(ofstream, static_cast<BoolAsByteType>(is_mutable));
+
+  // Rows that are invisible at commit_id (e.g., deleted rows or rows of rolled back transactions) count as invalid.
+  auto invalid_row_count = ChunkOffset{0};
+  if (table.uses_mvcc() == UseMvcc::Yes) {
+    const auto& mvcc_data = chunk.mvcc_data();
+    auto begin_cids = std::vector<CommitID>(row_count);
+    auto end_cids = std::vector<CommitID>(row_count);
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+      // Changes of transactions that committed after commit_id are stored as if they were not committed yet. Locks of
+      // transactions (i.e., TIDs) are not stored, as no transaction survives a restart.
+      const auto begin_cid = mvcc_data->get_begin_cid(chunk_offset);
+      const auto end_cid = mvcc_data->get_end_cid(chunk_offset);
+      begin_cids[chunk_offset] = begin_cid <= commit_id ? begin_cid : MvccData::MAX_COMMIT_ID;
+      end_cids[chunk_offset] = end_cid <= commit_id ? end_cid : MvccData::MAX_COMMIT_ID;
+      if (end_cids[chunk_offset] != MvccData::MAX_COMMIT_ID) ++invalid_row_count;
+    }
+    export_values(ofstream, begin_cids);
+    export_values(ofstream, end_cids);
+  }
+  export_value(ofstream, invalid_row_count);
+
+  // The pruning statistics do not reflect the values of updated rows.
+  const auto has_pruning_statistics = chunk.pruning_statistics().has_value() && !row_versions;
+  export_value(ofstream, static_cast<BoolAsByteType>(has_pruning_statistics));
+  if (has_pruning_statistics) {
+    _write_pruning_statistics(ofstream, table, chunk);
+  }
+}
+
+void CheckpointWriter::_write_pruning_statistics(std::ofstream& ofstream, const Table& table, const Chunk& chunk) {
+  const auto& pruning_statistics = *chunk.pruning_statistics();
+  for (auto column_id = ColumnID{0}; column_id < table.column_count(); ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto attribute_statistics =
+          std::dynamic_pointer_cast<const AttributeStatistics<ColumnDataType>>(pruning_statistics[column_id]);
+      if (!attribute_statistics) {
+        export_value(ofstream, uint8_t{0});
+        return;
+      }
+
+      auto flags = uint8_t{0};
+      if (attribute_statistics->min_max_filter) flags |= static_cast<uint8_t>(PruningStatisticsFlag::MinMaxFilter);
+      if (attribute_statistics->range_filter) flags |= static_cast<uint8_t>(PruningStatisticsFlag::RangeFilter);
+      if (attribute_statistics->null_value_ratio) flags |= static_cast<uint8_t>(PruningStatisticsFlag::NullValueRatio);
+      export_value(ofstream, flags);
+
+      if (attribute_statistics->min_max_filter) {
+        export_value(ofstream, attribute_statistics->min_max_filter->min);
+        export_value(ofstream, attribute_statistics->min_max_filter->max);
+      }
+
+      if constexpr (std::is_arithmetic_v<ColumnDataType>) {
+        if (attribute_statistics->range_filter) {
+          const auto& ranges = attribute_statistics->range_filter->ranges;
+          export_value(ofstream, static_cast<uint64_t>(ranges.size()));
+          for (const auto& [range_min, range_max] : ranges) {
+            export_value(ofstream, range_min);
+            export_value(ofstream, range_max);
+          }
+        }
+      }
+
+      if (attribute_statistics->null_value_ratio) {
+        export_value(ofstream, attribute_statistics->null_value_ratio->ratio);
+      }
+    });
+  }
+}
+
+void CheckpointWriter::_write_directory_entry(std::ofstream& ofstream, const std::string& table_name,
+                                              const Table& table, const std::vector<uint64_t>& block_offsets,
+                                              const std::vector<uint64_t>& block_sizes) {
+  export_value(ofstream, pmr_string{table_name});
+  export_value(ofstream, static_cast<BoolAsByteType>(table.uses_mvcc() == UseMvcc::Yes));
+  BinaryWriter::_write_header(table, ofstream);
+  export_value(ofstream, static_cast<ChunkID::base_type>(block_offsets.size()));
+  export_values(ofstream, block_offsets);
+  export_values(ofstream, block_sizes);
+}
+
+}  // namespace opossum
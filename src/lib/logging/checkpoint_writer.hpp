@@ -0,0 +1,127 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+class Table;
+
+/**
+ * Writes all tables of the StorageManager into a checkpoint file, from which CheckpointLoader restores them after a
+ * restart. In contrast to regenerating or re-importing the tables, segments are stored in their encoded form, and MVCC
+ * data as well as pruning statistics are kept. The file is laid out so that it can be memory-mapped and its chunks
+ * can be restored independently and in parallel:
+ *
+ * -----------------------------
+ * |  Header (one page)        |
+ * |---------------------------|
+ * |  Chunk blocks¹            |
+ * |---------------------------|
+ * |  Table directory          |
+ * -----------------------------
+ *
+ * ¹ Each block starts at a page boundary, so that pages are never shared between chunks.
+ *
+ * The checkpoint is consistent with the commit id returned by write(): Rows inserted or deleted by transactions that
+ * committed later are stored as if these transactions had not committed yet. Modifying transactions may continue while
+ * the checkpoint is written. Their effects are only restored if they are recovered from a write-ahead log afterwards
+ * (see WalRecovery). Without a write-ahead log, the checkpoint should be written while no transactions are running.
+ */
+class CheckpointWriter {
+ public:
+  static constexpr char MAGIC[8] = {'H', 'Y', 'R', 'C', 'K', 'P', 'T', '\0'};
+  static constexpr uint32_t FORMAT_VERSION = 1;
+
+  // Writes the checkpoint and returns the commit id it is consistent with. The file is first written under a temporary
+  // name and only replaces an existing checkpoint at `path` once it is complete and synced to disk.
+  static CommitID write(const std::filesystem::path& path);
+
+ private:
+  /**
+   * Header of the checkpoint file, padded to the page size:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Magic                       | char array                          | 8
+   * Format version              | uint32_t                            | 4
+   * Page size                   | uint32_t                            | 4
+   * Commit id                   | CommitID                            | 4
+   * Table count                 | uint32_t                            | 4
+   * Table directory offset      | uint64_t                            | 8
+   * Table directory size        | uint64_t                            | 8
+   */
+  static void _write_header(std::ofstream& ofstream, CommitID commit_id, uint32_t table_count,
+                            uint64_t directory_offset, uint64_t directory_size);
+
+  /**
+   * Writes a chunk block, which consists of the chunk in the format of BinaryWriter::_write_chunk followed by:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Chunk is mutable            | bool (stored as BoolAsByteType)     | 1
+   * Begin commit ids¹           | CommitID array                      | Row count * 4
+   * End commit ids¹             | CommitID array                      | Row count * 4
+   * Invalid row count           | ChunkOffset                         | 4
+   * Has pruning statistics      | bool (stored as BoolAsByteType)     | 1
+   * Pruning statistics²         | see _write_pruning_statistics       | variable
+   *
+   * ¹ Only written for tables that use MVCC
+   * ² Only written if the chunk has pruning statistics and no rows of it were updated in place
+   *
+   * Mutable chunks may be appended to concurrently. Only the rows that exist when the chunk is visited are written.
+   * ForeignSegments are loaded from their file, so that the restored chunk holds the data.
+   * Rows that were updated in place (see RowVersions) are written with the values they have at `commit_id`.
+   */
+  static void _write_chunk(std::ofstream& ofstream, const Table& table, const Chunk& chunk, CommitID commit_id);
+
+  /**
+   * Writes the pruning statistics of each column:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Statistics objects          | uint8_t (see PruningStatisticsFlag) | 1
+   * Minimum¹                    | T                                   | sizeof(T)
+   * Maximum¹                    | T                                   | sizeof(T)
+   * Range count²                | uint64_t                            | 8
+   * Ranges²                     | pair<T, T> array                    | Range count * 2 * sizeof(T)
+   * NULL value ratio³           | float                               | 4
+   *
+   * ¹ Only written for a MinMaxFilter. Strings are stored as their length (uint64_t) followed by their characters.
+   * ² Only written for a RangeFilter
+   * ³ Only written for NullValueRatioStatistics
+   *
+   * Histograms are not used for pruning and thus not written.
+   */
+  static void _write_pruning_statistics(std::ofstream& ofstream, const Table& table, const Chunk& chunk);
+
+  /**
+   * Writes the entry of a table in the table directory:
+   *
+   * Description                 | Type                                | Size in bytes
+   * --------------------------------------------------------------------------------------------------------
+   * Table name length           | uint64_t                            | 8
+   * Table name                  | char array                          | Table name length
+   * Table uses MVCC             | bool (stored as BoolAsByteType)     | 1
+   * Table header¹               | see BinaryWriter::_write_header     | variable
+   * Chunk count                 | ChunkID                             | 4
+   * Chunk block offsets         | uint64_t array                      | Chunk count * 8
+   * Chunk block sizes           | uint64_t array                      | Chunk count * 8
+   *
+   * ¹ The chunk count in the table header is ignored, as chunks might have been appended after the chunk blocks of
+   *   the table were written.
+   */
+  static void _write_directory_entry(std::ofstream& ofstream, const std::string& table_name, const Table& table,
+                                     const std::vector<uint64_t>& block_offsets,
+                                     const std::vector<uint64_t>& block_sizes);
+};
+
+// Flags of the statistics objects that are stored for a column's pruning statistics
+enum class PruningStatisticsFlag : uint8_t { MinMaxFilter = 1, RangeFilter = 2, NullValueRatio = 4 };
+
+}  // namespace opossum
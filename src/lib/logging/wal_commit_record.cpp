@@ -0,0 +1,351 @@
+#include "wal_commit_record.hpp"
+
+#include <boost/crc.hpp>
+
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "resolve_type.hpp"
+#include "storage/pos_lists/abstract_pos_list.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+constexpr auto RECORD_HEADER_SIZE = sizeof(uint32_t) + sizeof(uint32_t);
+
+uint32_t checksum(const char* data, const size_t size) {
+  auto crc = boost::crc_32_type{};
+  crc.process_bytes(data, size);
+  return crc.checksum();
+}
+
+// Bounds-checked reading of a record's payload. All read methods return false once the end of the payload is
+// reached, which means that the record is corrupted.
+class PayloadReader {
+ public:
+  PayloadReader(const char* data, const size_t size) : _data(data), _size(size) {}
+
+  template <typename T>
+  bool read(T& value) {
+    if (_offset + sizeof(T) > _size) return false;
+    std::memcpy(&value, _data + _offset, sizeof(T));
+    _offset += sizeof(T);
+    return true;
+  }
+
+  template <typename StringType>
+  bool read_string(StringType& string) {
+    auto length = uint32_t{0};
+    if (!read(length) || _offset + length > _size) return false;
+    string = StringType{_data + _offset, length};
+    _offset += length;
+    return true;
+  }
+
+  bool read_row_id(RowID& row_id) { return read(row_id.chunk_id) && read(row_id.chunk_offset); }
+
+  bool at_end() const { return _offset == _size; }
+
+ private:
+  const char* const _data;
+  const size_t _size;
+  size_t _offset{0};
+};
+
+bool read_data_type(PayloadReader& reader, DataType& data_type) {
+  constexpr auto DATA_TYPE_COUNT = decltype(hana::size(data_types_including_null))::value;
+
+  return reader.read(data_type) && data_type != DataType::Null && static_cast<size_t>(data_type) < DATA_TYPE_COUNT;
+}
+
+bool deserialize_insert_entry(PayloadReader& reader, WalCommitRecord::Entry& entry) {
+  auto first_row_id = RowID{};
+  auto row_count = uint32_t{0};
+  auto column_count = ColumnCount{0};
+  if (!reader.read_row_id(first_row_id) || !reader.read(row_count) || !reader.read(column_count)) return false;
+
+  auto data_types = std::vector<DataType>(column_count);
+  for (auto& data_type : data_types) {
+    if (!read_data_type(reader, data_type)) return false;
+  }
+
+  entry.row_ids.reserve(row_count);
+  for (auto row_index = uint32_t{0}; row_index < row_count; ++row_index) {
+    entry.row_ids.emplace_back(
+        RowID{first_row_id.chunk_id, static_cast<ChunkOffset>(first_row_id.chunk_offset + row_index)});
+  }
+
+  entry.rows.resize(row_count, std::vector<AllTypeVariant>(column_count));
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    auto success = true;
+    resolve_data_type(data_types[column_id], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      for (auto& row : entry.rows) {
+        auto is_null = BoolAsByteType{0};
+        success = reader.read(is_null);
+        if (!success) return;
+
+        if (is_null) {
+          row[column_id] = NULL_VALUE;
+          continue;
+        }
+
+        auto value = ColumnDataType{};
+        if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          success = reader.read_string(value);
+        } else {
+          success = reader.read(value);
+        }
+        if (!success) return;
+
+        row[column_id] = std::move(value);
+      }
+    });
+    if (!success) return false;
+  }
+
+  return true;
+}
+
+bool deserialize_delete_entry(PayloadReader& reader, WalCommitRecord::Entry& entry) {
+  auto row_count = uint32_t{0};
+  if (!reader.read(row_count)) return false;
+
+  entry.row_ids.resize(row_count);
+  for (auto& row_id : entry.row_ids) {
+    if (!reader.read_row_id(row_id)) return false;
+  }
+
+  return true;
+}
+
+bool deserialize_update_entry(PayloadReader& reader, WalCommitRecord::Entry& entry) {
+  auto row_count = uint32_t{0};
+  if (!reader.read(row_count)) return false;
+
+  entry.row_ids.resize(row_count);
+  entry.rows.resize(row_count);
+  entry.column_ids.resize(row_count);
+  for (auto row_index = uint32_t{0}; row_index < row_count; ++row_index) {
+    auto value_count = ColumnCount{0};
+    if (!reader.read_row_id(entry.row_ids[row_index]) || !reader.read(value_count)) return false;
+
+    for (auto value_index = ColumnCount{0}; value_index < value_count; ++value_index) {
+      auto column_id = ColumnID{0};
+      auto data_type = DataType::Null;
+      auto is_null = BoolAsByteType{0};
+      if (!reader.read(column_id) || !read_data_type(reader, data_type) || !reader.read(is_null)) return false;
+
+      entry.column_ids[row_index].emplace_back(column_id);
+      if (is_null) {
+        entry.rows[row_index].emplace_back(NULL_VALUE);
+        continue;
+      }
+
+      auto success = true;
+      resolve_data_type(data_type, [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+
+        auto value = ColumnDataType{};
+        if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          success = reader.read_string(value);
+        } else {
+          success = reader.read(value);
+        }
+        entry.rows[row_index].emplace_back(std::move(value));
+      });
+      if (!success) return false;
+    }
+  }
+
+  return true;
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::optional<WalCommitRecord> WalCommitRecord::deserialize(const char* data, const size_t size,
+                                                            size_t& record_size) {
+  if (size < RECORD_HEADER_SIZE) return std::nullopt;
+
+  auto payload_size = uint32_t{0};
+  auto payload_checksum = uint32_t{0};
+  std::memcpy(&payload_size, data, sizeof(uint32_t));
+  std::memcpy(&payload_checksum, data + sizeof(uint32_t), sizeof(uint32_t));
+
+  if (RECORD_HEADER_SIZE + payload_size > size) return std::nullopt;
+
+  const auto* const payload = data + RECORD_HEADER_SIZE;
+  if (checksum(payload, payload_size) != payload_checksum) return std::nullopt;
+
+  auto reader = PayloadReader{payload, payload_size};
+  auto record = WalCommitRecord{};
+  auto entry_count = uint32_t{0};
+  if (!reader.read(record.commit_id) || !reader.read(entry_count)) return std::nullopt;
+
+  record.entries.resize(entry_count);
+  for (auto& entry : record.entries) {
+    if (!reader.read(entry.type) || !reader.read_string(entry.table_name)) return std::nullopt;
+
+    switch (entry.type) {
+      case WalEntryType::Insert:
+        if (!deserialize_insert_entry(reader, entry)) return std::nullopt;
+        break;
+      case WalEntryType::Delete:
+        if (!deserialize_delete_entry(reader, entry)) return std::nullopt;
+        break;
+      case WalEntryType::Update:
+        if (!deserialize_update_entry(reader, entry)) return std::nullopt;
+        break;
+      default:
+        return std::nullopt;
+    }
+  }
+
+  if (!reader.at_end()) return std::nullopt;
+
+  record_size = RECORD_HEADER_SIZE + payload_size;
+  return record;
+}
+
+WalCommitRecordWriter::WalCommitRecordWriter(const CommitID commit_id) {
+  // Reserve space for the record header and the entry count, which are written in finish().
+  _buffer.resize(RECORD_HEADER_SIZE);
+  _write(commit_id);
+  _write(uint32_t{0});
+}
+
+void WalCommitRecordWriter::add_insert(const std::string& table_name, const Table& table, const ChunkID chunk_id,
+                                       const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset) {
+  DebugAssert(begin_chunk_offset <= end_chunk_offset, "Invalid range of inserted rows");
+  if (begin_chunk_offset == end_chunk_offset) return;
+
+  _add_entry_header(WalEntryType::Insert, table_name);
+
+  const auto column_count = table.column_count();
+  _write(chunk_id);
+  _write(begin_chunk_offset);
+  _write(static_cast<uint32_t>(end_chunk_offset - begin_chunk_offset));
+  _write(ColumnCount{column_count});
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    _write(table.column_data_type(column_id));
+  }
+
+  const auto chunk = table.get_chunk(chunk_id);
+  Assert(chunk, "Cannot log rows of a physically deleted chunk");
+
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(table.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto value_segment =
+          std::dynamic_pointer_cast<const ValueSegment<ColumnDataType>>(chunk->get_segment(column_id));
+      Assert(value_segment, "Can only log inserts into ValueSegments");
+
+      const auto& values = value_segment->values();
+      const auto is_nullable = value_segment->is_nullable();
+      for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+        const auto is_null = is_nullable && value_segment->null_values()[chunk_offset];
+        _write(static_cast<BoolAsByteType>(is_null));
+        if (is_null) continue;
+
+        if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          _write_string(values[chunk_offset]);
+        } else {
+          _write(values[chunk_offset]);
+        }
+      }
+    });
+  }
+}
+
+void WalCommitRecordWriter::add_delete(const std::string& table_name, const AbstractPosList& pos_list) {
+  if (pos_list.empty()) return;
+
+  _add_entry_header(WalEntryType::Delete, table_name);
+
+  _write(static_cast<uint32_t>(pos_list.size()));
+  for (const auto row_id : pos_list) {
+    _write(row_id.chunk_id);
+    _write(row_id.chunk_offset);
+  }
+}
+
+void WalCommitRecordWriter::add_update(
+    const std::string& table_name, const Table& table,
+    const std::vector<std::pair<RowID, std::shared_ptr<const RowVersion>>>& updated_rows) {
+  if (updated_rows.empty()) return;
+
+  _add_entry_header(WalEntryType::Update, table_name);
+
+  _write(static_cast<uint32_t>(updated_rows.size()));
+  for (const auto& [row_id, version] : updated_rows) {
+    _write(row_id.chunk_id);
+    _write(row_id.chunk_offset);
+    _write(ColumnCount{static_cast<ColumnCount::base_type>(version->values.size())});
+
+    for (const auto& [column_id, value] : version->values) {
+      const auto data_type = table.column_data_type(column_id);
+      const auto is_null = variant_is_null(value);
+      _write(column_id);
+      _write(data_type);
+      _write(static_cast<BoolAsByteType>(is_null));
+      if (is_null) continue;
+
+      resolve_data_type(data_type, [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+
+        if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          _write_string(boost::get<pmr_string>(value));
+        } else {
+          _write(boost::get<ColumnDataType>(value));
+        }
+      });
+    }
+  }
+}
+
+bool WalCommitRecordWriter::empty() const { return _entry_count == 0; }
+
+std::vector<char> WalCommitRecordWriter::finish() {
+  const auto payload_size = static_cast<uint32_t>(_buffer.size() - RECORD_HEADER_SIZE);
+
+  // The entry count follows the commit id
+  std::memcpy(_buffer.data() + RECORD_HEADER_SIZE + sizeof(CommitID), &_entry_count, sizeof(uint32_t));
+
+  const auto payload_checksum = checksum(_buffer.data() + RECORD_HEADER_SIZE, payload_size);
+  std::memcpy(_buffer.data(), &payload_size, sizeof(uint32_t));
+  std::memcpy(_buffer.data() + sizeof(uint32_t), &payload_checksum, sizeof(uint32_t));
+
+  return std::move(_buffer);
+}
+
+template <typename T>
+void WalCommitRecordWriter::_write(const T& value) {
+  static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable types can be written directly");
+  const auto offset = _buffer.size();
+  _buffer.resize(offset + sizeof(T));
+  std::memcpy(_buffer.data() + offset, &value, sizeof(T));
+}
+
+void WalCommitRecordWriter::_write_string(const std::string_view string) {
+  _write(static_cast<uint32_t>(string.size()));
+  _buffer.insert(_buffer.end(), string.begin(), string.end());
+}
+
+void WalCommitRecordWriter::_add_entry_header(const WalEntryType type, const std::string& table_name) {
+  ++_entry_count;
+  _write(type);
+  _write_string(table_name);
+}
+
+}  // namespace opossum
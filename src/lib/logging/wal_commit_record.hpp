@@ -0,0 +1,110 @@
+#pragma once
+
+#include <memory>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractPosList;
+class Table;
+struct RowVersion;
+
+enum class WalEntryType : uint8_t { Insert, Delete, Update };
+
+/**
+ * The effects of a single committed transaction as stored in the write-ahead log (see WriteAheadLog). On disk, a
+ * record has the following layout:
+ *
+ * Description                 | Type                                | Size in bytes
+ * --------------------------------------------------------------------------------------------------------
+ * Payload size                | uint32_t                            | 4
+ * Payload checksum            | uint32_t (CRC-32)                   | 4
+ * Commit ID                   | CommitID                            | 4
+ * Entry count                 | uint32_t                            | 4
+ * Entries                     | see below                           | Payload size - 8
+ *
+ * Each entry starts with its WalEntryType (1 byte) and the name of the modified table (uint32_t length + chars).
+ *  - An Insert entry continues with the RowID of the first inserted row, the number of inserted rows (uint32_t), the
+ *    column count (ColumnCount), and the DataType of each column (1 byte each). The inserted rows are consecutive
+ *    within one chunk. Their values follow column by column, each value is preceded by a NULL flag (BoolAsByteType).
+ *    Strings are stored as uint32_t length + chars.
+ *  - A Delete entry continues with the number of invalidated rows (uint32_t) and their RowIDs.
+ *  - An Update entry continues with the number of rows that were updated in place (uint32_t). For each row, it stores
+ *    the RowID, the number of changed values (ColumnCount), and for each value its ColumnID, its DataType (1 byte), a
+ *    NULL flag, and the value itself if it is not NULL. The values are those of the row's new RowVersion.
+ * Updates that are not executed in place are logged as a Delete followed by an Insert, just as they are executed.
+ *
+ * Rows are logged with their physical position so that recovery can restore every row at its original RowID. This
+ * keeps the RowIDs of later Delete entries valid, even though the order in which rows were allocated (i.e., the order
+ * of RowIDs) is not necessarily the order in which their transactions committed.
+ */
+struct WalCommitRecord {
+  struct Entry {
+    WalEntryType type{WalEntryType::Insert};
+    std::string table_name;
+
+    // Insert: the positions of the inserted rows. Delete: the invalidated rows. Update: the updated rows.
+    std::vector<RowID> row_ids;
+
+    // Insert: the values of the inserted rows, in the order of row_ids. Update: the changed values of the rows.
+    std::vector<std::vector<AllTypeVariant>> rows;
+
+    // Update only: the ColumnIDs of the changed values in `rows`.
+    std::vector<std::vector<ColumnID>> column_ids;
+  };
+
+  // Parses the record at the beginning of `data`. Returns std::nullopt if `size` bytes do not contain a complete and
+  // intact record, e.g., because the record was only partially written before a crash. On success, `record_size`
+  // is set to the number of bytes that the record occupies in the log.
+  static std::optional<WalCommitRecord> deserialize(const char* data, const size_t size, size_t& record_size);
+
+  CommitID commit_id{0};
+  std::vector<Entry> entries;
+};
+
+/**
+ * Serializes the effects of a transaction into the format described in WalCommitRecord. Values are read directly
+ * from the modified tables, i.e., the rows do not have to be materialized as AllTypeVariants.
+ */
+class WalCommitRecordWriter {
+ public:
+  explicit WalCommitRecordWriter(const CommitID commit_id);
+
+  // Logs the rows [begin_chunk_offset, end_chunk_offset) of the chunk `chunk_id` as inserted. The chunk's segments
+  // need to be ValueSegments, which is guaranteed for rows that were inserted by the Insert operator.
+  void add_insert(const std::string& table_name, const Table& table, const ChunkID chunk_id,
+                  const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset);
+
+  // Logs the rows in `pos_list` as deleted.
+  void add_delete(const std::string& table_name, const AbstractPosList& pos_list);
+
+  // Logs the rows as updated in place, i.e., as having the given new versions.
+  void add_update(const std::string& table_name, const Table& table,
+                  const std::vector<std::pair<RowID, std::shared_ptr<const RowVersion>>>& updated_rows);
+
+  // Returns true if no entries have been added
+  bool empty() const;
+
+  // Returns the serialized record, including its size and checksum. The writer must not be used afterwards.
+  std::vector<char> finish();
+
+ private:
+  template <typename T>
+  void _write(const T& value);
+
+  void _write_string(const std::string_view string);
+
+  void _add_entry_header(const WalEntryType type, const std::string& table_name);
+
+  std::vector<char> _buffer;
+  uint32_t _entry_count{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,221 @@
+#include "wal_recovery.hpp"
+
+#include <algorithm>
+#include <fstream>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "logging/wal_commit_record.hpp"
+#include "resolve_type.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+struct LoggedRow {
+  RowID row_id;
+  CommitID commit_id;
+  const std::vector<AllTypeVariant>* values;
+};
+
+// Overwrites the values of a row that exists in a mutable chunk, but whose insert had not committed when the
+// checkpoint the table was loaded from was written.
+void overwrite_row(const Chunk& chunk, const ChunkOffset chunk_offset, const std::vector<AllTypeVariant>& values) {
+  for (auto column_id = ColumnID{0}; column_id < chunk.column_count(); ++column_id) {
+    const auto segment = chunk.get_segment(column_id);
+    resolve_data_type(segment->data_type(), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+      auto& value_segment = static_cast<ValueSegment<ColumnDataType>&>(*segment);
+
+      // NULL flags are only ever set, never cleared, so the checkpoint cannot contain a NULL for a non-NULL value.
+      if (variant_is_null(values[column_id])) {
+        value_segment.set_null_value(chunk_offset);
+      } else {
+        value_segment.values()[chunk_offset] = boost::get<ColumnDataType>(values[column_id]);
+      }
+    });
+  }
+}
+
+// Restores the logged rows, sorted by their RowIDs. Rows that are missing in the table are appended, gaps are filled
+// with invisible rows.
+void restore_rows(Table& table, const std::vector<LoggedRow>& rows) {
+  Assert(table.uses_mvcc() == UseMvcc::Yes, "Can only recover tables with MVCC data");
+
+  // Values for rows that were inserted and rolled back. They are invisible, but need to occupy their position.
+  auto placeholder_values = std::vector<AllTypeVariant>{};
+  for (const auto& column_definition : table.column_definitions()) {
+    if (column_definition.nullable) {
+      placeholder_values.emplace_back(NULL_VALUE);
+    } else {
+      resolve_data_type(column_definition.data_type, [&](const auto data_type_t) {
+        using ColumnDataType = typename decltype(data_type_t)::type;
+        placeholder_values.emplace_back(ColumnDataType{});
+      });
+    }
+  }
+
+  for (const auto& [row_id, commit_id, values] : rows) {
+    while (table.chunk_count() <= row_id.chunk_id) {
+      table.append_mutable_chunk();
+    }
+
+    const auto chunk = table.get_chunk(row_id.chunk_id);
+    const auto& mvcc_data = chunk->mvcc_data();
+
+    if (row_id.chunk_offset < chunk->size()) {
+      // The row was already allocated when the checkpoint was written, but its transaction had not committed yet.
+      Assert(mvcc_data->get_begin_cid(row_id.chunk_offset) == MvccData::MAX_COMMIT_ID,
+             "Logged row conflicts with the existing data of table. Tables need to be in the state they had when "
+             "logging started or in the state of a checkpoint.");
+
+      // Once a chunk is immutable, its rows are completely written and the checkpoint contains their final values.
+      if (chunk->is_mutable()) overwrite_row(*chunk, row_id.chunk_offset, *values);
+      mvcc_data->set_begin_cid(row_id.chunk_offset, commit_id);
+      continue;
+    }
+
+    Assert(chunk->is_mutable(), "Logged row conflicts with the existing data of table. Tables need to be in the "
+                                "state they had when logging started or in the state of a checkpoint.");
+
+    while (chunk->size() < row_id.chunk_offset) {
+      const auto chunk_offset = chunk->size();
+      chunk->append(placeholder_values);
+      mvcc_data->set_end_cid(chunk_offset, CommitID{0});
+      mvcc_data->set_begin_cid(chunk_offset, CommitID{0});
+      chunk->increase_invalid_row_count(1);
+    }
+
+    chunk->append(*values);
+    mvcc_data->set_begin_cid(row_id.chunk_offset, commit_id);
+  }
+}
+
+}  // namespace
+
+namespace opossum {
+
+size_t WalRecovery::recover(const std::filesystem::path& path) {
+  Assert(!Hyrise::get().write_ahead_log, "Recovery needs to happen before write-ahead logging is enabled");
+  if (!std::filesystem::exists(path)) return 0;
+
+  auto data = std::vector<char>(std::filesystem::file_size(path));
+  {
+    auto file = std::ifstream{path, std::ios::binary};
+    Assert(file.is_open(), "Could not open write-ahead log '" + path.string() + "'");
+    file.read(data.data(), static_cast<std::streamsize>(data.size()));
+  }
+
+  auto records = std::vector<WalCommitRecord>{};
+  auto offset = size_t{0};
+  while (offset < data.size()) {
+    auto record_size = size_t{0};
+    auto record = WalCommitRecord::deserialize(data.data() + offset, data.size() - offset, record_size);
+    if (!record) break;
+
+    records.emplace_back(std::move(*record));
+    offset += record_size;
+  }
+
+  if (offset < data.size()) {
+    // The last record was torn by a crash. Drop it so that new records are not appended after a corrupted one.
+    std::filesystem::resize_file(path, offset);
+  }
+
+  auto& storage_manager = Hyrise::get().storage_manager;
+  const auto get_table = [&](const std::string& table_name) {
+    Assert(storage_manager.has_table(table_name),
+           "Table '" + table_name + "' needs to be loaded before the write-ahead log can be recovered");
+    return storage_manager.get_table(table_name);
+  };
+
+  // Records of transactions that committed before the tables were loaded from a checkpoint (see CheckpointLoader) are
+  // already contained in the tables.
+  const auto checkpoint_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+  records.erase(std::remove_if(records.begin(), records.end(),
+                               [&](const auto& record) { return record.commit_id <= checkpoint_commit_id; }),
+                records.end());
+
+  // Insert rows in the order of their RowIDs, which is not necessarily the commit order (see WalCommitRecord).
+  auto logged_rows_by_table = std::unordered_map<std::string, std::vector<LoggedRow>>{};
+  auto last_commit_id = checkpoint_commit_id;
+  for (const auto& record : records) {
+    last_commit_id = std::max(last_commit_id, record.commit_id);
+
+    for (const auto& entry : record.entries) {
+      if (entry.type != WalEntryType::Insert) continue;
+
+      auto& logged_rows = logged_rows_by_table[entry.table_name];
+      for (auto row_index = size_t{0}; row_index < entry.row_ids.size(); ++row_index) {
+        logged_rows.emplace_back(LoggedRow{entry.row_ids[row_index], record.commit_id, &entry.rows[row_index]});
+      }
+    }
+  }
+
+  for (auto& [table_name, logged_rows] : logged_rows_by_table) {
+    std::sort(logged_rows.begin(), logged_rows.end(),
+              [](const auto& lhs, const auto& rhs) { return lhs.row_id < rhs.row_id; });
+    restore_rows(*get_table(table_name), logged_rows);
+  }
+
+  // All inserted rows exist now, so the deletes can be applied.
+  for (const auto& record : records) {
+    for (const auto& entry : record.entries) {
+      if (entry.type != WalEntryType::Delete) continue;
+
+      const auto table = get_table(entry.table_name);
+      for (const auto& row_id : entry.row_ids) {
+        const auto chunk = table->get_chunk(row_id.chunk_id);
+        Assert(chunk && row_id.chunk_offset < chunk->size(), "Logged delete refers to a non-existing row");
+
+        chunk->mvcc_data()->set_end_cid(row_id.chunk_offset, record.commit_id);
+        chunk->increase_invalid_row_count(1);
+      }
+    }
+  }
+
+  // Rows that were updated in place keep their RowIDs, so they exist as well. Their versions are restored in the
+  // order in which they were committed.
+  auto update_entries = std::vector<std::pair<CommitID, const WalCommitRecord::Entry*>>{};
+  for (const auto& record : records) {
+    for (const auto& entry : record.entries) {
+      if (entry.type == WalEntryType::Update) update_entries.emplace_back(record.commit_id, &entry);
+    }
+  }
+  std::stable_sort(update_entries.begin(), update_entries.end(),
+                   [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+
+  for (const auto& [commit_id, entry] : update_entries) {
+    const auto table = get_table(entry->table_name);
+    for (auto row_index = size_t{0}; row_index < entry->row_ids.size(); ++row_index) {
+      const auto& row_id = entry->row_ids[row_index];
+      const auto chunk = table->get_chunk(row_id.chunk_id);
+      Assert(chunk && row_id.chunk_offset < chunk->size(), "Logged update refers to a non-existing row");
+
+      auto values = std::vector<std::pair<ColumnID, AllTypeVariant>>{};
+      for (auto value_index = size_t{0}; value_index < entry->column_ids[row_index].size(); ++value_index) {
+        values.emplace_back(entry->column_ids[row_index][value_index], entry->rows[row_index][value_index]);
+      }
+
+      const auto version = std::make_shared<RowVersion>(INVALID_TRANSACTION_ID, std::move(values));
+      version->begin_cid = commit_id;
+
+      const auto row_versions = chunk->mvcc_data()->get_or_create_row_versions();
+      row_versions->add_version(row_id.chunk_offset, row_versions->newest_version(row_id.chunk_offset), version);
+    }
+  }
+
+  Hyrise::get().transaction_manager._reset_last_commit_id(last_commit_id);
+
+  return records.size();
+}
+
+}  // namespace opossum
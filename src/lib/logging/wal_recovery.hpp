@@ -0,0 +1,30 @@
+#pragma once
+
+#include <filesystem>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Replays a write-ahead log (see WriteAheadLog) into the tables of the StorageManager.
+ *
+ * The log only contains the modifications made by transactions. Thus, the logged tables need to be in the
+ * StorageManager in the state they had when logging started, e.g., by regenerating deterministic benchmark data, or
+ * in the state of a checkpoint (see CheckpointLoader). Records of transactions that are already part of the checkpoint
+ * are skipped. Inserted rows are restored at their logged RowIDs. Positions of rows that were rolled back and thus
+ * never logged are filled with invisible rows. Afterwards, the TransactionManager continues with the commit IDs
+ * following the last recovered one.
+ *
+ * If the last record of the log is incomplete (i.e., the system crashed while writing it), it is discarded and the
+ * log file is truncated to its intact prefix. As commits are only acknowledged once their record is durable, no
+ * acknowledged commit is lost this way.
+ */
+class WalRecovery {
+ public:
+  // Returns the number of replayed commits. Must be called after the checkpoint (if any) is loaded, before transactions
+  // are started, and before a WriteAheadLog is opened for `path`.
+  static size_t recover(const std::filesystem::path& path);
+};
+
+}  // namespace opossum
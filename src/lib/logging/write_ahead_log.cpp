@@ -0,0 +1,127 @@
+#include "write_ahead_log.hpp"
+
+#include <fcntl.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+WriteAheadLog::WriteAheadLog(const std::filesystem::path& path, const std::chrono::microseconds group_commit_delay)
+    : _path(path), _group_commit_delay(group_commit_delay) {
+  _file_descriptor = open(_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, 0644);
+  Assert(_file_descriptor != -1,
+         "Could not open write-ahead log '" + _path.string() + "': " + std::string{std::strerror(errno)});
+
+  _flush_thread = std::thread{&WriteAheadLog::_flush_loop, this};
+}
+
+WriteAheadLog::~WriteAheadLog() {
+  {
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    _shutdown = true;
+  }
+  _pending_condition_variable.notify_one();
+  _flush_thread.join();
+
+  close(_file_descriptor);
+}
+
+void WriteAheadLog::append(std::vector<char>&& record, std::function<void()>&& on_durable) {
+  const auto now = std::chrono::steady_clock::now();
+  {
+    const auto lock = std::lock_guard<std::mutex>{_mutex};
+    DebugAssert(!_shutdown, "Cannot append to a write-ahead log that is being closed");
+
+    if (_appended_count == 0) _statistics.first_append_time = now;
+    ++_appended_count;
+
+    _pending_buffer.insert(_pending_buffer.end(), record.begin(), record.end());
+    _pending_commits.emplace_back(PendingCommit{std::move(on_durable), now});
+  }
+  _pending_condition_variable.notify_one();
+}
+
+void WriteAheadLog::flush() {
+  auto lock = std::unique_lock<std::mutex>{_mutex};
+  const auto appended_count = _appended_count;
+  _durable_condition_variable.wait(lock, [&] { return _durable_count >= appended_count; });
+}
+
+const std::filesystem::path& WriteAheadLog::path() const { return _path; }
+
+WriteAheadLog::Statistics WriteAheadLog::statistics() const {
+  const auto lock = std::lock_guard<std::mutex>{_mutex};
+  return _statistics;
+}
+
+void WriteAheadLog::_flush_loop() {
+  // Buffers are swapped with the pending ones so that their capacity is reused by later batches.
+  auto buffer = std::vector<char>{};
+  auto commits = std::vector<PendingCommit>{};
+
+  auto lock = std::unique_lock<std::mutex>{_mutex};
+  while (true) {
+    _pending_condition_variable.wait(lock, [&] { return !_pending_commits.empty() || _shutdown; });
+    if (_pending_commits.empty()) return;
+
+    if (_group_commit_delay.count() > 0 && !_shutdown) {
+      _pending_condition_variable.wait_for(lock, _group_commit_delay, [&] { return _shutdown; });
+    }
+
+    buffer.clear();
+    commits.clear();
+    std::swap(buffer, _pending_buffer);
+    std::swap(commits, _pending_commits);
+
+    // Transactions committing during the write and sync append to _pending_buffer and form the next batch.
+    lock.unlock();
+    _write_and_sync(buffer);
+    const auto flush_time = std::chrono::steady_clock::now();
+
+    for (const auto& commit : commits) {
+      commit.on_durable();
+    }
+    lock.lock();
+
+    _durable_count += commits.size();
+    _statistics.commit_count += commits.size();
+    ++_statistics.flush_count;
+    _statistics.bytes_written += buffer.size();
+    _statistics.last_flush_time = flush_time;
+    for (const auto& commit : commits) {
+      _statistics.commit_latencies.emplace_back(flush_time - commit.append_time);
+    }
+
+    _durable_condition_variable.notify_all();
+  }
+}
+
+void WriteAheadLog::_write_and_sync(const std::vector<char>& buffer) {
+  auto bytes_written = size_t{0};
+  while (bytes_written < buffer.size()) {
+    const auto result = write(_file_descriptor, buffer.data() + bytes_written, buffer.size() - bytes_written);
+    if (result == -1 && errno == EINTR) continue;
+    Assert(result != -1,
+           "Could not write to write-ahead log '" + _path.string() + "': " + std::string{std::strerror(errno)});
+    bytes_written += static_cast<size_t>(result);
+  }
+
+#ifdef __APPLE__
+  // macOS does not offer fdatasync. F_FULLFSYNC would additionally flush the drive's cache.
+  const auto sync_result = fsync(_file_descriptor);
+#else
+  // As the log is only appended to, fdatasync is sufficient: The file size is part of the synced metadata.
+  const auto sync_result = fdatasync(_file_descriptor);
+#endif
+  Assert(sync_result == 0,
+         "Could not sync write-ahead log '" + _path.string() + "': " + std::string{std::strerror(errno)});
+}
+
+}  // namespace opossum
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <filesystem>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Write-ahead log that makes committed transactions durable. If Hyrise::get().write_ahead_log is set, each committing
+ * transaction that modified data serializes its effects into a WalCommitRecord and appends it to the log (see
+ * TransactionContext::commit_async). The transaction only becomes visible and is only reported as committed once its
+ * record has been written and synced to disk. As a consequence, every transaction that observed the effects of
+ * another transaction is logged after it, and any durable prefix of the log is a consistent state. After a crash,
+ * WalRecovery replays the log.
+ *
+ * Records are made durable by a background thread using group commit: While one batch of records is being written
+ * and synced, the records of concurrently committing transactions are collected and later flushed together. Thus,
+ * the cost of a sync is shared by all transactions of a batch. Optionally, the flush thread waits for
+ * `group_commit_delay` before flushing to collect larger batches at the cost of a higher commit latency.
+ */
+class WriteAheadLog : private Noncopyable {
+ public:
+  struct Statistics {
+    size_t commit_count{0};
+    size_t flush_count{0};
+    size_t bytes_written{0};
+
+    // Time between WriteAheadLog::append() and the record being durable, for each durable commit
+    std::vector<std::chrono::nanoseconds> commit_latencies;
+
+    // Time of the first append and of the completion of the last flush, used to calculate the commit throughput
+    std::chrono::steady_clock::time_point first_append_time;
+    std::chrono::steady_clock::time_point last_flush_time;
+  };
+
+  // Opens the log file at `path`, which is created if it does not exist yet. New records are appended to the file.
+  // Existing records should be recovered (see WalRecovery) before the log is opened.
+  explicit WriteAheadLog(const std::filesystem::path& path,
+                         const std::chrono::microseconds group_commit_delay = std::chrono::microseconds{0});
+
+  // Flushes all pending records and closes the log file.
+  ~WriteAheadLog();
+
+  // Appends a serialized record (see WalCommitRecordWriter). `on_durable` is called from the flush thread once the
+  // record has been synced to disk. Thread-safe.
+  void append(std::vector<char>&& record, std::function<void()>&& on_durable);
+
+  // Blocks until all records that have been appended so far are durable.
+  void flush();
+
+  const std::filesystem::path& path() const;
+
+  Statistics statistics() const;
+
+ private:
+  struct PendingCommit {
+    std::function<void()> on_durable;
+    std::chrono::steady_clock::time_point append_time;
+  };
+
+  void _flush_loop();
+
+  void _write_and_sync(const std::vector<char>& buffer);
+
+  const std::filesystem::path _path;
+  const std::chrono::microseconds _group_commit_delay;
+  int _file_descriptor;
+
+  mutable std::mutex _mutex;
+  std::condition_variable _pending_condition_variable;
+  std::condition_variable _durable_condition_variable;
+
+  // Records that have been appended but not yet flushed, protected by _mutex
+  std::vector<char> _pending_buffer;
+  std::vector<PendingCommit> _pending_commits;
+  size_t _appended_count{0};
+  size_t _durable_count{0};
+  bool _shutdown{false};
+
+  Statistics _statistics;
+
+  std::thread _flush_thread;
+};
+
+}  // namespace opossum
@@ -1,5 +1,6 @@
 #include "lqp_translator.hpp"
 
+#include <algorithm>
 #include <memory>
 #include <string>
 #include <vector>
@@ -21,7 +22,9 @@
 #include "export_node.hpp"
 #include "expression/abstract_expression.hpp"
 #include "expression/abstract_predicate_expression.hpp"
+#include "expression/binary_predicate_expression.hpp"
 #include "expression/expression_utils.hpp"
+#include "expression/logical_expression.hpp"
 #include "expression/lqp_column_expression.hpp"
 #include "expression/lqp_subquery_expression.hpp"
 #include "expression/pqp_column_expression.hpp"
@@ -45,6 +48,7 @@
 #include "operators/join_hash.hpp"
 #include "operators/join_nested_loop.hpp"
 #include "operators/join_sort_merge.hpp"
+#include "operators/key_index_lookup.hpp"
 #include "operators/limit.hpp"
 #include "operators/maintenance/create_prepared_plan.hpp"
 #include "operators/maintenance/create_table.hpp"
@@ -53,6 +57,7 @@
 #include "operators/maintenance/drop_view.hpp"
 #include "operators/operator_join_predicate.hpp"
 #include "operators/operator_scan_predicate.hpp"
+#include "operators/pipelined_scan.hpp"
 #include "operators/product.hpp"
 #include "operators/projection.hpp"
 #include "operators/sort.hpp"
@@ -74,6 +79,9 @@ using namespace std::string_literals;  // NOLINT
 
 namespace opossum {
 
+LQPTranslator::LQPTranslator(const UsePipelinedExecution use_pipelined_execution)
+    : _use_pipelined_execution(use_pipelined_execution) {}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::translate_node(const std::shared_ptr<AbstractLQPNode>& node) const {
   /**
    * Translate a node (i.e. call `_translate_by_node_type`) only if it hasn't been translated before, otherwise just
@@ -106,7 +114,9 @@ std::shared_ptr<AbstractOperator> LQPTranslator::translate_node(const std::share
     return operator_iter->second;
   }
 
-  auto pqp = _translate_by_node_type(node->type, node);
+  auto pqp = std::shared_ptr<AbstractOperator>{};
+  if (_use_pipelined_execution == UsePipelinedExecution::Yes) pqp = _translate_to_pipelined_scan(node);
+  if (!pqp) pqp = _translate_by_node_type(node->type, node);
 
   // Adding the actual LQP node that led to the creation of the PQP node.  Note, the LQP needs to be set in
   // _translate_predicate_node_to_index_scan() as well, because the function creates two scans operators and returns
@@ -165,15 +175,23 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_stored_table_node(
 
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
+  const auto predicate_node = std::dynamic_pointer_cast<PredicateNode>(node);
+
+  // The KeyIndexLookup replaces the GetTable of the input node, so the input is not translated.
+  if (predicate_node->scan_type == ScanType::KeyIndexLookup) {
+    return _translate_predicate_node_to_key_index_lookup(predicate_node);
+  }
+
   const auto input_node = node->left_input();
   const auto input_operator = translate_node(input_node);
-  const auto predicate_node = std::dynamic_pointer_cast<PredicateNode>(node);
 
   switch (predicate_node->scan_type) {
     case ScanType::TableScan:
       return _translate_predicate_node_to_table_scan(predicate_node, input_operator);
     case ScanType::IndexScan:
       return _translate_predicate_node_to_index_scan(predicate_node, input_operator);
+    case ScanType::KeyIndexLookup:
+      break;
   }
 
   Fail("Invalid enum value");
@@ -267,6 +285,32 @@ std::shared_ptr<TableScan> LQPTranslator::_translate_predicate_node_to_table_sca
   return std::make_shared<TableScan>(input_operator, _translate_expression(node->predicate(), node->left_input()));
 }
 
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_predicate_node_to_key_index_lookup(
+    const std::shared_ptr<PredicateNode>& node) const {
+  const auto stored_table_node = std::dynamic_pointer_cast<StoredTableNode>(node->left_input());
+  Assert(stored_table_node, "KeyIndexLookup must follow a StoredTableNode.");
+
+  // The predicate is a conjunction of `<column> = <value>` predicates in the column order of the key index (see
+  // KeyIndexLookupRule).
+  auto key_column_ids = std::vector<ColumnID>{};
+  auto key_values = std::vector<std::shared_ptr<AbstractExpression>>{};
+  for (const auto& expression : flatten_logical_expressions(node->predicate(), LogicalOperator::And)) {
+    const auto predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(expression);
+    Assert(predicate && predicate->predicate_condition == PredicateCondition::Equals,
+           "Expected equality predicate for KeyIndexLookup");
+
+    const auto column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(predicate->left_operand());
+    Assert(column_expression && column_expression->original_node.lock() == stored_table_node,
+           "Expected column of the stored table as left operand for KeyIndexLookup");
+
+    key_column_ids.emplace_back(column_expression->original_column_id);
+    key_values.emplace_back(_translate_expression(predicate->right_operand(), stored_table_node));
+  }
+
+  return std::make_shared<KeyIndexLookup>(stored_table_node->table_name, stored_table_node->pruned_column_ids(),
+                                          key_column_ids, key_values);
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_alias_node(
     const std::shared_ptr<opossum::AbstractLQPNode>& node) const {
   const auto alias_node = std::dynamic_pointer_cast<AliasNode>(node);
@@ -481,6 +525,55 @@ std::shared_ptr<AbstractOperator> LQPTranslator::_translate_validate_node(
   return std::make_shared<Validate>(input_operator);
 }
 
+std::shared_ptr<AbstractOperator> LQPTranslator::_translate_to_pipelined_scan(
+    const std::shared_ptr<AbstractLQPNode>& node) const {
+  /**
+   * Walk down from `node` as long as we find ValidateNodes and PredicateNodes that are scanned with a TableScan. Nodes
+   * below the top of the chain must have no other outputs - otherwise, their result would be needed elsewhere and they
+   * have to be translated into an operator of their own. Both validation and predicates filter rows without changing
+   * the columns, so the order in which they are applied does not matter for the result. The PipelinedScan always
+   * validates first, which keeps the scans from looking at invisible rows.
+   */
+  auto validate = false;
+  auto predicates = std::vector<std::shared_ptr<AbstractExpression>>{};
+
+  auto current_node = node;
+  while (true) {
+    if (current_node != node && current_node->output_count() > 1) break;
+
+    if (current_node->type == LQPNodeType::Validate) {
+      if (validate) break;
+      validate = true;
+    } else if (current_node->type == LQPNodeType::Predicate) {
+      const auto predicate_node = std::static_pointer_cast<PredicateNode>(current_node);
+      if (predicate_node->scan_type != ScanType::TableScan) break;
+
+      // Subqueries are registered as consumers by the TableScan and would need special handling.
+      const auto predicate = predicate_node->predicate();
+      auto has_subquery = false;
+      visit_expression(predicate, [&](const auto& sub_expression) {
+        if (sub_expression->type == ExpressionType::LQPSubquery) has_subquery = true;
+        return has_subquery ? ExpressionVisitation::DoNotVisitArguments : ExpressionVisitation::VisitArguments;
+      });
+      if (has_subquery) break;
+
+      predicates.emplace_back(_translate_expression(predicate, predicate_node->left_input()));
+    } else {
+      break;
+    }
+
+    current_node = current_node->left_input();
+  }
+
+  const auto stage_count = (validate ? 1 : 0) + predicates.size();
+  if (stage_count < 2) return nullptr;
+
+  // We collected the predicates top-down, but the lower predicates are the ones the optimizer wants to run first.
+  std::reverse(predicates.begin(), predicates.end());
+
+  return std::make_shared<PipelinedScan>(translate_node(current_node), validate, predicates);
+}
+
 std::shared_ptr<AbstractOperator> LQPTranslator::_translate_change_meta_table_node(
     const std::shared_ptr<AbstractLQPNode>& node) const {
   const auto input_operator_left = translate_node(node->left_input());
@@ -2,10 +2,12 @@
 
 #include <memory>
 #include <unordered_map>
+#include <vector>
 
 #include "abstract_lqp_node.hpp"
 #include "all_type_variant.hpp"
 #include "operators/abstract_operator.hpp"
+#include "types.hpp"
 
 namespace opossum {
 
@@ -20,9 +22,13 @@ struct OperatorJoinPredicate;
 /**
  * Translates an LQP (Logical Query Plan), represented by its root node, into an Operator tree for the execution
  * engine, which in return is represented by its root Operator.
+ *
+ * If pipelined execution is enabled, chains of ValidateNodes and PredicateNodes are translated into a single
+ * PipelinedScan instead of one operator per node (see _translate_to_pipelined_scan).
  */
 class LQPTranslator {
  public:
+  explicit LQPTranslator(const UsePipelinedExecution use_pipelined_execution = UsePipelinedExecution::No);
   virtual ~LQPTranslator() = default;
 
   virtual std::shared_ptr<AbstractOperator> translate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -37,6 +43,8 @@ class LQPTranslator {
       const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const;
   std::shared_ptr<TableScan> _translate_predicate_node_to_table_scan(
       const std::shared_ptr<PredicateNode>& node, const std::shared_ptr<AbstractOperator>& input_operator) const;
+  std::shared_ptr<AbstractOperator> _translate_predicate_node_to_key_index_lookup(
+      const std::shared_ptr<PredicateNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_alias_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_projection_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_sort_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -55,6 +63,9 @@ class LQPTranslator {
       const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_validate_node(const std::shared_ptr<AbstractLQPNode>& node) const;
 
+  // Returns nullptr if `node` is not the top of a chain of at least two ValidateNodes/PredicateNodes that can be fused.
+  std::shared_ptr<AbstractOperator> _translate_to_pipelined_scan(const std::shared_ptr<AbstractLQPNode>& node) const;
+
   // Maintenance operators
   std::shared_ptr<AbstractOperator> _translate_show_tables_node(const std::shared_ptr<AbstractLQPNode>& node) const;
   std::shared_ptr<AbstractOperator> _translate_show_columns_node(const std::shared_ptr<AbstractLQPNode>& node) const;
@@ -78,6 +89,8 @@ class LQPTranslator {
   //   - identical operators (operators below a diamond shape)
   //   - equal but not identical operators
   mutable LQPNodeUnorderedMap<std::shared_ptr<AbstractOperator>> _operator_by_lqp_node;
+
+  const UsePipelinedExecution _use_pipelined_execution;
 };
 
 }  // namespace opossum
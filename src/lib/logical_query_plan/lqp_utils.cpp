@@ -223,6 +223,15 @@ bool lqp_is_validated(const std::shared_ptr<AbstractLQPNode>& lqp) {
   return lqp_is_validated(lqp->left_input()) && lqp_is_validated(lqp->right_input());
 }
 
+bool lqp_has_placeholder_predicates(const std::shared_ptr<AbstractLQPNode>& lqp) {
+  for (const auto& subplan_root : lqp_find_subplan_roots(lqp)) {
+    for (const auto& node : lqp_find_nodes_by_type(subplan_root, LQPNodeType::Predicate)) {
+      if (expression_contains_placeholder(static_cast<const PredicateNode&>(*node).predicate())) return true;
+    }
+  }
+  return false;
+}
+
 std::set<std::string> lqp_find_modified_tables(const std::shared_ptr<AbstractLQPNode>& lqp) {
   std::set<std::string> modified_tables;
 
@@ -101,6 +101,11 @@ void lqp_insert_node(const std::shared_ptr<AbstractLQPNode>& parent_node, const
  */
 bool lqp_is_validated(const std::shared_ptr<AbstractLQPNode>& lqp);
 
+/**
+ * @return whether a predicate of the LQP or of one of its subqueries contains a PlaceholderExpression
+ */
+bool lqp_has_placeholder_predicates(const std::shared_ptr<AbstractLQPNode>& lqp);
+
 /**
  * @return all names of tables that have been accessed in modifying nodes (e.g., InsertNode, UpdateNode)
  */
@@ -37,7 +37,10 @@ std::shared_ptr<AbstractExpression> PredicateNode::predicate() const { return no
 size_t PredicateNode::_on_shallow_hash() const { return boost::hash_value(scan_type); }
 
 std::shared_ptr<AbstractLQPNode> PredicateNode::_on_shallow_copy(LQPNodeMapping& node_mapping) const {
-  return std::make_shared<PredicateNode>(expression_copy_and_adapt_to_different_lqp(*predicate(), node_mapping));
+  const auto copy =
+      std::make_shared<PredicateNode>(expression_copy_and_adapt_to_different_lqp(*predicate(), node_mapping));
+  copy->scan_type = scan_type;
+  return copy;
 }
 
 bool PredicateNode::_on_shallow_equals(const AbstractLQPNode& rhs, const LQPNodeMapping& node_mapping) const {
@@ -13,12 +13,14 @@ namespace opossum {
 
 class AbstractExpression;
 
-enum class ScanType : uint8_t { TableScan, IndexScan };
+enum class ScanType : uint8_t { TableScan, IndexScan, KeyIndexLookup };
 
 /**
  * This node type represents a filter.
  * The most common use case is to represent a regular TableScan,
- * but this node is also supposed to be used for IndexScans, for example.
+ * but this node is also supposed to be used for IndexScans, for example. With ScanType::KeyIndexLookup, the node
+ * directly follows a StoredTableNode and its predicate is a conjunction of equality predicates on the columns of a
+ * TableKeyIndex (see KeyIndexLookupRule). Both nodes are then translated into a single KeyIndexLookup operator.
  *
  * HAVING clauses of GROUP BY clauses will be translated to this node type as well.
  */
@@ -0,0 +1,96 @@
+#include "memory_budget_resource.hpp"
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MemoryBudgetResource::MemoryBudgetResource(const size_t budget, const std::filesystem::path& spill_directory,
+                                           boost::container::pmr::memory_resource* upstream)
+    : _budget(budget), _spill_directory(spill_directory), _upstream(upstream) {
+  Assert(_upstream, "MemoryBudgetResource requires an upstream memory resource");
+}
+
+size_t MemoryBudgetResource::budget() const { return _budget; }
+
+size_t MemoryBudgetResource::used_bytes() const { return _used_bytes.load(); }
+
+size_t MemoryBudgetResource::peak_bytes() const { return _peak_bytes.load(); }
+
+size_t MemoryBudgetResource::available_bytes() const {
+  const auto used_bytes = _used_bytes.load();
+  return used_bytes < _budget ? _budget - used_bytes : 0;
+}
+
+bool MemoryBudgetResource::try_reserve(const size_t bytes) {
+  auto used_bytes = _used_bytes.load();
+  do {
+    if (used_bytes + bytes > _budget) return false;
+  } while (!_used_bytes.compare_exchange_weak(used_bytes, used_bytes + bytes));
+
+  _update_peak(used_bytes + bytes);
+  return true;
+}
+
+void MemoryBudgetResource::reserve(const size_t bytes) { _update_peak(_used_bytes.fetch_add(bytes) + bytes); }
+
+void MemoryBudgetResource::release(const size_t bytes) {
+  DebugAssert(_used_bytes.load() >= bytes, "Released more memory than was used");
+  _used_bytes.fetch_sub(bytes);
+}
+
+const std::filesystem::path& MemoryBudgetResource::spill_directory() const { return _spill_directory; }
+
+size_t MemoryBudgetResource::spilled_bytes() const { return _spilled_bytes.load(); }
+
+void MemoryBudgetResource::add_spilled_bytes(const size_t bytes) { _spilled_bytes.fetch_add(bytes); }
+
+void* MemoryBudgetResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  auto* const pointer = _upstream->allocate(bytes, alignment);
+  reserve(bytes);
+  return pointer;
+}
+
+void MemoryBudgetResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+  _upstream->deallocate(pointer, bytes, alignment);
+  release(bytes);
+}
+
+bool MemoryBudgetResource::do_is_equal(const boost::container::pmr::memory_resource& other) const noexcept {
+  return &other == this;
+}
+
+MemoryReservation::MemoryReservation(const std::shared_ptr<MemoryBudgetResource>& resource) : _resource(resource) {}
+
+MemoryReservation::~MemoryReservation() { release(); }
+
+bool MemoryReservation::try_reserve(const size_t bytes) {
+  if (!_resource) return true;
+  if (!_resource->try_reserve(bytes)) return false;
+
+  _reserved_bytes += bytes;
+  return true;
+}
+
+void MemoryReservation::reserve(const size_t bytes) {
+  if (!_resource) return;
+
+  _resource->reserve(bytes);
+  _reserved_bytes += bytes;
+}
+
+void MemoryReservation::release() {
+  if (!_resource) return;
+
+  _resource->release(_reserved_bytes);
+  _reserved_bytes = 0;
+}
+
+size_t MemoryReservation::reserved_bytes() const { return _reserved_bytes; }
+
+void MemoryBudgetResource::_update_peak(const size_t used_bytes) {
+  auto peak_bytes = _peak_bytes.load();
+  while (used_bytes > peak_bytes && !_peak_bytes.compare_exchange_weak(peak_bytes, used_bytes)) {
+  }
+}
+
+}  // namespace opossum
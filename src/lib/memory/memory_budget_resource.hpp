@@ -0,0 +1,92 @@
+#pragma once
+
+#include <atomic>
+#include <filesystem>
+#include <memory>
+
+#include <boost/container/pmr/memory_resource.hpp>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Memory resource that tracks the memory used by the operators of a single query against a budget (see
+ * SQLPipelineBuilder::with_memory_budget). Allocations are forwarded to the upstream resource and counted. Operators
+ * whose data structures do not use polymorphic allocators reserve their estimated memory consumption instead (see
+ * MemoryReservation).
+ *
+ * The budget is not enforced on allocations, which would make the query fail in an arbitrary place. Instead, operators
+ * with large intermediate data structures (JoinHash and AggregateHash) check up front whether their estimated memory
+ * consumption fits into the budget. If it does not, they partition their input into temporary files in
+ * spill_directory() and process one partition at a time. Thus, a single large query degrades gracefully instead of
+ * exhausting the memory of the whole process.
+ *
+ * All members are thread-safe.
+ */
+class MemoryBudgetResource : public boost::container::pmr::memory_resource, private Noncopyable {
+ public:
+  explicit MemoryBudgetResource(
+      const size_t budget, const std::filesystem::path& spill_directory = std::filesystem::temp_directory_path(),
+      boost::container::pmr::memory_resource* upstream = boost::container::pmr::get_default_resource());
+
+  size_t budget() const;
+
+  // Bytes that are currently allocated through this resource or reserved.
+  size_t used_bytes() const;
+
+  // Highest value of used_bytes() so far.
+  size_t peak_bytes() const;
+
+  // Bytes that can still be reserved without exceeding the budget.
+  size_t available_bytes() const;
+
+  // Reserves the given number of bytes if they are available. Returns whether the reservation succeeded.
+  bool try_reserve(const size_t bytes);
+
+  // Reserves the given number of bytes even if this exceeds the budget. Used where the memory is needed in any case.
+  void reserve(const size_t bytes);
+
+  void release(const size_t bytes);
+
+  const std::filesystem::path& spill_directory() const;
+
+  // Number of bytes that operators have written to spill files.
+  size_t spilled_bytes() const;
+  void add_spilled_bytes(const size_t bytes);
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const boost::container::pmr::memory_resource& other) const noexcept override;
+
+  void _update_peak(const size_t used_bytes);
+
+  const size_t _budget;
+  const std::filesystem::path _spill_directory;
+  boost::container::pmr::memory_resource* const _upstream;
+
+  std::atomic<size_t> _used_bytes{0};
+  std::atomic<size_t> _peak_bytes{0};
+  std::atomic<size_t> _spilled_bytes{0};
+};
+
+// Reserves memory of a MemoryBudgetResource and releases it when it goes out of scope. Without a resource, all
+// reservations succeed.
+class MemoryReservation : private Noncopyable {
+ public:
+  explicit MemoryReservation(const std::shared_ptr<MemoryBudgetResource>& resource);
+  ~MemoryReservation();
+
+  bool try_reserve(const size_t bytes);
+  void reserve(const size_t bytes);
+  void release();
+
+  size_t reserved_bytes() const;
+
+ private:
+  const std::shared_ptr<MemoryBudgetResource> _resource;
+  size_t _reserved_bytes{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,62 @@
+#include "numa_memory_resource.hpp"
+
+#if HYRISE_NUMA_SUPPORT
+
+#include <numa.h>
+
+#endif
+
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+NumaMemoryResource::NumaMemoryResource(const NodeID node_id, const bool fake_numa)
+    : _node_id(node_id), _fake_numa(fake_numa) {
+#if HYRISE_NUMA_SUPPORT
+  _allocates_on_node = !fake_numa && numa_available() >= 0;
+#endif
+}
+
+NodeID NumaMemoryResource::node_id() const { return _node_id; }
+
+bool NumaMemoryResource::is_fake_numa() const { return _fake_numa; }
+
+bool NumaMemoryResource::allocates_on_node() const { return _allocates_on_node; }
+
+size_t NumaMemoryResource::allocated_bytes() const { return _allocated_bytes.load(); }
+
+void* NumaMemoryResource::do_allocate(std::size_t bytes, std::size_t alignment) {
+  _allocated_bytes += bytes;
+
+#if HYRISE_NUMA_SUPPORT
+  if (_allocates_on_node) {
+    // numa_alloc_onnode returns page-aligned memory, which satisfies every alignment that is used for segments.
+    auto* const pointer = numa_alloc_onnode(bytes, static_cast<int>(_node_id));
+    Assert(pointer, "Could not allocate memory on NUMA node " + std::to_string(_node_id));
+    return pointer;
+  }
+#endif
+
+  return boost::container::pmr::get_default_resource()->allocate(bytes, alignment);
+}
+
+void NumaMemoryResource::do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) {
+  _allocated_bytes -= bytes;
+
+#if HYRISE_NUMA_SUPPORT
+  if (_allocates_on_node) {
+    numa_free(pointer, bytes);
+    return;
+  }
+#endif
+
+  boost::container::pmr::get_default_resource()->deallocate(pointer, bytes, alignment);
+}
+
+bool NumaMemoryResource::do_is_equal(const boost::container::pmr::memory_resource& other) const noexcept {
+  return &other == this;
+}
+
+}  // namespace opossum
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <atomic>
+
+#include <boost/container/pmr/memory_resource.hpp>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Memory resource that allocates memory on a given NUMA node. Chunks are moved to a node by migrating them to the
+ * node's resource (see Topology::get_memory_resource and place_chunks_on_numa_nodes).
+ *
+ * With NUMA support, memory is allocated with numa_alloc_onnode, which works at page granularity. Thus, the resource
+ * is meant for large and long-lived allocations such as segments, not for intermediate results. Without NUMA support
+ * or for fake-NUMA topologies, allocations are forwarded to the default resource, so that placement and scheduling can
+ * still be tested and benchmarked. In all cases, the resource counts the bytes allocated on its node.
+ */
+class NumaMemoryResource : public boost::container::pmr::memory_resource, private Noncopyable {
+ public:
+  NumaMemoryResource(const NodeID node_id, const bool fake_numa);
+
+  NodeID node_id() const;
+
+  // Whether the resource was created for a fake-NUMA topology.
+  bool is_fake_numa() const;
+
+  // Whether the memory is actually allocated on the node. False for fake-NUMA nodes or if NUMA is not available.
+  bool allocates_on_node() const;
+
+  // Bytes that are currently allocated on this node.
+  size_t allocated_bytes() const;
+
+ protected:
+  void* do_allocate(std::size_t bytes, std::size_t alignment) override;
+  void do_deallocate(void* pointer, std::size_t bytes, std::size_t alignment) override;
+  bool do_is_equal(const boost::container::pmr::memory_resource& other) const noexcept override;
+
+  const NodeID _node_id;
+  const bool _fake_numa;
+  bool _allocates_on_node{false};
+  std::atomic<size_t> _allocated_bytes{0};
+};
+
+}  // namespace opossum
@@ -0,0 +1,72 @@
+#include "spill_file.hpp"
+
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+SpillFile::SpillFile(const std::filesystem::path& directory) {
+  // mkstemp replaces the trailing Xs with a unique suffix and creates the file.
+  const auto path_template = (directory / "hyrise_spill_XXXXXX").string();
+  auto path_buffer = std::vector<char>(path_template.begin(), path_template.end());
+  path_buffer.emplace_back('\0');
+
+  const auto file_descriptor = mkstemp(path_buffer.data());
+  Assert(file_descriptor != -1, "Could not create spill file in '" + directory.string() +
+                                    "': " + std::string{std::strerror(errno)});
+  close(file_descriptor);
+
+  _path = path_buffer.data();
+  _stream.open(_path, std::ios::in | std::ios::out | std::ios::binary | std::ios::trunc);
+  Assert(_stream.is_open(), "Could not open spill file '" + _path.string() + "'");
+}
+
+SpillFile::~SpillFile() {
+  _stream.close();
+  auto error_code = std::error_code{};
+  std::filesystem::remove(_path, error_code);
+}
+
+void SpillFile::write(const pmr_string& value) {
+  write(value.size());
+  _write_bytes(value.data(), value.size());
+}
+
+void SpillFile::start_reading() {
+  _stream.flush();
+  _stream.seekg(0);
+  _is_reading = true;
+}
+
+void SpillFile::read(pmr_string& value) {
+  auto size = size_t{0};
+  read(size);
+  value.resize(size);
+  _read_bytes(value.data(), size);
+}
+
+const std::filesystem::path& SpillFile::path() const { return _path; }
+
+size_t SpillFile::size() const { return _size; }
+
+void SpillFile::_write_bytes(const char* data, const size_t size) {
+  DebugAssert(!_is_reading, "Cannot write to a spill file that is being read");
+  _stream.write(data, static_cast<std::streamsize>(size));
+  Assert(_stream.good(), "Could not write to spill file '" + _path.string() + "'");
+  _size += size;
+}
+
+void SpillFile::_read_bytes(char* data, const size_t size) {
+  DebugAssert(_is_reading, "start_reading() has not been called");
+  _stream.read(data, static_cast<std::streamsize>(size));
+  Assert(_stream.good(), "Could not read from spill file '" + _path.string() + "'");
+}
+
+}  // namespace opossum
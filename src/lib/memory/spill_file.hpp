@@ -0,0 +1,60 @@
+#pragma once
+
+#include <filesystem>
+#include <fstream>
+#include <type_traits>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Temporary file to which operators spill intermediate data that does not fit into their memory budget (see
+ * MemoryBudgetResource). Values are first written sequentially and, after a call to start_reading(), read back in the
+ * same order. Only trivially copyable values and strings are supported, strings are stored with a length prefix. The
+ * file is deleted when the SpillFile is destroyed.
+ *
+ * A SpillFile must not be used by multiple threads concurrently.
+ */
+class SpillFile : private Noncopyable {
+ public:
+  // Creates a new file with a unique name in the given directory.
+  explicit SpillFile(const std::filesystem::path& directory);
+
+  ~SpillFile();
+
+  template <typename T>
+  void write(const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be spilled");
+    _write_bytes(reinterpret_cast<const char*>(&value), sizeof(T));
+  }
+
+  void write(const pmr_string& value);
+
+  // Switches from writing to reading, starting with the first value that was written.
+  void start_reading();
+
+  template <typename T>
+  void read(T& value) {
+    static_assert(std::is_trivially_copyable_v<T>, "Only trivially copyable values can be spilled");
+    _read_bytes(reinterpret_cast<char*>(&value), sizeof(T));
+  }
+
+  void read(pmr_string& value);
+
+  const std::filesystem::path& path() const;
+
+  // Number of bytes written to the file
+  size_t size() const;
+
+ protected:
+  void _write_bytes(const char* data, const size_t size);
+  void _read_bytes(char* data, const size_t size);
+
+  std::filesystem::path _path;
+  std::fstream _stream;
+  size_t _size{0};
+  bool _is_reading{false};
+};
+
+}  // namespace opossum
@@ -9,6 +9,7 @@
 #include "concurrency/transaction_context.hpp"
 #include "logical_query_plan/abstract_non_query_node.hpp"
 #include "logical_query_plan/dummy_table_node.hpp"
+#include "memory/memory_budget_resource.hpp"
 #include "resolve_type.hpp"
 #include "storage/table.hpp"
 #include "storage/value_segment.hpp"
@@ -203,6 +204,9 @@ std::shared_ptr<AbstractOperator> AbstractOperator::deep_copy(
    */
   if (_transaction_context) copied_op->set_transaction_context(*_transaction_context);
 
+  // Likewise, copied subquery plans allocate from the budget of the query.
+  if (_memory_budget_resource) copied_op->set_memory_budget_resource(_memory_budget_resource);
+
   copied_ops.emplace(this, copied_op);
 
   return copied_op;
@@ -245,6 +249,23 @@ void AbstractOperator::set_transaction_context_recursively(
   if (_right_input) mutable_right_input()->set_transaction_context_recursively(transaction_context);
 }
 
+const std::shared_ptr<MemoryBudgetResource>& AbstractOperator::memory_budget_resource() const {
+  return _memory_budget_resource;
+}
+
+void AbstractOperator::set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {
+  _memory_budget_resource = memory_budget_resource;
+  _on_set_memory_budget_resource(memory_budget_resource);
+}
+
+void AbstractOperator::set_memory_budget_resource_recursively(
+    const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {
+  set_memory_budget_resource(memory_budget_resource);
+
+  if (_left_input) mutable_left_input()->set_memory_budget_resource_recursively(memory_budget_resource);
+  if (_right_input) mutable_right_input()->set_memory_budget_resource_recursively(memory_budget_resource);
+}
+
 std::shared_ptr<AbstractOperator> AbstractOperator::mutable_left_input() const {
   return std::const_pointer_cast<AbstractOperator>(_left_input);
 }
@@ -267,6 +288,9 @@ void AbstractOperator::set_parameters(const std::unordered_map<ParameterID, AllT
 
 void AbstractOperator::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {}
 
+void AbstractOperator::_on_set_memory_budget_resource(
+    const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {}
+
 void AbstractOperator::_on_cleanup() {}
 
 std::ostream& operator<<(std::ostream& stream, const AbstractOperator& abstract_operator) {
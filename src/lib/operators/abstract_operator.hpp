@@ -13,6 +13,7 @@
 
 namespace opossum {
 
+class MemoryBudgetResource;
 class OperatorTask;
 class Table;
 class TransactionContext;
@@ -38,7 +39,9 @@ enum class OperatorType {
   JoinNestedLoop,
   JoinSortMerge,
   JoinVerification,
+  KeyIndexLookup,
   Limit,
+  PipelinedScan,
   Print,
   Product,
   Projection,
@@ -138,6 +141,15 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   // Calls set_transaction_context on itself and both input operators recursively
   void set_transaction_context_recursively(const std::weak_ptr<TransactionContext>& transaction_context);
 
+  // Memory budget of the query that this operator belongs to. Might be nullptr, in which case operators allocate
+  // freely. See MemoryBudgetResource for how operators use the budget.
+  const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource() const;
+  void set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource);
+
+  // Calls set_memory_budget_resource on itself and both input operators recursively. Operators with subqueries pass
+  // the budget on to the subquery plans (see _on_set_memory_budget_resource).
+  void set_memory_budget_resource_recursively(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource);
+
   /**
    * Recursively copies the input operators and
    * @returns a new instance of the same operator with the same configuration. Deduplication of operator plans will be
@@ -204,6 +216,9 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   // override this if the Operator uses Expressions and set the transaction context in the SubqueryExpressions
   virtual void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context);
 
+  // override this if the Operator uses Expressions and set the memory budget resource in the SubqueryExpressions
+  virtual void _on_set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource);
+
   // An operator needs to implement this function in order to be cacheable.
   virtual std::shared_ptr<AbstractOperator> _on_deep_copy(
       const std::shared_ptr<AbstractOperator>& copied_left_input,
@@ -225,6 +240,8 @@ class AbstractOperator : public std::enable_shared_from_this<AbstractOperator>,
   // Weak pointer breaks cyclical dependency between operators and context
   std::optional<std::weak_ptr<TransactionContext>> _transaction_context;
 
+  std::shared_ptr<MemoryBudgetResource> _memory_budget_resource;
+
   // We track the number of consuming operators to automate the clearing of operator results.
   std::atomic<int> _consumer_count = 0;
 
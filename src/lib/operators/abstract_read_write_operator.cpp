@@ -1,8 +1,11 @@
 #include "abstract_read_write_operator.hpp"
 
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
+#include "storage/mvcc_data.hpp"
+
 namespace opossum {
 
 AbstractReadWriteOperator::AbstractReadWriteOperator(const OperatorType type,
@@ -51,6 +54,12 @@ void AbstractReadWriteOperator::rollback_records() {
   _state = ReadWriteOperatorState::RolledBack;
 }
 
+void AbstractReadWriteOperator::log_records(WalCommitRecordWriter& record_writer) const {
+  Assert(_state == ReadWriteOperatorState::Committed, "Operator needs to have state Committed in order to be logged.");
+
+  _on_log_records(record_writer);
+}
+
 bool AbstractReadWriteOperator::execute_failed() const {
   return _state == ReadWriteOperatorState::Conflicted || _state == ReadWriteOperatorState::RolledBack;
 }
@@ -63,6 +72,16 @@ void AbstractReadWriteOperator::_mark_as_failed() {
   _state = ReadWriteOperatorState::Conflicted;
 }
 
+std::unordered_map<const MvccData*, ChunkID> AbstractReadWriteOperator::_chunk_ids_by_mvcc_data(const Table& table) {
+  auto chunk_ids = std::unordered_map<const MvccData*, ChunkID>{};
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table.get_chunk(chunk_id);
+    if (chunk && chunk->has_mvcc_data()) chunk_ids.emplace(chunk->mvcc_data().get(), chunk_id);
+  }
+  return chunk_ids;
+}
+
 std::ostream& operator<<(std::ostream& stream, const ReadWriteOperatorState& phase) {
   switch (phase) {
     case ReadWriteOperatorState::Pending:
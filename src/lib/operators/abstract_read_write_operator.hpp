@@ -2,6 +2,7 @@
 
 #include <cstdint>
 #include <memory>
+#include <unordered_map>
 #include <vector>
 
 #include "abstract_operator.hpp"
@@ -13,6 +14,9 @@
 
 namespace opossum {
 
+class MvccData;
+class WalCommitRecordWriter;
+
 enum class ReadWriteOperatorState {
   Pending,     // The operator has been instantiated.
   Executed,    // Execution succeeded.
@@ -48,6 +52,12 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   void rollback_records();
 
+  /**
+   * Adds the committed modifications to the transaction's write-ahead log record. Only called if write-ahead logging
+   * is enabled (see WriteAheadLog).
+   */
+  void log_records(WalCommitRecordWriter& record_writer) const;
+
   /**
    * Returns true if a previous call to _on_execute produced an error.
    */
@@ -80,6 +90,12 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   virtual void _on_rollback_records() = 0;
 
+  /**
+   * Called by log_records. Operators that delegate their modifications to other read/write operators, which are
+   * registered with the transaction themselves (e.g., Update), do not need to log anything.
+   */
+  virtual void _on_log_records(WalCommitRecordWriter& record_writer) const {}
+
   /**
    * This method is used in sub classes in their _on_execute() method.
    *
@@ -88,6 +104,13 @@ class AbstractReadWriteOperator : public AbstractOperator {
    */
   void _mark_as_failed();
 
+  /**
+   * The input tables of read/write operators may reference copies of the stored chunks, e.g., if GetTable pruned
+   * chunks or columns. Thus, the ChunkIDs of the referenced rows may differ from the ones in the stored table. The
+   * copies share the MVCC data with the stored chunks, which is used to find the ChunkID of a row in the stored table.
+   */
+  static std::unordered_map<const MvccData*, ChunkID> _chunk_ids_by_mvcc_data(const Table& table);
+
  private:
   ReadWriteOperatorState _state;
 };
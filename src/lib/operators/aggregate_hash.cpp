@@ -1,7 +1,9 @@
 #include "aggregate_hash.hpp"
 
+#include <algorithm>
 #include <cmath>
 #include <memory>
+#include <numeric>
 #include <optional>
 #include <string>
 #include <unordered_map>
@@ -12,6 +14,8 @@
 #include "constant_mappings.hpp"
 #include "expression/pqp_column_expression.hpp"
 #include "hyrise.hpp"
+#include "memory/memory_budget_resource.hpp"
+#include "memory/spill_file.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
@@ -19,6 +23,7 @@
 #include "storage/segment_iterate.hpp"
 #include "utils/aligned_size.hpp"
 #include "utils/assert.hpp"
+#include "utils/format_bytes.hpp"
 #include "utils/performance_warning.hpp"
 #include "utils/timer.hpp"
 
@@ -137,6 +142,157 @@ AggregateKey& get_aggregate_key([[maybe_unused]] KeysPerChunk<AggregateKey>& key
   }
 }
 
+// The following structures are used by AggregateHash::_aggregate_partitioned. A PartitionedGroup is a group that was
+// pre-aggregated by a thread and is identified by its index in the thread-local results. A PartitionedRow is an input
+// row that was passed through without pre-aggregation. For both, partition_result_id is the index of the group within
+// the radix partition, which is assigned when the partitions are merged.
+template <typename AggregateKey>
+struct PartitionedGroup {
+  AggregateKey key;
+  AggregateResultId local_result_id;
+  AggregateResultId partition_result_id;
+};
+
+template <typename AggregateKey>
+struct PartitionedRow {
+  AggregateKey key;
+  RowID row_id;
+  AggregateResultId partition_result_id;
+};
+
+template <typename AggregateKey>
+struct LocalAggregation {
+  std::vector<std::shared_ptr<SegmentVisitorContext>> contexts;
+  std::vector<std::vector<PartitionedGroup<AggregateKey>>> groups_per_partition;
+  std::vector<std::vector<PartitionedRow<AggregateKey>>> rows_per_partition;
+};
+
+// Combines a pre-aggregated result into the result of the same group. This is the counterpart to the aggregate
+// functions of the AggregateFunctionBuilder for partial aggregates instead of single values.
+template <typename ColumnDataType, AggregateFunction aggregate_function>
+void merge_aggregate_result(AggregateResult<ColumnDataType, aggregate_function>& target,
+                            const AggregateResult<ColumnDataType, aggregate_function>& source) {
+  if (target.row_id.is_null()) {
+    target.row_id = source.row_id;
+  }
+
+  if (source.aggregate_count == 0) return;
+
+  if constexpr (aggregate_function == AggregateFunction::Min) {
+    if (target.aggregate_count == 0 || value_smaller(source.accumulator, target.accumulator)) {
+      target.accumulator = source.accumulator;
+    }
+  } else if constexpr (aggregate_function == AggregateFunction::Max) {
+    if (target.aggregate_count == 0 || value_greater(source.accumulator, target.accumulator)) {
+      target.accumulator = source.accumulator;
+    }
+  } else if constexpr (aggregate_function == AggregateFunction::Sum || aggregate_function == AggregateFunction::Avg) {
+    target.accumulator += source.accumulator;
+  } else if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+    target.accumulator.insert(source.accumulator.begin(), source.accumulator.end());
+  } else if constexpr (aggregate_function == AggregateFunction::StandardDeviationSample) {
+    // Combine the partial results of Welford's algorithm (see AggregateFunctionBuilder) using Chan et al.'s method
+    // https://en.wikipedia.org/wiki/Algorithms_for_calculating_variance#Parallel_algorithm
+    if (target.aggregate_count == 0) {
+      target.accumulator = source.accumulator;
+    } else {
+      auto& [count, mean, squared_distance_from_mean, result] = target.accumulator;
+      const auto source_count = source.accumulator[0];
+      const auto source_mean = source.accumulator[1];
+      const auto source_squared_distance_from_mean = source.accumulator[2];
+
+      const auto combined_count = count + source_count;
+      const auto delta = source_mean - mean;
+      mean += delta * source_count / combined_count;
+      squared_distance_from_mean +=
+          source_squared_distance_from_mean + delta * delta * count * source_count / combined_count;
+      count = combined_count;
+
+      if (count > 1) {
+        result = std::sqrt(squared_distance_from_mean / (count - 1));
+      }
+    }
+  }
+
+  target.aggregate_count += source.aggregate_count;
+}
+
+// Aggregates rows that were passed through without pre-aggregation. Their values are accessed by their RowID. If
+// input_column_id is INVALID_COLUMN_ID (i.e., for COUNT(*) and the DISTINCT implementation), rows are only counted.
+template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
+void aggregate_passed_through_rows(AggregateResults<ColumnDataType, aggregate_function>& results,
+                                   const AggregateResultId partition_offset,
+                                   const std::vector<PartitionedRow<AggregateKey>>& rows, const Table& input_table,
+                                   const ColumnID input_column_id) {
+  if (input_column_id == INVALID_COLUMN_ID) {
+    for (const auto& row : rows) {
+      auto& result = results[partition_offset + row.partition_result_id];
+      if (result.row_id.is_null()) {
+        result.row_id = row.row_id;
+      }
+      ++result.aggregate_count;
+    }
+    return;
+  }
+
+  using AggregateType = typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType;
+  auto aggregator =
+      AggregateFunctionBuilder<ColumnDataType, AggregateType, aggregate_function>().get_aggregate_function();
+
+  auto accessors = std::vector<std::unique_ptr<AbstractSegmentAccessor<ColumnDataType>>>(input_table.chunk_count());
+  for (const auto& row : rows) {
+    auto& result = results[partition_offset + row.partition_result_id];
+    if (result.row_id.is_null()) {
+      result.row_id = row.row_id;
+    }
+
+    auto& accessor = accessors[row.row_id.chunk_id];
+    if (!accessor) {
+      const auto& segment = input_table.get_chunk(row.row_id.chunk_id)->get_segment(input_column_id);
+      accessor = create_segment_accessor<ColumnDataType>(segment);
+    }
+
+    // As in _aggregate_segment, NULL values do not change the aggregate.
+    const auto optional_value = accessor->access(row.row_id.chunk_offset);
+    if (!optional_value) continue;
+
+    if constexpr (aggregate_function == AggregateFunction::CountDistinct) {
+      result.accumulator.emplace(*optional_value);
+    } else {
+      aggregator(ColumnDataType{*optional_value}, result.aggregate_count, result.accumulator);
+    }
+
+    ++result.aggregate_count;
+  }
+}
+
+// Used by AggregateHash::_aggregate_spilling. AggregateKeySmallVectors are stored with their size as a prefix.
+template <typename AggregateKey>
+void write_aggregate_key(SpillFile& file, const AggregateKey& key) {
+  if constexpr (std::is_same_v<AggregateKey, AggregateKeySmallVector>) {
+    file.write(key.size());
+    for (const auto entry : key) {
+      file.write(entry);
+    }
+  } else {
+    file.write(key);
+  }
+}
+
+template <typename AggregateKey>
+void read_aggregate_key(SpillFile& file, AggregateKey& key) {
+  if constexpr (std::is_same_v<AggregateKey, AggregateKeySmallVector>) {
+    auto size = size_t{0};
+    file.read(size);
+    key.resize(size);
+    for (auto& entry : key) {
+      file.read(entry);
+    }
+  } else {
+    file.read(key);
+  }
+}
+
 }  // namespace
 
 namespace opossum {
@@ -145,7 +301,7 @@ AggregateHash::AggregateHash(const std::shared_ptr<AbstractOperator>& in,
                              const std::vector<std::shared_ptr<AggregateExpression>>& aggregates,
                              const std::vector<ColumnID>& groupby_column_ids)
     : AbstractAggregateOperator(in, aggregates, groupby_column_ids,
-                                std::make_unique<OperatorPerformanceData<OperatorSteps>>()) {
+                                std::make_unique<PerformanceData>()) {
   _has_aggregate_functions =
       !_aggregates.empty() && !std::all_of(_aggregates.begin(), _aggregates.end(), [](const auto aggregate_expression) {
         return aggregate_expression->aggregate_function == AggregateFunction::Any;
@@ -177,9 +333,11 @@ struct AggregateResultContext : SegmentVisitorContext {
   using AggregateResultAllocator = PolymorphicAllocator<AggregateResults<ColumnDataType, aggregate_function>>;
 
   // In cases where we know how many values to expect, we can preallocate the context in order to avoid later
-  // re-allocations.
-  explicit AggregateResultContext(const size_t preallocated_size = 0)
-      : results(preallocated_size, AggregateResultAllocator{&buffer}) {}
+  // re-allocations. The buffer allocates its memory from the given upstream resource.
+  explicit AggregateResultContext(
+      const size_t preallocated_size = 0,
+      boost::container::pmr::memory_resource* upstream = boost::container::pmr::get_default_resource())
+      : buffer(upstream), results(preallocated_size, AggregateResultAllocator{&buffer}) {}
 
   boost::container::pmr::monotonic_buffer_resource buffer;
   AggregateResults<ColumnDataType, aggregate_function> results;
@@ -187,8 +345,10 @@ struct AggregateResultContext : SegmentVisitorContext {
 
 template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
 struct AggregateContext : public AggregateResultContext<ColumnDataType, aggregate_function> {
-  explicit AggregateContext(const size_t preallocated_size = 0)
-      : AggregateResultContext<ColumnDataType, aggregate_function>(preallocated_size) {
+  explicit AggregateContext(
+      const size_t preallocated_size = 0,
+      boost::container::pmr::memory_resource* upstream = boost::container::pmr::get_default_resource())
+      : AggregateResultContext<ColumnDataType, aggregate_function>(preallocated_size, upstream) {
     auto allocator = AggregateResultIdMapAllocator<AggregateKey>{&this->buffer};
 
     // Unused if AggregateKey == EmptyAggregateKey, but we initialize it anyway to reduce the number of diverging code
@@ -201,16 +361,16 @@ struct AggregateContext : public AggregateResultContext<ColumnDataType, aggregat
 };
 
 template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
-__attribute__((hot)) void AggregateHash::_aggregate_segment(ChunkID chunk_id, ColumnID column_index,
-                                                            const AbstractSegment& abstract_segment,
-                                                            KeysPerChunk<AggregateKey>& keys_per_chunk) {
+__attribute__((hot)) void AggregateHash::_aggregate_segment(
+    ChunkID chunk_id, ColumnID column_index, const AbstractSegment& abstract_segment,
+    std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts, KeysPerChunk<AggregateKey>& keys_per_chunk) {
   using AggregateType = typename AggregateTraits<ColumnDataType, aggregate_function>::AggregateType;
 
   auto aggregator =
       AggregateFunctionBuilder<ColumnDataType, AggregateType, aggregate_function>().get_aggregate_function();
 
   auto& context = *std::static_pointer_cast<AggregateContext<ColumnDataType, aggregate_function, AggregateKey>>(
-      _contexts_per_column[column_index]);
+      contexts[column_index]);
 
   auto& result_ids = *context.result_ids;
   auto& results = context.results;
@@ -243,7 +403,7 @@ __attribute__((hot)) void AggregateHash::_aggregate_segment(ChunkID chunk_id, Co
   // (and thus more than one context), it makes sense to cache the results indexes, see get_or_add_result for details.
   // Furthermore, if we use the immediate key shortcut (which uses the same code path as caching), we need to pass
   // true_type so that the aggregate keys are checked for immediate access values.
-  if (_contexts_per_column.size() > 1 || _use_immediate_key_shortcut) {
+  if (contexts.size() > 1 || _use_immediate_key_shortcut) {
     segment_iterate<ColumnDataType>(abstract_segment,
                                     [&](const auto& position) { process_position(std::true_type{}, position); });
   } else {
@@ -563,19 +723,26 @@ void AggregateHash::_aggregate() {
   /**
    * AGGREGATION STEP
    */
-  _contexts_per_column = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
-
-  if (!_has_aggregate_functions) {
-    /*
-    Insert a dummy context for the DISTINCT implementation.
-    That way, _contexts_per_column will always have at least one context with results.
-    This is important later on when we write the group keys into the table.
-    The template parameters (int32_t, AggregateFunction::Min) do not matter, as we do not calculate an aggregate anyway.
-    */
-    auto context =
-        std::make_shared<AggregateContext<int32_t, AggregateFunction::Min, AggregateKey>>(_expected_result_size);
+  if constexpr (!std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+    // If the query has a memory budget and the results and hash maps might not fit into it, the input is spilled to
+    // disk and aggregated partition by partition.
+    if (!_use_immediate_key_shortcut && memory_budget_resource()) {
+      const auto estimated_memory_consumption = _estimate_memory_consumption<AggregateKey>();
+      if (estimated_memory_consumption > memory_budget_resource()->available_bytes()) {
+        _aggregate_spilling<AggregateKey>(keys_per_chunk, estimated_memory_consumption);
+        step_performance_data.set_step_runtime(OperatorSteps::Aggregating, timer.lap());
+        return;
+      }
+    }
 
-    _contexts_per_column.push_back(context);
+    // Inputs without GROUP BY columns and inputs for which the immediate key shortcut can be used are cheap to
+    // aggregate sequentially. In both cases, there is only a small and preallocated list of results.
+    if (!_use_immediate_key_shortcut && input_table->chunk_count() > 1 &&
+        input_table->row_count() >= PARALLEL_AGGREGATION_MIN_ROW_COUNT) {
+      _aggregate_partitioned<AggregateKey>(keys_per_chunk);
+      step_performance_data.set_step_runtime(OperatorSteps::Aggregating, timer.lap());
+      return;
+    }
   }
 
   /**
@@ -583,25 +750,7 @@ void AggregateHash::_aggregate() {
    * created on. We do this here, and not in the per-chunk-loop below, because there might be no Chunks in the input
    * and _write_aggregate_output() needs these contexts anyway.
    */
-  for (ColumnID aggregate_idx{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
-    const auto& aggregate = _aggregates[aggregate_idx];
-
-    const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
-    const auto input_column_id = pqp_column.column_id;
-
-    if (input_column_id == INVALID_COLUMN_ID) {
-      Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
-      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
-      auto context = std::make_shared<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
-          _expected_result_size);
-
-      _contexts_per_column[aggregate_idx] = context;
-      continue;
-    }
-    const auto data_type = input_table->column_data_type(input_column_id);
-    _contexts_per_column[aggregate_idx] =
-        _create_aggregate_context<AggregateKey>(data_type, aggregate->aggregate_function);
-  }
+  _contexts_per_column = _create_aggregate_contexts<AggregateKey>(_expected_result_size.load());
 
   // Process Chunks and perform aggregations
   const auto chunk_count = input_table->chunk_count();
@@ -609,159 +758,493 @@ void AggregateHash::_aggregate() {
     const auto chunk_in = input_table->get_chunk(chunk_id);
     if (!chunk_in) continue;
 
-    // Sometimes, gcc is really bad at accessing loop conditions only once, so we cache that here.
-    const auto input_chunk_size = chunk_in->size();
+    _aggregate_chunk<AggregateKey>(chunk_id, _contexts_per_column, keys_per_chunk);
+  }
+  step_performance_data.set_step_runtime(OperatorSteps::Aggregating, timer.lap());
+}
 
-    if (!_has_aggregate_functions) {
-      /**
-       * DISTINCT implementation
-       *
-       * In Opossum we handle the SQL keyword DISTINCT by using an aggregate operator with grouping but without 
-       * aggregate functions. All input columns (either explicitly specified as `SELECT DISTINCT a, b, c` OR implicitly
-       * as `SELECT DISTINCT *` are passed as `groupby_column_ids`).
-       *
-       * As the grouping happens as part of the aggregation but no aggregate function exists, we use
-       * `AggregateFunction::Min` as a fake aggregate function whose result will be discarded. From here on, the steps
-       * are the same as they are for a regular grouped aggregate.
-       */
+template <typename AggregateKey>
+void AggregateHash::_aggregate_chunk(const ChunkID chunk_id,
+                                     std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts,
+                                     KeysPerChunk<AggregateKey>& keys_per_chunk) {
+  const auto& input_table = left_input_table();
+  const auto chunk_in = input_table->get_chunk(chunk_id);
 
-      auto context =
-          std::static_pointer_cast<AggregateContext<DistinctColumnType, AggregateFunction::Min, AggregateKey>>(
-              _contexts_per_column[0]);
-
-      auto& result_ids = *context->result_ids;
-      auto& results = context->results;
-
-      // Add value or combination of values is added to the list of distinct value(s). This is done by calling
-      // get_or_add_result, which adds the corresponding entry in the list of GROUP BY values.
-      if (_use_immediate_key_shortcut) {
-        for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-          // We are able to use immediate keys, so pass true_type so that the combined caching/immediate key code path
-          // is enabled in get_or_add_result.
-          get_or_add_result(std::true_type{}, result_ids, results,
-                            get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                            RowID{chunk_id, chunk_offset});
-        }
-      } else {
-        // Same as above, but we do not have immediate keys, so we disable that code path to reduce the complexity of
-        // get_aggregate_key.
-        for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-          get_or_add_result(std::false_type{}, result_ids, results,
-                            get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                            RowID{chunk_id, chunk_offset});
-        }
+  // Sometimes, gcc is really bad at accessing loop conditions only once, so we cache that here.
+  const auto input_chunk_size = chunk_in->size();
+
+  if (!_has_aggregate_functions) {
+    /**
+     * DISTINCT implementation
+     *
+     * In Opossum we handle the SQL keyword DISTINCT by using an aggregate operator with grouping but without 
+     * aggregate functions. All input columns (either explicitly specified as `SELECT DISTINCT a, b, c` OR implicitly
+     * as `SELECT DISTINCT *` are passed as `groupby_column_ids`).
+     *
+     * As the grouping happens as part of the aggregation but no aggregate function exists, we use
+     * `AggregateFunction::Min` as a fake aggregate function whose result will be discarded. From here on, the steps
+     * are the same as they are for a regular grouped aggregate.
+     */
+
+    auto context =
+        std::static_pointer_cast<AggregateContext<DistinctColumnType, AggregateFunction::Min, AggregateKey>>(
+            contexts[0]);
+
+    auto& result_ids = *context->result_ids;
+    auto& results = context->results;
+
+    // Add value or combination of values is added to the list of distinct value(s). This is done by calling
+    // get_or_add_result, which adds the corresponding entry in the list of GROUP BY values.
+    if (_use_immediate_key_shortcut) {
+      for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+        // We are able to use immediate keys, so pass true_type so that the combined caching/immediate key code path
+        // is enabled in get_or_add_result.
+        get_or_add_result(std::true_type{}, result_ids, results,
+                          get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                          RowID{chunk_id, chunk_offset});
       }
     } else {
-      ColumnID aggregate_idx{0};
-      for (const auto& aggregate : _aggregates) {
-        /**
-         * Special COUNT(*) implementation.
-         * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
-         * We then go through the keys_per_chunk map and count the occurrences of each group key.
-         * The results are saved in the regular aggregate_count variable so that we don't need a
-         * specific output logic for COUNT(*).
-         */
+      // Same as above, but we do not have immediate keys, so we disable that code path to reduce the complexity of
+      // get_aggregate_key.
+      for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+        get_or_add_result(std::false_type{}, result_ids, results,
+                          get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                          RowID{chunk_id, chunk_offset});
+      }
+    }
+  } else {
+    ColumnID aggregate_idx{0};
+    for (const auto& aggregate : _aggregates) {
+      /**
+       * Special COUNT(*) implementation.
+       * Because COUNT(*) does not have a specific target column, we use the maximum ColumnID.
+       * We then go through the keys_per_chunk map and count the occurrences of each group key.
+       * The results are saved in the regular aggregate_count variable so that we don't need a
+       * specific output logic for COUNT(*).
+       */
 
-        const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
-        const auto input_column_id = pqp_column.column_id;
+      const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
+      const auto input_column_id = pqp_column.column_id;
 
-        if (input_column_id == INVALID_COLUMN_ID) {
-          Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
-          auto context =
-              std::static_pointer_cast<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
-                  _contexts_per_column[aggregate_idx]);
+      if (input_column_id == INVALID_COLUMN_ID) {
+        Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
+        auto context =
+            std::static_pointer_cast<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
+                contexts[aggregate_idx]);
 
-          auto& result_ids = *context->result_ids;
-          auto& results = context->results;
+        auto& result_ids = *context->result_ids;
+        auto& results = context->results;
 
-          if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
-            // Not grouped by anything, simply count the number of rows
-            results.resize(1);
-            results[0].aggregate_count += input_chunk_size;
+        if constexpr (std::is_same_v<AggregateKey, EmptyAggregateKey>) {
+          // Not grouped by anything, simply count the number of rows
+          results.resize(1);
+          results[0].aggregate_count += input_chunk_size;
 
-            // We need to set any RowID because the default value (NULL_ROW_ID) would later be skipped. As we are not
-            // reconstructing the GROUP BY values later, the exact value of this row_id does not matter, as long as it
-            // not NULL_ROW_ID.
-            results[0].row_id = RowID{ChunkID{0}, ChunkOffset{0}};
+          // We need to set any RowID because the default value (NULL_ROW_ID) would later be skipped. As we are not
+          // reconstructing the GROUP BY values later, the exact value of this row_id does not matter, as long as it
+          // not NULL_ROW_ID.
+          results[0].row_id = RowID{ChunkID{0}, ChunkOffset{0}};
+        } else {
+          // Count occurrences for each group key -  If we have more than one aggregate function (and thus more than
+          // one context), it makes sense to cache the results indexes, see get_or_add_result for details.
+          if (contexts.size() > 1 || _use_immediate_key_shortcut) {
+            for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+              // Use CacheResultIds==true_type if we have more than one group by column or if the cached result ids
+              // have been written by the immediate key shortcut
+              auto& result =
+                  get_or_add_result(std::true_type{}, result_ids, results,
+                                    get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                                    RowID{chunk_id, chunk_offset});
+              ++result.aggregate_count;
+            }
           } else {
-            // Count occurrences for each group key -  If we have more than one aggregate function (and thus more than
-            // one context), it makes sense to cache the results indexes, see get_or_add_result for details.
-            if (_contexts_per_column.size() > 1 || _use_immediate_key_shortcut) {
-              for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-                // Use CacheResultIds==true_type if we have more than one group by column or if the cached result ids
-                // have been written by the immediate key shortcut
-                auto& result =
-                    get_or_add_result(std::true_type{}, result_ids, results,
-                                      get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                                      RowID{chunk_id, chunk_offset});
-                ++result.aggregate_count;
-              }
-            } else {
-              for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
-                auto& result =
-                    get_or_add_result(std::false_type{}, result_ids, results,
-                                      get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
-                                      RowID{chunk_id, chunk_offset});
-                ++result.aggregate_count;
-              }
+            for (ChunkOffset chunk_offset{0}; chunk_offset < input_chunk_size; chunk_offset++) {
+              auto& result =
+                  get_or_add_result(std::false_type{}, result_ids, results,
+                                    get_aggregate_key<AggregateKey>(keys_per_chunk, chunk_id, chunk_offset),
+                                    RowID{chunk_id, chunk_offset});
+              ++result.aggregate_count;
             }
           }
+        }
+
+        ++aggregate_idx;
+        continue;
+      }
+
+      const auto abstract_segment = chunk_in->get_segment(input_column_id);
+      const auto data_type = input_table->column_data_type(input_column_id);
+
+      /*
+      Invoke correct aggregator for each segment
+      */
+
+      resolve_data_type(data_type, [&, aggregate](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+
+        switch (aggregate->aggregate_function) {
+          case AggregateFunction::Min:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, contexts, keys_per_chunk);
+            break;
+          case AggregateFunction::Max:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, contexts, keys_per_chunk);
+            break;
+          case AggregateFunction::Sum:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, contexts, keys_per_chunk);
+            break;
+          case AggregateFunction::Avg:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, contexts, keys_per_chunk);
+            break;
+          case AggregateFunction::Count:
+            _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, contexts, keys_per_chunk);
+            break;
+          case AggregateFunction::CountDistinct:
+            _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, contexts, keys_per_chunk);
+            break;
+          case AggregateFunction::StandardDeviationSample:
+            _aggregate_segment<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>(
+                chunk_id, aggregate_idx, *abstract_segment, contexts, keys_per_chunk);
+            break;
+          case AggregateFunction::Any:
+            // ANY is a pseudo-function and is handled by _write_groupby_output
+            break;
+        }
+      });
+
+      ++aggregate_idx;
+    }
+  }
+}  // NOLINT(readability/fn_size)
+
+/**
+ * Parallel aggregation for large inputs. It is used instead of the sequential aggregation into _contexts_per_column,
+ * which does not scale with the number of threads, and works in three phases:
+ *
+ * (1) The input chunks are split into ranges, one per task. Each task pre-aggregates its chunks into thread-local
+ *     contexts, using the same code path as the sequential aggregation. Afterwards, it radix-partitions the local
+ *     groups by the hash of their AggregateKey. If the pre-aggregation does not reduce the number of rows (e.g., when
+ *     grouping by a unique column), the task stops pre-aggregating and passes the remaining rows through to the
+ *     partitions instead.
+ * (2) For each radix partition, one task assigns an index within the partition to every group and passed-through
+ *     row. Each AggregateKey ends up in exactly one partition, so these indexes are final.
+ * (3) With the number of groups per partition known, the results in _contexts_per_column are allocated and each
+ *     partition is merged into its own, disjoint range of results by one task.
+ *
+ * As the AggregateKeys are calculated globally by _partition_by_groupby_keys, equal groups have equal keys across
+ * all tasks. The results in _contexts_per_column are the same as for the sequential aggregation, except for the order
+ * of the groups.
+ */
+template <typename AggregateKey>
+void AggregateHash::_aggregate_partitioned(KeysPerChunk<AggregateKey>& keys_per_chunk) {
+  const auto& input_table = left_input_table();
+  const auto chunk_count = input_table->chunk_count();
+
+  // The context that performs the lookups in its result_ids map is the first one that actually aggregates a column.
+  // Following contexts retrieve the cached result ids from the AggregateKeys (see get_or_add_result).
+  auto key_context_idx = ColumnID{0};
+  if (_has_aggregate_functions) {
+    while (_aggregates[key_context_idx]->aggregate_function == AggregateFunction::Any) {
+      ++key_context_idx;
+    }
+  }
+
+  const auto task_count = std::min(static_cast<size_t>(chunk_count),
+                                   std::max(size_t{2}, static_cast<size_t>(Hyrise::get().topology.num_cpus())));
+  auto radix_bits = size_t{0};
+  while ((size_t{1} << radix_bits) < task_count) {
+    ++radix_bits;
+  }
+  const auto partition_count = size_t{1} << radix_bits;
+  const auto partition_mask = partition_count - 1;
+
+  /**
+   * (1) Thread-local pre-aggregation and radix partitioning
+   */
+  auto local_aggregations = std::vector<LocalAggregation<AggregateKey>>(task_count);
+  auto passed_through_row_counts = std::vector<size_t>(task_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(std::max(task_count, partition_count));
+  for (auto task_idx = size_t{0}; task_idx < task_count; ++task_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, task_idx]() {
+      auto& local_aggregation = local_aggregations[task_idx];
+      local_aggregation.contexts = _create_aggregate_contexts<AggregateKey>(0);
+      local_aggregation.groups_per_partition.resize(partition_count);
+      local_aggregation.rows_per_partition.resize(partition_count);
+
+      const AggregateResultIdMap<AggregateKey>* result_ids = nullptr;
+      _resolve_context_type(key_context_idx, [&](const auto type, const auto function) {
+        using ColumnDataType = typename decltype(type)::type;
+        using Context = AggregateContext<ColumnDataType, decltype(function)::value, AggregateKey>;
+        result_ids = static_cast<const Context&>(*local_aggregation.contexts[key_context_idx]).result_ids.get();
+      });
+
+      const auto begin_chunk_id = static_cast<ChunkID::base_type>(task_idx * chunk_count / task_count);
+      const auto end_chunk_id = static_cast<ChunkID::base_type>((task_idx + 1) * chunk_count / task_count);
+
+      auto pre_aggregated_row_count = size_t{0};
+      auto pass_through = false;
+      for (auto chunk_id = ChunkID{begin_chunk_id}; chunk_id < end_chunk_id; ++chunk_id) {
+        const auto chunk_in = input_table->get_chunk(chunk_id);
+        if (!chunk_in) continue;
 
-          ++aggregate_idx;
+        const auto input_chunk_size = chunk_in->size();
+        if (!pass_through) {
+          _aggregate_chunk<AggregateKey>(chunk_id, local_aggregation.contexts, keys_per_chunk);
+
+          // If (almost) every row formed its own group so far, the pre-aggregation only adds a hash map lookup per row
+          // without reducing the work of the merge phase. In that case, the remaining rows are passed through.
+          pre_aggregated_row_count += input_chunk_size;
+          pass_through = static_cast<double>(result_ids->size()) >
+                         static_cast<double>(pre_aggregated_row_count) * PASS_THROUGH_GROUP_RATIO;
           continue;
         }
 
-        const auto abstract_segment = chunk_in->get_segment(input_column_id);
-        const auto data_type = input_table->column_data_type(input_column_id);
+        const auto& keys = keys_per_chunk[chunk_id];
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < input_chunk_size; ++chunk_offset) {
+          const auto& key = keys[chunk_offset];
+          const auto partition_idx = std::hash<AggregateKey>{}(key) & partition_mask;
+          local_aggregation.rows_per_partition[partition_idx].push_back(
+              {key, RowID{chunk_id, chunk_offset}, AggregateResultId{0}});
+        }
+        passed_through_row_counts[task_idx] += input_chunk_size;
+      }
+
+      // The keys in the result_ids map have not been modified by the result id caching of get_or_add_result.
+      for (const auto& [key, local_result_id] : *result_ids) {
+        const auto partition_idx = std::hash<AggregateKey>{}(key) & partition_mask;
+        local_aggregation.groups_per_partition[partition_idx].push_back({key, local_result_id, AggregateResultId{0}});
+      }
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  /**
+   * (2) Assignment of the indexes of the groups within their partition
+   */
+  auto partition_offsets = std::vector<AggregateResultId>(partition_count + 1);
+
+  jobs.clear();
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_idx]() {
+      auto partition_result_ids = AggregateResultIdMap<AggregateKey>{};
+      const auto get_partition_result_id = [&](const AggregateKey& key) {
+        const auto it = partition_result_ids.find(key);
+        if (it != partition_result_ids.end()) return it->second;
+
+        const auto partition_result_id = partition_result_ids.size();
+        partition_result_ids.emplace(key, partition_result_id);
+        return partition_result_id;
+      };
+
+      for (auto& local_aggregation : local_aggregations) {
+        for (auto& group : local_aggregation.groups_per_partition[partition_idx]) {
+          group.partition_result_id = get_partition_result_id(group.key);
+        }
+        for (auto& row : local_aggregation.rows_per_partition[partition_idx]) {
+          row.partition_result_id = get_partition_result_id(row.key);
+        }
+      }
+
+      // Stored shifted by one so that the exclusive prefix sum below can be calculated in place.
+      partition_offsets[partition_idx + 1] = partition_result_ids.size();
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  std::partial_sum(partition_offsets.begin(), partition_offsets.end(), partition_offsets.begin());
+  const auto group_count = partition_offsets.back();
 
-        /*
-        Invoke correct aggregator for each segment
-        */
+  /**
+   * (3) Merging of the partitions
+   */
+  _contexts_per_column = _create_aggregate_contexts<AggregateKey>(0);
+  for (auto context_idx = ColumnID{0}; context_idx < _contexts_per_column.size(); ++context_idx) {
+    _resolve_context_type(context_idx, [&](const auto type, const auto function) {
+      using ColumnDataType = typename decltype(type)::type;
+      using Context = AggregateContext<ColumnDataType, decltype(function)::value, AggregateKey>;
+      // ANY is handled by _write_groupby_output and does not use its results.
+      if constexpr (decltype(function)::value != AggregateFunction::Any) {
+        static_cast<Context&>(*_contexts_per_column[context_idx]).results.resize(group_count);
+      }
+    });
+  }
+
+  jobs.clear();
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, partition_idx]() {
+      const auto partition_offset = partition_offsets[partition_idx];
 
-        resolve_data_type(data_type, [&, aggregate](auto type) {
+      for (auto context_idx = ColumnID{0}; context_idx < _contexts_per_column.size(); ++context_idx) {
+        const auto input_column_id =
+            _has_aggregate_functions
+                ? static_cast<const PQPColumnExpression&>(*_aggregates[context_idx]->argument()).column_id
+                : INVALID_COLUMN_ID;
+
+        _resolve_context_type(context_idx, [&](const auto type, const auto function) {
           using ColumnDataType = typename decltype(type)::type;
+          constexpr auto aggregate_function = decltype(function)::value;
+          using Context = AggregateContext<ColumnDataType, aggregate_function, AggregateKey>;
+
+          if constexpr (aggregate_function != AggregateFunction::Any) {
+            auto& results = static_cast<Context&>(*_contexts_per_column[context_idx]).results;
 
-          switch (aggregate->aggregate_function) {
-            case AggregateFunction::Min:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Min, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Max:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Max, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Sum:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Sum, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Avg:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Avg, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Count:
-              _aggregate_segment<ColumnDataType, AggregateFunction::Count, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::CountDistinct:
-              _aggregate_segment<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::StandardDeviationSample:
-              _aggregate_segment<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>(
-                  chunk_id, aggregate_idx, *abstract_segment, keys_per_chunk);
-              break;
-            case AggregateFunction::Any:
-              // ANY is a pseudo-function and is handled by _write_groupby_output
-              break;
+            for (const auto& local_aggregation : local_aggregations) {
+              const auto& local_results = static_cast<const Context&>(*local_aggregation.contexts[context_idx]).results;
+              for (const auto& group : local_aggregation.groups_per_partition[partition_idx]) {
+                merge_aggregate_result(results[partition_offset + group.partition_result_id],
+                                       local_results[group.local_result_id]);
+              }
+
+              const auto& rows = local_aggregation.rows_per_partition[partition_idx];
+              if (!rows.empty()) {
+                aggregate_passed_through_rows(results, partition_offset, rows, *input_table, input_column_id);
+              }
+            }
           }
         });
-
-        ++aggregate_idx;
       }
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  auto& step_performance_data = static_cast<PerformanceData&>(*performance_data);
+  step_performance_data.partition_count = partition_count;
+  step_performance_data.passed_through_row_count =
+      std::accumulate(passed_through_row_counts.begin(), passed_through_row_counts.end(), size_t{0});
+}
+
+// In the worst case, every row forms its own group. Each group has one result per context and an entry in the
+// result_ids map, for which a load factor of 0.8 is assumed. Memory allocated by the results (e.g., for the DISTINCT
+// values of COUNT(DISTINCT)) is not accounted for.
+template <typename AggregateKey>
+size_t AggregateHash::_estimate_memory_consumption() const {
+  auto group_size =
+      static_cast<size_t>(static_cast<double>(sizeof(std::pair<AggregateKey, AggregateResultId>) + 1) / 0.8);
+  const auto context_count = _has_aggregate_functions ? _aggregates.size() : size_t{1};
+  for (auto context_idx = ColumnID{0}; context_idx < context_count; ++context_idx) {
+    _resolve_context_type(context_idx, [&](const auto type, const auto function) {
+      using ColumnDataType = typename decltype(type)::type;
+      group_size += sizeof(AggregateResult<ColumnDataType, decltype(function)::value>);
+    });
+  }
+
+  return left_input_table()->row_count() * group_size;
+}
+
+/**
+ * Aggregation that is used if the results and hash maps of the aggregation might not fit into the memory budget of the
+ * query. The keys and RowIDs of all rows are written to files on disk, partitioned by the hash of their keys. As all
+ * rows of a group end up in the same partition, the partitions can be aggregated one at a time, so that only the hash
+ * map of a single partition is held in memory. The groups of each partition are appended to the results in
+ * _contexts_per_column. As in the merge phase of _aggregate_partitioned, the aggregated values are accessed by the
+ * RowIDs of the rows.
+ */
+template <typename AggregateKey>
+void AggregateHash::_aggregate_spilling(KeysPerChunk<AggregateKey>& keys_per_chunk,
+                                        const size_t estimated_memory_consumption) {
+  const auto& input_table = left_input_table();
+  const auto available_bytes = std::max(memory_budget_resource()->available_bytes(), size_t{1});
+
+  auto partition_count = size_t{2};
+  while (estimated_memory_consumption / partition_count > available_bytes &&
+         partition_count < MAX_SPILL_PARTITION_COUNT) {
+    partition_count *= 2;
+  }
+  const auto partition_mask = partition_count - 1;
+
+  /**
+   * (1) Spilling of the keys and RowIDs of all rows
+   */
+  auto partition_files = std::vector<std::unique_ptr<SpillFile>>(partition_count);
+  for (auto& partition_file : partition_files) {
+    partition_file = std::make_unique<SpillFile>(memory_budget_resource()->spill_directory());
+  }
+  auto row_counts = std::vector<size_t>(partition_count);
+
+  const auto chunk_count = input_table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk_in = input_table->get_chunk(chunk_id);
+    if (!chunk_in) continue;
+
+    const auto& keys = keys_per_chunk[chunk_id];
+    const auto input_chunk_size = chunk_in->size();
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < input_chunk_size; ++chunk_offset) {
+      const auto& key = keys[chunk_offset];
+      const auto partition_idx = std::hash<AggregateKey>{}(key) & partition_mask;
+      write_aggregate_key(*partition_files[partition_idx], key);
+      partition_files[partition_idx]->write(RowID{chunk_id, chunk_offset});
+      ++row_counts[partition_idx];
     }
+
+    // The keys of this chunk have been spilled and are not needed anymore.
+    keys_per_chunk[chunk_id] = AggregateKeys<AggregateKey>{};
   }
-  step_performance_data.set_step_runtime(OperatorSteps::Aggregating, timer.lap());
-}  // NOLINT(readability/fn_size)
+
+  auto spilled_bytes = size_t{0};
+  for (const auto& partition_file : partition_files) {
+    spilled_bytes += partition_file->size();
+  }
+  memory_budget_resource()->add_spilled_bytes(spilled_bytes);
+
+  /**
+   * (2) Aggregation of one partition at a time
+   */
+  _contexts_per_column = _create_aggregate_contexts<AggregateKey>(0);
+  auto group_count = AggregateResultId{0};
+  for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+    if (row_counts[partition_idx] == 0) continue;
+
+    // A partition cannot be split further, so its share of the estimated memory consumption is reserved even if that
+    // exceeds the budget.
+    auto partition_reservation = MemoryReservation{memory_budget_resource()};
+    partition_reservation.reserve(estimated_memory_consumption / partition_count);
+
+    auto& partition_file = *partition_files[partition_idx];
+    partition_file.start_reading();
+
+    auto rows = std::vector<PartitionedRow<AggregateKey>>(row_counts[partition_idx]);
+    auto partition_result_ids = AggregateResultIdMap<AggregateKey>{};
+    for (auto& row : rows) {
+      read_aggregate_key(partition_file, row.key);
+      partition_file.read(row.row_id);
+      row.partition_result_id = partition_result_ids.emplace(row.key, partition_result_ids.size()).first->second;
+    }
+    partition_files[partition_idx] = nullptr;
+
+    const auto partition_group_count = partition_result_ids.size();
+    for (auto context_idx = ColumnID{0}; context_idx < _contexts_per_column.size(); ++context_idx) {
+      const auto input_column_id =
+          _has_aggregate_functions
+              ? static_cast<const PQPColumnExpression&>(*_aggregates[context_idx]->argument()).column_id
+              : INVALID_COLUMN_ID;
+
+      _resolve_context_type(context_idx, [&](const auto type, const auto function) {
+        using ColumnDataType = typename decltype(type)::type;
+        constexpr auto aggregate_function = decltype(function)::value;
+        using Context = AggregateContext<ColumnDataType, aggregate_function, AggregateKey>;
+
+        // ANY is handled by _write_groupby_output and does not use its results.
+        if constexpr (aggregate_function != AggregateFunction::Any) {
+          auto& results = static_cast<Context&>(*_contexts_per_column[context_idx]).results;
+          results.resize(group_count + partition_group_count);
+          aggregate_passed_through_rows(results, group_count, rows, *input_table, input_column_id);
+        }
+      });
+    }
+    group_count += partition_group_count;
+  }
+
+  auto& step_performance_data = static_cast<PerformanceData&>(*performance_data);
+  step_performance_data.spilled_partition_count = partition_count;
+  step_performance_data.spilled_bytes = spilled_bytes;
+}
 
 std::shared_ptr<const Table> AggregateHash::_on_execute() {
   // We do not want the overhead of a vector with heap storage when we have a limited number of aggregate columns.
@@ -1160,39 +1643,85 @@ void AggregateHash::write_aggregate_output(ColumnID aggregate_index) {
   aggregate_columns_writing_duration += timer.lap() - excluded_time;
 }
 
+template <typename AggregateKey>
+std::vector<std::shared_ptr<SegmentVisitorContext>> AggregateHash::_create_aggregate_contexts(
+    const size_t preallocated_size) const {
+  if (!_has_aggregate_functions) {
+    /*
+    Insert a dummy context for the DISTINCT implementation.
+    That way, the contexts will always have at least one context with results.
+    This is important later on when we write the group keys into the table.
+    The template parameters (int32_t, AggregateFunction::Min) do not matter, as we do not calculate an aggregate anyway.
+    ANY pseudo-aggregates are written by _write_groupby_output and do not need a context.
+    */
+    return {std::make_shared<AggregateContext<DistinctColumnType, AggregateFunction::Min, AggregateKey>>(
+        preallocated_size, _context_memory_resource())};
+  }
+
+  auto contexts = std::vector<std::shared_ptr<SegmentVisitorContext>>(_aggregates.size());
+  const auto& input_table = left_input_table();
+  for (ColumnID aggregate_idx{0}; aggregate_idx < _aggregates.size(); ++aggregate_idx) {
+    const auto& aggregate = _aggregates[aggregate_idx];
+
+    const auto& pqp_column = static_cast<const PQPColumnExpression&>(*aggregate->argument());
+    const auto input_column_id = pqp_column.column_id;
+
+    if (input_column_id == INVALID_COLUMN_ID) {
+      Assert(aggregate->aggregate_function == AggregateFunction::Count, "Only COUNT may have an invalid ColumnID");
+      // SELECT COUNT(*) - we know the template arguments, so we don't need a visitor
+      contexts[aggregate_idx] =
+          std::make_shared<AggregateContext<CountColumnType, AggregateFunction::Count, AggregateKey>>(
+              preallocated_size, _context_memory_resource());
+      continue;
+    }
+    const auto data_type = input_table->column_data_type(input_column_id);
+    contexts[aggregate_idx] =
+        _create_aggregate_context<AggregateKey>(data_type, aggregate->aggregate_function, preallocated_size);
+  }
+
+  return contexts;
+}
+
 template <typename AggregateKey>
 std::shared_ptr<SegmentVisitorContext> AggregateHash::_create_aggregate_context(
-    const DataType data_type, const AggregateFunction aggregate_function) const {
+    const DataType data_type, const AggregateFunction aggregate_function, const size_t preallocated_size) const {
   std::shared_ptr<SegmentVisitorContext> context;
   resolve_data_type(data_type, [&](auto type) {
-    const auto size = _expected_result_size.load();
+    const auto size = preallocated_size;
+    auto* const upstream = _context_memory_resource();
     using ColumnDataType = typename decltype(type)::type;
     switch (aggregate_function) {
       case AggregateFunction::Min:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Min, AggregateKey>>(size);
+        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Min, AggregateKey>>(
+            size, upstream);
         break;
       case AggregateFunction::Max:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Max, AggregateKey>>(size);
+        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Max, AggregateKey>>(
+            size, upstream);
         break;
       case AggregateFunction::Sum:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Sum, AggregateKey>>(size);
+        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Sum, AggregateKey>>(
+            size, upstream);
         break;
       case AggregateFunction::Avg:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Avg, AggregateKey>>(size);
+        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Avg, AggregateKey>>(
+            size, upstream);
         break;
       case AggregateFunction::Count:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Count, AggregateKey>>(size);
+        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Count, AggregateKey>>(
+            size, upstream);
         break;
       case AggregateFunction::CountDistinct:
-        context =
-            std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>>(size);
+        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::CountDistinct, AggregateKey>>(
+            size, upstream);
         break;
       case AggregateFunction::StandardDeviationSample:
         context = std::make_shared<
-            AggregateContext<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>>(size);
+            AggregateContext<ColumnDataType, AggregateFunction::StandardDeviationSample, AggregateKey>>(size, upstream);
         break;
       case AggregateFunction::Any:
-        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Any, AggregateKey>>(size);
+        context = std::make_shared<AggregateContext<ColumnDataType, AggregateFunction::Any, AggregateKey>>(
+            size, upstream);
         break;
     }
   });
@@ -1200,4 +1729,74 @@ std::shared_ptr<SegmentVisitorContext> AggregateHash::_create_aggregate_context(
   return context;
 }
 
+template <typename Functor>
+void AggregateHash::_resolve_context_type(const ColumnID context_idx, const Functor& functor) const {
+  if (!_has_aggregate_functions) {
+    functor(boost::hana::type_c<DistinctColumnType>,
+            std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
+    return;
+  }
+
+  const auto& aggregate = _aggregates[context_idx];
+  const auto input_column_id = static_cast<const PQPColumnExpression&>(*aggregate->argument()).column_id;
+  if (input_column_id == INVALID_COLUMN_ID) {
+    functor(boost::hana::type_c<CountColumnType>,
+            std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+    return;
+  }
+
+  resolve_data_type(left_input_table()->column_data_type(input_column_id), [&](const auto type) {
+    switch (aggregate->aggregate_function) {
+      case AggregateFunction::Min:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Min>{});
+        break;
+      case AggregateFunction::Max:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Max>{});
+        break;
+      case AggregateFunction::Sum:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Sum>{});
+        break;
+      case AggregateFunction::Avg:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Avg>{});
+        break;
+      case AggregateFunction::Count:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Count>{});
+        break;
+      case AggregateFunction::CountDistinct:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::CountDistinct>{});
+        break;
+      case AggregateFunction::StandardDeviationSample:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::StandardDeviationSample>{});
+        break;
+      case AggregateFunction::Any:
+        functor(type, std::integral_constant<AggregateFunction, AggregateFunction::Any>{});
+        break;
+    }
+  });
+}
+
+boost::container::pmr::memory_resource* AggregateHash::_context_memory_resource() const {
+  if (_memory_budget_resource) return _memory_budget_resource.get();
+  return boost::container::pmr::get_default_resource();
+}
+
+void AggregateHash::PerformanceData::output_to_stream(std::ostream& stream, DescriptionMode description_mode) const {
+  OperatorPerformanceData<OperatorSteps>::output_to_stream(stream, description_mode);
+
+  const auto* const separator = description_mode == DescriptionMode::SingleLine ? " " : "\n";
+  if (spilled_partition_count > 0) {
+    stream << separator << "Spilled " << format_bytes(spilled_bytes) << " to " << spilled_partition_count
+           << " partitions.";
+    return;
+  }
+
+  if (partition_count == 0) {
+    stream << separator << "Aggregated sequentially.";
+    return;
+  }
+
+  stream << separator << "Radix partitions: " << partition_count << ".";
+  stream << separator << "Rows passed through: " << passed_through_row_count << ".";
+}
+
 }  // namespace opossum
@@ -156,6 +156,30 @@ class AggregateHash : public AbstractAggregateOperator {
     OutputWriting
   };
 
+  struct PerformanceData : public OperatorPerformanceData<OperatorSteps> {
+    void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override;
+
+    // Number of radix partitions that were merged in parallel. Zero if the input was aggregated sequentially.
+    size_t partition_count{0};
+
+    // Rows for which the thread-local pre-aggregation was skipped because it did not reduce the number of groups.
+    size_t passed_through_row_count{0};
+
+    // Number of partitions that the input was spilled to and their size on disk. Zero if the aggregation fit into the
+    // memory budget of the query.
+    size_t spilled_partition_count{0};
+    size_t spilled_bytes{0};
+  };
+
+  // Inputs with fewer rows are aggregated sequentially, as the merging of thread-local results would not pay off.
+  static constexpr auto PARALLEL_AGGREGATION_MIN_ROW_COUNT = size_t{50'000};
+
+  // If the pre-aggregation of a thread has found more groups than this share of its rows, it stops pre-aggregating.
+  static constexpr auto PASS_THROUGH_GROUP_RATIO = 0.8;
+
+  // Limits the number of files that are opened at the same time if the aggregation does not fit into its memory budget.
+  static constexpr auto MAX_SPILL_PARTITION_COUNT = size_t{256};
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
 
@@ -165,6 +189,19 @@ class AggregateHash : public AbstractAggregateOperator {
   template <typename AggregateKey>
   void _aggregate();
 
+  template <typename AggregateKey>
+  void _aggregate_chunk(ChunkID chunk_id, std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts,
+                        KeysPerChunk<AggregateKey>& keys_per_chunk);
+
+  template <typename AggregateKey>
+  void _aggregate_partitioned(KeysPerChunk<AggregateKey>& keys_per_chunk);
+
+  template <typename AggregateKey>
+  size_t _estimate_memory_consumption() const;
+
+  template <typename AggregateKey>
+  void _aggregate_spilling(KeysPerChunk<AggregateKey>& keys_per_chunk, size_t estimated_memory_consumption);
+
   std::shared_ptr<AbstractOperator> _on_deep_copy(
       const std::shared_ptr<AbstractOperator>& copied_left_input,
       const std::shared_ptr<AbstractOperator>& copied_right_input,
@@ -182,11 +219,25 @@ class AggregateHash : public AbstractAggregateOperator {
 
   template <typename ColumnDataType, AggregateFunction aggregate_function, typename AggregateKey>
   void _aggregate_segment(ChunkID chunk_id, ColumnID column_index, const AbstractSegment& abstract_segment,
+                          std::vector<std::shared_ptr<SegmentVisitorContext>>& contexts,
                           KeysPerChunk<AggregateKey>& keys_per_chunk);
 
+  template <typename AggregateKey>
+  std::vector<std::shared_ptr<SegmentVisitorContext>> _create_aggregate_contexts(size_t preallocated_size) const;
+
   template <typename AggregateKey>
   std::shared_ptr<SegmentVisitorContext> _create_aggregate_context(const DataType data_type,
-                                                                   const AggregateFunction aggregate_function) const;
+                                                                   const AggregateFunction aggregate_function,
+                                                                   size_t preallocated_size) const;
+
+  // Calls functor with the ColumnDataType (as boost::hana::type) and the AggregateFunction (as
+  // std::integral_constant) of the context that _create_aggregate_contexts creates at context_idx.
+  template <typename Functor>
+  void _resolve_context_type(ColumnID context_idx, const Functor& functor) const;
+
+  // The memory resource from which the aggregate contexts allocate their results and hash maps. If the query has a
+  // memory budget, this is its MemoryBudgetResource.
+  boost::container::pmr::memory_resource* _context_memory_resource() const;
 
   std::vector<std::shared_ptr<BaseValueSegment>> _groupby_segments;
   std::vector<std::shared_ptr<SegmentVisitorContext>> _contexts_per_column;
@@ -1,13 +1,21 @@
 #include "delete.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "logging/wal_commit_record.hpp"
 #include "operators/validate.hpp"
 #include "statistics/table_statistics.hpp"
+#include "storage/mvcc_data.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/row_versions.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
@@ -67,7 +75,19 @@ std::shared_ptr<const Table> Delete::_on_execute(std::shared_ptr<TransactionCont
         auto expected = 0u;
         const auto success = mvcc_data->compare_exchange_tid(row_id.chunk_offset, expected, _transaction_id);
 
-        if (!success) {
+        if (success) {
+          // A concurrent Update might have added a newer version of the row (see RowVersions). As Update adds its
+          // version before it checks the row's TID, at least one of both operators detects the conflict.
+          std::atomic_thread_fence(std::memory_order_seq_cst);
+          const auto row_versions = mvcc_data->row_versions();
+          const auto newest_version = row_versions ? row_versions->newest_version(row_id.chunk_offset) : nullptr;
+          if (newest_version && newest_version->transaction_id != _transaction_id &&
+              newest_version->begin_cid > context->snapshot_commit_id()) {
+            mvcc_data->set_tid(row_id.chunk_offset, INVALID_TRANSACTION_ID);
+            _mark_as_failed();
+            return nullptr;
+          }
+        } else {
           // If the row has a set TID, it might be a row that our TX inserted
           // No need to compare-and-swap here, because we can only run into conflicts when two transactions try to
           // change this row from the initial tid
@@ -130,6 +150,57 @@ void Delete::_on_rollback_records() {
   }
 }
 
+void Delete::_on_log_records(WalCommitRecordWriter& record_writer) const {
+  // The log refers to the stored tables by their names and to the rows by their RowIDs in the stored tables. The
+  // referenced tables are usually outputs of GetTable, which are neither stored nor have the ChunkIDs of the stored
+  // table if chunks were pruned. Their chunks share the MVCC data with the stored chunks, which identifies the stored
+  // table and the stored ChunkIDs.
+  struct StoredTable {
+    std::string name;
+    std::unordered_map<const MvccData*, ChunkID> chunk_ids;
+    RowIDPosList deleted_rows;
+  };
+  auto stored_tables = std::vector<StoredTable>{};
+  auto stored_table_indexes = std::unordered_map<const Table*, size_t>{};
+
+  const auto find_stored_table = [&](const MvccData* mvcc_data) {
+    for (const auto& [name, table] : Hyrise::get().storage_manager.tables()) {
+      auto chunk_ids = _chunk_ids_by_mvcc_data(*table);
+      if (chunk_ids.contains(mvcc_data)) {
+        stored_tables.emplace_back(StoredTable{name, std::move(chunk_ids), RowIDPosList{}});
+        return stored_tables.size() - 1;
+      }
+    }
+    Fail("Cannot log deletes from a table that is not in the StorageManager");
+  };
+
+  for (ChunkID referencing_chunk_id{0}; referencing_chunk_id < _referencing_table->chunk_count();
+       ++referencing_chunk_id) {
+    const auto referencing_chunk = _referencing_table->get_chunk(referencing_chunk_id);
+    const auto referencing_segment =
+        std::static_pointer_cast<const ReferenceSegment>(referencing_chunk->get_segment(ColumnID{0}));
+    const auto& referenced_table = *referencing_segment->referenced_table();
+
+    for (const auto row_id : *referencing_segment->pos_list()) {
+      const auto* mvcc_data = referenced_table.get_chunk(row_id.chunk_id)->mvcc_data().get();
+
+      auto stored_table_index_iter = stored_table_indexes.find(&referenced_table);
+      if (stored_table_index_iter == stored_table_indexes.end()) {
+        stored_table_index_iter = stored_table_indexes.emplace(&referenced_table, find_stored_table(mvcc_data)).first;
+      }
+
+      auto& stored_table = stored_tables[stored_table_index_iter->second];
+      const auto chunk_id_iter = stored_table.chunk_ids.find(mvcc_data);
+      Assert(chunk_id_iter != stored_table.chunk_ids.end(), "Deleted row does not belong to the stored table");
+      stored_table.deleted_rows.emplace_back(chunk_id_iter->second, row_id.chunk_offset);
+    }
+  }
+
+  for (const auto& stored_table : stored_tables) {
+    record_writer.add_delete(stored_table.name, stored_table.deleted_rows);
+  }
+}
+
 std::shared_ptr<AbstractOperator> Delete::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
@@ -36,6 +36,7 @@ std::shared_ptr<const Table> Export::_on_execute() {
       break;
     case FileType::Auto:
     case FileType::Tbl:
+    case FileType::Parquet:
       Fail("Export: Exporting file type is not supported.");
   }
 
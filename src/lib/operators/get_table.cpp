@@ -8,6 +8,10 @@
 #include <vector>
 
 #include "hyrise.hpp"
+#include "operators/runtime_filter.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/foreign_segment.hpp"
+#include "storage/row_versions.hpp"
 #include "types.hpp"
 
 namespace opossum {
@@ -50,6 +54,10 @@ std::string GetTable::description(DescriptionMode description_mode) const {
   stream << _pruned_chunk_ids.size() << "/" << stored_table->chunk_count() << " chunk(s)";
   if (description_mode == DescriptionMode::SingleLine) stream << ",";
   stream << separator << _pruned_column_ids.size() << "/" << stored_table->column_count() << " column(s)";
+  if (_runtime_filter_pruned_chunk_count > 0) {
+    if (description_mode == DescriptionMode::SingleLine) stream << ",";
+    stream << separator << _runtime_filter_pruned_chunk_count << " chunk(s) by runtime filters";
+  }
 
   return stream.str();
 }
@@ -60,6 +68,17 @@ const std::vector<ChunkID>& GetTable::pruned_chunk_ids() const { return _pruned_
 
 const std::vector<ColumnID>& GetTable::pruned_column_ids() const { return _pruned_column_ids; }
 
+void GetTable::add_runtime_filter(const std::shared_ptr<RuntimeFilter>& runtime_filter, const ColumnID column_id) {
+  // Runtime filters refer to the columns of the output, pruning statistics to those of the stored table.
+  auto stored_column_id = column_id;
+  for (const auto pruned_column_id : _pruned_column_ids) {
+    if (pruned_column_id > stored_column_id) break;
+    ++stored_column_id;
+  }
+
+  _runtime_filters.emplace_back(runtime_filter, stored_column_id);
+}
+
 std::shared_ptr<AbstractOperator> GetTable::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
@@ -69,6 +88,8 @@ std::shared_ptr<AbstractOperator> GetTable::_on_deep_copy(
 
 void GetTable::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
+void GetTable::_on_cleanup() { _runtime_filters.clear(); }
+
 std::shared_ptr<const Table> GetTable::_on_execute() {
   const auto stored_table = Hyrise::get().storage_manager.get_table(_name);
 
@@ -95,18 +116,32 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
   // flag, too, it needs to be forwarded here; otherwise it would be completely invisible in the PQP.
   DebugAssert(stored_table->value_clustered_by().empty(), "GetTable does not forward value_clustered_by");
 
+  // Runtime filters are only applied if the build side's join column has the same data type
+  auto runtime_filters = std::vector<std::pair<std::shared_ptr<RuntimeFilter>, ColumnID>>{};
+  for (const auto& [runtime_filter, stored_column_id] : _runtime_filters) {
+    if (runtime_filter->prepare(stored_table->column_data_type(stored_column_id))) {
+      runtime_filters.emplace_back(runtime_filter, stored_column_id);
+    }
+  }
+
   auto excluded_chunk_ids = std::vector<ChunkID>{};
   auto pruned_chunk_ids_iter = _pruned_chunk_ids.begin();
   for (ChunkID stored_chunk_id{0}; stored_chunk_id < chunk_count; ++stored_chunk_id) {
+    const auto chunk = stored_table->get_chunk(stored_chunk_id);
+
+    // The pruning statistics of chunks with rows that were updated in place (see RowVersions) do not reflect the
+    // updated values. Thus, these chunks are not pruned, even if they were pruned when the plan was optimized.
+    const auto has_row_versions = chunk && chunk->has_mvcc_data() && chunk->mvcc_data()->row_versions();
+
     // Check whether the Chunk is pruned
     if (pruned_chunk_ids_iter != _pruned_chunk_ids.end() && *pruned_chunk_ids_iter == stored_chunk_id) {
       ++pruned_chunk_ids_iter;
-      excluded_chunk_ids.emplace_back(stored_chunk_id);
-      continue;
+      if (!has_row_versions) {
+        excluded_chunk_ids.emplace_back(stored_chunk_id);
+        continue;
+      }
     }
 
-    const auto chunk = stored_table->get_chunk(stored_chunk_id);
-
     // Skip chunks that were physically deleted
     if (!chunk) {
       excluded_chunk_ids.emplace_back(stored_chunk_id);
@@ -125,6 +160,16 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
       excluded_chunk_ids.emplace_back(stored_chunk_id);
       continue;
     }
+
+    // Check whether the Chunk cannot contain join partners for the build side of a hash join
+    if (!has_row_versions &&
+        std::any_of(runtime_filters.begin(), runtime_filters.end(), [&](const auto& runtime_filter_and_column_id) {
+          return runtime_filter_and_column_id.first->can_prune(*chunk, runtime_filter_and_column_id.second);
+        })) {
+      excluded_chunk_ids.emplace_back(stored_chunk_id);
+      ++_runtime_filter_pruned_chunk_count;
+      continue;
+    }
   }
 
   // We cannot create a Table without columns - since Chunks rely on their first column to determine their row count
@@ -165,6 +210,9 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
 
   auto excluded_chunk_ids_iter = excluded_chunk_ids.begin();
 
+  // Jobs that load the ForeignSegments of the output chunks of a foreign table (see ForeignSegment)
+  auto foreign_segment_jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+
   for (ChunkID stored_chunk_id{0}; stored_chunk_id < chunk_count; ++stored_chunk_id) {
     // Skip `stored_chunk_id` if it is in the sorted vector `excluded_chunk_ids`
     if (excluded_chunk_ids_iter != excluded_chunk_ids.end() && *excluded_chunk_ids_iter == stored_chunk_id) {
@@ -180,7 +228,11 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
     const auto& input_chunk_sorted_by = stored_chunk->individually_sorted_by();
     std::optional<SortColumnDefinition> output_chunk_sorted_by;
 
-    if (_pruned_column_ids.empty()) {
+    // Chunks of foreign tables are copied so that their ForeignSegments can be replaced with the loaded segments.
+    const auto stored_chunk_is_foreign =
+        static_cast<bool>(std::dynamic_pointer_cast<const ForeignSegment>(stored_chunk->get_segment(ColumnID{0})));
+
+    if (_pruned_column_ids.empty() && !stored_chunk_is_foreign) {
       *output_chunks_iter = stored_chunk;
     } else {
       auto output_segments = Segments{stored_table->column_count() - _pruned_column_ids.size()};
@@ -227,11 +279,48 @@ std::shared_ptr<const Table> GetTable::_on_execute() {
       // The output chunk contains all rows that are in the stored chunk, including invalid rows. We forward this
       // information so that following operators (currently, the Validate operator) can use it for optimizations.
       (*output_chunks_iter)->increase_invalid_row_count(stored_chunk->invalid_row_count());
+
+      if (stored_chunk_is_foreign) {
+        const auto output_chunk = *output_chunks_iter;
+        for (auto column_id = ColumnID{0}; column_id < output_chunk->column_count(); ++column_id) {
+          foreign_segment_jobs.emplace_back(std::make_shared<JobTask>([output_chunk, column_id]() {
+            const auto foreign_segment =
+                std::static_pointer_cast<const ForeignSegment>(output_chunk->get_segment(column_id));
+            output_chunk->replace_segment(column_id, foreign_segment->load());
+          }));
+        }
+      }
     }
 
     ++output_chunks_iter;
   }
 
+  // Only the chunks and columns that were not pruned are read from the file.
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(foreign_segment_jobs);
+
+  // Replace the segments of columns with rows that were updated in place by segments with the values visible to this
+  // transaction (see RowVersions). Without a transaction context, the latest committed values are visible.
+  if (stored_table->uses_mvcc() == UseMvcc::Yes) {
+    auto stored_column_ids = std::vector<ColumnID>{};
+    auto pruned_column_ids_iter = _pruned_column_ids.begin();
+    for (auto stored_column_id = ColumnID{0}; stored_column_id < stored_table->column_count(); ++stored_column_id) {
+      if (pruned_column_ids_iter != _pruned_column_ids.end() && stored_column_id == *pruned_column_ids_iter) {
+        ++pruned_column_ids_iter;
+        continue;
+      }
+      stored_column_ids.emplace_back(stored_column_id);
+    }
+
+    const auto transaction_id =
+        transaction_context_is_set() ? transaction_context()->transaction_id() : INVALID_TRANSACTION_ID;
+    const auto snapshot_commit_id = transaction_context_is_set() ? transaction_context()->snapshot_commit_id()
+                                                                 : Hyrise::get().transaction_manager.last_commit_id();
+    for (auto& output_chunk : output_chunks) {
+      output_chunk =
+          resolve_row_versions(output_chunk, *stored_table, stored_column_ids, transaction_id, snapshot_commit_id);
+    }
+  }
+
   return std::make_shared<Table>(pruned_column_definitions, TableType::Data, std::move(output_chunks),
                                  stored_table->uses_mvcc());
 }
@@ -2,6 +2,7 @@
 
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "abstract_read_only_operator.hpp"
@@ -10,6 +11,8 @@
 
 namespace opossum {
 
+class RuntimeFilter;
+
 // Operator to retrieve a table from the StorageManager by specifying its name. Depending on how the operator was
 // constructed, chunks and columns may be pruned if they are irrelevant for the final result. The returned table is NOT
 // the same table as stored in the StorageManager. If that stored table is changed (most importantly: if a chunk is
@@ -17,6 +20,12 @@ namespace opossum {
 // have to deal with tables that change their chunk count while they are being looked at. However, rows added to a chunk
 // within that stored table that was already present when GetTable was executed will be visible when calling
 // get_output().
+//
+// If the GetTable reads the probe side of a hash join, the join's runtime filters are used to prune further chunks
+// (see RuntimeFilter).
+//
+// For rows that were updated in place, the values visible to the transaction are resolved here (see RowVersions), so
+// that following operators, including TableScans that were placed below the Validate, see these values.
 
 class GetTable : public AbstractReadOnlyOperator {
  public:
@@ -34,6 +43,10 @@ class GetTable : public AbstractReadOnlyOperator {
   const std::vector<ChunkID>& pruned_chunk_ids() const;
   const std::vector<ColumnID>& pruned_column_ids() const;
 
+  // Chunks whose pruning statistics for the column (given as a ColumnID of the output) do not overlap with the values
+  // of the runtime filter are skipped.
+  void add_runtime_filter(const std::shared_ptr<RuntimeFilter>& runtime_filter, const ColumnID column_id);
+
   std::shared_ptr<AbstractOperator> _on_deep_copy(
       const std::shared_ptr<AbstractOperator>& copied_left_input,
       const std::shared_ptr<AbstractOperator>& copied_right_input,
@@ -42,10 +55,14 @@ class GetTable : public AbstractReadOnlyOperator {
 
  protected:
   std::shared_ptr<const Table> _on_execute() override;
+  void _on_cleanup() override;
 
   // name of the table to retrieve
   const std::string _name;
   const std::vector<ChunkID> _pruned_chunk_ids;
   const std::vector<ColumnID> _pruned_column_ids;
+
+  std::vector<std::pair<std::shared_ptr<RuntimeFilter>, ColumnID>> _runtime_filters;
+  ChunkID _runtime_filter_pruned_chunk_count{0};
 };
 }  // namespace opossum
@@ -1,10 +1,13 @@
 #include "import.hpp"
 
+#include <fstream>
+
 #include <boost/algorithm/string.hpp>
 
 #include "hyrise.hpp"
 #include "import_export/binary/binary_parser.hpp"
 #include "import_export/csv/csv_parser.hpp"
+#include "import_export/parquet/parquet_parser.hpp"
 #include "utils/assert.hpp"
 #include "utils/load_table.hpp"
 
@@ -46,6 +49,9 @@ std::shared_ptr<const Table> Import::_on_execute() {
     case FileType::Binary:
       table = BinaryParser::parse(filename);
       break;
+    case FileType::Parquet:
+      table = ParquetParser::parse(filename);
+      break;
     case FileType::Auto:
       Fail("File type should have been determined previously.");
   }
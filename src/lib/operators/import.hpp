@@ -14,7 +14,7 @@ namespace opossum {
 
 /*
  * This operator reads a file, creates a table from that input and adds it to the storage manager.
- * Supported file types are .tbl, .csv and Opossum .bin files.
+ * Supported file types are .tbl, .csv, Opossum .bin, and Apache Parquet files.
  * For .csv files, a CSV config is additionally required, which is commonly located in the <filename>.json file.
  * Documentation of the file formats can be found in BinaryWriter and CsvWriter header files.
  */
@@ -23,7 +23,7 @@ class Import : public AbstractReadOnlyOperator {
   /**
    * @param filename       Path to the input file.
    * @param tablename      Name of the table to store in the StorageManager.
-   * @param chunk_size     Optional. Chunk size. Does not effect binary import.
+   * @param chunk_size     Optional. Chunk size. Does not effect binary and Parquet import.
    * @param file_type      Optional. Type indicating the file format. If not present, it is guessed by the filename.
    * @param csv_meta       Optional. A specific meta config, used instead of filename + '.json'
    */
@@ -7,9 +7,11 @@
 
 #include "concurrency/transaction_context.hpp"
 #include "hyrise.hpp"
+#include "logging/wal_commit_record.hpp"
 #include "resolve_type.hpp"
 #include "storage/abstract_encoded_segment.hpp"
 #include "storage/segment_iterate.hpp"
+#include "storage/table_key_index.hpp"
 #include "storage/value_segment.hpp"
 #include "utils/assert.hpp"
 
@@ -213,6 +215,18 @@ std::shared_ptr<const Table> Insert::_on_execute(std::shared_ptr<TransactionCont
     }
   }
 
+  /**
+   * 3. Add the new rows to the key indexes of the target Table. Until the commit, other transactions find the rows
+   *    in the index, but the Validate operator filters them out. If the transaction is rolled back, the rows stay
+   *    invisible and are removed from the index later.
+   */
+  for (const auto& key_index : _target_table->key_indexes()) {
+    for (const auto& target_chunk_range : _target_chunk_ranges) {
+      key_index->insert(target_chunk_range.chunk_id, target_chunk_range.begin_chunk_offset,
+                        target_chunk_range.end_chunk_offset);
+    }
+  }
+
   return nullptr;
 }
 
@@ -273,6 +287,13 @@ void Insert::_on_rollback_records() {
   }
 }
 
+void Insert::_on_log_records(WalCommitRecordWriter& record_writer) const {
+  for (const auto& target_chunk_range : _target_chunk_ranges) {
+    record_writer.add_insert(_target_table_name, *_target_table, target_chunk_range.chunk_id,
+                             target_chunk_range.begin_chunk_offset, target_chunk_range.end_chunk_offset);
+  }
+}
+
 std::shared_ptr<AbstractOperator> Insert::_on_deep_copy(
     const std::shared_ptr<AbstractOperator>& copied_left_input,
     const std::shared_ptr<AbstractOperator>& copied_right_input,
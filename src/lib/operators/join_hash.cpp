@@ -1,5 +1,7 @@
 #include "join_hash.hpp"
 
+#include <algorithm>
+#include <chrono>
 #include <cmath>
 #include <memory>
 #include <numeric>
@@ -14,10 +16,13 @@
 #include "join_hash/join_hash_steps.hpp"
 #include "join_hash/join_hash_traits.hpp"
 #include "join_helper/join_output_writing.hpp"
+#include "memory/memory_budget_resource.hpp"
+#include "memory/spill_file.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 #include "type_comparison.hpp"
 #include "utils/assert.hpp"
+#include "utils/format_bytes.hpp"
 #include "utils/format_duration.hpp"
 #include "utils/timer.hpp"
 
@@ -220,7 +225,10 @@ std::shared_ptr<const Table> JoinHash::_on_execute() {
   return _impl->_on_execute();
 }
 
-void JoinHash::_on_cleanup() { _impl.reset(); }
+void JoinHash::_on_cleanup() {
+  _impl.reset();
+  runtime_filter = nullptr;
+}
 
 template <typename BuildColumnType, typename ProbeColumnType>
 class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
@@ -261,6 +269,9 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
   // Determine correct type for hashing
   using HashedType = typename JoinHashTraits<BuildColumnType, ProbeColumnType>::HashType;
 
+  // Limits the number of files that are opened at the same time if the join does not fit into its memory budget
+  static constexpr auto MAX_SPILL_RADIX_BITS = size_t{7};
+
   std::shared_ptr<const Table> _on_execute() override {
     /**
      * Keep/Discard NULLs from build and probe columns as follows
@@ -279,6 +290,15 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     const auto keep_nulls_probe_column = _mode == JoinMode::Left || _mode == JoinMode::Right ||
                                          _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse;
 
+    // If the query has a memory budget, the intermediate data structures of the join have to fit into it. Otherwise,
+    // both inputs are spilled to disk and joined partition by partition. The reservation is held until the join is
+    // finished.
+    auto memory_reservation = MemoryReservation{_join_hash.memory_budget_resource()};
+    const auto estimated_memory_consumption = _estimate_memory_consumption();
+    if (!memory_reservation.try_reserve(estimated_memory_consumption)) {
+      return _on_execute_spilling(estimated_memory_consumption, keep_nulls_build_column, keep_nulls_probe_column);
+    }
+
     // Containers used to store histograms for (potentially subsequent) radix partitioning step (in cases
     // _radix_bits > 0). Created during materialization step.
     std::vector<std::vector<size_t>> histograms_build_column;
@@ -303,7 +323,10 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
      * tasks themselves. For example, materialize parallelizes over the input chunks and the following steps over the
      * radix clusters.
      *
-     * Bloom filters can be used to skip rows that will not find a join partner. They are not shown here.
+     * Bloom filters are used to skip rows that will not find a join partner. They are not shown here. The side that
+     * is materialized first (the smaller one) creates a Bloom filter that is used when materializing the other side.
+     * The Bloom filter of the side that is materialized second is used to filter the first side during radix
+     * partitioning or, if partitioning is skipped, when building the hash table.
      *
      *            Build Table                          Probe Table
      *                 |                                    |
@@ -327,6 +350,16 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     auto build_side_bloom_filter = BloomFilter{};
     auto probe_side_bloom_filter = BloomFilter{};
 
+    // The Bloom filter of the side that is materialized second only contains values that passed the first side's
+    // filter. Thus, it is sized for the smaller input.
+    const auto build_side_is_materialized_first = _build_input_table->row_count() < _probe_input_table->row_count();
+    const auto smaller_row_count = std::min(_build_input_table->row_count(), _probe_input_table->row_count());
+    if (build_side_is_materialized_first) {
+      probe_side_bloom_filter.allocate(smaller_row_count);
+    } else {
+      build_side_bloom_filter.allocate(smaller_row_count);
+    }
+
     const auto materialize_build_side = [&](const auto& input_bloom_filter) {
       if (keep_nulls_build_column) {
         materialized_build_column = materialize_input<BuildColumnType, HashedType, true>(
@@ -356,7 +389,7 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     };
 
     Timer timer_materialization;
-    if (_build_input_table->row_count() < _probe_input_table->row_count()) {
+    if (build_side_is_materialized_first) {
       // When materializing the first side (here: the build side), we do not yet have a Bloom filter. To keep the number
       // of code paths low, materialize_*_side always expects a Bloom filter. For the first step, we thus pass in a
       // Bloom filter that returns true for every probe.
@@ -366,8 +399,7 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
       _performance_data.set_step_runtime(OperatorSteps::ProbeSideMaterializing, timer_materialization.lap());
     } else {
       // Here, we first materialize the probe side and use the resulting Bloom filter in the materialization of the
-      // build side. Consequently, the Bloom filter later passed into build() will have no effect as it has already
-      // been used here to filter non-matching values.
+      // build side.
       materialize_probe_side(ALL_TRUE_BLOOM_FILTER);
       _performance_data.set_step_runtime(OperatorSteps::ProbeSideMaterializing, timer_materialization.lap());
       materialize_build_side(probe_side_bloom_filter);
@@ -384,11 +416,15 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     }
 
     /**
-     * 2. Perform radix partitioning for build and probe sides. The Bloom filters are not used in this step. Future work
-     *    could use them on the build side to exclude them for values that are not seen on the probe side. That would
-     *    reduce the size of the intermediary results, but would require an adapted calculation of the output offsets
-     *    within partition_by_radix.
+     * 2. Perform radix partitioning for build and probe sides. The side that was materialized first has not been
+     *    filtered yet. While partitioning it, we skip the values that are not contained in the Bloom filter of the
+     *    other side. The other side has already been filtered during its materialization.
      */
+    const auto& build_side_partitioning_bloom_filter =
+        build_side_is_materialized_first ? probe_side_bloom_filter : ALL_TRUE_BLOOM_FILTER;
+    const auto& probe_side_partitioning_bloom_filter =
+        build_side_is_materialized_first ? ALL_TRUE_BLOOM_FILTER : build_side_bloom_filter;
+
     if (_radix_bits > 0) {
       Timer timer_clustering;
       auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
@@ -397,10 +433,10 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
         // radix partition the build table
         if (keep_nulls_build_column) {
           radix_build_column = partition_by_radix<BuildColumnType, HashedType, true>(
-              materialized_build_column, histograms_build_column, _radix_bits);
+              materialized_build_column, histograms_build_column, _radix_bits, build_side_partitioning_bloom_filter);
         } else {
           radix_build_column = partition_by_radix<BuildColumnType, HashedType, false>(
-              materialized_build_column, histograms_build_column, _radix_bits);
+              materialized_build_column, histograms_build_column, _radix_bits, build_side_partitioning_bloom_filter);
         }
 
         // After the data in materialized_build_column has been partitioned, it is not needed anymore.
@@ -411,10 +447,10 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
         // radix partition the probe column.
         if (keep_nulls_probe_column) {
           radix_probe_column = partition_by_radix<ProbeColumnType, HashedType, true>(
-              materialized_probe_column, histograms_probe_column, _radix_bits);
+              materialized_probe_column, histograms_probe_column, _radix_bits, probe_side_partitioning_bloom_filter);
         } else {
           radix_probe_column = partition_by_radix<ProbeColumnType, HashedType, false>(
-              materialized_probe_column, histograms_probe_column, _radix_bits);
+              materialized_probe_column, histograms_probe_column, _radix_bits, probe_side_partitioning_bloom_filter);
         }
 
         // After the data in materialized_probe_column has been partitioned, it is not needed anymore.
@@ -438,33 +474,26 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
      *    In the case of semi or anti joins, we do not need to track all rows on the hashed side, just one per value.
      *    value. However, if we have secondary predicates, those might fail on that single row. In that case, we DO need
      *    all rows.
-     *    We use the probe side's Bloom filter to exclude values from the hash table that will not be accessed in the
-     *    probe step.
+     *    If the build side has not been filtered yet (i.e., it was materialized first and not partitioned), we use the
+     *    probe side's Bloom filter to exclude values from the hash table that will not be accessed in the probe step.
      */
+    const auto& build_bloom_filter =
+        build_side_is_materialized_first && _radix_bits == 0 ? probe_side_bloom_filter : ALL_TRUE_BLOOM_FILTER;
+
     Timer timer_hash_map_building;
-    if (_secondary_predicates.empty() &&
-        (_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse)) {
-      hash_tables = build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::ExistenceOnly,
-                                                       _radix_bits, probe_side_bloom_filter);
-    } else {
-      hash_tables = build<BuildColumnType, HashedType>(radix_build_column, JoinHashBuildMode::AllPositions, _radix_bits,
-                                                       probe_side_bloom_filter);
-    }
+    hash_tables =
+        build<BuildColumnType, HashedType>(radix_build_column, _build_mode(), _radix_bits, build_bloom_filter);
     _performance_data.set_step_runtime(OperatorSteps::Building, timer_hash_map_building.lap());
 
-    // Store the element counts of the built hash tables. Depending on the Bloom filter, we might have significantly
-    // less values stored than in the initial input table.
-    for (const auto& hash_table : hash_tables) {
-      if (!hash_table) continue;
+    // All uses of the Bloom filters are completed.
+    _performance_data.build_side_bloom_filter_probed_value_count = build_side_bloom_filter.probed_value_count();
+    _performance_data.build_side_bloom_filter_passed_value_count = build_side_bloom_filter.passed_value_count();
+    _performance_data.build_side_bloom_filter_deactivated = build_side_bloom_filter.was_deactivated();
+    _performance_data.probe_side_bloom_filter_probed_value_count = probe_side_bloom_filter.probed_value_count();
+    _performance_data.probe_side_bloom_filter_passed_value_count = probe_side_bloom_filter.passed_value_count();
+    _performance_data.probe_side_bloom_filter_deactivated = probe_side_bloom_filter.was_deactivated();
 
-      _performance_data.hash_tables_distinct_value_count += hash_table->distinct_value_count();
-      const auto position_count = hash_table->position_count();
-      if (position_count) {
-        // Update or set hash_tables_position_count if hash table stores positions.
-        _performance_data.hash_tables_position_count =
-            _performance_data.hash_tables_position_count.value_or(0) + *position_count;
-      }
-    }
+    _record_hash_table_statistics(hash_tables);
 
     /**
      * Short cut for AntiNullAsTrue:
@@ -506,6 +535,189 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
     }
 
     Timer timer_probing;
+    _probe(radix_probe_column, hash_tables, build_side_pos_lists, probe_side_pos_lists);
+    _performance_data.set_step_runtime(OperatorSteps::Probing, timer_probing.lap());
+
+    radix_probe_column.clear();
+    hash_tables.clear();
+
+    /**
+     * 5. Write output Table
+     */
+    return _write_output(build_side_pos_lists, probe_side_pos_lists);
+  }
+
+  /**
+   * Grace hash join that is used if the join does not fit into the memory budget of its query. Instead of being
+   * materialized in memory, both inputs are radix-partitioned into files on disk (see spill_input()). The number of
+   * partitions is chosen so that the data structures for a single partition fit into the available budget. The
+   * partitions are then read back and joined one at a time, using the same build and probe steps as the in-memory
+   * join. Only the resulting position lists of all partitions are kept in memory. Bloom filters are not used, as the
+   * inputs are read only once.
+   */
+  std::shared_ptr<const Table> _on_execute_spilling(const size_t estimated_memory_consumption,
+                                                    const bool keep_nulls_build_column,
+                                                    const bool keep_nulls_probe_column) {
+    const auto& memory_budget_resource = _join_hash.memory_budget_resource();
+    const auto available_bytes = std::max(memory_budget_resource->available_bytes(), size_t{1});
+
+    auto spill_radix_bits = size_t{1};
+    while ((estimated_memory_consumption >> spill_radix_bits) > available_bytes &&
+           spill_radix_bits < MAX_SPILL_RADIX_BITS) {
+      ++spill_radix_bits;
+    }
+    const auto partition_count = size_t{1} << spill_radix_bits;
+
+    const auto create_partition_files = [&]() {
+      auto partition_files = std::vector<std::unique_ptr<SpillFile>>(partition_count);
+      for (auto& partition_file : partition_files) {
+        partition_file = std::make_unique<SpillFile>(memory_budget_resource->spill_directory());
+      }
+      return partition_files;
+    };
+
+    /**
+     * 1. Spill both inputs to disk, partitioned by the hash of their values.
+     */
+    Timer timer_spilling;
+    auto build_partition_files = create_partition_files();
+    const auto build_element_counts =
+        keep_nulls_build_column
+            ? spill_input<BuildColumnType, HashedType, true>(_build_input_table, _column_ids.first,
+                                                             build_partition_files)
+            : spill_input<BuildColumnType, HashedType, false>(_build_input_table, _column_ids.first,
+                                                              build_partition_files);
+    _performance_data.set_step_runtime(OperatorSteps::BuildSideMaterializing, timer_spilling.lap());
+
+    auto probe_partition_files = create_partition_files();
+    const auto probe_element_counts =
+        keep_nulls_probe_column
+            ? spill_input<ProbeColumnType, HashedType, true>(_probe_input_table, _column_ids.second,
+                                                             probe_partition_files)
+            : spill_input<ProbeColumnType, HashedType, false>(_probe_input_table, _column_ids.second,
+                                                              probe_partition_files);
+    _performance_data.set_step_runtime(OperatorSteps::ProbeSideMaterializing, timer_spilling.lap());
+
+    auto spilled_bytes = size_t{0};
+    for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+      spilled_bytes += build_partition_files[partition_idx]->size() + probe_partition_files[partition_idx]->size();
+    }
+    memory_budget_resource->add_spilled_bytes(spilled_bytes);
+    _performance_data.spilled_partition_count = partition_count;
+    _performance_data.spilled_bytes = spilled_bytes;
+    _performance_data.build_side_materialized_value_count =
+        std::accumulate(build_element_counts.begin(), build_element_counts.end(), size_t{0});
+    _performance_data.probe_side_materialized_value_count =
+        std::accumulate(probe_element_counts.begin(), probe_element_counts.end(), size_t{0});
+
+    /**
+     * 2. Build and probe one partition at a time. Inner and semi joins skip partitions without build side values.
+     */
+    auto build_side_pos_lists = std::vector<RowIDPosList>(partition_count);
+    auto probe_side_pos_lists = std::vector<RowIDPosList>(partition_count);
+    const auto skip_empty_build_partitions = _mode == JoinMode::Inner || _mode == JoinMode::Semi;
+
+    auto building_duration = std::chrono::nanoseconds{0};
+    auto probing_duration = std::chrono::nanoseconds{0};
+    for (auto partition_idx = size_t{0}; partition_idx < partition_count; ++partition_idx) {
+      if (build_element_counts[partition_idx] == 0 && skip_empty_build_partitions) continue;
+
+      // A partition cannot be split further, so its share of the estimated memory consumption is reserved even if
+      // that exceeds the budget.
+      auto partition_reservation = MemoryReservation{memory_budget_resource};
+      partition_reservation.reserve(estimated_memory_consumption / partition_count);
+
+      Timer timer_partition;
+      auto radix_build_column =
+          keep_nulls_build_column
+              ? read_spilled_partition<BuildColumnType, true>(*build_partition_files[partition_idx],
+                                                              build_element_counts[partition_idx])
+              : read_spilled_partition<BuildColumnType, false>(*build_partition_files[partition_idx],
+                                                               build_element_counts[partition_idx]);
+      build_partition_files[partition_idx] = nullptr;
+
+      // See the short cut for AntiNullAsTrue in _on_execute().
+      if (_mode == JoinMode::AntiNullAsTrue) {
+        const auto& null_values = radix_build_column.front().null_values;
+        if (std::find(null_values.begin(), null_values.end(), true) != null_values.end()) {
+          Timer timer_output_writing;
+          const auto result = _join_hash._build_output_table({});
+          _performance_data.set_step_runtime(OperatorSteps::OutputWriting, timer_output_writing.lap());
+          return result;
+        }
+      }
+
+      const auto hash_tables = build<BuildColumnType, HashedType>(radix_build_column, _build_mode(), 0,
+                                                                  ALL_TRUE_BLOOM_FILTER);
+      _record_hash_table_statistics(hash_tables);
+      radix_build_column.clear();
+      building_duration += timer_partition.lap();
+
+      const auto radix_probe_column =
+          keep_nulls_probe_column
+              ? read_spilled_partition<ProbeColumnType, true>(*probe_partition_files[partition_idx],
+                                                              probe_element_counts[partition_idx])
+              : read_spilled_partition<ProbeColumnType, false>(*probe_partition_files[partition_idx],
+                                                               probe_element_counts[partition_idx]);
+      probe_partition_files[partition_idx] = nullptr;
+
+      auto partition_build_side_pos_lists = std::vector<RowIDPosList>(1);
+      auto partition_probe_side_pos_lists = std::vector<RowIDPosList>(1);
+      _probe(radix_probe_column, hash_tables, partition_build_side_pos_lists, partition_probe_side_pos_lists);
+      build_side_pos_lists[partition_idx] = std::move(partition_build_side_pos_lists.front());
+      probe_side_pos_lists[partition_idx] = std::move(partition_probe_side_pos_lists.front());
+      probing_duration += timer_partition.lap();
+    }
+    _performance_data.set_step_runtime(OperatorSteps::Building, building_duration);
+    _performance_data.set_step_runtime(OperatorSteps::Probing, probing_duration);
+
+    /**
+     * 3. Write output Table
+     */
+    return _write_output(build_side_pos_lists, probe_side_pos_lists);
+  }
+
+  // Estimates the memory used by the in-memory join for the materialized and radix-partitioned inputs, which are both
+  // held during partitioning, and for the hash tables (sized as in calculate_radix_bits, plus the stored RowIDs).
+  // Values of long strings are not accounted for.
+  size_t _estimate_memory_consumption() const {
+    constexpr auto HASH_TABLE_ENTRY_SIZE =
+        static_cast<size_t>(static_cast<double>(sizeof(HashedType) + sizeof(uint32_t) + 1) / 0.8) + sizeof(RowID);
+    constexpr auto BUILD_ELEMENT_SIZE = 2 * sizeof(PartitionedElement<BuildColumnType>) + HASH_TABLE_ENTRY_SIZE;
+    constexpr auto PROBE_ELEMENT_SIZE = 2 * sizeof(PartitionedElement<ProbeColumnType>);
+
+    return _build_input_table->row_count() * BUILD_ELEMENT_SIZE + _probe_input_table->row_count() * PROBE_ELEMENT_SIZE;
+  }
+
+  // In the case of semi or anti joins, we do not need to track all rows on the hashed side, just one per value.
+  // However, if we have secondary predicates, those might fail on that single row. In that case, we DO need all rows.
+  JoinHashBuildMode _build_mode() const {
+    if (_secondary_predicates.empty() &&
+        (_mode == JoinMode::Semi || _mode == JoinMode::AntiNullAsTrue || _mode == JoinMode::AntiNullAsFalse)) {
+      return JoinHashBuildMode::ExistenceOnly;
+    }
+    return JoinHashBuildMode::AllPositions;
+  }
+
+  // Store the element counts of the built hash tables. Depending on the Bloom filter, we might have significantly
+  // less values stored than in the initial input table.
+  void _record_hash_table_statistics(const std::vector<std::optional<PosHashTable<HashedType>>>& hash_tables) {
+    for (const auto& hash_table : hash_tables) {
+      if (!hash_table) continue;
+
+      _performance_data.hash_tables_distinct_value_count += hash_table->distinct_value_count();
+      const auto position_count = hash_table->position_count();
+      if (position_count) {
+        // Update or set hash_tables_position_count if hash table stores positions.
+        _performance_data.hash_tables_position_count =
+            _performance_data.hash_tables_position_count.value_or(0) + *position_count;
+      }
+    }
+  }
+
+  void _probe(const RadixContainer<ProbeColumnType>& radix_probe_column,
+              const std::vector<std::optional<PosHashTable<HashedType>>>& hash_tables,
+              std::vector<RowIDPosList>& build_side_pos_lists, std::vector<RowIDPosList>& probe_side_pos_lists) const {
     switch (_mode) {
       case JoinMode::Inner:
         probe<ProbeColumnType, HashedType, false>(radix_probe_column, hash_tables, build_side_pos_lists,
@@ -541,15 +753,10 @@ class JoinHash::JoinHashImpl : public AbstractReadOnlyOperatorImpl {
       default:
         Fail("JoinMode not supported by JoinHash");
     }
-    _performance_data.set_step_runtime(OperatorSteps::Probing, timer_probing.lap());
-
-    radix_probe_column.clear();
-    hash_tables.clear();
-
-    /**
-     * 5. Write output Table
-     */
+  }
 
+  std::shared_ptr<const Table> _write_output(std::vector<RowIDPosList>& build_side_pos_lists,
+                                             std::vector<RowIDPosList>& probe_side_pos_lists) {
     /**
      * After the probe step build_side_pos_lists and probe_side_pos_lists contain all pairs of joined rows grouped by
      * partition. Let p be a partition index and r a row index. The value of build_side_pos_lists[p][r] will match
@@ -582,6 +789,25 @@ void JoinHash::PerformanceData::output_to_stream(std::ostream& stream, Descripti
   const auto* const separator = description_mode == DescriptionMode::SingleLine ? " " : "\n";
   stream << separator << "Radix bits: " << radix_bits << ".";
   stream << separator << "Build side is " << (left_input_is_build_side ? "left." : "right.");
+
+  const auto output_bloom_filter_statistics = [&](const auto& side, const size_t probed_value_count,
+                                                  const size_t passed_value_count, const bool deactivated) {
+    if (probed_value_count == 0) return;
+
+    const auto hit_rate = std::lround(100.0 * static_cast<double>(passed_value_count) /
+                                      static_cast<double>(probed_value_count));
+    stream << separator << "Bloom filter of " << side << " side passed " << passed_value_count << " of "
+           << probed_value_count << " probed values (" << hit_rate << "%)" << (deactivated ? ", deactivated." : ".");
+  };
+  output_bloom_filter_statistics("build", build_side_bloom_filter_probed_value_count,
+                                 build_side_bloom_filter_passed_value_count, build_side_bloom_filter_deactivated);
+  output_bloom_filter_statistics("probe", probe_side_bloom_filter_probed_value_count,
+                                 probe_side_bloom_filter_passed_value_count, probe_side_bloom_filter_deactivated);
+
+  if (spilled_partition_count > 0) {
+    stream << separator << "Spilled " << format_bytes(spilled_bytes) << " to " << spilled_partition_count
+           << " partitions.";
+  }
 }
 
 }  // namespace opossum
@@ -8,6 +8,8 @@
 
 namespace opossum {
 
+class RuntimeFilter;
+
 /**
  * This operator joins two tables using one column of each table.
  * The output is a new table with referenced columns for all columns of the two inputs and filtered pos_lists.
@@ -37,6 +39,10 @@ class JoinHash : public AbstractJoinOperator {
   template <typename T>
   static size_t calculate_radix_bits(const size_t build_side_size, const size_t probe_side_size, const JoinMode mode);
 
+  // Filter on the values of the build side that is applied by the operators reading the probe side. Set by
+  // push_down_runtime_filters() before the join's inputs are executed. See RuntimeFilter.
+  std::shared_ptr<RuntimeFilter> runtime_filter;
+
   enum class OperatorSteps : uint8_t {
     BuildSideMaterializing,
     ProbeSideMaterializing,
@@ -65,6 +71,21 @@ class JoinHash : public AbstractJoinOperator {
     // build_side_position_count (see order of materialization in hash_join.cpp).
     size_t hash_tables_distinct_value_count{0};
     std::optional<size_t> hash_tables_position_count;
+
+    // The Bloom filter of each side is probed with values of the other side (see JoinHashImpl::_on_execute). The hit
+    // rate is the share of probed values that passed the filter. A filter is deactivated if its hit rate is too high
+    // to pay off.
+    size_t build_side_bloom_filter_probed_value_count{0};
+    size_t build_side_bloom_filter_passed_value_count{0};
+    bool build_side_bloom_filter_deactivated{false};
+    size_t probe_side_bloom_filter_probed_value_count{0};
+    size_t probe_side_bloom_filter_passed_value_count{0};
+    bool probe_side_bloom_filter_deactivated{false};
+
+    // If the join did not fit into the memory budget of its query, both inputs were written to this number of
+    // partitions on disk, which were then joined one at a time (see JoinHashImpl::_on_execute_spilling).
+    size_t spilled_partition_count{0};
+    size_t spilled_bytes{0};
   };
 
  protected:
@@ -0,0 +1,94 @@
+#include "bloom_filter.hpp"
+
+#include <algorithm>
+#include <memory>
+
+#include "hyrise.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+// Number of blocks (i.e., 1 MiB) that are merged by a single job
+constexpr auto MERGE_BLOCKS_PER_JOB = size_t{16'384};
+
+}  // namespace
+
+namespace opossum {
+
+BloomFilter::BloomFilter(const size_t expected_value_count) { allocate(expected_value_count); }
+
+void BloomFilter::allocate(const size_t expected_value_count) {
+  Assert(_blocks.empty(), "BloomFilter has already been allocated");
+
+  const auto required_block_count =
+      std::max(size_t{1}, (expected_value_count * BITS_PER_VALUE + BLOCK_SIZE - 1) / BLOCK_SIZE);
+
+  // The block count is a power of two, so that blocks can be selected by masking the hash.
+  auto block_count = size_t{1};
+  while (block_count < required_block_count && block_count < MAX_BLOCK_COUNT) {
+    block_count <<= 1u;
+  }
+
+  _blocks.resize(block_count);
+  _block_index_mask = block_count - 1;
+}
+
+void BloomFilter::allocate_like(const BloomFilter& other) {
+  Assert(_blocks.empty(), "BloomFilter has already been allocated");
+  _blocks.resize(other._blocks.size());
+  _block_index_mask = other._block_index_mask;
+}
+
+void BloomFilter::merge(const std::vector<BloomFilter>& partial_filters) {
+  const auto block_count = _blocks.size();
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto begin_block_idx = size_t{0}; begin_block_idx < block_count; begin_block_idx += MERGE_BLOCKS_PER_JOB) {
+    const auto end_block_idx = std::min(begin_block_idx + MERGE_BLOCKS_PER_JOB, block_count);
+
+    jobs.emplace_back(std::make_shared<JobTask>([&, begin_block_idx, end_block_idx]() {
+      for (const auto& partial_filter : partial_filters) {
+        // Partial filters that were never used are not allocated.
+        if (!partial_filter.is_allocated()) continue;
+        DebugAssert(partial_filter._blocks.size() == block_count, "Partial filter has a different size");
+
+        for (auto block_idx = begin_block_idx; block_idx < end_block_idx; ++block_idx) {
+          auto& block = _blocks[block_idx];
+          const auto& partial_block = partial_filter._blocks[block_idx];
+          for (auto word_idx = size_t{0}; word_idx < block.words.size(); ++word_idx) {
+            block.words[word_idx] |= partial_block.words[word_idx];
+          }
+        }
+      }
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+}
+
+bool BloomFilter::is_allocated() const { return !_blocks.empty(); }
+
+bool BloomFilter::is_active() const { return is_allocated() && !_deactivated.load(std::memory_order_relaxed); }
+
+void BloomFilter::record_probes(const size_t probed_value_count, const size_t passed_value_count) const {
+  const auto total_probed_value_count =
+      _probed_value_count.fetch_add(probed_value_count, std::memory_order_relaxed) + probed_value_count;
+  const auto total_passed_value_count =
+      _passed_value_count.fetch_add(passed_value_count, std::memory_order_relaxed) + passed_value_count;
+
+  if (total_probed_value_count >= MIN_PROBED_VALUE_COUNT &&
+      static_cast<double>(total_passed_value_count) > MAX_PASS_RATE * static_cast<double>(total_probed_value_count)) {
+    _deactivated.store(true, std::memory_order_relaxed);
+  }
+}
+
+size_t BloomFilter::probed_value_count() const { return _probed_value_count.load(); }
+
+size_t BloomFilter::passed_value_count() const { return _passed_value_count.load(); }
+
+bool BloomFilter::was_deactivated() const { return _deactivated.load(); }
+
+size_t BloomFilter::size() const { return _blocks.size() * BLOCK_SIZE; }
+
+}  // namespace opossum
@@ -0,0 +1,128 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace opossum {
+
+/**
+ * Blocked Bloom filter used by the hash join to skip values that will not find a join partner.
+ *
+ * The filter consists of blocks of 512 bits, i.e., one cache line. A value is mapped to a single block, in which it
+ * sets one bit in each of the block's eight 64-bit words (k=8). Thus, inserting or probing a value accesses only a
+ * single cache line. The bits within the words are derived from the hash using multiplicative hashing with different
+ * salts (similar to the split block Bloom filters used by Impala and Parquet). The loops over the words of a block
+ * have no dependencies between their iterations and are vectorized by the compiler, e.g., into a single AVX-512 or two
+ * AVX2 operations per probe.
+ *
+ * The filter is sized according to the expected number of distinct values (BITS_PER_VALUE bits per value). A
+ * default-constructed filter has no blocks and contains every value, i.e., it can be passed where no filter exists.
+ *
+ * Inserting into a filter is not thread-safe. Jobs that build a filter concurrently insert into partial filters of the
+ * same size, which are then merged into the filter in parallel (see merge()).
+ *
+ * Probing a filter only pays off if a significant share of the values is filtered. Users of the filter report the
+ * outcome of their probes via record_probes(). If, after MIN_PROBED_VALUE_COUNT probes, more than MAX_PASS_RATE of the
+ * probed values passed the filter, it is deactivated and should no longer be probed (see is_active()).
+ */
+class BloomFilter {
+ public:
+  static constexpr auto BITS_PER_VALUE = size_t{16};
+  static constexpr auto BLOCK_SIZE = size_t{512};
+  // Limits the filter to 8 MiB, which is reached for around four million distinct values.
+  static constexpr auto MAX_BLOCK_COUNT = size_t{1} << 17;
+
+  static constexpr auto MIN_PROBED_VALUE_COUNT = size_t{10'000};
+  static constexpr auto MAX_PASS_RATE = 0.9;
+
+  struct alignas(64) Block {
+    std::array<uint64_t, BLOCK_SIZE / 64> words;
+  };
+
+  // Creates a filter that contains every value and is not active.
+  BloomFilter() = default;
+
+  explicit BloomFilter(size_t expected_value_count);
+
+  BloomFilter(const BloomFilter&) = delete;
+  BloomFilter& operator=(const BloomFilter&) = delete;
+
+  // Allocates an empty filter sized for expected_value_count values. Must only be called on a default-constructed
+  // filter.
+  void allocate(size_t expected_value_count);
+
+  // Allocates an empty filter of the same size as other.
+  void allocate_like(const BloomFilter& other);
+
+  void insert(const size_t hash) {
+    auto& block = _blocks[_block_index(hash)];
+    const auto mask = _block_mask(hash);
+    for (auto word_idx = size_t{0}; word_idx < mask.words.size(); ++word_idx) {
+      block.words[word_idx] |= mask.words[word_idx];
+    }
+  }
+
+  bool contains(const size_t hash) const {
+    if (_blocks.empty()) return true;
+
+    const auto& block = _blocks[_block_index(hash)];
+    const auto mask = _block_mask(hash);
+    auto missing_bits = uint64_t{0};
+    for (auto word_idx = size_t{0}; word_idx < mask.words.size(); ++word_idx) {
+      missing_bits |= mask.words[word_idx] & ~block.words[word_idx];
+    }
+    return missing_bits == 0;
+  }
+
+  // ORs the given partial filters, which have to be of the same size as this filter, into this filter. The blocks are
+  // split into ranges that are merged in parallel.
+  void merge(const std::vector<BloomFilter>& partial_filters);
+
+  bool is_allocated() const;
+
+  // Returns whether the filter should be probed, i.e., whether it is allocated and has not been deactivated because of
+  // a poor selectivity.
+  bool is_active() const;
+
+  // Reports that probed_value_count values have been probed, of which passed_value_count passed the filter.
+  // Deactivates the filter if too many of the probed values passed it. Thread-safe.
+  void record_probes(size_t probed_value_count, size_t passed_value_count) const;
+
+  size_t probed_value_count() const;
+  size_t passed_value_count() const;
+  bool was_deactivated() const;
+
+  // Size of the filter in bits
+  size_t size() const;
+
+ protected:
+  size_t _block_index(const size_t hash) const {
+    // std::hash is the identity function for integers. Thus, the hash is mixed before its bits are used.
+    return static_cast<size_t>((static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull) >> 32u) & _block_index_mask;
+  }
+
+  static Block _block_mask(const size_t hash) {
+    static constexpr auto SALTS = std::array<uint32_t, BLOCK_SIZE / 64>{
+        0x47b6137bU, 0x44974d91U, 0x8824ad5bU, 0xa2b7289dU, 0x705495c7U, 0x2df1424bU, 0x9efc4947U, 0x5c6bfb31U};
+
+    const auto key = static_cast<uint32_t>(static_cast<uint64_t>(hash) * 0x9E3779B97F4A7C15ull);
+    auto mask = Block{};
+    for (auto word_idx = size_t{0}; word_idx < SALTS.size(); ++word_idx) {
+      // The upper six bits of the product select one of the 64 bits of the word.
+      mask.words[word_idx] = uint64_t{1} << (static_cast<uint32_t>(key * SALTS[word_idx]) >> 26u);
+    }
+    return mask;
+  }
+
+  std::vector<Block> _blocks;
+  size_t _block_index_mask{0};
+
+  mutable std::atomic<size_t> _probed_value_count{0};
+  mutable std::atomic<size_t> _passed_value_count{0};
+  mutable std::atomic<bool> _deactivated{false};
+};
+
+}  // namespace opossum
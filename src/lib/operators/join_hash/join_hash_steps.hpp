@@ -1,20 +1,25 @@
 #pragma once
 
+#include <atomic>
+#include <thread>
+
 #include <boost/container/pmr/monotonic_buffer_resource.hpp>
 #include <boost/container/pmr/unsynchronized_pool_resource.hpp>
 #include <boost/container/small_vector.hpp>
-#include <boost/dynamic_bitset.hpp>
 #include <boost/lexical_cast.hpp>
 #include <uninitialized_vector.hpp>
 
 #include "bytell_hash_map.hpp"
 #include "hyrise.hpp"
+#include "memory/spill_file.hpp"
 #include "operators/join_hash.hpp"
+#include "operators/join_hash/bloom_filter.hpp"
 #include "operators/multi_predicate_join/multi_predicate_join_evaluator.hpp"
 #include "resolve_type.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 #include "storage/create_iterable_from_segment.hpp"
+#include "storage/numa_placement.hpp"
 #include "storage/segment_iterate.hpp"
 #include "type_comparison.hpp"
 
@@ -222,42 +227,108 @@ class PosHashTable {
   std::optional<UnifiedPosList> _unified_pos_list{};
 };
 
-// The Bloom filter (with k=1) is used during the materialization and build phases. It contains `true` for each
-// `hash_function(value) % BLOOM_FILTER_SIZE`. Much of how the Bloom filter is used in the hash join could be improved:
-// (1) Dynamically check whether Bloom filters are worth the memory and computational costs. This could be based on the
-//     input table sizes, the expected cardinalities, the hardware characteristics, or other factors.
-// (2) Choosing an appropriate filter size. 2^20 was experimentally found to be good for TPC-H SF 10, but is certainly
-//     not optimal in every situation.
-// (3) Evaluate whether using multiple hash functions (k>1) brings any improvement. In a first experiment, however, we
-//     saw no benefits for single-threaded TPC-H SF 10.
-// (4) Use the probe side Bloom filter when partitioning the build side. By doing that, we reduce the size of the
-//     intermediary results. When a Bloom filter-supported partitioning has been done (i.e., partitioning has not
-//     been skipped), we do not need to use a Bloom filter in the build phase anymore.
-// Some of these points could be addressed with relatively low effort and should bring additional, significant benefits.
-// We did not yet work on this because the Bloom filter was a byproduct of a research project and we have not had the
-// resources to optimize it at the time.
-static constexpr auto BLOOM_FILTER_SIZE = 1 << 20;
-static constexpr auto BLOOM_FILTER_MASK = BLOOM_FILTER_SIZE - 1;
-
-// Using dynamic_bitset because, different from vector<bool>, it has an efficient operator| implementation, which is
-// needed for merging partial Bloom filters created by different threads. Note that the dynamic_bitset(n, value)
-// constructor does not do what you would expect it to, so try to avoid it.
-using BloomFilter = boost::dynamic_bitset<>;
-
-// ALL_TRUE_BLOOM_FILTER is initialized by creating a BloomFilter with every value being false and using bitwise
-// negation (~x). As the negation is surprisingly expensive, we create a static empty Bloom filter and reference
-// it where needed. Having a Bloom filter that always returns true avoids a branch in the hot loop.
-static const auto ALL_TRUE_BLOOM_FILTER = ~BloomFilter(BLOOM_FILTER_SIZE);
+// A Bloom filter is created for each side during the materialization. The filter of the side that is materialized
+// first is used to skip values while materializing the other side. The filter of the side that is materialized second
+// is used to skip values of the first side while radix partitioning it or, if partitioning is skipped, while building
+// the hash table (see JoinHash::JoinHashImpl::_on_execute). A default-constructed BloomFilter contains every value and
+// is passed where no filter should be applied.
+static const auto ALL_TRUE_BLOOM_FILTER = BloomFilter{};
+
+// Number of probes after which a job reports its probe statistics to the Bloom filter and checks whether the filter
+// has been deactivated.
+static constexpr auto BLOOM_FILTER_STATISTICS_INTERVAL = size_t{4'096};
+
+// Probes a Bloom filter and tracks the outcome. Each job uses its own prober and reports the statistics to the filter
+// in intervals, so that a filter with a poor selectivity is deactivated early (see BloomFilter).
+class BloomFilterProber {
+ public:
+  explicit BloomFilterProber(const BloomFilter& bloom_filter)
+      : _bloom_filter(bloom_filter), _is_active(bloom_filter.is_active()) {}
+
+  ~BloomFilterProber() {
+    if (_probed_value_count > 0) _bloom_filter.record_probes(_probed_value_count, _passed_value_count);
+  }
+
+  BloomFilterProber(const BloomFilterProber&) = delete;
+  BloomFilterProber& operator=(const BloomFilterProber&) = delete;
+
+  bool is_active() const { return _is_active; }
+
+  // Returns whether the value with the given hash might have a join partner. Once the filter is deactivated, all
+  // values pass without being probed.
+  bool passes(const Hash hash) {
+    if (!_is_active) return true;
+
+    const auto passed = _bloom_filter.contains(hash);
+    ++_probed_value_count;
+    _passed_value_count += passed;
+
+    if (_probed_value_count == BLOOM_FILTER_STATISTICS_INTERVAL) {
+      _bloom_filter.record_probes(_probed_value_count, _passed_value_count);
+      _probed_value_count = 0;
+      _passed_value_count = 0;
+      _is_active = _bloom_filter.is_active();
+    }
+
+    return passed;
+  }
+
+ private:
+  const BloomFilter& _bloom_filter;
+  bool _is_active;
+  size_t _probed_value_count{0};
+  size_t _passed_value_count{0};
+};
+
+// Hands out partial Bloom filters to concurrently running jobs, so that they can insert values without
+// synchronization. A job claims a partial filter for the duration of its execution. As at most as many jobs run at the
+// same time as there are workers (plus the thread that schedules them), a claimed filter is released quickly if all
+// filters are taken. Claiming is lock-free.
+//
+// Each partial filter has the size of the output filter, which is at most 8 MiB (see BloomFilter::MAX_BLOCK_COUNT).
+// With one partial filter per worker plus one, building a filter thus temporarily takes up to (cpus + 1) * 8 MiB on
+// top of the output filter. Filters are only allocated once they are claimed, so fewer are allocated for small inputs
+// with few chunks.
+class PartialBloomFilters {
+ public:
+  PartialBloomFilters(const BloomFilter& output_bloom_filter, const size_t filter_count)
+      : _output_bloom_filter(output_bloom_filter), _filters(filter_count), _claimed(filter_count) {}
+
+  // Returns the index of the claimed filter. Partial filters are allocated when they are claimed for the first time.
+  size_t claim() {
+    while (true) {
+      for (auto filter_idx = size_t{0}; filter_idx < _claimed.size(); ++filter_idx) {
+        auto expected = false;
+        if (_claimed[filter_idx].compare_exchange_strong(expected, true)) {
+          if (!_filters[filter_idx].is_allocated()) _filters[filter_idx].allocate_like(_output_bloom_filter);
+          return filter_idx;
+        }
+      }
+      std::this_thread::yield();
+    }
+  }
+
+  BloomFilter& get(const size_t filter_idx) { return _filters[filter_idx]; }
+
+  void release(const size_t filter_idx) { _claimed[filter_idx] = false; }
+
+  const std::vector<BloomFilter>& filters() const { return _filters; }
+
+ private:
+  const BloomFilter& _output_bloom_filter;
+  std::vector<BloomFilter> _filters;
+  std::vector<std::atomic<bool>> _claimed;
+};
 
 // @param in_table             Table to materialize
 // @param column_id            Column within that table to materialize
 // @param histograms           Out: If radix_bits > 0, contains one histogram per chunk where each histogram contains
 //                             1 << radix_bits slots
 // @param radix_bits           Number of radix_bits, needed only for histogram calculation
-// @param output_bloom_filter  Out: A filled BloomFilter where `value & BLOOM_FILTER_MASK == true` for each value
-//                             encountered in the input column
-// @param input_bloom_filter   Optional: Materialization is skipped for each value where the corresponding slot in the
-//                             Bloom filter is false
+// @param output_bloom_filter  Out: A filled BloomFilter that contains each value encountered in the input column. If
+//                             it has not been allocated yet, it is sized for the row count of in_table.
+// @param input_bloom_filter   Optional: Materialization is skipped for each value that is not contained in the Bloom
+//                             filter (unless NULL values are kept)
 template <typename T, typename HashedType, bool keep_null_values>
 RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table, const ColumnID column_id,
                                     std::vector<std::vector<size_t>>& histograms, const size_t radix_bits,
@@ -278,11 +349,15 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
   const auto pass = size_t{0};
   const auto radix_mask = static_cast<size_t>(pow(2, radix_bits * (pass + 1)) - 1);
 
-  Assert(output_bloom_filter.empty(), "output_bloom_filter should be empty");
-  output_bloom_filter.resize(BLOOM_FILTER_SIZE);
-  std::mutex output_bloom_filter_mutex;
+  if (!output_bloom_filter.is_allocated()) {
+    output_bloom_filter.allocate(in_table->row_count());
+  }
 
-  Assert(input_bloom_filter.size() == BLOOM_FILTER_SIZE, "Invalid input_bloom_filter");
+  // When running multi-threaded, the jobs insert into partial Bloom filters, which are merged afterwards.
+  auto partial_bloom_filters = std::optional<PartialBloomFilters>{};
+  if (Hyrise::get().is_multi_threaded()) {
+    partial_bloom_filters.emplace(output_bloom_filter, Hyrise::get().topology.num_cpus() + 1);
+  }
 
   // Create histograms per chunk
   histograms.resize(chunk_count);
@@ -296,16 +371,20 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
     const auto num_rows = chunk_in->size();
 
     const auto materialize = [&, chunk_in, chunk_id, num_rows]() {
-      auto local_output_bloom_filter = BloomFilter{};
+      // Skip chunks that were physically deleted
+      if (!chunk_in) return;
+
+      auto partial_bloom_filter_idx = std::optional<size_t>{};
       std::reference_wrapper<BloomFilter> used_output_bloom_filter = output_bloom_filter;
-      if (Hyrise::get().is_multi_threaded()) {
-        // We cannot write to BloomFilter concurrently, so we build a local one first.
-        local_output_bloom_filter = BloomFilter(BLOOM_FILTER_SIZE, false);
-        used_output_bloom_filter = local_output_bloom_filter;
+      if (partial_bloom_filters) {
+        partial_bloom_filter_idx = partial_bloom_filters->claim();
+        used_output_bloom_filter = partial_bloom_filters->get(*partial_bloom_filter_idx);
       }
 
-      // Skip chunks that were physically deleted
-      if (!chunk_in) return;
+      // NULL values are kept independently of whether they find a join partner. Thus, if they are kept, the Bloom
+      // filter cannot be used to skip values.
+      auto input_bloom_filter_prober =
+          BloomFilterProber{keep_null_values ? ALL_TRUE_BLOOM_FILTER : input_bloom_filter};
 
       auto& elements = radix_container[chunk_id].elements;
       auto& null_values = radix_container[chunk_id].null_values;
@@ -346,15 +425,9 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
             // double. See #1550 for details.
             const Hash hashed_value = hash_function(static_cast<HashedType>(value.value()));
 
-            auto skip = false;
-            if (!value.is_null() && !input_bloom_filter[hashed_value & BLOOM_FILTER_MASK] && !keep_null_values) {
-              // Value in not present in input bloom filter and can be skipped
-              skip = true;
-            }
-
-            if (!skip) {
-              // Fill the corresponding slot in the bloom filter
-              used_output_bloom_filter.get()[hashed_value & BLOOM_FILTER_MASK] = true;
+            // Values that are not present in the input Bloom filter can be skipped
+            if (value.is_null() || input_bloom_filter_prober.passes(hashed_value)) {
+              used_output_bloom_filter.get().insert(hashed_value);
 
               /*
               For ReferenceSegments we do not use the RowIDs from the referenced tables.
@@ -399,20 +472,26 @@ RadixContainer<T> materialize_input(const std::shared_ptr<const Table>& in_table
 
       histograms[chunk_id] = std::move(histogram);
 
-      if (Hyrise::get().is_multi_threaded()) {
-        // Merge the local_output_bloom_filter into output_bloom_filter
-        std::lock_guard<std::mutex> lock{output_bloom_filter_mutex};
-        output_bloom_filter |= local_output_bloom_filter;
+      if (partial_bloom_filter_idx) {
+        partial_bloom_filters->release(*partial_bloom_filter_idx);
       }
     };
     if (JoinHash::JOB_SPAWN_THRESHOLD > num_rows) {
       materialize();
     } else {
-      jobs.emplace_back(std::make_shared<JobTask>(materialize));
+      auto job_task = std::make_shared<JobTask>(materialize);
+      // Materialize the chunk on the NUMA node that holds its data (see place_chunks_on_numa_nodes). As the elements
+      // are first touched by this job, the operating system will usually allocate them on the same node.
+      job_task->set_preferred_node_id(preferred_numa_node_id(*in_table, chunk_id));
+      jobs.emplace_back(job_task);
     }
   }
   Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 
+  if (partial_bloom_filters) {
+    output_bloom_filter.merge(partial_bloom_filters->filters());
+  }
+
   return radix_container;
 }
 
@@ -424,13 +503,13 @@ template <typename BuildColumnType, typename HashedType>
 std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<BuildColumnType>& radix_container,
                                                            const JoinHashBuildMode mode, const size_t radix_bits,
                                                            const BloomFilter& input_bloom_filter) {
-  Assert(input_bloom_filter.size() == BLOOM_FILTER_SIZE, "invalid input_bloom_filter");
-
   if (radix_container.empty()) return {};
 
   /*
   NUMA notes:
-  The hash tables for each partition P should also reside on the same node as the build and probe partitions.
+  The hash tables for each partition P should also reside on the same node as the build and probe partitions. The
+  input chunks are materialized on their nodes (see materialize_input), but after radix partitioning, a partition
+  contains values from all nodes. Thus, the build and probe jobs currently have no preferred node.
   */
   std::vector<std::optional<PosHashTable<HashedType>>> hash_tables;
 
@@ -465,11 +544,13 @@ std::vector<std::optional<PosHashTable<HashedType>>> build(const RadixContainer<
       if (radix_bits > 0) {
         hash_table = PosHashTable<HashedType>(mode, elements_count);
       }
+
+      auto input_bloom_filter_prober = BloomFilterProber{input_bloom_filter};
       for (const auto& element : elements) {
         DebugAssert(!(element.row_id == NULL_ROW_ID), "No NULL_ROW_IDs should make it to this point");
 
-        const Hash hashed_value = hash_function(static_cast<HashedType>(element.value));
-        if (!input_bloom_filter[hashed_value & BLOOM_FILTER_MASK]) {
+        if (input_bloom_filter_prober.is_active() &&
+            !input_bloom_filter_prober.passes(hash_function(static_cast<HashedType>(element.value)))) {
           continue;
         }
 
@@ -526,6 +607,44 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
   Assert(histograms.size() == input_partition_count, "Expected one histogram per input partition");
   Assert(histograms[0].size() == output_partition_count, "Expected one histogram bucket per output partition");
 
+  std::vector<std::shared_ptr<AbstractTask>> jobs;
+  jobs.reserve(input_partition_count);
+
+  // Values that are not contained in the Bloom filter are dropped. As this changes the number of values per output
+  // partition, the histograms are recomputed while probing the filter. As in materialize_input(), the filter is not
+  // used if NULL values are kept.
+  auto passes_bloom_filter = std::vector<std::vector<bool>>{};
+  if (!keep_null_values && input_bloom_filter.is_active()) {
+    passes_bloom_filter.resize(input_partition_count);
+    for (auto input_partition_idx = size_t{0}; input_partition_idx < input_partition_count; ++input_partition_idx) {
+      const auto& elements = radix_container[input_partition_idx].elements;
+      const auto elements_count = elements.size();
+
+      const auto probe_bloom_filter = [&, input_partition_idx, elements_count]() {
+        auto input_bloom_filter_prober = BloomFilterProber{input_bloom_filter};
+        auto& histogram = histograms[input_partition_idx];
+        std::fill(histogram.begin(), histogram.end(), size_t{0});
+
+        auto& passes = passes_bloom_filter[input_partition_idx];
+        passes.resize(elements_count);
+        for (auto input_idx = size_t{0}; input_idx < elements_count; ++input_idx) {
+          const Hash hashed_value = hash_function(static_cast<HashedType>(elements[input_idx].value));
+          passes[input_idx] = input_bloom_filter_prober.passes(hashed_value);
+          if (passes[input_idx]) {
+            ++histogram[hashed_value & radix_mask];
+          }
+        }
+      };
+      if (JoinHash::JOB_SPAWN_THRESHOLD > elements_count) {
+        probe_bloom_filter();
+      } else {
+        jobs.emplace_back(std::make_shared<JobTask>(probe_bloom_filter));
+      }
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+    jobs.clear();
+  }
+
   // Writing to std::vector<bool> is not thread-safe if the same byte is being written to. For now, we temporarily
   // use a std::vector<char> and compress it into an std::vector<bool> later.
   auto null_values_as_char = std::vector<std::vector<char>>(output_partition_count);
@@ -548,9 +667,6 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
     }
   }
 
-  std::vector<std::shared_ptr<AbstractTask>> jobs;
-  jobs.reserve(input_partition_count);
-
   for (auto input_partition_idx = ChunkID{0}; input_partition_idx < input_partition_count; ++input_partition_idx) {
     const auto& input_partition = radix_container[input_partition_idx];
     const auto& elements = input_partition.elements;
@@ -558,6 +674,8 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
 
     const auto perform_partition = [&, input_partition_idx, elements_count]() {
       for (auto input_idx = size_t{0}; input_idx < elements_count; ++input_idx) {
+        if (!passes_bloom_filter.empty() && !passes_bloom_filter[input_partition_idx][input_idx]) continue;
+
         const auto& element = elements[input_idx];
 
         if constexpr (!keep_null_values) {
@@ -610,6 +728,90 @@ RadixContainer<T> partition_by_radix(const RadixContainer<T>& radix_container,
   return output;
 }
 
+// Used instead of materialize_input() and partition_by_radix() if the join does not fit into its memory budget (see
+// JoinHash::JoinHashImpl::_on_execute_spilling). The values of the column are radix-partitioned into one SpillFile per
+// partition without materializing the column in memory. For each element, the RowID, the NULL flag, and the value are
+// written. As in materialize_input(), NULL values are only kept if keep_null_values is set.
+// @returns the number of elements written to each of the partition_files
+template <typename T, typename HashedType, bool keep_null_values>
+std::vector<size_t> spill_input(const std::shared_ptr<const Table>& in_table, const ColumnID column_id,
+                                std::vector<std::unique_ptr<SpillFile>>& partition_files) {
+  const std::hash<HashedType> hash_function;
+  const auto radix_mask = partition_files.size() - 1;
+  DebugAssert((partition_files.size() & radix_mask) == 0, "Number of partitions must be a power of two");
+
+  auto element_counts = std::vector<size_t>(partition_files.size());
+
+  const auto chunk_count = in_table->chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk_in = in_table->get_chunk(chunk_id);
+    if (!chunk_in) continue;
+
+    const auto num_rows = chunk_in->size();
+    auto reference_chunk_offset = ChunkOffset{0};
+
+    const auto segment = chunk_in->get_segment(column_id);
+    segment_with_iterators<T>(*segment, [&](auto it, auto end) {
+      using IterableType = typename decltype(it)::IterableType;
+
+      // See materialize_input() for why rows inserted concurrently into ValueSegments are ignored.
+      if (dynamic_cast<ValueSegment<T>*>(&*segment)) {
+        end -= (end - it) - num_rows;
+      }
+
+      for (; it != end; ++it) {
+        const auto& value = *it;
+
+        // For ReferenceSegments, the index in the ReferenceSegment is used (see materialize_input()).
+        auto row_id = RowID{chunk_id, value.chunk_offset()};
+        if constexpr (is_reference_segment_iterable_v<IterableType>) {
+          row_id = RowID{chunk_id, reference_chunk_offset};
+          ++reference_chunk_offset;
+        }
+
+        if (value.is_null() && !keep_null_values) continue;
+
+        const auto partition_idx = hash_function(static_cast<HashedType>(value.value())) & radix_mask;
+        auto& partition_file = *partition_files[partition_idx];
+        partition_file.write(row_id);
+        partition_file.write(value.is_null());
+        partition_file.write(value.value());
+        ++element_counts[partition_idx];
+      }
+    });
+  }
+
+  return element_counts;
+}
+
+// Reads a partition that was written by spill_input() into a RadixContainer with a single partition.
+template <typename T, bool keep_null_values>
+RadixContainer<T> read_spilled_partition(SpillFile& partition_file, const size_t element_count) {
+  auto radix_container = RadixContainer<T>(1);
+  auto& elements = radix_container[0].elements;
+  auto& null_values = radix_container[0].null_values;
+
+  elements.resize(element_count);
+  if constexpr (keep_null_values) {
+    null_values.resize(element_count);
+  }
+
+  partition_file.start_reading();
+  for (auto element_idx = size_t{0}; element_idx < element_count; ++element_idx) {
+    auto& element = elements[element_idx];
+    auto is_null = false;
+    partition_file.read(element.row_id);
+    partition_file.read(is_null);
+    partition_file.read(element.value);
+
+    if constexpr (keep_null_values) {
+      null_values[element_idx] = is_null;
+    }
+  }
+
+  return radix_container;
+}
+
 /*
   In the probe phase we take all partitions from the probe partition, iterate over them and compare each join candidate
   with the values in the hash table. Since build and probe are hashed using the same hash function, we can reduce the
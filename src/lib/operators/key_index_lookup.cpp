@@ -0,0 +1,167 @@
+#include "key_index_lookup.hpp"
+
+#include <algorithm>
+#include <memory>
+#include <numeric>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "concurrency/transaction_context.hpp"
+#include "expression/abstract_expression.hpp"
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/table_key_index.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+KeyIndexLookup::KeyIndexLookup(const std::string& table_name, const std::vector<ColumnID>& pruned_column_ids,
+                               const std::vector<ColumnID>& key_column_ids,
+                               const std::vector<std::shared_ptr<AbstractExpression>>& key_values)
+    : AbstractReadOnlyOperator(OperatorType::KeyIndexLookup),
+      _table_name(table_name),
+      _pruned_column_ids(pruned_column_ids),
+      _key_column_ids(key_column_ids),
+      _key_values(key_values) {
+  Assert(_key_column_ids.size() == _key_values.size(), "Expected one value per key column");
+  DebugAssert(std::is_sorted(_pruned_column_ids.begin(), _pruned_column_ids.end()),
+              "Expected sorted vector of ColumnIDs");
+}
+
+const std::string& KeyIndexLookup::name() const {
+  static const auto name = std::string{"KeyIndexLookup"};
+  return name;
+}
+
+std::string KeyIndexLookup::description(DescriptionMode description_mode) const {
+  const auto* const separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream stream;
+  stream << AbstractOperator::description(description_mode) << separator << "(" << _table_name << ")";
+
+  const auto stored_table = Hyrise::get().storage_manager.get_table(_table_name);
+  stream << separator << "key:";
+  for (auto key_idx = size_t{0}; key_idx < _key_column_ids.size(); ++key_idx) {
+    stream << (key_idx == 0 ? separator : std::string{","} + separator);
+    stream << stored_table->column_name(_key_column_ids[key_idx]) << " = " << _key_values[key_idx]->as_column_name();
+  }
+
+  return stream.str();
+}
+
+const std::string& KeyIndexLookup::table_name() const { return _table_name; }
+
+const std::vector<ColumnID>& KeyIndexLookup::pruned_column_ids() const { return _pruned_column_ids; }
+
+const std::vector<ColumnID>& KeyIndexLookup::key_column_ids() const { return _key_column_ids; }
+
+const std::vector<std::shared_ptr<AbstractExpression>>& KeyIndexLookup::key_values() const { return _key_values; }
+
+std::shared_ptr<const Table> KeyIndexLookup::_on_execute() {
+  const auto stored_table = Hyrise::get().storage_manager.get_table(_table_name);
+
+  const auto& key_indexes = stored_table->key_indexes();
+  const auto key_index_iter = std::find_if(key_indexes.begin(), key_indexes.end(), [&](const auto& key_index) {
+    return key_index->column_ids() == _key_column_ids;
+  });
+  Assert(key_index_iter != key_indexes.end(), "No key index for the given columns of '" + _table_name + "'");
+
+  auto key = std::vector<AllTypeVariant>{};
+  key.reserve(_key_values.size());
+  for (const auto& key_value : _key_values) {
+    const auto value = expression_get_value_or_parameter(*key_value);
+    Assert(value, "Expected a value or a parameter as key value");
+    key.emplace_back(*value);
+  }
+
+  // Skip rows of chunks that were physically or logically deleted, as GetTable does.
+  auto matches = std::make_shared<RowIDPosList>();
+  for (const auto& row_id : (*key_index_iter)->lookup(key)) {
+    const auto chunk = stored_table->get_chunk(row_id.chunk_id);
+    if (!chunk) continue;
+
+    if (transaction_context_is_set() && chunk->get_cleanup_commit_id() &&
+        *chunk->get_cleanup_commit_id() <= transaction_context()->snapshot_commit_id()) {
+      continue;
+    }
+
+    matches->emplace_back(row_id);
+  }
+
+  // Rows that were updated in place are resolved as in GetTable (see RowVersions). Their chunks are replaced by
+  // resolved copies in a new table. The key columns themselves are never updated in place, so the lookup is not
+  // affected.
+  auto referenced_table = std::shared_ptr<const Table>{stored_table};
+  if (stored_table->uses_mvcc() == UseMvcc::Yes &&
+      std::any_of(matches->begin(), matches->end(), [&](const auto& row_id) {
+        return static_cast<bool>(stored_table->get_chunk(row_id.chunk_id)->mvcc_data()->row_versions());
+      })) {
+    auto stored_column_ids = std::vector<ColumnID>(stored_table->column_count());
+    std::iota(stored_column_ids.begin(), stored_column_ids.end(), ColumnID{0});
+
+    const auto transaction_id =
+        transaction_context_is_set() ? transaction_context()->transaction_id() : INVALID_TRANSACTION_ID;
+    const auto snapshot_commit_id = transaction_context_is_set() ? transaction_context()->snapshot_commit_id()
+                                                                 : Hyrise::get().transaction_manager.last_commit_id();
+
+    auto resolved_chunks = std::vector<std::shared_ptr<Chunk>>{};
+    auto stored_chunk_id = INVALID_CHUNK_ID;
+    for (auto& row_id : *matches) {
+      if (row_id.chunk_id != stored_chunk_id) {
+        stored_chunk_id = row_id.chunk_id;
+        resolved_chunks.emplace_back(resolve_row_versions(stored_table->get_chunk(stored_chunk_id), *stored_table,
+                                                          stored_column_ids, transaction_id, snapshot_commit_id));
+      }
+      row_id.chunk_id = static_cast<ChunkID>(resolved_chunks.size() - 1);
+    }
+
+    referenced_table = std::make_shared<Table>(stored_table->column_definitions(), TableType::Data,
+                                               std::move(resolved_chunks), stored_table->uses_mvcc());
+  }
+
+  auto column_definitions = TableColumnDefinitions{};
+  auto output_column_ids = std::vector<ColumnID>{};
+  auto pruned_column_ids_iter = _pruned_column_ids.begin();
+  for (auto column_id = ColumnID{0}; column_id < stored_table->column_count(); ++column_id) {
+    if (pruned_column_ids_iter != _pruned_column_ids.end() && *pruned_column_ids_iter == column_id) {
+      ++pruned_column_ids_iter;
+      continue;
+    }
+    column_definitions.emplace_back(stored_table->column_definitions()[column_id]);
+    output_column_ids.emplace_back(column_id);
+  }
+
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  if (!matches->empty()) {
+    // The index returns the RowIDs sorted, so all of them are in a single chunk if the first and the last one are.
+    if (matches->front().chunk_id == matches->back().chunk_id) matches->guarantee_single_chunk();
+
+    auto segments = Segments{};
+    segments.reserve(output_column_ids.size());
+    for (const auto column_id : output_column_ids) {
+      segments.emplace_back(std::make_shared<ReferenceSegment>(referenced_table, column_id, matches));
+    }
+    output_chunks.emplace_back(std::make_shared<Chunk>(std::move(segments)));
+  }
+
+  return std::make_shared<Table>(column_definitions, TableType::References, std::move(output_chunks));
+}
+
+std::shared_ptr<AbstractOperator> KeyIndexLookup::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_left_input,
+    const std::shared_ptr<AbstractOperator>& copied_right_input,
+    std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
+  return std::make_shared<KeyIndexLookup>(_table_name, _pruned_column_ids, _key_column_ids,
+                                          expressions_deep_copy(_key_values));
+}
+
+void KeyIndexLookup::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  for (const auto& key_value : _key_values) {
+    expression_set_parameters(key_value, parameters);
+  }
+}
+
+}  // namespace opossum
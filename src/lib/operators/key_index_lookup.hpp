@@ -0,0 +1,53 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractExpression;
+
+/**
+ * Operator that retrieves the rows of a stored table whose key equals the given values by looking them up in the
+ * table's TableKeyIndex (see Table::create_key_index). It replaces a GetTable and the TableScans on the key columns
+ * (see KeyIndexLookupRule) and thus reads neither the other rows nor the other chunks.
+ *
+ * key_column_ids refer to the stored table and must be the columns of a key index. key_values are ValueExpressions or
+ * CorrelatedParameterExpressions. Like GetTable, the operator outputs all columns except the pruned ones. As the index
+ * returns all row versions with the key, the output has to be validated.
+ */
+class KeyIndexLookup : public AbstractReadOnlyOperator {
+ public:
+  KeyIndexLookup(const std::string& table_name, const std::vector<ColumnID>& pruned_column_ids,
+                 const std::vector<ColumnID>& key_column_ids,
+                 const std::vector<std::shared_ptr<AbstractExpression>>& key_values);
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode) const override;
+
+  const std::string& table_name() const;
+  const std::vector<ColumnID>& pruned_column_ids() const;
+  const std::vector<ColumnID>& key_column_ids() const;
+  const std::vector<std::shared_ptr<AbstractExpression>>& key_values() const;
+
+ protected:
+  std::shared_ptr<const Table> _on_execute() override;
+
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_left_input,
+      const std::shared_ptr<AbstractOperator>& copied_right_input,
+      std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+
+  const std::string _table_name;
+  const std::vector<ColumnID> _pruned_column_ids;
+  const std::vector<ColumnID> _key_column_ids;
+  const std::vector<std::shared_ptr<AbstractExpression>> _key_values;
+};
+
+}  // namespace opossum
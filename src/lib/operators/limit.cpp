@@ -119,4 +119,8 @@ void Limit::_on_set_transaction_context(const std::weak_ptr<TransactionContext>&
   expression_set_transaction_context(_row_count_expression, transaction_context);
 }
 
+void Limit::_on_set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {
+  expression_set_memory_budget_resource(_row_count_expression, memory_budget_resource);
+}
+
 }  // namespace opossum
@@ -27,6 +27,7 @@ class Limit : public AbstractReadOnlyOperator {
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
   void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+  void _on_set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) override;
 
  private:
   std::shared_ptr<AbstractExpression> _row_count_expression;
@@ -0,0 +1,175 @@
+#include "pipelined_scan.hpp"
+
+#include <memory>
+#include <mutex>
+#include <sstream>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "concurrency/transaction_context.hpp"
+#include "expression/expression_utils.hpp"
+#include "hyrise.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/validate.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/chunk.hpp"
+#include "storage/table.hpp"
+#include "table_scan/expression_evaluator_table_scan_impl.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+PipelinedScan::PipelinedScan(const std::shared_ptr<const AbstractOperator>& in, const bool validate,
+                             const std::vector<std::shared_ptr<AbstractExpression>>& predicates)
+    : AbstractReadOnlyOperator{OperatorType::PipelinedScan, in, nullptr, std::make_unique<PerformanceData>()},
+      _validate(validate),
+      _predicates(predicates) {
+  Assert(_validate || !_predicates.empty(), "PipelinedScan needs at least one stage");
+  for (const auto& predicate : _predicates) {
+    Assert(find_pqp_subquery_expressions(predicate).empty(), "PipelinedScan does not support subqueries");
+  }
+}
+
+const std::string& PipelinedScan::name() const {
+  static const auto name = std::string{"PipelinedScan"};
+  return name;
+}
+
+std::string PipelinedScan::description(DescriptionMode description_mode) const {
+  const auto* const separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+
+  std::stringstream stream;
+
+  stream << AbstractOperator::description(description_mode);
+  if (_validate) stream << separator << "Validate";
+  for (const auto& predicate : _predicates) {
+    stream << separator << predicate->as_column_name();
+  }
+
+  return stream.str();
+}
+
+bool PipelinedScan::validates() const { return _validate; }
+
+const std::vector<std::shared_ptr<AbstractExpression>>& PipelinedScan::predicates() const { return _predicates; }
+
+std::shared_ptr<AbstractOperator> PipelinedScan::_on_deep_copy(
+    const std::shared_ptr<AbstractOperator>& copied_left_input,
+    const std::shared_ptr<AbstractOperator>& copied_right_input,
+    std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const {
+  return std::make_shared<PipelinedScan>(copied_left_input, _validate, expressions_deep_copy(_predicates, copied_ops));
+}
+
+void PipelinedScan::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
+  expressions_set_transaction_context(_predicates, transaction_context);
+}
+
+void PipelinedScan::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
+  expressions_set_parameters(_predicates, parameters);
+}
+
+std::shared_ptr<const Table> PipelinedScan::_on_execute() { return _on_execute(nullptr); }
+
+std::shared_ptr<const Table> PipelinedScan::_on_execute(std::shared_ptr<TransactionContext> transaction_context) {
+  Assert(!_validate || transaction_context, "Validating PipelinedScan can't be executed without a transaction context.");
+  DebugAssert(!_validate || transaction_context->phase() == TransactionPhase::Active,
+              "Transaction is not active anymore.");
+
+  const auto in_table = left_input_table();
+  const auto chunk_count = in_table->chunk_count();
+
+  // See Validate::_on_execute() for the conditions under which entirely visible chunks can be skipped.
+  const auto can_use_chunk_shortcut = _validate && Validate::can_use_chunk_shortcut(transaction_context);
+
+  auto output_mutex = std::mutex{};
+  auto output_chunks = std::vector<std::shared_ptr<Chunk>>{};
+  output_chunks.reserve(chunk_count);
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(chunk_count);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk_in = in_table->get_chunk(chunk_id);
+    Assert(chunk_in, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+    auto process_morsel = [&, chunk_id]() {
+      const auto chunk = _process_morsel(in_table, chunk_id, transaction_context, can_use_chunk_shortcut);
+      if (!chunk) return;
+
+      std::lock_guard<std::mutex> lock(output_mutex);
+      output_chunks.emplace_back(chunk);
+    };
+
+    // Same threshold as in the TableScan. As all stages are executed in the same job, the scheduling overhead is paid
+    // only once per morsel.
+    constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
+    if (chunk_in->size() >= JOB_SPAWN_THRESHOLD) {
+      jobs.emplace_back(std::make_shared<JobTask>(process_morsel));
+    } else {
+      process_morsel();
+    }
+  }
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  return std::make_shared<Table>(in_table->column_definitions(), TableType::References, std::move(output_chunks));
+}
+
+std::shared_ptr<Chunk> PipelinedScan::_process_morsel(const std::shared_ptr<const Table>& in_table,
+                                                      const ChunkID chunk_id,
+                                                      const std::shared_ptr<TransactionContext>& transaction_context,
+                                                      const bool can_use_chunk_shortcut) const {
+  auto& scan_performance_data = dynamic_cast<PerformanceData&>(*performance_data);
+
+  // The table and chunk that the next stage reads from. Stages after the first one read the output chunk of the
+  // previous stage, which is wrapped in a single-chunk reference table so that the TableScanImpls can process it.
+  auto morsel_table = in_table;
+  auto morsel_chunk_id = chunk_id;
+  auto morsel_chunk = std::shared_ptr<Chunk>{};
+
+  auto remaining_stage_count = (_validate ? size_t{1} : size_t{0}) + _predicates.size();
+
+  if (_validate) {
+    // The cache for entirely visible chunks is only used for reference inputs that reference multiple chunks, which
+    // is rare below a Validate.
+    auto entirely_visible_chunks_cache = Validate::EntirelyVisibleChunksCache{};
+    morsel_chunk = Validate::validate_chunk(in_table, chunk_id, transaction_context->transaction_id(),
+                                            transaction_context->snapshot_commit_id(), can_use_chunk_shortcut,
+                                            entirely_visible_chunks_cache);
+    --remaining_stage_count;
+    if (!morsel_chunk) {
+      if (remaining_stage_count > 0) ++scan_performance_data.num_morsels_eliminated;
+      return nullptr;
+    }
+  }
+
+  for (const auto& predicate : _predicates) {
+    if (morsel_chunk) {
+      morsel_table = std::make_shared<Table>(in_table->column_definitions(), TableType::References,
+                                             std::vector<std::shared_ptr<Chunk>>{morsel_chunk});
+      morsel_chunk_id = ChunkID{0};
+    }
+
+    auto impl = TableScan::create_dedicated_impl(morsel_table, predicate);
+    if (!impl) impl = std::make_unique<ExpressionEvaluatorTableScanImpl>(morsel_table, predicate, nullptr);
+
+    const auto matches = impl->scan_chunk(morsel_chunk_id);
+
+    scan_performance_data.num_chunks_with_early_out += impl->num_chunks_with_early_out.load();
+    scan_performance_data.num_chunks_with_all_rows_matching += impl->num_chunks_with_all_rows_matching.load();
+    scan_performance_data.num_chunks_with_binary_search += impl->num_chunks_with_binary_search.load();
+
+    --remaining_stage_count;
+    if (matches->empty()) {
+      if (remaining_stage_count > 0) ++scan_performance_data.num_morsels_eliminated;
+      return nullptr;
+    }
+
+    morsel_chunk = TableScan::create_output_chunk(morsel_table, morsel_chunk_id, matches);
+  }
+
+  return morsel_chunk;
+}
+
+}  // namespace opossum
@@ -0,0 +1,78 @@
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "abstract_read_only_operator.hpp"
+#include "expression/abstract_expression.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+class Table;
+
+/**
+ * Fused, morsel-driven execution of a chain of Validate and TableScan operators.
+ *
+ * Executed one after the other, each of the fused operators would materialize a position list for the entire table
+ * before the next operator starts reading it again. Instead, the PipelinedScan pushes each chunk (morsel) of its input
+ * through all stages in a single task, i.e., while the chunk is still hot in the cache. After the (optional)
+ * validation, the predicates are applied in the given order. A morsel is dropped as soon as one stage leaves no rows
+ * of it. The result is the same as that of the unfused chain.
+ *
+ * The LQPTranslator emits PipelinedScans for Validate/Predicate chains if pipelined execution is enabled (see
+ * SQLPipelineBuilder::with_pipelined_execution). Predicates must not contain subqueries.
+ */
+class PipelinedScan : public AbstractReadOnlyOperator {
+ public:
+  PipelinedScan(const std::shared_ptr<const AbstractOperator>& in, const bool validate,
+                const std::vector<std::shared_ptr<AbstractExpression>>& predicates);
+
+  const std::string& name() const override;
+  std::string description(DescriptionMode description_mode) const override;
+
+  bool validates() const;
+  const std::vector<std::shared_ptr<AbstractExpression>>& predicates() const;
+
+  struct PerformanceData : public OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps> {
+    std::atomic<size_t> num_morsels_eliminated{0};
+    std::atomic<size_t> num_chunks_with_early_out{0};
+    std::atomic<size_t> num_chunks_with_all_rows_matching{0};
+    std::atomic<size_t> num_chunks_with_binary_search{0};
+
+    void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override {
+      OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps>::output_to_stream(stream, description_mode);
+
+      const auto* const separator = description_mode == DescriptionMode::MultiLine ? "\n" : " ";
+      stream << separator << "Morsels: " << num_morsels_eliminated.load() << " eliminated before the last stage.";
+      stream << separator << "Chunks: " << num_chunks_with_early_out.load() << " skipped with no results, ";
+      stream << separator << num_chunks_with_all_rows_matching.load() << " skipped with all matching, ";
+      stream << num_chunks_with_binary_search.load() << " scanned using binary search.";
+    }
+  };
+
+ protected:
+  std::shared_ptr<const Table> _on_execute(std::shared_ptr<TransactionContext> transaction_context) override;
+  std::shared_ptr<const Table> _on_execute() override;
+
+  std::shared_ptr<AbstractOperator> _on_deep_copy(
+      const std::shared_ptr<AbstractOperator>& copied_left_input,
+      const std::shared_ptr<AbstractOperator>& copied_right_input,
+      std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
+
+  void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+  void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
+
+ private:
+  // Pushes the chunk `chunk_id` of the input table through all stages. Returns nullptr if no row qualifies.
+  std::shared_ptr<Chunk> _process_morsel(const std::shared_ptr<const Table>& in_table, const ChunkID chunk_id,
+                                         const std::shared_ptr<TransactionContext>& transaction_context,
+                                         const bool can_use_chunk_shortcut) const;
+
+  const bool _validate;
+  const std::vector<std::shared_ptr<AbstractExpression>> _predicates;
+};
+
+}  // namespace opossum
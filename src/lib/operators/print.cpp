@@ -252,6 +252,10 @@ std::string Print::_segment_type(const std::shared_ptr<AbstractSegment>& segment
           segment_type += ":BP";
           break;
         }
+        case CompressedVectorType::BitPacking: {
+          segment_type += ":BitP";
+          break;
+        }
       }
     }
   } else {
@@ -71,6 +71,10 @@ void Projection::_on_set_transaction_context(const std::weak_ptr<TransactionCont
   expressions_set_transaction_context(expressions, transaction_context);
 }
 
+void Projection::_on_set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {
+  expressions_set_memory_budget_resource(expressions, memory_budget_resource);
+}
+
 std::shared_ptr<const Table> Projection::_on_execute() {
   Timer timer;
 
@@ -0,0 +1,304 @@
+#include "runtime_filter.hpp"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "operators/get_table.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/join_hash/join_hash_steps.hpp"
+#include "operators/pqp_utils.hpp"
+#include "operators/table_scan.hpp"
+#include "resolve_type.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/chunk.hpp"
+#include "storage/segment_accessor.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Operators on the probe side of a hash join that apply its runtime filter
+struct RuntimeFilterConsumers {
+  std::shared_ptr<TableScan> table_scan;
+  std::shared_ptr<GetTable> get_table;
+};
+
+// Walks down a chain of TableScans and Validates, which do not change the column layout, and collects the topmost
+// TableScan (which sees the fewest rows) and the GetTable at the bottom of the chain.
+RuntimeFilterConsumers find_runtime_filter_consumers(const std::shared_ptr<AbstractOperator>& probe_input) {
+  auto consumers = RuntimeFilterConsumers{};
+
+  auto op = probe_input;
+  while (op && op->consumer_count() == 1 && !op->executed()) {
+    if (op->type() == OperatorType::TableScan) {
+      if (!consumers.table_scan) consumers.table_scan = std::static_pointer_cast<TableScan>(op);
+    } else if (op->type() == OperatorType::GetTable) {
+      consumers.get_table = std::static_pointer_cast<GetTable>(op);
+      break;
+    } else if (op->type() != OperatorType::Validate) {
+      break;
+    }
+    op = op->mutable_left_input();
+  }
+
+  return consumers;
+}
+
+size_t stored_row_count(const RuntimeFilterConsumers& consumers) {
+  if (!consumers.get_table) return 0;
+  return Hyrise::get().storage_manager.get_table(consumers.get_table->table_name())->row_count();
+}
+
+}  // namespace
+
+namespace opossum {
+
+RuntimeFilter::RuntimeFilter(const std::shared_ptr<AbstractOperator>& producer, const ColumnID producer_column_id)
+    : _producer(producer), _producer_column_id(producer_column_id) {}
+
+const std::shared_ptr<AbstractOperator>& RuntimeFilter::producer() const { return _producer; }
+
+ColumnID RuntimeFilter::producer_column_id() const { return _producer_column_id; }
+
+const std::vector<std::weak_ptr<AbstractOperator>>& RuntimeFilter::consumers() const { return _consumers; }
+
+void RuntimeFilter::add_consumer(const std::shared_ptr<AbstractOperator>& consumer) {
+  _consumers.emplace_back(consumer);
+}
+
+bool RuntimeFilter::prepare(const DataType data_type) {
+  std::call_once(_build_flag, [&]() { _build(); });
+  return _data_type && *_data_type == data_type;
+}
+
+bool RuntimeFilter::can_prune(const Chunk& chunk, const ColumnID column_id) const {
+  DebugAssert(_data_type, "RuntimeFilter has not been prepared");
+
+  // Without any values on the build side, no row can find a join partner.
+  if (!_min) return true;
+
+  // Pruning statistics of mutable chunks might not cover rows that were inserted later.
+  const auto& pruning_statistics = chunk.pruning_statistics();
+  if (!pruning_statistics || chunk.is_mutable()) return false;
+
+  const auto& base_segment_statistics = *(*pruning_statistics)[column_id];
+  DebugAssert(base_segment_statistics.data_type == *_data_type, "Pruning statistics have an unexpected data type");
+
+  auto can_prune = false;
+  resolve_data_type(*_data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto& segment_statistics = static_cast<const AttributeStatistics<ColumnDataType>&>(base_segment_statistics);
+
+    // Range filters are only available for arithmetic (non-string) types.
+    if constexpr (std::is_arithmetic_v<ColumnDataType>) {
+      if (segment_statistics.range_filter &&
+          segment_statistics.range_filter->does_not_contain(PredicateCondition::BetweenInclusive, *_min, *_max)) {
+        can_prune = true;
+      }
+    }
+
+    if (segment_statistics.min_max_filter &&
+        segment_statistics.min_max_filter->does_not_contain(PredicateCondition::BetweenInclusive, *_min, *_max)) {
+      can_prune = true;
+    }
+  });
+
+  return can_prune;
+}
+
+std::shared_ptr<RowIDPosList> RuntimeFilter::filter(const std::shared_ptr<const AbstractSegment>& segment,
+                                                    const std::shared_ptr<RowIDPosList>& positions) const {
+  DebugAssert(_data_type, "RuntimeFilter has not been prepared");
+
+  auto filtered_positions = std::make_shared<RowIDPosList>();
+  if (positions->references_single_chunk()) filtered_positions->guarantee_single_chunk();
+  if (!_min) return filtered_positions;
+
+  filtered_positions->reserve(positions->size());
+
+  resolve_data_type(*_data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto min = boost::get<ColumnDataType>(*_min);
+    const auto max = boost::get<ColumnDataType>(*_max);
+    const auto hash_function = std::hash<ColumnDataType>{};
+    const auto probe_bloom_filter = _bloom_filter.is_active();
+
+    auto probed_value_count = size_t{0};
+    auto passed_value_count = size_t{0};
+
+    const auto segment_accessor = create_segment_accessor<ColumnDataType>(segment);
+    for (const auto& row_id : *positions) {
+      const auto value = segment_accessor->access(row_id.chunk_offset);
+      if (!value || *value < min || *value > max) continue;
+
+      if (probe_bloom_filter) {
+        ++probed_value_count;
+        if (!_bloom_filter.contains(hash_function(*value))) continue;
+        ++passed_value_count;
+      }
+
+      filtered_positions->emplace_back(row_id);
+    }
+
+    if (probe_bloom_filter) _bloom_filter.record_probes(probed_value_count, passed_value_count);
+  });
+
+  return filtered_positions;
+}
+
+const std::optional<AllTypeVariant>& RuntimeFilter::min() const { return _min; }
+
+const std::optional<AllTypeVariant>& RuntimeFilter::max() const { return _max; }
+
+const BloomFilter& RuntimeFilter::bloom_filter() const { return _bloom_filter; }
+
+void RuntimeFilter::_build() {
+  // The producer might not have been executed if the consumer was executed without the dependencies that
+  // OperatorTask::make_tasks_from_operator sets up. In this case, the filter is not applied.
+  if (!_producer->executed()) return;
+
+  const auto table = _producer->get_output();
+  const auto data_type = table->column_data_type(_producer_column_id);
+  const auto chunk_count = table->chunk_count();
+
+  _bloom_filter.allocate(table->row_count());
+
+  resolve_data_type(data_type, [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto hash_function = std::hash<ColumnDataType>{};
+
+    // As in materialize_input, jobs insert into partial Bloom filters that are merged afterwards.
+    const auto use_partial_bloom_filters = Hyrise::get().is_multi_threaded();
+    auto partial_bloom_filters = std::optional<PartialBloomFilters>{};
+    if (use_partial_bloom_filters) {
+      partial_bloom_filters.emplace(_bloom_filter, Hyrise::get().topology.num_cpus() + 1);
+    }
+
+    auto chunk_min_max = std::vector<std::optional<std::pair<ColumnDataType, ColumnDataType>>>(chunk_count);
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = table->get_chunk(chunk_id);
+      if (!chunk) continue;
+
+      auto build_chunk = [&, chunk, chunk_id]() {
+        const auto filter_idx = use_partial_bloom_filters ? partial_bloom_filters->claim() : size_t{0};
+        auto& bloom_filter = use_partial_bloom_filters ? partial_bloom_filters->get(filter_idx) : _bloom_filter;
+
+        auto& min_max = chunk_min_max[chunk_id];
+        segment_iterate<ColumnDataType>(*chunk->get_segment(_producer_column_id), [&](const auto& position) {
+          if (position.is_null()) return;
+
+          const auto& value = position.value();
+          bloom_filter.insert(hash_function(value));
+          if (!min_max) {
+            min_max.emplace(value, value);
+          } else if (value < min_max->first) {
+            min_max->first = value;
+          } else if (value > min_max->second) {
+            min_max->second = value;
+          }
+        });
+
+        if (use_partial_bloom_filters) partial_bloom_filters->release(filter_idx);
+      };
+
+      if (use_partial_bloom_filters && chunk->size() > JoinHash::JOB_SPAWN_THRESHOLD) {
+        jobs.emplace_back(std::make_shared<JobTask>(build_chunk));
+      } else {
+        build_chunk();
+      }
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+    if (use_partial_bloom_filters) _bloom_filter.merge(partial_bloom_filters->filters());
+
+    for (const auto& min_max : chunk_min_max) {
+      if (!min_max) continue;
+
+      if (!_min) {
+        _min = min_max->first;
+        _max = min_max->second;
+        continue;
+      }
+      if (min_max->first < boost::get<ColumnDataType>(*_min)) _min = min_max->first;
+      if (min_max->second > boost::get<ColumnDataType>(*_max)) _max = min_max->second;
+    }
+  });
+
+  _data_type = data_type;
+}
+
+std::vector<std::shared_ptr<RuntimeFilter>> push_down_runtime_filters(const std::shared_ptr<AbstractOperator>& pqp) {
+  auto runtime_filters = std::vector<std::shared_ptr<RuntimeFilter>>{};
+
+  visit_pqp(pqp, [&](const auto& op) {
+    if (op->type() != OperatorType::JoinHash || op->executed()) return PQPVisitation::VisitInputs;
+
+    const auto join_hash = std::static_pointer_cast<JoinHash>(op);
+    if (join_hash->runtime_filter) {
+      runtime_filters.emplace_back(join_hash->runtime_filter);
+      return PQPVisitation::VisitInputs;
+    }
+
+    // Probe rows without a join partner are only discarded by inner and semi joins. For anti and outer joins, the
+    // probe side must not be filtered.
+    const auto mode = join_hash->mode();
+    const auto& primary_predicate = join_hash->primary_predicate();
+    if ((mode != JoinMode::Inner && mode != JoinMode::Semi) ||
+        primary_predicate.predicate_condition != PredicateCondition::Equals) {
+      return PQPVisitation::VisitInputs;
+    }
+
+    // The right input is the build side of semi joins. For inner joins, JoinHash decides on the build side at runtime.
+    // As either input can be used to filter the other one, we filter the input that reads the larger stored table.
+    auto filter_left_input = true;
+    auto consumers = find_runtime_filter_consumers(join_hash->mutable_left_input());
+    if (mode == JoinMode::Inner) {
+      auto right_consumers = find_runtime_filter_consumers(join_hash->mutable_right_input());
+      if (stored_row_count(right_consumers) > stored_row_count(consumers)) {
+        filter_left_input = false;
+        consumers = std::move(right_consumers);
+      }
+    }
+    if (!consumers.table_scan && !consumers.get_table) return PQPVisitation::VisitInputs;
+
+    const auto& [left_column_id, right_column_id] = primary_predicate.column_ids;
+    const auto consumer_column_id = filter_left_input ? left_column_id : right_column_id;
+    const auto runtime_filter = std::make_shared<RuntimeFilter>(
+        filter_left_input ? join_hash->mutable_right_input() : join_hash->mutable_left_input(),
+        filter_left_input ? right_column_id : left_column_id);
+
+    if (consumers.table_scan) {
+      consumers.table_scan->add_runtime_filter(runtime_filter, consumer_column_id);
+      runtime_filter->add_consumer(consumers.table_scan);
+    }
+    if (consumers.get_table) {
+      consumers.get_table->add_runtime_filter(runtime_filter, consumer_column_id);
+      runtime_filter->add_consumer(consumers.get_table);
+    }
+    join_hash->runtime_filter = runtime_filter;
+    runtime_filters.emplace_back(runtime_filter);
+
+    return PQPVisitation::VisitInputs;
+  });
+
+  return runtime_filters;
+}
+
+}  // namespace opossum
@@ -0,0 +1,87 @@
+#pragma once
+
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "operators/join_hash/bloom_filter.hpp"
+#include "storage/pos_lists/row_id_pos_list.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractOperator;
+class AbstractSegment;
+class Chunk;
+
+/**
+ * Runtime filters pass information from the build side of a hash join sideways to the operators that read the probe
+ * side. The values of the build side's join column are summarized in a min/max range and a BloomFilter. GetTable
+ * skips chunks whose pruning statistics do not overlap with the range, and TableScan drops rows that cannot find a
+ * join partner. Thus, these rows are never materialized by the join (see materialize_input in join_hash_steps.hpp).
+ *
+ * Hyrise executes both inputs of a join before the join itself. By the time JoinHash builds its hash table, the probe
+ * side has already been read. Therefore, the filter is built from the output of the join's build input (the
+ * producer), which contains the same values, and the consuming operators are made to wait for the producer (see
+ * OperatorTask::make_tasks_from_operator). The first consumer that executes builds the filter.
+ *
+ * Dropping rows is only correct for join modes that discard probe rows without a join partner, i.e., for inner and
+ * semi joins with an equality predicate.
+ */
+class RuntimeFilter {
+ public:
+  RuntimeFilter(const std::shared_ptr<AbstractOperator>& producer, const ColumnID producer_column_id);
+
+  const std::shared_ptr<AbstractOperator>& producer() const;
+  ColumnID producer_column_id() const;
+
+  // Operators that apply this filter, i.e., that have to be executed after the producer. The consumers hold the filter
+  // until they have been executed, so the filter only holds weak pointers to them.
+  const std::vector<std::weak_ptr<AbstractOperator>>& consumers() const;
+  void add_consumer(const std::shared_ptr<AbstractOperator>& consumer);
+
+  // Builds the filter from the producer's output unless that has already happened. Returns whether the filter can be
+  // applied to values of the given data type. This is not the case if the producer has not been executed or if its
+  // join column has a different data type (e.g., when joining an int column with a long column). Thread-safe.
+  bool prepare(const DataType data_type);
+
+  // Returns whether no row of the chunk can find a join partner, judging by the pruning statistics of the given column.
+  // Requires prepare().
+  bool can_prune(const Chunk& chunk, const ColumnID column_id) const;
+
+  // Returns the subset of the positions (all of which point into segment) whose values may find a join partner. NULL
+  // values are always removed. Requires prepare().
+  std::shared_ptr<RowIDPosList> filter(const std::shared_ptr<const AbstractSegment>& segment,
+                                       const std::shared_ptr<RowIDPosList>& positions) const;
+
+  // Minimum and maximum of the producer's join column. Not set if it contains no (non-NULL) values.
+  const std::optional<AllTypeVariant>& min() const;
+  const std::optional<AllTypeVariant>& max() const;
+
+  const BloomFilter& bloom_filter() const;
+
+ protected:
+  void _build();
+
+  const std::shared_ptr<AbstractOperator> _producer;
+  const ColumnID _producer_column_id;
+  std::vector<std::weak_ptr<AbstractOperator>> _consumers;
+
+  std::once_flag _build_flag;
+  std::optional<DataType> _data_type;
+  std::optional<AllTypeVariant> _min;
+  std::optional<AllTypeVariant> _max;
+  BloomFilter _bloom_filter;
+};
+
+/**
+ * Creates the runtime filters of all hash joins in the PQP that have not been executed yet. The filters are registered
+ * at the JoinHash and at the GetTable and the topmost TableScan of a chain of TableScans and Validates that feeds the
+ * probe side. Operators of the chain must not have other consumers, as those would see a filtered result, too.
+ * Returns all runtime filters of the PQP, including those that have been pushed down by a previous call.
+ */
+std::vector<std::shared_ptr<RuntimeFilter>> push_down_runtime_filters(const std::shared_ptr<AbstractOperator>& pqp);
+
+}  // namespace opossum
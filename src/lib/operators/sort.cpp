@@ -1,5 +1,13 @@
 #include "sort.hpp"
 
+#include <cstring>
+#include <limits>
+
+#include <uninitialized_vector.hpp>
+
+#include "hyrise.hpp"
+#include "scheduler/abstract_task.hpp"
+#include "scheduler/job_task.hpp"
 #include "storage/segment_iterate.hpp"
 #include "utils/timer.hpp"
 
@@ -8,7 +16,7 @@ namespace {
 using namespace opossum;  // NOLINT
 
 // Given an unsorted_table and a pos_list that defines the output order, this materializes all columns in the table,
-// creating chunks of output_chunk_size rows at maximum.
+// creating chunks of output_chunk_size rows at maximum. The output chunks are written in parallel.
 std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<const Table>& unsorted_table,
                                                        RowIDPosList pos_list, const ChunkOffset output_chunk_size) {
   // First, we create a new table as the output
@@ -16,8 +24,8 @@ std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<con
   auto output = std::make_shared<Table>(unsorted_table->column_definitions(), TableType::Data, output_chunk_size);
 
   // After we created the output table and initialized the column structure, we can start adding values. Because the
-  // values are not sorted by input chunks anymore, we can't process them chunk by chunk. Instead the values are copied
-  // column by column for each output row.
+  // values are not sorted by input chunks anymore, we can't process them chunk by chunk. Instead, each output chunk is
+  // materialized column by column by accessing the input rows in their sorted order.
 
   // Ceiling of integer division
   const auto div_ceil = [](auto x, auto y) { return (x + y - 1u) / y; };
@@ -25,51 +33,48 @@ std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<con
   Assert(pos_list.size() == unsorted_table->row_count(), "Mismatching size of input table and PosList");
 
   // Vector of segments for each chunk
-  std::vector<Segments> output_segments_by_chunk(output_chunk_count);
+  const auto column_count = output->column_count();
+  auto output_segments_by_chunk = std::vector<Segments>(output_chunk_count, Segments(column_count));
 
-  // Materialize column by column, starting a new ValueSegment whenever output_chunk_size is reached
   const auto input_chunk_count = unsorted_table->chunk_count();
-  const auto row_count = unsorted_table->row_count();
-  for (ColumnID column_id{0u}; column_id < output->column_count(); ++column_id) {
-    const auto column_data_type = output->column_data_type(column_id);
-    const auto column_is_nullable = unsorted_table->column_is_nullable(column_id);
-
-    resolve_data_type(column_data_type, [&](auto type) {
-      using ColumnDataType = typename decltype(type)::type;
-
-      auto chunk_it = output_segments_by_chunk.begin();
-      auto current_segment_size = 0u;
-
-      auto value_segment_value_vector = pmr_vector<ColumnDataType>();
-      auto value_segment_null_vector = pmr_vector<bool>();
-
-      {
-        const auto next_chunk_size = std::min(static_cast<size_t>(output_chunk_size), static_cast<size_t>(row_count));
-        value_segment_value_vector.reserve(next_chunk_size);
-        if (column_is_nullable) value_segment_null_vector.reserve(next_chunk_size);
-      }
-
-      auto accessor_by_chunk_id =
-          std::vector<std::unique_ptr<AbstractSegmentAccessor<ColumnDataType>>>(unsorted_table->chunk_count());
-      for (auto input_chunk_id = ChunkID{0}; input_chunk_id < input_chunk_count; ++input_chunk_id) {
-        const auto& abstract_segment = unsorted_table->get_chunk(input_chunk_id)->get_segment(column_id);
-        accessor_by_chunk_id[input_chunk_id] = create_segment_accessor<ColumnDataType>(abstract_segment);
-      }
-
-      for (auto row_index = size_t{0}; row_index < row_count; ++row_index) {
-        const auto [chunk_id, chunk_offset] = pos_list[row_index];
-
-        auto& accessor = accessor_by_chunk_id[chunk_id];
-        const auto typed_value = accessor->access(chunk_offset);
-        const auto is_null = !typed_value;
-        value_segment_value_vector.push_back(is_null ? ColumnDataType{} : typed_value.value());
-        if (column_is_nullable) value_segment_null_vector.push_back(is_null);
-
-        ++current_segment_size;
-
-        // Check if value segment is full
-        if (current_segment_size >= output_chunk_size) {
-          current_segment_size = 0u;
+  const auto row_count = pos_list.size();
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(output_chunk_count);
+  for (auto output_chunk_idx = size_t{0}; output_chunk_idx < output_chunk_count; ++output_chunk_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, output_chunk_idx]() {
+      const auto begin_row_index = output_chunk_idx * output_chunk_size;
+      const auto end_row_index = std::min(begin_row_index + output_chunk_size, row_count);
+
+      for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+        const auto column_is_nullable = unsorted_table->column_is_nullable(column_id);
+
+        resolve_data_type(output->column_data_type(column_id), [&](auto type) {
+          using ColumnDataType = typename decltype(type)::type;
+
+          auto value_segment_value_vector = pmr_vector<ColumnDataType>();
+          auto value_segment_null_vector = pmr_vector<bool>();
+          value_segment_value_vector.reserve(end_row_index - begin_row_index);
+          if (column_is_nullable) value_segment_null_vector.reserve(end_row_index - begin_row_index);
+
+          // Accessors are created lazily, as an output chunk usually references only some of the input chunks.
+          auto accessor_by_chunk_id =
+              std::vector<std::unique_ptr<AbstractSegmentAccessor<ColumnDataType>>>(input_chunk_count);
+
+          for (auto row_index = begin_row_index; row_index < end_row_index; ++row_index) {
+            const auto [chunk_id, chunk_offset] = pos_list[row_index];
+
+            auto& accessor = accessor_by_chunk_id[chunk_id];
+            if (!accessor) {
+              const auto& abstract_segment = unsorted_table->get_chunk(chunk_id)->get_segment(column_id);
+              accessor = create_segment_accessor<ColumnDataType>(abstract_segment);
+            }
+
+            const auto typed_value = accessor->access(chunk_offset);
+            const auto is_null = !typed_value;
+            value_segment_value_vector.push_back(is_null ? ColumnDataType{} : typed_value.value());
+            if (column_is_nullable) value_segment_null_vector.push_back(is_null);
+          }
 
           std::shared_ptr<ValueSegment<ColumnDataType>> value_segment;
           if (column_is_nullable) {
@@ -78,33 +83,12 @@ std::shared_ptr<Table> write_materialized_output_table(const std::shared_ptr<con
           } else {
             value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector));
           }
-
-          chunk_it->push_back(value_segment);
-          value_segment_value_vector = pmr_vector<ColumnDataType>();
-          value_segment_null_vector = pmr_vector<bool>();
-
-          const auto next_chunk_size =
-              std::min(static_cast<size_t>(output_chunk_size), static_cast<size_t>(row_count - row_index));
-          value_segment_value_vector.reserve(next_chunk_size);
-          if (column_is_nullable) value_segment_null_vector.reserve(next_chunk_size);
-
-          ++chunk_it;
-        }
-      }
-
-      // Last segment has not been added
-      if (current_segment_size > 0u) {
-        std::shared_ptr<ValueSegment<ColumnDataType>> value_segment;
-        if (column_is_nullable) {
-          value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector),
-                                                                         std::move(value_segment_null_vector));
-        } else {
-          value_segment = std::make_shared<ValueSegment<ColumnDataType>>(std::move(value_segment_value_vector));
-        }
-        chunk_it->push_back(value_segment);
+          output_segments_by_chunk[output_chunk_idx][column_id] = value_segment;
+        });
       }
-    });
+    }));
   }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
 
   for (auto& segments : output_segments_by_chunk) {
     output->append_chunk(segments);
@@ -215,6 +199,98 @@ std::shared_ptr<Table> write_reference_output_table(const std::shared_ptr<const
   return output_table;
 }
 
+// Inputs are split into runs of at least this many rows, which are sorted in parallel.
+constexpr auto MIN_ROWS_PER_SORT_RUN = size_t{50'000};
+
+// Stable sort that splits the values into one run per CPU. The runs are sorted in parallel and then merged pairwise,
+// with the merges of each round running in parallel. std::merge prefers elements of the first run over equal elements
+// of the second run, so the merging does not break the stability.
+template <typename Values, typename Comparator>
+void parallel_stable_sort(Values& values, const Comparator& comparator) {
+  const auto run_count = std::min(values.size() / MIN_ROWS_PER_SORT_RUN,
+                                  std::max(size_t{1}, static_cast<size_t>(Hyrise::get().topology.num_cpus())));
+  if (run_count <= 1) {
+    std::stable_sort(values.begin(), values.end(), comparator);
+    return;
+  }
+
+  auto run_bounds = std::vector<size_t>(run_count + 1);
+  for (auto run_idx = size_t{0}; run_idx <= run_count; ++run_idx) {
+    run_bounds[run_idx] = run_idx * values.size() / run_count;
+  }
+
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+  jobs.reserve(run_count);
+  for (auto run_idx = size_t{0}; run_idx < run_count; ++run_idx) {
+    jobs.emplace_back(std::make_shared<JobTask>([&, run_idx]() {
+      std::stable_sort(values.begin() + run_bounds[run_idx], values.begin() + run_bounds[run_idx + 1], comparator);
+    }));
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+  auto buffer = Values(values.size());
+  auto* source = &values;
+  auto* target = &buffer;
+  while (run_bounds.size() > 2) {
+    auto merged_run_bounds = std::vector<size_t>{0};
+    jobs.clear();
+    for (auto run_idx = size_t{0}; run_idx + 1 < run_bounds.size(); run_idx += 2) {
+      // An odd run without a partner is merged with an empty run, i.e., copied.
+      const auto begin = run_bounds[run_idx];
+      const auto middle = run_bounds[run_idx + 1];
+      const auto end = run_idx + 2 < run_bounds.size() ? run_bounds[run_idx + 2] : middle;
+      jobs.emplace_back(std::make_shared<JobTask>([&, source, target, begin, middle, end]() {
+        std::merge(source->begin() + begin, source->begin() + middle, source->begin() + middle, source->begin() + end,
+                   target->begin() + begin, comparator);
+      }));
+      merged_run_bounds.emplace_back(end);
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+    std::swap(source, target);
+    run_bounds = std::move(merged_run_bounds);
+  }
+
+  if (source != &values) {
+    values = std::move(buffer);
+  }
+}
+
+// Writes a binary-comparable representation of value to key, i.e., comparing two representations with memcmp yields
+// the same order as comparing the values. Integers are stored in big-endian order with their sign bit flipped. For
+// floating-point numbers, the sign bit is flipped for positive numbers and all bits are flipped for negative numbers.
+// Strings are padded with zeros to value_width - 1 bytes, followed by their length, so that a string is ordered before
+// any longer string that it is a prefix of.
+template <typename T>
+void write_normalized_value(const T& value, uint8_t* key, const size_t value_width) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    DebugAssert(value.size() < value_width && value.size() <= std::numeric_limits<uint8_t>::max(),
+                "String is too long for the normalized key");
+    std::memcpy(key, value.data(), value.size());
+    std::memset(key + value.size(), 0, value_width - 1 - value.size());
+    key[value_width - 1] = static_cast<uint8_t>(value.size());
+  } else {
+    using UnsignedType = std::conditional_t<sizeof(T) == 4, uint32_t, uint64_t>;
+    static_assert(sizeof(T) == sizeof(UnsignedType), "Unexpected size of sort column type");
+    constexpr auto SIGN_BIT = UnsignedType{1} << (sizeof(T) * 8 - 1);
+
+    auto bits = UnsignedType{};
+    if constexpr (std::is_floating_point_v<T>) {
+      // -0.0 and 0.0 are equal and have to keep their relative order. Thus, both are represented like 0.0.
+      const auto normalized_value = value == T{0} ? T{0} : value;
+      std::memcpy(&bits, &normalized_value, sizeof(T));
+      bits = (bits & SIGN_BIT) ? ~bits : bits | SIGN_BIT;
+    } else {
+      std::memcpy(&bits, &value, sizeof(T));
+      bits ^= SIGN_BIT;
+    }
+
+    for (auto byte_idx = size_t{0}; byte_idx < sizeof(T); ++byte_idx) {
+      key[byte_idx] = static_cast<uint8_t>(bits >> ((sizeof(T) - 1 - byte_idx) * 8));
+    }
+  }
+}
+
 }  // namespace
 
 namespace opossum {
@@ -245,6 +321,226 @@ std::shared_ptr<AbstractOperator> Sort::_on_deep_copy(
 
 void Sort::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
+class Sort::NormalizedKeySortImpl {
+ public:
+  std::chrono::nanoseconds materialization_time{};
+  std::chrono::nanoseconds temporary_result_writing_time{};
+  std::chrono::nanoseconds sort_time{};
+
+  NormalizedKeySortImpl(const std::shared_ptr<const Table>& table_in,
+                        const std::vector<SortColumnDefinition>& sort_definitions)
+      : _table_in(table_in), _sort_definitions(sort_definitions) {}
+
+  // Sorts table_in by all sort columns at once. Returns std::nullopt if the normalized keys would be wider than
+  // MAX_NORMALIZED_KEY_WIDTH, in which case table_in has to be sorted using SortImpl.
+  std::optional<RowIDPosList> sort() {
+    Timer timer;
+    if (!_layout_key_columns()) {
+      materialization_time = timer.lap();
+      return std::nullopt;
+    }
+
+    // Keys of up to eight bytes are packed into integers and sorted together with their RowIDs, which avoids the
+    // indirection of comparing the keys of RowIDs.
+    if (_key_width <= sizeof(uint64_t)) {
+      auto packed_keys = std::vector<PackedKey>(_table_in->row_count());
+      _materialize_keys(&packed_keys, nullptr);
+      materialization_time = timer.lap();
+
+      parallel_stable_sort(packed_keys, [](const PackedKey& lhs, const PackedKey& rhs) { return lhs.key < rhs.key; });
+      sort_time = timer.lap();
+
+      auto pos_list = RowIDPosList(packed_keys.size());
+      for (auto row_index = size_t{0}; row_index < packed_keys.size(); ++row_index) {
+        pos_list[row_index] = packed_keys[row_index].row_id;
+      }
+      temporary_result_writing_time = timer.lap();
+      return pos_list;
+    }
+
+    // Wider keys are stored in a single buffer. The RowIDs in table order are sorted by comparing the keys they point
+    // to, so that the sorted RowIDs are the result without further writing.
+    auto pos_list = RowIDPosList(_table_in->row_count());
+    _materialize_keys(nullptr, &pos_list);
+    materialization_time = timer.lap();
+
+    const auto* const keys = _keys.data();
+    const auto& chunk_begins = _chunk_begins;
+    const auto key_width = _key_width;
+    const auto key_of = [&](const RowID& row_id) {
+      return keys + (chunk_begins[row_id.chunk_id] + row_id.chunk_offset) * key_width;
+    };
+    parallel_stable_sort(pos_list, [&](const RowID& lhs, const RowID& rhs) {
+      return std::memcmp(key_of(lhs), key_of(rhs), key_width) < 0;
+    });
+    sort_time = timer.lap();
+
+    return pos_list;
+  }
+
+ protected:
+  struct PackedKey {
+    uint64_t key;
+    RowID row_id;
+  };
+
+  // Describes the part of the normalized key that is written for a sort column. For nullable columns, this part starts
+  // with a byte that is 0 for NULL and 1 for all other values, so that NULLs come first, independent of the sort mode
+  // (see SortImpl::sort). For descending sort modes, all bits of the value are flipped.
+  struct KeyColumn {
+    ColumnID column_id{INVALID_COLUMN_ID};
+    SortMode sort_mode{SortMode::Ascending};
+    bool nullable{false};
+    size_t offset{0};
+    size_t value_width{0};
+  };
+
+  // Determines the layout of the normalized keys. Fails if they would be wider than MAX_NORMALIZED_KEY_WIDTH.
+  bool _layout_key_columns() {
+    const auto chunk_count = _table_in->chunk_count();
+    _chunk_begins.resize(chunk_count + 1);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto chunk = _table_in->get_chunk(chunk_id);
+      Assert(chunk, "Did not expect deleted chunk here.");  // see https://github.com/hyrise/hyrise/issues/1686
+      _chunk_begins[chunk_id + 1] = _chunk_begins[chunk_id] + chunk->size();
+    }
+
+    // Strings are stored with the length of the longest string of their column. Determining it requires a scan of
+    // each string column, which is done in parallel for all chunks.
+    const auto sort_definition_count = _sort_definitions.size();
+    auto max_string_lengths_per_chunk = std::vector<std::vector<size_t>>(chunk_count);
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        auto& max_string_lengths = max_string_lengths_per_chunk[chunk_id];
+        max_string_lengths.resize(sort_definition_count);
+        for (auto sort_definition_idx = size_t{0}; sort_definition_idx < sort_definition_count; ++sort_definition_idx) {
+          const auto column_id = _sort_definitions[sort_definition_idx].column;
+          if (_table_in->column_data_type(column_id) != DataType::String) continue;
+
+          const auto& segment = _table_in->get_chunk(chunk_id)->get_segment(column_id);
+          auto& max_string_length = max_string_lengths[sort_definition_idx];
+          segment_iterate<pmr_string>(*segment, [&](const auto& position) {
+            if (position.is_null()) return;
+            max_string_length = std::max(max_string_length, position.value().size());
+          });
+        }
+      }));
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+
+    _key_width = 0;
+    for (auto sort_definition_idx = size_t{0}; sort_definition_idx < sort_definition_count; ++sort_definition_idx) {
+      const auto& sort_definition = _sort_definitions[sort_definition_idx];
+      auto key_column = KeyColumn{};
+      key_column.column_id = sort_definition.column;
+      key_column.sort_mode = sort_definition.sort_mode;
+      key_column.nullable = _table_in->column_is_nullable(sort_definition.column);
+      key_column.offset = _key_width;
+
+      resolve_data_type(_table_in->column_data_type(sort_definition.column), [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
+        if constexpr (std::is_same_v<ColumnDataType, pmr_string>) {
+          auto max_string_length = size_t{0};
+          for (const auto& max_string_lengths : max_string_lengths_per_chunk) {
+            max_string_length = std::max(max_string_length, max_string_lengths[sort_definition_idx]);
+          }
+          // One additional byte stores the length of the string.
+          key_column.value_width = max_string_length + 1;
+        } else {
+          key_column.value_width = sizeof(ColumnDataType);
+        }
+      });
+
+      _key_width += (key_column.nullable ? 1 : 0) + key_column.value_width;
+      if (_key_width > MAX_NORMALIZED_KEY_WIDTH) return false;
+
+      _key_columns.emplace_back(key_column);
+    }
+
+    return true;
+  }
+
+  // Writes the normalized keys in parallel for all chunks. Packed keys are written to packed_keys, other keys to
+  // _keys, in which case pos_list is filled with the RowIDs in table order.
+  void _materialize_keys(std::vector<PackedKey>* packed_keys, RowIDPosList* pos_list) {
+    const auto chunk_count = _table_in->chunk_count();
+    if (!packed_keys) {
+      _keys.resize(_table_in->row_count() * _key_width);
+    }
+
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    jobs.reserve(chunk_count);
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&, chunk_id]() {
+        const auto chunk = _table_in->get_chunk(chunk_id);
+        const auto chunk_size = chunk->size();
+        const auto chunk_begin = _chunk_begins[chunk_id];
+
+        // Packed keys are first written to a buffer for the chunk.
+        auto packed_key_buffer = std::vector<uint8_t>(packed_keys ? chunk_size * _key_width : 0);
+        auto* const chunk_keys = packed_keys ? packed_key_buffer.data() : _keys.data() + chunk_begin * _key_width;
+
+        for (const auto& key_column : _key_columns) {
+          resolve_data_type(_table_in->column_data_type(key_column.column_id), [&](auto type) {
+            using ColumnDataType = typename decltype(type)::type;
+
+            const auto& segment = chunk->get_segment(key_column.column_id);
+            segment_iterate<ColumnDataType>(*segment, [&](const auto& position) {
+              auto* key = chunk_keys + position.chunk_offset() * _key_width + key_column.offset;
+              if (key_column.nullable) {
+                *key = position.is_null() ? 0 : 1;
+                ++key;
+              }
+
+              if (position.is_null()) {
+                std::memset(key, 0, key_column.value_width);
+                return;
+              }
+
+              write_normalized_value(position.value(), key, key_column.value_width);
+              if (key_column.sort_mode == SortMode::Descending) {
+                for (auto byte_idx = size_t{0}; byte_idx < key_column.value_width; ++byte_idx) {
+                  key[byte_idx] = static_cast<uint8_t>(~key[byte_idx]);
+                }
+              }
+            });
+          });
+        }
+
+        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+          const auto row_id = RowID{chunk_id, chunk_offset};
+          if (!packed_keys) {
+            (*pos_list)[chunk_begin + chunk_offset] = row_id;
+            continue;
+          }
+
+          // Load the key in big-endian order, aligned to the most significant byte.
+          const auto* const key = chunk_keys + chunk_offset * _key_width;
+          auto packed_key = uint64_t{0};
+          for (auto byte_idx = size_t{0}; byte_idx < sizeof(uint64_t); ++byte_idx) {
+            packed_key = (packed_key << 8u) | (byte_idx < _key_width ? key[byte_idx] : uint8_t{0});
+          }
+          (*packed_keys)[chunk_begin + chunk_offset] = PackedKey{packed_key, row_id};
+        }
+      }));
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+  }
+
+  const std::shared_ptr<const Table> _table_in;
+  const std::vector<SortColumnDefinition>& _sort_definitions;
+
+  std::vector<KeyColumn> _key_columns;
+  size_t _key_width{0};
+
+  // Index of the first row of each chunk in the keys. Has an additional entry for the end of the last chunk.
+  std::vector<size_t> _chunk_begins;
+
+  // Normalized keys of all rows in table order, each being _key_width bytes wide. Unused for packed keys.
+  uninitialized_vector<uint8_t> _keys;
+};
+
 std::shared_ptr<const Table> Sort::_on_execute() {
   const auto& input_table = left_input_table();
 
@@ -273,20 +569,28 @@ std::shared_ptr<const Table> Sort::_on_execute() {
   auto total_temporary_result_writing_time = std::chrono::nanoseconds{};
   auto total_sort_time = std::chrono::nanoseconds{};
 
-  for (auto sort_step = static_cast<int64_t>(_sort_definitions.size() - 1); sort_step >= 0; --sort_step) {
-    const auto& sort_definition = _sort_definitions[sort_step];
-    const auto data_type = input_table->column_data_type(sort_definition.column);
+  auto normalized_key_sort_impl = NormalizedKeySortImpl(input_table, _sort_definitions);
+  previously_sorted_pos_list = normalized_key_sort_impl.sort();
+  total_materialization_time += normalized_key_sort_impl.materialization_time;
+  total_temporary_result_writing_time += normalized_key_sort_impl.temporary_result_writing_time;
+  total_sort_time += normalized_key_sort_impl.sort_time;
 
-    resolve_data_type(data_type, [&](auto type) {
-      using ColumnDataType = typename decltype(type)::type;
+  if (!previously_sorted_pos_list) {
+    for (auto sort_step = static_cast<int64_t>(_sort_definitions.size() - 1); sort_step >= 0; --sort_step) {
+      const auto& sort_definition = _sort_definitions[sort_step];
+      const auto data_type = input_table->column_data_type(sort_definition.column);
 
-      auto sort_impl = SortImpl<ColumnDataType>(input_table, sort_definition.column, sort_definition.sort_mode);
-      previously_sorted_pos_list = sort_impl.sort(previously_sorted_pos_list);
+      resolve_data_type(data_type, [&](auto type) {
+        using ColumnDataType = typename decltype(type)::type;
 
-      total_materialization_time += sort_impl.materialization_time;
-      total_temporary_result_writing_time += sort_impl.temporary_result_writing_time;
-      total_sort_time += sort_impl.sort_time;
-    });
+        auto sort_impl = SortImpl<ColumnDataType>(input_table, sort_definition.column, sort_definition.sort_mode);
+        previously_sorted_pos_list = sort_impl.sort(previously_sorted_pos_list);
+
+        total_materialization_time += sort_impl.materialization_time;
+        total_temporary_result_writing_time += sort_impl.temporary_result_writing_time;
+        total_sort_time += sort_impl.sort_time;
+      });
+    }
   }
 
   auto& step_performance_data = dynamic_cast<OperatorPerformanceData<OperatorSteps>&>(*performance_data);
@@ -18,6 +18,10 @@ namespace opossum {
  * Operator to sort a table by one or multiple columns. This implements a stable sort, i.e., rows that share the same
  * value will maintain their relative order.
  * By passing multiple sort column definitions it is possible to sort multiple columns with one operator run.
+ *
+ * Usually, the values of all sort columns are encoded into a single, binary-comparable key per row (see
+ * NormalizedKeySortImpl), which is sorted in parallel. If these keys would become too wide (e.g., because of long
+ * strings), the table is sorted by one column after the other, starting with the least significant one (see SortImpl).
  */
 class Sort : public AbstractReadOnlyOperator {
  public:
@@ -33,6 +37,9 @@ class Sort : public AbstractReadOnlyOperator {
 
   const std::string& name() const override;
 
+  // Maximum width of the normalized keys in bytes. Wider keys are too expensive to materialize and compare.
+  static constexpr auto MAX_NORMALIZED_KEY_WIDTH = size_t{128};
+
  protected:
   std::shared_ptr<const Table> _on_execute() override;
   std::shared_ptr<AbstractOperator> _on_deep_copy(
@@ -47,6 +54,8 @@ class Sort : public AbstractReadOnlyOperator {
   template <typename SortColumnType>
   class SortImplMaterializeOutput;
 
+  class NormalizedKeySortImpl;
+
   const std::vector<SortColumnDefinition> _sort_definitions;
   const ChunkOffset _output_chunk_size;
   const ForceMaterialization _force_materialization;
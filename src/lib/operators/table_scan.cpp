@@ -22,10 +22,12 @@
 #include "hyrise.hpp"
 #include "lossless_cast.hpp"
 #include "operators/operator_scan_predicate.hpp"
+#include "operators/runtime_filter.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 #include "storage/abstract_segment.hpp"
 #include "storage/chunk.hpp"
+#include "storage/numa_placement.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "table_scan/column_between_table_scan_impl.hpp"
@@ -81,10 +83,18 @@ std::string TableScan::description(DescriptionMode description_mode) const {
   return stream.str();
 }
 
+void TableScan::add_runtime_filter(const std::shared_ptr<RuntimeFilter>& runtime_filter, const ColumnID column_id) {
+  _runtime_filters.emplace_back(runtime_filter, column_id);
+}
+
 void TableScan::_on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) {
   expressions_set_transaction_context({_predicate}, transaction_context);
 }
 
+void TableScan::_on_set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) {
+  expressions_set_memory_budget_resource({_predicate}, memory_budget_resource);
+}
+
 void TableScan::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {
   expression_set_parameters(_predicate, parameters);
 }
@@ -102,6 +112,15 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
   _impl = create_impl();
   _impl_description = _impl->description();
 
+  // Runtime filters are only applied if the build side's join column has the same data type
+  auto runtime_filters = std::vector<std::pair<std::shared_ptr<RuntimeFilter>, ColumnID>>{};
+  for (const auto& [runtime_filter, column_id] : _runtime_filters) {
+    if (runtime_filter->prepare(in_table->column_data_type(column_id))) {
+      runtime_filters.emplace_back(runtime_filter, column_id);
+    }
+  }
+  auto num_rows_removed_by_runtime_filters = std::atomic<size_t>{0};
+
   std::mutex output_mutex;
 
   const auto excluded_chunk_set = std::unordered_set<ChunkID>{excluded_chunk_ids.cbegin(), excluded_chunk_ids.cend()};
@@ -119,92 +138,21 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
     Assert(chunk_in, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
     // chunk_in – Copy by value since copy by reference is not possible due to the limited scope of the for-iteration.
-    auto perform_table_scan = [this, chunk_id, chunk_in, &in_table, &output_mutex, &output_chunks]() {
+    auto perform_table_scan = [this, chunk_id, &in_table, &output_mutex, &output_chunks, &runtime_filters,
+                               &num_rows_removed_by_runtime_filters]() {
       // The actual scan happens in the sub classes of BaseTableScanImpl
-      const auto matches_out = _impl->scan_chunk(chunk_id);
-      if (matches_out->empty()) return;
-
-      Segments out_segments;
-      out_segments.reserve(in_table->column_count());
-
-      /**
-       * matches_out contains a list of row IDs into this chunk. If this is not a reference table, we can directly use
-       * the matches to construct the reference segments of the output. If it is a reference segment, we need to
-       * resolve the row IDs so that they reference the physical data segments (value, dictionary) instead, since we
-       * don’t allow multi-level referencing. To save time and space, we want to share position lists between segments
-       * as much as possible. Position lists can be shared between two segments iff (a) they point to the same table
-       * and (b) the reference segments of the input table point to the same positions in the same order (i.e. they
-       * share their position list).
-       */
-      auto keep_chunk_sort_order = true;
-      if (in_table->type() == TableType::References) {
-        if (matches_out->size() == chunk_in->size()) {
-          // Shortcut - the entire input reference segment matches, so we can simply forward that chunk
-          for (ColumnID column_id{0u}; column_id < in_table->column_count(); ++column_id) {
-            const auto segment_in = chunk_in->get_segment(column_id);
-            out_segments.emplace_back(segment_in);
-          }
-        } else {
-          auto filtered_pos_lists = std::map<std::shared_ptr<const AbstractPosList>, std::shared_ptr<RowIDPosList>>{};
-
-          for (ColumnID column_id{0u}; column_id < in_table->column_count(); ++column_id) {
-            const auto segment_in = chunk_in->get_segment(column_id);
-
-            auto ref_segment_in = std::dynamic_pointer_cast<const ReferenceSegment>(segment_in);
-            DebugAssert(ref_segment_in, "All segments should be of type ReferenceSegment.");
-
-            const auto pos_list_in = ref_segment_in->pos_list();
-
-            const auto table_out = ref_segment_in->referenced_table();
-            const auto column_id_out = ref_segment_in->referenced_column_id();
-
-            auto& filtered_pos_list = filtered_pos_lists[pos_list_in];
-
-            if (!filtered_pos_list) {
-              filtered_pos_list = std::make_shared<RowIDPosList>(matches_out->size());
-              if (pos_list_in->references_single_chunk()) {
-                filtered_pos_list->guarantee_single_chunk();
-              } else {
-                // When segments reference multiple chunks, we do not keep the sort order of the input chunk. The main
-                // reason is that several table scan implementations split the pos lists by chunks (see
-                // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment) and thus shuffle the data. While
-                // this does not affect all scan implementations, we chose the safe and defensive path for now.
-                keep_chunk_sort_order = false;
-              }
-
-              size_t offset = 0;
-              for (const auto& match : *matches_out) {
-                const auto row_id = (*pos_list_in)[match.chunk_offset];
-                (*filtered_pos_list)[offset] = row_id;
-                ++offset;
-              }
-            }
-
-            const auto ref_segment_out =
-                std::make_shared<ReferenceSegment>(table_out, column_id_out, filtered_pos_list);
-            out_segments.push_back(ref_segment_out);
-          }
-        }
-      } else {
-        matches_out->guarantee_single_chunk();
-
-        // If the entire chunk is matched, create an EntireChunkPosList instead
-        const auto output_pos_list = matches_out->size() == chunk_in->size()
-                                         ? static_cast<std::shared_ptr<AbstractPosList>>(
-                                               std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size()))
-                                         : static_cast<std::shared_ptr<AbstractPosList>>(matches_out);
+      auto matches_out = _impl->scan_chunk(chunk_id);
 
-        for (auto column_id = ColumnID{0u}; column_id < in_table->column_count(); ++column_id) {
-          const auto ref_segment_out = std::make_shared<ReferenceSegment>(in_table, column_id, output_pos_list);
-          out_segments.push_back(ref_segment_out);
-        }
+      for (const auto& [runtime_filter, column_id] : runtime_filters) {
+        if (matches_out->empty()) break;
+        const auto match_count = matches_out->size();
+        matches_out = runtime_filter->filter(in_table->get_chunk(chunk_id)->get_segment(column_id), matches_out);
+        num_rows_removed_by_runtime_filters += match_count - matches_out->size();
       }
 
-      const auto chunk = std::make_shared<Chunk>(out_segments, nullptr, chunk_in->get_allocator());
-      chunk->finalize();
-      if (keep_chunk_sort_order && !chunk_in->individually_sorted_by().empty()) {
-        chunk->set_individually_sorted_by(chunk_in->individually_sorted_by());
-      }
+      if (matches_out->empty()) return;
+
+      const auto chunk = create_output_chunk(in_table, chunk_id, matches_out);
       std::lock_guard<std::mutex> lock(output_mutex);
       output_chunks.emplace_back(chunk);
     };
@@ -213,6 +161,8 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
     constexpr auto JOB_SPAWN_THRESHOLD = ChunkOffset{500};
     if (chunk_in->size() >= JOB_SPAWN_THRESHOLD) {
       auto job_task = std::make_shared<JobTask>(perform_table_scan);
+      // Scan the chunk on the NUMA node that holds its data (if it was placed, see place_chunks_on_numa_nodes)
+      job_task->set_preferred_node_id(preferred_numa_node_id(*in_table, chunk_id));
       jobs.push_back(job_task);
     } else {
       perform_table_scan();
@@ -225,10 +175,100 @@ std::shared_ptr<const Table> TableScan::_on_execute() {
   scan_performance_data.num_chunks_with_early_out = _impl->num_chunks_with_early_out.load();
   scan_performance_data.num_chunks_with_all_rows_matching = _impl->num_chunks_with_all_rows_matching.load();
   scan_performance_data.num_chunks_with_binary_search = _impl->num_chunks_with_binary_search.load();
+  scan_performance_data.num_rows_removed_by_runtime_filters = num_rows_removed_by_runtime_filters.load();
 
   return std::make_shared<Table>(in_table->column_definitions(), TableType::References, std::move(output_chunks));
 }
 
+std::shared_ptr<Chunk> TableScan::create_output_chunk(const std::shared_ptr<const Table>& in_table,
+                                                      const ChunkID chunk_id,
+                                                      const std::shared_ptr<RowIDPosList>& matches_out) {
+  const auto chunk_in = in_table->get_chunk(chunk_id);
+  Assert(chunk_in, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+
+  Segments out_segments;
+  out_segments.reserve(in_table->column_count());
+
+  /**
+   * matches_out contains a list of row IDs into this chunk. If this is not a reference table, we can directly use
+   * the matches to construct the reference segments of the output. If it is a reference segment, we need to
+   * resolve the row IDs so that they reference the physical data segments (value, dictionary) instead, since we
+   * don’t allow multi-level referencing. To save time and space, we want to share position lists between segments
+   * as much as possible. Position lists can be shared between two segments iff (a) they point to the same table
+   * and (b) the reference segments of the input table point to the same positions in the same order (i.e. they
+   * share their position list).
+   */
+  auto keep_chunk_sort_order = true;
+  if (in_table->type() == TableType::References) {
+    if (matches_out->size() == chunk_in->size()) {
+      // Shortcut - the entire input reference segment matches, so we can simply forward that chunk
+      for (ColumnID column_id{0u}; column_id < in_table->column_count(); ++column_id) {
+        const auto segment_in = chunk_in->get_segment(column_id);
+        out_segments.emplace_back(segment_in);
+      }
+    } else {
+      auto filtered_pos_lists = std::map<std::shared_ptr<const AbstractPosList>, std::shared_ptr<RowIDPosList>>{};
+
+      for (ColumnID column_id{0u}; column_id < in_table->column_count(); ++column_id) {
+        const auto segment_in = chunk_in->get_segment(column_id);
+
+        auto ref_segment_in = std::dynamic_pointer_cast<const ReferenceSegment>(segment_in);
+        DebugAssert(ref_segment_in, "All segments should be of type ReferenceSegment.");
+
+        const auto pos_list_in = ref_segment_in->pos_list();
+
+        const auto table_out = ref_segment_in->referenced_table();
+        const auto column_id_out = ref_segment_in->referenced_column_id();
+
+        auto& filtered_pos_list = filtered_pos_lists[pos_list_in];
+
+        if (!filtered_pos_list) {
+          filtered_pos_list = std::make_shared<RowIDPosList>(matches_out->size());
+          if (pos_list_in->references_single_chunk()) {
+            filtered_pos_list->guarantee_single_chunk();
+          } else {
+            // When segments reference multiple chunks, we do not keep the sort order of the input chunk. The main
+            // reason is that several table scan implementations split the pos lists by chunks (see
+            // AbstractDereferencedColumnTableScanImpl::_scan_reference_segment) and thus shuffle the data. While
+            // this does not affect all scan implementations, we chose the safe and defensive path for now.
+            keep_chunk_sort_order = false;
+          }
+
+          size_t offset = 0;
+          for (const auto& match : *matches_out) {
+            const auto row_id = (*pos_list_in)[match.chunk_offset];
+            (*filtered_pos_list)[offset] = row_id;
+            ++offset;
+          }
+        }
+
+        const auto ref_segment_out = std::make_shared<ReferenceSegment>(table_out, column_id_out, filtered_pos_list);
+        out_segments.push_back(ref_segment_out);
+      }
+    }
+  } else {
+    matches_out->guarantee_single_chunk();
+
+    // If the entire chunk is matched, create an EntireChunkPosList instead
+    const auto output_pos_list = matches_out->size() == chunk_in->size()
+                                     ? static_cast<std::shared_ptr<AbstractPosList>>(
+                                           std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size()))
+                                     : static_cast<std::shared_ptr<AbstractPosList>>(matches_out);
+
+    for (auto column_id = ColumnID{0u}; column_id < in_table->column_count(); ++column_id) {
+      const auto ref_segment_out = std::make_shared<ReferenceSegment>(in_table, column_id, output_pos_list);
+      out_segments.push_back(ref_segment_out);
+    }
+  }
+
+  const auto chunk = std::make_shared<Chunk>(out_segments, nullptr, chunk_in->get_allocator());
+  chunk->finalize();
+  if (keep_chunk_sort_order && !chunk_in->individually_sorted_by().empty()) {
+    chunk->set_individually_sorted_by(chunk_in->individually_sorted_by());
+  }
+  return chunk;
+}
+
 std::shared_ptr<const AbstractExpression> TableScan::_resolve_uncorrelated_subqueries(
     const std::shared_ptr<const AbstractExpression>& predicate) {
   /**
@@ -310,6 +350,24 @@ std::shared_ptr<const AbstractExpression> TableScan::_resolve_uncorrelated_subqu
 }
 
 std::unique_ptr<AbstractTableScanImpl> TableScan::create_impl() {
+  const auto resolved_predicate = _resolve_uncorrelated_subqueries(_predicate);
+
+  auto impl = create_dedicated_impl(left_input_table(), resolved_predicate);
+  if (impl) return impl;
+
+  // Predicate pattern: Everything else. Fall back to ExpressionEvaluator.
+  const auto& uncorrelated_subquery_results =
+      ExpressionEvaluator::populate_uncorrelated_subquery_results_cache(_uncorrelated_subquery_expressions);
+  // Deregister, because we obtained the results and no longer need the subquery plans.
+  for (const auto& pqp_subquery_expression : _uncorrelated_subquery_expressions) {
+    pqp_subquery_expression->pqp->deregister_consumer();
+  }
+  return std::make_unique<ExpressionEvaluatorTableScanImpl>(left_input_table(), resolved_predicate,
+                                                            uncorrelated_subquery_results);
+}
+
+std::unique_ptr<AbstractTableScanImpl> TableScan::create_dedicated_impl(
+    const std::shared_ptr<const Table>& in_table, const std::shared_ptr<const AbstractExpression>& resolved_predicate) {
   /**
    * Select the scanning implementation (`_impl`) to use based on the kind of the expression. For this we have to
    * closely examine the predicate expression.
@@ -318,12 +376,10 @@ std::unique_ptr<AbstractTableScanImpl> TableScan::create_impl() {
    * to the column type, `int_column = 16.25` would turn into `int_column = 16`, which is obviously wrong. As such, we
    * use lossless casts to guarantee safe type conversions. This was introduced by #1550.
    *
-   * Use the ExpressionEvaluator as a powerful, but slower fallback if no dedicated scanning implementation exists for
-   * an expression.
+   * Returns nullptr if no dedicated scanning implementation exists for an expression. In that case, create_impl()
+   * uses the ExpressionEvaluator as a powerful, but slower fallback.
    */
 
-  const auto resolved_predicate = _resolve_uncorrelated_subqueries(_predicate);
-
   if (const auto binary_predicate_expression =
           std::dynamic_pointer_cast<const BinaryPredicateExpression>(resolved_predicate)) {
     auto predicate_condition = binary_predicate_expression->predicate_condition;
@@ -371,23 +427,23 @@ std::unique_ptr<AbstractTableScanImpl> TableScan::create_impl() {
     // Predicate pattern: <column of type string> LIKE <value of type string>
     if (left_column_expression && left_column_expression->data_type() == DataType::String && is_like_predicate &&
         right_value) {
-      return std::make_unique<ColumnLikeTableScanImpl>(left_input_table(), left_column_expression->column_id,
+      return std::make_unique<ColumnLikeTableScanImpl>(in_table, left_column_expression->column_id,
                                                        predicate_condition, boost::get<pmr_string>(*right_value));
     }
 
     // Predicate pattern: <column of type T> <binary predicate_condition> <value of type T>
     if (left_column_expression && right_value) {
-      return std::make_unique<ColumnVsValueTableScanImpl>(left_input_table(), left_column_expression->column_id,
+      return std::make_unique<ColumnVsValueTableScanImpl>(in_table, left_column_expression->column_id,
                                                           predicate_condition, *right_value);
     }
     if (right_column_expression && left_value) {
-      return std::make_unique<ColumnVsValueTableScanImpl>(left_input_table(), right_column_expression->column_id,
+      return std::make_unique<ColumnVsValueTableScanImpl>(in_table, right_column_expression->column_id,
                                                           flip_predicate_condition(predicate_condition), *left_value);
     }
 
     // Predicate pattern: <column> <binary predicate_condition> <column>
     if (left_column_expression && right_column_expression) {
-      return std::make_unique<ColumnVsColumnTableScanImpl>(left_input_table(), left_column_expression->column_id,
+      return std::make_unique<ColumnVsColumnTableScanImpl>(in_table, left_column_expression->column_id,
                                                            predicate_condition, right_column_expression->column_id);
     }
   }
@@ -396,7 +452,7 @@ std::unique_ptr<AbstractTableScanImpl> TableScan::create_impl() {
     // Predicate pattern: <column> IS NULL
     if (const auto left_column_expression =
             std::dynamic_pointer_cast<PQPColumnExpression>(is_null_expression->operand())) {
-      return std::make_unique<ColumnIsNullTableScanImpl>(left_input_table(), left_column_expression->column_id,
+      return std::make_unique<ColumnIsNullTableScanImpl>(in_table, left_column_expression->column_id,
                                                          is_null_expression->predicate_condition);
     }
   }
@@ -440,22 +496,17 @@ std::unique_ptr<AbstractTableScanImpl> TableScan::create_impl() {
     // Predicate pattern: <column of type T> BETWEEN <value of type T> AND <value of type T>
     if (left_column && lower_bound_value && upper_bound_value &&
         lower_bound_value->type() == upper_bound_value->type()) {
-      return std::make_unique<ColumnBetweenTableScanImpl>(left_input_table(), left_column->column_id,
+      return std::make_unique<ColumnBetweenTableScanImpl>(in_table, left_column->column_id,
                                                           *lower_bound_value, *upper_bound_value, predicate_condition);
     }
   }
 
-  // Predicate pattern: Everything else. Fall back to ExpressionEvaluator.
-  const auto& uncorrelated_subquery_results =
-      ExpressionEvaluator::populate_uncorrelated_subquery_results_cache(_uncorrelated_subquery_expressions);
-  // Deregister, because we obtained the results and no longer need the subquery plans.
-  for (const auto& pqp_subquery_expression : _uncorrelated_subquery_expressions) {
-    pqp_subquery_expression->pqp->deregister_consumer();
-  }
-  return std::make_unique<ExpressionEvaluatorTableScanImpl>(left_input_table(), resolved_predicate,
-                                                            uncorrelated_subquery_results);
+  return nullptr;
 }
 
-void TableScan::_on_cleanup() { _impl.reset(); }
+void TableScan::_on_cleanup() {
+  _impl.reset();
+  _runtime_filters.clear();
+}
 
 }  // namespace opossum
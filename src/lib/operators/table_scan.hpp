@@ -3,6 +3,7 @@
 #include <memory>
 #include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "abstract_read_only_operator.hpp"
@@ -14,7 +15,9 @@
 
 namespace opossum {
 
+class Chunk;
 class PQPSubqueryExpression;
+class RuntimeFilter;
 class Table;
 
 class TableScan : public AbstractReadOnlyOperator {
@@ -35,6 +38,21 @@ class TableScan : public AbstractReadOnlyOperator {
    */
   std::unique_ptr<AbstractTableScanImpl> create_impl();
 
+  /**
+   * Create a dedicated TableScanImpl (i.e., not the ExpressionEvaluatorTableScanImpl) for a predicate whose
+   * uncorrelated subqueries have already been resolved. Returns nullptr if there is no dedicated impl for the predicate.
+   */
+  static std::unique_ptr<AbstractTableScanImpl> create_dedicated_impl(
+      const std::shared_ptr<const Table>& in_table, const std::shared_ptr<const AbstractExpression>& resolved_predicate);
+
+  /**
+   * Build the output chunk of a scan from the matches of the chunk `chunk_id` of `in_table`. Reference segments are
+   * resolved so that the output never references another reference segment.
+   */
+  static std::shared_ptr<Chunk> create_output_chunk(const std::shared_ptr<const Table>& in_table,
+                                                    const ChunkID chunk_id,
+                                                    const std::shared_ptr<RowIDPosList>& matches_out);
+
   /**
    * @brief If set, the specified chunks will not be scanned.
    *
@@ -51,10 +69,17 @@ class TableScan : public AbstractReadOnlyOperator {
    */
   std::vector<ChunkID> excluded_chunk_ids;
 
+  /**
+   * Matches whose value in the column cannot find a join partner on the build side of the runtime filter's hash join
+   * are removed from the output (see RuntimeFilter).
+   */
+  void add_runtime_filter(const std::shared_ptr<RuntimeFilter>& runtime_filter, const ColumnID column_id);
+
   struct PerformanceData : public OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps> {
     std::atomic<size_t> num_chunks_with_early_out{0};
     std::atomic<size_t> num_chunks_with_all_rows_matching{0};
     std::atomic<size_t> num_chunks_with_binary_search{0};
+    std::atomic<size_t> num_rows_removed_by_runtime_filters{0};
 
     void output_to_stream(std::ostream& stream, DescriptionMode description_mode) const override {
       OperatorPerformanceData<AbstractOperatorPerformanceData::NoSteps>::output_to_stream(stream, description_mode);
@@ -63,6 +88,9 @@ class TableScan : public AbstractReadOnlyOperator {
       stream << separator << "Chunks: " << num_chunks_with_early_out.load() << " skipped with no results, ";
       stream << separator << num_chunks_with_all_rows_matching.load() << " skipped with all matching, ";
       stream << num_chunks_with_binary_search.load() << " scanned using binary search.";
+      if (num_rows_removed_by_runtime_filters > 0) {
+        stream << separator << "Rows: " << num_rows_removed_by_runtime_filters.load() << " removed by runtime filters.";
+      }
     }
   };
 
@@ -75,6 +103,7 @@ class TableScan : public AbstractReadOnlyOperator {
       std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
 
   void _on_set_transaction_context(const std::weak_ptr<TransactionContext>& transaction_context) override;
+  void _on_set_memory_budget_resource(const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource) override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
   void _on_cleanup() override;
@@ -87,6 +116,7 @@ class TableScan : public AbstractReadOnlyOperator {
  private:
   const std::shared_ptr<AbstractExpression> _predicate;
   std::vector<std::shared_ptr<PQPSubqueryExpression>> _uncorrelated_subquery_expressions;
+  std::vector<std::pair<std::shared_ptr<RuntimeFilter>, ColumnID>> _runtime_filters;
 
   std::unique_ptr<AbstractTableScanImpl> _impl;
 
@@ -3,6 +3,7 @@
 #include <memory>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "resolve_type.hpp"
 #include "storage/chunk.hpp"
@@ -11,6 +12,7 @@
 #include "storage/split_pos_list_by_chunk_id.hpp"
 #include "storage/table.hpp"
 #include "storage/value_segment.hpp"
+#include "storage/vector_compression/bit_packing/bit_packing_vector.hpp"
 
 namespace opossum {
 
@@ -75,4 +77,32 @@ void AbstractDereferencedColumnTableScanImpl::_scan_reference_segment(const Refe
   }
 }
 
+void AbstractDereferencedColumnTableScanImpl::_scan_bit_packing_vector(const BitPackingVector& attribute_vector,
+                                                                       const ValueID begin_value_id,
+                                                                       const ValueID end_value_id,
+                                                                       const ChunkID chunk_id, RowIDPosList& matches) {
+  auto bitmap = std::vector<uint64_t>{};
+  attribute_vector.match_range(begin_value_id, end_value_id, bitmap);
+
+  auto match_count = size_t{0};
+  for (const auto bits : bitmap) {
+    match_count += __builtin_popcountll(bits);
+  }
+
+  // `matches` might already contain entries if it is called multiple times by _scan_reference_segment.
+  auto output_index = matches.size();
+  matches.resize(matches.size() + match_count);
+
+  for (auto word_index = size_t{0}; word_index < bitmap.size(); ++word_index) {
+    auto bits = bitmap[word_index];
+    while (bits) {
+      const auto chunk_offset = static_cast<ChunkOffset>(word_index * 64 + __builtin_ctzll(bits));
+      matches[output_index] = RowID{chunk_id, chunk_offset};
+      ++output_index;
+      // Clear the lowest set bit
+      bits &= bits - 1;
+    }
+  }
+}
+
 }  // namespace opossum
@@ -14,6 +14,7 @@ class Table;
 class ReferenceSegment;
 class AbstractSegment;
 class BaseDictionarySegment;
+class BitPackingVector;
 class AttributeVectorIterable;
 
 /**
@@ -42,6 +43,12 @@ class AbstractDereferencedColumnTableScanImpl : public AbstractTableScanImpl {
                                            RowIDPosList& matches,
                                            const std::shared_ptr<const AbstractPosList>& position_filter) = 0;
 
+  // Appends all rows whose value ID v fulfills begin_value_id <= v < end_value_id. Instead of decompressing each value
+  // ID, the range is evaluated on the bit-packed attribute vector (see BitPackingVector::match_range). As the result
+  // is a bitmap over the entire segment, this cannot be used with a position_filter.
+  static void _scan_bit_packing_vector(const BitPackingVector& attribute_vector, const ValueID begin_value_id,
+                                       const ValueID end_value_id, const ChunkID chunk_id, RowIDPosList& matches);
+
   const std::shared_ptr<const Table> _in_table;
   const ColumnID _column_id;
 };
@@ -11,6 +11,7 @@
 #include "storage/segment_iterables/create_iterable_from_attribute_vector.hpp"
 #include "storage/segment_iterate.hpp"
 #include "storage/table.hpp"
+#include "storage/vector_compression/bit_packing/bit_packing_vector.hpp"
 
 #include "utils/assert.hpp"
 
@@ -159,6 +160,12 @@ void ColumnBetweenTableScanImpl::_scan_dictionary_segment(
     upper_bound_value_id = segment.unique_values_count();
   }
 
+  if (const auto* bit_packing_vector = dynamic_cast<const BitPackingVector*>(segment.attribute_vector().get());
+      bit_packing_vector && !position_filter) {
+    _scan_bit_packing_vector(*bit_packing_vector, lower_bound_value_id, upper_bound_value_id, chunk_id, matches);
+    return;
+  }
+
   const auto value_id_diff = upper_bound_value_id - lower_bound_value_id;
   const auto comparator = [lower_bound_value_id, value_id_diff](const auto& position) {
     // Using < here because the right value id is the upper_bound. Also, because the value ids are integers, we can do
@@ -10,6 +10,7 @@
 #include "storage/resolve_encoded_segment_type.hpp"
 #include "storage/segment_iterables/create_iterable_from_attribute_vector.hpp"
 #include "storage/segment_iterate.hpp"
+#include "storage/vector_compression/bit_packing/bit_packing_vector.hpp"
 
 #include "resolve_type.hpp"
 #include "type_comparison.hpp"
@@ -147,6 +148,33 @@ void ColumnVsValueTableScanImpl::_scan_dictionary_segment(
     return;
   }
 
+  // Except for !=, the matching value IDs form a range, which can be evaluated directly on bit-packed value IDs.
+  // NULL is represented by unique_values_count() and is never part of the range.
+  const auto* bit_packing_vector = dynamic_cast<const BitPackingVector*>(segment.attribute_vector().get());
+  if (bit_packing_vector && !position_filter && predicate_condition != PredicateCondition::NotEquals) {
+    switch (predicate_condition) {
+      case PredicateCondition::Equals:
+        _scan_bit_packing_vector(*bit_packing_vector, search_value_id, ValueID{search_value_id + 1}, chunk_id,
+                                 matches);
+        return;
+
+      case PredicateCondition::LessThan:
+      case PredicateCondition::LessThanEquals:
+        _scan_bit_packing_vector(*bit_packing_vector, ValueID{0}, search_value_id, chunk_id, matches);
+        return;
+
+      case PredicateCondition::GreaterThan:
+      case PredicateCondition::GreaterThanEquals:
+        _scan_bit_packing_vector(*bit_packing_vector, search_value_id,
+                                 ValueID{static_cast<ValueID::base_type>(segment.unique_values_count())}, chunk_id,
+                                 matches);
+        return;
+
+      default:
+        Fail("Unsupported comparison type encountered");
+    }
+  }
+
   _with_operator_for_dict_segment_scan([&](auto predicate_comparator) {
     auto comparator = [predicate_comparator, search_value_id](const auto& position) {
       return predicate_comparator(position.value(), search_value_id);
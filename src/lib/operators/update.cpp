@@ -1,7 +1,12 @@
 #include "update.hpp"
 
+#include <algorithm>
+#include <atomic>
 #include <memory>
+#include <optional>
 #include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -9,10 +14,49 @@
 #include "delete.hpp"
 #include "hyrise.hpp"
 #include "insert.hpp"
+#include "logging/wal_commit_record.hpp"
+#include "resolve_type.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table_key_index.hpp"
 #include "table_wrapper.hpp"
 #include "utils/assert.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+std::vector<std::optional<T>> materialize_column(const Table& table, const ColumnID column_id) {
+  auto values = std::vector<std::optional<T>>{};
+  values.reserve(table.row_count());
+
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    segment_iterate<T>(*table.get_chunk(chunk_id)->get_segment(column_id), [&](const auto& position) {
+      if (position.is_null()) {
+        values.emplace_back(std::nullopt);
+      } else {
+        values.emplace_back(position.value());
+      }
+    });
+  }
+
+  return values;
+}
+
+// Returns whether another transaction has locked the row for deletion or the row was deleted. The row may also be
+// locked by the transaction itself if it inserted the row.
+bool is_row_written_concurrently(const MvccData& mvcc_data, const ChunkOffset chunk_offset,
+                                 const TransactionID transaction_id) {
+  const auto row_tid = mvcc_data.get_tid(chunk_offset);
+  return (row_tid != INVALID_TRANSACTION_ID && row_tid != transaction_id) ||
+         mvcc_data.get_end_cid(chunk_offset) != MvccData::MAX_COMMIT_ID;
+}
+
+}  // namespace
+
 namespace opossum {
 
 Update::Update(const std::string& table_to_update_name, const std::shared_ptr<AbstractOperator>& fields_to_update_op,
@@ -35,7 +79,14 @@ std::shared_ptr<const Table> Update::_on_execute(std::shared_ptr<TransactionCont
   DebugAssert(left_input_table()->column_data_types() == right_input_table()->column_data_types(),
               "Update required identical layouts from its input tables");
 
-  // 1. Delete obsolete data with the Delete operator.
+  // 1. Update the rows in place if possible.
+  auto changed_values = _changed_values(*table_to_update);
+  if (changed_values && _can_update_in_place(*table_to_update, *changed_values)) {
+    if (!_update_in_place(*context, *changed_values)) _mark_as_failed();
+    return nullptr;
+  }
+
+  // 2. Otherwise, delete obsolete data with the Delete operator.
   //    Delete doesn't accept empty input data
   if (left_input_table()->row_count() > 0) {
     _delete = std::make_shared<Delete>(_left_input);
@@ -48,7 +99,7 @@ std::shared_ptr<const Table> Update::_on_execute(std::shared_ptr<TransactionCont
     }
   }
 
-  // 2. Insert new data with the Insert operator.
+  // 3. Insert new data with the Insert operator.
   _insert = std::make_shared<Insert>(_table_to_update_name, _right_input);
   _insert->set_transaction_context(context);
   _insert->execute();
@@ -66,4 +117,205 @@ std::shared_ptr<AbstractOperator> Update::_on_deep_copy(
 
 void Update::_on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) {}
 
+void Update::_on_commit_records(const CommitID commit_id) {
+  for (const auto& updated_row : _updated_rows) {
+    updated_row.version->begin_cid = commit_id;
+  }
+}
+
+void Update::_on_rollback_records() {
+  // Versions that the transaction added to the same row later are newer, so the versions are removed in reverse order.
+  for (auto iter = _updated_rows.rbegin(); iter != _updated_rows.rend(); ++iter) {
+    iter->mvcc_data->row_versions()->remove_version(iter->chunk_offset, iter->version);
+  }
+}
+
+void Update::_on_log_records(WalCommitRecordWriter& record_writer) const {
+  // Rows that were not updated in place are logged by the Delete and Insert operators.
+  if (_updated_rows.empty()) return;
+
+  const auto table_to_update = Hyrise::get().storage_manager.get_table(_table_to_update_name);
+  const auto chunk_ids = _chunk_ids_by_mvcc_data(*table_to_update);
+
+  auto updated_rows = std::vector<std::pair<RowID, std::shared_ptr<const RowVersion>>>{};
+  updated_rows.reserve(_updated_rows.size());
+  for (const auto& updated_row : _updated_rows) {
+    const auto chunk_id_iter = chunk_ids.find(updated_row.mvcc_data.get());
+    Assert(chunk_id_iter != chunk_ids.end(), "Updated row does not belong to the updated table");
+    updated_rows.emplace_back(RowID{chunk_id_iter->second, updated_row.chunk_offset}, updated_row.version);
+  }
+
+  record_writer.add_update(_table_to_update_name, *table_to_update, updated_rows);
+}
+
+std::optional<Update::ChangedValues> Update::_changed_values(const Table& table_to_update) const {
+  const auto& left_table = *left_input_table();
+  const auto& right_table = *right_input_table();
+  const auto column_count = table_to_update.column_count();
+
+  if (table_to_update.uses_mvcc() != UseMvcc::Yes || left_table.type() != TableType::References ||
+      left_table.column_count() != column_count || right_table.column_count() != column_count ||
+      right_table.column_data_types() != table_to_update.column_data_types()) {
+    return std::nullopt;
+  }
+
+  // Each row is identified by the RowID of the first column, so all columns need to reference the same rows. The
+  // changed values are stored by the ColumnIDs of the updated table.
+  const auto chunk_count = left_table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = left_table.get_chunk(chunk_id);
+    const auto first_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}));
+    if (!first_segment || first_segment->referenced_table()->column_count() != column_count) return std::nullopt;
+
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      const auto segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(column_id));
+      if (!segment || segment->referenced_table() != first_segment->referenced_table() ||
+          segment->pos_list() != first_segment->pos_list() || segment->referenced_column_id() != column_id) {
+        return std::nullopt;
+      }
+    }
+  }
+
+  auto changed_values = ChangedValues(left_table.row_count());
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    resolve_data_type(table_to_update.column_data_type(column_id), [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto old_values = materialize_column<ColumnDataType>(left_table, column_id);
+      const auto new_values = materialize_column<ColumnDataType>(right_table, column_id);
+      for (auto row_index = size_t{0}; row_index < old_values.size(); ++row_index) {
+        if (old_values[row_index] == new_values[row_index]) continue;
+
+        const auto& new_value = new_values[row_index];
+        changed_values[row_index].emplace_back(column_id, new_value ? AllTypeVariant{*new_value} : NULL_VALUE);
+      }
+    });
+  }
+
+  return changed_values;
+}
+
+bool Update::_can_update_in_place(const Table& table_to_update, const ChangedValues& changed_values) const {
+  auto column_is_changed = std::vector<bool>(table_to_update.column_count());
+  for (const auto& row_values : changed_values) {
+    for (const auto& [column_id, value] : row_values) {
+      if (variant_is_null(value) && !table_to_update.column_is_nullable(column_id)) return false;
+      column_is_changed[column_id] = true;
+    }
+  }
+
+  for (const auto& key_index : table_to_update.key_indexes()) {
+    const auto& key_column_ids = key_index->column_ids();
+    if (std::any_of(key_column_ids.begin(), key_column_ids.end(),
+                    [&](const auto column_id) { return column_is_changed[column_id]; })) {
+      return false;
+    }
+  }
+
+  const auto chunk_ids = _chunk_ids_by_mvcc_data(table_to_update);
+  auto checked_mvcc_data = std::unordered_set<const MvccData*>{};
+
+  const auto& left_table = *left_input_table();
+  const auto chunk_count = left_table.chunk_count();
+  auto row_index = size_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto segment =
+        std::static_pointer_cast<const ReferenceSegment>(left_table.get_chunk(chunk_id)->get_segment(ColumnID{0}));
+    const auto& referenced_table = *segment->referenced_table();
+
+    for (const auto& row_id : *segment->pos_list()) {
+      if (changed_values[row_index++].empty()) continue;
+
+      const auto mvcc_data = referenced_table.get_chunk(row_id.chunk_id)->mvcc_data();
+      if (!mvcc_data) return false;
+      if (!checked_mvcc_data.emplace(mvcc_data.get()).second) continue;
+
+      const auto chunk_id_iter = chunk_ids.find(mvcc_data.get());
+      if (chunk_id_iter == chunk_ids.end()) return false;
+
+      // Mutable chunks might be copied while rows are appended to them. Their segments would have different sizes if
+      // only the changed columns were resolved (see resolve_row_versions).
+      const auto stored_chunk = table_to_update.get_chunk(chunk_id_iter->second);
+      if (stored_chunk->is_mutable() || stored_chunk->has_indexes()) return false;
+
+      const auto& sorted_by = stored_chunk->individually_sorted_by();
+      if (std::any_of(sorted_by.begin(), sorted_by.end(),
+                      [&](const auto& sort_definition) { return column_is_changed[sort_definition.column]; })) {
+        return false;
+      }
+    }
+  }
+
+  return true;
+}
+
+bool Update::_update_in_place(const TransactionContext& context, ChangedValues& changed_values) {
+  const auto transaction_id = context.transaction_id();
+  const auto snapshot_commit_id = context.snapshot_commit_id();
+
+  const auto& left_table = *left_input_table();
+  const auto chunk_count = left_table.chunk_count();
+  auto row_index = size_t{0};
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto segment =
+        std::static_pointer_cast<const ReferenceSegment>(left_table.get_chunk(chunk_id)->get_segment(ColumnID{0}));
+    const auto& referenced_table = *segment->referenced_table();
+
+    for (const auto& row_id : *segment->pos_list()) {
+      auto& values = changed_values[row_index++];
+      const auto mvcc_data = referenced_table.get_chunk(row_id.chunk_id)->mvcc_data();
+
+      // The row was updated by a transaction that has not committed yet or that committed after our snapshot.
+      const auto is_updated_concurrently = [&](const auto& newest_version) {
+        return newest_version && newest_version->transaction_id != transaction_id &&
+               newest_version->begin_cid > snapshot_commit_id;
+      };
+
+      if (values.empty()) {
+        // Rows whose values do not change are not written. Still, the update conflicts with concurrent writes to them,
+        // just like deleting and re-inserting them would.
+        const auto row_versions = mvcc_data ? mvcc_data->row_versions() : nullptr;
+        if (!mvcc_data || is_row_written_concurrently(*mvcc_data, row_id.chunk_offset, transaction_id) ||
+            (row_versions && is_updated_concurrently(row_versions->newest_version(row_id.chunk_offset)))) {
+          return false;
+        }
+        continue;
+      }
+
+      auto row_versions = mvcc_data->get_or_create_row_versions();
+      const auto newest_version = row_versions->newest_version(row_id.chunk_offset);
+      if (is_updated_concurrently(newest_version)) return false;
+
+      if (newest_version) {
+        // Versions contain all values that differ from the main segments. Carry over the values of older versions that
+        // this update does not change.
+        for (const auto& column_id_and_value : newest_version->values) {
+          const auto iter = std::lower_bound(
+              values.begin(), values.end(), column_id_and_value.first,
+              [](const auto& lhs, const auto column_id) { return lhs.first < column_id; });
+          if (iter == values.end() || iter->first != column_id_and_value.first) {
+            values.insert(iter, column_id_and_value);
+          }
+        }
+      }
+
+      const auto version = std::make_shared<RowVersion>(transaction_id, std::move(values));
+      if (!row_versions->add_version(row_id.chunk_offset, newest_version, version)) {
+        // The versions were retired concurrently by merge_row_versions. It merged all versions of the row, so the new
+        // version becomes the first version of the row in the new RowVersions.
+        if (!row_versions->is_retired()) return false;
+        row_versions = mvcc_data->get_or_create_row_versions();
+        if (!row_versions->add_version(row_id.chunk_offset, nullptr, version)) return false;
+      }
+      _updated_rows.emplace_back(UpdatedRow{mvcc_data, row_id.chunk_offset, version});
+
+      // A concurrent Delete locks the row before it checks for versions (see Delete::_on_execute).
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (is_row_written_concurrently(*mvcc_data, row_id.chunk_offset, transaction_id)) return false;
+    }
+  }
+
+  return true;
+}
+
 }  // namespace opossum
@@ -1,16 +1,21 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "abstract_read_write_operator.hpp"
+#include "all_type_variant.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
 
 class Delete;
 class Insert;
+struct MvccData;
+struct RowVersion;
 
 /**
  * Operator that updates a subset of columns of a number of rows and from one table with values supplied in another.
@@ -22,7 +27,16 @@ class Insert;
  *
  * Assumption: The input has been validated before.
  *
- * Note: Update does not support null values at the moment
+ * If possible, rows are updated in place: Only the values of the changed columns are stored as a new RowVersion of the
+ * row, which keeps its RowID and stays valid. This writes less data and does not grow the table. Rows that do not
+ * change are not written at all. Otherwise, the rows are invalidated with the Delete operator and reinserted with
+ * the Insert operator. This is the case if
+ *  - the first input table does not reference all columns of the updated table in their original order,
+ *  - a changed column is part of a TableKeyIndex (which indexes the values in the main segments),
+ *  - an updated row belongs to a mutable chunk (which is still appended to) or to a chunk that has indexes or is
+ *    sorted by a changed column, or
+ *  - a non-nullable column would be set to NULL (which Insert reports as an error).
+ * The decision is made for all rows of the operator at once.
  */
 class Update : public AbstractReadWriteOperator {
  public:
@@ -39,15 +53,35 @@ class Update : public AbstractReadWriteOperator {
       std::unordered_map<const AbstractOperator*, std::shared_ptr<AbstractOperator>>& copied_ops) const override;
   void _on_set_parameters(const std::unordered_map<ParameterID, AllTypeVariant>& parameters) override;
 
-  // Commit happens in Insert and Delete operators
-  void _on_commit_records(const CommitID cid) override {}
+  // If the rows were not updated in place, commit and rollback happen in the Insert and Delete operators.
+  void _on_commit_records(const CommitID commit_id) override;
+  void _on_rollback_records() override;
+  void _on_log_records(WalCommitRecordWriter& record_writer) const override;
 
-  // Rollback happens in Insert and Delete operators
-  void _on_rollback_records() override {}
+  // The values of the changed columns of each row, sorted by ColumnID
+  using ChangedValues = std::vector<std::vector<std::pair<ColumnID, AllTypeVariant>>>;
+
+  // Returns the changed values of the rows, or std::nullopt if the layout of the first input table does not allow
+  // updating the rows in place.
+  std::optional<ChangedValues> _changed_values(const Table& table_to_update) const;
+
+  bool _can_update_in_place(const Table& table_to_update, const ChangedValues& changed_values) const;
+
+  // Returns false if a row was concurrently updated or deleted by another transaction.
+  bool _update_in_place(const TransactionContext& context, ChangedValues& changed_values);
 
  protected:
   const std::string _table_to_update_name;
   std::shared_ptr<Delete> _delete;
   std::shared_ptr<Insert> _insert;
+
+  struct UpdatedRow {
+    std::shared_ptr<MvccData> mvcc_data;
+    ChunkOffset chunk_offset;
+    std::shared_ptr<RowVersion> version;
+  };
+
+  // Rows updated in place, in the order in which their versions were added
+  std::vector<UpdatedRow> _updated_rows;
 };
 }  // namespace opossum
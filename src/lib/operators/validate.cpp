@@ -9,6 +9,7 @@
 #include "hyrise.hpp"
 #include "operators/delete.hpp"
 #include "scheduler/job_task.hpp"
+#include "storage/numa_placement.hpp"
 #include "storage/pos_lists/entire_chunk_pos_list.hpp"
 #include "storage/reference_segment.hpp"
 #include "utils/assert.hpp"
@@ -25,6 +26,41 @@ bool is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id, ChunkOff
   return Validate::is_row_visible(our_tid, snapshot_commit_id, row_tid, begin_cid, end_cid);
 }
 
+// Frozen MVCC data without later changes (see MvccData::freeze) and without invalid rows is entirely visible to all
+// transactions.
+bool is_frozen_chunk_entirely_visible(const MvccData& mvcc_data, CommitID snapshot_commit_id) {
+  return mvcc_data.is_frozen() && !mvcc_data.has_changes_since_freeze() && mvcc_data.frozen_invalid_rows().empty() &&
+         snapshot_commit_id >= *mvcc_data.max_begin_cid;
+}
+
+// If a PosList references less than 1 / BITMAP_MIN_REFERENCED_ROW_SHARE of the rows of a chunk, its rows are
+// checked one by one instead of computing the visibility of all rows of the chunk.
+constexpr auto BITMAP_MIN_REFERENCED_ROW_SHARE = size_t{16};
+
+// Returns the rows of the chunk that are visible to the transaction (see MvccData::visible_rows). Unless the
+// transaction has in-flight deletes, it cannot have locked rows. In this case, the bitmaps of immutable chunks are
+// shared with other transactions (see MvccData::shared_visible_rows).
+std::shared_ptr<const MvccData::VisibleRows> visible_rows(const Chunk& chunk, const MvccData& mvcc_data,
+                                                          TransactionID our_tid, CommitID snapshot_commit_id,
+                                                          bool can_use_chunk_shortcut) {
+  const auto row_count = chunk.size();
+  if (can_use_chunk_shortcut && !chunk.is_mutable()) {
+    const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+    return mvcc_data.shared_visible_rows(row_count, snapshot_commit_id, last_commit_id);
+  }
+
+  auto visible_rows = std::make_shared<MvccData::VisibleRows>();
+  visible_rows->first_snapshot_commit_id = snapshot_commit_id;
+  visible_rows->last_snapshot_commit_id = snapshot_commit_id;
+  visible_rows->row_count = row_count;
+  mvcc_data.visible_rows(our_tid, snapshot_commit_id, row_count, visible_rows->bitmap);
+  return visible_rows;
+}
+
+bool is_bit_set(const std::vector<uint64_t>& bitmap, ChunkOffset chunk_offset) {
+  return (bitmap[chunk_offset / 64] >> (chunk_offset % 64)) & 1;
+}
+
 }  // namespace
 
 bool Validate::is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id, const TransactionID row_tid,
@@ -38,11 +74,7 @@ bool Validate::is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id
   return snapshot_commit_id < end_cid && ((snapshot_commit_id >= begin_cid) != (row_tid == our_tid));
 }
 
-bool Validate::_is_entire_chunk_visible(const std::shared_ptr<const Chunk>& chunk,
-                                        const CommitID snapshot_commit_id) const {
-  Assert(
-      _can_use_chunk_shortcut,
-      "This call to _is_entire_chunk_visible is not allowed. Are there any DeleteOperators in the same transaction?");
+bool Validate::_is_entire_chunk_visible(const std::shared_ptr<const Chunk>& chunk, const CommitID snapshot_commit_id) {
   DebugAssert(!std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0})),
               "_is_entire_chunk_visible cannot be called on reference chunks.");
 
@@ -53,6 +85,14 @@ bool Validate::_is_entire_chunk_visible(const std::shared_ptr<const Chunk>& chun
   return snapshot_commit_id >= max_begin_cid && chunk->invalid_row_count() == 0;
 }
 
+bool Validate::can_use_chunk_shortcut(const std::shared_ptr<TransactionContext>& transaction_context) {
+  const auto& read_write_operators = transaction_context->read_write_operators();
+  for (const auto& read_write_operator : read_write_operators) {
+    if (read_write_operator->type() == OperatorType::Delete) return false;
+  }
+  return true;
+}
+
 Validate::Validate(const std::shared_ptr<AbstractOperator>& in)
     : AbstractReadOnlyOperator(OperatorType::Validate, in) {}
 
@@ -100,13 +140,7 @@ std::shared_ptr<const Table> Validate::_on_execute(std::shared_ptr<TransactionCo
   //     (the max_begin_cid is stored in the chunk, not determined by the ValidateOperator),
   // (4) no rows in the chunk have been invalidated before this transaction was started,
   // (5) the current transaction has no in-flight deletes.
-  const auto& read_write_operators = transaction_context->read_write_operators();
-  for (const auto& read_write_operator : read_write_operators) {
-    if (read_write_operator->type() == OperatorType::Delete) {
-      _can_use_chunk_shortcut = false;
-      break;
-    }
-  }
+  _can_use_chunk_shortcut = can_use_chunk_shortcut(transaction_context);
 
   while (job_end_chunk_id < chunk_count) {
     const auto chunk = in_table->get_chunk(job_end_chunk_id);
@@ -123,10 +157,13 @@ std::shared_ptr<const Table> Validate::_on_execute(std::shared_ptr<TransactionCo
         _validate_chunks(in_table, job_start_chunk_id, job_end_chunk_id, our_tid, snapshot_commit_id, output_chunks,
                          output_mutex);
       } else {
-        jobs.push_back(std::make_shared<JobTask>([=, this, &output_chunks, &output_mutex] {
+        auto job_task = std::make_shared<JobTask>([=, this, &output_chunks, &output_mutex] {
           _validate_chunks(in_table, job_start_chunk_id, job_end_chunk_id, our_tid, snapshot_commit_id, output_chunks,
                            output_mutex);
-        }));
+        });
+        // Bundled chunks may reside on different NUMA nodes. We use the node of the first one.
+        job_task->set_preferred_node_id(preferred_numa_node_id(*in_table, job_start_chunk_id));
+        jobs.push_back(job_task);
 
         // Prepare next job
         job_start_chunk_id = job_end_chunk_id + 1;
@@ -145,154 +182,205 @@ void Validate::_validate_chunks(const std::shared_ptr<const Table>& in_table, co
                                 const ChunkID chunk_id_end, const TransactionID our_tid,
                                 const TransactionID snapshot_commit_id,
                                 std::vector<std::shared_ptr<Chunk>>& output_chunks, std::mutex& output_mutex) const {
-  // Stores whether a chunk has been found to be entirely visible. Only used for reference tables where no single
-  // chunk guarantee has been given. Not stored in Validate object to avoid concurrency issues. This assumes that
-  // only one table is referenced over all chunks. If, in the future, this is not true anymore, entirely_visible_chunks
-  // either needs to be moved into the loop or turn into an `unordered_map<shared_ptr<Table>, vector<bool>>`.
-  auto entirely_visible_chunks = std::vector<bool>{};
-  auto entirely_visible_chunks_table = std::shared_ptr<const Table>{};  // used only for sanity check
+  // Not stored in Validate object to avoid concurrency issues. This assumes that only one table is referenced over all
+  // chunks. If, in the future, this is not true anymore, the cache either needs to be moved into the loop or turn into
+  // an `unordered_map<shared_ptr<Table>, vector<bool>>`.
+  auto entirely_visible_chunks_cache = EntirelyVisibleChunksCache{};
 
   for (auto chunk_id = chunk_id_start; chunk_id <= chunk_id_end; ++chunk_id) {
-    const auto chunk_in = in_table->get_chunk(chunk_id);
-    Assert(chunk_in, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
+    const auto chunk = validate_chunk(in_table, chunk_id, our_tid, snapshot_commit_id, _can_use_chunk_shortcut,
+                                      entirely_visible_chunks_cache);
+    if (!chunk) continue;
 
-    const auto expected_number_of_valid_rows = chunk_in->size() - chunk_in->invalid_row_count();
+    std::lock_guard<std::mutex> lock(output_mutex);
+    output_chunks.emplace_back(chunk);
+  }
+}
 
-    Segments output_segments;
-    std::shared_ptr<const AbstractPosList> pos_list_out = std::make_shared<const RowIDPosList>();
+std::shared_ptr<Chunk> Validate::validate_chunk(const std::shared_ptr<const Table>& in_table, const ChunkID chunk_id,
+                                                const TransactionID our_tid, const CommitID snapshot_commit_id,
+                                                const bool can_use_chunk_shortcut, EntirelyVisibleChunksCache& cache) {
+  auto& entirely_visible_chunks = cache.entirely_visible_chunks;
+  auto& entirely_visible_chunks_table = cache.table;
 
-    const auto ref_segment_in = std::dynamic_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(ColumnID{0}));
+  const auto chunk_in = in_table->get_chunk(chunk_id);
+  Assert(chunk_in, "Physically deleted chunk should not reach this point, see get_chunk / #1686.");
 
-    // Holds the table that contains the MVCC information. For data segments, this is the table that we operate on.
-    // If we are validating a reference segment, this is the table referenced by ref_segment_in.
-    auto referenced_table = std::shared_ptr<const Table>{};
+  const auto expected_number_of_valid_rows = chunk_in->size() - chunk_in->invalid_row_count();
 
-    // If the segments in this chunk reference a segment, build a poslist for a reference segment.
-    if (ref_segment_in) {
-      DebugAssert(chunk_in->references_exactly_one_table(),
-                  "Input to Validate contains a Chunk referencing more than one table.");
+  Segments output_segments;
+  std::shared_ptr<const AbstractPosList> pos_list_out = std::make_shared<const RowIDPosList>();
 
-      // Check all rows in the old poslist and put them in pos_list_out if they are visible.
-      referenced_table = ref_segment_in->referenced_table();
-      DebugAssert(referenced_table->uses_mvcc(), "Trying to use Validate on a table that has no MVCC data");
+  const auto ref_segment_in = std::dynamic_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(ColumnID{0}));
 
-      if (!entirely_visible_chunks_table) {
-        entirely_visible_chunks_table = referenced_table;
-      } else {
-        Assert(entirely_visible_chunks_table == referenced_table, "Input table references more than once table");
-      }
+  // Holds the table that contains the MVCC information. For data segments, this is the table that we operate on.
+  // If we are validating a reference segment, this is the table referenced by ref_segment_in.
+  auto referenced_table = std::shared_ptr<const Table>{};
 
-      const auto& pos_list_in = ref_segment_in->pos_list();
-      if (pos_list_in->references_single_chunk() && !pos_list_in->empty()) {
-        // Fast path - we are looking at a single referenced chunk and thus need to get the MVCC data vector only once.
-        const auto referenced_chunk = referenced_table->get_chunk(pos_list_in->common_chunk_id());
-        auto mvcc_data = referenced_chunk->mvcc_data();
+  // If the segments in this chunk reference a segment, build a poslist for a reference segment.
+  if (ref_segment_in) {
+    DebugAssert(chunk_in->references_exactly_one_table(),
+                "Input to Validate contains a Chunk referencing more than one table.");
 
-        if (_can_use_chunk_shortcut && _is_entire_chunk_visible(referenced_chunk, snapshot_commit_id)) {
-          // We can reuse the old PosList since it is entirely visible. Not using the entirely_visible_chunks cache for
-          // this shortcut to keep the code short.
-          pos_list_out = pos_list_in;
+    // Check all rows in the old poslist and put them in pos_list_out if they are visible.
+    referenced_table = ref_segment_in->referenced_table();
+    DebugAssert(referenced_table->uses_mvcc(), "Trying to use Validate on a table that has no MVCC data");
+
+    if (!entirely_visible_chunks_table) {
+      entirely_visible_chunks_table = referenced_table;
+    } else {
+      Assert(entirely_visible_chunks_table == referenced_table, "Input table references more than once table");
+    }
+
+    const auto& pos_list_in = ref_segment_in->pos_list();
+    if (pos_list_in->references_single_chunk() && !pos_list_in->empty()) {
+      // Fast path - we are looking at a single referenced chunk and thus need to get the MVCC data vector only once.
+      const auto referenced_chunk = referenced_table->get_chunk(pos_list_in->common_chunk_id());
+      auto mvcc_data = referenced_chunk->mvcc_data();
+
+      if (can_use_chunk_shortcut && _is_entire_chunk_visible(referenced_chunk, snapshot_commit_id)) {
+        // We can reuse the old PosList since it is entirely visible. Not using the entirely_visible_chunks cache for
+        // this shortcut to keep the code short.
+        pos_list_out = pos_list_in;
+      } else if (is_frozen_chunk_entirely_visible(*mvcc_data, snapshot_commit_id)) {
+        pos_list_out = pos_list_in;
+      } else {
+        RowIDPosList temp_pos_list;
+        temp_pos_list.guarantee_single_chunk();
+        if (pos_list_in->size() * BITMAP_MIN_REFERENCED_ROW_SHARE >= referenced_chunk->size()) {
+          const auto visible_rows =
+              opossum::visible_rows(*referenced_chunk, *mvcc_data, our_tid, snapshot_commit_id, can_use_chunk_shortcut);
+          for (auto row_id : *pos_list_in) {
+            if (is_bit_set(visible_rows->bitmap, row_id.chunk_offset)) temp_pos_list.emplace_back(row_id);
+          }
         } else {
-          RowIDPosList temp_pos_list;
-          temp_pos_list.guarantee_single_chunk();
           for (auto row_id : *pos_list_in) {
             if (opossum::is_row_visible(our_tid, snapshot_commit_id, row_id.chunk_offset, *mvcc_data)) {
               temp_pos_list.emplace_back(row_id);
             }
           }
-          pos_list_out = std::make_shared<const RowIDPosList>(std::move(temp_pos_list));
         }
-      } else {
-        // Slow path - we are looking at multiple referenced chunks and have to look at each row individually. We first
-        // build a list of entirely visible chunks. Rows with chunk ids from that list do not need to be tested
-        // individually. For chunk ids that are NOT in the list of entirely visible chunks, we need to actually look at
-        // their MVCC information.
-        RowIDPosList temp_pos_list;
-        temp_pos_list.reserve(expected_number_of_valid_rows);
-
-        if (entirely_visible_chunks.empty()) {
-          // Check _is_entire_chunk_visible once for every chunk, even if we do not know if it is referenced or not.
-          // While this might introduce a small overhead in the case of many unreferenced chunks, it allows us to avoid
-          // a branch in the hot loop.
-          entirely_visible_chunks = std::vector<bool>(referenced_table->chunk_count(), false);
-          for (auto referenced_table_chunk_id = ChunkID{0}; referenced_table_chunk_id < referenced_table->chunk_count();
-               ++referenced_table_chunk_id) {
-            const auto referenced_chunk = referenced_table->get_chunk(referenced_table_chunk_id);
-            entirely_visible_chunks[referenced_table_chunk_id] =
-                _is_entire_chunk_visible(referenced_chunk, snapshot_commit_id);
-          }
+        pos_list_out = std::make_shared<const RowIDPosList>(std::move(temp_pos_list));
+      }
+    } else {
+      // Slow path - we are looking at multiple referenced chunks and have to look at each row individually. We first
+      // build a list of entirely visible chunks. Rows with chunk ids from that list do not need to be tested
+      // individually. For chunk ids that are NOT in the list of entirely visible chunks, we need to actually look at
+      // their MVCC information.
+      RowIDPosList temp_pos_list;
+      temp_pos_list.reserve(expected_number_of_valid_rows);
+
+      if (entirely_visible_chunks.empty()) {
+        // Check _is_entire_chunk_visible once for every chunk, even if we do not know if it is referenced or not.
+        // While this might introduce a small overhead in the case of many unreferenced chunks, it allows us to avoid
+        // a branch in the hot loop.
+        entirely_visible_chunks = std::vector<bool>(referenced_table->chunk_count(), false);
+        for (auto referenced_table_chunk_id = ChunkID{0}; referenced_table_chunk_id < referenced_table->chunk_count();
+             ++referenced_table_chunk_id) {
+          const auto referenced_chunk = referenced_table->get_chunk(referenced_table_chunk_id);
+          entirely_visible_chunks[referenced_table_chunk_id] =
+              (can_use_chunk_shortcut && _is_entire_chunk_visible(referenced_chunk, snapshot_commit_id)) ||
+              is_frozen_chunk_entirely_visible(*referenced_chunk->mvcc_data(), snapshot_commit_id);
         }
+      }
 
-        for (auto row_id : *pos_list_in) {
-          if (entirely_visible_chunks[row_id.chunk_id]) {
-            temp_pos_list.emplace_back(row_id);
-            continue;
-          }
+      // Consecutive rows of the same chunk, as in sorted PosLists, are checked using the same MVCC data. As the number
+      // of rows referenced per chunk is not known in advance, bitmaps are only used if other transactions have already
+      // computed them.
+      auto current_chunk_id = INVALID_CHUNK_ID;
+      auto mvcc_data = std::shared_ptr<const MvccData>{};
+      auto visible_rows = std::shared_ptr<const MvccData::VisibleRows>{};
+      for (auto row_id : *pos_list_in) {
+        if (entirely_visible_chunks[row_id.chunk_id]) {
+          temp_pos_list.emplace_back(row_id);
+          continue;
+        }
 
-          const auto referenced_chunk = referenced_table->get_chunk(row_id.chunk_id);
+        if (row_id.chunk_id != current_chunk_id) {
+          current_chunk_id = row_id.chunk_id;
+          const auto referenced_chunk = referenced_table->get_chunk(current_chunk_id);
+          mvcc_data = referenced_chunk->mvcc_data();
+          visible_rows = can_use_chunk_shortcut && !referenced_chunk->is_mutable()
+                             ? mvcc_data->cached_visible_rows(referenced_chunk->size(), snapshot_commit_id)
+                             : nullptr;
+        }
 
-          auto mvcc_data = referenced_chunk->mvcc_data();
-          if (opossum::is_row_visible(our_tid, snapshot_commit_id, row_id.chunk_offset, *mvcc_data)) {
-            temp_pos_list.emplace_back(row_id);
-          }
+        if (visible_rows ? is_bit_set(visible_rows->bitmap, row_id.chunk_offset)
+                         : opossum::is_row_visible(our_tid, snapshot_commit_id, row_id.chunk_offset, *mvcc_data)) {
+          temp_pos_list.emplace_back(row_id);
         }
-        pos_list_out = std::make_shared<const RowIDPosList>(std::move(temp_pos_list));
       }
+      pos_list_out = std::make_shared<const RowIDPosList>(std::move(temp_pos_list));
+    }
 
-      // Construct the actual ReferenceSegment objects and add them to the chunk.
-      for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
-        const auto reference_segment =
-            std::static_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(column_id));
-        const auto referenced_column_id = reference_segment->referenced_column_id();
-        auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, pos_list_out);
-        output_segments.push_back(ref_segment_out);
-      }
+    // Construct the actual ReferenceSegment objects and add them to the chunk.
+    for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
+      const auto reference_segment = std::static_pointer_cast<const ReferenceSegment>(chunk_in->get_segment(column_id));
+      const auto referenced_column_id = reference_segment->referenced_column_id();
+      auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, referenced_column_id, pos_list_out);
+      output_segments.push_back(ref_segment_out);
+    }
+
+    // Otherwise we have a non-reference Segment and simply iterate over all rows to build a poslist.
+  } else {
+    referenced_table = in_table;
 
-      // Otherwise we have a non-reference Segment and simply iterate over all rows to build a poslist.
+    DebugAssert(chunk_in->has_mvcc_data(), "Trying to use Validate on a table that has no MVCC data");
+
+    const auto mvcc_data = chunk_in->mvcc_data();
+    if ((can_use_chunk_shortcut && _is_entire_chunk_visible(chunk_in, snapshot_commit_id)) ||
+        is_frozen_chunk_entirely_visible(*mvcc_data, snapshot_commit_id)) {
+      // Not using the entirely_visible_chunks cache here as for data tables, we only look at chunks once anyway.
+      pos_list_out = std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size());
     } else {
-      referenced_table = in_table;
+      const auto visible_rows =
+          opossum::visible_rows(*chunk_in, *mvcc_data, our_tid, snapshot_commit_id, can_use_chunk_shortcut);
+      const auto& bitmap = visible_rows->bitmap;
 
-      DebugAssert(chunk_in->has_mvcc_data(), "Trying to use Validate on a table that has no MVCC data");
+      auto visible_row_count = size_t{0};
+      for (const auto bits : bitmap) {
+        visible_row_count += __builtin_popcountll(bits);
+      }
 
-      if (_can_use_chunk_shortcut && _is_entire_chunk_visible(chunk_in, snapshot_commit_id)) {
-        // Not using the entirely_visible_chunks cache here as for data tables, we only look at chunks once anyway.
-        pos_list_out = std::make_shared<EntireChunkPosList>(chunk_id, chunk_in->size());
+      if (visible_row_count == visible_rows->row_count) {
+        pos_list_out = std::make_shared<EntireChunkPosList>(chunk_id, visible_rows->row_count);
       } else {
-        const auto mvcc_data = chunk_in->mvcc_data();
-        RowIDPosList temp_pos_list;
-        temp_pos_list.reserve(expected_number_of_valid_rows);
+        RowIDPosList temp_pos_list(visible_row_count);
         temp_pos_list.guarantee_single_chunk();
-        // Generate pos_list_out.
-        auto chunk_size = chunk_in->size();  // The compiler fails to optimize this in the for clause :(
-        for (auto i = 0u; i < chunk_size; i++) {
-          if (opossum::is_row_visible(our_tid, snapshot_commit_id, i, *mvcc_data)) {
-            temp_pos_list.emplace_back(RowID{chunk_id, i});
+        auto output_index = size_t{0};
+        for (auto word_index = size_t{0}; word_index < bitmap.size(); ++word_index) {
+          auto bits = bitmap[word_index];
+          while (bits) {
+            const auto chunk_offset = static_cast<ChunkOffset>(word_index * 64 + __builtin_ctzll(bits));
+            temp_pos_list[output_index] = RowID{chunk_id, chunk_offset};
+            ++output_index;
+            // Clear the lowest set bit
+            bits &= bits - 1;
           }
         }
         pos_list_out = std::make_shared<const RowIDPosList>(std::move(temp_pos_list));
       }
+    }
 
-      // Create actual ReferenceSegment objects.
-      for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
-        auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, column_id, pos_list_out);
-        output_segments.push_back(ref_segment_out);
-      }
+    // Create actual ReferenceSegment objects.
+    for (ColumnID column_id{0}; column_id < chunk_in->column_count(); ++column_id) {
+      auto ref_segment_out = std::make_shared<ReferenceSegment>(referenced_table, column_id, pos_list_out);
+      output_segments.push_back(ref_segment_out);
     }
+  }
 
-    if (!pos_list_out->empty()) {
-      std::lock_guard<std::mutex> lock(output_mutex);
-      // The validate operator does not affect the sorted_by property. If a chunk has been sorted before, it still is
-      // after the validate operator.
-      const auto chunk = std::make_shared<Chunk>(output_segments);
-      chunk->finalize();
+  if (pos_list_out->empty()) return nullptr;
 
-      const auto& sorted_by = chunk_in->individually_sorted_by();
-      if (!sorted_by.empty()) {
-        chunk->set_individually_sorted_by(sorted_by);
-      }
-      output_chunks.emplace_back(chunk);
-    }
+  // The validate operator does not affect the sorted_by property. If a chunk has been sorted before, it still is
+  // after the validate operator.
+  const auto chunk = std::make_shared<Chunk>(output_segments);
+  chunk->finalize();
+
+  const auto& sorted_by = chunk_in->individually_sorted_by();
+  if (!sorted_by.empty()) {
+    chunk->set_individually_sorted_by(sorted_by);
   }
+  return chunk;
 }
 
 }  // namespace opossum
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <mutex>
 #include <string>
 #include <vector>
 
@@ -10,6 +11,8 @@
 
 namespace opossum {
 
+class TransactionContext;
+
 /**
  * Validates visibility of records of a table
  * within the context of a given transaction
@@ -28,14 +31,33 @@ class Validate : public AbstractReadOnlyOperator {
   static bool is_row_visible(TransactionID our_tid, CommitID snapshot_commit_id, const TransactionID row_tid,
                              const CommitID begin_cid, const CommitID end_cid);
 
+  // Stores whether the chunks of a referenced table have been found to be entirely visible. Only used for reference
+  // tables where no single chunk guarantee has been given. This assumes that only one table is referenced over all
+  // chunks that are validated with the same cache.
+  struct EntirelyVisibleChunksCache {
+    std::vector<bool> entirely_visible_chunks;
+    std::shared_ptr<const Table> table;  // used only for sanity check
+  };
+
+  // Returns false if the transaction has in-flight deletes, in which case the entirely-visible shortcut for chunks must
+  // not be used. Consult _on_execute() for more details.
+  static bool can_use_chunk_shortcut(const std::shared_ptr<TransactionContext>& transaction_context);
+
+  // Validates a single chunk of in_table and returns a reference chunk with the visible rows, or nullptr if no row is
+  // visible. Exposed so that operators that process the input chunk by chunk (see PipelinedScan) can validate
+  // without materializing an intermediate table.
+  static std::shared_ptr<Chunk> validate_chunk(const std::shared_ptr<const Table>& in_table, const ChunkID chunk_id,
+                                               const TransactionID our_tid, const CommitID snapshot_commit_id,
+                                               const bool can_use_chunk_shortcut, EntirelyVisibleChunksCache& cache);
+
  private:
   void _validate_chunks(const std::shared_ptr<const Table>& in_table, const ChunkID chunk_id_start,
                         const ChunkID chunk_id_end, const TransactionID our_tid, const TransactionID snapshot_commit_id,
                         std::vector<std::shared_ptr<Chunk>>& output_chunks, std::mutex& output_mutex) const;
 
   // This is a performance optimization that can only be used if a couple of conditions are met, i.e., if
-  // _can_use_chunk_shortcut is true. Consult _on_execute() for more details on the conditions.
-  bool _is_entire_chunk_visible(const std::shared_ptr<const Chunk>& chunk, const CommitID snapshot_commit_id) const;
+  // can_use_chunk_shortcut() is true. Consult _on_execute() for more details on the conditions.
+  static bool _is_entire_chunk_visible(const std::shared_ptr<const Chunk>& chunk, const CommitID snapshot_commit_id);
 
   bool _can_use_chunk_shortcut = true;
 
@@ -17,6 +17,7 @@
 #include "strategy/index_scan_rule.hpp"
 #include "strategy/join_ordering_rule.hpp"
 #include "strategy/join_predicate_ordering_rule.hpp"
+#include "strategy/key_index_lookup_rule.hpp"
 #include "strategy/null_scan_removal_rule.hpp"
 #include "strategy/predicate_merge_rule.hpp"
 #include "strategy/predicate_placement_rule.hpp"
@@ -99,6 +100,10 @@ std::shared_ptr<Optimizer> Optimizer::create_default_optimizer() {
 
   optimizer->add_rule(std::make_unique<PredicateMergeRule>());
 
+  // Run last, as it replaces the StoredTableNode and the key predicates on top of it by a single lookup. Any rule that
+  // reorders, merges, or pushes down predicates would have to be aware of this.
+  optimizer->add_rule(std::make_unique<KeyIndexLookupRule>());
+
   return optimizer;
 }
 
@@ -9,6 +9,8 @@
 #include "hyrise.hpp"
 #include "logical_query_plan/abstract_lqp_node.hpp"
 #include "logical_query_plan/join_node.hpp"
+#include "logical_query_plan/logical_plan_root_node.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
 #include "logical_query_plan/predicate_node.hpp"
 #include "logical_query_plan/stored_table_node.hpp"
 #include "lossless_cast.hpp"
@@ -131,6 +133,22 @@ std::vector<PredicatePruningChain> find_predicate_pruning_chains_by_stored_table
 
 namespace opossum {
 
+std::shared_ptr<AbstractLQPNode> ChunkPruningRule::prune_instantiated_plan(
+    const std::shared_ptr<AbstractLQPNode>& lqp) {
+  for (const auto& subplan_root : lqp_find_subplan_roots(lqp)) {
+    for (const auto& node : lqp_find_nodes_by_type(subplan_root, LQPNodeType::StoredTable)) {
+      static_cast<StoredTableNode&>(*node).set_pruned_chunk_ids({});
+    }
+  }
+
+  const auto root_node = LogicalPlanRootNode::make(lqp);
+  ChunkPruningRule{}.apply_to_plan(root_node);
+
+  auto pruned_lqp = root_node->left_input();
+  root_node->set_left_input(nullptr);
+  return pruned_lqp;
+}
+
 void ChunkPruningRule::_apply_to_plan_without_subqueries(const std::shared_ptr<AbstractLQPNode>& lqp_root) const {
   std::unordered_map<std::shared_ptr<StoredTableNode>, std::vector<PredicatePruningChain>>
       predicate_pruning_chains_by_stored_table_node;
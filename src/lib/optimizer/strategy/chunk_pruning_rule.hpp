@@ -25,6 +25,14 @@ class Table;
  * The resulting pruning information is stored inside the StoredTableNode objects.
  */
 class ChunkPruningRule : public AbstractRule {
+ public:
+  /**
+   * Chunks cannot be pruned by predicates on placeholders while a plan is optimized with placeholders (see
+   * lqp_has_placeholder_predicates). This prunes the chunks of such a plan again after its placeholders have been
+   * bound, replacing the pruning information of all StoredTableNodes.
+   */
+  static std::shared_ptr<AbstractLQPNode> prune_instantiated_plan(const std::shared_ptr<AbstractLQPNode>& lqp);
+
  protected:
   void _apply_to_plan_without_subqueries(const std::shared_ptr<AbstractLQPNode>& lqp_root) const override;
 
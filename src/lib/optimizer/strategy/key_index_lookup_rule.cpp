@@ -0,0 +1,138 @@
+#include "key_index_lookup_rule.hpp"
+
+#include <algorithm>
+#include <map>
+#include <memory>
+#include <optional>
+#include <vector>
+
+#include "expression/binary_predicate_expression.hpp"
+#include "expression/correlated_parameter_expression.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/lqp_column_expression.hpp"
+#include "expression/value_expression.hpp"
+#include "hyrise.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "storage/table_key_index.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+struct KeyPredicate {
+  std::shared_ptr<PredicateNode> predicate_node;
+  std::shared_ptr<AbstractExpression> column_expression;
+  std::shared_ptr<AbstractExpression> value_expression;
+};
+
+// Returns the column and the value if the predicate is `<column of stored_table_node> = <value or parameter>`.
+std::optional<KeyPredicate> get_key_predicate(const std::shared_ptr<PredicateNode>& predicate_node,
+                                              const std::shared_ptr<StoredTableNode>& stored_table_node) {
+  const auto predicate = std::dynamic_pointer_cast<BinaryPredicateExpression>(predicate_node->predicate());
+  if (!predicate || predicate->predicate_condition != PredicateCondition::Equals) return std::nullopt;
+
+  const auto is_key_column = [&](const auto& expression) {
+    const auto column_expression = std::dynamic_pointer_cast<LQPColumnExpression>(expression);
+    return column_expression && column_expression->original_node.lock() == stored_table_node;
+  };
+
+  const auto is_key_value = [](const auto& expression) {
+    return expression->type == ExpressionType::Value || expression->type == ExpressionType::CorrelatedParameter ||
+           expression->type == ExpressionType::Placeholder;
+  };
+
+  if (is_key_column(predicate->left_operand()) && is_key_value(predicate->right_operand())) {
+    return KeyPredicate{predicate_node, predicate->left_operand(), predicate->right_operand()};
+  }
+  if (is_key_value(predicate->left_operand()) && is_key_column(predicate->right_operand())) {
+    return KeyPredicate{predicate_node, predicate->right_operand(), predicate->left_operand()};
+  }
+  return std::nullopt;
+}
+
+void apply_to_stored_table_node(const std::shared_ptr<StoredTableNode>& stored_table_node) {
+  const auto table = Hyrise::get().storage_manager.get_table(stored_table_node->table_name);
+  if (table->key_indexes().empty()) return;
+
+  // Collect the predicates of the chain of PredicateNodes on top of the StoredTableNode. The chain may contain the
+  // ValidateNode, as Validate and the lookup commute. Only the topmost node of the chain may have multiple outputs, as
+  // the other nodes might be removed.
+  auto chain = std::vector<std::shared_ptr<PredicateNode>>{};
+  auto key_predicates = std::map<ColumnID, KeyPredicate>{};
+  auto node = std::static_pointer_cast<AbstractLQPNode>(stored_table_node);
+  while (node->output_count() == 1) {
+    const auto output = node->outputs()[0];
+    if (output->type == LQPNodeType::Validate) {
+      node = output;
+      continue;
+    }
+
+    const auto predicate_node = std::dynamic_pointer_cast<PredicateNode>(output);
+    if (!predicate_node) break;
+
+    chain.emplace_back(predicate_node);
+    const auto key_predicate = get_key_predicate(predicate_node, stored_table_node);
+    if (key_predicate) {
+      const auto& column_expression = static_cast<const LQPColumnExpression&>(*key_predicate->column_expression);
+      // For multiple predicates on the same column, only the first is used for the lookup.
+      key_predicates.try_emplace(column_expression.original_column_id, *key_predicate);
+    }
+
+    node = predicate_node;
+  }
+  if (key_predicates.empty()) return;
+
+  const auto& key_indexes = table->key_indexes();
+  const auto key_index_iter = std::find_if(key_indexes.begin(), key_indexes.end(), [&](const auto& key_index) {
+    const auto& column_ids = key_index->column_ids();
+    return std::all_of(column_ids.begin(), column_ids.end(),
+                       [&](const auto column_id) { return key_predicates.contains(column_id); });
+  });
+  if (key_index_iter == key_indexes.end()) return;
+
+  auto lookup_predicates = std::vector<std::shared_ptr<AbstractExpression>>{};
+  for (const auto column_id : (*key_index_iter)->column_ids()) {
+    const auto& key_predicate = key_predicates.at(column_id);
+    lookup_predicates.emplace_back(
+        expression_functional::equals_(key_predicate.column_expression, key_predicate.value_expression));
+    lqp_remove_node(key_predicate.predicate_node);
+  }
+
+  // IndexScans require the StoredTableNode as their input, which is now the KeyIndexLookup.
+  for (const auto& predicate_node : chain) {
+    predicate_node->scan_type = ScanType::TableScan;
+  }
+
+  const auto lookup_node = PredicateNode::make(inflate_logical_expressions(lookup_predicates, LogicalOperator::And));
+  lookup_node->scan_type = ScanType::KeyIndexLookup;
+
+  // After removing the key predicates, the StoredTableNode can have multiple outputs if the topmost node was removed.
+  for (const auto& [output, input_side] : stored_table_node->output_relations()) {
+    output->set_input(input_side, lookup_node);
+  }
+  lookup_node->set_left_input(stored_table_node);
+}
+
+}  // namespace
+
+namespace opossum {
+
+void KeyIndexLookupRule::_apply_to_plan_without_subqueries(const std::shared_ptr<AbstractLQPNode>& lqp_root) const {
+  // Collect the nodes first, as the plan is modified below them.
+  auto stored_table_nodes = std::vector<std::shared_ptr<StoredTableNode>>{};
+  visit_lqp(lqp_root, [&](const auto& node) {
+    if (node->type == LQPNodeType::StoredTable) {
+      stored_table_nodes.emplace_back(std::static_pointer_cast<StoredTableNode>(node));
+    }
+    return LQPVisitation::VisitInputs;
+  });
+
+  for (const auto& stored_table_node : stored_table_nodes) {
+    apply_to_stored_table_node(stored_table_node);
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <memory>
+
+#include "abstract_rule.hpp"
+
+namespace opossum {
+
+class AbstractLQPNode;
+
+/**
+ * This optimizer rule finds chains of PredicateNodes (and the ValidateNode) on top of StoredTableNodes whose table has
+ * a TableKeyIndex (see Table::create_key_index). If the chain contains a `<column> = <value>` predicate for each
+ * column of the key index, these predicates are combined into a single PredicateNode with ScanType::KeyIndexLookup,
+ * which is placed directly on top of the StoredTableNode. The LQPTranslator translates it into a KeyIndexLookup that
+ * replaces the GetTable and the TableScans. The other predicates of the chain remain on top of it.
+ *
+ * Values can be literals, correlated parameters, or placeholders, so that lookups in subqueries, prepared statements,
+ * and parameterized plans (see SQLPipelineStatement) benefit as well. As a key lookup returns at most a handful of
+ * rows, it is always preferred over an IndexScan.
+ */
+class KeyIndexLookupRule : public AbstractRule {
+ protected:
+  void _apply_to_plan_without_subqueries(const std::shared_ptr<AbstractLQPNode>& lqp_root) const override;
+};
+
+}  // namespace opossum
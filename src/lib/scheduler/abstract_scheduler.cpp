@@ -42,4 +42,16 @@ void AbstractScheduler::schedule_and_wait_for_tasks(const std::vector<std::share
   wait_for_tasks(tasks);
 }
 
+uint64_t AbstractScheduler::numa_local_task_count() const { return _numa_local_task_count.load(); }
+
+uint64_t AbstractScheduler::numa_remote_task_count() const { return _numa_remote_task_count.load(); }
+
+void AbstractScheduler::record_numa_task_execution(const bool is_local) {
+  if (is_local) {
+    ++_numa_local_task_count;
+  } else {
+    ++_numa_remote_task_count;
+  }
+}
+
 }  // namespace opossum
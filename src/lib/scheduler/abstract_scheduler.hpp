@@ -1,5 +1,6 @@
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <vector>
 
@@ -54,10 +55,19 @@ class AbstractScheduler : public Noncopyable {
   // NodeQueueScheduler::_group_tasks for an example.
   void schedule_and_wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
 
+  // Number of executed tasks with a preferred NUMA node (see AbstractTask::set_preferred_node_id) that ran on a worker
+  // of that node (local) or of another node (remote).
+  uint64_t numa_local_task_count() const;
+  uint64_t numa_remote_task_count() const;
+  void record_numa_task_execution(const bool is_local);
+
  protected:
   // Internal helper method that adds predecessor/successor relationships between tasks to limit the degree of
   // parallelism and reduce scheduling overhead.
   virtual void _group_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks) const;
+
+  std::atomic<uint64_t> _numa_local_task_count{0};
+  std::atomic<uint64_t> _numa_remote_task_count{0};
 };
 
 }  // namespace opossum
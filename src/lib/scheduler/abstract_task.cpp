@@ -49,6 +49,14 @@ const std::vector<std::shared_ptr<AbstractTask>>& AbstractTask::successors() con
 
 void AbstractTask::set_node_id(NodeID node_id) { _node_id = node_id; }
 
+void AbstractTask::set_preferred_node_id(NodeID preferred_node_id) {
+  DebugAssert((!_is_scheduled), "Possible race: Don't set the preferred node after the Task was scheduled");
+
+  _preferred_node_id = preferred_node_id;
+}
+
+NodeID AbstractTask::preferred_node_id() const { return _preferred_node_id; }
+
 bool AbstractTask::try_mark_as_enqueued() { return !_is_enqueued.exchange(true); }
 
 bool AbstractTask::try_mark_as_assigned_to_worker() { return !_is_assigned_to_worker.exchange(true); }
@@ -70,7 +78,12 @@ void AbstractTask::schedule(NodeID preferred_node_id) {
 
   _mark_as_scheduled();
 
-  Hyrise::get().scheduler()->schedule(shared_from_this(), preferred_node_id, _priority);
+  const auto& scheduler = Hyrise::get().scheduler();
+  if (preferred_node_id == CURRENT_NODE_ID && _preferred_node_id < scheduler->queues().size()) {
+    preferred_node_id = _preferred_node_id;
+  }
+
+  scheduler->schedule(shared_from_this(), preferred_node_id, _priority);
 }
 
 void AbstractTask::_join() {
@@ -93,6 +106,15 @@ void AbstractTask::execute() {
   // spawned the task are pushed down to a point where this thread is already running.
   Assert(_is_scheduled, "Task should have been scheduled before being executed");
 
+  if (_preferred_node_id != INVALID_NODE_ID) {
+    // Track whether the data accessed by the task was local to the executing worker. Tasks that were stolen by a
+    // worker of another node are counted as remote.
+    const auto worker = Worker::get_this_thread_worker();
+    if (worker) {
+      Hyrise::get().scheduler()->record_numa_task_execution(worker->queue()->node_id() == _preferred_node_id);
+    }
+  }
+
   _on_execute();
 
   for (auto& successor : _successors) {
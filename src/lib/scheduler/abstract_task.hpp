@@ -82,6 +82,14 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
    */
   void set_node_id(NodeID node_id);
 
+  /**
+   * NUMA node whose memory the Task mainly accesses (e.g., the node of the chunk it processes, see Chunk::node_id()).
+   * If set, schedule() without an explicit node puts the Task into the queue of that node instead of the queue of the
+   * current worker. INVALID_NODE_ID (the default) means that the Task has no preference.
+   */
+  void set_preferred_node_id(NodeID preferred_node_id);
+  NodeID preferred_node_id() const;
+
   /**
    * Callback to be executed right after the Task finished.
    * Notice the execution of the callback might happen on ANY thread
@@ -138,6 +146,7 @@ class AbstractTask : public std::enable_shared_from_this<AbstractTask> {
 
   std::atomic<TaskID> _id{INVALID_TASK_ID};
   std::atomic<NodeID> _node_id = INVALID_NODE_ID;
+  NodeID _preferred_node_id{INVALID_NODE_ID};
   SchedulePriority _priority;
   std::atomic<bool> _stealable;
   std::atomic_bool _done{false};
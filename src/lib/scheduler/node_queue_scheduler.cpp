@@ -1,6 +1,7 @@
 #include "node_queue_scheduler.hpp"
 #include <cstdlib>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -39,7 +40,7 @@ void NodeQueueScheduler::begin() {
     const auto& topology_node = Hyrise::get().topology.nodes()[node_id];
 
     for (const auto& topology_cpu : topology_node.cpus) {
-      _workers.emplace_back(std::make_shared<Worker>(queue, _worker_id_allocator->allocate(), topology_cpu.cpu_id));
+      _workers.emplace_back(_create_worker(queue, _worker_id_allocator->allocate(), topology_cpu.cpu_id));
     }
   }
 
@@ -119,6 +120,11 @@ void NodeQueueScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID pre
   queue->push(task, static_cast<uint32_t>(priority));
 }
 
+std::shared_ptr<Worker> NodeQueueScheduler::_create_worker(const std::shared_ptr<TaskQueue>& queue,
+                                                           const WorkerID worker_id, const CpuID cpu_id) {
+  return std::make_shared<Worker>(queue, worker_id, cpu_id);
+}
+
 void NodeQueueScheduler::_group_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks) const {
   // Adds predecessor/successor relationships between tasks so that only NUM_GROUPS tasks can be executed in parallel.
   // The optimal value of NUM_GROUPS depends on the number of cores and the number of queries being executed
@@ -126,30 +132,28 @@ void NodeQueueScheduler::_group_tasks(const std::vector<std::shared_ptr<Abstract
   //
   // Approach: Skip all tasks that already have predecessors or successors, as adding relationships to these could
   // introduce cyclic dependencies. Again, this is far from perfect, but better than not grouping the tasks.
+  //
+  // As a chain of tasks will likely be executed on the same Worker (see Worker::execute_next), only tasks with the
+  // same preferred NUMA node are chained. Otherwise, all but the first task of a chain would ignore their node.
 
-  auto round_robin_counter = 0;
-  auto common_node_id = std::optional<NodeID>{};
-
-  std::vector<std::shared_ptr<AbstractTask>> grouped_tasks(NUM_GROUPS);
   for (const auto& task : tasks) {
     if (!task->predecessors().empty() || !task->successors().empty()) return;
+  }
 
-    if (common_node_id) {
-      // This is not really a hard assertion. As the chain will likely be executed on the same Worker (see
-      // Worker::execute_next), we would ignore all but the first node_id. At the time of writing, we did not do any
-      // smart node assignment. This assertion is only here so that this behavior is understood if we ever assign NUMA
-      // node ids.
-      DebugAssert(task->node_id() == *common_node_id, "Expected all grouped tasks to have the same node_id");
-    } else {
-      common_node_id = task->node_id();
-    }
+  auto round_robin_counters = std::map<NodeID, size_t>{};
+  auto grouped_tasks = std::map<NodeID, std::vector<std::shared_ptr<AbstractTask>>>{};
+  for (const auto& task : tasks) {
+    const auto preferred_node_id = task->preferred_node_id();
+    auto& node_grouped_tasks = grouped_tasks[preferred_node_id];
+    if (node_grouped_tasks.empty()) node_grouped_tasks.resize(NUM_GROUPS);
+    auto& round_robin_counter = round_robin_counters[preferred_node_id];
 
     const auto group_id = round_robin_counter % NUM_GROUPS;
-    const auto& first_task_in_group = grouped_tasks[group_id];
+    const auto& first_task_in_group = node_grouped_tasks[group_id];
     if (first_task_in_group) {
       task->set_as_predecessor_of(first_task_in_group);
     }
-    grouped_tasks[group_id] = task;
+    node_grouped_tasks[group_id] = task;
     ++round_robin_counter;
   }
 }
@@ -69,6 +69,8 @@ namespace opossum {
  * worker of the remote node pulled the task, the current worker is pulling the task and therefore steals it.
  * Afterwards, the current worker is checking its local queue gain.
  *
+ * For a scheduler with per-worker lock-free deques and a more aggressive work stealing, see WorkStealingScheduler.
+ *
  * [1] http://frankdenneman.nl/2016/07/13/numa-deep-dive-4-local-memory-optimization/
  */
 
@@ -112,7 +114,11 @@ class NodeQueueScheduler : public AbstractScheduler {
  protected:
   void _group_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks) const override;
 
- private:
+  // Creates the worker for a processing unit. Overridden by schedulers that use a specialized worker, e.g., the
+  // WorkStealingScheduler.
+  virtual std::shared_ptr<Worker> _create_worker(const std::shared_ptr<TaskQueue>& queue, const WorkerID worker_id,
+                                                 const CpuID cpu_id);
+
   std::atomic<TaskID> _task_counter{TaskID{0}};
   std::shared_ptr<UidAllocator> _worker_id_allocator;
   std::vector<std::shared_ptr<TaskQueue>> _queues;
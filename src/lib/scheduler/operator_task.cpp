@@ -6,6 +6,7 @@
 
 #include "operators/abstract_operator.hpp"
 #include "operators/abstract_read_write_operator.hpp"
+#include "operators/runtime_filter.hpp"
 
 #include "scheduler/job_task.hpp"
 #include "utils/tracing/probes.hpp"
@@ -23,6 +24,16 @@ std::vector<std::shared_ptr<AbstractTask>> OperatorTask::make_tasks_from_operato
   std::vector<std::shared_ptr<AbstractTask>> tasks;
   std::unordered_map<std::shared_ptr<AbstractOperator>, std::shared_ptr<AbstractTask>> task_by_op;
   _add_tasks_from_operator(op, tasks, task_by_op);
+
+  // Runtime filters of hash joins are built from the output of one of the join's inputs. The operators that apply the
+  // filter to the other input have to wait for that input.
+  for (const auto& runtime_filter : push_down_runtime_filters(op)) {
+    const auto& producer_task = task_by_op.at(runtime_filter->producer());
+    for (const auto& consumer : runtime_filter->consumers()) {
+      producer_task->set_as_predecessor_of(task_by_op.at(consumer.lock()));
+    }
+  }
+
   return tasks;
 }
 
@@ -20,7 +20,8 @@ class OperatorTask : public AbstractTask {
                bool stealable = true);
 
   /**
-   * Create tasks recursively from result operator and set task dependencies automatically.
+   * Create tasks recursively from result operator and set task dependencies automatically. Pushes down the runtime
+   * filters of hash joins (see RuntimeFilter).
    */
   static std::vector<std::shared_ptr<AbstractTask>> make_tasks_from_operator(
       const std::shared_ptr<AbstractOperator>& op);
@@ -10,10 +10,14 @@
 #include <iomanip>
 #include <memory>
 #include <sstream>
+#include <string>
 #include <thread>
 #include <utility>
 #include <vector>
 
+#include "memory/numa_memory_resource.hpp"
+#include "utils/assert.hpp"
+
 namespace opossum {
 
 #if HYRISE_NUMA_SUPPORT
@@ -22,7 +26,16 @@ const int Topology::_number_of_hardware_nodes = numa_num_configured_nodes();  //
 const int Topology::_number_of_hardware_nodes = 1;  // NOLINT
 #endif
 
-Topology::Topology() { _init_default_topology(); }
+Topology::Topology() {
+  _init_default_topology();
+  _create_memory_resources();
+}
+
+Topology::Topology(Topology&&) noexcept = default;
+
+Topology& Topology::operator=(Topology&&) noexcept = default;
+
+Topology::~Topology() = default;
 
 std::ostream& operator<<(std::ostream& stream, const TopologyNode& topology_node) {
   stream << "Number of Node CPUs: " << topology_node.cpus.size() << ", CPUIDs: [";
@@ -37,14 +50,24 @@ std::ostream& operator<<(std::ostream& stream, const TopologyNode& topology_node
   return stream;
 }
 
-void Topology::use_default_topology(uint32_t max_num_cores) { _init_default_topology(max_num_cores); }
+void Topology::use_default_topology(uint32_t max_num_cores) {
+  _init_default_topology(max_num_cores);
+  _create_memory_resources();
+}
 
-void Topology::use_numa_topology(uint32_t max_num_cores) { _init_numa_topology(max_num_cores); }
+void Topology::use_numa_topology(uint32_t max_num_cores) {
+  _init_numa_topology(max_num_cores);
+  _create_memory_resources();
+}
 
-void Topology::use_non_numa_topology(uint32_t max_num_cores) { _init_non_numa_topology(max_num_cores); }
+void Topology::use_non_numa_topology(uint32_t max_num_cores) {
+  _init_non_numa_topology(max_num_cores);
+  _create_memory_resources();
+}
 
 void Topology::use_fake_numa_topology(uint32_t max_num_workers, uint32_t workers_per_node) {
   _init_fake_numa_topology(max_num_workers, workers_per_node);
+  _create_memory_resources();
 }
 
 void Topology::_init_default_topology(uint32_t max_num_cores) {
@@ -162,11 +185,36 @@ const std::vector<TopologyNode>& Topology::nodes() const { return _nodes; }
 
 size_t Topology::num_cpus() const { return _num_cpus; }
 
+bool Topology::is_fake_numa_topology() const { return _fake_numa_topology; }
+
+NumaMemoryResource* Topology::get_memory_resource(const NodeID node_id) const {
+  Assert(node_id < _nodes.size(), "NodeID " + std::to_string(node_id) + " is not part of the topology");
+
+  const auto resource_it = std::find_if(
+      _memory_resources.cbegin(), _memory_resources.cend(), [&](const auto& memory_resource) {
+        return memory_resource->node_id() == node_id && memory_resource->is_fake_numa() == _fake_numa_topology;
+      });
+  DebugAssert(resource_it != _memory_resources.cend(), "Memory resources were not created for the topology");
+  return resource_it->get();
+}
+
 void Topology::_clear() {
   _nodes.clear();
   _num_cpus = 0;
 }
 
+void Topology::_create_memory_resources() {
+  for (auto node_id = NodeID{0}; node_id < _nodes.size(); ++node_id) {
+    const auto resource_it = std::find_if(
+        _memory_resources.cbegin(), _memory_resources.cend(), [&](const auto& memory_resource) {
+          return memory_resource->node_id() == node_id && memory_resource->is_fake_numa() == _fake_numa_topology;
+        });
+    if (resource_it != _memory_resources.cend()) continue;
+
+    _memory_resources.emplace_back(std::make_unique<NumaMemoryResource>(node_id, _fake_numa_topology));
+  }
+}
+
 std::ostream& operator<<(std::ostream& stream, const Topology& topology) {
   stream << "Number of CPUs: " << topology.num_cpus() << std::endl;
   if (topology._filtered_by_affinity) {
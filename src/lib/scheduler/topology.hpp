@@ -5,10 +5,14 @@
 #include <utility>
 #include <vector>
 
+#include <boost/container/pmr/memory_resource.hpp>
+
 #include "types.hpp"
 
 namespace opossum {
 
+class NumaMemoryResource;
+
 struct TopologyCpu final {
   explicit TopologyCpu(CpuID init_cpu_id) : cpu_id(init_cpu_id) {}
 
@@ -32,6 +36,10 @@ std::ostream& operator<<(std::ostream& stream, const TopologyNode& topology_node
  */
 class Topology final : public Noncopyable {
  public:
+  Topology(Topology&&) noexcept;
+  Topology& operator=(Topology&&) noexcept;
+  ~Topology();
+
   /**
    * Use the default system topology.
    *
@@ -73,6 +81,14 @@ class Topology final : public Noncopyable {
 
   size_t num_cpus() const;
 
+  bool is_fake_numa_topology() const;
+
+  /**
+   * Returns the memory resource that allocates memory on the given node (see NumaMemoryResource). Resources remain
+   * valid when the topology is changed, as segments may still use them.
+   */
+  NumaMemoryResource* get_memory_resource(const NodeID node_id) const;
+
  private:
   Topology();
 
@@ -86,11 +102,17 @@ class Topology final : public Noncopyable {
 
   void _clear();
 
+  // Creates the memory resources for the nodes of the current topology unless matching ones already exist.
+  void _create_memory_resources();
+
   std::vector<TopologyNode> _nodes;
   uint32_t _num_cpus{0};
   bool _fake_numa_topology{false};
   bool _filtered_by_affinity{false};
 
+  // Append-only, see get_memory_resource.
+  std::vector<std::unique_ptr<NumaMemoryResource>> _memory_resources;
+
   static const int _number_of_hardware_nodes;
 };
 
@@ -0,0 +1,120 @@
+#include "work_stealing_deque.hpp"
+
+#include <memory>
+#include <utility>
+
+#include "abstract_task.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+WorkStealingDeque::RingBuffer::RingBuffer(const int64_t init_capacity)
+    : capacity(init_capacity), mask(init_capacity - 1), slots(std::make_unique<std::atomic<Box*>[]>(init_capacity)) {
+  DebugAssert(capacity > 0 && (capacity & mask) == 0, "Capacity must be a power of two");
+}
+
+// The paper uses relaxed accesses to the slots, relying on the fences in push() and steal(). As tsan does not
+// understand standalone fences (as of Oct 2019, see AbstractTask::execute), we use acquire/release semantics, which
+// come for free on x86.
+WorkStealingDeque::Box* WorkStealingDeque::RingBuffer::get(const int64_t index) const {
+  return slots[index & mask].load(std::memory_order_acquire);
+}
+
+void WorkStealingDeque::RingBuffer::put(const int64_t index, Box* box) {
+  slots[index & mask].store(box, std::memory_order_release);
+}
+
+WorkStealingDeque::WorkStealingDeque(const int64_t initial_capacity) {
+  _buffers.emplace_back(std::make_unique<RingBuffer>(initial_capacity));
+  _buffer.store(_buffers.back().get(), std::memory_order_relaxed);
+}
+
+WorkStealingDeque::~WorkStealingDeque() {
+  // Free the boxes of tasks that were never taken. At this point, no other thread may access the deque.
+  auto* const buffer = _buffer.load(std::memory_order_relaxed);
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  for (auto index = _top.load(std::memory_order_relaxed); index < bottom; ++index) {
+    delete buffer->get(index);
+  }
+}
+
+void WorkStealingDeque::push(const std::shared_ptr<AbstractTask>& task) {
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto top = _top.load(std::memory_order_acquire);
+  auto* buffer = _buffer.load(std::memory_order_relaxed);
+
+  if (bottom - top > buffer->capacity - 1) {
+    buffer = _grow(buffer, bottom, top);
+  }
+
+  buffer->put(bottom, new Box{task});
+  std::atomic_thread_fence(std::memory_order_release);
+  _bottom.store(bottom + 1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<AbstractTask> WorkStealingDeque::pop() {
+  const auto bottom = _bottom.load(std::memory_order_relaxed) - 1;
+  auto* const buffer = _buffer.load(std::memory_order_relaxed);
+  _bottom.store(bottom, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  auto top = _top.load(std::memory_order_relaxed);
+
+  if (top > bottom) {
+    // Deque was empty, restore the canonical empty state.
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+
+  auto* box = buffer->get(bottom);
+  if (top == bottom) {
+    // This is the last task - race against the thieves for it.
+    if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+      box = nullptr;
+    }
+    _bottom.store(bottom + 1, std::memory_order_relaxed);
+    if (!box) return nullptr;
+  }
+
+  const auto owned_box = std::unique_ptr<Box>{box};
+  return std::move(*owned_box);
+}
+
+std::shared_ptr<AbstractTask> WorkStealingDeque::steal() {
+  auto top = _top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const auto bottom = _bottom.load(std::memory_order_acquire);
+
+  if (top >= bottom) return nullptr;
+
+  auto* const buffer = _buffer.load(std::memory_order_acquire);
+  auto* const box = buffer->get(top);
+  if (!_top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed)) {
+    // Lost the race against the owner or another thief. The box belongs to the winner.
+    return nullptr;
+  }
+
+  const auto owned_box = std::unique_ptr<Box>{box};
+  return std::move(*owned_box);
+}
+
+bool WorkStealingDeque::empty() const { return size() == 0; }
+
+size_t WorkStealingDeque::size() const {
+  const auto bottom = _bottom.load(std::memory_order_relaxed);
+  const auto top = _top.load(std::memory_order_relaxed);
+  return bottom > top ? static_cast<size_t>(bottom - top) : size_t{0};
+}
+
+WorkStealingDeque::RingBuffer* WorkStealingDeque::_grow(RingBuffer* buffer, const int64_t bottom, const int64_t top) {
+  auto new_buffer = std::make_unique<RingBuffer>(buffer->capacity * 2);
+  for (auto index = top; index < bottom; ++index) {
+    new_buffer->put(index, buffer->get(index));
+  }
+
+  auto* const new_buffer_ptr = new_buffer.get();
+  _buffers.emplace_back(std::move(new_buffer));
+  _buffer.store(new_buffer_ptr, std::memory_order_release);
+  return new_buffer_ptr;
+}
+
+}  // namespace opossum
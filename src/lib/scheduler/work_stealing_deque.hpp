@@ -0,0 +1,85 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractTask;
+
+/**
+ * Lock-free Chase-Lev work-stealing deque as used by the WorkStealingScheduler. Each deque has exactly one owner
+ * (a WorkStealingWorker) that pushes and pops tasks at the bottom, i.e., in LIFO order, so that freshly spawned tasks
+ * are executed while their inputs are still in the cache. Any other thread may steal from the top, i.e., in FIFO
+ * order, taking the oldest (and usually largest) piece of work.
+ *
+ * The implementation follows "Correct and Efficient Work-Stealing for Weak Memory Models" by Lê et al. (PPoPP 2013).
+ * As the slots can only hold trivially copyable values, each task is stored in a heap-allocated shared_ptr "box". A
+ * box is only dereferenced by the thread that won the race for it, i.e., after a successful CAS on _top or when the
+ * owner popped it without competition.
+ *
+ * When the deque runs full, the owner replaces the ring buffer with one of twice the size. As a concurrent thief might
+ * still read from the old buffer, old buffers are kept until the deque is destroyed. Since the capacity doubles every
+ * time, this wastes at most as much memory as the current buffer uses.
+ */
+class WorkStealingDeque : private Noncopyable {
+ public:
+  static constexpr int64_t DEFAULT_CAPACITY = 1024;
+
+  explicit WorkStealingDeque(const int64_t initial_capacity = DEFAULT_CAPACITY);
+  ~WorkStealingDeque();
+
+  /**
+   * Adds a task to the bottom of the deque. Must only be called by the owner.
+   */
+  void push(const std::shared_ptr<AbstractTask>& task);
+
+  /**
+   * Removes the most recently pushed task. Must only be called by the owner. Returns nullptr if the deque is empty or
+   * if a thief took the last task.
+   */
+  std::shared_ptr<AbstractTask> pop();
+
+  /**
+   * Removes the oldest task. Can be called by any thread. Returns nullptr if the deque is empty or if the task was
+   * taken by another thread first.
+   */
+  std::shared_ptr<AbstractTask> steal();
+
+  /**
+   * Approximate values, as other threads might be modifying the deque concurrently.
+   */
+  bool empty() const;
+  size_t size() const;
+
+ private:
+  using Box = std::shared_ptr<AbstractTask>;
+
+  struct RingBuffer {
+    explicit RingBuffer(const int64_t init_capacity);
+
+    Box* get(const int64_t index) const;
+    void put(const int64_t index, Box* box);
+
+    const int64_t capacity;
+    const int64_t mask;
+    std::unique_ptr<std::atomic<Box*>[]> slots;
+  };
+
+  RingBuffer* _grow(RingBuffer* buffer, const int64_t bottom, const int64_t top);
+
+  // _top and _bottom are accessed by different threads. Aligning them to different cache lines avoids false sharing
+  // between the owner and the thieves.
+  alignas(64) std::atomic<int64_t> _top{0};
+  alignas(64) std::atomic<int64_t> _bottom{0};
+  alignas(64) std::atomic<RingBuffer*> _buffer;
+
+  // Holds the current and all previous buffers, only accessed by the owner and the destructor.
+  std::vector<std::unique_ptr<RingBuffer>> _buffers;
+};
+
+}  // namespace opossum
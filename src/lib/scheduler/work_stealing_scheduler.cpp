@@ -0,0 +1,69 @@
+#include "work_stealing_scheduler.hpp"
+
+#include <memory>
+#include <vector>
+
+#include "abstract_task.hpp"
+#include "hyrise.hpp"
+#include "task_queue.hpp"
+#include "work_stealing_worker.hpp"
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+void WorkStealingScheduler::finish() {
+  NodeQueueScheduler::finish();
+
+  // Deques may still hold tasks that were executed directly by a worker waiting for them (see
+  // Worker::_wait_for_tasks). These are freed together with the workers.
+  _workers_per_node = {};
+}
+
+void WorkStealingScheduler::schedule(std::shared_ptr<AbstractTask> task, NodeID preferred_node_id,
+                                     SchedulePriority priority) {
+  DebugAssert(_active, "Can't schedule more tasks after the WorkStealingScheduler was shut down");
+  DebugAssert(task->is_scheduled(), "Don't call WorkStealingScheduler::schedule(), call schedule() on the task");
+
+  const auto worker = Worker::get_this_thread_worker();
+  auto* const work_stealing_worker = dynamic_cast<WorkStealingWorker*>(worker.get());
+
+  // Only tasks that are spawned by one of our workers and could be executed by any worker of the node go into the
+  // worker's deque. Everything else is handled like in the NodeQueueScheduler.
+  const auto use_deque = work_stealing_worker && priority == SchedulePriority::Default && task->is_stealable() &&
+                         (preferred_node_id == CURRENT_NODE_ID || preferred_node_id == worker->queue()->node_id());
+  if (!use_deque) {
+    NodeQueueScheduler::schedule(task, preferred_node_id, priority);
+    return;
+  }
+
+  task->set_id(_task_counter++);
+
+  if (!task->is_ready()) return;
+
+  work_stealing_worker->push(task);
+}
+
+const std::vector<std::shared_ptr<WorkStealingWorker>>& WorkStealingScheduler::workers_on_node(
+    const NodeID node_id) const {
+  DebugAssert(node_id < _workers_per_node.size(), "Invalid node_id");
+  return _workers_per_node[node_id];
+}
+
+void WorkStealingScheduler::notify_task_pushed(const NodeID node_id) {
+  if (num_parked_workers.load(std::memory_order_relaxed) == 0) return;
+
+  _queues[node_id]->new_task.notify_one();
+}
+
+std::shared_ptr<Worker> WorkStealingScheduler::_create_worker(const std::shared_ptr<TaskQueue>& queue,
+                                                              const WorkerID worker_id, const CpuID cpu_id) {
+  // Nodes without any CPUs still get an (empty) entry so that _workers_per_node can be indexed by all NodeIDs.
+  _workers_per_node.resize(Hyrise::get().topology.nodes().size());
+
+  auto worker = std::make_shared<WorkStealingWorker>(queue, worker_id, cpu_id, *this);
+  _workers_per_node[queue->node_id()].emplace_back(worker);
+  return worker;
+}
+
+}  // namespace opossum
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#include "node_queue_scheduler.hpp"
+
+namespace opossum {
+
+class WorkStealingWorker;
+
+/**
+ * Variant of the NodeQueueScheduler that gives each worker a lock-free Chase-Lev deque (see WorkStealingDeque).
+ *
+ * Tasks that are scheduled by a worker thread (e.g., the JobTasks spawned by an operator) are pushed into that worker's
+ * deque instead of the shared TaskQueue of the node. The owner pops from its deque in LIFO order, idle workers steal in
+ * FIFO order - first from the deques of their own node, then from remote nodes. This avoids contention on the shared
+ * queue and keeps the data of freshly spawned tasks in the cache of the spawning core. Tasks scheduled from outside
+ * of the workers, high priority tasks, non-stealable tasks, and tasks with an explicitly different preferred node are
+ * still placed in the node's TaskQueue.
+ *
+ * Instead of going to sleep as soon as no task is found, workers spin for a bounded number of rounds, which reduces
+ * the latency of short-running (e.g., OLTP) queries. For details, see WorkStealingWorker.
+ */
+class WorkStealingScheduler : public NodeQueueScheduler {
+ public:
+  void finish() override;
+
+  void schedule(std::shared_ptr<AbstractTask> task, NodeID preferred_node_id = CURRENT_NODE_ID,
+                SchedulePriority priority = SchedulePriority::Default) override;
+
+  const std::vector<std::shared_ptr<WorkStealingWorker>>& workers_on_node(const NodeID node_id) const;
+
+  /**
+   * Called when a task was pushed into a deque of the given node. Wakes up a parked worker, if there is any.
+   */
+  void notify_task_pushed(const NodeID node_id);
+
+  // Workers keep track of how many of them are parked so that pushing a task does not need to notify the condition
+  // variable (which might result in a syscall) if all workers are busy or spinning.
+  std::atomic_uint32_t num_parked_workers{0};
+
+ protected:
+  std::shared_ptr<Worker> _create_worker(const std::shared_ptr<TaskQueue>& queue, const WorkerID worker_id,
+                                         const CpuID cpu_id) override;
+
+ private:
+  std::vector<std::vector<std::shared_ptr<WorkStealingWorker>>> _workers_per_node;
+};
+
+}  // namespace opossum
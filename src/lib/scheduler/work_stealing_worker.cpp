@@ -0,0 +1,138 @@
+#include "work_stealing_worker.hpp"
+
+#include <chrono>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "abstract_task.hpp"
+#include "task_queue.hpp"
+#include "work_stealing_scheduler.hpp"
+
+namespace {
+
+// Time a parked worker sleeps before it looks for work again if it is not notified. Same as in worker.cpp.
+constexpr auto WORKER_PARK_TIME = std::chrono::microseconds(300);
+
+}  // namespace
+
+namespace opossum {
+
+WorkStealingWorker::WorkStealingWorker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id,
+                                       WorkStealingScheduler& scheduler)
+    : Worker(queue, id, cpu_id), _scheduler(scheduler) {}
+
+WorkStealingDeque& WorkStealingWorker::deque() { return _deque; }
+
+void WorkStealingWorker::push(const std::shared_ptr<AbstractTask>& task) {
+  DebugAssert(&*get_this_thread_worker() == this, "Only the owning worker may push into its deque");
+
+  // Someone else was first to enqueue this task? No problem!
+  if (!task->try_mark_as_enqueued()) return;
+
+  task->set_node_id(_queue->node_id());
+  _deque.push(task);
+
+  _scheduler.notify_task_pushed(_queue->node_id());
+}
+
+void WorkStealingWorker::_work() {
+  auto task = std::shared_ptr<AbstractTask>{};
+  if (_next_task) {
+    task = std::move(_next_task);
+    _next_task = nullptr;
+  } else {
+    task = _deque.pop();
+    if (!task) task = _queue->pull();
+    if (!task) task = _steal();
+  }
+
+  if (!task) {
+    _idle();
+    return;
+  }
+
+  _idle_rounds = 0;
+
+  const auto successfully_assigned = task->try_mark_as_assigned_to_worker();
+  if (!successfully_assigned) {
+    // Some other worker has already started to work on this task, e.g., because it was waiting for it in
+    // _wait_for_tasks. Pick a different one.
+    return;
+  }
+
+  task->execute();
+
+  _num_finished_tasks++;
+}
+
+void WorkStealingWorker::_enqueue(const std::shared_ptr<AbstractTask>& task) {
+  if (!task->is_stealable()) {
+    Worker::_enqueue(task);
+    return;
+  }
+
+  push(task);
+}
+
+std::shared_ptr<AbstractTask> WorkStealingWorker::_steal() {
+  const auto own_node_id = _queue->node_id();
+
+  auto task = _steal_from_node(own_node_id);
+  if (task) return task;
+
+  const auto& queues = _scheduler.queues();
+  const auto node_count = queues.size();
+  for (auto offset = size_t{1}; offset < node_count; ++offset) {
+    const auto node_id = static_cast<NodeID>((own_node_id + offset) % node_count);
+
+    // Remote queues may hold non-stealable tasks, which TaskQueue::steal() skips. Deques only hold stealable tasks.
+    task = queues[node_id]->steal();
+    if (!task) task = _steal_from_node(node_id);
+
+    if (task) {
+      task->set_node_id(own_node_id);
+      return task;
+    }
+  }
+
+  return nullptr;
+}
+
+std::shared_ptr<AbstractTask> WorkStealingWorker::_steal_from_node(const NodeID node_id) {
+  const auto& victims = _scheduler.workers_on_node(node_id);
+  const auto victim_count = victims.size();
+  if (victim_count == 0) return nullptr;
+
+  const auto first_victim = _next_victim++;
+  for (auto offset = size_t{0}; offset < victim_count; ++offset) {
+    const auto& victim = victims[(first_victim + offset) % victim_count];
+    if (victim.get() == this) continue;
+
+    auto task = victim->deque().steal();
+    if (task) return task;
+  }
+
+  return nullptr;
+}
+
+void WorkStealingWorker::_idle() {
+  if (++_idle_rounds < MAX_IDLE_SPIN_ROUNDS) {
+    std::this_thread::yield();
+    return;
+  }
+
+  // Park until a new task is pushed into the queue or deques of our node, or until the timeout is reached. A
+  // notification that is sent between our last unsuccessful round and the wait is lost, but the timeout bounds the
+  // resulting delay.
+  _idle_rounds = 0;
+  ++_scheduler.num_parked_workers;
+  {
+    std::unique_lock<std::mutex> unique_lock(_queue->lock);
+    _queue->new_task.wait_for(unique_lock, WORKER_PARK_TIME);
+  }
+  --_scheduler.num_parked_workers;
+}
+
+}  // namespace opossum
@@ -0,0 +1,60 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "types.hpp"
+#include "work_stealing_deque.hpp"
+#include "worker.hpp"
+
+namespace opossum {
+
+class WorkStealingScheduler;
+
+/**
+ * Worker of the WorkStealingScheduler. In addition to the TaskQueue of its node, each worker owns a WorkStealingDeque
+ * into which tasks spawned on this worker are pushed. A worker looks for work in the following order:
+ *
+ *  1) the task set by execute_next
+ *  2) its own deque (LIFO, i.e., the most recently spawned task)
+ *  3) the TaskQueue of its node, which holds tasks scheduled from non-worker threads and high priority tasks
+ *  4) the deques of the other workers on the same node (FIFO, i.e., the oldest task)
+ *  5) the TaskQueues and deques of remote nodes
+ *
+ * If no task is found, the worker spins for a bounded number of rounds (each round re-checks all of the above) before
+ * it parks on the condition variable of its node's TaskQueue.
+ */
+class WorkStealingWorker : public Worker {
+ public:
+  // Number of unsuccessful rounds before a worker parks. Each round yields the CPU once. The value is a tradeoff
+  // between the latency of short tasks (which suffer from parked workers) and wasted cycles on idle systems.
+  static constexpr auto MAX_IDLE_SPIN_ROUNDS = 64;
+
+  WorkStealingWorker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id,
+                     WorkStealingScheduler& scheduler);
+
+  WorkStealingDeque& deque();
+
+  /**
+   * Pushes a task into this worker's deque. Must only be called from the thread of this worker.
+   */
+  void push(const std::shared_ptr<AbstractTask>& task);
+
+ protected:
+  void _work() override;
+  void _enqueue(const std::shared_ptr<AbstractTask>& task) override;
+
+ private:
+  std::shared_ptr<AbstractTask> _steal();
+  std::shared_ptr<AbstractTask> _steal_from_node(const NodeID node_id);
+  void _idle();
+
+  WorkStealingScheduler& _scheduler;
+  WorkStealingDeque _deque;
+
+  // Used to rotate the first victim so that not all thieves hammer the same deque.
+  size_t _next_victim{0};
+  uint32_t _idle_rounds{0};
+};
+
+}  // namespace opossum
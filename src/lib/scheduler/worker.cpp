@@ -126,10 +126,14 @@ void Worker::execute_next(const std::shared_ptr<AbstractTask>& task) {
     Assert(successfully_enqueued, "Task was already enqueued, expected to be solely responsible for execution");
     _next_task = task;
   } else {
-    _queue->push(task, static_cast<uint32_t>(SchedulePriority::Default));
+    _enqueue(task);
   }
 }
 
+void Worker::_enqueue(const std::shared_ptr<AbstractTask>& task) {
+  _queue->push(task, static_cast<uint32_t>(SchedulePriority::Default));
+}
+
 void Worker::start() { _thread = std::thread(&Worker::operator(), this); }
 
 void Worker::join() {
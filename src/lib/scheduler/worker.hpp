@@ -24,6 +24,7 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
   static std::shared_ptr<Worker> get_this_thread_worker();
 
   Worker(const std::shared_ptr<TaskQueue>& queue, WorkerID id, CpuID cpu_id);
+  virtual ~Worker() = default;
 
   /**
    * Unique ID of a worker. Currently not in use, but really helpful for debugging.
@@ -49,10 +50,17 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
 
  protected:
   void operator()();
-  void _work();
+  virtual void _work();
+
+  // Called by execute_next if the task cannot be executed next because another task already occupies that slot.
+  virtual void _enqueue(const std::shared_ptr<AbstractTask>& task);
 
   void _wait_for_tasks(const std::vector<std::shared_ptr<AbstractTask>>& tasks);
 
+  std::shared_ptr<AbstractTask> _next_task{};
+  std::shared_ptr<TaskQueue> _queue;
+  std::atomic<uint64_t> _num_finished_tasks{0};
+
  private:
   /**
    * Pin a worker to a particular core.
@@ -60,12 +68,9 @@ class Worker : public std::enable_shared_from_this<Worker>, private Noncopyable
    */
   void _set_affinity();
 
-  std::shared_ptr<AbstractTask> _next_task{};
-  std::shared_ptr<TaskQueue> _queue;
   WorkerID _id;
   CpuID _cpu_id;
   std::thread _thread;
-  std::atomic<uint64_t> _num_finished_tasks{0};
 
   std::vector<int> _random{};
   size_t _next_random{};
@@ -0,0 +1,203 @@
+#include "async_session.hpp"
+
+#include <cstring>
+
+#include "postgres_message_type.hpp"
+#include "scheduler/job_task.hpp"
+
+namespace {
+
+// Messages longer than this are considered a protocol violation, the connection is closed.
+constexpr auto MAX_MESSAGE_LENGTH = uint32_t{1} << 30;
+
+// Serializing a result pauses while more than this has not been written to the socket yet. This bounds the memory
+// that a client which reads its results slowly (or not at all) occupies on the server.
+constexpr auto MAX_PENDING_WRITE_BYTES = 4 * opossum::MessageStream::OUTPUT_HANDLER_THRESHOLD;
+
+uint32_t read_length_field(const char* data) {
+  auto network_value = uint32_t{0};
+  std::memcpy(&network_value, data, sizeof(network_value));
+  return ntohl(network_value);
+}
+
+}  // namespace
+
+namespace opossum {
+
+AsyncSession::AsyncSession(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info,
+                           std::atomic<uint64_t>& num_running_sessions)
+    : _strand(io_service),
+      _socket(std::make_shared<Socket>(io_service)),
+      _message_stream(std::make_shared<MessageStream>()),
+      _session(_message_stream, send_execution_info),
+      _num_running_sessions(num_running_sessions) {}
+
+AsyncSession::~AsyncSession() {
+  if (_is_started) --_num_running_sessions;
+}
+
+std::shared_ptr<Socket> AsyncSession::socket() { return _socket; }
+
+void AsyncSession::start() {
+  _is_started = true;
+  ++_num_running_sessions;
+
+  // See Session::run
+  _socket->set_option(boost::asio::ip::tcp::no_delay(true));
+
+  // The output handler is called by the thread that handles the current message. As that thread holds a reference to
+  // the session, capturing `this` is safe. It blocks that thread until the socket has caught up, the data is written
+  // on the strand.
+  _message_stream->set_output_handler([this](std::string&& data) {
+    {
+      auto lock = std::unique_lock{_pending_write_mutex};
+      _pending_writes_drained.wait(lock,
+                                   [&]() { return _is_closed || _pending_write_bytes < MAX_PENDING_WRITE_BYTES; });
+      _pending_write_bytes += data.size();
+    }
+
+    boost::asio::post(_strand, [self = shared_from_this(), data = std::move(data)]() mutable {
+      self->_enqueue_write(std::move(data));
+    });
+  });
+
+  boost::asio::post(_strand, [self = shared_from_this()]() { self->_read_startup_packet(); });
+}
+
+void AsyncSession::_read_startup_packet() {
+  // The startup packet has no message type, it starts with the length field.
+  boost::asio::async_read(
+      *_socket, boost::asio::buffer(_header.data(), LENGTH_FIELD_SIZE),
+      boost::asio::bind_executor(_strand, [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+        const auto length = read_length_field(self->_header.data());
+        if (error || length < 2 * LENGTH_FIELD_SIZE || length > MAX_MESSAGE_LENGTH) return self->_close();
+
+        self->_body.resize(length - LENGTH_FIELD_SIZE);
+        boost::asio::async_read(
+            *self->_socket, boost::asio::buffer(self->_body),
+            boost::asio::bind_executor(self->_strand, [self](const boost::system::error_code& error, size_t) {
+              if (error) return self->_close();
+
+              // We do not support SSL. Deny the request and wait for the actual startup packet.
+              if (read_length_field(self->_body.data()) == SSL_REQUEST_CODE) {
+                self->_write(std::string(1, static_cast<char>(PostgresMessageType::SslNo)));
+                self->_read_startup_packet();
+                return;
+              }
+
+              self->_message_stream->append_input(self->_header.data(), LENGTH_FIELD_SIZE);
+              self->_message_stream->append_input(self->_body.data(), self->_body.size());
+
+              // Establishing the connection does not execute any queries, so it is done on the I/O thread.
+              try {
+                self->_session.establish_connection();
+              } catch (const std::exception&) {
+                return self->_close();
+              }
+              self->_write(self->_message_stream->take_output());
+              self->_on_message_handled(false);
+            }));
+      }));
+}
+
+void AsyncSession::_read_message() {
+  boost::asio::async_read(
+      *_socket, boost::asio::buffer(_header.data(), sizeof(PostgresMessageType) + LENGTH_FIELD_SIZE),
+      boost::asio::bind_executor(_strand, [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+        const auto length = read_length_field(self->_header.data() + sizeof(PostgresMessageType));
+        if (error || length < LENGTH_FIELD_SIZE || length > MAX_MESSAGE_LENGTH) return self->_close();
+
+        self->_body.resize(length - LENGTH_FIELD_SIZE);
+        boost::asio::async_read(
+            *self->_socket, boost::asio::buffer(self->_body),
+            boost::asio::bind_executor(self->_strand, [self](const boost::system::error_code& error, size_t) {
+              if (error) return self->_close();
+
+              self->_message_stream->append_input(self->_header.data(), self->_header.size());
+              self->_message_stream->append_input(self->_body.data(), self->_body.size());
+              self->_handle_message();
+            }));
+      }));
+}
+
+void AsyncSession::_handle_message() {
+  // The message is handled by a scheduler worker. The session and the message stream are not accessed by the strand
+  // until _on_message_handled is called.
+  const auto task = std::make_shared<JobTask>([self = shared_from_this()]() {
+    const auto continue_session = self->_session.handle_request();
+    boost::asio::post(self->_strand,
+                      [self, output = self->_message_stream->take_output(), continue_session]() mutable {
+                        if (!output.empty()) self->_write(std::move(output));
+                        self->_on_message_handled(!continue_session);
+                      });
+  });
+  task->schedule();
+}
+
+void AsyncSession::_on_message_handled(const bool terminate) {
+  if (terminate || _is_closed) return _close();
+
+  // Only read the next message once the response has been written. This way, clients that do not read their results
+  // cannot make the server buffer an unbounded amount of data.
+  if (_is_writing) {
+    _read_after_write = true;
+  } else {
+    _read_message();
+  }
+}
+
+void AsyncSession::_write(std::string&& data) {
+  {
+    const auto lock = std::lock_guard{_pending_write_mutex};
+    _pending_write_bytes += data.size();
+  }
+  _enqueue_write(std::move(data));
+}
+
+void AsyncSession::_enqueue_write(std::string&& data) {
+  if (_is_closed) return;
+
+  _pending_writes.emplace_back(std::move(data));
+  if (!_is_writing) _write_next();
+}
+
+void AsyncSession::_write_next() {
+  _is_writing = true;
+  boost::asio::async_write(
+      *_socket, boost::asio::buffer(_pending_writes.front()),
+      boost::asio::bind_executor(_strand, [self = shared_from_this()](const boost::system::error_code& error, size_t) {
+        if (error) return self->_close();
+
+        {
+          const auto lock = std::lock_guard{self->_pending_write_mutex};
+          self->_pending_write_bytes -= self->_pending_writes.front().size();
+        }
+        self->_pending_writes_drained.notify_all();
+
+        self->_pending_writes.pop_front();
+        if (!self->_pending_writes.empty()) return self->_write_next();
+
+        self->_is_writing = false;
+        if (self->_read_after_write) {
+          self->_read_after_write = false;
+          self->_read_message();
+        }
+      }));
+}
+
+void AsyncSession::_close() {
+  if (_is_closed) return;
+  {
+    const auto lock = std::lock_guard{_pending_write_mutex};
+    _is_closed = true;
+  }
+  // Wake up an output handler that waits for the socket, its data is discarded.
+  _pending_writes_drained.notify_all();
+
+  // Pending operations complete with an error and release their references to the session.
+  auto error = boost::system::error_code{};
+  _socket->shutdown(boost::asio::ip::tcp::socket::shutdown_both, error);
+  _socket->close(error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include <boost/asio.hpp>
+
+#include "message_stream.hpp"
+#include "server_types.hpp"
+#include "session.hpp"
+
+namespace opossum {
+
+// Session for the asynchronous mode of the server. Instead of blocking a thread per client, all AsyncSessions share a
+// small pool of I/O threads that run the io_service. An AsyncSession
+//  - asynchronously reads one complete message (the PostgreSQL protocol prefixes each message with its length),
+//  - hands it to a Session<MessageStream> that is executed as a JobTask by the Hyrise scheduler, so that the I/O
+//    threads never execute queries, and
+//  - asynchronously writes the response. Large results are passed to the I/O threads in parts while they are still
+//    being serialized (see MessageStream::OUTPUT_HANDLER_THRESHOLD). Serializing pauses while the parts that have not
+//    been written to the socket exceed MAX_PENDING_WRITE_BYTES (see async_session.cpp).
+// Only one message of a client is handled at a time. The handlers of a session run on a strand and keep the session
+// alive until the client closes the connection.
+class AsyncSession : public std::enable_shared_from_this<AsyncSession> {
+ public:
+  AsyncSession(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info,
+               std::atomic<uint64_t>& num_running_sessions);
+
+  ~AsyncSession();
+
+  // Start reading the startup packet of the connected client.
+  void start();
+
+  std::shared_ptr<Socket> socket();
+
+ private:
+  void _read_startup_packet();
+  void _read_message();
+  void _handle_message();
+
+  // Write data to the client. Must be called on the strand. Writes are performed in the order of the calls.
+  void _write(std::string&& data);
+  // Same as _write, but for data that has already been added to _pending_write_bytes
+  void _enqueue_write(std::string&& data);
+  void _write_next();
+
+  // Called on the strand once the current message has been handled. Reads the next message once all output has been
+  // written.
+  void _on_message_handled(const bool terminate);
+
+  void _close();
+
+  boost::asio::io_service::strand _strand;
+  const std::shared_ptr<Socket> _socket;
+  const std::shared_ptr<MessageStream> _message_stream;
+  Session<MessageStream> _session;
+  std::atomic<uint64_t>& _num_running_sessions;
+  bool _is_started{false};
+
+  // Header of the message that is currently read: one byte for the message type (except for the startup packet) and
+  // the message length
+  std::array<char, 5> _header{};
+  std::vector<char> _body;
+
+  std::deque<std::string> _pending_writes;
+  bool _is_writing{false};
+  // Set if the current message has been handled while its response was still being written
+  bool _read_after_write{false};
+
+  // Size of the output that has been passed to the strand but not yet written to the socket. The output handler waits
+  // for _pending_writes_drained while it exceeds MAX_PENDING_WRITE_BYTES. _is_closed is only modified on the strand,
+  // but also read by the output handler, so both are protected by _pending_write_mutex.
+  std::mutex _pending_write_mutex;
+  std::condition_variable _pending_writes_drained;
+  size_t _pending_write_bytes{0};
+  bool _is_closed{false};
+};
+
+}  // namespace opossum
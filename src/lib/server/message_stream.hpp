@@ -0,0 +1,81 @@
+#pragma once
+
+#include <functional>
+#include <string>
+#include <utility>
+
+#include <boost/asio.hpp>
+
+namespace opossum {
+
+// In-memory stream that lets the ReadBuffer and the WriteBuffer (and thus the PostgresProtocolHandler) operate on
+// messages that an AsyncSession received from and sends to the network asynchronously. It fulfills the requirements of
+// boost::asio's SyncReadStream and SyncWriteStream, but never blocks: Reading beyond the received input fails with
+// boost::asio::error::eof, and written data is collected until it is taken by the session.
+class MessageStream {
+ public:
+  // Once the collected output exceeds this size, it is passed to the output handler (if set) so that large results can
+  // be sent while they are still being serialized.
+  static constexpr auto OUTPUT_HANDLER_THRESHOLD = size_t{64 * 1024};
+
+  using OutputHandler = std::function<void(std::string&&)>;
+
+  void append_input(const char* data, const size_t size) {
+    // Drop the input that has been read already
+    _input.erase(0, _read_position);
+    _read_position = 0;
+    _input.append(data, size);
+  }
+
+  size_t unread_input_size() const { return _input.size() - _read_position; }
+
+  std::string take_output() { return std::exchange(_output, std::string{}); }
+
+  void set_output_handler(const OutputHandler& output_handler) { _output_handler = output_handler; }
+
+  template <typename MutableBufferSequence>
+  size_t read_some(const MutableBufferSequence& buffers, boost::system::error_code& error_code) {
+    const auto bytes_read =
+        boost::asio::buffer_copy(buffers, boost::asio::buffer(_input.data() + _read_position, unread_input_size()));
+    _read_position += bytes_read;
+    error_code = bytes_read == 0 && boost::asio::buffer_size(buffers) > 0 ? boost::asio::error::eof
+                                                                           : boost::system::error_code{};
+    return bytes_read;
+  }
+
+  template <typename MutableBufferSequence>
+  size_t read_some(const MutableBufferSequence& buffers) {
+    auto error_code = boost::system::error_code{};
+    const auto bytes_read = read_some(buffers, error_code);
+    if (error_code) throw boost::system::system_error(error_code);
+    return bytes_read;
+  }
+
+  template <typename ConstBufferSequence>
+  size_t write_some(const ConstBufferSequence& buffers, boost::system::error_code& error_code) {
+    const auto bytes_to_write = boost::asio::buffer_size(buffers);
+    const auto previous_size = _output.size();
+    _output.resize(previous_size + bytes_to_write);
+    boost::asio::buffer_copy(boost::asio::buffer(_output.data() + previous_size, bytes_to_write), buffers);
+    error_code = {};
+
+    if (_output_handler && _output.size() >= OUTPUT_HANDLER_THRESHOLD) {
+      _output_handler(take_output());
+    }
+    return bytes_to_write;
+  }
+
+  template <typename ConstBufferSequence>
+  size_t write_some(const ConstBufferSequence& buffers) {
+    auto error_code = boost::system::error_code{};
+    return write_some(buffers, error_code);
+  }
+
+ private:
+  std::string _input;
+  size_t _read_position{0};
+  std::string _output;
+  OutputHandler _output_handler;
+};
+
+}  // namespace opossum
@@ -1,11 +1,16 @@
 #pragma once
 
+#include <cstdint>
+
 namespace opossum {
 
 // Each message contains a field (4 bytes) indicating the packet's size including itself. Using extra variable here to
 // avoid magic numbers.
 static constexpr auto LENGTH_FIELD_SIZE = 4u;
 
+// Special protocol version number of the startup packet that we catch to deny SSL support
+static constexpr auto SSL_REQUEST_CODE = 80877103u;
+
 // Documentation of the message types can be found here:
 // https://www.postgresql.org/docs/12/protocol-message-formats.html
 enum class PostgresMessageType : unsigned char {
@@ -45,6 +50,10 @@ enum class PostgresMessageType : unsigned char {
   Notice = 'N',
 };
 
+// Format of parameter and result values. Clients choose the format of each result column in the Bind message. Values in
+// binary format are sent in network byte order, strings are sent as their raw bytes in either format.
+enum class PostgresFormatCode : int16_t { Text = 0, Binary = 1 };
+
 enum class TransactionStatusIndicator : unsigned char {
   Idle = 'I',
   InTransactionBlock = 'T',
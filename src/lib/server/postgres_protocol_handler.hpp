@@ -11,11 +11,14 @@ namespace opossum {
 
 using ErrorMessage = std::unordered_map<PostgresMessageType, std::string>;
 
-// This struct stores a prepared statement's name, its portal used and the specified parameters.
+// This struct stores a prepared statement's name, its portal used, the specified parameters, and the requested formats
+// of the result columns. The format codes are stored as sent by the client: No format code means that all columns use
+// the text format, a single format code applies to all columns, otherwise there is one format code per column.
 struct PreparedStatementDetails {
   std::string statement_name;
   std::string portal;
   std::vector<AllTypeVariant> parameters;
+  std::vector<PostgresFormatCode> result_format_codes;
 };
 
 // This class extracts information from client messages and serializes the response data according to the PostgreSQL
@@ -44,14 +47,18 @@ class PostgresProtocolHandler {
 
   // Send query result
   void send_row_description_header(const uint32_t total_column_name_length, const uint16_t column_count);
-  void send_row_description(const std::string& column_name, const uint32_t object_id, const int16_t type_width);
+  void send_row_description(const std::string& column_name, const uint32_t object_id, const int16_t type_width,
+                            const PostgresFormatCode format_code = PostgresFormatCode::Text);
   void send_data_row(const std::vector<std::optional<std::string>>& values_as_strings,
                      const uint32_t string_length_sum);
+  // Send DataRow messages that have already been serialized (see ResultSerializer)
+  void send_serialized_data_rows(const std::vector<char>& data_rows);
   void send_command_complete(const std::string& command_complete_message);
 
   // Messages for parsing prepared statements
   std::pair<std::string, std::string> read_parse_packet();
   void read_sync_packet();
+  void read_flush_packet();
 
   // Send out status message containing PostgresMessageType and length
   void send_status_message(const PostgresMessageType message_type);
@@ -67,8 +74,10 @@ class PostgresProtocolHandler {
   // Additional (optional) message containing execution times of different components (such as translator or optimizer)
   void send_execution_info(const std::string& execution_information);
 
-  // This method is required for testing. Otherwise we cannot make the protocol handler flush its data.
-  void force_flush() { _write_buffer.flush(); }
+  // Send all buffered data, e.g., when the client sent a Flush message. This is also required for testing.
+  void force_flush() {
+    if (_write_buffer.size() > 0) _write_buffer.flush();
+  }
 
  private:
   void _ssl_deny();
@@ -1,7 +1,9 @@
 #include "query_handler.hpp"
 
 #include "expression/value_expression.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
 #include "optimizer/optimizer.hpp"
+#include "optimizer/strategy/chunk_pruning_rule.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_translator.hpp"
 
@@ -79,13 +81,7 @@ std::shared_ptr<AbstractOperator> QueryHandler::bind_prepared_plan(const Prepare
 
   const auto prepared_plan = Hyrise::get().storage_manager.get_prepared_plan(statement_details.statement_name);
 
-  auto parameter_expressions = std::vector<std::shared_ptr<AbstractExpression>>{statement_details.parameters.size()};
-  for (auto parameter_idx = size_t{0}; parameter_idx < statement_details.parameters.size(); ++parameter_idx) {
-    parameter_expressions[parameter_idx] =
-        std::make_shared<ValueExpression>(statement_details.parameters[parameter_idx]);
-  }
-
-  auto lqp = prepared_plan->instantiate(parameter_expressions);
+  auto lqp = prepared_plan->instantiate(_parameter_expressions(statement_details));
   const auto optimizer = Optimizer::create_default_optimizer();
   lqp = optimizer->optimize(std::move(lqp));
 
@@ -94,6 +90,28 @@ std::shared_ptr<AbstractOperator> QueryHandler::bind_prepared_plan(const Prepare
   return pqp;
 }
 
+std::shared_ptr<AbstractOperator> QueryHandler::bind_prepared_plan(const PreparedStatementDetails& statement_details,
+                                                                   OptimizedPreparedPlans& optimized_prepared_plans) {
+  AssertInput(Hyrise::get().storage_manager.has_prepared_plan(statement_details.statement_name),
+              "The specified statement does not exist.");
+
+  const auto prepared_plan = Hyrise::get().storage_manager.get_prepared_plan(statement_details.statement_name);
+
+  auto& optimized_prepared_plan = optimized_prepared_plans[statement_details.statement_name];
+  if (optimized_prepared_plan.prepared_plan != prepared_plan) {
+    optimized_prepared_plan = _optimize_with_placeholders(prepared_plan);
+  }
+
+  if (!optimized_prepared_plan.optimized_lqp) return bind_prepared_plan(statement_details);
+
+  // Instantiating the plan copies it, so that the optimized plan is not modified.
+  auto lqp = PreparedPlan{optimized_prepared_plan.optimized_lqp, prepared_plan->parameter_ids}.instantiate(
+      _parameter_expressions(statement_details));
+  if (optimized_prepared_plan.has_placeholder_predicates) lqp = ChunkPruningRule::prune_instantiated_plan(lqp);
+
+  return LQPTranslator{}.translate_node(lqp);
+}
+
 std::shared_ptr<const Table> QueryHandler::execute_prepared_plan(
     const std::shared_ptr<AbstractOperator>& physical_plan) {
   const auto tasks = OperatorTask::make_tasks_from_operator(physical_plan);
@@ -101,6 +119,51 @@ std::shared_ptr<const Table> QueryHandler::execute_prepared_plan(
   return static_cast<const OperatorTask&>(*tasks.back()).get_operator()->get_output();
 }
 
+std::vector<std::shared_ptr<const Table>> QueryHandler::execute_prepared_plans(
+    const std::vector<std::shared_ptr<AbstractOperator>>& physical_plans) {
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto root_tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (const auto& physical_plan : physical_plans) {
+    const auto plan_tasks = OperatorTask::make_tasks_from_operator(physical_plan);
+    tasks.insert(tasks.end(), plan_tasks.begin(), plan_tasks.end());
+    root_tasks.emplace_back(plan_tasks.back());
+  }
+
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+  auto result_tables = std::vector<std::shared_ptr<const Table>>{};
+  result_tables.reserve(root_tasks.size());
+  for (const auto& root_task : root_tasks) {
+    result_tables.emplace_back(static_cast<const OperatorTask&>(*root_task).get_operator()->get_output());
+  }
+  return result_tables;
+}
+
+std::vector<std::shared_ptr<AbstractExpression>> QueryHandler::_parameter_expressions(
+    const PreparedStatementDetails& statement_details) {
+  auto parameter_expressions = std::vector<std::shared_ptr<AbstractExpression>>{statement_details.parameters.size()};
+  for (auto parameter_idx = size_t{0}; parameter_idx < statement_details.parameters.size(); ++parameter_idx) {
+    parameter_expressions[parameter_idx] =
+        std::make_shared<ValueExpression>(statement_details.parameters[parameter_idx]);
+  }
+  return parameter_expressions;
+}
+
+OptimizedPreparedPlan QueryHandler::_optimize_with_placeholders(const std::shared_ptr<PreparedPlan>& prepared_plan) {
+  auto optimized_prepared_plan = OptimizedPreparedPlan{prepared_plan, nullptr, false};
+  try {
+    // The prepared plan contains placeholders for its parameters. Copy it, so that the registered plan is not modified.
+    const auto optimizer = Optimizer::create_default_optimizer();
+    optimized_prepared_plan.optimized_lqp = optimizer->optimize(prepared_plan->lqp->deep_copy());
+    optimized_prepared_plan.has_placeholder_predicates =
+        lqp_has_placeholder_predicates(optimized_prepared_plan.optimized_lqp);
+  } catch (const std::exception&) {
+    // Some rules and expressions cannot handle placeholders. The plan is then optimized after binding its parameters.
+    optimized_prepared_plan.optimized_lqp = nullptr;
+  }
+  return optimized_prepared_plan;
+}
+
 void QueryHandler::_handle_transaction_statement_message(ExecutionInformation& execution_info,
                                                          SQLPipeline& sql_pipeline) {
   // handle custom user feedback (command complete messages) for transaction statements
@@ -5,6 +5,7 @@
 #include "operators/abstract_operator.hpp"
 #include "postgres_protocol_handler.hpp"
 #include "sql/sql_pipeline.hpp"
+#include "storage/prepared_plan.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
@@ -20,6 +21,20 @@ struct ExecutionInformation {
   std::optional<std::string> custom_command_complete_message;
 };
 
+// A prepared plan that has been optimized with placeholders for its parameters. Binding it only requires filling in
+// the parameters and translating it.
+struct OptimizedPreparedPlan {
+  // The plan as registered in the StorageManager, used to detect that the prepared statement has been redefined
+  std::shared_ptr<PreparedPlan> prepared_plan;
+  // nullptr if the plan cannot be optimized with placeholders. It is then optimized after binding the parameters.
+  std::shared_ptr<AbstractLQPNode> optimized_lqp;
+  bool has_placeholder_predicates{false};
+};
+
+// Optimized prepared plans by statement name. Each session keeps its own, as other sessions might redefine prepared
+// statements.
+using OptimizedPreparedPlans = std::unordered_map<std::string, OptimizedPreparedPlan>;
+
 // This class manages the interaction between the server and the database component. Furthermore, most of the SQL-based
 // error handling happens in this class.
 class QueryHandler {
@@ -32,9 +47,23 @@ class QueryHandler {
 
   static std::shared_ptr<AbstractOperator> bind_prepared_plan(const PreparedStatementDetails& statement_details);
 
+  // Binds the prepared plan without running the optimizer for every set of parameters. Instead, the plan is optimized
+  // with placeholders once and stored in optimized_prepared_plans.
+  static std::shared_ptr<AbstractOperator> bind_prepared_plan(const PreparedStatementDetails& statement_details,
+                                                              OptimizedPreparedPlans& optimized_prepared_plans);
+
   static std::shared_ptr<const Table> execute_prepared_plan(const std::shared_ptr<AbstractOperator>& physical_plan);
 
+  // Executes plans that do not depend on each other as one batch of tasks
+  static std::vector<std::shared_ptr<const Table>> execute_prepared_plans(
+      const std::vector<std::shared_ptr<AbstractOperator>>& physical_plans);
+
  private:
+  static std::vector<std::shared_ptr<AbstractExpression>> _parameter_expressions(
+      const PreparedStatementDetails& statement_details);
+
+  static OptimizedPreparedPlan _optimize_with_placeholders(const std::shared_ptr<PreparedPlan>& prepared_plan);
+
   static void _handle_transaction_statement_message(ExecutionInformation& execution_info, SQLPipeline& sql_pipeline);
 };
 
@@ -1,6 +1,7 @@
 #include "read_buffer.hpp"
 
 #include "client_disconnect_exception.hpp"
+#include "message_stream.hpp"
 
 namespace opossum {
 
@@ -113,5 +114,6 @@ void ReadBuffer<SocketType>::_receive_if_necessary(const size_t bytes_required)
 
 template class ReadBuffer<Socket>;
 template class ReadBuffer<boost::asio::posix::stream_descriptor>;
+template class ReadBuffer<MessageStream>;
 
 }  // namespace opossum
@@ -1,13 +1,85 @@
 #include "result_serializer.hpp"
-#include "lossy_cast.hpp"
+
+#include <bit>
+#include <charconv>
+#include <limits>
+
+#include <boost/endian/conversion.hpp>
+#include <boost/lexical_cast.hpp>
+
+#include "message_stream.hpp"
 #include "query_handler.hpp"
+#include "scheduler/abstract_scheduler.hpp"
+#include "scheduler/job_task.hpp"
+#include "storage/segment_iterate.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+template <typename T>
+void append_network_value(std::vector<char>& buffer, const T value) {
+  const auto network_value = boost::endian::native_to_big(value);
+  const auto* bytes = reinterpret_cast<const char*>(&network_value);
+  buffer.insert(buffer.end(), bytes, bytes + sizeof(T));
+}
+
+// Append the length field and the value. Strings are represented by their bytes in both formats.
+template <typename T>
+void append_value(std::vector<char>& buffer, const T& value, const PostgresFormatCode format_code) {
+  if constexpr (std::is_same_v<T, pmr_string>) {
+    append_network_value(buffer, static_cast<int32_t>(value.size()));
+    buffer.insert(buffer.end(), value.begin(), value.end());
+  } else if (format_code == PostgresFormatCode::Binary) {
+    append_network_value(buffer, static_cast<int32_t>(sizeof(T)));
+    if constexpr (std::is_same_v<T, float>) {
+      append_network_value(buffer, std::bit_cast<uint32_t>(value));
+    } else if constexpr (std::is_same_v<T, double>) {
+      append_network_value(buffer, std::bit_cast<uint64_t>(value));
+    } else {
+      append_network_value(buffer, value);
+    }
+  } else {
+    // Some standard libraries, e.g., libc++ on macOS, do not implement std::to_chars for floating-point numbers.
+#ifdef __cpp_lib_to_chars
+    constexpr auto use_to_chars = true;
+#else
+    constexpr auto use_to_chars = !std::is_floating_point_v<T>;
+#endif
+
+    if constexpr (use_to_chars) {
+      // Floating-point values are printed with the same precision as boost::lexical_cast uses, so that they can be
+      // parsed without loss.
+      auto characters = std::array<char, 32>{};
+      auto result = std::to_chars_result{};
+      if constexpr (std::is_floating_point_v<T>) {
+        result = std::to_chars(characters.begin(), characters.end(), value, std::chars_format::general,
+                               std::numeric_limits<T>::max_digits10);
+      } else {
+        result = std::to_chars(characters.begin(), characters.end(), value);
+      }
+      DebugAssert(result.ec == std::errc{}, "Could not convert value to string");
+      append_network_value(buffer, static_cast<int32_t>(std::distance(characters.begin(), result.ptr)));
+      buffer.insert(buffer.end(), characters.begin(), result.ptr);
+    } else {
+      const auto string_value = boost::lexical_cast<std::string>(value);
+      append_network_value(buffer, static_cast<int32_t>(string_value.size()));
+      buffer.insert(buffer.end(), string_value.begin(), string_value.end());
+    }
+  }
+}
+
+}  // namespace
 
 namespace opossum {
 
 template <typename SocketType>
 void ResultSerializer::send_table_description(
     const std::shared_ptr<const Table>& table,
-    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler) {
+    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+    const std::vector<PostgresFormatCode>& format_codes) {
+  const auto column_format_codes = ResultSerializer::column_format_codes(format_codes, table->column_count());
+
   // Calculate sum of length of all column names
   uint32_t column_name_length_sum = 0;
   for (auto& column_name : table->column_names()) {
@@ -48,46 +120,119 @@ void ResultSerializer::send_table_description(
       case DataType::Null:
         Fail("Bad DataType");
     }
-    postgres_protocol_handler->send_row_description(table->column_name(column_id), object_id, type_width);
+    postgres_protocol_handler->send_row_description(table->column_name(column_id), object_id, type_width,
+                                                    column_format_codes[column_id]);
   }
 }
 
 template <typename SocketType>
 void ResultSerializer::send_query_response(
     const std::shared_ptr<const Table>& table,
-    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler) {
-  auto values_as_strings = std::vector<std::optional<std::string>>(table->column_count());
-
+    const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+    const std::vector<PostgresFormatCode>& format_codes) {
+  const auto column_format_codes = ResultSerializer::column_format_codes(format_codes, table->column_count());
   const auto chunk_count = table->chunk_count();
 
-  // Iterate over each chunk in result table
-  for (ChunkID chunk_id{0}; chunk_id < chunk_count; chunk_id++) {
-    const auto chunk = table->get_chunk(chunk_id);
-    const auto chunk_size = chunk->size();
+  // Most results of point queries consist of a single chunk. Avoid the overhead of scheduling a job for them.
+  if (chunk_count == 1) {
+    postgres_protocol_handler->send_serialized_data_rows(serialize_chunk(table->get_chunk(ChunkID{0}),
+                                                                         column_format_codes));
+    return;
+  }
+
+  // Serialized chunks are freed once they are sent. Serializing at most MAX_BUFFERED_CHUNK_COUNT chunks ahead of the
+  // chunk that is sent limits the memory consumption if the client receives the result slower than it is serialized.
+  auto serialized_chunks = std::vector<std::vector<char>>(chunk_count);
+  auto jobs = std::vector<std::shared_ptr<AbstractTask>>(chunk_count);
+  auto scheduled_chunk_count = uint32_t{0};
+
+  try {
+    for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+      const auto schedule_end = std::min(static_cast<uint32_t>(chunk_count), chunk_id + MAX_BUFFERED_CHUNK_COUNT);
+      for (; scheduled_chunk_count < schedule_end; ++scheduled_chunk_count) {
+        const auto job_chunk_id = ChunkID{scheduled_chunk_count};
+        jobs[job_chunk_id] = std::make_shared<JobTask>([&, job_chunk_id]() {
+          serialized_chunks[job_chunk_id] = serialize_chunk(table->get_chunk(job_chunk_id), column_format_codes);
+        });
+        jobs[job_chunk_id]->schedule();
+      }
 
-    const auto column_count = table->column_count();
-    auto segments = Segments(column_count);
-    for (auto column_id = ColumnID{0}; column_id < column_count; column_id++) {
-      segments[column_id] = chunk->get_segment(column_id);
+      AbstractScheduler::wait_for_tasks({jobs[chunk_id]});
+      postgres_protocol_handler->send_serialized_data_rows(serialized_chunks[chunk_id]);
+      serialized_chunks[chunk_id] = {};
     }
+  } catch (...) {
+    // The scheduled jobs reference the local variables. Let them finish, e.g., when the client disconnected.
+    AbstractScheduler::wait_for_tasks(
+        std::vector<std::shared_ptr<AbstractTask>>(jobs.begin(), jobs.begin() + scheduled_chunk_count));
+    throw;
+  }
+}
 
-    // Iterate over each row in chunk
-    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
-      auto string_length_sum = 0;
-      // Iterate over each attribute in row
-      for (auto segment_id = ColumnID{0}; segment_id < column_count; segment_id++) {
-        const auto attribute_value = (*segments[segment_id])[chunk_offset];
-        // The PostgreSQL protocol requires the conversion of values to strings
-        const auto string_value = lossy_variant_cast<pmr_string>(attribute_value);
-        if (string_value.has_value()) {
-          // Sum up string lengths for a row to save an extra loop during serialization
-          string_length_sum += string_value.value().size();
-        }
-        values_as_strings[segment_id] = string_value;
+std::vector<char> ResultSerializer::serialize_chunk(const std::shared_ptr<const Chunk>& chunk,
+                                                    const std::vector<PostgresFormatCode>& column_format_codes) {
+  const auto column_count = chunk->column_count();
+  const auto chunk_size = chunk->size();
+
+  // The values are serialized column by column, including their length fields, so that each segment is resolved only
+  // once. Afterwards, the DataRow messages are assembled from the serialized values.
+  auto serialized_columns = std::vector<std::vector<char>>(column_count);
+  auto value_offsets = std::vector<std::vector<size_t>>(column_count, std::vector<size_t>(chunk_size + 1));
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    auto& serialized_column = serialized_columns[column_id];
+    auto& offsets = value_offsets[column_id];
+    const auto format_code = column_format_codes[column_id];
+
+    auto chunk_offset = ChunkOffset{0};
+    segment_iterate(*chunk->get_segment(column_id), [&](const auto& position) {
+      offsets[chunk_offset] = serialized_column.size();
+      ++chunk_offset;
+      if (position.is_null()) {
+        // NULL values are represented by setting the value's length to -1
+        append_network_value(serialized_column, int32_t{-1});
+      } else {
+        append_value(serialized_column, position.value(), format_code);
       }
-      postgres_protocol_handler->send_data_row(values_as_strings, string_length_sum);
+    });
+    offsets[chunk_size] = serialized_column.size();
+  }
+
+  // The documentation of the fields in this message can be found at:
+  // https://www.postgresql.org/docs/12/static/protocol-message-formats.html
+  auto data_rows_size = static_cast<size_t>(chunk_size) * (sizeof(PostgresMessageType) + LENGTH_FIELD_SIZE +
+                                                           sizeof(uint16_t));
+  for (const auto& serialized_column : serialized_columns) {
+    data_rows_size += serialized_column.size();
+  }
+
+  auto data_rows = std::vector<char>{};
+  data_rows.reserve(data_rows_size);
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+    auto message_length = size_t{LENGTH_FIELD_SIZE + sizeof(uint16_t)};
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      message_length += value_offsets[column_id][chunk_offset + 1] - value_offsets[column_id][chunk_offset];
+    }
+
+    data_rows.push_back(static_cast<char>(PostgresMessageType::DataRow));
+    append_network_value(data_rows, static_cast<uint32_t>(message_length));
+    append_network_value(data_rows, static_cast<uint16_t>(column_count));
+    for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+      const auto& serialized_column = serialized_columns[column_id];
+      data_rows.insert(data_rows.end(), serialized_column.begin() + value_offsets[column_id][chunk_offset],
+                       serialized_column.begin() + value_offsets[column_id][chunk_offset + 1]);
     }
   }
+
+  return data_rows;
+}
+
+std::vector<PostgresFormatCode> ResultSerializer::column_format_codes(
+    const std::vector<PostgresFormatCode>& format_codes, const ColumnCount column_count) {
+  if (format_codes.empty()) return std::vector<PostgresFormatCode>(column_count, PostgresFormatCode::Text);
+  if (format_codes.size() == 1) return std::vector<PostgresFormatCode>(column_count, format_codes.front());
+
+  AssertInput(format_codes.size() == column_count, "Expected one result format code per column");
+  return format_codes;
 }
 
 std::string ResultSerializer::build_command_complete_message(const ExecutionInformation& execution_information,
@@ -123,17 +268,29 @@ std::string ResultSerializer::build_command_complete_message(const OperatorType
 }
 
 template void ResultSerializer::send_table_description<Socket>(const std::shared_ptr<const Table>&,
-                                                               const std::shared_ptr<PostgresProtocolHandler<Socket>>&);
+                                                               const std::shared_ptr<PostgresProtocolHandler<Socket>>&,
+                                                               const std::vector<PostgresFormatCode>&);
 
 template void ResultSerializer::send_table_description<boost::asio::posix::stream_descriptor>(
     const std::shared_ptr<const Table>&,
-    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&);
+    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&,
+    const std::vector<PostgresFormatCode>&);
+
+template void ResultSerializer::send_table_description<MessageStream>(
+    const std::shared_ptr<const Table>&, const std::shared_ptr<PostgresProtocolHandler<MessageStream>>&,
+    const std::vector<PostgresFormatCode>&);
 
 template void ResultSerializer::send_query_response<Socket>(const std::shared_ptr<const Table>&,
-                                                            const std::shared_ptr<PostgresProtocolHandler<Socket>>&);
+                                                            const std::shared_ptr<PostgresProtocolHandler<Socket>>&,
+                                                            const std::vector<PostgresFormatCode>&);
 
 template void ResultSerializer::send_query_response<boost::asio::posix::stream_descriptor>(
     const std::shared_ptr<const Table>&,
-    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&);
+    const std::shared_ptr<PostgresProtocolHandler<boost::asio::posix::stream_descriptor>>&,
+    const std::vector<PostgresFormatCode>&);
+
+template void ResultSerializer::send_query_response<MessageStream>(
+    const std::shared_ptr<const Table>&, const std::shared_ptr<PostgresProtocolHandler<MessageStream>>&,
+    const std::vector<PostgresFormatCode>&);
 
 }  // namespace opossum
@@ -1,6 +1,8 @@
 #pragma once
 
 #include <memory>
+#include <vector>
+
 #include "operators/abstract_operator.hpp"
 #include "postgres_protocol_handler.hpp"
 #include "storage/table.hpp"
@@ -12,17 +14,33 @@ struct ExecutionInformation;
 // The ResultSerializer serializes the result data returned by Hyrise according to PostgreSQL Wire Protocol.
 class ResultSerializer {
  public:
-  // Serialize information about the result table
+  // Maximum number of chunks that send_query_response serializes ahead of the chunk that is currently sent
+  static constexpr auto MAX_BUFFERED_CHUNK_COUNT = uint32_t{8};
+
+  // Serialize information about the result table. The format codes are the requested formats of the result columns as
+  // sent by the client (see PreparedStatementDetails).
   template <typename SocketType>
   static void send_table_description(
       const std::shared_ptr<const Table>& table,
-      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler);
+      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+      const std::vector<PostgresFormatCode>& format_codes = {});
 
+  // Serialize the chunks of the result table in parallel and send their rows. Each chunk is sent as soon as it and all
+  // previous chunks are serialized, while the following chunks are still being serialized.
   template <typename SocketType>
-  // Cast attributes of the result table and send them row-wise
   static void send_query_response(
       const std::shared_ptr<const Table>& table,
-      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler);
+      const std::shared_ptr<PostgresProtocolHandler<SocketType>>& postgres_protocol_handler,
+      const std::vector<PostgresFormatCode>& format_codes = {});
+
+  // Serialize the rows of a chunk as DataRow messages. The values are encoded directly from the segment iterators
+  // without converting them to AllTypeVariants.
+  static std::vector<char> serialize_chunk(const std::shared_ptr<const Chunk>& chunk,
+                                           const std::vector<PostgresFormatCode>& column_format_codes);
+
+  // Resolve the format codes sent by the client to one format code per column
+  static std::vector<PostgresFormatCode> column_format_codes(const std::vector<PostgresFormatCode>& format_codes,
+                                                             const ColumnCount column_count);
 
   // Build completion message after query execution containing the statement type and the number of rows affected
   static std::string build_command_complete_message(const ExecutionInformation& execution_information,
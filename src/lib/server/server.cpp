@@ -4,6 +4,7 @@
 
 #include <iostream>
 #include <thread>
+#include <vector>
 
 #include "hyrise.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
@@ -12,8 +13,14 @@ namespace opossum {
 
 // Specified port (default: 5432) will be opened after initializing the _acceptor
 Server::Server(const boost::asio::ip::address& address, const uint16_t port,
-               const SendExecutionInfo send_execution_info)
-    : _acceptor(_io_service, boost::asio::ip::tcp::endpoint(address, port)), _send_execution_info(send_execution_info) {
+               const SendExecutionInfo send_execution_info, const PlanCacheType plan_cache_type,
+               const ServerMode server_mode, const uint32_t io_thread_count)
+    : _acceptor(_io_service, boost::asio::ip::tcp::endpoint(address, port)),
+      _send_execution_info(send_execution_info),
+      _plan_cache_type(plan_cache_type),
+      _server_mode(server_mode),
+      _io_thread_count(io_thread_count) {
+  Assert(_io_thread_count > 0, "At least one I/O thread is required");
   std::cout << "Server started at " << server_address() << " and port " << server_port() << std::endl
             << "Run 'psql -h localhost " << server_address() << "' to connect to the server" << std::endl;
 }
@@ -25,24 +32,37 @@ void Server::run() {
   Hyrise::get().set_scheduler(std::make_shared<opossum::NodeQueueScheduler>());
 
   // Set caches
-  Hyrise::get().default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
-  Hyrise::get().default_lqp_cache = std::make_shared<SQLLogicalPlanCache>();
+  set_default_plan_caches(_plan_cache_type);
 
   _is_initialized = true;
-  _accept_new_session();
+  if (_server_mode == ServerMode::ThreadPerSession) {
+    _accept_new_session();
+    _io_service.run();
+    return;
+  }
+
+  _accept_new_async_session();
+  auto io_threads = std::vector<std::thread>{};
+  for (auto thread_id = uint32_t{1}; thread_id < _io_thread_count; ++thread_id) {
+    io_threads.emplace_back([&]() { _io_service.run(); });
+  }
   _io_service.run();
+  for (auto& io_thread : io_threads) {
+    io_thread.join();
+  }
 }
 
 void Server::_accept_new_session() {
   // Create a new session. This will also open a new data socket in order to communicate with the client
   // For more information on TCP ports + Asio see:
   // https://www.gamedev.net/forums/topic/586557-boostasio-allowing-multiple-connections-to-a-single-server-socket/
-  auto new_session = std::make_shared<Session>(_io_service, _send_execution_info);
+  auto new_session = std::make_shared<Session<Socket>>(std::make_shared<Socket>(_io_service), _send_execution_info);
   _acceptor.async_accept(*(new_session->socket()),
                          boost::bind(&Server::_start_session, this, new_session, boost::asio::placeholders::error));
 }
 
-void Server::_start_session(const std::shared_ptr<Session>& new_session, const boost::system::error_code& error) {
+void Server::_start_session(const std::shared_ptr<Session<Socket>>& new_session,
+                            const boost::system::error_code& error) {
   Assert(!error, error.message());
 
   std::thread session_thread([session = new_session, &num_running_sessions = this->_num_running_sessions]() mutable {
@@ -72,6 +92,16 @@ void Server::_start_session(const std::shared_ptr<Session>& new_session, const b
   _accept_new_session();
 }
 
+void Server::_accept_new_async_session() {
+  // The session counts itself as running once it is started and until it is destroyed.
+  auto new_session = std::make_shared<AsyncSession>(_io_service, _send_execution_info, _num_running_sessions);
+  _acceptor.async_accept(*new_session->socket(), [this, new_session](const boost::system::error_code& error) {
+    Assert(!error, error.message());
+    new_session->start();
+    _accept_new_async_session();
+  });
+}
+
 boost::asio::ip::address Server::server_address() const { return _acceptor.local_endpoint().address(); }
 
 uint16_t Server::server_port() const { return _acceptor.local_endpoint().port(); }
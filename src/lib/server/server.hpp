@@ -3,8 +3,10 @@
 #include <boost/asio/io_service.hpp>
 #include <boost/asio/ip/tcp.hpp>
 
+#include "async_session.hpp"
 #include "server_types.hpp"
 #include "session.hpp"
+#include "sql/sql_plan_cache.hpp"
 
 namespace opossum {
 
@@ -13,6 +15,9 @@ namespace opossum {
 *  Server - Opens and binds a server socket. Starts a new session per client.
 *  Session - Creates a data socket for client server communication. It is responsible for the message flow and holds
 *            session-specific data.
+*  AsyncSession - Used instead of a thread per Session in the asynchronous server mode. Receives and sends messages
+*                 asynchronously and lets a Session handle them on the scheduler.
+*  MessageStream - In-memory stream between an AsyncSession and its Session.
 *  PostgresProtocolHandler - This class operates on the message level. It serializes and de-serializes information from
 *                            messages.
 *  PostgresMessageTypes - Set of different message types supported by Hyrise.
@@ -29,7 +34,11 @@ namespace opossum {
 
 class Server {
  public:
-  Server(const boost::asio::ip::address& address, const uint16_t port, const SendExecutionInfo send_execution_info);
+  // In the asynchronous server mode, io_thread_count threads (including the one calling run()) handle the network I/O
+  // of all sessions.
+  Server(const boost::asio::ip::address& address, const uint16_t port, const SendExecutionInfo send_execution_info,
+         const PlanCacheType plan_cache_type = PlanCacheType::GDFS,
+         const ServerMode server_mode = ServerMode::ThreadPerSession, const uint32_t io_thread_count = 1);
 
   // Start server to accept new sessions.
   void run();
@@ -49,12 +58,17 @@ class Server {
  private:
   void _accept_new_session();
 
-  void _start_session(const std::shared_ptr<Session>& new_session, const boost::system::error_code& error);
+  void _start_session(const std::shared_ptr<Session<Socket>>& new_session, const boost::system::error_code& error);
+
+  void _accept_new_async_session();
 
   std::atomic<uint64_t> _num_running_sessions{0};
   boost::asio::io_service _io_service;
   boost::asio::ip::tcp::acceptor _acceptor;
   const SendExecutionInfo _send_execution_info;
+  const PlanCacheType _plan_cache_type;
+  const ServerMode _server_mode;
+  const uint32_t _io_thread_count;
   std::atomic_bool _is_initialized{false};
 };
 }  // namespace opossum
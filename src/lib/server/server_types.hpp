@@ -10,4 +10,8 @@ enum class HasNullTerminator : bool { Yes = true, No = false };
 
 enum class SendExecutionInfo : bool { Yes = true, No = false };
 
+// ThreadPerSession: Each session runs in a thread of its own and blocks while waiting for the client (see Session).
+// Async: All sessions share a small pool of I/O threads, queries are executed by the scheduler (see AsyncSession).
+enum class ServerMode { ThreadPerSession, Async };
+
 }  // namespace opossum
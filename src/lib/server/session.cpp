@@ -1,46 +1,95 @@
 #include "session.hpp"
 
 #include "client_disconnect_exception.hpp"
+#include "message_stream.hpp"
+#include "operators/pqp_utils.hpp"
 #include "postgres_message_type.hpp"
 #include "query_handler.hpp"
 #include "result_serializer.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+bool modifies_data(const std::shared_ptr<AbstractOperator>& physical_plan) {
+  auto modifies_data = false;
+  visit_pqp(physical_plan, [&](const auto& op) {
+    switch (op->type()) {
+      case OperatorType::Insert:
+      case OperatorType::Update:
+      case OperatorType::Delete:
+      case OperatorType::ChangeMetaTable:
+      case OperatorType::CreateTable:
+      case OperatorType::CreatePreparedPlan:
+      case OperatorType::CreateView:
+      case OperatorType::DropTable:
+      case OperatorType::DropView:
+      case OperatorType::Import:
+        modifies_data = true;
+        return PQPVisitation::DoNotVisitInputs;
+      default:
+        return PQPVisitation::VisitInputs;
+    }
+  });
+  return modifies_data;
+}
+
+}  // namespace
+
 namespace opossum {
 
-Session::Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info)
-    : _socket(std::make_shared<Socket>(io_service)),
-      _postgres_protocol_handler(std::make_shared<PostgresProtocolHandler<Socket>>(_socket)),
+template <typename SocketType>
+Session<SocketType>::Session(const std::shared_ptr<SocketType>& socket, const SendExecutionInfo send_execution_info)
+    : _socket(socket),
+      _postgres_protocol_handler(std::make_shared<PostgresProtocolHandler<SocketType>>(_socket)),
       _send_execution_info(send_execution_info) {}
 
-std::shared_ptr<Socket> Session::socket() { return _socket; }
-
-void Session::run() {
-  // Set TCP_NODELAY in order to disable Nagle's algorithm. It handles congestion control in TCP networks. Therefore,
-  // small packets are buffered and sent out later as one large packet. This might introduce a delay of up to 40 ms
-  // which we have to avoid. Further reading: https://howdoesinternetwork.com/2015/nagles-algorithm
-  _socket->set_option(boost::asio::ip::tcp::no_delay(true));
-  _establish_connection();
-  while (!_terminate_session) {
-    try {
-      _handle_request();
-    } catch (const ClientDisconnectException&) {
-      return;
-    } catch (const std::exception& e) {
+template <typename SocketType>
+std::shared_ptr<SocketType> Session<SocketType>::socket() {
+  return _socket;
+}
+
+template <typename SocketType>
+void Session<SocketType>::run() {
+  if constexpr (std::is_same_v<SocketType, Socket>) {
+    // Set TCP_NODELAY in order to disable Nagle's algorithm. It handles congestion control in TCP networks. Therefore,
+    // small packets are buffered and sent out later as one large packet. This might introduce a delay of up to 40 ms
+    // which we have to avoid. Further reading: https://howdoesinternetwork.com/2015/nagles-algorithm
+    _socket->set_option(boost::asio::ip::tcp::no_delay(true));
+  }
+  establish_connection();
+  while (handle_request()) {}
+}
+
+template <typename SocketType>
+bool Session<SocketType>::handle_request() {
+  try {
+    _handle_request();
+  } catch (const ClientDisconnectException&) {
+    return false;
+  } catch (const std::exception& e) {
+    if constexpr (std::is_same_v<SocketType, Socket>) {
       std::cerr << "Exception in session with client port " << _socket->remote_endpoint().port() << ":" << std::endl
                 << e.what() << std::endl;
-      const auto error_message = ErrorMessage{{PostgresMessageType::HumanReadableError, e.what()}};
-      _postgres_protocol_handler->send_error_message(error_message);
-      _postgres_protocol_handler->send_ready_for_query();
-      // In case of an error, an error message has to be send to the client followed by a "ReadyForQuery" message.
-      // Messages that have already been received are processed further. A "sync" message makes the server send another
-      // "ReadyForQuery" message. In order to avoid this, we set this flag for further operations. As soon as a new
-      // query arrives it must be set to false again to ensure correct message flow.
-      _sync_send_after_error = true;
     }
+    // Like PostgreSQL, drop the statements of the pipeline that have not been executed yet and roll back the changes
+    // of those that have.
+    _pending_responses.clear();
+    _rollback_after_error();
+    const auto error_message = ErrorMessage{{PostgresMessageType::HumanReadableError, e.what()}};
+    _postgres_protocol_handler->send_error_message(error_message);
+    _postgres_protocol_handler->send_ready_for_query();
+    // In case of an error, an error message has to be send to the client followed by a "ReadyForQuery" message.
+    // Messages that have already been received are processed further. A "sync" message makes the server send another
+    // "ReadyForQuery" message. In order to avoid this, we set this flag for further operations. As soon as a new
+    // query arrives it must be set to false again to ensure correct message flow.
+    _sync_send_after_error = true;
   }
+  return !_terminate_session;
 }
 
-void Session::_establish_connection() {
+template <typename SocketType>
+void Session<SocketType>::establish_connection() {
   const auto body_length = _postgres_protocol_handler->read_startup_packet_header();
 
   // Currently, the information available in the start up packet body (such as db name, user name) is ignored
@@ -53,7 +102,8 @@ void Session::_establish_connection() {
   _postgres_protocol_handler->send_ready_for_query();
 }
 
-void Session::_handle_request() {
+template <typename SocketType>
+void Session<SocketType>::_handle_request() {
   const auto header = _postgres_protocol_handler->read_packet_type();
 
   switch (header) {
@@ -94,14 +144,22 @@ void Session::_handle_request() {
       _handle_execute();
       break;
     }
+    case PostgresMessageType::FlushCommand: {
+      _handle_flush_command();
+      break;
+    }
     default:
       Fail("Unknown packet type");
   }
 }
 
-void Session::_handle_simple_query() {
+template <typename SocketType>
+void Session<SocketType>::_handle_simple_query() {
   const auto& query = _postgres_protocol_handler->read_query_packet();
 
+  // The query is read first, so that the message stream stays consistent if a pending execution fails.
+  _execute_pending_statements();
+
   // A simple query command invalidates unnamed portals
   _portals.erase("");
 
@@ -131,16 +189,24 @@ void Session::_handle_simple_query() {
   _postgres_protocol_handler->send_ready_for_query();
 }
 
-void Session::_handle_parse_command() {
+template <typename SocketType>
+void Session<SocketType>::_handle_parse_command() {
   const auto [statement_name, query] = _postgres_protocol_handler->read_parse_packet();
-  QueryHandler::setup_prepared_plan(statement_name, query);
+  try {
+    QueryHandler::setup_prepared_plan(statement_name, query);
+  } catch (const std::exception&) {
+    // The results of the pending executions are sent before the error.
+    _execute_pending_statements();
+    throw;
+  }
 
-  _postgres_protocol_handler->send_status_message(PostgresMessageType::ParseComplete);
+  _send_status_message(PostgresMessageType::ParseComplete);
 
   // Ready for query + flush will be done after reading sync message
 }
 
-void Session::_handle_bind_command() {
+template <typename SocketType>
+void Session<SocketType>::_handle_bind_command() {
   const auto parameters = _postgres_protocol_handler->read_bind_packet();
 
   // Named portals must be explicitly closed before they can be redefined by another Bind message,
@@ -155,18 +221,27 @@ void Session::_handle_bind_command() {
   // Since bind and execute packet usually arrive together, we still have to handle the execute packet. Therefore,
   // we first store a nullptr in the portals map to signalize an error. However, if binding succeeds in the next step
   // this nullptr gets replaced by the correct pqp. Before executing the prepared statement we make a check for errors.
-  _portals.emplace(parameters.portal, nullptr);
-
-  const auto pqp = QueryHandler::bind_prepared_plan(parameters);
+  _portals.emplace(parameters.portal, Portal{});
+
+  auto pqp = std::shared_ptr<AbstractOperator>{};
+  try {
+    pqp = QueryHandler::bind_prepared_plan(parameters, _optimized_prepared_plans);
+  } catch (const std::exception&) {
+    // The results of the pending executions are sent before the error.
+    _execute_pending_statements();
+    throw;
+  }
 
-  _portals[parameters.portal] = pqp;
-  _postgres_protocol_handler->send_status_message(PostgresMessageType::BindComplete);
+  _portals[parameters.portal] = Portal{pqp, parameters.result_format_codes};
+  _send_status_message(PostgresMessageType::BindComplete);
 
   // Ready for query + flush will be done after reading sync message
 }
 
-void Session::_sync() {
+template <typename SocketType>
+void Session<SocketType>::_sync() {
   _postgres_protocol_handler->read_sync_packet();
+  _execute_pending_statements();
   if (_transaction_context) {
     _transaction_context->commit();
     _transaction_context.reset();
@@ -174,7 +249,8 @@ void Session::_sync() {
   _postgres_protocol_handler->send_ready_for_query();
 }
 
-void Session::_handle_execute() {
+template <typename SocketType>
+void Session<SocketType>::_handle_execute() {
   const std::string& portal_name = _postgres_protocol_handler->read_execute_packet();
 
   auto portal_it = _portals.find(portal_name);
@@ -182,34 +258,114 @@ void Session::_handle_execute() {
 
   // In case of an error occured during binding there is no pqp available. Hence, early return here since there is
   // nothing to execute.
-  if (!portal_it->second) {
+  if (!portal_it->second.physical_plan) {
     _portals.erase(portal_it);
     return;
   }
 
-  const auto physical_plan = portal_it->second;
+  const auto portal = portal_it->second;
 
   if (portal_name.empty()) _portals.erase(portal_it);
 
   if (!_transaction_context) {
     _transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
   }
-  physical_plan->set_transaction_context_recursively(_transaction_context);
+  portal.physical_plan->set_transaction_context_recursively(_transaction_context);
+
+  _pending_responses.emplace_back(portal);
 
-  const auto result_table = QueryHandler::execute_prepared_plan(physical_plan);
+  // Statements that modify data, e.g., CREATE TABLE, are executed right away, as Parse and Bind messages that follow
+  // them might depend on their changes. Otherwise, execution, results, ready for query + flush will be done after
+  // reading sync message.
+  if (modifies_data(portal.physical_plan)) _execute_pending_statements();
+}
 
-  uint64_t row_count = 0;
-  // If there is no result table, e.g. after an INSERT command, we cannot send row data
-  if (result_table) {
-    ResultSerializer::send_table_description(result_table, _postgres_protocol_handler);
-    ResultSerializer::send_query_response(result_table, _postgres_protocol_handler);
-    row_count = result_table->row_count();
+template <typename SocketType>
+void Session<SocketType>::_send_status_message(const PostgresMessageType message_type) {
+  if (_pending_responses.empty()) {
+    _postgres_protocol_handler->send_status_message(message_type);
   } else {
-    _postgres_protocol_handler->send_status_message(PostgresMessageType::NoDataResponse);
+    _pending_responses.emplace_back(message_type);
   }
+}
 
-  _postgres_protocol_handler->send_command_complete(
-      ResultSerializer::build_command_complete_message(physical_plan->type(), row_count));
-  // Ready for query + flush will be done after reading sync message
+template <typename SocketType>
+void Session<SocketType>::_rollback_after_error() {
+  if (!_transaction_context) return;
+
+  if (_transaction_context->phase() == TransactionPhase::Active) {
+    _transaction_context->rollback(RollbackReason::Conflict);
+  }
+  _transaction_context.reset();
 }
+
+template <typename SocketType>
+void Session<SocketType>::_execute_pending_statements() {
+  // If a statement fails, the following ones are dropped.
+  const auto pending_responses = std::exchange(_pending_responses, {});
+
+  const auto is_modifying_execution = [&](const size_t response_idx) {
+    const auto* portal = std::get_if<Portal>(&pending_responses[response_idx]);
+    return portal && modifies_data(portal->physical_plan);
+  };
+
+  // Statements that modify data are executed on their own, so that the following statements see their changes.
+  // Consecutive statements that only read data are executed as one batch. Status messages between them do not end
+  // the batch, but are sent in their order.
+  auto batch_begin = size_t{0};
+  while (batch_begin < pending_responses.size()) {
+    auto batch_end = batch_begin + 1;
+    if (!is_modifying_execution(batch_begin)) {
+      while (batch_end < pending_responses.size() && !is_modifying_execution(batch_end)) {
+        ++batch_end;
+      }
+    }
+
+    auto physical_plans = std::vector<std::shared_ptr<AbstractOperator>>{};
+    for (auto response_idx = batch_begin; response_idx < batch_end; ++response_idx) {
+      if (const auto* portal = std::get_if<Portal>(&pending_responses[response_idx])) {
+        physical_plans.emplace_back(portal->physical_plan);
+      }
+    }
+    auto result_tables = std::vector<std::shared_ptr<const Table>>{};
+    if (!physical_plans.empty()) result_tables = QueryHandler::execute_prepared_plans(physical_plans);
+
+    auto result_table_iter = result_tables.begin();
+    for (auto response_idx = batch_begin; response_idx < batch_end; ++response_idx) {
+      if (const auto* status_message = std::get_if<PostgresMessageType>(&pending_responses[response_idx])) {
+        _postgres_protocol_handler->send_status_message(*status_message);
+        continue;
+      }
+
+      const auto& [physical_plan, result_format_codes] = std::get<Portal>(pending_responses[response_idx]);
+      const auto& result_table = *result_table_iter++;
+
+      uint64_t row_count = 0;
+      // If there is no result table, e.g. after an INSERT command, we cannot send row data
+      if (result_table) {
+        ResultSerializer::send_table_description(result_table, _postgres_protocol_handler, result_format_codes);
+        ResultSerializer::send_query_response(result_table, _postgres_protocol_handler, result_format_codes);
+        row_count = result_table->row_count();
+      } else {
+        _postgres_protocol_handler->send_status_message(PostgresMessageType::NoDataResponse);
+      }
+
+      _postgres_protocol_handler->send_command_complete(
+          ResultSerializer::build_command_complete_message(physical_plan->type(), row_count));
+    }
+
+    batch_begin = batch_end;
+  }
+}
+
+template <typename SocketType>
+void Session<SocketType>::_handle_flush_command() {
+  _postgres_protocol_handler->read_flush_packet();
+  _execute_pending_statements();
+  _postgres_protocol_handler->force_flush();
+}
+
+template class Session<Socket>;
+template class Session<MessageStream>;
+
 }  // namespace opossum
@@ -1,8 +1,11 @@
 #pragma once
 
+#include <variant>
+
 #include "concurrency/transaction_context.hpp"
 #include "operators/abstract_operator.hpp"
 #include "postgres_protocol_handler.hpp"
+#include "query_handler.hpp"
 #include "scheduler/operator_task.hpp"
 
 namespace opossum {
@@ -12,19 +15,33 @@ namespace opossum {
 // portals used for CURSOR operations are currently not supported by Hyrise. For further documentation see here:
 // https://www.postgresql.org/docs/12/protocol-overview.html#PROTOCOL-QUERY-CONCEPTS
 // Example usage can be found here: https://stackoverflow.com/questions/52479293/postgresql-refcursor-and-portal-name
+//
+// In the thread-per-session mode of the server, a Session<Socket> runs in a thread of its own and blocks while waiting
+// for the client. In the asynchronous mode, an AsyncSession receives complete messages and lets a
+// Session<MessageStream> handle them.
+//
+// Clients may pipeline the extended query protocol, i.e., send many Bind/Execute messages before a Sync. Executions of
+// statements that do not modify data are therefore deferred until the client waits for their results (Sync or Flush)
+// and then scheduled as one batch. Statements that modify data are executed right away, so that the Parse and Bind
+// messages that follow them see their changes, e.g., a created table.
+template <typename SocketType>
 class Session {
  public:
-  explicit Session(boost::asio::io_service& io_service, const SendExecutionInfo send_execution_info);
+  Session(const std::shared_ptr<SocketType>& socket, const SendExecutionInfo send_execution_info);
 
-  // Start new session.
+  // Start new session. Returns when the client terminated the session or closed the connection.
   void run();
 
-  std::shared_ptr<Socket> socket();
-
- private:
   // Establish new connection by exchanging parameters.
-  void _establish_connection();
+  void establish_connection();
 
+  // Handle the next message of the client. Errors are sent to the client. Returns false if the client terminated the
+  // session or closed the connection.
+  bool handle_request();
+
+  std::shared_ptr<SocketType> socket();
+
+ private:
   // Determine message and call the appropriate method.
   void _handle_request();
 
@@ -40,18 +57,42 @@ class Session {
   // Read describe message. Row description will be send after execution.
   void _handle_describe();
 
-  // Execute prepared statement and send row description.
+  // Defer the execution of a prepared statement until the results are requested, unless it modifies data.
   void _handle_execute();
 
+  // Execute the deferred statements and send their results including the row descriptions, as well as the deferred
+  // status messages.
+  void _execute_pending_statements();
+
+  // Send the status message of a Parse or Bind message. If executions are pending, the message is sent after their
+  // results.
+  void _send_status_message(const PostgresMessageType message_type);
+
+  // Roll back the transaction of the pipeline after an error, like PostgreSQL does for its implicit transaction.
+  void _rollback_after_error();
+
+  // Execute the pending statements and flush the results.
+  void _handle_flush_command();
+
   // Commit current transaction.
   void _sync();
 
-  const std::shared_ptr<Socket> _socket;
-  const std::shared_ptr<PostgresProtocolHandler<Socket>> _postgres_protocol_handler;
+  const std::shared_ptr<SocketType> _socket;
+  const std::shared_ptr<PostgresProtocolHandler<SocketType>> _postgres_protocol_handler;
   const SendExecutionInfo _send_execution_info;
   bool _terminate_session = false;
   bool _sync_send_after_error = false;
   std::shared_ptr<TransactionContext> _transaction_context;
-  std::unordered_map<std::string, std::shared_ptr<AbstractOperator>> _portals;
+
+  // A bound prepared statement. The physical plan is nullptr if binding failed.
+  struct Portal {
+    std::shared_ptr<AbstractOperator> physical_plan;
+    std::vector<PostgresFormatCode> result_format_codes;
+  };
+  std::unordered_map<std::string, Portal> _portals;
+
+  // Deferred executions and the status messages that have to be sent after them, in the order of the requests
+  std::vector<std::variant<Portal, PostgresMessageType>> _pending_responses;
+  OptimizedPreparedPlans _optimized_prepared_plans;
 };
 }  // namespace opossum
@@ -1,6 +1,7 @@
 #include "write_buffer.hpp"
 
 #include "client_disconnect_exception.hpp"
+#include "message_stream.hpp"
 
 namespace opossum {
 
@@ -22,29 +23,34 @@ bool WriteBuffer<SocketType>::full() const {
 
 template <typename SocketType>
 void WriteBuffer<SocketType>::put_string(const std::string& value, const HasNullTerminator has_null_terminator) {
-  auto position_in_string = 0u;
+  put_bytes(value.data(), value.size());
+
+  // Add string terminator if necessary
+  if (has_null_terminator == HasNullTerminator::Yes) {
+    _flush_if_necessary(sizeof(char));
+    *_current_position = '\0';
+    _current_position++;
+  }
+}
+
+template <typename SocketType>
+void WriteBuffer<SocketType>::put_bytes(const char* data, const size_t byte_count) {
+  auto position_in_data = size_t{0};
 
   // Use available space first
   if (!full()) {
-    position_in_string = static_cast<uint32_t>(std::min(maximum_capacity() - size(), value.size()));
-    std::copy_n(value.cbegin(), position_in_string, _current_position);
-    std::advance(_current_position, position_in_string);
+    position_in_data = std::min(maximum_capacity() - size(), byte_count);
+    std::copy_n(data, position_in_data, _current_position);
+    std::advance(_current_position, position_in_data);
   }
 
-  // Write to network device until string is complete. Ignore last character since it is \0
-  while (position_in_string < value.size()) {
-    const auto bytes_to_transfer = std::min(maximum_capacity(), value.size() - position_in_string);
+  // Write to network device until all bytes are in the buffer
+  while (position_in_data < byte_count) {
+    const auto bytes_to_transfer = std::min(maximum_capacity(), byte_count - position_in_data);
     _flush_if_necessary(bytes_to_transfer);
-    std::copy_n(value.cbegin() + position_in_string, bytes_to_transfer, _current_position);
+    std::copy_n(data + position_in_data, bytes_to_transfer, _current_position);
     std::advance(_current_position, bytes_to_transfer);
-    position_in_string += bytes_to_transfer;
-  }
-
-  // Add string terminator if necessary
-  if (has_null_terminator == HasNullTerminator::Yes) {
-    _flush_if_necessary(sizeof(char));
-    *_current_position = '\0';
-    _current_position++;
+    position_in_data += bytes_to_transfer;
   }
 }
 
@@ -87,5 +93,6 @@ void WriteBuffer<SocketType>::_flush_if_necessary(const size_t bytes_required) {
 
 template class WriteBuffer<Socket>;
 template class WriteBuffer<boost::asio::posix::stream_descriptor>;
+template class WriteBuffer<MessageStream>;
 
 }  // namespace opossum
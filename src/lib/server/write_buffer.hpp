@@ -45,6 +45,9 @@ class WriteBuffer {
   // Put string into the buffer. If the string is longer than the buffer itself the buffer will flush automatically.
   void put_string(const std::string& value, const HasNullTerminator has_null_terminator = HasNullTerminator::Yes);
 
+  // Put raw bytes into the buffer. Like strings, they use the remaining space first.
+  void put_bytes(const char* data, const size_t byte_count);
+
   // Flush buffer by at least bytes_required. 0 means, flush whole buffer.
   void flush(const size_t bytes_required = 0);
 
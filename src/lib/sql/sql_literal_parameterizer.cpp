@@ -0,0 +1,248 @@
+#include "sql_literal_parameterizer.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <charconv>
+#include <cstdlib>
+#include <limits>
+#include <string_view>
+
+#include <boost/algorithm/string.hpp>
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+enum class TokenType { Word, QuotedIdentifier, String, Number, Symbol };
+
+struct Token {
+  TokenType type;
+  std::string_view text;
+
+  // Only set for literals that can be replaced by a placeholder, i.e., strings without escape sequences and numbers
+  // without an exponent.
+  bool is_parameterizable_literal{false};
+};
+
+bool is_word_character(const char character) {
+  return std::isalnum(static_cast<unsigned char>(character)) || character == '_' || character == '$' ||
+         static_cast<unsigned char>(character) >= 0x80;
+}
+
+// Splits the SQL string into tokens. Returns std::nullopt if the string contains placeholders, comments, or
+// unterminated quotes.
+std::optional<std::vector<Token>> tokenize(const std::string_view sql) {
+  auto tokens = std::vector<Token>{};
+  auto position = size_t{0};
+
+  while (position < sql.size()) {
+    const auto character = sql[position];
+    const auto next_character = position + 1 < sql.size() ? sql[position + 1] : '\0';
+    const auto begin = position;
+
+    if (std::isspace(static_cast<unsigned char>(character))) {
+      ++position;
+      continue;
+    }
+
+    if (character == '?' || (character == '-' && next_character == '-') ||
+        (character == '/' && next_character == '*')) {
+      return std::nullopt;
+    }
+
+    if (character == '\'') {
+      auto has_escape_sequence = false;
+      ++position;
+      while (true) {
+        if (position >= sql.size()) return std::nullopt;
+        if (sql[position] == '\\') has_escape_sequence = true;
+        if (sql[position] == '\'') {
+          if (position + 1 < sql.size() && sql[position + 1] == '\'') {
+            has_escape_sequence = true;
+            position += 2;
+            continue;
+          }
+          break;
+        }
+        ++position;
+      }
+      ++position;
+      tokens.emplace_back(Token{TokenType::String, sql.substr(begin, position - begin), !has_escape_sequence});
+      continue;
+    }
+
+    if (character == '"' || character == '`') {
+      const auto closing_position = sql.find(character, position + 1);
+      if (closing_position == std::string_view::npos) return std::nullopt;
+      position = closing_position + 1;
+      tokens.emplace_back(Token{TokenType::QuotedIdentifier, sql.substr(begin, position - begin)});
+      continue;
+    }
+
+    if (std::isdigit(static_cast<unsigned char>(character)) ||
+        (character == '.' && std::isdigit(static_cast<unsigned char>(next_character)))) {
+      const auto is_number_character = [&](const char number_character) {
+        return std::isdigit(static_cast<unsigned char>(number_character)) || number_character == '.';
+      };
+      while (position < sql.size() && is_number_character(sql[position])) ++position;
+
+      auto has_exponent = false;
+      if (position < sql.size() && (sql[position] == 'e' || sql[position] == 'E')) {
+        has_exponent = true;
+        ++position;
+        if (position < sql.size() && (sql[position] == '+' || sql[position] == '-')) ++position;
+        while (position < sql.size() && std::isdigit(static_cast<unsigned char>(sql[position]))) ++position;
+      }
+      tokens.emplace_back(Token{TokenType::Number, sql.substr(begin, position - begin), !has_exponent});
+      continue;
+    }
+
+    if (is_word_character(character)) {
+      while (position < sql.size() && is_word_character(sql[position])) ++position;
+      tokens.emplace_back(Token{TokenType::Word, sql.substr(begin, position - begin)});
+      continue;
+    }
+
+    const auto two_characters = sql.substr(position, 2);
+    if (two_characters == "<>" || two_characters == "!=" || two_characters == "<=" || two_characters == ">=" ||
+        two_characters == "==" || two_characters == "||" || two_characters == "::") {
+      position += 2;
+    } else {
+      ++position;
+    }
+    tokens.emplace_back(Token{TokenType::Symbol, sql.substr(begin, position - begin)});
+  }
+
+  return tokens;
+}
+
+bool is_symbol(const Token* token, const std::string_view symbol) {
+  return token && token->type == TokenType::Symbol && token->text == symbol;
+}
+
+bool is_comparison_operator(const Token* token) {
+  return is_symbol(token, "=") || is_symbol(token, "==") || is_symbol(token, "<>") || is_symbol(token, "!=") ||
+         is_symbol(token, "<") || is_symbol(token, "<=") || is_symbol(token, ">") || is_symbol(token, ">=");
+}
+
+// Whether the token can end the left operand of a comparison
+bool ends_operand(const Token* token) {
+  return token && (token->type == TokenType::Word || token->type == TokenType::QuotedIdentifier ||
+                   is_symbol(token, ")"));
+}
+
+// Whether the token (or the end of the statement, if it is nullptr) ends the comparison that precedes it. For all
+// other tokens, the literal before might be an operand of an operator that binds stronger than the comparison, e.g.,
+// `a = 5 + b`, or the comparison might be part of a larger construct, e.g., `CASE WHEN a = 5 THEN ...`.
+bool ends_comparison(const Token* token) {
+  if (!token) return true;
+  if (is_symbol(token, ")") || is_symbol(token, ",") || is_symbol(token, ";")) return true;
+  if (token->type != TokenType::Word) return false;
+
+  static const auto keywords =
+      std::vector<std::string_view>{"AND",    "OR",    "WHERE", "GROUP", "ORDER", "HAVING", "LIMIT",   "UNION",
+                                    "EXCEPT", "INNER", "LEFT",  "RIGHT", "FULL",  "CROSS",  "NATURAL", "JOIN",
+                                    "INTERSECT"};
+  return std::any_of(keywords.begin(), keywords.end(),
+                     [&](const auto& keyword) { return boost::iequals(token->text, keyword); });
+}
+
+// Converts the literal to the value the SQLTranslator would create for it. Returns std::nullopt for integers that
+// exceed the range of int64_t.
+std::optional<AllTypeVariant> literal_value(const Token& literal, const bool is_negative) {
+  if (literal.type == TokenType::String) {
+    return AllTypeVariant{pmr_string{literal.text.substr(1, literal.text.size() - 2)}};
+  }
+
+  auto text = std::string{is_negative ? "-" : ""};
+  text += literal.text;
+
+  if (text.find('.') != std::string::npos) {
+    return AllTypeVariant{std::strtod(text.c_str(), nullptr)};
+  }
+
+  auto value = int64_t{};
+  const auto [end, error] = std::from_chars(text.data(), text.data() + text.size(), value);
+  if (error != std::errc{} || end != text.data() + text.size()) return std::nullopt;
+
+  if (value >= std::numeric_limits<int32_t>::min() && value <= std::numeric_limits<int32_t>::max()) {
+    return AllTypeVariant{static_cast<int32_t>(value)};
+  }
+  return AllTypeVariant{value};
+}
+
+}  // namespace
+
+namespace opossum {
+
+std::optional<ParameterizedSQL> parameterize_sql_literals(const std::string& sql) {
+  const auto tokens = tokenize(sql);
+  if (!tokens || tokens->empty() || (*tokens)[0].type != TokenType::Word) return std::nullopt;
+
+  const auto& statement_keyword = (*tokens)[0].text;
+  if (!boost::iequals(statement_keyword, "SELECT") && !boost::iequals(statement_keyword, "INSERT") &&
+      !boost::iequals(statement_keyword, "UPDATE") && !boost::iequals(statement_keyword, "DELETE")) {
+    return std::nullopt;
+  }
+
+  const auto token_count = tokens->size();
+  const auto token_at = [&](const size_t token_idx) {
+    return token_idx < token_count ? &(*tokens)[token_idx] : nullptr;
+  };
+
+  auto parameterized_sql = ParameterizedSQL{};
+  auto copied_until = size_t{0};
+
+  auto parenthesis_depth = size_t{0};
+  // Parenthesis depth of the VALUES keyword while its list has not been closed yet
+  auto values_list_depth = std::optional<size_t>{};
+
+  for (auto token_idx = size_t{0}; token_idx < token_count; ++token_idx) {
+    const auto& token = (*tokens)[token_idx];
+
+    if (is_symbol(&token, "(")) {
+      ++parenthesis_depth;
+    } else if (is_symbol(&token, ")")) {
+      if (parenthesis_depth == 0) return std::nullopt;
+      --parenthesis_depth;
+      if (values_list_depth && parenthesis_depth == *values_list_depth) values_list_depth.reset();
+    } else if (token.type == TokenType::Word && boost::iequals(token.text, "VALUES")) {
+      values_list_depth = parenthesis_depth;
+    }
+
+    if (!token.is_parameterizable_literal) continue;
+
+    // Include the sign of negative numbers
+    const auto is_negative =
+        token.type == TokenType::Number && token_idx > 0 && is_symbol(token_at(token_idx - 1), "-");
+    const auto first_token_idx = is_negative ? token_idx - 1 : token_idx;
+
+    const auto* previous_token = first_token_idx > 0 ? token_at(first_token_idx - 1) : nullptr;
+    const auto* next_token = token_at(token_idx + 1);
+
+    const auto is_comparison_operand = first_token_idx > 1 && is_comparison_operator(previous_token) &&
+                                       ends_operand(token_at(first_token_idx - 2)) && ends_comparison(next_token);
+    const auto is_values_item = values_list_depth && parenthesis_depth == *values_list_depth + 1 &&
+                                (is_symbol(previous_token, "(") || is_symbol(previous_token, ",")) &&
+                                (is_symbol(next_token, ",") || is_symbol(next_token, ")"));
+    if (!is_comparison_operand && !is_values_item) continue;
+
+    const auto value = literal_value(token, is_negative);
+    if (!value) continue;
+
+    const auto replaced_begin = static_cast<size_t>((*tokens)[first_token_idx].text.data() - sql.data());
+    const auto replaced_end = static_cast<size_t>(token.text.data() + token.text.size() - sql.data());
+
+    parameterized_sql.sql.append(sql, copied_until, replaced_begin - copied_until);
+    parameterized_sql.sql += '?';
+    copied_until = replaced_end;
+    parameterized_sql.values.emplace_back(*value);
+  }
+
+  if (parameterized_sql.values.empty()) return std::nullopt;
+
+  parameterized_sql.sql.append(sql, copied_until, std::string::npos);
+  return parameterized_sql;
+}
+
+}  // namespace opossum
@@ -0,0 +1,35 @@
+#pragma once
+
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "all_type_variant.hpp"
+
+namespace opossum {
+
+struct ParameterizedSQL {
+  // The SQL string with the replaced literals turned into value placeholders (`?`)
+  std::string sql;
+
+  // The replaced literals in the order of their placeholders
+  std::vector<AllTypeVariant> values;
+};
+
+/**
+ * Replaces the literals of a single SELECT, INSERT, UPDATE, or DELETE statement with value placeholders, so that
+ * statements that only differ in their literals map to the same string. SQLPipelineStatement uses this string as the
+ * key of the LQP cache and binds the extracted values to the cached plan (see SQLPipelineStatement).
+ *
+ * The SQL string is only tokenized, not parsed. Thus, only literals whose replacement can never change the meaning of
+ * the statement are parameterized:
+ *  - literals that form the complete right operand of a comparison, e.g., `WHERE a = 5 AND b < 'x'` or
+ *    `SET a = -3.5, b = 'y'`
+ *  - literals that form a complete item of an INSERT's VALUES list
+ * Other literals (e.g., in IN lists, LIMIT clauses, function arguments, or arithmetic expressions) as well as NULL are
+ * kept. Returns std::nullopt if no literal was replaced, if the statement already contains placeholders or comments,
+ * or if it is not a SELECT, INSERT, UPDATE, or DELETE statement.
+ */
+std::optional<ParameterizedSQL> parameterize_sql_literals(const std::string& sql);
+
+}  // namespace opossum
@@ -16,9 +16,10 @@
 namespace opossum {
 
 SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<TransactionContext>& transaction_context,
-                         const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
-                         const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-                         const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache)
+                         const UseMvcc use_mvcc, const UsePipelinedExecution use_pipelined_execution,
+                         const std::optional<size_t>& memory_budget, const std::shared_ptr<Optimizer>& optimizer,
+                         const std::shared_ptr<AbstractSQLPhysicalPlanCache>& init_pqp_cache,
+                         const std::shared_ptr<AbstractSQLLogicalPlanCache>& init_lqp_cache)
     : pqp_cache(init_pqp_cache),
       lqp_cache(init_lqp_cache),
       _sql(sql),
@@ -82,8 +83,9 @@ SQLPipeline::SQLPipeline(const std::string& sql, const std::shared_ptr<Transacti
     const auto statement_string = boost::trim_copy(sql.substr(sql_string_offset, statement_string_length));
     sql_string_offset += statement_string_length;
 
-    auto pipeline_statement = std::make_shared<SQLPipelineStatement>(statement_string, std::move(parsed_statement),
-                                                                     use_mvcc, optimizer, pqp_cache, lqp_cache);
+    auto pipeline_statement =
+        std::make_shared<SQLPipelineStatement>(statement_string, std::move(parsed_statement), use_mvcc,
+                                               use_pipelined_execution, memory_budget, optimizer, pqp_cache, lqp_cache);
     _sql_pipeline_statements.emplace_back(std::move(pipeline_statement));
   }
 
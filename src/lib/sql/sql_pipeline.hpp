@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 
 #include "SQLParserResult.h"
 #include "concurrency/transaction_context.hpp"
@@ -33,9 +34,10 @@ class SQLPipeline : public Noncopyable {
  public:
   // Prefer using the SQLPipelineBuilder interface for constructing SQLPipelines conveniently
   SQLPipeline(const std::string& sql, const std::shared_ptr<TransactionContext>& transaction_context,
-              const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
-              const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-              const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache);
+              const UseMvcc use_mvcc, const UsePipelinedExecution use_pipelined_execution,
+              const std::optional<size_t>& memory_budget, const std::shared_ptr<Optimizer>& optimizer,
+              const std::shared_ptr<AbstractSQLPhysicalPlanCache>& init_pqp_cache,
+              const std::shared_ptr<AbstractSQLLogicalPlanCache>& init_lqp_cache);
 
   // Returns the original SQL string
   const std::string& get_sql() const;
@@ -93,8 +95,8 @@ class SQLPipeline : public Noncopyable {
 
   SQLPipelineMetrics& metrics();
 
-  const std::shared_ptr<SQLPhysicalPlanCache> pqp_cache;
-  const std::shared_ptr<SQLLogicalPlanCache> lqp_cache;
+  const std::shared_ptr<AbstractSQLPhysicalPlanCache> pqp_cache;
+  const std::shared_ptr<AbstractSQLLogicalPlanCache> lqp_cache;
 
  private:
   friend class SQLPipelineStatementTest;
@@ -25,22 +25,34 @@ SQLPipelineBuilder& SQLPipelineBuilder::with_transaction_context(
   return *this;
 }
 
-SQLPipelineBuilder& SQLPipelineBuilder::with_pqp_cache(const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache) {
+SQLPipelineBuilder& SQLPipelineBuilder::with_pqp_cache(const std::shared_ptr<AbstractSQLPhysicalPlanCache>& pqp_cache) {
   _pqp_cache = pqp_cache;
   return *this;
 }
 
-SQLPipelineBuilder& SQLPipelineBuilder::with_lqp_cache(const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache) {
+SQLPipelineBuilder& SQLPipelineBuilder::with_lqp_cache(const std::shared_ptr<AbstractSQLLogicalPlanCache>& lqp_cache) {
   _lqp_cache = lqp_cache;
   return *this;
 }
 
+SQLPipelineBuilder& SQLPipelineBuilder::with_pipelined_execution(
+    const UsePipelinedExecution use_pipelined_execution) {
+  _use_pipelined_execution = use_pipelined_execution;
+  return *this;
+}
+
+SQLPipelineBuilder& SQLPipelineBuilder::with_memory_budget(const size_t memory_budget) {
+  _memory_budget = memory_budget;
+  return *this;
+}
+
 SQLPipelineBuilder& SQLPipelineBuilder::disable_mvcc() { return with_mvcc(UseMvcc::No); }
 
 SQLPipeline SQLPipelineBuilder::create_pipeline() const {
   DTRACE_PROBE1(HYRISE, CREATE_PIPELINE, reinterpret_cast<uintptr_t>(this));
   auto optimizer = _optimizer ? _optimizer : Optimizer::create_default_optimizer();
-  auto pipeline = SQLPipeline(_sql, _transaction_context, _use_mvcc, optimizer, _pqp_cache, _lqp_cache);
+  auto pipeline = SQLPipeline(_sql, _transaction_context, _use_mvcc, _use_pipelined_execution, _memory_budget,
+                              optimizer, _pqp_cache, _lqp_cache);
   DTRACE_PROBE3(HYRISE, PIPELINE_CREATION_DONE, pipeline.get_sql_per_statement().size(), _sql.c_str(),
                 reinterpret_cast<uintptr_t>(this));
   return pipeline;
@@ -1,6 +1,7 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "types.hpp"
@@ -28,6 +29,8 @@ class Optimizer;
  * Defaults:
  *  - MVCC is enabled
  *  - The default Optimizer (Optimizer::create_default_optimizer()) is used.
+ *  - Pipelined execution is disabled
+ *  - No memory budget is set
  *
  * Favour this interface over calling the SQLPipeline[Statement] constructors with their long parameter list.
  * See SQLPipeline[Statement] doc for these classes, in short SQLPipeline ist for queries with multiple statement,
@@ -40,8 +43,22 @@ class SQLPipelineBuilder final {
   SQLPipelineBuilder& with_mvcc(const UseMvcc use_mvcc);
   SQLPipelineBuilder& with_optimizer(const std::shared_ptr<Optimizer>& optimizer);
   SQLPipelineBuilder& with_transaction_context(const std::shared_ptr<TransactionContext>& transaction_context);
-  SQLPipelineBuilder& with_pqp_cache(const std::shared_ptr<SQLPhysicalPlanCache>& pqp_cache);
-  SQLPipelineBuilder& with_lqp_cache(const std::shared_ptr<SQLLogicalPlanCache>& lqp_cache);
+  SQLPipelineBuilder& with_pqp_cache(const std::shared_ptr<AbstractSQLPhysicalPlanCache>& pqp_cache);
+  SQLPipelineBuilder& with_lqp_cache(const std::shared_ptr<AbstractSQLLogicalPlanCache>& lqp_cache);
+
+  /**
+   * Let the LQPTranslator fuse chains of Validates and TableScans into PipelinedScans, which process the input chunk
+   * by chunk instead of materializing the output of every operator. The physical plans of such pipelines are not
+   * cached.
+   */
+  SQLPipelineBuilder& with_pipelined_execution(const UsePipelinedExecution use_pipelined_execution);
+
+  /**
+   * Limit the memory that the hash joins and hash aggregates of each statement use for their intermediate data
+   * structures. If the budget does not suffice, they spill partitions of their input to temporary files.
+   * See MemoryBudgetResource.
+   */
+  SQLPipelineBuilder& with_memory_budget(const size_t memory_budget);
 
   /**
    * Short for with_mvcc(UseMvcc::No)
@@ -54,10 +71,12 @@ class SQLPipelineBuilder final {
   const std::string _sql;
 
   UseMvcc _use_mvcc{UseMvcc::Yes};
+  UsePipelinedExecution _use_pipelined_execution{UsePipelinedExecution::No};
+  std::optional<size_t> _memory_budget;
   std::shared_ptr<TransactionContext> _transaction_context;
   std::shared_ptr<Optimizer> _optimizer;
-  std::shared_ptr<SQLPhysicalPlanCache> _pqp_cache;
-  std::shared_ptr<SQLLogicalPlanCache> _lqp_cache;
+  std::shared_ptr<AbstractSQLPhysicalPlanCache> _pqp_cache;
+  std::shared_ptr<AbstractSQLLogicalPlanCache> _lqp_cache;
 };
 
 }  // namespace opossum
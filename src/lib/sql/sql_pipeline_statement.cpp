@@ -8,6 +8,8 @@
 
 #include "SQLParser.h"
 #include "create_sql_parser_error_message.hpp"
+#include "expression/expression_utils.hpp"
+#include "expression/placeholder_expression.hpp"
 #include "expression/value_expression.hpp"
 #include "hyrise.hpp"
 #include "logical_query_plan/lqp_utils.hpp"
@@ -19,23 +21,52 @@
 #include "operators/maintenance/drop_table.hpp"
 #include "operators/maintenance/drop_view.hpp"
 #include "optimizer/optimizer.hpp"
+#include "optimizer/strategy/chunk_pruning_rule.hpp"
 #include "scheduler/job_task.hpp"
 #include "sql/sql_pipeline_builder.hpp"
 #include "sql/sql_plan_cache.hpp"
 #include "sql/sql_translator.hpp"
+#include "storage/prepared_plan.hpp"
 #include "utils/assert.hpp"
 #include "utils/tracing/probes.hpp"
 
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Statements with more literals are not parameterized, so that the ParameterIDs of parameterized_plan_parameter_ids
+// do not collide with the ones allocated by the SQLTranslator.
+constexpr auto MAX_PARAMETERIZED_VALUE_COUNT = size_t{1'000};
+
+// The placeholders of parameterized plans use ParameterIDs counted down from the highest ParameterID. Thus, they do not
+// collide with the ParameterIDs that the SQLTranslator allocates for correlated subqueries, and they can be derived
+// from the number of values when a cached plan is instantiated.
+std::vector<ParameterID> parameterized_plan_parameter_ids(const size_t value_count) {
+  auto parameter_ids = std::vector<ParameterID>(value_count);
+  for (auto value_idx = size_t{0}; value_idx < value_count; ++value_idx) {
+    parameter_ids[value_idx] = ParameterID{
+        static_cast<ParameterID::base_type>(std::numeric_limits<ParameterID::base_type>::max() - value_idx)};
+  }
+  return parameter_ids;
+}
+
+}  // namespace
+
 namespace opossum {
 
 SQLPipelineStatement::SQLPipelineStatement(const std::string& sql, std::shared_ptr<hsql::SQLParserResult> parsed_sql,
-                                           const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
-                                           const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-                                           const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache)
+                                           const UseMvcc use_mvcc,
+                                           const UsePipelinedExecution use_pipelined_execution,
+                                           const std::optional<size_t>& memory_budget,
+                                           const std::shared_ptr<Optimizer>& optimizer,
+                                           const std::shared_ptr<AbstractSQLPhysicalPlanCache>& init_pqp_cache,
+                                           const std::shared_ptr<AbstractSQLLogicalPlanCache>& init_lqp_cache)
     : pqp_cache(init_pqp_cache),
       lqp_cache(init_lqp_cache),
       _sql_string(sql),
       _use_mvcc(use_mvcc),
+      _use_pipelined_execution(use_pipelined_execution),
+      _memory_budget(memory_budget),
       _optimizer(optimizer),
       _parsed_sql_statement(std::move(parsed_sql)),
       _metrics(std::make_shared<SQLPipelineStatementMetrics>()) {
@@ -125,6 +156,9 @@ const std::shared_ptr<AbstractLQPNode>& SQLPipelineStatement::get_optimized_logi
         return _optimized_logical_plan;
       }
     }
+
+    _optimized_logical_plan = _get_optimized_logical_plan_from_parameterized_plan();
+    if (_optimized_logical_plan) return _optimized_logical_plan;
   }
 
   auto unoptimized_lqp = get_unoptimized_logical_plan();
@@ -147,11 +181,86 @@ const std::shared_ptr<AbstractLQPNode>& SQLPipelineStatement::get_optimized_logi
   // Cache newly created plan for the according sql statement
   if (lqp_cache && _translation_info.cacheable) {
     lqp_cache->set(_sql_string, _optimized_logical_plan);
+
+    // Statements that only differ in their literals directly take the regular path from now on.
+    if (_unparameterizable_sql) {
+      Hyrise::get().unparameterizable_sql->insert(*_unparameterizable_sql);
+    }
   }
 
   return _optimized_logical_plan;
 }
 
+std::shared_ptr<AbstractLQPNode> SQLPipelineStatement::_get_optimized_logical_plan_from_parameterized_plan() {
+  const auto parameterized_sql = parameterize_sql_literals(_sql_string);
+  if (!parameterized_sql || parameterized_sql->values.size() > MAX_PARAMETERIZED_VALUE_COUNT) return nullptr;
+
+  if (Hyrise::get().unparameterizable_sql->contains(parameterized_sql->sql)) return nullptr;
+
+  const auto started = std::chrono::high_resolution_clock::now();
+
+  auto parameterized_lqp = std::shared_ptr<AbstractLQPNode>{};
+  if (const auto cached_plan = lqp_cache->try_get(parameterized_sql->sql)) {
+    // MVCC-enabled and MVCC-disabled LQPs will evict each other
+    if (lqp_is_validated(*cached_plan) == (_use_mvcc == UseMvcc::Yes)) parameterized_lqp = *cached_plan;
+  }
+
+  auto values = std::vector<std::shared_ptr<AbstractExpression>>{};
+  values.reserve(parameterized_sql->values.size());
+  for (const auto& value : parameterized_sql->values) {
+    values.emplace_back(std::make_shared<ValueExpression>(value));
+  }
+
+  auto lqp = std::shared_ptr<AbstractLQPNode>{};
+  try {
+    if (parameterized_lqp) {
+      _metrics->parameterized_plan_cache_hit = true;
+    } else {
+      parameterized_lqp = _create_parameterized_plan(*parameterized_sql);
+    }
+
+    // Instantiating the plan copies it, so that the cached plan is not modified.
+    const auto prepared_plan = PreparedPlan{parameterized_lqp, parameterized_plan_parameter_ids(values.size())};
+    lqp = prepared_plan.instantiate(values);
+  } catch (const std::exception&) {
+    // Rules and expressions that cannot handle placeholders fail. Invalid statements fail again on the regular path.
+    _metrics->parameterized_plan_cache_hit = false;
+    _unparameterizable_sql = parameterized_sql->sql;
+    return nullptr;
+  }
+
+  if (!_metrics->parameterized_plan_cache_hit) lqp_cache->set(parameterized_sql->sql, parameterized_lqp);
+
+  if (lqp_has_placeholder_predicates(parameterized_lqp)) lqp = ChunkPruningRule::prune_instantiated_plan(lqp);
+
+  const auto done = std::chrono::high_resolution_clock::now();
+  _metrics->optimization_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
+
+  return lqp;
+}
+
+std::shared_ptr<AbstractLQPNode> SQLPipelineStatement::_create_parameterized_plan(
+    const ParameterizedSQL& parameterized_sql) const {
+  auto parsed_sql = hsql::SQLParserResult{};
+  hsql::SQLParser::parse(parameterized_sql.sql, &parsed_sql);
+  Assert(parsed_sql.isValid() && parsed_sql.size() == 1, "Parameterized statement could not be parsed");
+
+  auto translation_result = SQLTranslator{_use_mvcc}.translate_parser_result(parsed_sql);
+  const auto& translation_info = translation_result.translation_info;
+  Assert(translation_info.cacheable, "Parameterized statement is not cacheable");
+
+  // Replace the placeholders with ones whose ParameterIDs do not depend on the order in which the SQLTranslator
+  // encountered them.
+  auto placeholders = std::vector<std::shared_ptr<AbstractExpression>>{};
+  for (const auto parameter_id : parameterized_plan_parameter_ids(parameterized_sql.values.size())) {
+    placeholders.emplace_back(std::make_shared<PlaceholderExpression>(parameter_id));
+  }
+  const auto prepared_plan =
+      PreparedPlan{translation_result.lqp_nodes.at(0), translation_info.parameter_ids_of_value_placeholders};
+
+  return _optimizer->optimize(prepared_plan.instantiate(placeholders));
+}
+
 const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan() {
   if (_physical_plan) {
     return _physical_plan;
@@ -166,8 +275,13 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
   auto started = std::chrono::high_resolution_clock::now();
   auto done = started;  // dummy value needed for initialization
 
+  // The PQP cache is keyed by the SQL string only. Plans for pipelined execution are therefore neither cached nor taken
+  // from the cache, so that statements do not execute a plan for the other execution mode. The LQPs do not depend on
+  // the execution mode.
+  const auto use_pqp_cache = pqp_cache && _use_pipelined_execution == UsePipelinedExecution::No;
+
   // Try to retrieve the PQP from cache
-  if (pqp_cache) {
+  if (use_pqp_cache) {
     if (const auto cached_physical_plan = pqp_cache->try_get(_sql_string)) {
       if ((*cached_physical_plan)->transaction_context_is_set()) {
         Assert(_use_mvcc == UseMvcc::Yes, "Trying to use MVCC cached query without a transaction context.");
@@ -186,7 +300,7 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
 
     // Reset time to exclude previous pipeline steps
     started = std::chrono::high_resolution_clock::now();
-    _physical_plan = LQPTranslator{}.translate_node(lqp);
+    _physical_plan = LQPTranslator{_use_pipelined_execution}.translate_node(lqp);
   }
 
   done = std::chrono::high_resolution_clock::now();
@@ -194,8 +308,11 @@ const std::shared_ptr<AbstractOperator>& SQLPipelineStatement::get_physical_plan
   if (_use_mvcc == UseMvcc::Yes) _physical_plan->set_transaction_context_recursively(_transaction_context);
 
   // Cache newly created plan for the according sql statement (only if not already cached)
-  if (pqp_cache && !_metrics->query_plan_cache_hit && _translation_info.cacheable) {
+  if (use_pqp_cache && !_metrics->query_plan_cache_hit && _translation_info.cacheable) {
     pqp_cache->set(_sql_string, _physical_plan);
+
+    // The memory budget of this statement must not be attached to the cached plan, as later statements copy it.
+    if (_memory_budget) _physical_plan = _physical_plan->deep_copy();
   }
 
   _metrics->lqp_translation_duration = std::chrono::duration_cast<std::chrono::nanoseconds>(done - started);
@@ -212,6 +329,14 @@ const std::vector<std::shared_ptr<AbstractTask>>& SQLPipelineStatement::get_task
     _tasks = _get_transaction_tasks();
   } else {
     _precheck_ddl_operators(get_physical_plan());
+
+    // The physical plan is never the cached one if a budget is set (see get_physical_plan), so that statements do not
+    // share their budgets.
+    if (_memory_budget) {
+      _memory_budget_resource = std::make_shared<MemoryBudgetResource>(*_memory_budget);
+      get_physical_plan()->set_memory_budget_resource_recursively(_memory_budget_resource);
+    }
+
     auto operator_tasks = OperatorTask::make_tasks_from_operator(get_physical_plan());
     _tasks = std::vector<std::shared_ptr<AbstractTask>>(operator_tasks.cbegin(), operator_tasks.cend());
   }
@@ -315,6 +440,10 @@ const std::shared_ptr<TransactionContext>& SQLPipelineStatement::transaction_con
 
 const std::shared_ptr<SQLPipelineStatementMetrics>& SQLPipelineStatement::metrics() const { return _metrics; }
 
+const std::shared_ptr<MemoryBudgetResource>& SQLPipelineStatement::memory_budget_resource() const {
+  return _memory_budget_resource;
+}
+
 void SQLPipelineStatement::_precheck_ddl_operators(const std::shared_ptr<AbstractOperator>& pqp) {
   const auto& storage_manager = Hyrise::get().storage_manager;
 
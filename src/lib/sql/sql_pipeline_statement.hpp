@@ -1,16 +1,19 @@
 #pragma once
 
 #include <memory>
+#include <optional>
 #include <string>
 
 #include "SQLParserResult.h"
 #include "cache/gdfs_cache.hpp"
 #include "concurrency/transaction_context.hpp"
 #include "logical_query_plan/lqp_translator.hpp"
+#include "memory/memory_budget_resource.hpp"
 #include "optimizer/optimizer.hpp"
 #include "scheduler/abstract_task.hpp"
 #include "scheduler/job_task.hpp"
 #include "scheduler/operator_task.hpp"
+#include "sql/sql_literal_parameterizer.hpp"
 #include "sql/sql_translator.hpp"
 #include "sql_plan_cache.hpp"
 #include "storage/table.hpp"
@@ -26,6 +29,7 @@ struct SQLPipelineStatementMetrics {
   std::chrono::nanoseconds plan_execution_duration{};
 
   bool query_plan_cache_hit = false;
+  bool parameterized_plan_cache_hit = false;
 };
 
 enum class SQLPipelineStatus {
@@ -50,14 +54,24 @@ enum class SQLPipelineStatus {
  *  If a physical plan for an SQL statement is in the SQLPhysicalPlanCache, it will be used instead of translating the
  *  optimized LQP (get_optimized_logical_plans()) into a PQP. Thus, in this case, the optimized LQP and PQP could be
  *  different.
+ *
+ * NOTE:
+ *  Statements that only differ in their literals share an entry of the SQLLogicalPlanCache: If
+ *  parameterize_sql_literals finds literals that can be replaced by placeholders, the optimized LQP of the
+ *  parameterized statement is cached under the parameterized SQL string. The literals of each statement are then bound
+ *  to a copy of this plan using PreparedPlan::instantiate. Only the ChunkPruningRule depends on the bound values and is
+ *  applied again if placeholders were used in predicates. If the parameterized statement cannot be optimized, this is
+ *  remembered in the cache and the statement is optimized as usual. As PQPs contain the values, the
+ *  SQLPhysicalPlanCache is still keyed by the original SQL string.
  */
 class SQLPipelineStatement : public Noncopyable {
  public:
   // Prefer using the SQLPipelineBuilder for constructing SQLPipelineStatements conveniently
   SQLPipelineStatement(const std::string& sql, std::shared_ptr<hsql::SQLParserResult> parsed_sql,
-                       const UseMvcc use_mvcc, const std::shared_ptr<Optimizer>& optimizer,
-                       const std::shared_ptr<SQLPhysicalPlanCache>& init_pqp_cache,
-                       const std::shared_ptr<SQLLogicalPlanCache>& init_lqp_cache);
+                       const UseMvcc use_mvcc, const UsePipelinedExecution use_pipelined_execution,
+                       const std::optional<size_t>& memory_budget, const std::shared_ptr<Optimizer>& optimizer,
+                       const std::shared_ptr<AbstractSQLPhysicalPlanCache>& init_pqp_cache,
+                       const std::shared_ptr<AbstractSQLLogicalPlanCache>& init_lqp_cache);
 
   // Set the transaction context if this SQLPipelineStatement should not auto-commit.
   void set_transaction_context(const std::shared_ptr<TransactionContext>& transaction_context);
@@ -100,8 +114,12 @@ class SQLPipelineStatement : public Noncopyable {
 
   const std::shared_ptr<SQLPipelineStatementMetrics>& metrics() const;
 
-  const std::shared_ptr<SQLPhysicalPlanCache> pqp_cache;
-  const std::shared_ptr<SQLLogicalPlanCache> lqp_cache;
+  // Tracks the memory used by the operators of this statement. Only set if a memory budget was given and once
+  // get_tasks() has been called.
+  const std::shared_ptr<MemoryBudgetResource>& memory_budget_resource() const;
+
+  const std::shared_ptr<AbstractSQLPhysicalPlanCache> pqp_cache;
+  const std::shared_ptr<AbstractSQLLogicalPlanCache> lqp_cache;
 
  private:
   bool _is_transaction_statement();
@@ -114,8 +132,19 @@ class SQLPipelineStatement : public Noncopyable {
   // Throws an InvalidInputException if an invalid PQP is detected.
   static void _precheck_ddl_operators(const std::shared_ptr<AbstractOperator>& pqp);
 
+  // Returns the optimized LQP with the statement's literals bound to the cached plan of its parameterized version,
+  // which is created if necessary. Returns nullptr if the statement has no parameterizable literals or if its
+  // parameterized version cannot be optimized.
+  std::shared_ptr<AbstractLQPNode> _get_optimized_logical_plan_from_parameterized_plan();
+
+  // Translates and optimizes the parameterized statement. Its placeholders use the ParameterIDs returned by
+  // parameterized_plan_parameter_ids (see sql_pipeline_statement.cpp).
+  std::shared_ptr<AbstractLQPNode> _create_parameterized_plan(const ParameterizedSQL& parameterized_sql) const;
+
   const std::string _sql_string;
   const UseMvcc _use_mvcc;
+  const UsePipelinedExecution _use_pipelined_execution;
+  const std::optional<size_t> _memory_budget;
 
   const std::shared_ptr<Optimizer> _optimizer;
 
@@ -126,10 +155,15 @@ class SQLPipelineStatement : public Noncopyable {
   std::shared_ptr<AbstractOperator> _physical_plan;
   std::vector<std::shared_ptr<AbstractTask>> _tasks;
   std::shared_ptr<const Table> _result_table;
+  std::shared_ptr<MemoryBudgetResource> _memory_budget_resource;
   // Assume there is an output table. Only change if nullptr is returned from execution.
   bool _query_has_output{true};
   SQLTranslationInfo _translation_info;
 
+  // Set if the parameterized version of the statement could not be optimized. Once the statement has been optimized as
+  // usual, this is stored in Hyrise::unparameterizable_sql.
+  std::optional<std::string> _unparameterizable_sql;
+
   std::shared_ptr<SQLPipelineStatementMetrics> _metrics;
 
   // Either a multi-statement transaction context that was passed in using set_transaction_context or an auto-commit
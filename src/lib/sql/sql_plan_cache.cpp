@@ -0,0 +1,37 @@
+#include "sql_plan_cache.hpp"
+
+#include <mutex>
+
+#include "hyrise.hpp"
+
+namespace opossum {
+
+UnparameterizableSQLSet::UnparameterizableSQLSet(const size_t capacity) : _capacity(capacity) {}
+
+void UnparameterizableSQLSet::insert(const std::string& parameterized_sql) {
+  auto lock = std::unique_lock{_mutex};
+  if (_parameterized_sqls.size() >= _capacity) _parameterized_sqls.clear();
+  _parameterized_sqls.emplace(parameterized_sql);
+}
+
+bool UnparameterizableSQLSet::contains(const std::string& parameterized_sql) const {
+  auto lock = std::shared_lock{_mutex};
+  return _parameterized_sqls.contains(parameterized_sql);
+}
+
+size_t UnparameterizableSQLSet::size() const {
+  auto lock = std::shared_lock{_mutex};
+  return _parameterized_sqls.size();
+}
+
+void UnparameterizableSQLSet::clear() {
+  auto lock = std::unique_lock{_mutex};
+  _parameterized_sqls.clear();
+}
+
+void set_default_plan_caches(const PlanCacheType type) {
+  Hyrise::get().default_pqp_cache = create_plan_cache<std::shared_ptr<AbstractOperator>>(type);
+  Hyrise::get().default_lqp_cache = create_plan_cache<std::shared_ptr<AbstractLQPNode>>(type);
+}
+
+}  // namespace opossum
@@ -1,16 +1,58 @@
 #pragma once
 
 #include <memory>
+#include <shared_mutex>
 #include <string>
+#include <unordered_set>
 
 #include "cache/gdfs_cache.hpp"
+#include "cache/sharded_cache.hpp"
 
 namespace opossum {
 
 class AbstractOperator;
 class AbstractLQPNode;
 
+using AbstractSQLPhysicalPlanCache = AbstractCache<std::string, std::shared_ptr<AbstractOperator>>;
+using AbstractSQLLogicalPlanCache = AbstractCache<std::string, std::shared_ptr<AbstractLQPNode>>;
+
 using SQLPhysicalPlanCache = GDFSCache<std::string, std::shared_ptr<AbstractOperator>>;
 using SQLLogicalPlanCache = GDFSCache<std::string, std::shared_ptr<AbstractLQPNode>>;
 
+using ShardedSQLPhysicalPlanCache = ShardedCache<std::string, std::shared_ptr<AbstractOperator>>;
+using ShardedSQLLogicalPlanCache = ShardedCache<std::string, std::shared_ptr<AbstractLQPNode>>;
+
+// GDFS: GDFSCache with exact GDFS eviction, but each lookup takes a cache-wide exclusive lock.
+// Sharded: ShardedCache, which scales to many concurrent clients (e.g., of the server).
+enum class PlanCacheType { GDFS, Sharded };
+
+template <typename Value>
+std::shared_ptr<AbstractCache<std::string, Value>> create_plan_cache(const PlanCacheType type,
+                                                                     const size_t capacity = DEFAULT_CACHE_CAPACITY) {
+  if (type == PlanCacheType::Sharded) return std::make_shared<ShardedCache<std::string, Value>>(capacity);
+  return std::make_shared<GDFSCache<std::string, Value>>(capacity);
+}
+
+// Parameterized SQL strings (see SQLLiteralParameterizer) whose plans could not be optimized. Statements matching them
+// skip the parameterized plan and are optimized as usual. The strings are kept apart from the SQLLogicalPlanCache, so
+// that they neither take up its capacity nor appear as plans in it. Once the capacity is reached, the set is cleared.
+class UnparameterizableSQLSet {
+ public:
+  explicit UnparameterizableSQLSet(const size_t capacity = DEFAULT_CACHE_CAPACITY);
+
+  void insert(const std::string& parameterized_sql);
+  bool contains(const std::string& parameterized_sql) const;
+
+  size_t size() const;
+  void clear();
+
+ private:
+  const size_t _capacity;
+  mutable std::shared_mutex _mutex;
+  std::unordered_set<std::string> _parameterized_sqls;
+};
+
+// Sets Hyrise::default_pqp_cache and Hyrise::default_lqp_cache to new, empty caches of the given type.
+void set_default_plan_caches(const PlanCacheType type);
+
 }  // namespace opossum
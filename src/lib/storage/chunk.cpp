@@ -81,9 +81,22 @@ ChunkOffset Chunk::size() const {
   return static_cast<ChunkOffset>(first_segment->size());
 }
 
-bool Chunk::has_mvcc_data() const { return _mvcc_data != nullptr; }
+bool Chunk::has_mvcc_data() const { return std::atomic_load(&_mvcc_data) != nullptr; }
 
-std::shared_ptr<MvccData> Chunk::mvcc_data() const { return _mvcc_data; }
+std::shared_ptr<MvccData> Chunk::mvcc_data() const { return std::atomic_load(&_mvcc_data); }
+
+bool Chunk::try_freeze_mvcc_data(const CommitID visibility_threshold) {
+  Assert(!is_mutable(), "Only the MVCC data of immutable chunks can be frozen");
+
+  const auto mvcc_data = this->mvcc_data();
+  if (!mvcc_data || mvcc_data->is_frozen() || size() == 0) return false;
+
+  const auto frozen_mvcc_data = mvcc_data->freeze(size(), visibility_threshold);
+  if (!frozen_mvcc_data) return false;
+
+  std::atomic_store(&_mvcc_data, frozen_mvcc_data);
+  return true;
+}
 
 std::vector<std::shared_ptr<AbstractIndex>> Chunk::get_indexes(
     const std::vector<std::shared_ptr<const AbstractSegment>>& segments) const {
@@ -112,6 +125,8 @@ void Chunk::finalize() {
   }
 }
 
+bool Chunk::has_indexes() const { return !_indexes.empty(); }
+
 std::vector<std::shared_ptr<AbstractIndex>> Chunk::get_indexes(const std::vector<ColumnID>& column_ids) const {
   auto segments = _get_segments_for_ids(column_ids);
   return get_indexes(segments);
@@ -158,7 +173,7 @@ bool Chunk::references_exactly_one_table() const {
   return true;
 }
 
-void Chunk::migrate(boost::container::pmr::memory_resource* memory_source) {
+void Chunk::migrate(boost::container::pmr::memory_resource* memory_source, const NodeID node_id) {
   // Migrating chunks with indexes is not implemented yet.
   if (!_indexes.empty()) {
     Fail("Cannot migrate Chunk with Indexes.");
@@ -170,8 +185,11 @@ void Chunk::migrate(boost::container::pmr::memory_resource* memory_source) {
     new_segments.push_back(segment->copy_using_allocator(_alloc));
   }
   _segments = std::move(new_segments);
+  _node_id = node_id;
 }
 
+NodeID Chunk::node_id() const { return _node_id; }
+
 const PolymorphicAllocator<Chunk>& Chunk::get_allocator() const { return _alloc; }
 
 size_t Chunk::memory_usage(const MemoryUsageCalculationMode mode) const {
@@ -183,8 +201,8 @@ size_t Chunk::memory_usage(const MemoryUsageCalculationMode mode) const {
 
   // TODO(anybody) Index memory usage missing
 
-  if (_mvcc_data) {
-    bytes += _mvcc_data->memory_usage();
+  if (const auto mvcc_data = this->mvcc_data()) {
+    bytes += mvcc_data->memory_usage();
   }
 
   return bytes;
@@ -85,12 +85,19 @@ class Chunk : private Noncopyable {
 
   bool has_mvcc_data() const;
 
+  // Atomically accesses the MVCC data, which might be replaced by a frozen copy (see try_freeze_mvcc_data)
   std::shared_ptr<MvccData> mvcc_data() const;
 
+  // Replaces the MVCC data of an immutable chunk by a frozen copy (see MvccData::freeze) if all rows were inserted and
+  // invalidated at or before `visibility_threshold`. Returns whether the MVCC data was frozen.
+  bool try_freeze_mvcc_data(const CommitID visibility_threshold);
+
   std::vector<std::shared_ptr<AbstractIndex>> get_indexes(
       const std::vector<std::shared_ptr<const AbstractSegment>>& segments) const;
   std::vector<std::shared_ptr<AbstractIndex>> get_indexes(const std::vector<ColumnID>& column_ids) const;
 
+  bool has_indexes() const;
+
   std::shared_ptr<AbstractIndex> get_index(const SegmentIndexType index_type,
                                            const std::vector<std::shared_ptr<const AbstractSegment>>& segments) const;
   std::shared_ptr<AbstractIndex> get_index(const SegmentIndexType index_type,
@@ -121,7 +128,15 @@ class Chunk : private Noncopyable {
 
   void remove_index(const std::shared_ptr<AbstractIndex>& index);
 
-  void migrate(boost::container::pmr::memory_resource* memory_source);
+  /**
+   * Copies all segments using the given memory resource. If the resource allocates memory on a NUMA node, node_id
+   * should be that node, so that per-chunk jobs can be scheduled on it (see place_chunks_on_numa_nodes). Migration is
+   * not thread-safe and must not happen while the chunk is being accessed.
+   */
+  void migrate(boost::container::pmr::memory_resource* memory_source, const NodeID node_id = INVALID_NODE_ID);
+
+  // NUMA node that holds the segments of this chunk, INVALID_NODE_ID if the chunk has not been placed on a node.
+  NodeID node_id() const;
 
   bool references_exactly_one_table() const;
 
@@ -198,6 +213,7 @@ class Chunk : private Noncopyable {
   std::optional<ChunkPruningStatistics> _pruning_statistics;
   bool _is_mutable = true;
   std::vector<SortColumnDefinition> _sorted_by;
+  NodeID _node_id{INVALID_NODE_ID};
   mutable std::atomic<ChunkOffset> _invalid_row_count{0};
 
   // Default value of zero means "not set"
@@ -10,6 +10,7 @@
 #include "statistics/generate_pruning_statistics.hpp"
 #include "storage/abstract_encoded_segment.hpp"
 #include "storage/base_segment_encoder.hpp"
+#include "storage/foreign_segment.hpp"
 #include "storage/reference_segment.hpp"
 #include "storage/segment_encoding_utils.hpp"
 #include "storage/segment_iterables/any_segment_iterable.hpp"
@@ -94,6 +95,9 @@ void ChunkEncoder::encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::
          "Number of column encoding specs must match the chunk’s column count.");
   Assert(!chunk->is_mutable(), "Only immutable chunks can be encoded.");
 
+  // The data of foreign chunks remains in their file (see ForeignSegment). Encoding them would load it into memory.
+  if (std::dynamic_pointer_cast<const ForeignSegment>(chunk->get_segment(ColumnID{0}))) return;
+
   for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
     const auto spec = chunk_encoding_spec[column_id];
 
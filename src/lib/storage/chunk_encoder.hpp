@@ -36,6 +36,7 @@ class ChunkEncoder {
    * @brief Encodes a chunk
    *
    * Encodes a chunk using the passed encoding specifications. Reduces also the fragmentation of the chunk’s MVCC data.
+   * Chunks of foreign tables (see ForeignSegment) are left unchanged.
    */
   static void encode_chunk(const std::shared_ptr<Chunk>& chunk, const std::vector<DataType>& column_data_types,
                            const ChunkEncodingSpec& chunk_encoding_spec);
@@ -0,0 +1,32 @@
+#include "foreign_segment.hpp"
+
+#include <memory>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+ForeignSegment::ForeignSegment(const DataType data_type, const ChunkOffset size, const LoadFunction& load_function)
+    : AbstractSegment(data_type), _size(size), _load_function(load_function) {}
+
+std::shared_ptr<AbstractSegment> ForeignSegment::load() const {
+  auto segment = _load_function();
+  Assert(segment->data_type() == data_type() && segment->size() == _size, "Loaded segment does not match");
+  return segment;
+}
+
+AllTypeVariant ForeignSegment::operator[](const ChunkOffset /*chunk_offset*/) const {
+  Fail("ForeignSegments have to be loaded before their values can be accessed");
+}
+
+ChunkOffset ForeignSegment::size() const { return _size; }
+
+std::shared_ptr<AbstractSegment> ForeignSegment::copy_using_allocator(
+    const PolymorphicAllocator<size_t>& /*alloc*/) const {
+  // The data is not held in memory, so there is nothing to place on a new NUMA node.
+  return std::make_shared<ForeignSegment>(data_type(), _size, _load_function);
+}
+
+size_t ForeignSegment::memory_usage(const MemoryUsageCalculationMode /*mode*/) const { return sizeof(*this); }
+
+}  // namespace opossum
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <functional>
+#include <memory>
+
+#include "abstract_segment.hpp"
+
+namespace opossum {
+
+/**
+ * Placeholder for a segment of a foreign table, i.e., a table whose data remains in an external file (see
+ * ParquetParser::attach). The data is read from the file only when the segment is loaded. GetTable loads the
+ * ForeignSegments of all chunks and columns that were not pruned and passes the loaded segments on. Thus, operators
+ * other than GetTable never see ForeignSegments. The loaded segments are not cached, so that querying a foreign table
+ * does not keep its data in memory.
+ */
+class ForeignSegment : public AbstractSegment {
+ public:
+  using LoadFunction = std::function<std::shared_ptr<AbstractSegment>()>;
+
+  ForeignSegment(const DataType data_type, const ChunkOffset size, const LoadFunction& load_function);
+
+  // Reads the segment from its file.
+  std::shared_ptr<AbstractSegment> load() const;
+
+  /**
+   * @defgroup AbstractSegment interface
+   * @{
+   */
+
+  AllTypeVariant operator[](const ChunkOffset chunk_offset) const final;
+
+  ChunkOffset size() const final;
+
+  std::shared_ptr<AbstractSegment> copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const final;
+
+  size_t memory_usage(const MemoryUsageCalculationMode mode) const final;
+  /**@}*/
+
+ protected:
+  const ChunkOffset _size;
+  const LoadFunction _load_function;
+};
+
+}  // namespace opossum
@@ -1,5 +1,9 @@
 #include "mvcc_data.hpp"
 
+#include <algorithm>
+#include <mutex>
+
+#include "storage/row_versions.hpp"
 #include "utils/assert.hpp"
 
 namespace opossum {
@@ -13,7 +17,24 @@ MvccData::MvccData(const size_t size, CommitID begin_commit_id) {
   std::atomic_thread_fence(std::memory_order_seq_cst);
 }
 
+MvccData::MvccData(const ChunkOffset size, const CommitID begin_commit_id, const CommitID end_commit_id,
+                   std::vector<uint64_t> invalid_rows)
+    : max_begin_cid{begin_commit_id},
+      _is_frozen{true},
+      _frozen_size{size},
+      _frozen_end_cid{end_commit_id},
+      _frozen_invalid_rows{std::move(invalid_rows)} {}
+
 std::ostream& operator<<(std::ostream& stream, const MvccData& mvcc_data) {
+  if (mvcc_data._is_frozen) {
+    stream << "Frozen at BeginCID " << *mvcc_data.max_begin_cid << ", invalid rows: ";
+    for (auto offset = ChunkOffset{0}; offset < mvcc_data._frozen_size; ++offset) {
+      if (mvcc_data.get_end_cid(offset) != MvccData::MAX_COMMIT_ID) stream << offset << ", ";
+    }
+    stream << std::endl;
+    return stream;
+  }
+
   stream << "TIDs: ";
   for (const auto& tid : mvcc_data._tids) stream << tid.load() << ", ";
   stream << std::endl;
@@ -30,32 +51,69 @@ std::ostream& operator<<(std::ostream& stream, const MvccData& mvcc_data) {
 }
 
 CommitID MvccData::get_begin_cid(const ChunkOffset offset) const {
+  if (_is_frozen) {
+    DebugAssert(offset < _frozen_size, "offset out of bounds");
+    return *max_begin_cid;
+  }
+
   DebugAssert(offset < _begin_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   return _begin_cids[offset];
 }
 
 void MvccData::set_begin_cid(const ChunkOffset offset, const CommitID commit_id) {
+  DebugAssert(!_is_frozen, "Rows cannot be inserted into frozen MVCC data");
   DebugAssert(offset < _begin_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   _begin_cids[offset] = commit_id;
 }
 
 CommitID MvccData::get_end_cid(const ChunkOffset offset) const {
+  if (_is_frozen) {
+    DebugAssert(offset < _frozen_size, "offset out of bounds");
+    if (_has_changed_rows) {
+      auto lock = std::shared_lock{_changed_rows_mutex};
+      const auto iter = _changed_rows.find(offset);
+      if (iter != _changed_rows.end()) return iter->second.end_cid;
+    }
+    return _is_frozen_invalid(offset) ? _frozen_end_cid : MAX_COMMIT_ID;
+  }
+
   DebugAssert(offset < _end_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   return _end_cids[offset];
 }
 
 void MvccData::set_end_cid(const ChunkOffset offset, const CommitID commit_id) {
+  if (_is_frozen) {
+    auto lock = std::unique_lock{_changed_rows_mutex};
+    _changed_row(offset).end_cid = commit_id;
+    return;
+  }
+
   DebugAssert(offset < _end_cids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   _end_cids[offset] = commit_id;
 }
 
 TransactionID MvccData::get_tid(const ChunkOffset offset) const {
+  if (_is_frozen) {
+    DebugAssert(offset < _frozen_size, "offset out of bounds");
+    if (!_has_changed_rows) return INVALID_TRANSACTION_ID;
+
+    auto lock = std::shared_lock{_changed_rows_mutex};
+    const auto iter = _changed_rows.find(offset);
+    return iter != _changed_rows.end() ? iter->second.tid : INVALID_TRANSACTION_ID;
+  }
+
   DebugAssert(offset < _tids.size(), "offset out of bounds; MvccData insufficently preallocated?");
   return _tids[offset];
 }
 
 void MvccData::set_tid(const ChunkOffset offset, const TransactionID new_transaction_id,
                        const std::memory_order memory_order) {
+  if (_is_frozen) {
+    auto lock = std::unique_lock{_changed_rows_mutex};
+    _changed_row(offset).tid = new_transaction_id;
+    return;
+  }
+
   DebugAssert(offset < _tids.size(), "offset out of bounds; MvccData insufficently preallocated?");
 
   _tids[offset].store(new_transaction_id, memory_order);
@@ -63,13 +121,247 @@ void MvccData::set_tid(const ChunkOffset offset, const TransactionID new_transac
 
 bool MvccData::compare_exchange_tid(const ChunkOffset offset, TransactionID expected_transaction_id,
                                     TransactionID new_transaction_id) {
+  if (_is_frozen) {
+    auto lock = std::unique_lock{_changed_rows_mutex};
+    auto& changed_row = _changed_row(offset);
+    if (changed_row.tid != expected_transaction_id) return false;
+    changed_row.tid = new_transaction_id;
+    return true;
+  }
+
   DebugAssert(offset < _tids.size(), "offset out of bounds; MvccData insufficently preallocated?");
 
   return _tids[offset].compare_exchange_strong(expected_transaction_id, new_transaction_id);
 }
 
-size_t MvccData::memory_usage() const {
+std::shared_ptr<RowVersions> MvccData::row_versions() const { return std::atomic_load(&_row_versions); }
+
+std::shared_ptr<RowVersions> MvccData::get_or_create_row_versions() {
+  auto row_versions = std::atomic_load(&_row_versions);
+  if (row_versions && !row_versions->is_retired()) return row_versions;
+
+  // Retired versions are replaced before reset_row_versions removes them. If another thread created the versions in
+  // the meantime, row_versions is set to them.
+  const auto new_row_versions = std::make_shared<RowVersions>();
+  if (std::atomic_compare_exchange_strong(&_row_versions, &row_versions, new_row_versions)) return new_row_versions;
+  return row_versions;
+}
+
+void MvccData::reset_row_versions(const std::shared_ptr<RowVersions>& row_versions) {
+  DebugAssert(row_versions && row_versions->is_retired(), "Only retired versions can be removed");
+  auto expected_row_versions = row_versions;
+  std::atomic_compare_exchange_strong(&_row_versions, &expected_row_versions, std::shared_ptr<RowVersions>{});
+}
+
+std::shared_ptr<MvccData> MvccData::freeze(const ChunkOffset chunk_size, const CommitID visibility_threshold) {
+  Assert(!_is_frozen, "MVCC data is already frozen");
+  DebugAssert(chunk_size > 0 && chunk_size <= _tids.size(), "Invalid chunk size");
+
+  // Lock all rows first. Afterwards, no transaction can invalidate rows anymore, so that the commit ids checked below
+  // do not change. Committed deletes and rolled-back inserts keep the TID of their transaction (see
+  // Delete::_on_commit_records). These rows are invisible to all transactions once their end_cid is at or below the
+  // threshold, so their TID is replaced as well. The previous TIDs are restored if the data cannot be frozen.
+  auto previous_tids = std::vector<TransactionID>{};
+  previous_tids.reserve(chunk_size);
+  while (previous_tids.size() < chunk_size) {
+    const auto offset = static_cast<ChunkOffset>(previous_tids.size());
+    auto expected_tid = INVALID_TRANSACTION_ID;
+    if (!_tids[offset].compare_exchange_strong(expected_tid, FROZEN_TRANSACTION_ID)) {
+      const auto end_cid = get_end_cid(offset);
+      if (end_cid == MAX_COMMIT_ID || end_cid > visibility_threshold ||
+          !_tids[offset].compare_exchange_strong(expected_tid, FROZEN_TRANSACTION_ID)) {
+        break;
+      }
+    }
+    previous_tids.emplace_back(expected_tid);
+  }
+  const auto locked_row_count = static_cast<ChunkOffset>(previous_tids.size());
+
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+
+  auto frozen_begin_cid = CommitID{0};
+  auto frozen_end_cid = CommitID{0};
+  auto invalid_rows = std::vector<uint64_t>{};
+  auto can_freeze = locked_row_count == chunk_size;
+  for (auto offset = ChunkOffset{0}; can_freeze && offset < chunk_size; ++offset) {
+    const auto begin_cid = get_begin_cid(offset);
+    const auto end_cid = get_end_cid(offset);
+    if (begin_cid > visibility_threshold || (end_cid != MAX_COMMIT_ID && end_cid > visibility_threshold)) {
+      can_freeze = false;
+      continue;
+    }
+
+    frozen_begin_cid = std::max(frozen_begin_cid, begin_cid);
+    if (end_cid == MAX_COMMIT_ID) continue;
+
+    // Rows that were deleted or whose insert was rolled back are invisible to all transactions.
+    if (invalid_rows.empty()) invalid_rows.resize((chunk_size + 63) / 64);
+    invalid_rows[offset / 64] |= uint64_t{1} << (offset % 64);
+    frozen_end_cid = std::max(frozen_end_cid, end_cid);
+  }
+
+  if (!can_freeze) {
+    for (auto offset = ChunkOffset{0}; offset < locked_row_count; ++offset) {
+      set_tid(offset, previous_tids[offset]);
+    }
+    return nullptr;
+  }
+
+  auto frozen_mvcc_data =
+      std::shared_ptr<MvccData>(new MvccData(chunk_size, frozen_begin_cid, frozen_end_cid, std::move(invalid_rows)));
+  frozen_mvcc_data->_row_versions = row_versions();
+  return frozen_mvcc_data;
+}
+
+bool MvccData::is_frozen() const { return _is_frozen; }
+
+bool MvccData::has_changes_since_freeze() const { return _has_changed_rows; }
+
+const std::vector<uint64_t>& MvccData::frozen_invalid_rows() const { return _frozen_invalid_rows; }
+
+bool MvccData::_is_frozen_invalid(const ChunkOffset offset) const {
+  return !_frozen_invalid_rows.empty() && ((_frozen_invalid_rows[offset / 64] >> (offset % 64)) & 1);
+}
+
+MvccData::ChangedRow& MvccData::_changed_row(const ChunkOffset offset) {
+  DebugAssert(offset < _frozen_size, "offset out of bounds");
+  auto iter = _changed_rows.find(offset);
+  if (iter == _changed_rows.end()) {
+    const auto end_cid = _is_frozen_invalid(offset) ? _frozen_end_cid : MAX_COMMIT_ID;
+    iter = _changed_rows.emplace(offset, ChangedRow{INVALID_TRANSACTION_ID, end_cid}).first;
+    _has_changed_rows = true;
+  }
+  return iter->second;
+}
+
+void MvccData::visible_rows(const TransactionID transaction_id, const CommitID snapshot_commit_id,
+                            const ChunkOffset row_count, std::vector<uint64_t>& bitmap) const {
+  const auto word_count = (static_cast<size_t>(row_count) + 63) / 64;
+  bitmap.assign(word_count, 0);
+
+  if (_is_frozen) {
+    DebugAssert(row_count <= _frozen_size, "Row count exceeds the MVCC data");
+
+    // All rows that are not marked as invalid were inserted at max_begin_cid at the latest.
+    if (snapshot_commit_id >= *max_begin_cid) {
+      for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+        bitmap[word_index] = _frozen_invalid_rows.empty() ? ~uint64_t{0} : ~_frozen_invalid_rows[word_index];
+      }
+      if (row_count % 64 != 0) bitmap.back() &= (uint64_t{1} << (row_count % 64)) - 1;
+    }
+
+    if (!_has_changed_rows) return;
+
+    auto lock = std::shared_lock{_changed_rows_mutex};
+    for (const auto& [offset, changed_row] : _changed_rows) {
+      if (offset >= row_count) continue;
+
+      const auto is_own_row = transaction_id != INVALID_TRANSACTION_ID && changed_row.tid == transaction_id;
+      const auto is_visible =
+          snapshot_commit_id < changed_row.end_cid && ((snapshot_commit_id >= *max_begin_cid) != is_own_row);
+      const auto bit = uint64_t{1} << (offset % 64);
+      bitmap[offset / 64] = is_visible ? bitmap[offset / 64] | bit : bitmap[offset / 64] & ~bit;
+    }
+    return;
+  }
+
+  DebugAssert(row_count <= _begin_cids.size(), "Row count exceeds the MVCC data");
+  const auto* const begin_cids = _begin_cids.data();
+  const auto* const end_cids = _end_cids.data();
+
+  for (auto word_index = size_t{0}; word_index < word_count; ++word_index) {
+    const auto first_offset = word_index * 64;
+    const auto block_size = std::min(size_t{64}, row_count - first_offset);
+
+    // Same formula as in Validate::is_row_visible, evaluated for 64 rows at once
+    auto begin_visible = uint64_t{0};
+    auto end_visible = uint64_t{0};
+    for (auto index = size_t{0}; index < block_size; ++index) {
+      begin_visible |= uint64_t{snapshot_commit_id >= begin_cids[first_offset + index]} << index;
+      end_visible |= uint64_t{snapshot_commit_id < end_cids[first_offset + index]} << index;
+    }
+
+    // The transaction ids only matter for rows that the transaction has locked itself before.
+    auto own_rows = uint64_t{0};
+    if (transaction_id != INVALID_TRANSACTION_ID) {
+      for (auto index = size_t{0}; index < block_size; ++index) {
+        own_rows |= uint64_t{_tids[first_offset + index].load(std::memory_order_relaxed) == transaction_id} << index;
+      }
+    }
+
+    bitmap[word_index] = end_visible & (begin_visible ^ own_rows);
+  }
+}
+
+std::shared_ptr<const MvccData::VisibleRows> MvccData::shared_visible_rows(const ChunkOffset row_count,
+                                                                          const CommitID snapshot_commit_id,
+                                                                          const CommitID last_commit_id) const {
+  if (auto visible_rows = cached_visible_rows(row_count, snapshot_commit_id)) return visible_rows;
+
+  auto visible_rows = std::make_shared<VisibleRows>();
+  visible_rows->row_count = row_count;
+  this->visible_rows(INVALID_TRANSACTION_ID, snapshot_commit_id, row_count, visible_rows->bitmap);
+
+  // The visibility of the rows only changes at the commit ids stored for them. Thus, the bitmap is valid from the
+  // newest of these commit ids at or before the snapshot up to the next one. Commits after `last_commit_id` might not
+  // have been written completely when the bitmap was computed, while those up to the snapshot have been.
+  auto newest_change = CommitID{0};
+  auto next_change = std::max(last_commit_id, snapshot_commit_id) + 1;
+  const auto add_change = [&](const CommitID commit_id) {
+    if (commit_id <= snapshot_commit_id) {
+      newest_change = std::max(newest_change, commit_id);
+    } else {
+      next_change = std::min(next_change, commit_id);
+    }
+  };
+
+  if (_is_frozen) {
+    add_change(*max_begin_cid);
+    if (!_frozen_invalid_rows.empty()) add_change(_frozen_end_cid);
+
+    auto lock = std::shared_lock{_changed_rows_mutex};
+    for (const auto& [offset, changed_row] : _changed_rows) {
+      add_change(changed_row.end_cid);
+    }
+  } else {
+    for (auto offset = ChunkOffset{0}; offset < row_count; ++offset) {
+      add_change(_begin_cids[offset]);
+      add_change(_end_cids[offset]);
+    }
+  }
+
+  visible_rows->first_snapshot_commit_id = newest_change;
+  visible_rows->last_snapshot_commit_id = next_change - 1;
+
+  // Concurrent transactions might replace each other's bitmaps. As they are equally valid, this does not matter.
+  auto shared_visible_rows = std::shared_ptr<const VisibleRows>{std::move(visible_rows)};
+  std::atomic_store(&_shared_visible_rows, shared_visible_rows);
+  return shared_visible_rows;
+}
+
+std::shared_ptr<const MvccData::VisibleRows> MvccData::cached_visible_rows(const ChunkOffset row_count,
+                                                                          const CommitID snapshot_commit_id) const {
+  auto visible_rows = std::atomic_load(&_shared_visible_rows);
+  if (!visible_rows || visible_rows->row_count != row_count ||
+      snapshot_commit_id < visible_rows->first_snapshot_commit_id ||
+      snapshot_commit_id > visible_rows->last_snapshot_commit_id) {
+    return nullptr;
+  }
+  return visible_rows;
+}
+
+size_t MvccData::visibility_memory_usage() const {
   auto bytes = size_t{0};
+  if (_is_frozen) {
+    bytes += sizeof(_frozen_invalid_rows) + _frozen_invalid_rows.size() * sizeof(uint64_t);
+
+    auto lock = std::shared_lock{_changed_rows_mutex};
+    // Each entry of the map additionally needs a node pointer and a bucket
+    bytes += sizeof(_changed_rows) +
+             _changed_rows.size() * (sizeof(decltype(_changed_rows)::value_type) + 2 * sizeof(void*));
+    return bytes;
+  }
+
   bytes += sizeof(_tids) + sizeof(_begin_cids) + sizeof(_end_cids);  // NOLINT
   bytes += _tids.size() * sizeof(decltype(_tids)::value_type);
   bytes += _begin_cids.size() * sizeof(decltype(_begin_cids)::value_type);
@@ -77,4 +369,13 @@ size_t MvccData::memory_usage() const {
   return bytes;
 }
 
+size_t MvccData::memory_usage() const {
+  auto bytes = visibility_memory_usage();
+  if (const auto row_versions = this->row_versions()) bytes += row_versions->memory_usage();
+  if (const auto visible_rows = std::atomic_load(&_shared_visible_rows)) {
+    bytes += sizeof(VisibleRows) + visible_rows->bitmap.capacity() * sizeof(uint64_t);
+  }
+  return bytes;
+}
+
 }  // namespace opossum
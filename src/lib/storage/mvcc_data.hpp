@@ -1,15 +1,25 @@
 #pragma once
 
 #include <atomic>
+#include <memory>
 #include <shared_mutex>  // NOLINT lint thinks this is a C header or something
+#include <unordered_map>
+#include <vector>
 
 #include "types.hpp"
 #include "utils/copyable_atomic.hpp"
 
 namespace opossum {
 
+class RowVersions;
+
 /**
  * Stores visibility information for multiversion concurrency control.
+ *
+ * Once all rows of an immutable chunk were inserted and invalidated before the oldest active snapshot, each row is
+ * either visible or invisible to all current and future transactions. The per-row commit ids are not needed anymore
+ * and the MVCC data can be frozen (see freeze()). Frozen MVCC data only stores max_begin_cid and a bitmap of the
+ * invalid rows. The few rows that are deleted afterwards are tracked in a sparse map.
  */
 struct MvccData {
   friend class Chunk;
@@ -19,6 +29,10 @@ struct MvccData {
   // The last commit id is reserved for uncommitted changes
   static constexpr CommitID MAX_COMMIT_ID = std::numeric_limits<CommitID>::max() - 1;
 
+  // Locks all rows of MVCC data that has been replaced by a frozen copy, so that transactions that still hold it
+  // cannot delete or update its rows anymore.
+  static constexpr TransactionID FROZEN_TRANSACTION_ID = std::numeric_limits<TransactionID>::max();
+
   // This is used for optimizing the validation process. It is set during Chunk::finalize(). Consult
   // Validate::_on_execute for further details.
   std::optional<CommitID> max_begin_cid;
@@ -45,13 +59,98 @@ struct MvccData {
   bool compare_exchange_tid(const ChunkOffset offset, TransactionID expected_transaction_id,
                             TransactionID new_transaction_id);
 
+  // Returns the versions of the rows that were updated in place (see RowVersions), nullptr if no row of the chunk has
+  // been updated in place or if all versions have been merged into the main segments (see merge_row_versions).
+  std::shared_ptr<RowVersions> row_versions() const;
+  std::shared_ptr<RowVersions> get_or_create_row_versions();
+
+  // Removes the versions if they are still `row_versions`, which must have been retired (see RowVersions::try_retire).
+  void reset_row_versions(const std::shared_ptr<RowVersions>& row_versions);
+
+  // Returns a frozen copy of the MVCC data of a chunk with `chunk_size` rows, which Chunk::try_freeze_mvcc_data
+  // installs in place of this object. All rows of this object are locked with FROZEN_TRANSACTION_ID. Returns nullptr
+  // and leaves this object unchanged if a row is locked by an active transaction or was inserted or invalidated after
+  // `visibility_threshold`.
+  std::shared_ptr<MvccData> freeze(const ChunkOffset chunk_size, const CommitID visibility_threshold);
+
+  bool is_frozen() const;
+
+  // For frozen MVCC data, returns whether rows have been locked or invalidated since it was frozen. If not, a row is
+  // visible to all transactions with a snapshot of max_begin_cid or newer unless it is set in frozen_invalid_rows().
+  bool has_changes_since_freeze() const;
+
+  // Bitmap of the rows that were invalid when the MVCC data was frozen, empty if all rows were valid
+  const std::vector<uint64_t>& frozen_invalid_rows() const;
+
+  // Bitmap of the rows that are visible to transactions with a snapshot commit id between the first and the last one
+  // (inclusive) that have not modified the rows themselves
+  struct VisibleRows {
+    CommitID first_snapshot_commit_id;
+    CommitID last_snapshot_commit_id;
+    ChunkOffset row_count;
+    std::vector<uint64_t> bitmap;
+  };
+
+  // Sets a bit in `bitmap` for each of the first `row_count` rows that is visible to the transaction (see
+  // Validate::is_row_visible). The commit ids and transaction ids are evaluated in blocks of 64 rows over the
+  // contiguous vectors, which the compiler can vectorize. Pass INVALID_TRANSACTION_ID to ignore the transaction ids.
+  void visible_rows(const TransactionID transaction_id, const CommitID snapshot_commit_id, const ChunkOffset row_count,
+                    std::vector<uint64_t>& bitmap) const;
+
+  // Returns the visible rows of an immutable chunk with `row_count` rows for transactions that have not modified its
+  // rows. The bitmap is valid for all snapshots in which no row was inserted or invalidated and is cached, so that
+  // concurrent transactions with similar snapshots share it. `last_commit_id` has to be read before calling this
+  // method, as commits that are not completed yet might only be partially visible here.
+  std::shared_ptr<const VisibleRows> shared_visible_rows(const ChunkOffset row_count, const CommitID snapshot_commit_id,
+                                                         const CommitID last_commit_id) const;
+
+  // Returns the cached visible rows (see shared_visible_rows) if they are valid for the snapshot, nullptr otherwise
+  std::shared_ptr<const VisibleRows> cached_visible_rows(const ChunkOffset row_count,
+                                                         const CommitID snapshot_commit_id) const;
+
+  // Memory used by the commit ids and transaction ids or, if frozen, by the bitmap and the rows changed since then
+  size_t visibility_memory_usage() const;
+
+  // Includes the row versions
   size_t memory_usage() const;
 
  private:
+  // Row that was locked or invalidated after the MVCC data was frozen
+  struct ChangedRow {
+    TransactionID tid;
+    CommitID end_cid;
+  };
+
+  // Creates frozen MVCC data, see freeze()
+  MvccData(const ChunkOffset size, const CommitID begin_commit_id, const CommitID end_commit_id,
+           std::vector<uint64_t> invalid_rows);
+
+  bool _is_frozen_invalid(const ChunkOffset offset) const;
+
+  // Returns the changed row, which is created from the frozen state if needed. Requires _changed_rows_mutex to be
+  // locked exclusively.
+  ChangedRow& _changed_row(const ChunkOffset offset);
+
   // These vectors are pre-allocated. Do not resize them as someone might be reading them concurrently.
   pmr_vector<CommitID> _begin_cids;                  // < commit id when record was added
   pmr_vector<CommitID> _end_cids;                    // < commit id when record was deleted
   pmr_vector<copyable_atomic<TransactionID>> _tids;  // < 0 unless locked by a transaction
+
+  // Accessed with std::atomic_load/store, as it is created lazily
+  std::shared_ptr<RowVersions> _row_versions;
+
+  // Accessed with std::atomic_load/store, see shared_visible_rows()
+  mutable std::shared_ptr<const VisibleRows> _shared_visible_rows;
+
+  // Only used by frozen MVCC data. _frozen_end_cid is the highest end commit id of the invalid rows.
+  bool _is_frozen = false;
+  ChunkOffset _frozen_size{0};
+  CommitID _frozen_end_cid{0};
+  std::vector<uint64_t> _frozen_invalid_rows;
+
+  mutable std::shared_mutex _changed_rows_mutex;
+  std::unordered_map<ChunkOffset, ChangedRow> _changed_rows;
+  std::atomic_bool _has_changed_rows{false};
 };
 
 std::ostream& operator<<(std::ostream& stream, const MvccData& mvcc_data);
@@ -0,0 +1,100 @@
+#include "numa_placement.hpp"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "hyrise.hpp"
+#include "memory/numa_memory_resource.hpp"
+#include "storage/chunk.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+namespace {
+
+uint64_t chunk_access_count(const Chunk& chunk) {
+  auto access_count = uint64_t{0};
+  const auto column_count = chunk.column_count();
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto& access_counter = chunk.get_segment(column_id)->access_counter;
+    for (auto type = size_t{0}; type < static_cast<size_t>(SegmentAccessCounter::AccessType::Count); ++type) {
+      access_count += access_counter[static_cast<SegmentAccessCounter::AccessType>(type)].load();
+    }
+  }
+  return access_count;
+}
+
+}  // namespace
+
+void place_chunks_on_numa_nodes(const std::shared_ptr<Table>& table, const NumaPlacementPolicy policy) {
+  Assert(table->type() == TableType::Data, "Only data tables can be placed on NUMA nodes");
+
+  const auto& topology = Hyrise::get().topology;
+  const auto node_count = topology.nodes().size();
+  Assert(node_count > 0, "Topology has no nodes");
+
+  // Collect the chunks that can be migrated together with their number of accesses.
+  auto chunks = std::vector<std::pair<std::shared_ptr<Chunk>, uint64_t>>{};
+  const auto chunk_count = table->chunk_count();
+  chunks.reserve(chunk_count);
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk || chunk->is_mutable() || chunk->has_indexes()) continue;
+
+    const auto access_count = policy == NumaPlacementPolicy::Hotness ? chunk_access_count(*chunk) : uint64_t{0};
+    chunks.emplace_back(chunk, access_count);
+  }
+
+  if (policy == NumaPlacementPolicy::Hotness) {
+    std::stable_sort(chunks.begin(), chunks.end(),
+                     [](const auto& lhs, const auto& rhs) { return lhs.second > rhs.second; });
+  }
+
+  // For round-robin placement, all access counts are zero, so the least loaded node is the next one in turn.
+  auto node_access_counts = std::vector<uint64_t>(node_count);
+  auto node_chunk_counts = std::vector<size_t>(node_count);
+  for (const auto& [chunk, access_count] : chunks) {
+    auto node_id = NodeID{0};
+    for (auto candidate_node_id = NodeID{1}; candidate_node_id < node_count; ++candidate_node_id) {
+      if (std::make_pair(node_access_counts[candidate_node_id], node_chunk_counts[candidate_node_id]) <
+          std::make_pair(node_access_counts[node_id], node_chunk_counts[node_id])) {
+        node_id = candidate_node_id;
+      }
+    }
+
+    if (chunk->node_id() != node_id) {
+      chunk->migrate(topology.get_memory_resource(node_id), node_id);
+    }
+    node_access_counts[node_id] += access_count;
+    ++node_chunk_counts[node_id];
+  }
+}
+
+void place_all_tables_on_numa_nodes(const NumaPlacementPolicy policy) {
+  for (const auto& [table_name, table] : Hyrise::get().storage_manager.tables()) {
+    place_chunks_on_numa_nodes(table, policy);
+  }
+}
+
+NodeID preferred_numa_node_id(const Table& table, const ChunkID chunk_id) {
+  const auto chunk = table.get_chunk(chunk_id);
+  if (!chunk) return INVALID_NODE_ID;
+
+  if (table.type() == TableType::Data) return chunk->node_id();
+
+  // All segments of a reference chunk usually share their position list, so the first segment is representative.
+  if (chunk->column_count() == 0) return INVALID_NODE_ID;
+  const auto reference_segment = std::dynamic_pointer_cast<const ReferenceSegment>(chunk->get_segment(ColumnID{0}));
+  if (!reference_segment) return INVALID_NODE_ID;
+
+  const auto& pos_list = reference_segment->pos_list();
+  if (pos_list->empty() || !pos_list->references_single_chunk()) return INVALID_NODE_ID;
+
+  const auto referenced_chunk = reference_segment->referenced_table()->get_chunk(pos_list->common_chunk_id());
+  return referenced_chunk ? referenced_chunk->node_id() : INVALID_NODE_ID;
+}
+
+}  // namespace opossum
@@ -0,0 +1,40 @@
+#pragma once
+
+#include <memory>
+
+#include "types.hpp"
+
+namespace opossum {
+
+class Table;
+
+enum class NumaPlacementPolicy {
+  // Chunk i is placed on node i % node_count.
+  RoundRobin,
+  // Chunks are ordered by the number of accesses recorded in their segments' SegmentAccessCounters. Each chunk is then
+  // placed on the node with the fewest accumulated accesses so far, so that frequently used chunks are spread evenly.
+  Hotness
+};
+
+/**
+ * Moves the immutable chunks of the given table to the NUMA nodes of Hyrise::get().topology according to the policy.
+ * The segments are copied using the node's NumaMemoryResource (see Topology::get_memory_resource), and the node is
+ * stored in the chunk (see Chunk::node_id()). Mutable chunks and chunks with indexes are not moved.
+ *
+ * Chunks are migrated in place, so this must not be called while the table is being accessed by queries (e.g., only
+ * after loading the data). Chunks that are encoded after their placement lose it, as encoding allocates new segments.
+ */
+void place_chunks_on_numa_nodes(const std::shared_ptr<Table>& table, const NumaPlacementPolicy policy);
+
+// Calls place_chunks_on_numa_nodes for all tables in the StorageManager.
+void place_all_tables_on_numa_nodes(const NumaPlacementPolicy policy);
+
+/**
+ * Returns the NUMA node that holds the data of the given chunk, to be used as the preferred node of jobs that process
+ * the chunk (see AbstractTask::set_preferred_node_id). For data tables, this is Chunk::node_id(). For reference
+ * tables, it is the node of the referenced chunk if all segments reference a single chunk. Otherwise, INVALID_NODE_ID
+ * is returned.
+ */
+NodeID preferred_numa_node_id(const Table& table, const ChunkID chunk_id);
+
+}  // namespace opossum
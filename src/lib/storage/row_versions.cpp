@@ -0,0 +1,339 @@
+#include "row_versions.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+#include "hyrise.hpp"
+#include "resolve_type.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "storage/chunk.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/foreign_segment.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+RowVersion::RowVersion(const TransactionID init_transaction_id,
+                       std::vector<std::pair<ColumnID, AllTypeVariant>> init_values)
+    : begin_cid{MvccData::MAX_COMMIT_ID}, transaction_id{init_transaction_id}, values{std::move(init_values)} {
+  DebugAssert(std::is_sorted(values.begin(), values.end(),
+                             [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; }),
+              "Expected values sorted by ColumnID");
+}
+
+std::shared_ptr<RowVersion> RowVersions::newest_version(const ChunkOffset chunk_offset) const {
+  auto lock = std::shared_lock{_mutex};
+  const auto iter = _newest_versions.find(chunk_offset);
+  return iter != _newest_versions.end() ? iter->second : nullptr;
+}
+
+bool RowVersions::add_version(const ChunkOffset chunk_offset,
+                              const std::shared_ptr<RowVersion>& expected_newest_version,
+                              const std::shared_ptr<RowVersion>& version) {
+  auto lock = std::unique_lock{_mutex};
+  if (_is_retired) return false;
+
+  auto& newest_version = _newest_versions[chunk_offset];
+  if (newest_version != expected_newest_version) {
+    if (!newest_version) _newest_versions.erase(chunk_offset);
+    return false;
+  }
+
+  version->previous = newest_version;
+  newest_version = version;
+  return true;
+}
+
+void RowVersions::remove_version(const ChunkOffset chunk_offset, const std::shared_ptr<RowVersion>& version) {
+  auto lock = std::unique_lock{_mutex};
+  const auto iter = _newest_versions.find(chunk_offset);
+  Assert(iter != _newest_versions.end() && iter->second == version, "Only the newest version can be removed");
+  DebugAssert(version->begin_cid == MvccData::MAX_COMMIT_ID, "Committed versions cannot be removed");
+
+  if (version->previous) {
+    iter->second = version->previous;
+  } else {
+    _newest_versions.erase(iter);
+  }
+}
+
+RowVersions::VersionList RowVersions::visible_versions(const TransactionID transaction_id,
+                                                       const CommitID snapshot_commit_id) const {
+  auto versions = VersionList{};
+  {
+    auto lock = std::shared_lock{_mutex};
+    versions.reserve(_newest_versions.size());
+    for (const auto& [chunk_offset, newest_version] : _newest_versions) {
+      for (auto version = newest_version; version; version = version->previous) {
+        const auto begin_cid = version->begin_cid.load();
+        const auto is_own_version = begin_cid == MvccData::MAX_COMMIT_ID &&
+                                    transaction_id != INVALID_TRANSACTION_ID &&
+                                    version->transaction_id == transaction_id;
+        if (begin_cid <= snapshot_commit_id || is_own_version) {
+          versions.emplace_back(chunk_offset, version);
+          break;
+        }
+      }
+    }
+  }
+
+  std::sort(versions.begin(), versions.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  return versions;
+}
+
+RowVersions::VersionList RowVersions::mergeable_versions(const CommitID commit_id) const {
+  auto versions = VersionList{};
+  {
+    auto lock = std::shared_lock{_mutex};
+    for (const auto& [chunk_offset, newest_version] : _newest_versions) {
+      for (auto version = newest_version; version; version = version->previous) {
+        if (version->begin_cid.load() > commit_id) continue;
+
+        if (!_merged_version_set.count(version.get())) {
+          versions.emplace_back(chunk_offset, version);
+        }
+        break;
+      }
+    }
+  }
+
+  std::sort(versions.begin(), versions.end(), [](const auto& lhs, const auto& rhs) { return lhs.first < rhs.first; });
+  return versions;
+}
+
+void RowVersions::mark_merged(const VersionList& versions, const CommitID merge_commit_id) {
+  auto lock = std::unique_lock{_mutex};
+  for (const auto& [chunk_offset, version] : versions) {
+    _merged_versions.emplace_back(chunk_offset, version, merge_commit_id);
+    _merged_version_set.emplace(version.get());
+  }
+}
+
+void RowVersions::remove_merged_versions(const std::optional<CommitID>& lowest_active_snapshot_commit_id) {
+  auto lock = std::unique_lock{_mutex};
+  const auto is_removable = [&](const auto& merged_version) {
+    return !lowest_active_snapshot_commit_id || std::get<2>(merged_version) < *lowest_active_snapshot_commit_id;
+  };
+
+  for (const auto& merged_version : _merged_versions) {
+    if (!is_removable(merged_version)) continue;
+
+    const auto& [chunk_offset, version, merge_commit_id] = merged_version;
+    _merged_version_set.erase(version.get());
+
+    // The version might already have been removed along with a newer merged version.
+    const auto iter = _newest_versions.find(chunk_offset);
+    if (iter == _newest_versions.end()) continue;
+
+    if (iter->second == version) {
+      _newest_versions.erase(iter);
+      continue;
+    }
+
+    for (auto newer_version = iter->second.get(); newer_version; newer_version = newer_version->previous.get()) {
+      if (newer_version->previous == version) {
+        newer_version->previous = nullptr;
+        break;
+      }
+    }
+  }
+
+  _merged_versions.erase(std::remove_if(_merged_versions.begin(), _merged_versions.end(), is_removable),
+                         _merged_versions.end());
+}
+
+size_t RowVersions::row_count() const {
+  auto lock = std::shared_lock{_mutex};
+  return _newest_versions.size();
+}
+
+bool RowVersions::try_retire() {
+  auto lock = std::unique_lock{_mutex};
+  if (!_newest_versions.empty() || !_merged_versions.empty()) return false;
+
+  _is_retired = true;
+  return true;
+}
+
+bool RowVersions::is_retired() const {
+  auto lock = std::shared_lock{_mutex};
+  return _is_retired;
+}
+
+size_t RowVersions::memory_usage() const {
+  auto lock = std::shared_lock{_mutex};
+  auto bytes = sizeof(*this);
+  for (const auto& [chunk_offset, newest_version] : _newest_versions) {
+    bytes += sizeof(chunk_offset) + sizeof(newest_version);
+    for (auto version = newest_version.get(); version; version = version->previous.get()) {
+      bytes += sizeof(RowVersion) + version->values.capacity() * sizeof(std::pair<ColumnID, AllTypeVariant>);
+    }
+  }
+  bytes += _merged_versions.capacity() * sizeof(decltype(_merged_versions)::value_type);
+  return bytes;
+}
+
+std::vector<ColumnID> RowVersions::changed_column_ids(const VersionList& versions) {
+  auto column_ids = std::vector<ColumnID>{};
+  for (const auto& [chunk_offset, version] : versions) {
+    for (const auto& [column_id, value] : version->values) {
+      column_ids.emplace_back(column_id);
+    }
+  }
+
+  std::sort(column_ids.begin(), column_ids.end());
+  column_ids.erase(std::unique(column_ids.begin(), column_ids.end()), column_ids.end());
+  return column_ids;
+}
+
+std::shared_ptr<AbstractSegment> apply_row_versions(const AbstractSegment& segment, const ColumnID column_id,
+                                                    const bool nullable, const RowVersions::VersionList& versions) {
+  auto result = std::shared_ptr<AbstractSegment>{};
+
+  resolve_data_type(segment.data_type(), [&](const auto data_type_t) {
+    using ColumnDataType = typename decltype(data_type_t)::type;
+
+    const auto size = segment.size();
+    auto values = pmr_vector<ColumnDataType>(size);
+    auto null_values = pmr_vector<bool>(nullable ? size : 0);
+    segment_iterate<ColumnDataType>(segment, [&](const auto& position) {
+      if (position.is_null()) {
+        DebugAssert(nullable, "Unexpected NULL value in non-nullable segment");
+        null_values[position.chunk_offset()] = true;
+      } else {
+        values[position.chunk_offset()] = position.value();
+      }
+    });
+
+    for (const auto& [chunk_offset, version] : versions) {
+      // Versions of rows that were appended after the segment was copied are not relevant.
+      if (chunk_offset >= size) break;
+
+      const auto value_iter = std::lower_bound(
+          version->values.begin(), version->values.end(), column_id,
+          [](const auto& column_id_and_value, const auto search_id) { return column_id_and_value.first < search_id; });
+      if (value_iter == version->values.end() || value_iter->first != column_id) continue;
+
+      if (variant_is_null(value_iter->second)) {
+        Assert(nullable, "Cannot store NULL value in non-nullable segment");
+        null_values[chunk_offset] = true;
+      } else {
+        values[chunk_offset] = boost::get<ColumnDataType>(value_iter->second);
+        if (nullable) null_values[chunk_offset] = false;
+      }
+    }
+
+    if (nullable) {
+      result = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values), std::move(null_values));
+    } else {
+      result = std::make_shared<ValueSegment<ColumnDataType>>(std::move(values));
+    }
+  });
+
+  return result;
+}
+
+std::shared_ptr<Chunk> resolve_row_versions(const std::shared_ptr<Chunk>& chunk, const Table& stored_table,
+                                            const std::vector<ColumnID>& stored_column_ids,
+                                            const TransactionID transaction_id, const CommitID snapshot_commit_id) {
+  DebugAssert(stored_column_ids.size() == chunk->column_count(), "Expected one stored ColumnID per column");
+
+  const auto mvcc_data = chunk->mvcc_data();
+  if (!mvcc_data) return chunk;
+
+  const auto row_versions = mvcc_data->row_versions();
+  if (!row_versions) return chunk;
+
+  // The versions are retrieved before the segments. If the versions have been merged in the meantime, the segments
+  // already contain their values (see RowVersions::mark_merged).
+  const auto versions = row_versions->visible_versions(transaction_id, snapshot_commit_id);
+  if (versions.empty()) return chunk;
+
+  const auto changed_column_ids = RowVersions::changed_column_ids(versions);
+  const auto column_count = chunk->column_count();
+
+  auto segments = Segments(column_count);
+  auto indexes = Indexes{};
+  for (auto column_id = ColumnID{0}; column_id < column_count; ++column_id) {
+    const auto stored_column_id = stored_column_ids[column_id];
+    const auto segment = chunk->get_segment(column_id);
+
+    if (std::binary_search(changed_column_ids.begin(), changed_column_ids.end(), stored_column_id)) {
+      segments[column_id] = apply_row_versions(*segment, stored_column_id,
+                                               stored_table.column_is_nullable(stored_column_id), versions);
+      continue;
+    }
+
+    segments[column_id] = segment;
+    const auto segment_indexes = chunk->get_indexes({segment});
+    indexes.insert(indexes.end(), segment_indexes.begin(), segment_indexes.end());
+  }
+
+  const auto resolved_chunk =
+      std::make_shared<Chunk>(std::move(segments), mvcc_data, chunk->get_allocator(), std::move(indexes));
+  if (!chunk->is_mutable()) {
+    // The Update operator does not update columns that chunks are sorted by in place.
+    resolved_chunk->finalize();
+    if (!chunk->individually_sorted_by().empty()) {
+      resolved_chunk->set_individually_sorted_by(chunk->individually_sorted_by());
+    }
+  }
+  resolved_chunk->increase_invalid_row_count(chunk->invalid_row_count());
+
+  return resolved_chunk;
+}
+
+size_t merge_row_versions(Table& table, const ChunkID chunk_id) {
+  const auto chunk = table.get_chunk(chunk_id);
+  Assert(chunk && !chunk->is_mutable(), "Can only merge the row versions of immutable chunks");
+
+  const auto& mvcc_data = chunk->mvcc_data();
+  const auto row_versions = mvcc_data ? mvcc_data->row_versions() : nullptr;
+  if (!row_versions) return 0;
+
+  // Segments of foreign tables are loaded from their file, so they cannot be replaced.
+  if (std::dynamic_pointer_cast<const ForeignSegment>(chunk->get_segment(ColumnID{0}))) return 0;
+
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  const auto lowest_active_snapshot_commit_id = transaction_manager.get_lowest_active_snapshot_commit_id();
+  row_versions->remove_merged_versions(lowest_active_snapshot_commit_id);
+
+  if (row_versions->try_retire()) {
+    // Clear the caches before GetTable prunes the chunk again, so that no plan pruned with outdated statistics is used.
+    if (const auto& pqp_cache = Hyrise::get().default_pqp_cache) pqp_cache->clear();
+    if (const auto& lqp_cache = Hyrise::get().default_lqp_cache) lqp_cache->clear();
+    mvcc_data->reset_row_versions(row_versions);
+    return 0;
+  }
+
+  // Versions up to this commit id are visible to all current and future transactions (unless they are superseded by
+  // newer versions, which are kept).
+  const auto merge_threshold =
+      lowest_active_snapshot_commit_id ? *lowest_active_snapshot_commit_id : transaction_manager.last_commit_id();
+  const auto versions = row_versions->mergeable_versions(merge_threshold);
+  if (versions.empty()) return 0;
+
+  for (const auto column_id : RowVersions::changed_column_ids(versions)) {
+    const auto segment = chunk->get_segment(column_id);
+    const auto merged_segment =
+        apply_row_versions(*segment, column_id, table.column_is_nullable(column_id), versions);
+    chunk->replace_segment(column_id, ChunkEncoder::encode_segment(merged_segment, table.column_data_type(column_id),
+                                                                   get_segment_encoding_spec(segment)));
+  }
+
+  // The pruning statistics are not regenerated if they exist.
+  chunk->set_pruning_statistics(std::nullopt);
+  generate_chunk_pruning_statistics(chunk);
+
+  // Transactions that start after this point read the merged segments.
+  row_versions->mark_merged(versions, transaction_manager.last_commit_id());
+
+  return versions.size();
+}
+
+}  // namespace opossum
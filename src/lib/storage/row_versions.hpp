@@ -0,0 +1,131 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <optional>
+#include <shared_mutex>
+#include <tuple>
+#include <unordered_map>
+#include <unordered_set>
+#include <utility>
+#include <vector>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class AbstractSegment;
+class Chunk;
+class Table;
+
+/**
+ * A version of a row that was updated in place by the Update operator. Instead of invalidating the row and inserting a
+ * complete copy of it, only the values of the changed columns are stored. The row in the main segments stays valid and
+ * keeps its RowID.
+ */
+struct RowVersion : private Noncopyable {
+  RowVersion(const TransactionID init_transaction_id, std::vector<std::pair<ColumnID, AllTypeVariant>> init_values);
+
+  // Commit id of the updating transaction, MvccData::MAX_COMMIT_ID until the transaction has committed
+  std::atomic<CommitID> begin_cid;
+
+  // INVALID_TRANSACTION_ID for versions restored from the write-ahead log
+  const TransactionID transaction_id;
+
+  // Values of all columns that differ from the main segments, sorted by ColumnID. This includes the columns changed by
+  // older versions, so that readers only need the newest version that is visible to them.
+  const std::vector<std::pair<ColumnID, AllTypeVariant>> values;
+
+  // The next older version of the row. Protected by the mutex of the RowVersions that the version belongs to.
+  std::shared_ptr<RowVersion> previous;
+};
+
+/**
+ * Stores the version chains of the rows of a chunk that were updated in place, starting with the newest version of
+ * each row. Only rows with versions are stored, so that chunks with few updated rows need little memory. All methods
+ * are thread-safe.
+ *
+ * The versions are written by the Update operator. GetTable resolves them (see resolve_row_versions): It replaces the
+ * segments of the changed columns with ValueSegments that contain the values visible to its transaction. Thus, all
+ * following operators see the visible values, including predicates that were placed below the Validate operator. As
+ * this costs time for every query, merge_row_versions folds versions that are visible to all transactions back into
+ * the main segments.
+ */
+class RowVersions : private Noncopyable {
+ public:
+  // Pairs of a row and one of its versions, sorted by the ChunkOffset of the row
+  using VersionList = std::vector<std::pair<ChunkOffset, std::shared_ptr<const RowVersion>>>;
+
+  // Returns the newest version of the row, nullptr if the row was not updated in place.
+  std::shared_ptr<RowVersion> newest_version(const ChunkOffset chunk_offset) const;
+
+  // Adds `version` as the newest version of the row if `expected_newest_version` is still its newest version, i.e., if
+  // no other transaction has added a version in the meantime, and the versions have not been retired. Returns whether
+  // the version was added.
+  bool add_version(const ChunkOffset chunk_offset, const std::shared_ptr<RowVersion>& expected_newest_version,
+                   const std::shared_ptr<RowVersion>& version);
+
+  // Removes the uncommitted version, which has to be the newest version of the row. Used for rollbacks.
+  void remove_version(const ChunkOffset chunk_offset, const std::shared_ptr<RowVersion>& version);
+
+  // Returns the newest version of each row that is visible to the given transaction. A version is visible if it was
+  // committed at or before the snapshot commit id or if it was written by the transaction itself.
+  VersionList visible_versions(const TransactionID transaction_id, const CommitID snapshot_commit_id) const;
+
+  // Returns the newest version of each row that was committed at or before the given commit id, unless that version
+  // has already been merged into the main segments (see merge_row_versions).
+  VersionList mergeable_versions(const CommitID commit_id) const;
+
+  // Marks versions as merged into the main segments. Transactions that read the segments before they were replaced
+  // may still need the versions. Thus, remove_merged_versions only removes them (and their older versions) once no
+  // transaction with a snapshot commit id of `merge_commit_id` or lower is active anymore.
+  void mark_merged(const VersionList& versions, const CommitID merge_commit_id);
+  void remove_merged_versions(const std::optional<CommitID>& lowest_active_snapshot_commit_id);
+
+  // Number of rows with versions
+  size_t row_count() const;
+
+  // Once all versions have been merged and removed, merge_row_versions retires the RowVersions and removes them from
+  // the MvccData. Returns false and leaves the versions unchanged if there are versions left. Afterwards, add_version
+  // fails, so that an Update that still holds the RowVersions adds its version to new ones.
+  bool try_retire();
+  bool is_retired() const;
+
+  size_t memory_usage() const;
+
+  // Returns the sorted ids of the columns that have values in at least one of the versions.
+  static std::vector<ColumnID> changed_column_ids(const VersionList& versions);
+
+ private:
+  mutable std::shared_mutex _mutex;
+  std::unordered_map<ChunkOffset, std::shared_ptr<RowVersion>> _newest_versions;
+
+  // Versions that were merged into the main segments, with the commit id at which they were merged
+  std::vector<std::tuple<ChunkOffset, std::shared_ptr<const RowVersion>, CommitID>> _merged_versions;
+  std::unordered_set<const RowVersion*> _merged_version_set;
+
+  bool _is_retired{false};
+};
+
+// Returns a ValueSegment with the values of `segment`, in which the values of the rows that have a value for the
+// column `column_id` in `versions` are replaced.
+std::shared_ptr<AbstractSegment> apply_row_versions(const AbstractSegment& segment, const ColumnID column_id,
+                                                    const bool nullable, const RowVersions::VersionList& versions);
+
+// Returns `chunk` itself or, if it has versions that are visible to the transaction, a copy of it in which the
+// segments of the changed columns are replaced (see apply_row_versions). The copy shares the MVCC data and all
+// other segments with `chunk`. As GetTable may prune columns, `stored_column_ids` maps the columns of `chunk` to those
+// of `stored_table`, which the versions refer to.
+std::shared_ptr<Chunk> resolve_row_versions(const std::shared_ptr<Chunk>& chunk, const Table& stored_table,
+                                            const std::vector<ColumnID>& stored_column_ids,
+                                            const TransactionID transaction_id, const CommitID snapshot_commit_id);
+
+// Folds the versions of an immutable chunk that are visible to all current and future transactions into its main
+// segments, which are encoded like the segments they replace, and regenerates the pruning statistics of the chunk.
+// Once no versions are left, they are removed from the MvccData so that GetTable prunes the chunk again. Plans cached
+// before that might have been pruned using the statistics from before the update, so the default plan caches are
+// cleared. Returns the number of merged rows. Must not run concurrently with the encoding of the same chunk.
+size_t merge_row_versions(Table& table, const ChunkID chunk_id);
+
+}  // namespace opossum
@@ -66,6 +66,8 @@ VectorCompressionType parent_vector_compression_type(const CompressedVectorType
       break;
     case CompressedVectorType::SimdBp128:
       return VectorCompressionType::SimdBp128;
+    case CompressedVectorType::BitPacking:
+      return VectorCompressionType::BitPacking;
   }
   Fail("Invalid enum value");
 }
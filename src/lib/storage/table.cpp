@@ -5,6 +5,7 @@
 #include <memory>
 #include <numeric>
 #include <string>
+#include <unordered_set>
 #include <utility>
 #include <vector>
 
@@ -13,6 +14,7 @@
 #include "statistics/attribute_statistics.hpp"
 #include "statistics/table_statistics.hpp"
 #include "storage/segment_iterate.hpp"
+#include "storage/table_key_index.hpp"
 #include "types.hpp"
 #include "utils/assert.hpp"
 #include "value_segment.hpp"
@@ -354,6 +356,26 @@ void Table::add_soft_key_constraint(const TableKeyConstraint& table_key_constrai
   }
 }
 
+void Table::create_key_index(const std::vector<ColumnID>& column_ids) {
+  Assert(_type == TableType::Data, "Key indexes can only be created for data tables");
+
+  const auto column_set = std::unordered_set<ColumnID>{column_ids.begin(), column_ids.end()};
+  Assert(column_set.size() == column_ids.size(), "Duplicate column in key index");
+  Assert(std::any_of(_table_key_constraints.begin(), _table_key_constraints.end(),
+                     [&](const auto& key_constraint) { return key_constraint.columns() == column_set; }),
+         "Key indexes can only be created for the columns of a key constraint");
+
+  auto key_index = std::make_shared<TableKeyIndex>(*this, column_ids);
+
+  const auto scoped_lock = acquire_append_mutex();
+  Assert(std::none_of(_key_indexes.begin(), _key_indexes.end(),
+                      [&](const auto& existing_key_index) { return existing_key_index->column_ids() == column_ids; }),
+         "Key index already exists");
+  _key_indexes.emplace_back(std::move(key_index));
+}
+
+const std::vector<std::shared_ptr<TableKeyIndex>>& Table::key_indexes() const { return _key_indexes; }
+
 const std::vector<ColumnID>& Table::value_clustered_by() const { return _value_clustered_by; }
 
 void Table::set_value_clustered_by(const std::vector<ColumnID>& value_clustered_by) {
@@ -410,6 +432,10 @@ size_t Table::memory_usage(const MemoryUsageCalculationMode mode) const {
     bytes += column_definition.name.size();
   }
 
+  for (const auto& key_index : _key_indexes) {
+    bytes += key_index->memory_usage();
+  }
+
   // TODO(anybody) Statistics and Indexes missing from Memory Usage Estimation
   // TODO(anybody) TableLayout missing
 
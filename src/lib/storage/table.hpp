@@ -19,6 +19,7 @@
 
 namespace opossum {
 
+class TableKeyIndex;
 class TableStatistics;
 
 /**
@@ -204,6 +205,14 @@ class Table : private Noncopyable {
   void add_soft_key_constraint(const TableKeyConstraint& table_key_constraint);
   const TableKeyConstraints& soft_key_constraints() const;
 
+  /**
+   * Creates a TableKeyIndex for a PRIMARY KEY or UNIQUE key constraint that was added before. The order of column_ids
+   * determines the order of the values in lookups. All existing rows are indexed. Afterwards, rows are added to the
+   * index by the Insert operator, but not by Table::append. Must not be called concurrently to inserts.
+   */
+  void create_key_index(const std::vector<ColumnID>& column_ids);
+  const std::vector<std::shared_ptr<TableKeyIndex>>& key_indexes() const;
+
   /**
    * For debugging purposes, makes an estimation about the memory used by this Table (including Chunk and Segments)
    */
@@ -240,6 +249,7 @@ class Table : private Noncopyable {
   tbb::concurrent_vector<std::shared_ptr<Chunk>, tbb::zero_allocator<std::shared_ptr<Chunk>>> _chunks;
 
   TableKeyConstraints _table_key_constraints;
+  std::vector<std::shared_ptr<TableKeyIndex>> _key_indexes;
 
   std::vector<ColumnID> _value_clustered_by;
   std::shared_ptr<TableStatistics> _table_statistics;
@@ -0,0 +1,201 @@
+#include "table_key_index.hpp"
+
+#include <algorithm>
+#include <mutex>
+#include <optional>
+
+#include <boost/container_hash/hash.hpp>
+
+#include "hyrise.hpp"
+#include "lossless_cast.hpp"
+#include "resolve_type.hpp"
+#include "storage/segment_iterate.hpp"
+#include "storage/table.hpp"
+#include "utils/assert.hpp"
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+// Row versions whose end_cid is lower than or equal to the returned CommitID are invisible to all current and future
+// transactions.
+CommitID get_visibility_threshold() {
+  const auto& transaction_manager = Hyrise::get().transaction_manager;
+  const auto lowest_active_snapshot_commit_id = transaction_manager.get_lowest_active_snapshot_commit_id();
+  return lowest_active_snapshot_commit_id ? *lowest_active_snapshot_commit_id : transaction_manager.last_commit_id();
+}
+
+}  // namespace
+
+namespace opossum {
+
+TableKeyIndex::TableKeyIndex(const Table& table, const std::vector<ColumnID>& column_ids)
+    : _table(table), _column_ids(column_ids) {
+  Assert(!_column_ids.empty(), "Key index requires at least one column");
+
+  _data_types.reserve(_column_ids.size());
+  for (const auto column_id : _column_ids) {
+    Assert(column_id < _table.column_count(), "ColumnID out of range");
+    _data_types.emplace_back(_table.column_data_type(column_id));
+  }
+
+  const auto chunk_count = _table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto chunk = _table.get_chunk(chunk_id);
+    if (!chunk) continue;
+
+    insert(chunk_id, ChunkOffset{0}, chunk->size());
+  }
+}
+
+const std::vector<ColumnID>& TableKeyIndex::column_ids() const { return _column_ids; }
+
+void TableKeyIndex::insert(const ChunkID chunk_id, const ChunkOffset begin_chunk_offset,
+                           const ChunkOffset end_chunk_offset) {
+  const auto chunk = _table.get_chunk(chunk_id);
+  Assert(chunk, "Cannot index rows of a physically deleted chunk");
+
+  auto hashes = std::vector<size_t>(end_chunk_offset - begin_chunk_offset);
+  auto is_null = std::vector<bool>(end_chunk_offset - begin_chunk_offset);
+  _hash_rows(*chunk, begin_chunk_offset, end_chunk_offset, hashes, is_null);
+
+  // Only determined if a key already has entries, as this requires looking at the active transactions.
+  auto visibility_threshold = std::optional<CommitID>{};
+
+  for (auto chunk_offset = begin_chunk_offset; chunk_offset < end_chunk_offset; ++chunk_offset) {
+    const auto row_idx = chunk_offset - begin_chunk_offset;
+    if (is_null[row_idx]) continue;
+
+    const auto hash = hashes[row_idx];
+    auto& shard = _shard(hash);
+    const auto lock = std::unique_lock<std::shared_mutex>{shard.mutex};
+
+    auto& row_ids = shard.row_ids_by_hash[hash];
+    if (!row_ids.empty()) {
+      if (!visibility_threshold) visibility_threshold = get_visibility_threshold();
+      _remove_invisible_rows(row_ids, *visibility_threshold);
+    }
+    row_ids.emplace_back(RowID{chunk_id, chunk_offset});
+  }
+}
+
+std::vector<RowID> TableKeyIndex::lookup(const std::vector<AllTypeVariant>& key) const {
+  Assert(key.size() == _column_ids.size(), "Key does not match the columns of the key index");
+
+  // Cast the key to the data types of the columns and calculate its hash the same way as _hash_rows does.
+  auto typed_key = std::vector<AllTypeVariant>(key.size());
+  auto hash = size_t{0};
+  for (auto key_idx = size_t{0}; key_idx < key.size(); ++key_idx) {
+    if (variant_is_null(key[key_idx])) return {};
+
+    auto castable = true;
+    resolve_data_type(_data_types[key_idx], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      const auto value = lossless_variant_cast<ColumnDataType>(key[key_idx]);
+      if (!value) {
+        castable = false;
+        return;
+      }
+
+      boost::hash_combine(hash, *value);
+      typed_key[key_idx] = *value;
+    });
+    if (!castable) return {};
+  }
+
+  auto candidates = RowIDs{};
+  {
+    const auto& shard = _shard(hash);
+    const auto lock = std::shared_lock<std::shared_mutex>{shard.mutex};
+
+    const auto iter = shard.row_ids_by_hash.find(hash);
+    if (iter == shard.row_ids_by_hash.end()) return {};
+    candidates = iter->second;
+  }
+
+  // Discard hash collisions
+  auto row_ids = std::vector<RowID>{};
+  row_ids.reserve(candidates.size());
+  for (const auto& row_id : candidates) {
+    const auto chunk = _table.get_chunk(row_id.chunk_id);
+    if (!chunk) continue;
+
+    auto matches = true;
+    for (auto key_idx = size_t{0}; key_idx < _column_ids.size() && matches; ++key_idx) {
+      matches = (*chunk->get_segment(_column_ids[key_idx]))[row_id.chunk_offset] == typed_key[key_idx];
+    }
+    if (matches) row_ids.emplace_back(row_id);
+  }
+
+  std::sort(row_ids.begin(), row_ids.end());
+  return row_ids;
+}
+
+size_t TableKeyIndex::row_count() const {
+  auto row_count = size_t{0};
+  for (const auto& shard : _shards) {
+    const auto lock = std::shared_lock<std::shared_mutex>{shard.mutex};
+    for (const auto& [hash, row_ids] : shard.row_ids_by_hash) {
+      row_count += row_ids.size();
+    }
+  }
+  return row_count;
+}
+
+size_t TableKeyIndex::memory_usage() const {
+  auto bytes = sizeof(*this) + _column_ids.capacity() * sizeof(ColumnID) + _data_types.capacity() * sizeof(DataType);
+  for (const auto& shard : _shards) {
+    const auto lock = std::shared_lock<std::shared_mutex>{shard.mutex};
+    bytes += shard.row_ids_by_hash.bucket_count() * sizeof(void*);
+    // Each entry is stored in a node that also holds a pointer to the next node.
+    bytes += shard.row_ids_by_hash.size() * (sizeof(std::pair<const size_t, RowIDs>) + sizeof(void*));
+    for (const auto& [hash, row_ids] : shard.row_ids_by_hash) {
+      if (row_ids.capacity() > 1) bytes += row_ids.capacity() * sizeof(RowID);
+    }
+  }
+  return bytes;
+}
+
+void TableKeyIndex::_hash_rows(const Chunk& chunk, const ChunkOffset begin_chunk_offset,
+                               const ChunkOffset end_chunk_offset, std::vector<size_t>& hashes,
+                               std::vector<bool>& is_null) const {
+  for (auto key_idx = size_t{0}; key_idx < _column_ids.size(); ++key_idx) {
+    const auto segment = chunk.get_segment(_column_ids[key_idx]);
+    DebugAssert(segment->size() >= end_chunk_offset, "Segment out-of-bounds");
+
+    resolve_data_type(_data_types[key_idx], [&](const auto data_type_t) {
+      using ColumnDataType = typename decltype(data_type_t)::type;
+
+      segment_with_iterators<ColumnDataType>(*segment, [&](const auto begin, const auto /* end */) {
+        auto iter = begin + begin_chunk_offset;
+        for (auto row_idx = size_t{0}; row_idx < hashes.size(); ++row_idx, ++iter) {
+          const auto position = *iter;
+          if (position.is_null()) {
+            is_null[row_idx] = true;
+          } else {
+            boost::hash_combine(hashes[row_idx], position.value());
+          }
+        }
+      });
+    });
+  }
+}
+
+void TableKeyIndex::_remove_invisible_rows(RowIDs& row_ids, const CommitID visibility_threshold) const {
+  const auto is_invisible = [&](const RowID& row_id) {
+    const auto chunk = _table.get_chunk(row_id.chunk_id);
+    if (!chunk) return true;
+
+    const auto mvcc_data = chunk->mvcc_data();
+    return mvcc_data && mvcc_data->get_end_cid(row_id.chunk_offset) <= visibility_threshold;
+  };
+
+  row_ids.erase(std::remove_if(row_ids.begin(), row_ids.end(), is_invisible), row_ids.end());
+}
+
+TableKeyIndex::Shard& TableKeyIndex::_shard(const size_t hash) { return _shards[hash % SHARD_COUNT]; }
+
+const TableKeyIndex::Shard& TableKeyIndex::_shard(const size_t hash) const { return _shards[hash % SHARD_COUNT]; }
+
+}  // namespace opossum
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <array>
+#include <shared_mutex>
+#include <unordered_map>
+#include <vector>
+
+#include <boost/container/small_vector.hpp>
+
+#include "all_type_variant.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class Chunk;
+class Table;
+
+/**
+ * Table-wide hash index that maps the values of a PRIMARY KEY or UNIQUE key constraint to the RowIDs of the rows with
+ * these values. In contrast to the chunk indexes in storage/index, it covers all chunks including the mutable ones
+ * and is maintained by the Insert operator. It is created with Table::create_key_index and used by KeyIndexLookup
+ * (see KeyIndexLookupRule) to answer equality predicates on the key without scanning the table.
+ *
+ * The index is MVCC-agnostic: As updates are executed as a delete and an insert, a key can map to multiple versions of
+ * a row, including uncommitted and rolled back ones. Lookups return all of them, and the visible version is determined
+ * by the Validate operator. When a row is added for a key that already has entries, entries of rows that are no
+ * longer visible to any transaction are removed.
+ *
+ * Only hashes of the keys are stored. Lookups compare the values of the candidate rows with the requested key, so that
+ * hash collisions do not lead to wrong results. Rows with a NULL value in one of the key columns are not indexed, as
+ * NULL is never equal to any value.
+ *
+ * Key constraints are not enforced, so the index also handles duplicate keys. All methods are thread-safe.
+ */
+class TableKeyIndex : private Noncopyable {
+ public:
+  // Creates the index and adds all existing rows of the table.
+  TableKeyIndex(const Table& table, const std::vector<ColumnID>& column_ids);
+
+  const std::vector<ColumnID>& column_ids() const;
+
+  // Adds the rows [begin_chunk_offset, end_chunk_offset) of the given chunk. Their values must have been written.
+  void insert(const ChunkID chunk_id, const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset);
+
+  // Returns the sorted RowIDs of all row versions with the given key. The values are given in the order of
+  // column_ids() and are cast to the column's data type. If that is not possible without loss, nothing can match.
+  std::vector<RowID> lookup(const std::vector<AllTypeVariant>& key) const;
+
+  // Number of indexed row versions
+  size_t row_count() const;
+
+  size_t memory_usage() const;
+
+ protected:
+  static constexpr auto SHARD_COUNT = size_t{32};
+
+  using RowIDs = boost::container::small_vector<RowID, 1>;
+
+  struct Shard {
+    mutable std::shared_mutex mutex;
+    std::unordered_map<size_t, RowIDs> row_ids_by_hash;
+  };
+
+  // Calculates the key hashes of the given rows. Rows with NULL values are marked in is_null.
+  void _hash_rows(const Chunk& chunk, const ChunkOffset begin_chunk_offset, const ChunkOffset end_chunk_offset,
+                  std::vector<size_t>& hashes, std::vector<bool>& is_null) const;
+
+  // Removes row versions that no transaction can see anymore from the given list.
+  void _remove_invisible_rows(RowIDs& row_ids, const CommitID visibility_threshold) const;
+
+  Shard& _shard(const size_t hash);
+  const Shard& _shard(const size_t hash) const;
+
+  const Table& _table;
+  const std::vector<ColumnID> _column_ids;
+  std::vector<DataType> _data_types;
+
+  std::array<Shard, SHARD_COUNT> _shards;
+};
+
+}  // namespace opossum
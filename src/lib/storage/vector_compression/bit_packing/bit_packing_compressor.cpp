@@ -0,0 +1,56 @@
+#include "bit_packing_compressor.hpp"
+
+#include <algorithm>
+
+#include "bit_packing_vector.hpp"
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+std::unique_ptr<const BaseCompressedVector> BitPackingCompressor::compress(const pmr_vector<uint32_t>& vector,
+                                                                           const PolymorphicAllocator<size_t>& alloc,
+                                                                           const UncompressedVectorInfo& meta_info) {
+  constexpr auto LANE_COUNT = BitPackingDecompressor::LANE_COUNT;
+  constexpr auto BLOCK_SIZE = BitPackingDecompressor::BLOCK_SIZE;
+
+  auto max_value = uint32_t{0};
+  if (meta_info.max_value) {
+    max_value = *meta_info.max_value;
+  } else if (!vector.empty()) {
+    max_value = *std::max_element(vector.cbegin(), vector.cend());
+  }
+
+  // Even a vector of zeros uses one bit per value so that every value has a position.
+  auto bit_width = uint32_t{1};
+  while (bit_width < 32 && (max_value >> bit_width) != 0) {
+    ++bit_width;
+  }
+
+  const auto block_count = (vector.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  auto data = pmr_vector<uint32_t>(block_count * bit_width * LANE_COUNT, 0u, alloc);
+
+  for (auto index = size_t{0}; index < vector.size(); ++index) {
+    const auto value = vector[index];
+    DebugAssert(bit_width == 32 || (value >> bit_width) == 0, "Value exceeds the maximum value of the vector");
+
+    const auto index_in_block = index % BLOCK_SIZE;
+    const auto first_bit = (index_in_block / LANE_COUNT) * bit_width;
+    const auto word_index = first_bit / 32;
+    const auto shift = first_bit % 32;
+    auto* const lane_words = data.data() + (index / BLOCK_SIZE) * bit_width * LANE_COUNT + index_in_block % LANE_COUNT;
+
+    lane_words[word_index * LANE_COUNT] |= value << shift;
+    if (shift + bit_width > 32) {
+      lane_words[(word_index + 1) * LANE_COUNT] |= value >> (32 - shift);
+    }
+  }
+
+  return std::make_unique<BitPackingVector>(std::move(data), static_cast<uint8_t>(bit_width), vector.size());
+}
+
+std::unique_ptr<BaseVectorCompressor> BitPackingCompressor::create_new() const {
+  return std::make_unique<BitPackingCompressor>();
+}
+
+}  // namespace opossum
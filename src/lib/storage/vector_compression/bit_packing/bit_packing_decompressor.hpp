@@ -0,0 +1,75 @@
+#pragma once
+
+#include <cstdint>
+
+#include "storage/vector_compression/base_vector_decompressor.hpp"
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * @brief Implements point-access into a bit-packed vector
+ *
+ * As all values have the same bit width, the position of a value can be calculated directly. The decompressor does not
+ * need to cache anything and accesses are equally fast in any order.
+ *
+ * @see BitPackingVector for the layout
+ */
+class BitPackingDecompressor : public BaseVectorDecompressor {
+ public:
+  // Number of 32-bit lanes across which the values of a block are interleaved
+  static constexpr auto LANE_COUNT = size_t{8};
+
+  // Each lane of a block holds 32 values. Thus, a block occupies bit_width words of LANE_COUNT * 32 bit.
+  static constexpr auto BLOCK_SIZE = LANE_COUNT * 32;
+
+  BitPackingDecompressor(const pmr_vector<uint32_t>& data, const uint8_t bit_width, const size_t size)
+      : _data{&data},
+        _bit_width{bit_width},
+        _value_mask{static_cast<uint32_t>((uint64_t{1} << bit_width) - 1)},
+        _size{size} {}
+
+  BitPackingDecompressor(const BitPackingDecompressor&) = default;
+  BitPackingDecompressor(BitPackingDecompressor&&) = default;
+
+  // BaseVectorDecompressor is not assignable. As the decompressor only points to the data, it can be reassigned.
+  BitPackingDecompressor& operator=(const BitPackingDecompressor& other) {
+    _data = other._data;
+    _bit_width = other._bit_width;
+    _value_mask = other._value_mask;
+    _size = other._size;
+    return *this;
+  }
+  BitPackingDecompressor& operator=(BitPackingDecompressor&& other) noexcept { return *this = other; }
+
+  ~BitPackingDecompressor() override = default;
+
+  uint32_t get(size_t i) final {
+    const auto index_in_block = i % BLOCK_SIZE;
+    const auto first_bit = (index_in_block / LANE_COUNT) * _bit_width;
+    const auto word_index = first_bit / 32;
+    const auto shift = first_bit % 32;
+
+    // Words of the lane that holds the value
+    const auto* const lane_words =
+        _data->data() + (i / BLOCK_SIZE) * _bit_width * LANE_COUNT + index_in_block % LANE_COUNT;
+
+    auto value = lane_words[word_index * LANE_COUNT] >> shift;
+    if (shift + _bit_width > 32) {
+      // The value continues in the next word of the lane.
+      value |= lane_words[(word_index + 1) * LANE_COUNT] << (32 - shift);
+    }
+    return value & _value_mask;
+  }
+
+  size_t size() const final { return _size; }
+
+ private:
+  const pmr_vector<uint32_t>* _data;
+  uint8_t _bit_width;
+  uint32_t _value_mask;
+  size_t _size;
+};
+
+}  // namespace opossum
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "storage/vector_compression/base_compressed_vector.hpp"
+
+#include "bit_packing_decompressor.hpp"
+
+#include "types.hpp"
+
+namespace opossum {
+
+// Random-access iterator over a BitPackingVector. As the BitPackingDecompressor does not cache any blocks, copying and
+// advancing the iterator is cheap.
+class BitPackingIterator : public BaseCompressedVectorIterator<BitPackingIterator> {
+ public:
+  explicit BitPackingIterator(const BitPackingDecompressor& decompressor, const size_t absolute_index = 0u)
+      : _decompressor{decompressor}, _absolute_index{absolute_index} {}
+
+ private:
+  friend class boost::iterator_core_access;  // grants the boost::iterator_facade access to the private interface
+
+  void increment() { ++_absolute_index; }
+
+  void decrement() { --_absolute_index; }
+
+  void advance(std::ptrdiff_t n) { _absolute_index += n; }
+
+  bool equal(const BitPackingIterator& other) const { return _absolute_index == other._absolute_index; }
+
+  std::ptrdiff_t distance_to(const BitPackingIterator& other) const {
+    return static_cast<std::ptrdiff_t>(other._absolute_index) - static_cast<std::ptrdiff_t>(_absolute_index);
+  }
+
+  uint32_t dereference() const { return _decompressor.get(_absolute_index); }
+
+ private:
+  mutable BitPackingDecompressor _decompressor;
+  size_t _absolute_index;
+};
+
+}  // namespace opossum
@@ -0,0 +1,136 @@
+#include "bit_packing_vector.hpp"
+
+#if defined(__AVX512VL__) || defined(__AVX2__)
+#include <x86intrin.h>
+#endif
+
+#include <cstring>
+
+namespace {
+
+using namespace opossum;  // NOLINT
+
+constexpr auto LANE_COUNT = BitPackingDecompressor::LANE_COUNT;
+constexpr auto BLOCK_SIZE = BitPackingDecompressor::BLOCK_SIZE;
+constexpr auto BITMAP_WORDS_PER_BLOCK = BLOCK_SIZE / 64;
+
+// One word of a block, i.e., one 32-bit word per lane. GCC and clang compile operations on this type to 256-bit SIMD
+// instructions if the target supports them (we build with -march=native) and to narrower instructions otherwise.
+using Lanes = uint32_t __attribute__((vector_size(LANE_COUNT * sizeof(uint32_t))));
+static_assert(sizeof(Lanes) * 8 == 256, "The layout of BitPackingVector assumes 256-bit words");
+
+// Lanes are passed by reference, as passing SIMD types by value has a different ABI depending on the target.
+void load_lanes(Lanes& lanes, const uint32_t* const words) {
+  // The data is only guaranteed to be aligned to four bytes. Compilers turn this into an unaligned load.
+  std::memcpy(&lanes, words, sizeof(Lanes));
+}
+
+// Returns a mask that has bit i set if lane i of `values` lies in [begin, begin + count). As the subtraction wraps
+// around for values smaller than begin, a single unsigned comparison suffices.
+uint64_t match_lanes(const Lanes& values, const Lanes& begin, const Lanes& count) {
+#ifdef __AVX512VL__
+  const auto offsets = values - begin;
+  return _mm256_cmplt_epu32_mask(*reinterpret_cast<const __m256i*>(&offsets),
+                                 *reinterpret_cast<const __m256i*>(&count));
+#else
+  const auto matches = (values - begin) < count;
+#ifdef __AVX2__
+  return static_cast<uint32_t>(_mm256_movemask_ps(*reinterpret_cast<const __m256*>(&matches)));
+#else
+  auto mask = uint64_t{0};
+  for (auto lane = size_t{0}; lane < LANE_COUNT; ++lane) {
+    mask |= static_cast<uint64_t>(matches[lane] & 1) << lane;
+  }
+  return mask;
+#endif
+#endif
+}
+
+}  // namespace
+
+namespace opossum {
+
+BitPackingVector::BitPackingVector(pmr_vector<uint32_t> data, const uint8_t bit_width, const size_t size)
+    : _data{std::move(data)}, _bit_width{bit_width}, _size{size} {
+  DebugAssert(bit_width >= 1 && bit_width <= 32, "Invalid bit width");
+  DebugAssert(_data.size() == (size + BLOCK_SIZE - 1) / BLOCK_SIZE * bit_width * LANE_COUNT, "Unexpected data size");
+}
+
+const pmr_vector<uint32_t>& BitPackingVector::data() const { return _data; }
+
+uint8_t BitPackingVector::bit_width() const { return _bit_width; }
+
+void BitPackingVector::match_range(const uint32_t begin, const uint32_t end, std::vector<uint64_t>& bitmap) const {
+  const auto block_count = (_size + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  bitmap.assign(block_count * BITMAP_WORDS_PER_BLOCK, uint64_t{0});
+  if (begin >= end) {
+    bitmap.resize((_size + 63) / 64);
+    return;
+  }
+
+  const auto begin_lanes = Lanes{} + begin;
+  const auto count_lanes = Lanes{} + (end - begin);
+  const auto value_mask_lanes = Lanes{} + static_cast<uint32_t>((uint64_t{1} << _bit_width) - 1);
+  const auto bit_width = static_cast<uint32_t>(_bit_width);
+
+  for (auto block_index = size_t{0}; block_index < block_count; ++block_index) {
+    const auto* words = _data.data() + block_index * bit_width * LANE_COUNT;
+    auto* const bitmap_words = bitmap.data() + block_index * BITMAP_WORDS_PER_BLOCK;
+
+    // Each step unpacks the next value of all lanes, i.e., eight consecutive values of the block. The shifts are the
+    // same for all lanes.
+    auto word = Lanes{};
+    load_lanes(word, words);
+    auto shift = uint32_t{0};
+    for (auto step = size_t{0}; step < BLOCK_SIZE / LANE_COUNT; ++step) {
+      auto values = word >> shift;
+      if (shift + bit_width > 32) {
+        words += LANE_COUNT;
+        load_lanes(word, words);
+        values |= word << (32 - shift);
+      }
+      values &= value_mask_lanes;
+
+      bitmap_words[step / 8] |= match_lanes(values, begin_lanes, count_lanes) << ((step % 8) * LANE_COUNT);
+
+      shift += bit_width;
+      if (shift >= 32) {
+        shift -= 32;
+        // If the value ended exactly at the end of the word, the next value starts in the next word (if there is one).
+        if (shift == 0 && step + 1 < BLOCK_SIZE / LANE_COUNT) {
+          words += LANE_COUNT;
+          load_lanes(word, words);
+        }
+      }
+    }
+  }
+
+  // The padding of the last block might match as well.
+  bitmap.resize((_size + 63) / 64);
+  if (_size % 64 != 0) {
+    bitmap.back() &= (uint64_t{1} << (_size % 64)) - 1;
+  }
+}
+
+size_t BitPackingVector::on_size() const { return _size; }
+size_t BitPackingVector::on_data_size() const { return sizeof(uint32_t) * _data.size(); }
+
+std::unique_ptr<BaseVectorDecompressor> BitPackingVector::on_create_base_decompressor() const {
+  return std::make_unique<BitPackingDecompressor>(_data, _bit_width, _size);
+}
+
+BitPackingDecompressor BitPackingVector::on_create_decompressor() const {
+  return BitPackingDecompressor(_data, _bit_width, _size);
+}
+
+BitPackingIterator BitPackingVector::on_begin() const { return BitPackingIterator{on_create_decompressor(), 0u}; }
+
+BitPackingIterator BitPackingVector::on_end() const { return BitPackingIterator{on_create_decompressor(), _size}; }
+
+std::unique_ptr<const BaseCompressedVector> BitPackingVector::on_copy_using_allocator(
+    const PolymorphicAllocator<size_t>& alloc) const {
+  auto data_copy = pmr_vector<uint32_t>{_data, alloc};
+  return std::make_unique<BitPackingVector>(std::move(data_copy), _bit_width, _size);
+}
+
+}  // namespace opossum
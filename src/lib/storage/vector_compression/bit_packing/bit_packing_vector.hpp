@@ -0,0 +1,59 @@
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include "storage/vector_compression/base_compressed_vector.hpp"
+
+#include "bit_packing_decompressor.hpp"
+#include "bit_packing_iterator.hpp"
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * @brief Bit-packed vector with a fixed bit width
+ *
+ * All values are stored with the bit width of the largest value. The values are packed in blocks of 256 values, which
+ * are interleaved across eight 32-bit lanes: value i of a block is stored in lane i % 8. Within a lane, the values are
+ * packed consecutively, starting at the least significant bit. Values may span two words of a lane. Thus, a block
+ * occupies bit_width words of 256 bit. The last block is padded with zeros.
+ *
+ * In contrast to SIMD-BP128, whose bit width varies per block, the values can be accessed directly and a 256-bit SIMD
+ * register holds eight consecutive values after the same shift and mask operations. This allows match_range to
+ * evaluate predicates on the packed values without decompressing them one by one.
+ */
+class BitPackingVector : public CompressedVector<BitPackingVector> {
+ public:
+  BitPackingVector(pmr_vector<uint32_t> data, const uint8_t bit_width, const size_t size);
+  ~BitPackingVector() override = default;
+
+  const pmr_vector<uint32_t>& data() const;
+  uint8_t bit_width() const;
+
+  /**
+   * Sets the bits of all values v with begin <= v < end in the bitmap, which has one bit per value (bit i % 64 of word
+   * i / 64). The bitmap is resized to fit the vector. Predicates on value IDs such as =, <, >=, and BETWEEN are ranges
+   * of values. The values are compared in SIMD registers, using AVX-512 or AVX2 if available.
+   */
+  void match_range(const uint32_t begin, const uint32_t end, std::vector<uint64_t>& bitmap) const;
+
+  size_t on_size() const;
+  size_t on_data_size() const;
+
+  std::unique_ptr<BaseVectorDecompressor> on_create_base_decompressor() const;
+  BitPackingDecompressor on_create_decompressor() const;
+
+  BitPackingIterator on_begin() const;
+  BitPackingIterator on_end() const;
+
+  std::unique_ptr<const BaseCompressedVector> on_copy_using_allocator(const PolymorphicAllocator<size_t>& alloc) const;
+
+ private:
+  const pmr_vector<uint32_t> _data;
+  const uint8_t _bit_width;
+  const size_t _size;
+};
+
+}  // namespace opossum
@@ -4,6 +4,7 @@
 #include <boost/hana/value.hpp>
 
 // Include your compressed vector file here!
+#include "bit_packing/bit_packing_vector.hpp"
 #include "fixed_size_byte_aligned/fixed_size_byte_aligned_vector.hpp"
 #include "simd_bp128/simd_bp128_vector.hpp"
 
@@ -228,6 +228,8 @@ enum class DescriptionMode { SingleLine, MultiLine };
 
 enum class UseMvcc : bool { Yes = true, No = false };
 
+enum class UsePipelinedExecution : bool { Yes = true, No = false };
+
 enum class RollbackReason : bool { User, Conflict };
 
 enum class MemoryUsageCalculationMode { Sampled, Full };
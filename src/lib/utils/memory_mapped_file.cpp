@@ -0,0 +1,71 @@
+#include "memory_mapped_file.hpp"
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+#include "utils/assert.hpp"
+
+namespace opossum {
+
+MemoryMappedFile::MemoryMappedFile(const std::filesystem::path& path) : _path(path) {
+  const auto file_descriptor = open(_path.c_str(), O_RDONLY);
+  Assert(file_descriptor != -1, "Could not open '" + _path.string() + "': " + std::string{std::strerror(errno)});
+
+  _size = std::filesystem::file_size(_path);
+
+  // Mapping zero bytes is not allowed. An empty file is represented by a nullptr.
+  if (_size > 0) {
+    auto* const mapping = mmap(nullptr, _size, PROT_READ, MAP_PRIVATE, file_descriptor, 0);
+    Assert(mapping != MAP_FAILED, "Could not map '" + _path.string() + "': " + std::string{std::strerror(errno)});
+    _data = static_cast<char*>(mapping);
+  }
+
+  // The mapping stays valid after the file descriptor is closed.
+  close(file_descriptor);
+}
+
+MemoryMappedFile::~MemoryMappedFile() {
+  if (_data) munmap(_data, _size);
+}
+
+const char* MemoryMappedFile::data() const { return _data; }
+
+size_t MemoryMappedFile::size() const { return _size; }
+
+void MemoryMappedFile::will_need(const size_t offset, const size_t size) const {
+  DebugAssert(offset + size <= _size, "Range exceeds the mapped file");
+  if (size == 0) return;
+
+  // madvise requires a page-aligned address.
+  const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const auto aligned_offset = offset - offset % page_size;
+
+  // This is only a hint. If the operating system does not follow it, the pages are loaded on their first access.
+  madvise(_data + aligned_offset, size + (offset - aligned_offset), MADV_WILLNEED);
+}
+
+void MemoryMappedFile::dont_need(const size_t offset, const size_t size) const {
+  DebugAssert(offset + size <= _size, "Range exceeds the mapped file");
+
+  // Unlike in will_need, partially covered pages must be kept as other parts of them might still be accessed.
+  const auto page_size = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+  const auto aligned_begin = (offset + page_size - 1) / page_size * page_size;
+  const auto aligned_end = (offset + size) / page_size * page_size;
+  if (aligned_begin >= aligned_end) return;
+
+  madvise(_data + aligned_begin, aligned_end - aligned_begin, MADV_DONTNEED);
+}
+
+MemoryInputStream::MemoryInputStream(const char* data, const size_t size) : std::istream(nullptr) {
+  // std::streambuf's interface is not const-correct, but the get area is only read from.
+  auto* const begin = const_cast<char*>(data);  // NOLINT
+  setg(begin, begin, begin + size);
+  rdbuf(this);
+}
+
+}  // namespace opossum
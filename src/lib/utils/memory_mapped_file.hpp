@@ -0,0 +1,47 @@
+#pragma once
+
+#include <filesystem>
+#include <istream>
+#include <streambuf>
+
+#include "types.hpp"
+
+namespace opossum {
+
+/**
+ * Maps a file read-only into memory. Pages are loaded lazily by the operating system when they are first accessed,
+ * so opening even a large file is cheap. The mapping is private, i.e., it is not affected by later writes to the file
+ * through other mappings. It is released when the MemoryMappedFile is destroyed.
+ */
+class MemoryMappedFile : private Noncopyable {
+ public:
+  explicit MemoryMappedFile(const std::filesystem::path& path);
+  ~MemoryMappedFile();
+
+  const char* data() const;
+  size_t size() const;
+
+  // Hints the operating system to read [offset, offset + size) ahead, e.g., before multiple threads consume it.
+  void will_need(size_t offset, size_t size) const;
+
+  // Releases the pages that lie entirely within [offset, offset + size) once they are no longer accessed, e.g., after a
+  // range was parsed. They are read again from the file if they are accessed later on.
+  void dont_need(size_t offset, size_t size) const;
+
+ private:
+  const std::filesystem::path _path;
+  char* _data = nullptr;
+  size_t _size = 0;
+};
+
+/**
+ * std::istream that reads from a range of memory, e.g., from a MemoryMappedFile. In contrast to an std::ifstream, no
+ * intermediate buffer is involved: Reads copy the requested bytes directly out of the memory range. Reading past its
+ * end fails the stream.
+ */
+class MemoryInputStream : private std::streambuf, public std::istream {
+ public:
+  MemoryInputStream(const char* data, size_t size);
+};
+
+}  // namespace opossum
@@ -9,7 +9,9 @@ MetaChunksTable::MetaChunksTable()
                                                {"chunk_id", DataType::Int, false},
                                                {"row_count", DataType::Long, false},
                                                {"invalid_row_count", DataType::Long, false},
-                                               {"cleanup_commit_id", DataType::Long, true}}) {}
+                                               {"cleanup_commit_id", DataType::Long, true},
+                                               {"mvcc_size_in_bytes", DataType::Long, true},
+                                               {"mvcc_frozen", DataType::Int, true}}) {}
 
 const std::string& MetaChunksTable::name() const {
   static const auto name = std::string{"chunks"};
@@ -27,8 +29,16 @@ std::shared_ptr<Table> MetaChunksTable::_on_generate() const {
       const auto cleanup_commit_id = chunk->get_cleanup_commit_id()
                                          ? AllTypeVariant{static_cast<int64_t>(*chunk->get_cleanup_commit_id())}
                                          : NULL_VALUE;
+      // Size of the commit ids and transaction ids, which are replaced by a bitmap of invalid rows once the MVCC data
+      // is frozen (see MvccData::freeze)
+      const auto mvcc_data = chunk->mvcc_data();
+      const auto mvcc_size =
+          mvcc_data ? AllTypeVariant{static_cast<int64_t>(mvcc_data->visibility_memory_usage())} : NULL_VALUE;
+      const auto mvcc_frozen = mvcc_data ? AllTypeVariant{static_cast<int32_t>(mvcc_data->is_frozen())} : NULL_VALUE;
+
       output_table->append({pmr_string{table_name}, static_cast<int32_t>(chunk_id), static_cast<int64_t>(chunk->size()),
-                            static_cast<int64_t>(chunk->invalid_row_count()), cleanup_commit_id});
+                            static_cast<int64_t>(chunk->invalid_row_count()), cleanup_commit_id, mvcc_size,
+                            mvcc_frozen});
     }
   }
 
@@ -1,11 +1,16 @@
 #include "mvcc_delete_plugin.hpp"
 
+#include "operators/delete.hpp"
 #include "operators/get_table.hpp"
+#include "operators/insert.hpp"
 #include "operators/table_wrapper.hpp"
-#include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/foreign_segment.hpp"
 #include "storage/pos_lists/row_id_pos_list.hpp"
 #include "storage/reference_segment.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/segment_encoding_utils.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
@@ -28,11 +33,15 @@ void MvccDeletePlugin::stop() {
 }
 
 /**
- * This function analyzes each chunk of every table and triggers a chunk-cleanup-procedure if a certain threshold of
- * invalidated rows is exceeded.
+ * This function analyzes each chunk of every table and triggers a chunk-cleanup-procedure for groups of chunks with
+ * invalidated rows (see _select_compaction_groups). Its next execution is scheduled based on the share of invalidated
+ * rows in all tables.
  */
 void MvccDeletePlugin::_logical_delete_loop() {
   const auto tables = Hyrise::get().storage_manager.tables();
+  auto total_row_count = size_t{0};
+  auto total_invalid_row_count = size_t{0};
+  auto compacted = false;
 
   // Check all tables
   for (auto& [table_name, table] : tables) {
@@ -45,45 +54,33 @@ void MvccDeletePlugin::_logical_delete_loop() {
     for (auto chunk_id = ChunkID{0}; chunk_id < max_chunk_id; chunk_id++) {
       const auto& chunk = table->get_chunk(chunk_id);
       if (chunk && !chunk->get_cleanup_commit_id()) {
-        const auto chunk_memory = chunk->memory_usage(MemoryUsageCalculationMode::Sampled);
+        // Fold the versions of rows that were updated in place into the main segments (see RowVersions)
+        if (!chunk->is_mutable()) merge_row_versions(*table, chunk_id);
 
-        // Calculate metric 1 – Chunk invalidation level
-        const double invalidated_rows_ratio = static_cast<double>(chunk->invalid_row_count()) / chunk->size();
-        const bool criterion1 = (DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS <= invalidated_rows_ratio);
-
-        if (!criterion1) {
-          continue;
-        }
-
-        // Calculate metric 2 – Chunk Hotness
-        auto highest_end_commit_id = CommitID{0};
-        const auto chunk_size = chunk->size();
-        for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
-          const auto commit_id = chunk->mvcc_data()->get_end_cid(chunk_offset);
-          if (commit_id != MvccData::MAX_COMMIT_ID && commit_id > highest_end_commit_id) {
-            highest_end_commit_id = commit_id;
-          }
-        }
-
-        const bool criterion2 =
-            highest_end_commit_id + DELETE_THRESHOLD_LAST_COMMIT <= Hyrise::get().transaction_manager.last_commit_id();
+        total_row_count += chunk->size();
+        total_invalid_row_count += chunk->invalid_row_count();
+      }
+    }
 
-        if (!criterion2) {
-          continue;
-        }
+    for (const auto& chunk_ids : _select_compaction_groups(*table)) {
+      auto chunk_memory = size_t{0};
+      for (const auto chunk_id : chunk_ids) {
+        chunk_memory += table->get_chunk(chunk_id)->memory_usage(MemoryUsageCalculationMode::Sampled);
+      }
 
-        auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
-        const bool success = _try_logical_delete(table_name, chunk_id, transaction_context);
+      auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+      const bool success = _try_logical_delete(table_name, chunk_ids, transaction_context);
 
-        if (success) {
+      if (success) {
+        std::unique_lock<std::mutex> lock(_mutex_physical_delete_queue);
+        for (const auto chunk_id : chunk_ids) {
           DebugAssert(table->get_chunk(chunk_id)->get_cleanup_commit_id(),
                       "Chunk needs to be deleted logically before deleting it physically.");
-
-          std::unique_lock<std::mutex> lock(_mutex_physical_delete_queue);
           _physical_delete_queue.emplace(table, chunk_id);
-          saved_memory += chunk_memory;
-          num_chunks++;
         }
+        saved_memory += chunk_memory;
+        num_chunks += chunk_ids.size();
+        compacted = true;
       }
     }
     if (saved_memory > 0) {
@@ -93,53 +90,182 @@ void MvccDeletePlugin::_logical_delete_loop() {
               << std::setprecision(2) << saved_mb << " MB";
       Hyrise::get().log_manager.add_message("MvccDeletePlugin", message.str(), LogLevel::Info);
     }
+
+    _freeze_mvcc_data(*table);
+  }
+
+  if (_loop_thread_logical_delete) {
+    const auto invalidated_rows_ratio =
+        total_row_count > 0 ? static_cast<double>(total_invalid_row_count) / static_cast<double>(total_row_count) : 0.0;
+    _loop_thread_logical_delete->set_loop_sleep_time(_logical_delete_delay(invalidated_rows_ratio, compacted));
   }
 }
 
+std::vector<std::vector<ChunkID>> MvccDeletePlugin::_select_compaction_groups(const Table& table) {
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+  const auto target_chunk_size = static_cast<size_t>(table.target_chunk_size());
+
+  auto groups = std::vector<std::vector<ChunkID>>{};
+  auto group = std::vector<ChunkID>{};
+  auto group_valid_row_count = size_t{0};
+  auto first_invalidated_rows_ratio = 0.0;
+
+  const auto finish_group = [&]() {
+    // Moving the rows of a single chunk to the end of the table only pays off if most of them are invalidated.
+    if (group.size() > 1 ||
+        (group.size() == 1 && first_invalidated_rows_ratio >= DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS)) {
+      groups.emplace_back(std::move(group));
+    }
+    group.clear();
+    group_valid_row_count = 0;
+  };
+
+  // Check all chunks, except for the last one, which is currently used for insertions
+  const auto max_chunk_id = static_cast<ChunkID>(table.chunk_count() - 1);
+  for (auto chunk_id = ChunkID{0}; chunk_id < max_chunk_id; chunk_id++) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    if (!chunk || chunk->get_cleanup_commit_id() || chunk->size() == 0) continue;
+
+    // Calculate metric 1 – Chunk invalidation level
+    const auto chunk_size = chunk->size();
+    const auto invalid_row_count = static_cast<size_t>(chunk->invalid_row_count());
+    const double invalidated_rows_ratio = static_cast<double>(invalid_row_count) / chunk_size;
+    const bool criterion1 = (COMPACTION_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS <= invalidated_rows_ratio);
+
+    if (!criterion1) {
+      continue;
+    }
+
+    // Calculate metric 2 – Chunk Hotness. Chunks with pending inserts are not moved either, as these rows would not
+    // be visible to the transaction that moves the rows.
+    const auto& mvcc_data = chunk->mvcc_data();
+    auto highest_end_commit_id = CommitID{0};
+    auto has_pending_inserts = false;
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk_size; ++chunk_offset) {
+      if (mvcc_data->get_begin_cid(chunk_offset) == MvccData::MAX_COMMIT_ID) {
+        has_pending_inserts = true;
+        break;
+      }
+
+      const auto commit_id = mvcc_data->get_end_cid(chunk_offset);
+      if (commit_id != MvccData::MAX_COMMIT_ID && commit_id > highest_end_commit_id) {
+        highest_end_commit_id = commit_id;
+      }
+    }
+
+    const bool criterion2 =
+        !has_pending_inserts && highest_end_commit_id + DELETE_THRESHOLD_LAST_COMMIT <= last_commit_id;
+
+    if (!criterion2) {
+      continue;
+    }
+
+    // Start a new group if the visible rows of the chunk do not fit into the current one.
+    const auto valid_row_count = chunk_size - invalid_row_count;
+    if (!group.empty() && group_valid_row_count + valid_row_count > target_chunk_size) finish_group();
+
+    if (group.empty()) first_invalidated_rows_ratio = invalidated_rows_ratio;
+    group.emplace_back(chunk_id);
+    group_valid_row_count += valid_row_count;
+  }
+  finish_group();
+
+  return groups;
+}
+
+size_t MvccDeletePlugin::_freeze_mvcc_data(Table& table) {
+  auto& transaction_manager = Hyrise::get().transaction_manager;
+  const auto last_commit_id = transaction_manager.last_commit_id();
+  if (last_commit_id < DELETE_THRESHOLD_LAST_COMMIT) return 0;
+
+  // Rows must be visible or invisible to all active transactions. Furthermore, chunks that were modified recently are
+  // likely to be modified again, which frozen MVCC data handles less efficiently.
+  const auto lowest_active_snapshot_commit_id = transaction_manager.get_lowest_active_snapshot_commit_id();
+  const auto visibility_threshold =
+      std::min(lowest_active_snapshot_commit_id ? *lowest_active_snapshot_commit_id : last_commit_id,
+               last_commit_id - DELETE_THRESHOLD_LAST_COMMIT);
+
+  auto frozen_chunk_count = size_t{0};
+  const auto chunk_count = table.chunk_count();
+  for (auto chunk_id = ChunkID{0}; chunk_id < chunk_count; ++chunk_id) {
+    const auto& chunk = table.get_chunk(chunk_id);
+    if (!chunk || chunk->is_mutable() || chunk->get_cleanup_commit_id()) continue;
+
+    const auto mvcc_data = chunk->mvcc_data();
+    if (!mvcc_data || mvcc_data->is_frozen()) continue;
+
+    if (chunk->try_freeze_mvcc_data(visibility_threshold)) ++frozen_chunk_count;
+  }
+
+  return frozen_chunk_count;
+}
+
+std::chrono::milliseconds MvccDeletePlugin::_logical_delete_delay(const double invalidated_rows_ratio,
+                                                                  const bool compacted) {
+  // Continue quickly after chunks were compacted, as the next candidates might be waiting.
+  if (compacted) return MIN_IDLE_DELAY_LOGICAL_DELETE;
+
+  const auto urgency = std::min(1.0, invalidated_rows_ratio / COMPACTION_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS);
+  const auto delay_range = IDLE_DELAY_LOGICAL_DELETE - MIN_IDLE_DELAY_LOGICAL_DELETE;
+  return MIN_IDLE_DELAY_LOGICAL_DELETE +
+         std::chrono::duration_cast<std::chrono::milliseconds>(delay_range * (1.0 - urgency));
+}
+
 /**
- * This function processes the physical-delete-queue until its empty.
+ * This function processes the physical-delete-queue until its empty or its front chunk might still be used. As the
+ * chunks of a compaction group share the same cleanup commit id, they are usually removed in the same execution.
  */
 void MvccDeletePlugin::_physical_delete_loop() {
   std::unique_lock<std::mutex> lock(_mutex_physical_delete_queue);
 
-  if (!_physical_delete_queue.empty()) {
+  while (!_physical_delete_queue.empty()) {
     TableAndChunkID table_and_chunk_id = _physical_delete_queue.front();
     const auto& table = table_and_chunk_id.first;
     const auto& chunk = table->get_chunk(table_and_chunk_id.second);
 
     DebugAssert(chunk != nullptr, "Chunk does not exist. Physical Delete can not be applied.");
 
-    if (chunk->get_cleanup_commit_id().has_value()) {
-      // Check whether there are still active transactions that might use the chunk
-      bool conflicting_transactions = false;
-      auto lowest_snapshot_commit_id = Hyrise::get().transaction_manager.get_lowest_active_snapshot_commit_id();
+    if (!chunk->get_cleanup_commit_id().has_value()) break;
 
-      if (lowest_snapshot_commit_id.has_value()) {
-        conflicting_transactions = chunk->get_cleanup_commit_id().value() > lowest_snapshot_commit_id.value();
-      }
+    // Check whether there are still active transactions that might use the chunk
+    bool conflicting_transactions = false;
+    auto lowest_snapshot_commit_id = Hyrise::get().transaction_manager.get_lowest_active_snapshot_commit_id();
 
-      if (!conflicting_transactions) {
-        _delete_chunk_physically(table, table_and_chunk_id.second);
-        _physical_delete_queue.pop();
-      }
+    if (lowest_snapshot_commit_id.has_value()) {
+      conflicting_transactions = chunk->get_cleanup_commit_id().value() > lowest_snapshot_commit_id.value();
     }
+
+    if (conflicting_transactions) break;
+
+    _delete_chunk_physically(table, table_and_chunk_id.second);
+    _physical_delete_queue.pop();
   }
 }
 
 bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const ChunkID chunk_id,
                                            const std::shared_ptr<TransactionContext>& transaction_context) {
+  return _try_logical_delete(table_name, std::vector<ChunkID>{chunk_id}, transaction_context);
+}
+
+bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                           const std::shared_ptr<TransactionContext>& transaction_context) {
   const auto& table = Hyrise::get().storage_manager.get_table(table_name);
-  const auto& chunk = table->get_chunk(chunk_id);
+  Assert(!chunk_ids.empty(), "Expected at least one chunk to delete logically.");
+  Assert(std::is_sorted(chunk_ids.begin(), chunk_ids.end()), "Expected sorted ChunkIDs.");
 
-  Assert(chunk != nullptr, "Chunk does not exist. Logical Delete can not be applied.");
-  Assert(chunk_id < (table->chunk_count() - 1),
-         "MVCC Logical Delete should not be applied on the last/current mutable chunk.");
+  for (const auto chunk_id : chunk_ids) {
+    Assert(table->get_chunk(chunk_id) != nullptr, "Chunk does not exist. Logical Delete can not be applied.");
+    Assert(chunk_id < (table->chunk_count() - 1),
+           "MVCC Logical Delete should not be applied on the last/current mutable chunk.");
+  }
 
-  // Create temporary referencing table that contains the given chunk only
-  //   Include all ChunksIDs of current table except chunk_id for pruning in GetTable
-  std::vector<ChunkID> excluded_chunk_ids(table->chunk_count() - 1);
-  std::iota(excluded_chunk_ids.begin(), excluded_chunk_ids.begin() + chunk_id, 0);
-  std::iota(excluded_chunk_ids.begin() + chunk_id, excluded_chunk_ids.end(), chunk_id + 1);
+  // Create temporary referencing table that contains the given chunks only
+  //   Include all ChunksIDs of current table except chunk_ids for pruning in GetTable
+  std::vector<ChunkID> all_chunk_ids(table->chunk_count() - 1);
+  std::iota(all_chunk_ids.begin(), all_chunk_ids.end(), ChunkID{0});
+  std::vector<ChunkID> excluded_chunk_ids;
+  std::set_difference(all_chunk_ids.begin(), all_chunk_ids.end(), chunk_ids.begin(), chunk_ids.end(),
+                      std::back_inserter(excluded_chunk_ids));
 
   auto get_table = std::make_shared<GetTable>(table_name, excluded_chunk_ids, std::vector<ColumnID>());
   get_table->set_transaction_context(transaction_context);
@@ -150,23 +276,61 @@ bool MvccDeletePlugin::_try_logical_delete(const std::string& table_name, const
   validate->set_transaction_context(transaction_context);
   validate->execute();
 
-  // Use Update operator to delete and re-insert valid records in chunk
-  // Pass validate into Update operator twice since data will not be changed.
-  auto update = std::make_shared<Update>(table_name, validate, validate);
-  update->set_transaction_context(transaction_context);
-  update->execute();
+  // Use Delete and Insert operators to delete and re-insert valid records in chunks. The Update operator would not
+  // write the records at all, as their values do not change.
+  auto delete_op = std::make_shared<Delete>(validate);
+  delete_op->set_transaction_context(transaction_context);
+  delete_op->execute();
 
   // Check for success
-  if (update->execute_failed()) {
-    // Transaction conflict. Usually, the OperatorTask would call rollback, but as we executed Update directly, that is
+  if (delete_op->execute_failed()) {
+    // Transaction conflict. Usually, the OperatorTask would call rollback, but as we executed Delete directly, that is
     // our job.
     transaction_context->rollback(RollbackReason::Conflict);
     return false;
   }
 
+  // The rows are appended to the last chunk and, if it is full, to new chunks.
+  const auto first_target_chunk_id = ChunkID{table->chunk_count() - 1};
+  auto insert = std::make_shared<Insert>(table_name, validate);
+  insert->set_transaction_context(transaction_context);
+  insert->execute();
+
   transaction_context->commit();
-  // Mark chunk as logically deleted
-  chunk->set_cleanup_commit_id(transaction_context->commit_id());
+  // Mark chunks as logically deleted
+  for (const auto chunk_id : chunk_ids) {
+    table->get_chunk(chunk_id)->set_cleanup_commit_id(transaction_context->commit_id());
+  }
+
+  // Finalize and encode the chunks that the moved rows filled up, unless other transactions are still inserting into
+  // them. They are encoded like the first chunk that the rows came from. Rows of foreign tables, which are loaded from
+  // their files, get the default encoding.
+  const auto source_chunk = table->get_chunk(chunk_ids.front());
+  auto chunk_encoding_spec = ChunkEncodingSpec{};
+  for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+    const auto segment = source_chunk->get_segment(column_id);
+    chunk_encoding_spec.emplace_back(std::dynamic_pointer_cast<const ForeignSegment>(segment)
+                                         ? SegmentEncodingSpec{}
+                                         : get_segment_encoding_spec(segment));
+  }
+
+  const auto target_chunk_size = table->target_chunk_size();
+  const auto end_target_chunk_id = ChunkID{table->chunk_count() - 1};
+  for (auto chunk_id = first_target_chunk_id; chunk_id < end_target_chunk_id; ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    if (!chunk || !chunk->is_mutable() || chunk->size() != target_chunk_size) continue;
+
+    const auto& mvcc_data = chunk->mvcc_data();
+    auto is_completed = true;
+    for (auto chunk_offset = ChunkOffset{0}; chunk_offset < target_chunk_size && is_completed; ++chunk_offset) {
+      is_completed = mvcc_data->get_begin_cid(chunk_offset) != MvccData::MAX_COMMIT_ID;
+    }
+    if (!is_completed) continue;
+
+    chunk->finalize();
+    ChunkEncoder::encode_chunk(chunk, table->column_data_types(), chunk_encoding_spec);
+  }
+
   return true;
 }
 
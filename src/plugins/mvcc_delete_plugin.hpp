@@ -1,10 +1,12 @@
 #pragma once
 
 #include <algorithm>
+#include <chrono>
 #include <mutex>
 #include <numeric>
 #include <queue>
 #include <thread>
+#include <vector>
 
 #include "gtest/gtest_prod.h"
 #include "hyrise.hpp"
@@ -26,6 +28,16 @@ namespace opossum {
  * recognizing chunks with high numbers of invalidated rows and fully invalidates them.
  * The physical delete checks if chunks are not visible anymore for other transactions and
  * removes the chunk from the table completely.
+ * Additionally, the logical delete loop merges the versions of rows that were updated in place into the main segments
+ * of immutable chunks (see merge_row_versions).
+ *
+ * Chunks with a moderate share of invalidated rows are compacted together: The visible rows of neighboring candidate
+ * chunks that fit into one chunk are moved in a single transaction, so that several partially invalidated chunks are
+ * replaced by one. Chunks that the moved rows fill up are finalized and encoded like the chunks the rows came from.
+ * The logical delete loop runs more often the more invalidated rows the tables contain.
+ *
+ * Finally, the MVCC data of immutable chunks that have not been modified for DELETE_THRESHOLD_LAST_COMMIT commits is
+ * frozen (see MvccData::freeze), which replaces the per-row commit ids by a bitmap of the invalid rows.
  */
 class MvccDeletePlugin : public AbstractPlugin {
   friend class MvccDeletePluginTest;
@@ -40,15 +52,22 @@ class MvccDeletePlugin : public AbstractPlugin {
 
   /**
    * DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS: the percentage of invalidated rows
-   * in chunk to be deleted logically by the plugin.
+   * in chunk to be deleted logically by the plugin on its own.
+   * COMPACTION_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS: the percentage of invalidated rows
+   * in chunk to be compacted together with other chunks.
    * DELETE_THRESHOLD_LAST_COMMIT: the number of commits that must have passed since
    * the candidate chunk was last modified
-   * IDLE_DELAY_LOGICAL_DELETE: sleep after execution of logical delete
+   * IDLE_DELAY_LOGICAL_DELETE: longest sleep after execution of logical delete, used if
+   * the tables contain no invalidated rows
+   * MIN_IDLE_DELAY_LOGICAL_DELETE: shortest sleep after execution of logical delete, used if
+   * chunks were compacted or the tables contain many invalidated rows
    * IDLE_DELAY_PHYSICAL_DELETE: sleep after execution of physical delete
    */
   constexpr static double DELETE_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS = 0.6;
+  constexpr static double COMPACTION_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS = 0.2;
   constexpr static CommitID DELETE_THRESHOLD_LAST_COMMIT = CommitID{100};
   constexpr static std::chrono::milliseconds IDLE_DELAY_LOGICAL_DELETE = std::chrono::milliseconds(1000);
+  constexpr static std::chrono::milliseconds MIN_IDLE_DELAY_LOGICAL_DELETE = std::chrono::milliseconds(100);
   constexpr static std::chrono::milliseconds IDLE_DELAY_PHYSICAL_DELETE = std::chrono::milliseconds(1000);
 
  private:
@@ -57,8 +76,20 @@ class MvccDeletePlugin : public AbstractPlugin {
   void _logical_delete_loop();
   void _physical_delete_loop();
 
+  // Returns groups of chunks whose visible rows fit into one chunk together. Each group is deleted logically in one
+  // transaction.
+  static std::vector<std::vector<ChunkID>> _select_compaction_groups(const Table& table);
+
+  // Freezes the MVCC data of cold immutable chunks. Returns the number of frozen chunks.
+  static size_t _freeze_mvcc_data(Table& table);
+
+  // Returns the sleep time of the logical delete loop for the given share of invalidated rows of all tables.
+  static std::chrono::milliseconds _logical_delete_delay(const double invalidated_rows_ratio, const bool compacted);
+
   static bool _try_logical_delete(const std::string& table_name, ChunkID chunk_id,
                                   const std::shared_ptr<TransactionContext>& transaction_context);
+  static bool _try_logical_delete(const std::string& table_name, const std::vector<ChunkID>& chunk_ids,
+                                  const std::shared_ptr<TransactionContext>& transaction_context);
   static void _delete_chunk_physically(const std::shared_ptr<Table>& table, ChunkID chunk_id);
 
   std::unique_ptr<PausableLoopThread> _loop_thread_logical_delete, _loop_thread_physical_delete;
@@ -1,5 +1,10 @@
+#include <thread>
+#include <vector>
+
 #include "base_test.hpp"
 
+#include "cache/sharded_cache.hpp"
+
 namespace opossum {
 
 // Test for the cache implementation in lib/cache.
@@ -191,4 +196,104 @@ TEST_F(CacheTest, Snapshot) {
   }
 }
 
+TEST_F(CacheTest, ShardedCache) {
+  ShardedCache<int, int> cache(4);
+  EXPECT_EQ(cache.shard_count(), 1u);
+
+  cache.set(1, 2);
+  cache.set(2, 4);
+  EXPECT_EQ(cache.size(), 2u);
+  EXPECT_TRUE(cache.has(1));
+  EXPECT_FALSE(cache.has(3));
+  EXPECT_EQ(cache.try_get(1), 2);
+  EXPECT_FALSE(cache.try_get(3));
+
+  cache.set(1, 3);
+  EXPECT_EQ(cache.try_get(1), 3);
+  EXPECT_EQ(cache.size(), 2u);
+
+  const auto snapshot = cache.snapshot();
+  EXPECT_EQ(snapshot.size(), 2u);
+  // Set twice and retrieved twice
+  EXPECT_EQ(snapshot.at(1).frequency, 4);
+  EXPECT_EQ(snapshot.at(2).value, 4);
+  EXPECT_EQ(snapshot.at(2).frequency, 1);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0u);
+  EXPECT_FALSE(cache.try_get(1));
+}
+
+TEST_F(CacheTest, ShardedCacheAdmission) {
+  ShardedCache<int, int> cache(2);
+  cache.set(1, 1);
+  cache.set(2, 2);
+  for (auto access = 0; access < 4; ++access) {
+    cache.try_get(1);
+  }
+  for (auto access = 0; access < 3; ++access) {
+    cache.try_get(2);
+  }
+
+  // Key 3 was never requested, so it does not displace any entry.
+  cache.set(3, 3);
+  EXPECT_FALSE(cache.has(3));
+  EXPECT_EQ(cache.size(), 2u);
+
+  // After key 3 was requested more often than key 2 (the entry with the lowest GDFS priority), it replaces key 2.
+  for (auto access = 0; access < 5; ++access) {
+    EXPECT_FALSE(cache.try_get(3));
+  }
+  cache.set(3, 3);
+  EXPECT_TRUE(cache.has(1));
+  EXPECT_FALSE(cache.has(2));
+  EXPECT_TRUE(cache.has(3));
+}
+
+TEST_F(CacheTest, ShardedCacheCapacity) {
+  ShardedCache<int, int> cache(1024);
+  EXPECT_EQ(cache.shard_count(), 32u);
+
+  for (auto key = 0; key < 5000; ++key) {
+    cache.try_get(key);
+    cache.set(key, key);
+    ASSERT_LE(cache.size(), 1024u);
+  }
+  // Each full shard evicts a batch of entries before it admits a new one.
+  EXPECT_GT(cache.size(), 900u);
+
+  cache.resize(100);
+  EXPECT_EQ(cache.capacity(), 100u);
+  EXPECT_LE(cache.size(), 100u);
+
+  cache.resize(0);
+  EXPECT_EQ(cache.size(), 0u);
+  cache.set(1, 1);
+  EXPECT_FALSE(cache.has(1));
+}
+
+TEST_F(CacheTest, ShardedCacheConcurrentAccess) {
+  ShardedCache<int, int> cache(256);
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < 8; ++thread_id) {
+    threads.emplace_back([&, thread_id]() {
+      for (auto iteration = 0; iteration < 10'000; ++iteration) {
+        const auto key = (iteration * 7 + thread_id) % 512;
+        const auto value = cache.try_get(key);
+        if (value) {
+          EXPECT_EQ(*value, key * 2);
+        } else {
+          cache.set(key, key * 2);
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_LE(cache.size(), 256u);
+}
+
 }  // namespace opossum
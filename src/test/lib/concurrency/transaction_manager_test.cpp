@@ -1,4 +1,6 @@
 #include <algorithm>
+#include <thread>
+#include <unordered_set>
 #include <vector>
 
 #include "base_test.hpp"
@@ -12,23 +14,22 @@ class TransactionManagerTest : public BaseTest {
  protected:
   void SetUp() override {}
 
-  static std::unordered_multiset<CommitID>& get_active_snapshot_commit_ids() {
-    return Hyrise::get().transaction_manager._active_snapshot_commit_ids;
+  static std::unordered_multiset<CommitID> get_active_snapshot_commit_ids() {
+    return Hyrise::get().transaction_manager._active_snapshot_commit_ids();
   }
 
-  static void register_transaction(CommitID snapshot_commit_id) {
-    Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id);
+  static size_t register_transaction(CommitID snapshot_commit_id) {
+    return Hyrise::get().transaction_manager._register_transaction(snapshot_commit_id);
   }
-  static void deregister_transaction(CommitID snapshot_commit_id) {
-    Hyrise::get().transaction_manager._deregister_transaction(snapshot_commit_id);
+  static void deregister_transaction(CommitID snapshot_commit_id, size_t slot) {
+    Hyrise::get().transaction_manager._deregister_transaction(snapshot_commit_id, slot);
   }
 };
 
 /** Check if all active snapshot commit ids of uncommitted
  * transaction contexts are tracked correctly.
- * Normally, deregister_transaction() is called in the
- * destructor of the transaction context but is called
- * manually for this test.
+ * The transactions are deregistered in the destructor
+ * of the transaction context.
  */
 TEST_F(TransactionManagerTest, TrackActiveCommitIDs) {
   auto& manager = Hyrise::get().transaction_manager;
@@ -36,52 +37,99 @@ TEST_F(TransactionManagerTest, TrackActiveCommitIDs) {
   EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0);
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
 
-  const auto t1_context = manager.new_transaction_context(AutoCommit::No);
-  const auto t2_context = manager.new_transaction_context(AutoCommit::No);
-  const auto t3_context = manager.new_transaction_context(AutoCommit::No);
+  auto t1_context = manager.new_transaction_context(AutoCommit::No);
+  auto t2_context = manager.new_transaction_context(AutoCommit::No);
+  auto t3_context = manager.new_transaction_context(AutoCommit::No);
 
   const CommitID t1_snapshot_commit_id = t1_context->snapshot_commit_id();
   const CommitID t2_snapshot_commit_id = t2_context->snapshot_commit_id();
   const CommitID t3_snapshot_commit_id = t3_context->snapshot_commit_id();
   const auto vec = std::vector<CommitID>{t1_snapshot_commit_id, t2_snapshot_commit_id, t3_snapshot_commit_id};
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 3);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_snapshot_commit_id) != get_active_snapshot_commit_ids().cend());
+  auto active_snapshot_commit_ids = get_active_snapshot_commit_ids();
+  EXPECT_EQ(active_snapshot_commit_ids, std::unordered_multiset<CommitID>(vec.cbegin(), vec.cend()));
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), *std::min_element(vec.cbegin(), vec.cend()));
 
   t1_context->commit();
-  deregister_transaction(t1_context->snapshot_commit_id());
+  t1_context = nullptr;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 2);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t1_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t3_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
+  active_snapshot_commit_ids = get_active_snapshot_commit_ids();
+  EXPECT_EQ(active_snapshot_commit_ids,
+            std::unordered_multiset<CommitID>({t2_snapshot_commit_id, t3_snapshot_commit_id}));
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_snapshot_commit_id);
 
   t3_context->commit();
-  deregister_transaction(t3_context->snapshot_commit_id());
+  t3_context = nullptr;
 
-  EXPECT_EQ(get_active_snapshot_commit_ids().size(), 1);
-  EXPECT_TRUE(std::find(get_active_snapshot_commit_ids().cbegin(), get_active_snapshot_commit_ids().cend(),
-                        t2_context->snapshot_commit_id()) != get_active_snapshot_commit_ids().cend());
-  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_context->snapshot_commit_id());
+  active_snapshot_commit_ids = get_active_snapshot_commit_ids();
+  EXPECT_EQ(active_snapshot_commit_ids, std::unordered_multiset<CommitID>({t2_snapshot_commit_id}));
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_snapshot_commit_id);
+
+  // A transaction that began after t1 and t3 committed uses a newer snapshot.
+  const auto t4_context = manager.new_transaction_context(AutoCommit::No);
+  EXPECT_GT(t4_context->snapshot_commit_id(), t2_snapshot_commit_id);
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t2_snapshot_commit_id);
 
   t2_context->commit();
-  deregister_transaction(t2_context->snapshot_commit_id());
+  t2_context = nullptr;
+
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), t4_context->snapshot_commit_id());
+
+  t4_context->commit();
+}
+
+// If more transactions are active than there are slots, the remaining snapshot commit ids are tracked separately.
+TEST_F(TransactionManagerTest, MoreActiveTransactionsThanSlots) {
+  auto& manager = Hyrise::get().transaction_manager;
+
+  constexpr auto TRANSACTION_COUNT = TransactionManager::SNAPSHOT_COMMIT_ID_SLOT_COUNT + 10;
+  auto slots = std::vector<size_t>(TRANSACTION_COUNT);
+  for (auto index = size_t{0}; index < TRANSACTION_COUNT; ++index) {
+    slots[index] = register_transaction(static_cast<CommitID>(TRANSACTION_COUNT + 1 - index));
+  }
+
+  EXPECT_EQ(get_active_snapshot_commit_ids().size(), TRANSACTION_COUNT);
+  EXPECT_EQ(std::unordered_set<size_t>(slots.cbegin(), slots.cend()).size(),
+            TransactionManager::SNAPSHOT_COMMIT_ID_SLOT_COUNT + 1);
+  // The lowest snapshot commit ids were the last to be registered and have not found a slot.
+  EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), CommitID{2});
+
+  for (auto index = TRANSACTION_COUNT; index > 0; --index) {
+    deregister_transaction(static_cast<CommitID>(TRANSACTION_COUNT + 1 - (index - 1)), slots[index - 1]);
+  }
 
   EXPECT_EQ(get_active_snapshot_commit_ids().size(), 0);
   EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), std::nullopt);
+}
+
+// While many threads begin and end transactions, the lowest active snapshot commit id never exceeds the snapshot of a
+// long-running transaction.
+TEST_F(TransactionManagerTest, ConcurrentTransactions) {
+  auto& manager = Hyrise::get().transaction_manager;
+
+  const auto long_running_context = manager.new_transaction_context(AutoCommit::No);
+  const auto long_running_snapshot_commit_id = long_running_context->snapshot_commit_id();
+
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_index = 0; thread_index < 8; ++thread_index) {
+    threads.emplace_back([&]() {
+      for (auto iteration = 0; iteration < 1'000; ++iteration) {
+        const auto context = manager.new_transaction_context(AutoCommit::Yes);
+        context->commit();
+      }
+    });
+  }
+
+  for (auto iteration = 0; iteration < 1'000; ++iteration) {
+    EXPECT_EQ(manager.get_lowest_active_snapshot_commit_id(), long_running_snapshot_commit_id);
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
 
-  // To prevent exceptions in TransactionContext destructor
-  register_transaction(t1_snapshot_commit_id);
-  register_transaction(t2_snapshot_commit_id);
-  register_transaction(t3_snapshot_commit_id);
+  EXPECT_EQ(get_active_snapshot_commit_ids(), std::unordered_multiset<CommitID>({long_running_snapshot_commit_id}));
+  long_running_context->commit();
 }
 
 }  // namespace opossum
@@ -2,10 +2,13 @@
 #include <string>
 #include <vector>
 
+#include <magic_enum.hpp>
+
 #include "base_test.hpp"
 
 #include "hyrise.hpp"
 #include "import_export/binary/binary_parser.hpp"
+#include "import_export/binary/binary_writer.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 
@@ -33,6 +36,20 @@ INSTANTIATE_TEST_SUITE_P(BinaryEncodingTypes, BinaryParserMultiEncodingTest,
                                            EncodingType::LZ4),
                          import_binary_formatter);
 
+class BinaryParserBlockCompressionTest : public BinaryParserTest,
+                                         public ::testing::WithParamInterface<BlockCompression> {
+ protected:
+  void TearDown() override { std::remove(_filename.c_str()); }
+
+  const std::string _filename = test_data_path + "block_compression_test.bin";
+};
+
+INSTANTIATE_TEST_SUITE_P(BlockCompressions, BinaryParserBlockCompressionTest,
+                         ::testing::Values(BlockCompression::None, BlockCompression::LZ4, BlockCompression::Zstd),
+                         [](const ::testing::TestParamInfo<BlockCompression> info) {
+                           return std::string{magic_enum::enum_name(info.param)};
+                         });
+
 TEST_P(BinaryParserMultiEncodingTest, SingleChunkSingleFloatColumn) {
   auto expected_table =
       std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Float, false}}, TableType::Data, 5);
@@ -422,4 +439,29 @@ TEST_F(BinaryParserTest, SortColumnDefinitions) {
   EXPECT_TRUE(table->get_chunk(ChunkID{2})->individually_sorted_by().empty());
 }
 
+TEST_F(BinaryParserTest, FormatVersion1) {
+  // Files without a chunk directory are parsed sequentially.
+  const auto table = BinaryParser::parse(_reference_filepath + "int_float_version_1.bin");
+  const auto expected_table = BinaryParser::parse(_reference_filepath + "int_float.bin");
+
+  EXPECT_EQ(table->chunk_count(), 2);
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
+TEST_P(BinaryParserBlockCompressionTest, WriteAndParse) {
+  const auto expected_table = load_table("resources/test_data/tbl/all_data_types_sorted.tbl", 3);
+  ChunkEncoder::encode_chunks(expected_table, {ChunkID{0}, ChunkID{2}}, SegmentEncodingSpec{EncodingType::Dictionary});
+  expected_table->get_chunk(ChunkID{1})->set_individually_sorted_by(SortColumnDefinition{ColumnID{0}});
+
+  BinaryWriter::write(*expected_table, _filename, GetParam());
+  const auto table = BinaryParser::parse(_filename);
+
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+  EXPECT_EQ(table->chunk_count(), expected_table->chunk_count());
+  const auto& segment = table->get_chunk(ChunkID{0})->get_segment(ColumnID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<int32_t>>(segment));
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->individually_sorted_by(),
+            std::vector<SortColumnDefinition>{SortColumnDefinition{ColumnID{0}}});
+}
+
 }  // namespace opossum
@@ -5,12 +5,18 @@
 #include "scheduler/immediate_execution_scheduler.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/table.hpp"
 
 namespace opossum {
 
 class CsvParserTest : public BaseTest {};
 
+class CsvParserForTests : public CsvParser {
+ public:
+  using CsvParser::_find_row_ends_in_block;
+};
+
 TEST_F(CsvParserTest, SingleFloatColumn) {
   auto table = CsvParser::parse("resources/test_data/csv/float.csv");
   std::shared_ptr<Table> expected_table = load_table("resources/test_data/tbl/float.tbl", 5);
@@ -261,6 +267,18 @@ TEST_F(CsvParserTest, UnconvertedCharactersThrows) {
   EXPECT_THROW(CsvParser::parse("resources/test_data/csv/unconverted_characters_double.csv"), std::logic_error);
 }
 
+TEST_F(CsvParserTest, LeadingWhitespaceAndSigns) {
+  // Numbers may be preceded by whitespace and a sign, as accepted by std::stoi and std::stof.
+  const auto table = CsvParser::parse("resources/test_data/csv/leading_whitespace_and_signs.csv");
+
+  TableColumnDefinitions column_definitions{{"b", DataType::Float, false}, {"a", DataType::Int, false}};
+  auto expected_table = std::make_shared<Table>(column_definitions, TableType::Data, 3);
+  expected_table->append({458.7f, 12345});
+  expected_table->append({456.7f, 123});
+  expected_table->append({-457.7f, -1234});
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+}
+
 TEST_F(CsvParserTest, EmptyTableFromMetaFile) {
   const auto csv_meta_table = CsvParser{}.create_table_from_meta_file("resources/test_data/csv/float_int.csv.json");
   const auto expected_table = std::make_shared<Table>(
@@ -300,4 +318,43 @@ TEST_F(CsvParserTest, FinalizedChunks) {
   EXPECT_FALSE(table->get_chunk(ChunkID{2})->is_mutable());
 }
 
+TEST_F(CsvParserTest, EncodeWhileParsing) {
+  const auto table = CsvParser::parse("resources/test_data/csv/float_int_large.csv", ChunkOffset{40}, std::nullopt,
+                                      ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::Dictionary},
+                                                        SegmentEncodingSpec{EncodingType::Unencoded}});
+
+  TableColumnDefinitions column_definitions{{"b", DataType::Float, false}, {"a", DataType::Int, false}};
+  auto expected_table = std::make_shared<Table>(column_definitions, TableType::Data, 20);
+  for (int i = 0; i < 100; ++i) {
+    expected_table->append({458.7f, 12345});
+  }
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto& chunk = table->get_chunk(chunk_id);
+    EXPECT_TRUE(std::dynamic_pointer_cast<DictionarySegment<float>>(chunk->get_segment(ColumnID{0})));
+    EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<int32_t>>(chunk->get_segment(ColumnID{1})));
+  }
+}
+
+TEST_F(CsvParserTest, FindRowEndsInBlock) {
+  auto meta = CsvMeta{};
+  const auto csv_content = std::string_view{"1,\"a\nb\"\n2,\"c\"\n3,d\n"};
+
+  // The block starts within the quoted field of the first row. Whether its delimiters end rows depends on the quote
+  // state at the start of the block, which is only known once the preceding blocks were searched.
+  const auto block_row_ends = CsvParserForTests::_find_row_ends_in_block(csv_content, 4, csv_content.size(), meta);
+  EXPECT_EQ(block_row_ends.row_ends_inside_quotes, (std::vector<size_t>{7, 13, 17}));
+  EXPECT_EQ(block_row_ends.row_ends_outside_quotes, std::vector<size_t>{4});
+  EXPECT_TRUE(block_row_ends.has_odd_quote_count);
+
+  // Escaped quotes do not change the quote state.
+  meta.config.escape = '\\';
+  const auto escaped_content = std::string_view{"\"a\\\"\n\"\n"};
+  const auto escaped_row_ends = CsvParserForTests::_find_row_ends_in_block(escaped_content, 0, escaped_content.size(),
+                                                                           meta);
+  EXPECT_EQ(escaped_row_ends.row_ends_outside_quotes, std::vector<size_t>{6});
+  EXPECT_FALSE(escaped_row_ends.has_odd_quote_count);
+}
+
 }  // namespace opossum
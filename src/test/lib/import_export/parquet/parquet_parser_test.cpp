@@ -0,0 +1,216 @@
+#include <limits>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "import_export/parquet/parquet_parser.hpp"
+#include "operators/get_table.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "statistics/table_statistics.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/foreign_segment.hpp"
+#include "storage/run_length_segment.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class ParquetParserTest : public BaseTest {
+ protected:
+  // The rows of the dictionary_*.parquet files. The files have a row group of 1000 rows, whose pages are of version 1,
+  // and a row group of 500 rows, whose pages are of version 2. The number column of the second row group falls back
+  // from dictionary to PLAIN encoding after its first page.
+  static std::shared_ptr<Table> _expected_dictionary_table() {
+    const auto column_definitions = TableColumnDefinitions{
+        {"id", DataType::Int, false}, {"category", DataType::String, false}, {"number", DataType::Long, true}};
+    auto table = std::make_shared<Table>(column_definitions, TableType::Data);
+    for (auto row_index = int32_t{0}; row_index < 1500; ++row_index) {
+      const auto number = row_index % 7 == 0 ? AllTypeVariant{NullValue{}}
+                                             : AllTypeVariant{int64_t{(row_index * row_index) % 13 * 1000 - 6000}};
+      table->append({row_index, pmr_string{"category_" + std::to_string(row_index / 100)}, number});
+    }
+    return table;
+  }
+
+  const std::string _reference_filepath = "resources/test_data/parquet/";
+};
+
+class ParquetParserCodecTest : public ParquetParserTest, public ::testing::WithParamInterface<std::string> {};
+
+INSTANTIATE_TEST_SUITE_P(ParquetCodecs, ParquetParserCodecTest,
+                         ::testing::Values("uncompressed", "snappy", "lz4_raw", "zstd"),
+                         [](const ::testing::TestParamInfo<std::string> info) { return info.param; });
+
+TEST_F(ParquetParserTest, AllTypes) {
+  const auto column_definitions =
+      TableColumnDefinitions{{"a", DataType::Int, false},
+                             {"b", DataType::Long, true},
+                             {"c", DataType::Float, false},
+                             {"d", DataType::Double, true},
+                             {"e", DataType::String, true}};
+  auto expected_table = std::make_shared<Table>(column_definitions, TableType::Data);
+  expected_table->append({12345, NullValue{}, 458.7f, 1.1, pmr_string{"Hello"}});
+  expected_table->append({-7, int64_t{2147483648}, 1.5f, NullValue{}, NullValue{}});
+  expected_table->append({0, int64_t{-3}, -2.25f, NullValue{}, pmr_string{""}});
+  expected_table->append({458, int64_t{5}, 0.0f, -4.75, pmr_string{"Wörld"}});
+  expected_table->append({2147483647, int64_t{7}, 3.5f, 0.5, NullValue{}});
+  expected_table->append({9, NullValue{}, 12.25f, 100.125, pmr_string{"zebra"}});
+  expected_table->append({std::numeric_limits<int32_t>::min(), int64_t{1}, 8.0f, NullValue{}, pmr_string{"apple"}});
+
+  const auto table = ParquetParser::parse(_reference_filepath + "all_types.parquet");
+
+  EXPECT_TABLE_EQ_ORDERED(table, expected_table);
+  EXPECT_EQ(table->uses_mvcc(), UseMvcc::Yes);
+
+  // Each row group becomes an immutable chunk.
+  ASSERT_EQ(table->chunk_count(), ChunkID{2});
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->size(), 4u);
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->size(), 3u);
+  EXPECT_FALSE(table->get_chunk(ChunkID{0})->is_mutable());
+
+  // The file only has the deprecated min/max statistics, which are not used for strings. Thus, the pruning statistics
+  // are left to the StorageManager.
+  EXPECT_FALSE(table->get_chunk(ChunkID{0})->pruning_statistics());
+}
+
+TEST_P(ParquetParserCodecTest, DictionaryEncodedColumns) {
+  const auto table = ParquetParser::parse(_reference_filepath + "dictionary_" + GetParam() + ".parquet");
+
+  EXPECT_TABLE_EQ_ORDERED(table, _expected_dictionary_table());
+  ASSERT_EQ(table->chunk_count(), ChunkID{2});
+
+  // PLAIN-encoded column chunks are not dictionary-encoded in Hyrise either.
+  const auto first_chunk = table->get_chunk(ChunkID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<int32_t>>(first_chunk->get_segment(ColumnID{0})));
+
+  // The categories form ten runs of 100 rows.
+  const auto run_length_segment =
+      std::dynamic_pointer_cast<RunLengthSegment<pmr_string>>(first_chunk->get_segment(ColumnID{1}));
+  ASSERT_TRUE(run_length_segment);
+  EXPECT_EQ(run_length_segment->values()->size(), 10u);
+
+  // The runs of the numbers are too short. Their Parquet dictionary is sorted.
+  const auto dictionary_segment =
+      std::dynamic_pointer_cast<DictionarySegment<int64_t>>(first_chunk->get_segment(ColumnID{2}));
+  ASSERT_TRUE(dictionary_segment);
+  EXPECT_EQ(*dictionary_segment->dictionary(),
+            pmr_vector<int64_t>({-6000, -5000, -3000, -2000, 3000, 4000, 6000}));
+
+  // A column chunk with both dictionary-encoded and PLAIN pages is materialized.
+  const auto second_chunk = table->get_chunk(ChunkID{1});
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<int64_t>>(second_chunk->get_segment(ColumnID{2})));
+}
+
+TEST_F(ParquetParserTest, PruningStatistics) {
+  const auto table = ParquetParser::parse(_reference_filepath + "dictionary_uncompressed.parquet");
+
+  const auto& pruning_statistics = table->get_chunk(ChunkID{1})->pruning_statistics();
+  ASSERT_TRUE(pruning_statistics);
+  ASSERT_EQ(pruning_statistics->size(), 3u);
+
+  const auto id_statistics = std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(pruning_statistics->at(0));
+  ASSERT_TRUE(id_statistics);
+  ASSERT_TRUE(id_statistics->range_filter);
+  EXPECT_EQ(id_statistics->range_filter->ranges, (std::vector<std::pair<int32_t, int32_t>>{{1000, 1499}}));
+
+  const auto category_statistics =
+      std::dynamic_pointer_cast<AttributeStatistics<pmr_string>>(pruning_statistics->at(1));
+  ASSERT_TRUE(category_statistics);
+  ASSERT_TRUE(category_statistics->min_max_filter);
+  EXPECT_EQ(category_statistics->min_max_filter->min, "category_10");
+  EXPECT_EQ(category_statistics->min_max_filter->max, "category_14");
+}
+
+TEST_F(ParquetParserTest, AttachAndLoadSegmentsOnDemand) {
+  const auto table = ParquetParser::attach(_reference_filepath + "dictionary_zstd.parquet");
+  ASSERT_EQ(table->chunk_count(), ChunkID{2});
+  EXPECT_EQ(table->row_count(), 1500u);
+
+  // No column chunk is read when the file is attached.
+  const auto foreign_segment =
+      std::dynamic_pointer_cast<ForeignSegment>(table->get_chunk(ChunkID{0})->get_segment(ColumnID{1}));
+  ASSERT_TRUE(foreign_segment);
+  EXPECT_EQ(foreign_segment->size(), 1000u);
+  EXPECT_EQ(foreign_segment->data_type(), DataType::String);
+  EXPECT_THROW((*foreign_segment)[ChunkOffset{0}], std::logic_error);
+  EXPECT_TRUE(std::dynamic_pointer_cast<RunLengthSegment<pmr_string>>(foreign_segment->load()));
+
+  // The pruning statistics are taken from the file.
+  EXPECT_TRUE(table->get_chunk(ChunkID{0})->pruning_statistics());
+
+  Hyrise::get().storage_manager.add_table("attached", table);
+
+  auto get_table = std::make_shared<GetTable>("attached");
+  get_table->execute();
+  EXPECT_TABLE_EQ_ORDERED(get_table->get_output(), _expected_dictionary_table());
+
+  // Only the chunks and columns that are not pruned are loaded.
+  get_table = std::make_shared<GetTable>("attached", std::vector{ChunkID{0}}, std::vector{ColumnID{0}});
+  get_table->execute();
+  const auto output = get_table->get_output();
+  ASSERT_EQ(output->chunk_count(), ChunkID{1});
+  ASSERT_EQ(output->column_count(), ColumnCount{2});
+  const auto output_chunk = output->get_chunk(ChunkID{0});
+  EXPECT_TRUE(std::dynamic_pointer_cast<RunLengthSegment<pmr_string>>(output_chunk->get_segment(ColumnID{0})));
+  EXPECT_TRUE(std::dynamic_pointer_cast<ValueSegment<int64_t>>(output_chunk->get_segment(ColumnID{1})));
+  EXPECT_EQ(output->get_value<pmr_string>(ColumnID{0}, 0), "category_10");
+  EXPECT_EQ(output->get_value<int64_t>(ColumnID{1}, 0), int64_t{-5000});
+
+  // The stored table keeps its ForeignSegments.
+  EXPECT_TRUE(std::dynamic_pointer_cast<ForeignSegment>(table->get_chunk(ChunkID{1})->get_segment(ColumnID{1})));
+}
+
+TEST_F(ParquetParserTest, EncodingLeavesAttachedFileUnchanged) {
+  const auto table = ParquetParser::attach(_reference_filepath + "dictionary_zstd.parquet");
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::Dictionary});
+  EXPECT_TRUE(std::dynamic_pointer_cast<ForeignSegment>(table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+}
+
+TEST_F(ParquetParserTest, TableStatisticsOfAttachedFile) {
+  const auto table = ParquetParser::attach(_reference_filepath + "dictionary_snappy.parquet");
+  const auto table_statistics = table->table_statistics();
+  ASSERT_TRUE(table_statistics);
+  EXPECT_EQ(table_statistics->row_count, 1500.0f);
+
+  // The StorageManager does not overwrite the statistics, which would require reading the entire file.
+  Hyrise::get().storage_manager.add_table("attached", table);
+  EXPECT_EQ(table->table_statistics(), table_statistics);
+
+  const auto id_statistics =
+      std::dynamic_pointer_cast<AttributeStatistics<int32_t>>(table_statistics->column_statistics[0]);
+  ASSERT_TRUE(id_statistics);
+  ASSERT_TRUE(id_statistics->histogram);
+  EXPECT_EQ(id_statistics->histogram->bin_minimum(BinID{0}), 0);
+  EXPECT_EQ(id_statistics->histogram->bin_maximum(BinID{0}), 1499);
+  EXPECT_FLOAT_EQ(id_statistics->histogram->total_count(), 1500.0f);
+
+  const auto number_statistics =
+      std::dynamic_pointer_cast<AttributeStatistics<int64_t>>(table_statistics->column_statistics[2]);
+  ASSERT_TRUE(number_statistics);
+  ASSERT_TRUE(number_statistics->null_value_ratio);
+  EXPECT_FLOAT_EQ(number_statistics->null_value_ratio->ratio, 215.0f / 1500.0f);
+  ASSERT_TRUE(number_statistics->histogram);
+  EXPECT_EQ(number_statistics->histogram->bin_minimum(BinID{0}), -6000);
+  EXPECT_EQ(number_statistics->histogram->bin_maximum(BinID{0}), 6000);
+  EXPECT_FLOAT_EQ(number_statistics->histogram->total_count(), 1285.0f);
+
+  const auto category_statistics =
+      std::dynamic_pointer_cast<AttributeStatistics<pmr_string>>(table_statistics->column_statistics[1]);
+  ASSERT_TRUE(category_statistics);
+  ASSERT_TRUE(category_statistics->histogram);
+  EXPECT_EQ(category_statistics->histogram->bin_minimum(BinID{0}), "category_0");
+  EXPECT_EQ(category_statistics->histogram->bin_maximum(BinID{0}), "category_9");
+}
+
+TEST_F(ParquetParserTest, InvalidFiles) {
+  EXPECT_THROW(ParquetParser::parse(_reference_filepath + "unsupported_type.parquet"), std::logic_error);
+  EXPECT_THROW(ParquetParser::parse("resources/test_data/tbl/float.tbl"), std::logic_error);
+  EXPECT_THROW(ParquetParser::attach("resources/test_data/tbl/float.tbl"), std::logic_error);
+}
+
+}  // namespace opossum
@@ -0,0 +1,255 @@
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <sstream>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "import_export/parquet/parquet_parser.hpp"
+#include "logging/checkpoint_loader.hpp"
+#include "logging/checkpoint_writer.hpp"
+#include "logging/wal_recovery.hpp"
+#include "logging/write_ahead_log.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "statistics/statistics_objects/min_max_filter.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/foreign_segment.hpp"
+#include "storage/segment_encoding_utils.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class CheckpointTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove(_checkpoint_path);
+    std::filesystem::remove(_log_path);
+  }
+
+  void TearDown() override {
+    Hyrise::get().write_ahead_log = nullptr;
+    std::filesystem::remove(_checkpoint_path);
+    std::filesystem::remove(_log_path);
+  }
+
+  static std::shared_ptr<const Table> _execute(const std::string& sql) {
+    auto pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    const auto [pipeline_status, table] = pipeline.get_result_table();
+    EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+    return table;
+  }
+
+  const std::string _checkpoint_path = test_data_path + "checkpoint_test.checkpoint";
+  const std::string _log_path = test_data_path + "checkpoint_test.log";
+};
+
+class CheckpointMultiEncodingTest : public CheckpointTest, public ::testing::WithParamInterface<EncodingType> {};
+
+auto checkpoint_encoding_formatter = [](const ::testing::TestParamInfo<EncodingType> info) {
+  auto stream = std::stringstream{};
+  stream << info.param;
+
+  auto string = stream.str();
+  string.erase(std::remove_if(string.begin(), string.end(), [](char c) { return !std::isalnum(c); }), string.end());
+
+  return string;
+};
+
+INSTANTIATE_TEST_SUITE_P(CheckpointEncodingTypes, CheckpointMultiEncodingTest,
+                         ::testing::Values(EncodingType::Unencoded, EncodingType::Dictionary, EncodingType::RunLength,
+                                           EncodingType::FrameOfReference, EncodingType::LZ4),
+                         checkpoint_encoding_formatter);
+
+TEST_P(CheckpointMultiEncodingTest, RestoresEncodedTables) {
+  const auto table = load_table("resources/test_data/tbl/int_int_w_null_8_rows.tbl", ChunkOffset{3});
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{GetParam()});
+  generate_chunk_pruning_statistics(table);
+  table->get_chunk(ChunkID{2})->set_individually_sorted_by(SortColumnDefinition{ColumnID{0}, SortMode::Descending});
+  Hyrise::get().storage_manager.add_table("t", table);
+
+  const auto commit_id = CheckpointWriter::write(_checkpoint_path);
+  EXPECT_EQ(commit_id, Hyrise::get().transaction_manager.last_commit_id());
+
+  Hyrise::reset();
+  EXPECT_EQ(CheckpointLoader::load(_checkpoint_path), commit_id);
+
+  const auto restored_table = Hyrise::get().storage_manager.get_table("t");
+  EXPECT_TABLE_EQ_ORDERED(restored_table, table);
+  ASSERT_EQ(restored_table->chunk_count(), table->chunk_count());
+  EXPECT_EQ(restored_table->target_chunk_size(), table->target_chunk_size());
+  EXPECT_EQ(Hyrise::get().transaction_manager.last_commit_id(), commit_id);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto chunk = table->get_chunk(chunk_id);
+    const auto restored_chunk = restored_table->get_chunk(chunk_id);
+    EXPECT_FALSE(restored_chunk->is_mutable());
+    EXPECT_EQ(restored_chunk->individually_sorted_by(), chunk->individually_sorted_by());
+
+    for (auto column_id = ColumnID{0}; column_id < table->column_count(); ++column_id) {
+      EXPECT_EQ(get_segment_encoding_spec(restored_chunk->get_segment(column_id)),
+                get_segment_encoding_spec(chunk->get_segment(column_id)));
+    }
+
+    ASSERT_TRUE(restored_chunk->pruning_statistics());
+    const auto& statistics =
+        static_cast<const AttributeStatistics<int32_t>&>(*restored_chunk->pruning_statistics()->at(0));
+    const auto& expected_statistics =
+        static_cast<const AttributeStatistics<int32_t>&>(*chunk->pruning_statistics()->at(0));
+    ASSERT_EQ(static_cast<bool>(statistics.range_filter), static_cast<bool>(expected_statistics.range_filter));
+    if (expected_statistics.range_filter) {
+      EXPECT_EQ(statistics.range_filter->ranges, expected_statistics.range_filter->ranges);
+    }
+  }
+}
+
+TEST_F(CheckpointTest, RestoresStringStatistics) {
+  const auto table = load_table("resources/test_data/tbl/int_float_double_string.tbl", ChunkOffset{3});
+  ChunkEncoder::encode_all_chunks(table, ChunkEncodingSpec{SegmentEncodingSpec{EncodingType::Dictionary},
+                                                           SegmentEncodingSpec{EncodingType::Dictionary},
+                                                           SegmentEncodingSpec{EncodingType::Unencoded},
+                                                           SegmentEncodingSpec{EncodingType::FixedStringDictionary}});
+  generate_chunk_pruning_statistics(table);
+  Hyrise::get().storage_manager.add_table("t", table);
+
+  CheckpointWriter::write(_checkpoint_path);
+  Hyrise::reset();
+  CheckpointLoader::load(_checkpoint_path);
+
+  const auto restored_table = Hyrise::get().storage_manager.get_table("t");
+  EXPECT_TABLE_EQ_ORDERED(restored_table, table);
+
+  const auto restored_chunk = restored_table->get_chunk(ChunkID{0});
+  const auto& statistics =
+      static_cast<const AttributeStatistics<pmr_string>&>(*restored_chunk->pruning_statistics()->at(3));
+  ASSERT_TRUE(statistics.min_max_filter);
+  EXPECT_EQ(statistics.min_max_filter->min, "b");
+  EXPECT_EQ(statistics.min_max_filter->max, "d");
+}
+
+TEST_F(CheckpointTest, RestoresMvccDataAndMutableChunks) {
+  _execute("CREATE TABLE t (a INT, b VARCHAR(10))");
+  _execute("INSERT INTO t VALUES (1, 'one'); INSERT INTO t VALUES (2, 'two'); INSERT INTO t VALUES (3, 'three');");
+  _execute("DELETE FROM t WHERE a = 2");
+  const auto expected_table = _execute("SELECT * FROM t");
+
+  const auto commit_id = CheckpointWriter::write(_checkpoint_path);
+  Hyrise::reset();
+  CheckpointLoader::load(_checkpoint_path);
+
+  const auto table = Hyrise::get().storage_manager.get_table("t");
+  EXPECT_EQ(table->row_count(), 3);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->invalid_row_count(), 1);
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM t"), expected_table);
+
+  // The last chunk is still mutable and can be inserted into
+  EXPECT_TRUE(table->last_chunk()->is_mutable());
+  _execute("INSERT INTO t VALUES (4, 'four')");
+  EXPECT_EQ(table->chunk_count(), 1);
+  EXPECT_EQ(_execute("SELECT * FROM t")->row_count(), 3);
+  EXPECT_EQ(Hyrise::get().transaction_manager.last_commit_id(), commit_id + 1);
+}
+
+TEST_F(CheckpointTest, RestoresAttachedFiles) {
+  const auto filename = std::string{"resources/test_data/parquet/dictionary_zstd.parquet"};
+  Hyrise::get().storage_manager.add_table("t", ParquetParser::attach(filename));
+
+  CheckpointWriter::write(_checkpoint_path);
+  Hyrise::reset();
+  CheckpointLoader::load(_checkpoint_path);
+
+  // The checkpoint holds the data of the file, so the restored segments are no ForeignSegments.
+  const auto table = Hyrise::get().storage_manager.get_table("t");
+  ASSERT_EQ(table->chunk_count(), ChunkID{2});
+  EXPECT_FALSE(std::dynamic_pointer_cast<ForeignSegment>(table->get_chunk(ChunkID{0})->get_segment(ColumnID{0})));
+  EXPECT_TABLE_EQ_ORDERED(table, ParquetParser::parse(filename));
+  EXPECT_EQ(_execute("SELECT * FROM t WHERE id < 10")->row_count(), 10);
+}
+
+TEST_F(CheckpointTest, ExcludesLaterCommits) {
+  _execute("CREATE TABLE t (a INT, b VARCHAR(10))");
+  _execute("INSERT INTO t VALUES (1, 'one'); INSERT INTO t VALUES (2, 'two');");
+
+  // An uncommitted insert and an uncommitted delete
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto pipeline = SQLPipelineBuilder{"INSERT INTO t VALUES (3, 'three'); DELETE FROM t WHERE a = 1;"}
+                      .with_transaction_context(transaction_context)
+                      .create_pipeline();
+  pipeline.get_result_table();
+
+  CheckpointWriter::write(_checkpoint_path);
+  transaction_context->commit();
+
+  Hyrise::reset();
+  CheckpointLoader::load(_checkpoint_path);
+
+  const auto table = Hyrise::get().storage_manager.get_table("t");
+  EXPECT_EQ(table->row_count(), 3);
+  EXPECT_EQ(_execute("SELECT * FROM t")->row_count(), 2);
+  EXPECT_EQ(_execute("SELECT * FROM t WHERE a = 1")->row_count(), 1);
+}
+
+TEST_F(CheckpointTest, RecoversLogAfterCheckpoint) {
+  _execute("CREATE TABLE t (a INT, b VARCHAR(10))");
+  Hyrise::get().write_ahead_log = std::make_shared<WriteAheadLog>(_log_path);
+  _execute("INSERT INTO t VALUES (1, 'one'); INSERT INTO t VALUES (2, 'two');");
+
+  // A transaction that commits while the checkpoint is written is only recovered from the log.
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto pipeline = SQLPipelineBuilder{"INSERT INTO t VALUES (3, 'three'); DELETE FROM t WHERE a = 1;"}
+                      .with_transaction_context(transaction_context)
+                      .create_pipeline();
+  pipeline.get_result_table();
+
+  CheckpointWriter::write(_checkpoint_path);
+  transaction_context->commit();
+  _execute("INSERT INTO t VALUES (4, 'four')");
+
+  const auto expected_table = _execute("SELECT * FROM t");
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+
+  Hyrise::reset();
+  CheckpointLoader::load(_checkpoint_path);
+  EXPECT_EQ(WalRecovery::recover(_log_path), 2);
+
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM t"), expected_table);
+  EXPECT_EQ(Hyrise::get().transaction_manager.last_commit_id(), last_commit_id);
+}
+
+TEST_F(CheckpointTest, ReplacesPreviousCheckpoint) {
+  Hyrise::get().storage_manager.add_table("t", load_table("resources/test_data/tbl/int_float.tbl"));
+  CheckpointWriter::write(_checkpoint_path);
+
+  Hyrise::get().storage_manager.add_table("u", load_table("resources/test_data/tbl/int_float.tbl"));
+  CheckpointWriter::write(_checkpoint_path);
+  EXPECT_FALSE(std::filesystem::exists(_checkpoint_path + ".tmp"));
+
+  Hyrise::reset();
+  CheckpointLoader::load(_checkpoint_path);
+  EXPECT_TRUE(Hyrise::get().storage_manager.has_table("t"));
+  EXPECT_TRUE(Hyrise::get().storage_manager.has_table("u"));
+}
+
+TEST_F(CheckpointTest, RejectsInvalidFiles) {
+  std::ofstream{_checkpoint_path} << "no checkpoint";
+  EXPECT_THROW(CheckpointLoader::load(_checkpoint_path), std::logic_error);
+
+  Hyrise::get().storage_manager.add_table("t", load_table("resources/test_data/tbl/int_float.tbl"));
+  CheckpointWriter::write(_checkpoint_path);
+
+  // Tables must not exist yet
+  EXPECT_THROW(CheckpointLoader::load(_checkpoint_path), std::logic_error);
+
+  // Truncated files are detected
+  Hyrise::reset();
+  std::filesystem::resize_file(_checkpoint_path, std::filesystem::file_size(_checkpoint_path) / 2);
+  EXPECT_THROW(CheckpointLoader::load(_checkpoint_path), std::logic_error);
+}
+
+}  // namespace opossum
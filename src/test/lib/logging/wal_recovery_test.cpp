@@ -0,0 +1,193 @@
+#include <filesystem>
+#include <memory>
+#include <string>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "logging/wal_recovery.hpp"
+#include "logging/write_ahead_log.hpp"
+#include "operators/delete.hpp"
+#include "operators/get_table.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/validate.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class WalRecoveryTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove(_log_path);
+    _add_table();
+    Hyrise::get().write_ahead_log = std::make_shared<WriteAheadLog>(_log_path);
+  }
+
+  void TearDown() override {
+    Hyrise::get().write_ahead_log = nullptr;
+    std::filesystem::remove(_log_path);
+  }
+
+  // Adds the table in the state it has when logging starts. The small chunk size makes inserts span multiple chunks.
+  static void _add_table() {
+    const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::String, true}};
+    auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{2}, UseMvcc::Yes);
+    table->append({0, pmr_string{"initial"}});
+    Hyrise::get().storage_manager.add_table("t", table);
+  }
+
+  // Loses all in-memory state, as a crash would, and restores the table's initial state.
+  static void _crash() {
+    Hyrise::reset();
+    _add_table();
+  }
+
+  static std::shared_ptr<const Table> _execute(const std::string& sql) {
+    auto pipeline = SQLPipelineBuilder{sql}.create_pipeline();
+    const auto [pipeline_status, table] = pipeline.get_result_table();
+    EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+    return table;
+  }
+
+  const std::string _log_path = test_data_path + "wal_recovery_test.log";
+};
+
+TEST_F(WalRecoveryTest, RecoversCommittedTransactions) {
+  _execute("INSERT INTO t VALUES (1, 'one'); INSERT INTO t VALUES (2, NULL); INSERT INTO t VALUES (3, 'three');");
+  _execute("UPDATE t SET b = 'two' WHERE a = 2; DELETE FROM t WHERE a = 3 OR a = 0;");
+  _execute("INSERT INTO t SELECT a + 10, b FROM t;");
+
+  const auto expected_table = _execute("SELECT * FROM t");
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+
+  _crash();
+  EXPECT_EQ(WalRecovery::recover(_log_path), 6);
+
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM t"), expected_table);
+  EXPECT_EQ(Hyrise::get().transaction_manager.last_commit_id(), last_commit_id);
+
+  // New transactions continue after the recovered ones
+  Hyrise::get().write_ahead_log = std::make_shared<WriteAheadLog>(_log_path);
+  _execute("DELETE FROM t WHERE a = 11");
+  EXPECT_EQ(Hyrise::get().transaction_manager.last_commit_id(), last_commit_id + 1);
+  EXPECT_EQ(_execute("SELECT * FROM t")->row_count(), 3);
+
+  // Recovery works repeatedly
+  _crash();
+  EXPECT_EQ(WalRecovery::recover(_log_path), 7);
+  EXPECT_EQ(_execute("SELECT * FROM t")->row_count(), 3);
+}
+
+TEST_F(WalRecoveryTest, RestoresRowsAtTheirPositions) {
+  // The rolled back row is not logged, but it occupies a position in the table.
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto pipeline = SQLPipelineBuilder{"INSERT INTO t VALUES (1, 'rolled back')"}
+                      .with_transaction_context(transaction_context)
+                      .create_pipeline();
+  pipeline.get_result_table();
+  transaction_context->rollback(RollbackReason::User);
+
+  _execute("INSERT INTO t VALUES (2, 'two'); INSERT INTO t VALUES (3, 'three');");
+  _execute("DELETE FROM t WHERE a = 2");
+
+  _crash();
+  EXPECT_EQ(WalRecovery::recover(_log_path), 3);
+
+  const auto table = Hyrise::get().storage_manager.get_table("t");
+  ASSERT_EQ(table->chunk_count(), 2);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->invalid_row_count(), 1);
+  EXPECT_EQ(table->get_value<int32_t>(ColumnID{0}, 2), 2);
+  EXPECT_EQ(table->get_value<int32_t>(ColumnID{0}, 3), 3);
+
+  const auto result = _execute("SELECT a FROM t");
+  ASSERT_EQ(result->row_count(), 2);
+  EXPECT_TABLE_EQ_UNORDERED(result, _execute("SELECT a FROM t WHERE a = 0 OR a = 3"));
+}
+
+TEST_F(WalRecoveryTest, RecoversDeletesAfterPrunedChunks) {
+  _execute("INSERT INTO t VALUES (1, 'one'); INSERT INTO t VALUES (2, 'two'); INSERT INTO t VALUES (3, 'three');");
+
+  // GetTable prunes the first chunk. Thus, the deleted row is in the first chunk of its output, but in the second
+  // chunk of the stored table.
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto get_table = std::make_shared<GetTable>("t", std::vector{ChunkID{0}}, std::vector<ColumnID>{});
+  const auto validate = std::make_shared<Validate>(get_table);
+  const auto table_scan = create_table_scan(validate, ColumnID{0}, PredicateCondition::Equals, 3);
+  const auto delete_op = std::make_shared<Delete>(table_scan);
+  for (const auto& op : std::vector<std::shared_ptr<AbstractOperator>>{get_table, validate, table_scan, delete_op}) {
+    op->set_transaction_context(transaction_context);
+  }
+  execute_all({get_table, validate, table_scan, delete_op});
+  ASSERT_FALSE(delete_op->execute_failed());
+  transaction_context->commit();
+
+  const auto expected_table = _execute("SELECT * FROM t");
+  ASSERT_EQ(expected_table->row_count(), 3);
+
+  _crash();
+  EXPECT_EQ(WalRecovery::recover(_log_path), 4);
+
+  const auto table = Hyrise::get().storage_manager.get_table("t");
+  ASSERT_EQ(table->chunk_count(), 2);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->invalid_row_count(), 0);
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->invalid_row_count(), 1);
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM t"), expected_table);
+}
+
+TEST_F(WalRecoveryTest, RecoversUpdatesInPlace) {
+  _execute("INSERT INTO t VALUES (1, 'one')");
+
+  // Rows of immutable chunks are updated in place, so they keep their positions.
+  Hyrise::get().storage_manager.get_table("t")->get_chunk(ChunkID{0})->finalize();
+  _execute("UPDATE t SET b = 'updated' WHERE a = 1");
+  _execute("UPDATE t SET b = NULL WHERE a = 0; UPDATE t SET a = 2 WHERE a = 1;");
+  EXPECT_EQ(Hyrise::get().storage_manager.get_table("t")->row_count(), 2);
+
+  const auto expected_table = _execute("SELECT * FROM t");
+
+  _crash();
+  EXPECT_EQ(WalRecovery::recover(_log_path), 4);
+
+  const auto table = Hyrise::get().storage_manager.get_table("t");
+  EXPECT_EQ(table->row_count(), 2);
+  const auto row_versions = table->get_chunk(ChunkID{0})->mvcc_data()->row_versions();
+  ASSERT_TRUE(row_versions);
+  EXPECT_EQ(row_versions->row_count(), 2);
+  EXPECT_TABLE_EQ_UNORDERED(_execute("SELECT * FROM t"), expected_table);
+}
+
+TEST_F(WalRecoveryTest, DiscardsTornRecord) {
+  // Commits only return once their record is durable
+  _execute("INSERT INTO t VALUES (1, 'one')");
+  const auto first_record_size = std::filesystem::file_size(_log_path);
+
+  _execute("INSERT INTO t VALUES (2, 'two')");
+  Hyrise::get().write_ahead_log = nullptr;
+
+  // Simulate a crash while the second record was written
+  std::filesystem::resize_file(_log_path, std::filesystem::file_size(_log_path) - 3);
+
+  _crash();
+  EXPECT_EQ(WalRecovery::recover(_log_path), 1);
+  EXPECT_EQ(std::filesystem::file_size(_log_path), first_record_size);
+  EXPECT_EQ(_execute("SELECT * FROM t")->row_count(), 2);
+}
+
+TEST_F(WalRecoveryTest, RequiresLoggedTables) {
+  _execute("INSERT INTO t VALUES (1, 'one')");
+
+  Hyrise::reset();
+  EXPECT_THROW(WalRecovery::recover(_log_path), std::logic_error);
+}
+
+TEST_F(WalRecoveryTest, MissingLog) {
+  Hyrise::get().write_ahead_log = nullptr;
+  std::filesystem::remove(_log_path);
+  EXPECT_EQ(WalRecovery::recover(_log_path), 0);
+}
+
+}  // namespace opossum
@@ -0,0 +1,144 @@
+#include <atomic>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "logging/wal_commit_record.hpp"
+#include "logging/write_ahead_log.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class WriteAheadLogTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    std::filesystem::remove(_log_path);
+
+    _table = load_table("resources/test_data/tbl/int_string.tbl", ChunkOffset{3});
+    _empty_table = std::make_shared<Table>(_table->column_definitions(), TableType::Data, ChunkOffset{3},
+                                           UseMvcc::Yes);
+    Hyrise::get().storage_manager.add_table("target", _empty_table);
+  }
+
+  void TearDown() override {
+    Hyrise::get().write_ahead_log = nullptr;
+    std::filesystem::remove(_log_path);
+  }
+
+  const std::string _log_path = test_data_path + "write_ahead_log_test.log";
+  std::shared_ptr<Table> _table, _empty_table;
+};
+
+TEST_F(WriteAheadLogTest, AppendAndFlush) {
+  auto write_ahead_log = WriteAheadLog{_log_path};
+
+  auto durable_count = std::atomic<size_t>{0};
+  write_ahead_log.append(std::vector<char>(10, 'a'), [&]() { ++durable_count; });
+  write_ahead_log.append(std::vector<char>(20, 'b'), [&]() { ++durable_count; });
+  write_ahead_log.flush();
+
+  EXPECT_EQ(durable_count, 2);
+  EXPECT_EQ(std::filesystem::file_size(_log_path), 30);
+
+  const auto statistics = write_ahead_log.statistics();
+  EXPECT_EQ(statistics.commit_count, 2);
+  EXPECT_EQ(statistics.bytes_written, 30);
+  EXPECT_EQ(statistics.commit_latencies.size(), 2);
+  EXPECT_GE(statistics.flush_count, 1);
+  EXPECT_LE(statistics.flush_count, 2);
+}
+
+TEST_F(WriteAheadLogTest, GroupCommit) {
+  // With a group commit delay, the records of concurrent committers are synced together.
+  constexpr auto THREAD_COUNT = 8;
+  constexpr auto RECORDS_PER_THREAD = 50;
+
+  auto write_ahead_log = WriteAheadLog{_log_path, std::chrono::microseconds{500}};
+
+  auto durable_count = std::atomic<size_t>{0};
+  auto threads = std::vector<std::thread>{};
+  for (auto thread_id = 0; thread_id < THREAD_COUNT; ++thread_id) {
+    threads.emplace_back([&]() {
+      for (auto record_id = 0; record_id < RECORDS_PER_THREAD; ++record_id) {
+        write_ahead_log.append(std::vector<char>(8, 'x'), [&]() { ++durable_count; });
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  write_ahead_log.flush();
+
+  EXPECT_EQ(durable_count, THREAD_COUNT * RECORDS_PER_THREAD);
+
+  const auto statistics = write_ahead_log.statistics();
+  EXPECT_EQ(statistics.commit_count, THREAD_COUNT * RECORDS_PER_THREAD);
+  EXPECT_LT(statistics.flush_count, statistics.commit_count);
+  EXPECT_EQ(std::filesystem::file_size(_log_path), THREAD_COUNT * RECORDS_PER_THREAD * 8);
+}
+
+TEST_F(WriteAheadLogTest, CommitIsVisibleOnceDurable) {
+  Hyrise::get().write_ahead_log = std::make_shared<WriteAheadLog>(_log_path);
+
+  auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  table_wrapper->execute();
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto insert = std::make_shared<Insert>("target", table_wrapper);
+  insert->set_transaction_context(transaction_context);
+  insert->execute();
+
+  transaction_context->commit();
+  EXPECT_EQ(transaction_context->phase(), TransactionPhase::Committed);
+  EXPECT_EQ(Hyrise::get().transaction_manager.last_commit_id(), transaction_context->commit_id());
+  EXPECT_EQ(Hyrise::get().write_ahead_log->statistics().commit_count, 1);
+
+  // Read the record back from the log
+  auto data = std::vector<char>(std::filesystem::file_size(_log_path));
+  std::ifstream{_log_path, std::ios::binary}.read(data.data(), static_cast<std::streamsize>(data.size()));
+
+  auto record_size = size_t{0};
+  const auto record = WalCommitRecord::deserialize(data.data(), data.size(), record_size);
+  ASSERT_TRUE(record);
+  EXPECT_EQ(record_size, data.size());
+  EXPECT_EQ(record->commit_id, transaction_context->commit_id());
+
+  // The three-row chunks of the input are inserted into chunks of the same size.
+  ASSERT_EQ(record->entries.size(), _empty_table->chunk_count());
+  auto row_index = size_t{0};
+  for (const auto& entry : record->entries) {
+    EXPECT_EQ(entry.type, WalEntryType::Insert);
+    EXPECT_EQ(entry.table_name, "target");
+    ASSERT_EQ(entry.rows.size(), entry.row_ids.size());
+    for (const auto& row : entry.rows) {
+      EXPECT_EQ(row, _table->get_row(row_index));
+      ++row_index;
+    }
+  }
+  EXPECT_EQ(row_index, _table->row_count());
+
+  // Corrupted records are rejected
+  data[data.size() / 2] ^= 1;
+  EXPECT_FALSE(WalCommitRecord::deserialize(data.data(), data.size(), record_size));
+  EXPECT_FALSE(WalCommitRecord::deserialize(data.data(), data.size() - 1, record_size));
+}
+
+TEST_F(WriteAheadLogTest, ReadOnlyTransactionsAreNotLogged) {
+  Hyrise::get().write_ahead_log = std::make_shared<WriteAheadLog>(_log_path);
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  transaction_context->commit();
+
+  EXPECT_EQ(transaction_context->phase(), TransactionPhase::Committed);
+  EXPECT_EQ(Hyrise::get().write_ahead_log->statistics().commit_count, 0);
+  EXPECT_EQ(std::filesystem::file_size(_log_path), 0);
+}
+
+}  // namespace opossum
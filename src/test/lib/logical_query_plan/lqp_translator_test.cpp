@@ -45,6 +45,7 @@
 #include "operators/maintenance/create_prepared_plan.hpp"
 #include "operators/maintenance/create_table.hpp"
 #include "operators/maintenance/drop_table.hpp"
+#include "operators/pipelined_scan.hpp"
 #include "operators/product.hpp"
 #include "operators/projection.hpp"
 #include "operators/sort.hpp"
@@ -397,6 +398,57 @@ TEST_F(LQPTranslatorTest, PredicateNodeBetweenScan) {
   EXPECT_EQ(*table_scan_op->predicate(), *between_inclusive_(a, 42, 1337));
 }
 
+TEST_F(LQPTranslatorTest, PipelinedScan) {
+  // clang-format off
+  const auto lqp =
+  PredicateNode::make(greater_than_(int_float_b, 100.0f),
+    PredicateNode::make(less_than_(int_float_a, 1000),
+      ValidateNode::make(int_float_node)));
+  // clang-format on
+
+  const auto op = LQPTranslator{UsePipelinedExecution::Yes}.translate_node(lqp);
+
+  const auto pipelined_scan = std::dynamic_pointer_cast<PipelinedScan>(op);
+  ASSERT_TRUE(pipelined_scan);
+  EXPECT_EQ(pipelined_scan->lqp_node, lqp);
+  EXPECT_TRUE(pipelined_scan->validates());
+
+  const auto a = PQPColumnExpression::from_table(*table_int_float, "a");
+  const auto b = PQPColumnExpression::from_table(*table_int_float, "b");
+  ASSERT_EQ(pipelined_scan->predicates().size(), 2);
+  EXPECT_EQ(*pipelined_scan->predicates()[0], *less_than_(a, 1000));
+  EXPECT_EQ(*pipelined_scan->predicates()[1], *greater_than_(b, 100.0f));
+
+  EXPECT_EQ(pipelined_scan->left_input()->type(), OperatorType::GetTable);
+
+  // Without pipelined execution, every node becomes an operator of its own
+  const auto unpipelined_op = LQPTranslator{}.translate_node(lqp);
+  EXPECT_EQ(unpipelined_op->type(), OperatorType::TableScan);
+  EXPECT_EQ(unpipelined_op->left_input()->type(), OperatorType::TableScan);
+  EXPECT_EQ(unpipelined_op->left_input()->left_input()->type(), OperatorType::Validate);
+}
+
+TEST_F(LQPTranslatorTest, PipelinedScanStopsAtSharedNode) {
+  // The lower PredicateNode is used by two outputs and must not be fused into either of them.
+  const auto shared_predicate_node = PredicateNode::make(less_than_(int_float_a, 1000), int_float_node);
+
+  // clang-format off
+  const auto lqp =
+  UnionNode::make(SetOperationMode::Positions,
+    PredicateNode::make(greater_than_(int_float_b, 100.0f),
+      shared_predicate_node),
+    PredicateNode::make(greater_than_(int_float_b, 200.0f),
+      shared_predicate_node));
+  // clang-format on
+
+  const auto op = LQPTranslator{UsePipelinedExecution::Yes}.translate_node(lqp);
+
+  EXPECT_EQ(op->left_input()->type(), OperatorType::TableScan);
+  EXPECT_EQ(op->right_input()->type(), OperatorType::TableScan);
+  EXPECT_EQ(op->left_input()->left_input(), op->right_input()->left_input());
+  EXPECT_EQ(op->left_input()->left_input()->type(), OperatorType::TableScan);
+}
+
 // Tests accessing the original LQP node after translation.
 TEST_F(LQPTranslatorTest, LQPNodeAccess) {
   auto predicate_node = PredicateNode::make(between_inclusive_(int_float_a, 42, 1337), int_float_node);
@@ -0,0 +1,92 @@
+#include <filesystem>
+#include <limits>
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "memory/memory_budget_resource.hpp"
+#include "memory/spill_file.hpp"
+
+namespace opossum {
+
+class MemoryBudgetResourceTest : public BaseTest {};
+
+TEST_F(MemoryBudgetResourceTest, TracksAllocations) {
+  auto resource = MemoryBudgetResource{1'000};
+  EXPECT_EQ(resource.budget(), 1'000);
+  EXPECT_EQ(resource.available_bytes(), 1'000);
+
+  auto* const pointer = resource.allocate(400, 8);
+  EXPECT_EQ(resource.used_bytes(), 400);
+  EXPECT_EQ(resource.available_bytes(), 600);
+
+  // Allocations are not limited by the budget.
+  auto* const other_pointer = resource.allocate(800, 8);
+  EXPECT_EQ(resource.used_bytes(), 1'200);
+  EXPECT_EQ(resource.available_bytes(), 0);
+
+  resource.deallocate(pointer, 400, 8);
+  resource.deallocate(other_pointer, 800, 8);
+  EXPECT_EQ(resource.used_bytes(), 0);
+  EXPECT_EQ(resource.peak_bytes(), 1'200);
+}
+
+TEST_F(MemoryBudgetResourceTest, Reservations) {
+  const auto resource = std::make_shared<MemoryBudgetResource>(1'000);
+
+  {
+    auto reservation = MemoryReservation{resource};
+    EXPECT_TRUE(reservation.try_reserve(700));
+    EXPECT_FALSE(reservation.try_reserve(400));
+    EXPECT_EQ(reservation.reserved_bytes(), 700);
+    EXPECT_EQ(resource->used_bytes(), 700);
+
+    reservation.reserve(400);
+    EXPECT_EQ(reservation.reserved_bytes(), 1'100);
+    EXPECT_EQ(resource->available_bytes(), 0);
+  }
+
+  // The reservation is released when it goes out of scope.
+  EXPECT_EQ(resource->used_bytes(), 0);
+  EXPECT_EQ(resource->peak_bytes(), 1'100);
+
+  // Without a resource, all reservations succeed.
+  auto unbudgeted_reservation = MemoryReservation{nullptr};
+  EXPECT_TRUE(unbudgeted_reservation.try_reserve(std::numeric_limits<size_t>::max()));
+}
+
+TEST_F(MemoryBudgetResourceTest, SpillFileRoundTrip) {
+  auto path = std::filesystem::path{};
+
+  {
+    auto spill_file = SpillFile{std::filesystem::temp_directory_path()};
+    path = spill_file.path();
+    EXPECT_TRUE(std::filesystem::exists(path));
+
+    spill_file.write(int32_t{17});
+    spill_file.write(pmr_string{"hello world"});
+    spill_file.write(RowID{ChunkID{3}, ChunkOffset{4}});
+    spill_file.write(pmr_string{});
+    EXPECT_EQ(spill_file.size(), sizeof(int32_t) + sizeof(size_t) + 11 + sizeof(RowID) + sizeof(size_t));
+
+    spill_file.start_reading();
+    auto int_value = int32_t{};
+    auto string_value = pmr_string{};
+    auto row_id = RowID{};
+    auto empty_string = pmr_string{"not empty"};
+    spill_file.read(int_value);
+    spill_file.read(string_value);
+    spill_file.read(row_id);
+    spill_file.read(empty_string);
+
+    EXPECT_EQ(int_value, 17);
+    EXPECT_EQ(string_value, "hello world");
+    EXPECT_EQ(row_id, (RowID{ChunkID{3}, ChunkOffset{4}}));
+    EXPECT_TRUE(empty_string.empty());
+  }
+
+  // The file is removed when the SpillFile is destroyed.
+  EXPECT_FALSE(std::filesystem::exists(path));
+}
+
+}  // namespace opossum
@@ -10,6 +10,7 @@
 #include "base_test.hpp"
 
 #include "expression/aggregate_expression.hpp"
+#include "memory/memory_budget_resource.hpp"
 #include "operators/abstract_read_only_operator.hpp"
 #include "operators/aggregate_hash.hpp"
 #include "operators/aggregate_sort.hpp"
@@ -894,4 +895,166 @@ TYPED_TEST(OperatorsAggregateTest, StringVariations) {
   EXPECT_EQ(values_sorted, result_values_sorted);
 }
 
+/**
+ * Tests for the parallel aggregation of AggregateHash. AggregateSort, which does not partition its input, serves as the
+ * reference.
+ */
+
+class OperatorsAggregateHashTest : public BaseTest {
+ public:
+  static void SetUpTestCase() {
+    // Columns: a (int, 11 distinct values and NULLs), b (string, 5 distinct values), c (int), d (nullable double),
+    // e (long, unique)
+    const auto column_definitions =
+        TableColumnDefinitions{{"a", DataType::Int, true},
+                               {"b", DataType::String, false},
+                               {"c", DataType::Int, false},
+                               {"d", DataType::Double, true},
+                               {"e", DataType::Long, false}};
+    const auto table = std::make_shared<Table>(column_definitions, TableType::Data, CHUNK_SIZE);
+
+    const auto row_count = AggregateHash::PARALLEL_AGGREGATION_MIN_ROW_COUNT + CHUNK_SIZE;
+    for (auto chunk_begin = size_t{0}; chunk_begin < row_count; chunk_begin += CHUNK_SIZE) {
+      auto a_values = pmr_vector<int32_t>(CHUNK_SIZE);
+      auto a_nulls = pmr_vector<bool>(CHUNK_SIZE);
+      auto b_values = pmr_vector<pmr_string>(CHUNK_SIZE);
+      auto c_values = pmr_vector<int32_t>(CHUNK_SIZE);
+      auto d_values = pmr_vector<double>(CHUNK_SIZE);
+      auto d_nulls = pmr_vector<bool>(CHUNK_SIZE);
+      auto e_values = pmr_vector<int64_t>(CHUNK_SIZE);
+
+      for (auto offset = size_t{0}; offset < CHUNK_SIZE; ++offset) {
+        const auto row = chunk_begin + offset;
+        a_values[offset] = static_cast<int32_t>(row % 11);
+        a_nulls[offset] = row % 101 == 0;
+        b_values[offset] = pmr_string{"group_"} + std::to_string(row % 5).c_str();
+        c_values[offset] = static_cast<int32_t>((row * 7919) % 1000);
+        d_values[offset] = static_cast<double>(row % 13) * 0.5;
+        d_nulls[offset] = row % 7 == 0;
+        e_values[offset] = static_cast<int64_t>(row) * 3;
+      }
+
+      table->append_chunk(
+          {std::make_shared<ValueSegment<int32_t>>(std::move(a_values), std::move(a_nulls)),
+           std::make_shared<ValueSegment<pmr_string>>(std::move(b_values)),
+           std::make_shared<ValueSegment<int32_t>>(std::move(c_values)),
+           std::make_shared<ValueSegment<double>>(std::move(d_values), std::move(d_nulls)),
+           std::make_shared<ValueSegment<int64_t>>(std::move(e_values))});
+    }
+
+    _table_wrapper = std::make_shared<TableWrapper>(table);
+    _table_wrapper->never_clear_output();
+    _table_wrapper->execute();
+  }
+
+ protected:
+  static void _execute_and_compare_with_aggregate_sort(const std::shared_ptr<AggregateHash>& aggregate_hash) {
+    aggregate_hash->execute();
+
+    const auto aggregate_sort = std::make_shared<AggregateSort>(_table_wrapper, aggregate_hash->aggregates(),
+                                                                aggregate_hash->groupby_column_ids());
+    aggregate_sort->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(aggregate_hash->get_output(), aggregate_sort->get_output());
+  }
+
+  static std::shared_ptr<PQPColumnExpression> _column(const ColumnID column_id) {
+    const auto& table = _table_wrapper->get_output();
+    return pqp_column_(column_id, table->column_data_type(column_id), table->column_is_nullable(column_id),
+                       table->column_name(column_id));
+  }
+
+  static constexpr auto CHUNK_SIZE = size_t{500};
+
+  inline static std::shared_ptr<TableWrapper> _table_wrapper;
+};
+
+TEST_F(OperatorsAggregateHashTest, ParallelAggregation) {
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      min_(_column(ColumnID{2})),
+      max_(_column(ColumnID{1})),
+      sum_(_column(ColumnID{3})),
+      avg_(_column(ColumnID{2})),
+      count_(_column(ColumnID{3})),
+      count_distinct_(_column(ColumnID{2})),
+      standard_deviation_sample_(_column(ColumnID{3})),
+      count_(pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*"))};
+
+  const auto aggregate =
+      std::make_shared<AggregateHash>(_table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{0}, ColumnID{1}});
+  _execute_and_compare_with_aggregate_sort(aggregate);
+
+  const auto& performance_data = static_cast<const AggregateHash::PerformanceData&>(*aggregate->performance_data);
+  EXPECT_GT(performance_data.partition_count, 0);
+  EXPECT_EQ(performance_data.passed_through_row_count, 0);
+}
+
+TEST_F(OperatorsAggregateHashTest, ParallelDistinct) {
+  const auto aggregate =
+      std::make_shared<AggregateHash>(_table_wrapper, std::vector<std::shared_ptr<AggregateExpression>>{},
+                                      std::vector<ColumnID>{ColumnID{1}, ColumnID{0}});
+  _execute_and_compare_with_aggregate_sort(aggregate);
+
+  EXPECT_EQ(aggregate->get_output()->row_count(), 5 * 12);
+  EXPECT_GT(static_cast<const AggregateHash::PerformanceData&>(*aggregate->performance_data).partition_count, 0);
+}
+
+TEST_F(OperatorsAggregateHashTest, PassesThroughUniqueGroups) {
+  // Grouping by a unique column does not reduce the number of rows. After the first chunk of each task, the rows are
+  // passed through instead of being pre-aggregated.
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      sum_(_column(ColumnID{2})), min_(_column(ColumnID{1})), count_distinct_(_column(ColumnID{3})),
+      count_(pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*"))};
+
+  const auto aggregate =
+      std::make_shared<AggregateHash>(_table_wrapper, aggregates, std::vector<ColumnID>{ColumnID{4}});
+  _execute_and_compare_with_aggregate_sort(aggregate);
+
+  EXPECT_EQ(aggregate->get_output()->row_count(), _table_wrapper->get_output()->row_count());
+
+  const auto& performance_data = static_cast<const AggregateHash::PerformanceData&>(*aggregate->performance_data);
+  EXPECT_GT(performance_data.partition_count, 0);
+  EXPECT_GT(performance_data.passed_through_row_count, 0);
+}
+
+TEST_F(OperatorsAggregateHashTest, SmallInputIsAggregatedSequentially) {
+  const auto filtered =
+      std::make_shared<TableScan>(_table_wrapper, less_than_(get_column_expression(_table_wrapper, ColumnID{4}), 300));
+  filtered->execute();
+
+  const auto aggregate = std::make_shared<AggregateHash>(
+      filtered, std::vector<std::shared_ptr<AggregateExpression>>{sum_(_column(ColumnID{2}))},
+      std::vector<ColumnID>{ColumnID{1}});
+  aggregate->execute();
+
+  EXPECT_EQ(aggregate->get_output()->row_count(), 5);
+  EXPECT_EQ(static_cast<const AggregateHash::PerformanceData&>(*aggregate->performance_data).partition_count, 0);
+}
+
+TEST_F(OperatorsAggregateHashTest, SpillsIfMemoryBudgetIsExceeded) {
+  const auto aggregates = std::vector<std::shared_ptr<AggregateExpression>>{
+      min_(_column(ColumnID{2})), any_(_column(ColumnID{1})), avg_(_column(ColumnID{3})),
+      count_distinct_(_column(ColumnID{2})), standard_deviation_sample_(_column(ColumnID{3})),
+      count_(pqp_column_(INVALID_COLUMN_ID, DataType::Long, false, "*"))};
+
+  for (const auto& groupby_column_ids : {std::vector<ColumnID>{ColumnID{0}, ColumnID{1}},
+                                         std::vector<ColumnID>{ColumnID{1}, ColumnID{0}, ColumnID{4}}}) {
+    for (const auto has_aggregates : {true, false}) {
+      const auto memory_budget_resource = std::make_shared<MemoryBudgetResource>(10'000);
+      const auto aggregate = std::make_shared<AggregateHash>(
+          _table_wrapper, has_aggregates ? aggregates : std::vector<std::shared_ptr<AggregateExpression>>{},
+          groupby_column_ids);
+      aggregate->set_memory_budget_resource(memory_budget_resource);
+      _execute_and_compare_with_aggregate_sort(aggregate);
+
+      const auto& performance_data = static_cast<const AggregateHash::PerformanceData&>(*aggregate->performance_data);
+      EXPECT_GT(performance_data.spilled_partition_count, 1);
+      EXPECT_EQ(performance_data.spilled_bytes, memory_budget_resource->spilled_bytes());
+
+      // The results are allocated through the budget, which is exceeded as the output does not fit into it either.
+      EXPECT_GT(memory_budget_resource->peak_bytes(), 0);
+    }
+  }
+}
+
 }  // namespace opossum
@@ -5,6 +5,7 @@
 #include "operators/join_hash/join_hash_steps.hpp"
 #include "operators/table_wrapper.hpp"
 #include "resolve_type.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 #include "storage/create_iterable_from_segment.hpp"
 
 namespace opossum {
@@ -165,16 +166,18 @@ TEST_F(JoinHashStepsTest, MaterializeOutputBloomFilter) {
     materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0}, histograms, 1,
                                        bloom_filter);
 
-    // For all input values, their position in the bloom filter should be correctly set to true
-    for (auto value : std::vector<int>{0, 6, 7, 9, 13, 18}) {
-      EXPECT_TRUE(bloom_filter[value]);
+    // The Bloom filter is sized for the row count of the input table
+    EXPECT_EQ(bloom_filter.size(), BloomFilter::BLOCK_SIZE);
 
-      // Set to false for easier checking of the values that should be false
-      bloom_filter[value] = false;
+    // All input values should be contained in the Bloom filter
+    for (auto value : std::vector<int>{0, 6, 7, 9, 13, 18}) {
+      EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(value)));
     }
 
-    // All other slots should be false
-    EXPECT_EQ(bloom_filter, BloomFilter{BLOOM_FILTER_SIZE});
+    // Other values are not contained (for these values, there are no false positives)
+    for (auto value : std::vector<int>{-1, 1, 2, 5, 8, 100}) {
+      EXPECT_FALSE(bloom_filter.contains(std::hash<int>{}(value)));
+    }
   }
 }
 
@@ -184,9 +187,9 @@ TEST_F(JoinHashStepsTest, MaterializeInputBloomFilter) {
     BloomFilter output_bloom_filter;
 
     // Fill input_bloom_filter
-    BloomFilter input_bloom_filter(BLOOM_FILTER_SIZE);
+    BloomFilter input_bloom_filter(3);
     for (auto value : std::vector<int>{6, 7, 9}) {
-      input_bloom_filter[value] = true;
+      input_bloom_filter.insert(std::hash<int>{}(value));
     }
 
     auto container = materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0},
@@ -284,9 +287,9 @@ TEST_F(JoinHashStepsTest, BuildRespectsBloomFilter) {
   BloomFilter output_bloom_filter;              // Ignored in this test
 
   // Fill input_bloom_filter
-  BloomFilter input_bloom_filter(BLOOM_FILTER_SIZE);
+  BloomFilter input_bloom_filter(3);
   for (auto value : std::vector<int>{6, 7, 9}) {
-    input_bloom_filter[value] = true;
+    input_bloom_filter.insert(std::hash<int>{}(value));
   }
 
   auto container = materialize_input<int, int, false>(_table_with_nulls_and_zeros->get_output(), ColumnID{0},
@@ -305,6 +308,133 @@ TEST_F(JoinHashStepsTest, BuildRespectsBloomFilter) {
   EXPECT_FALSE(hash_table->contains(18));
 }
 
+TEST_F(JoinHashStepsTest, PartitionByRadixRespectsBloomFilter) {
+  std::vector<std::vector<size_t>> histograms;
+  BloomFilter output_bloom_filter;  // Ignored in this test
+
+  BloomFilter input_bloom_filter(1);
+  input_bloom_filter.insert(std::hash<int>{}(1));
+
+  const auto container =
+      materialize_input<int, int, false>(_table_zero_one, ColumnID{0}, histograms, 1, output_bloom_filter);
+  const auto radix_cluster_result =
+      partition_by_radix<int, int, false>(container, histograms, 1, input_bloom_filter);
+
+  // Only the ones pass the Bloom filter
+  auto partitioned_value_count = size_t{0};
+  for (const auto& partition : radix_cluster_result) {
+    for (const auto& element : partition.elements) {
+      EXPECT_EQ(element.value, 1);
+      ++partitioned_value_count;
+    }
+  }
+  EXPECT_EQ(partitioned_value_count, _table_size_zero_one / 2);
+  EXPECT_EQ(input_bloom_filter.probed_value_count(), _table_size_zero_one);
+  EXPECT_EQ(input_bloom_filter.passed_value_count(), _table_size_zero_one / 2);
+
+  // NULL values are kept, so the Bloom filter is not used
+  const auto container_with_nulls =
+      materialize_input<int, int, true>(_table_zero_one, ColumnID{0}, histograms, 1, output_bloom_filter);
+  const auto radix_cluster_result_with_nulls =
+      partition_by_radix<int, int, true>(container_with_nulls, histograms, 1, input_bloom_filter);
+  EXPECT_EQ(radix_cluster_result_with_nulls[0].elements.size() + radix_cluster_result_with_nulls[1].elements.size(),
+            _table_size_zero_one);
+}
+
+TEST_F(JoinHashStepsTest, BloomFilterSizing) {
+  EXPECT_FALSE(BloomFilter{}.is_allocated());
+  EXPECT_FALSE(BloomFilter{}.is_active());
+  EXPECT_TRUE(BloomFilter{}.contains(17));
+
+  EXPECT_EQ(BloomFilter{0}.size(), BloomFilter::BLOCK_SIZE);
+  EXPECT_EQ(BloomFilter{32}.size(), BloomFilter::BLOCK_SIZE);
+  EXPECT_EQ(BloomFilter{33}.size(), 2 * BloomFilter::BLOCK_SIZE);
+  EXPECT_EQ(BloomFilter{1'000}.size(), 32 * BloomFilter::BLOCK_SIZE);
+  EXPECT_EQ(BloomFilter{1'000'000'000}.size(), BloomFilter::MAX_BLOCK_COUNT * BloomFilter::BLOCK_SIZE);
+
+  auto bloom_filter = BloomFilter{1'000};
+  auto other_bloom_filter = BloomFilter{};
+  other_bloom_filter.allocate_like(bloom_filter);
+  EXPECT_EQ(other_bloom_filter.size(), bloom_filter.size());
+  EXPECT_THROW(other_bloom_filter.allocate(10), std::logic_error);
+}
+
+TEST_F(JoinHashStepsTest, BloomFilterFalsePositiveRate) {
+  const auto value_count = 100'000;
+  auto bloom_filter = BloomFilter{value_count};
+  for (auto value = 0; value < value_count; ++value) {
+    bloom_filter.insert(std::hash<int>{}(value));
+  }
+
+  auto false_positive_count = 0;
+  for (auto value = 0; value < value_count; ++value) {
+    EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(value)));
+    false_positive_count += bloom_filter.contains(std::hash<int>{}(value + value_count));
+  }
+  EXPECT_LT(false_positive_count, value_count / 100);
+}
+
+TEST_F(JoinHashStepsTest, BloomFilterMergesPartialFilters) {
+  auto bloom_filter = BloomFilter{1'000};
+  auto partial_bloom_filters = std::vector<BloomFilter>(3);
+  for (auto& partial_bloom_filter : partial_bloom_filters) {
+    partial_bloom_filter.allocate_like(bloom_filter);
+  }
+  partial_bloom_filters[0].insert(std::hash<int>{}(1));
+  partial_bloom_filters[2].insert(std::hash<int>{}(2));
+
+  bloom_filter.merge(partial_bloom_filters);
+  EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(1)));
+  EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(2)));
+  EXPECT_FALSE(bloom_filter.contains(std::hash<int>{}(3)));
+}
+
+TEST_F(JoinHashStepsTest, MaterializeMultiThreadedBloomFilter) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  std::vector<std::vector<size_t>> histograms;  // Ignored in this test
+  BloomFilter bloom_filter;
+
+  materialize_input<int, int, false>(_table_zero_one, ColumnID{0}, histograms, 1, bloom_filter);
+  EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(0)));
+  EXPECT_TRUE(bloom_filter.contains(std::hash<int>{}(1)));
+  EXPECT_FALSE(bloom_filter.contains(std::hash<int>{}(2)));
+}
+
+TEST_F(JoinHashStepsTest, BloomFilterIsDeactivatedForPoorSelectivity) {
+  auto bloom_filter = BloomFilter{1'000};
+
+  // The filter is not deactivated before MIN_PROBED_VALUE_COUNT values have been probed
+  const auto half_count = BloomFilter::MIN_PROBED_VALUE_COUNT / 2;
+  bloom_filter.record_probes(half_count, half_count);
+  EXPECT_TRUE(bloom_filter.is_active());
+
+  // A pass rate of 50% is good enough
+  bloom_filter.record_probes(half_count, 0);
+  EXPECT_TRUE(bloom_filter.is_active());
+
+  // A pass rate of 95% is not
+  bloom_filter.record_probes(18 * half_count, 18 * half_count);
+  EXPECT_FALSE(bloom_filter.is_active());
+  EXPECT_TRUE(bloom_filter.was_deactivated());
+  EXPECT_EQ(bloom_filter.probed_value_count(), 20 * half_count);
+  EXPECT_EQ(bloom_filter.passed_value_count(), 19 * half_count);
+
+  // A deactivated filter is no longer used for skipping values. Although 1 is not contained in the filter, all values
+  // of _table_zero_one are materialized.
+  bloom_filter.insert(std::hash<int>{}(0));
+  std::vector<std::vector<size_t>> histograms;
+  BloomFilter output_bloom_filter;
+  const auto container = materialize_input<int, int, false>(_table_zero_one, ColumnID{0}, histograms, 0,
+                                                            output_bloom_filter, bloom_filter);
+  auto materialized_value_count = size_t{0};
+  for (const auto& partition : container) {
+    materialized_value_count += partition.elements.size();
+  }
+  EXPECT_EQ(materialized_value_count, _table_size_zero_one);
+}
+
 TEST_F(JoinHashStepsTest, ThrowWhenNoNullValuesArePassed) {
   if (!HYRISE_DEBUG) GTEST_SKIP();
 
@@ -1,5 +1,6 @@
 #include "base_test.hpp"
 
+#include "memory/memory_budget_resource.hpp"
 #include "operators/join_hash.hpp"
 #include "operators/table_wrapper.hpp"
 #include "types.hpp"
@@ -118,4 +119,34 @@ TEST_F(OperatorsJoinHashTest, RadixBitCalculation) {
                                                       std::numeric_limits<size_t>::max(), JoinMode::Inner) > 0ul);
 }
 
+TEST_F(OperatorsJoinHashTest, SpillsIfMemoryBudgetIsExceeded) {
+  const auto test_join = [](const auto& left_input, const auto& right_input, const JoinMode mode) {
+    const auto primary_predicate = OperatorJoinPredicate{{ColumnID{0}, ColumnID{0}}, PredicateCondition::Equals};
+
+    const auto join = std::make_shared<JoinHash>(left_input, right_input, mode, primary_predicate);
+    join->execute();
+
+    const auto memory_budget_resource = std::make_shared<MemoryBudgetResource>(100);
+    const auto spilling_join = std::make_shared<JoinHash>(left_input, right_input, mode, primary_predicate);
+    spilling_join->set_memory_budget_resource(memory_budget_resource);
+    spilling_join->execute();
+
+    SCOPED_TRACE(join_mode_to_string.left.at(mode));
+    EXPECT_TABLE_EQ_UNORDERED(spilling_join->get_output(), join->get_output());
+
+    const auto& performance_data = dynamic_cast<const JoinHash::PerformanceData&>(*spilling_join->performance_data);
+    EXPECT_GT(performance_data.spilled_partition_count, 1);
+    EXPECT_GT(performance_data.spilled_bytes, 0);
+    EXPECT_EQ(memory_budget_resource->spilled_bytes(), performance_data.spilled_bytes);
+    EXPECT_EQ(memory_budget_resource->used_bytes(), 0);
+  };
+
+  for (const auto mode : {JoinMode::Inner, JoinMode::Left, JoinMode::Right, JoinMode::Semi, JoinMode::AntiNullAsFalse,
+                          JoinMode::AntiNullAsTrue}) {
+    test_join(_table_tpch_orders, _table_tpch_lineitems, mode);
+    test_join(_table_with_nulls, _table_wrapper_small, mode);
+    test_join(_table_wrapper_small, _table_with_nulls, mode);
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,147 @@
+#include <memory>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "expression/expression_functional.hpp"
+#include "hyrise.hpp"
+#include "operators/delete.hpp"
+#include "operators/key_index_lookup.hpp"
+#include "operators/pqp_utils.hpp"
+#include "operators/validate.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+#include "utils/load_table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsKeyIndexLookupTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    table = load_table("resources/test_data/tbl/int_int_float.tbl", 2);
+    table->add_soft_key_constraint({{ColumnID{0}, ColumnID{2}}, KeyConstraintType::PRIMARY_KEY});
+    table->create_key_index({ColumnID{0}, ColumnID{2}});
+    Hyrise::get().storage_manager.add_table("int_int_float", table);
+  }
+
+  std::shared_ptr<KeyIndexLookup> make_lookup(const int32_t a, const float c,
+                                              const std::vector<ColumnID>& pruned_column_ids = {}) {
+    return std::make_shared<KeyIndexLookup>("int_int_float", pruned_column_ids,
+                                            std::vector<ColumnID>{ColumnID{0}, ColumnID{2}},
+                                            expression_vector(value_(a), value_(c)));
+  }
+
+  std::shared_ptr<Table> table;
+};
+
+TEST_F(OperatorsKeyIndexLookupTest, Lookup) {
+  const auto lookup = make_lookup(9, 9.5f);
+  lookup->execute();
+
+  const auto& output = lookup->get_output();
+  EXPECT_EQ(output->type(), TableType::References);
+  EXPECT_EQ(output->column_definitions(), table->column_definitions());
+  ASSERT_EQ(output->chunk_count(), 1);
+
+  const auto segment =
+      std::dynamic_pointer_cast<ReferenceSegment>(output->get_chunk(ChunkID{0})->get_segment(ColumnID{1}));
+  ASSERT_TRUE(segment);
+  EXPECT_EQ(segment->referenced_table(), table);
+  EXPECT_TRUE(segment->pos_list()->references_single_chunk());
+
+  const auto expected_table = std::make_shared<Table>(table->column_definitions(), TableType::Data);
+  expected_table->append({9, 10, 9.5f});
+  EXPECT_TABLE_EQ_UNORDERED(output, expected_table);
+}
+
+TEST_F(OperatorsKeyIndexLookupTest, NoMatch) {
+  const auto lookup = make_lookup(9, 10.5f);
+  lookup->execute();
+
+  EXPECT_EQ(lookup->get_output()->column_count(), 3);
+  EXPECT_EQ(lookup->get_output()->row_count(), 0);
+}
+
+TEST_F(OperatorsKeyIndexLookupTest, PrunedColumns) {
+  const auto lookup = make_lookup(10, 10.5f, {ColumnID{1}});
+  lookup->execute();
+
+  const auto expected_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"c", DataType::Float, false}}, TableType::Data);
+  expected_table->append({10, 10.5f});
+  EXPECT_TABLE_EQ_UNORDERED(lookup->get_output(), expected_table);
+}
+
+TEST_F(OperatorsKeyIndexLookupTest, Parameters) {
+  const auto lookup = std::make_shared<KeyIndexLookup>(
+      "int_int_float", std::vector<ColumnID>{}, std::vector<ColumnID>{ColumnID{0}, ColumnID{2}},
+      expression_vector(correlated_parameter_(ParameterID{0}, pqp_column_(ColumnID{0}, DataType::Int, false, "a")),
+                        correlated_parameter_(ParameterID{1}, pqp_column_(ColumnID{2}, DataType::Float, false, "c"))));
+  lookup->set_parameters({{ParameterID{0}, AllTypeVariant{11}}, {ParameterID{1}, AllTypeVariant{11.5f}}});
+
+  const auto copied_lookup = std::static_pointer_cast<KeyIndexLookup>(lookup->deep_copy());
+  copied_lookup->execute();
+
+  const auto expected_table = std::make_shared<Table>(table->column_definitions(), TableType::Data);
+  expected_table->append({11, 10, 11.5f});
+  EXPECT_TABLE_EQ_UNORDERED(copied_lookup->get_output(), expected_table);
+}
+
+TEST_F(OperatorsKeyIndexLookupTest, RequiresKeyIndex) {
+  const auto lookup = std::make_shared<KeyIndexLookup>("int_int_float", std::vector<ColumnID>{},
+                                                       std::vector<ColumnID>{ColumnID{0}}, expression_vector(9));
+  EXPECT_THROW(lookup->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsKeyIndexLookupTest, ValidateFiltersDeletedRows) {
+  const auto delete_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto delete_lookup = make_lookup(9, 11.5f);
+  delete_lookup->set_transaction_context(delete_context);
+  delete_lookup->execute();
+  const auto delete_operator = std::make_shared<Delete>(delete_lookup);
+  delete_operator->set_transaction_context(delete_context);
+  delete_operator->execute();
+  delete_context->commit();
+
+  // The index still returns the deleted row, but Validate removes it.
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto lookup = make_lookup(9, 11.5f);
+  lookup->set_transaction_context(transaction_context);
+  lookup->execute();
+  EXPECT_EQ(lookup->get_output()->row_count(), 1);
+
+  const auto validate = std::make_shared<Validate>(lookup);
+  validate->set_transaction_context(transaction_context);
+  validate->execute();
+  EXPECT_EQ(validate->get_output()->row_count(), 0);
+}
+
+TEST_F(OperatorsKeyIndexLookupTest, Description) {
+  const auto lookup = make_lookup(9, 9.5f);
+  EXPECT_EQ(lookup->description(DescriptionMode::SingleLine), "KeyIndexLookup (int_int_float) key: a = 9, c = 9.5");
+}
+
+TEST_F(OperatorsKeyIndexLookupTest, SQL) {
+  auto pipeline = SQLPipelineBuilder{"SELECT b FROM int_int_float WHERE c = 11.5 AND a = 11"}.create_pipeline();
+  const auto [pipeline_status, result_table] = pipeline.get_result_table();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+
+  const auto expected_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"b", DataType::Int, false}}, TableType::Data);
+  expected_table->append({10});
+  EXPECT_TABLE_EQ_UNORDERED(result_table, expected_table);
+
+  const auto& pqps = pipeline.get_physical_plans();
+  ASSERT_EQ(pqps.size(), 1);
+  auto found_lookup = false;
+  visit_pqp(pqps[0], [&](const auto& op) {
+    found_lookup |= op->type() == OperatorType::KeyIndexLookup;
+    return PQPVisitation::VisitInputs;
+  });
+  EXPECT_TRUE(found_lookup);
+}
+
+}  // namespace opossum
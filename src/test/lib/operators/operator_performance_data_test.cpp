@@ -232,6 +232,14 @@ TEST_F(OperatorPerformanceDataTest, JoinHashBloomFilterReductions) {
   EXPECT_EQ(inner_perf.hash_tables_position_count, 3ul);           // positions 1,2,3
   EXPECT_TRUE(inner_perf.left_input_is_build_side);
 
+  // All values of the probe side are probed against the build side's Bloom filter. The build side's values are probed
+  // against the probe side's Bloom filter when the hash table is built.
+  EXPECT_EQ(inner_perf.build_side_bloom_filter_probed_value_count, table_b->row_count());
+  EXPECT_EQ(inner_perf.build_side_bloom_filter_passed_value_count, 4ul);
+  EXPECT_EQ(inner_perf.probe_side_bloom_filter_probed_value_count, 4ul);
+  EXPECT_EQ(inner_perf.probe_side_bloom_filter_passed_value_count, 3ul);
+  EXPECT_FALSE(inner_perf.build_side_bloom_filter_deactivated);
+
   // Semi join case: We check that no positions are stored (see explanation for "AllPositions" mode in hash map).
   // Further, we force the larger input to be the build side. As we first materialize the smaller side (i.e., the probe
   // side in this case) and create the initial bloom filter with that, there will be no reduction due to bloom
@@ -247,6 +255,11 @@ TEST_F(OperatorPerformanceDataTest, JoinHashBloomFilterReductions) {
   EXPECT_EQ(semi_perf.hash_tables_distinct_value_count, 2ul);
   EXPECT_FALSE(semi_perf.hash_tables_position_count);
   EXPECT_FALSE(semi_perf.left_input_is_build_side);
+
+  // The build side is materialized second and has thus already been filtered. Its Bloom filter is not probed.
+  EXPECT_EQ(semi_perf.probe_side_bloom_filter_probed_value_count, table_b->row_count());
+  EXPECT_EQ(semi_perf.probe_side_bloom_filter_passed_value_count, 4ul);
+  EXPECT_EQ(semi_perf.build_side_bloom_filter_probed_value_count, 0ul);
 }
 
 // Check that steps of IndexJoin (indexed chunks/unindexed chunks) are executed as expected.
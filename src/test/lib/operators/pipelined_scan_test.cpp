@@ -0,0 +1,129 @@
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "operators/pipelined_scan.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "operators/validate.hpp"
+#include "storage/table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class OperatorsPipelinedScanTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    _validate_table = load_table("resources/test_data/tbl/validate_input.tbl", 2u);
+    for (auto chunk_id = ChunkID{0}; chunk_id < _validate_table->chunk_count(); ++chunk_id) {
+      const auto chunk = _validate_table->get_chunk(chunk_id);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < chunk->size(); ++chunk_offset) {
+        chunk->mvcc_data()->set_begin_cid(chunk_offset, CommitID{0});
+      }
+    }
+
+    // Invalidate the row with a = 7
+    _validate_table->get_chunk(ChunkID{1})->mvcc_data()->set_end_cid(ChunkOffset{0}, CommitID{2});
+    _validate_table->get_chunk(ChunkID{1})->increase_invalid_row_count(1);
+
+    _validate_table_wrapper = std::make_shared<TableWrapper>(_validate_table);
+    _validate_table_wrapper->never_clear_output();
+    _validate_table_wrapper->execute();
+
+    _int_int_table = load_table("resources/test_data/tbl/int_int_shuffled.tbl", 3u);
+    _int_int_table_wrapper = std::make_shared<TableWrapper>(_int_int_table);
+    _int_int_table_wrapper->never_clear_output();
+    _int_int_table_wrapper->execute();
+
+    _a = PQPColumnExpression::from_table(*_int_int_table, "a");
+    _b = PQPColumnExpression::from_table(*_int_int_table, "b");
+  }
+
+  std::shared_ptr<Table> _validate_table, _int_int_table;
+  std::shared_ptr<TableWrapper> _validate_table_wrapper, _int_int_table_wrapper;
+  std::shared_ptr<PQPColumnExpression> _a, _b;
+};
+
+TEST_F(OperatorsPipelinedScanTest, ValidateAndScan) {
+  const auto context = std::make_shared<TransactionContext>(TransactionID{1}, CommitID{3}, AutoCommit::No);
+  const auto a = PQPColumnExpression::from_table(*_validate_table, "a");
+
+  auto pipelined_scan = std::make_shared<PipelinedScan>(_validate_table_wrapper, true,
+                                                        expression_vector(greater_than_equals_(a, 2)));
+  pipelined_scan->set_transaction_context(context);
+  pipelined_scan->execute();
+
+  const auto expected_result = load_table("resources/test_data/tbl/validate_output_validated_scanned.tbl", 2u);
+  EXPECT_TABLE_EQ_UNORDERED(pipelined_scan->get_output(), expected_result);
+}
+
+TEST_F(OperatorsPipelinedScanTest, ValidationRequiresTransactionContext) {
+  auto pipelined_scan = std::make_shared<PipelinedScan>(_validate_table_wrapper, true,
+                                                        std::vector<std::shared_ptr<AbstractExpression>>{});
+  EXPECT_THROW(pipelined_scan->execute(), std::logic_error);
+}
+
+TEST_F(OperatorsPipelinedScanTest, MatchesChainOfTableScans) {
+  // Run the same predicates once as individual TableScans and once as a PipelinedScan, both on the data table and on
+  // a reference table.
+  const auto predicates = expression_vector(greater_than_(_a, 2), less_than_(_b, 112), not_equals_(_a, 8));
+  const auto first_scan = std::make_shared<TableScan>(_int_int_table_wrapper, greater_than_(_b, 100));
+  first_scan->never_clear_output();
+  first_scan->execute();
+
+  for (const auto& input : std::vector<std::shared_ptr<AbstractOperator>>{_int_int_table_wrapper, first_scan}) {
+    auto expected_result = input->get_output();
+    for (const auto& predicate : predicates) {
+      auto wrapper = std::make_shared<TableWrapper>(expected_result);
+      wrapper->execute();
+      auto table_scan = std::make_shared<TableScan>(wrapper, predicate);
+      table_scan->execute();
+      expected_result = table_scan->get_output();
+    }
+
+    auto pipelined_scan = std::make_shared<PipelinedScan>(input, false, predicates);
+    pipelined_scan->execute();
+
+    EXPECT_TABLE_EQ_UNORDERED(pipelined_scan->get_output(), expected_result);
+    EXPECT_EQ(pipelined_scan->get_output()->type(), TableType::References);
+  }
+}
+
+TEST_F(OperatorsPipelinedScanTest, EliminatesMorsels) {
+  // No row matches both predicates. All morsels are eliminated, either by the first or by the second stage.
+  auto pipelined_scan = std::make_shared<PipelinedScan>(
+      _int_int_table_wrapper, false, expression_vector(greater_than_(_a, 0), less_than_(_a, 0), equals_(_b, 1)));
+  pipelined_scan->execute();
+
+  EXPECT_EQ(pipelined_scan->get_output()->row_count(), 0);
+
+  const auto& performance_data = dynamic_cast<PipelinedScan::PerformanceData&>(*pipelined_scan->performance_data);
+  EXPECT_EQ(performance_data.num_morsels_eliminated, _int_int_table->chunk_count());
+}
+
+TEST_F(OperatorsPipelinedScanTest, DeepCopy) {
+  auto pipelined_scan = std::make_shared<PipelinedScan>(_int_int_table_wrapper, false,
+                                                        expression_vector(greater_than_(_a, 2), less_than_(_b, 112)));
+  const auto copy = std::dynamic_pointer_cast<PipelinedScan>(pipelined_scan->deep_copy());
+  ASSERT_TRUE(copy);
+
+  EXPECT_FALSE(copy->validates());
+  ASSERT_EQ(copy->predicates().size(), 2);
+  EXPECT_EQ(*copy->predicates()[0], *greater_than_(_a, 2));
+  EXPECT_EQ(*copy->predicates()[1], *less_than_(_b, 112));
+}
+
+TEST_F(OperatorsPipelinedScanTest, Description) {
+  auto pipelined_scan = std::make_shared<PipelinedScan>(_int_int_table_wrapper, true,
+                                                        expression_vector(greater_than_(_a, 2), less_than_(_b, 112)));
+
+  EXPECT_EQ(pipelined_scan->description(DescriptionMode::SingleLine), "PipelinedScan Validate a > 2 b < 112");
+}
+
+}  // namespace opossum
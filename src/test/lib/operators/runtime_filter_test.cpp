@@ -0,0 +1,217 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "expression/expression_functional.hpp"
+#include "expression/pqp_column_expression.hpp"
+#include "hyrise.hpp"
+#include "operators/get_table.hpp"
+#include "operators/join_hash.hpp"
+#include "operators/runtime_filter.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "scheduler/operator_task.hpp"
+#include "sql/sql_pipeline_builder.hpp"
+#include "statistics/generate_pruning_statistics.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/table.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class RuntimeFilterTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    // The probe table has ten chunks with sorted values: 0-9, 10-19, ..., 90-99.
+    _probe_table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Int, false}}, TableType::Data,
+        ChunkOffset{10}, UseMvcc::Yes);
+    for (auto value = int32_t{0}; value < 100; ++value) {
+      _probe_table->append({value, value % 7});
+    }
+    _probe_table->last_chunk()->finalize();
+    ChunkEncoder::encode_all_chunks(_probe_table);
+    generate_chunk_pruning_statistics(_probe_table);
+    Hyrise::get().storage_manager.add_table("probe", _probe_table);
+
+    _build_table = std::make_shared<Table>(TableColumnDefinitions{{"x", DataType::Int, true}}, TableType::Data,
+                                           std::nullopt, UseMvcc::Yes);
+    _build_table->append({15});
+    _build_table->append({NULL_VALUE});
+    _build_table->append({42});
+    _build_table->append({17});
+    Hyrise::get().storage_manager.add_table("build", _build_table);
+
+    _a = PQPColumnExpression::from_table(*_probe_table, "a");
+    _x = PQPColumnExpression::from_table(*_build_table, "x");
+  }
+
+  static void _execute(const std::shared_ptr<AbstractOperator>& pqp) {
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(OperatorTask::make_tasks_from_operator(pqp));
+  }
+
+  std::shared_ptr<Table> _probe_table;
+  std::shared_ptr<Table> _build_table;
+  std::shared_ptr<PQPColumnExpression> _a;
+  std::shared_ptr<PQPColumnExpression> _x;
+};
+
+TEST_F(RuntimeFilterTest, FiltersProbeSideOfSemiJoin) {
+  const auto probe_get_table = std::make_shared<GetTable>("probe");
+  probe_get_table->never_clear_output();
+  const auto probe_scan = std::make_shared<TableScan>(probe_get_table, greater_than_equals_(_a, 0));
+  probe_scan->never_clear_output();
+  const auto build_get_table = std::make_shared<GetTable>("build");
+  const auto join = std::make_shared<JoinHash>(
+      probe_scan, build_get_table, JoinMode::Semi,
+      OperatorJoinPredicate{ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals});
+
+  const auto runtime_filters = push_down_runtime_filters(join);
+  ASSERT_EQ(runtime_filters.size(), 1);
+  const auto& runtime_filter = runtime_filters.front();
+  EXPECT_EQ(join->runtime_filter, runtime_filter);
+  EXPECT_EQ(runtime_filter->producer(), build_get_table);
+  ASSERT_EQ(runtime_filter->consumers().size(), 2);
+  EXPECT_EQ(runtime_filter->consumers()[0].lock(), probe_scan);
+  EXPECT_EQ(runtime_filter->consumers()[1].lock(), probe_get_table);
+
+  _execute(join);
+
+  EXPECT_EQ(*runtime_filter->min(), AllTypeVariant{15});
+  EXPECT_EQ(*runtime_filter->max(), AllTypeVariant{42});
+
+  // The join releases the filter once it has been executed.
+  EXPECT_FALSE(join->runtime_filter);
+
+  // Only the chunks 10-19, 20-29, 30-39, and 40-49 may contain join partners.
+  EXPECT_EQ(probe_get_table->get_output()->chunk_count(), 4);
+  const auto description = probe_get_table->description(DescriptionMode::SingleLine);
+  EXPECT_NE(description.find("6 chunk(s) by runtime filters"), std::string::npos);
+
+  // Of the remaining 40 rows, at most 28 are within the range of the build side.
+  EXPECT_LE(probe_scan->get_output()->row_count(), 28);
+  const auto& scan_performance_data = dynamic_cast<const TableScan::PerformanceData&>(*probe_scan->performance_data);
+  EXPECT_EQ(scan_performance_data.num_rows_removed_by_runtime_filters + probe_scan->get_output()->row_count(), 40);
+
+  const auto expected_table = std::make_shared<Table>(_probe_table->column_definitions(), TableType::Data);
+  expected_table->append({15, 1});
+  expected_table->append({17, 3});
+  expected_table->append({42, 0});
+  EXPECT_TABLE_EQ_UNORDERED(join->get_output(), expected_table);
+}
+
+TEST_F(RuntimeFilterTest, FiltersLargerInputOfInnerJoin) {
+  const auto build_get_table = std::make_shared<GetTable>("build");
+  const auto probe_get_table = std::make_shared<GetTable>("probe");
+  const auto join = std::make_shared<JoinHash>(
+      build_get_table, probe_get_table, JoinMode::Inner,
+      OperatorJoinPredicate{ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals});
+
+  const auto runtime_filters = push_down_runtime_filters(join);
+  ASSERT_EQ(runtime_filters.size(), 1);
+  EXPECT_EQ(runtime_filters.front()->producer(), build_get_table);
+  EXPECT_EQ(runtime_filters.front()->producer_column_id(), ColumnID{0});
+  ASSERT_EQ(runtime_filters.front()->consumers().size(), 1);
+  EXPECT_EQ(runtime_filters.front()->consumers().front().lock(), probe_get_table);
+
+  // Pushing down again returns the existing filter.
+  EXPECT_EQ(push_down_runtime_filters(join), runtime_filters);
+
+  _execute(join);
+  EXPECT_EQ(join->get_output()->row_count(), 3);
+}
+
+TEST_F(RuntimeFilterTest, EmptyBuildSidePrunesAllChunks) {
+  const auto probe_get_table = std::make_shared<GetTable>("probe");
+  probe_get_table->never_clear_output();
+  const auto build_get_table = std::make_shared<GetTable>("build");
+  const auto build_scan = std::make_shared<TableScan>(build_get_table, less_than_(_x, 0));
+  const auto join = std::make_shared<JoinHash>(
+      probe_get_table, build_scan, JoinMode::Semi,
+      OperatorJoinPredicate{ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals});
+
+  const auto runtime_filters = push_down_runtime_filters(join);
+  _execute(join);
+
+  ASSERT_EQ(runtime_filters.size(), 1);
+  EXPECT_FALSE(runtime_filters.front()->min());
+  EXPECT_EQ(probe_get_table->get_output()->chunk_count(), 0);
+  EXPECT_EQ(join->get_output()->row_count(), 0);
+}
+
+TEST_F(RuntimeFilterTest, NoPushDownForAntiAndOuterJoins) {
+  for (const auto join_mode : {JoinMode::AntiNullAsTrue, JoinMode::AntiNullAsFalse, JoinMode::Left}) {
+    const auto probe_get_table = std::make_shared<GetTable>("probe");
+    const auto build_get_table = std::make_shared<GetTable>("build");
+    const auto join = std::make_shared<JoinHash>(
+        probe_get_table, build_get_table, join_mode,
+        OperatorJoinPredicate{ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals});
+
+    EXPECT_TRUE(push_down_runtime_filters(join).empty());
+  }
+}
+
+TEST_F(RuntimeFilterTest, NoPushDownForSharedOperators) {
+  // The result of the scan is used by another operator, which must not see a filtered result.
+  const auto probe_get_table = std::make_shared<GetTable>("probe");
+  const auto probe_scan = std::make_shared<TableScan>(probe_get_table, greater_than_equals_(_a, 0));
+  const auto other_consumer = std::make_shared<TableScan>(probe_scan, less_than_(_a, 50));
+  const auto build_get_table = std::make_shared<GetTable>("build");
+  const auto join = std::make_shared<JoinHash>(
+      probe_scan, build_get_table, JoinMode::Semi,
+      OperatorJoinPredicate{ColumnIDPair(ColumnID{0}, ColumnID{0}), PredicateCondition::Equals});
+
+  EXPECT_TRUE(push_down_runtime_filters(join).empty());
+}
+
+TEST_F(RuntimeFilterTest, FilterRemovesNullsAndValuesWithoutJoinPartner) {
+  const auto producer = std::make_shared<TableWrapper>(_build_table);
+  producer->never_clear_output();
+  producer->execute();
+
+  const auto runtime_filter = std::make_shared<RuntimeFilter>(producer, ColumnID{0});
+  EXPECT_FALSE(runtime_filter->prepare(DataType::Long));
+  EXPECT_TRUE(runtime_filter->prepare(DataType::Int));
+  EXPECT_TRUE(runtime_filter->bloom_filter().is_allocated());
+
+  const auto positions = std::make_shared<RowIDPosList>();
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < _build_table->row_count(); ++chunk_offset) {
+    positions->emplace_back(RowID{ChunkID{0}, chunk_offset});
+  }
+  positions->guarantee_single_chunk();
+
+  const auto filtered_positions =
+      runtime_filter->filter(_build_table->get_chunk(ChunkID{0})->get_segment(ColumnID{0}), positions);
+  EXPECT_EQ(*filtered_positions, RowIDPosList({RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{0}, ChunkOffset{2}},
+                                               RowID{ChunkID{0}, ChunkOffset{3}}}));
+  EXPECT_TRUE(filtered_positions->references_single_chunk());
+}
+
+TEST_F(RuntimeFilterTest, FilterIsNotAppliedWithoutExecutedProducer) {
+  const auto producer = std::make_shared<TableWrapper>(_build_table);
+  const auto runtime_filter = std::make_shared<RuntimeFilter>(producer, ColumnID{0});
+  EXPECT_FALSE(runtime_filter->prepare(DataType::Int));
+
+  // The probe side is not filtered if the producer has not been executed before.
+  const auto probe_get_table = std::make_shared<GetTable>("probe");
+  probe_get_table->add_runtime_filter(runtime_filter, ColumnID{0});
+  probe_get_table->execute();
+  EXPECT_EQ(probe_get_table->get_output()->chunk_count(), 10);
+}
+
+TEST_F(RuntimeFilterTest, SQLResultIsNotAffected) {
+  auto pipeline = SQLPipelineBuilder{"SELECT a FROM probe, build WHERE a = x AND b < 5"}.create_pipeline();
+  const auto [pipeline_status, table] = pipeline.get_result_table();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+
+  const auto expected_table =
+      std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data);
+  expected_table->append({15});
+  expected_table->append({17});
+  expected_table->append({42});
+  EXPECT_TABLE_EQ_UNORDERED(table, expected_table);
+}
+
+}  // namespace opossum
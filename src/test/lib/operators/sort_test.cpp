@@ -1,8 +1,11 @@
+#include <random>
+
 #include "base_test.hpp"
 
 #include "operators/join_hash.hpp"
 #include "operators/sort.hpp"
 #include "operators/table_wrapper.hpp"
+#include "scheduler/node_queue_scheduler.hpp"
 
 namespace opossum {
 
@@ -228,4 +231,100 @@ TEST_F(SortTest, InputReferencesDifferentColumns) {
   EXPECT_EQ(sort.get_output()->type(), TableType::Data);
 }
 
+class SortNormalizedKeyTest : public BaseTest {
+ protected:
+  // Creates a table with random values, NULLs, and negative numbers. Strings are up to max_string_length long.
+  static std::shared_ptr<Table> _create_table(const size_t row_count, const size_t max_string_length) {
+    const auto table = std::make_shared<Table>(
+        TableColumnDefinitions{{"a", DataType::Int, true},
+                               {"b", DataType::String, true},
+                               {"c", DataType::Float, false},
+                               {"d", DataType::Double, true},
+                               {"e", DataType::Long, false}},
+        TableType::Data, ChunkOffset{1'000});
+
+    auto generator = std::mt19937{17};
+    auto distribution = std::uniform_int_distribution<int32_t>{-20, 20};
+    for (auto row_idx = size_t{0}; row_idx < row_count; ++row_idx) {
+      const auto value = distribution(generator);
+      const auto string_length = std::abs(value) * max_string_length / 20;
+      const auto string = pmr_string(string_length, static_cast<char>('a' + value % 3 + 2));
+      table->append({value % 7 == 0 ? NULL_VALUE : AllTypeVariant{value % 5},
+                     value % 11 == 0 ? NULL_VALUE : AllTypeVariant{string}, AllTypeVariant{value * 0.5f},
+                     value % 13 == 0 ? NULL_VALUE : AllTypeVariant{value * -0.25},
+                     AllTypeVariant{int64_t{value} * 1'000'000'000}});
+    }
+
+    return table;
+  }
+
+  // Sorts the rows of table with a stable sort per sort column, starting with the least significant one. As Sort,
+  // it orders NULLs before all other values.
+  static std::vector<std::vector<AllTypeVariant>> _expected_rows(
+      const std::shared_ptr<const Table>& table, const std::vector<SortColumnDefinition>& sort_definitions) {
+    auto rows = table->get_rows();
+    for (auto sort_definition = sort_definitions.rbegin(); sort_definition != sort_definitions.rend();
+         ++sort_definition) {
+      const auto column_id = sort_definition->column;
+      const auto descending = sort_definition->sort_mode == SortMode::Descending;
+      std::stable_sort(rows.begin(), rows.end(), [&](const auto& lhs, const auto& rhs) {
+        if (variant_is_null(lhs[column_id]) || variant_is_null(rhs[column_id])) {
+          return variant_is_null(lhs[column_id]) && !variant_is_null(rhs[column_id]);
+        }
+        return descending ? rhs[column_id] < lhs[column_id] : lhs[column_id] < rhs[column_id];
+      });
+    }
+    return rows;
+  }
+
+  static void _sort_and_compare(const std::shared_ptr<Table>& table,
+                                const std::vector<SortColumnDefinition>& sort_definitions) {
+    const auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->execute();
+
+    auto sort = Sort{table_wrapper, sort_definitions};
+    sort.execute();
+
+    EXPECT_EQ(sort.get_output()->get_rows(), _expected_rows(table, sort_definitions));
+  }
+};
+
+TEST_F(SortNormalizedKeyTest, PackedKeys) {
+  // Keys of up to eight bytes are packed into integers.
+  const auto table = _create_table(5'000, 3);
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{0}, SortMode::Descending}});
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{2}, SortMode::Ascending}});
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{4}, SortMode::Descending}});
+}
+
+TEST_F(SortNormalizedKeyTest, MultipleColumns) {
+  const auto table = _create_table(5'000, 10);
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{1}, SortMode::Ascending},
+                            SortColumnDefinition{ColumnID{0}, SortMode::Descending},
+                            SortColumnDefinition{ColumnID{3}, SortMode::Ascending}});
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{4}, SortMode::Descending},
+                            SortColumnDefinition{ColumnID{1}, SortMode::Descending},
+                            SortColumnDefinition{ColumnID{2}, SortMode::Ascending},
+                            SortColumnDefinition{ColumnID{3}, SortMode::Descending},
+                            SortColumnDefinition{ColumnID{0}, SortMode::Ascending}});
+}
+
+TEST_F(SortNormalizedKeyTest, FallbackForWideKeys) {
+  // Strings of this length exceed MAX_NORMALIZED_KEY_WIDTH, so that the table is sorted column by column.
+  const auto table = _create_table(2'000, Sort::MAX_NORMALIZED_KEY_WIDTH);
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{1}, SortMode::Descending},
+                            SortColumnDefinition{ColumnID{0}, SortMode::Ascending}});
+}
+
+TEST_F(SortNormalizedKeyTest, ParallelSort) {
+  // Large enough to be split into multiple runs that are sorted in parallel and merged afterwards.
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  const auto table = _create_table(250'000, 5);
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{0}, SortMode::Ascending}});
+  _sort_and_compare(table, {SortColumnDefinition{ColumnID{1}, SortMode::Ascending},
+                            SortColumnDefinition{ColumnID{4}, SortMode::Descending}});
+}
+
 }  // namespace opossum
@@ -22,6 +22,7 @@
 #include "operators/table_scan/column_vs_value_table_scan_impl.hpp"
 #include "operators/table_scan/expression_evaluator_table_scan_impl.hpp"
 #include "operators/table_wrapper.hpp"
+#include "storage/base_dictionary_segment.hpp"
 #include "storage/chunk_encoder.hpp"
 #include "storage/encoding_type.hpp"
 #include "storage/reference_segment.hpp"
@@ -1283,4 +1284,78 @@ TEST_P(OperatorsTableScanTest, SortedFlagMultipleChunksReferenced) {
   ASSERT_TRUE(chunk_sorted_by.empty());
 }
 
+class OperatorsTableScanBitPackingTest : public BaseTest {
+ protected:
+  // Creates a nullable int column of 2'500 rows (i.e., chunks that are not a multiple of the block size) with 300
+  // distinct values, dictionary-encoded with the given vector compression.
+  static std::shared_ptr<TableWrapper> _create_table(const VectorCompressionType vector_compression_type) {
+    const auto column_definitions = TableColumnDefinitions{{"a", DataType::Int, true}};
+    auto table = std::make_shared<Table>(column_definitions, TableType::Data, ChunkOffset{1'000}, UseMvcc::Yes);
+    for (auto row = int32_t{0}; row < 2'500; ++row) {
+      table->append({row % 11 == 0 ? AllTypeVariant{NullValue{}} : AllTypeVariant{(row * 7) % 300}});
+    }
+    table->last_chunk()->finalize();
+    ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::Dictionary, vector_compression_type});
+
+    auto table_wrapper = std::make_shared<TableWrapper>(table);
+    table_wrapper->never_clear_output();
+    table_wrapper->execute();
+    return table_wrapper;
+  }
+};
+
+// Dictionary scans on bit-packed value IDs evaluate range predicates on the packed data. Their results must match the
+// scans on byte-aligned value IDs, both for data tables and for reference tables (where position filters are used).
+TEST_F(OperatorsTableScanBitPackingTest, MatchesByteAlignedValueIDs) {
+  const auto byte_aligned_table = _create_table(VectorCompressionType::FixedSizeByteAligned);
+  const auto bit_packed_table = _create_table(VectorCompressionType::BitPacking);
+
+  const auto& attribute_vector = dynamic_cast<const BaseDictionarySegment&>(
+      *bit_packed_table->get_output()->get_chunk(ChunkID{0})->get_segment(ColumnID{0})).attribute_vector();
+  ASSERT_EQ(attribute_vector->type(), CompressedVectorType::BitPacking);
+
+  // Scans the output of a previous scan so that the dictionary segments are accessed via position filters.
+  const auto byte_aligned_references = create_table_scan(byte_aligned_table, ColumnID{0}, PredicateCondition::LessThan,
+                                                         200);
+  byte_aligned_references->never_clear_output();
+  byte_aligned_references->execute();
+  const auto bit_packed_references = create_table_scan(bit_packed_table, ColumnID{0}, PredicateCondition::LessThan,
+                                                       200);
+  bit_packed_references->never_clear_output();
+  bit_packed_references->execute();
+
+  const auto inputs = std::vector<std::pair<std::shared_ptr<AbstractOperator>, std::shared_ptr<AbstractOperator>>>{
+      {byte_aligned_table, bit_packed_table}, {byte_aligned_references, bit_packed_references}};
+
+  for (const auto& [byte_aligned_input, bit_packed_input] : inputs) {
+    for (const auto predicate_condition :
+         {PredicateCondition::Equals, PredicateCondition::NotEquals, PredicateCondition::LessThan,
+          PredicateCondition::LessThanEquals, PredicateCondition::GreaterThan, PredicateCondition::GreaterThanEquals}) {
+      for (const auto value : {-1, 0, 42, 150, 299, 300}) {
+        SCOPED_TRACE(std::to_string(static_cast<int>(predicate_condition)) + " " + std::to_string(value));
+        const auto expected = create_table_scan(byte_aligned_input, ColumnID{0}, predicate_condition, value);
+        expected->execute();
+        const auto actual = create_table_scan(bit_packed_input, ColumnID{0}, predicate_condition, value);
+        actual->execute();
+        EXPECT_TABLE_EQ_ORDERED(actual->get_output(), expected->get_output());
+      }
+    }
+
+    for (const auto predicate_condition :
+         {PredicateCondition::BetweenInclusive, PredicateCondition::BetweenLowerExclusive,
+          PredicateCondition::BetweenUpperExclusive, PredicateCondition::BetweenExclusive}) {
+      for (const auto& [left_value, right_value] : std::vector<std::pair<int32_t, int32_t>>{{0, 299}, {17, 19}}) {
+        SCOPED_TRACE(std::to_string(static_cast<int>(predicate_condition)) + " " + std::to_string(left_value));
+        const auto expected = create_between_table_scan(byte_aligned_input, ColumnID{0}, left_value, right_value,
+                                                        predicate_condition);
+        expected->execute();
+        const auto actual = create_between_table_scan(bit_packed_input, ColumnID{0}, left_value, right_value,
+                                                      predicate_condition);
+        actual->execute();
+        EXPECT_TABLE_EQ_ORDERED(actual->get_output(), expected->get_output());
+      }
+    }
+  }
+}
+
 }  // namespace opossum
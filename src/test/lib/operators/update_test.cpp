@@ -7,12 +7,14 @@
 #include "expression/expression_functional.hpp"
 #include "expression/pqp_column_expression.hpp"
 #include "hyrise.hpp"
+#include "operators/delete.hpp"
 #include "operators/get_table.hpp"
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
 #include "operators/update.hpp"
 #include "operators/validate.hpp"
 #include "statistics/table_statistics.hpp"
+#include "storage/row_versions.hpp"
 #include "storage/table.hpp"
 
 using namespace opossum::expression_functional;  // NOLINT
@@ -62,6 +64,36 @@ class OperatorsUpdateTest : public BaseTest {
     EXPECT_TABLE_EQ_UNORDERED(validate->get_output(), load_table(expected_result_path));
   }
 
+  // Sets column b of the rows with a > 100 to `value` within the given transaction.
+  std::shared_ptr<Update> update_b(const std::shared_ptr<TransactionContext>& transaction_context, const float value) {
+    const auto get_table = std::make_shared<GetTable>(table_to_update_name);
+    get_table->set_transaction_context(transaction_context);
+    const auto validate = std::make_shared<Validate>(get_table);
+    validate->set_transaction_context(transaction_context);
+    const auto where_scan = std::make_shared<TableScan>(validate, greater_than_(column_a, 100));
+    const auto updated_values_projection =
+        std::make_shared<Projection>(where_scan, expression_vector(column_a, value));
+
+    const auto update = std::make_shared<Update>(table_to_update_name, where_scan, updated_values_projection);
+    update->set_transaction_context(transaction_context);
+    execute_all({get_table, validate, where_scan, updated_values_projection, update});
+    return update;
+  }
+
+  std::shared_ptr<const Table> validated_table(const std::shared_ptr<TransactionContext>& transaction_context) {
+    const auto get_table = std::make_shared<GetTable>(table_to_update_name);
+    get_table->set_transaction_context(transaction_context);
+    const auto validate = std::make_shared<Validate>(get_table);
+    validate->set_transaction_context(transaction_context);
+    execute_all({get_table, validate});
+    return validate->get_output();
+  }
+
+  std::shared_ptr<RowVersions> row_versions(const ChunkID chunk_id) {
+    const auto table = Hyrise::get().storage_manager.get_table(table_to_update_name);
+    return table->get_chunk(chunk_id)->mvcc_data()->row_versions();
+  }
+
   std::string table_to_update_name{"updateTestTable"};
   inline static std::shared_ptr<AbstractExpression> column_a, column_b;
 };
@@ -84,4 +116,138 @@ TEST_F(OperatorsUpdateTest, UpdateNone) {
   helper(greater_than_(column_a, 100'000), expression_vector(1, 1.5f), "resources/test_data/tbl/int_float2.tbl");
 }
 
+TEST_F(OperatorsUpdateTest, UpdateInPlace) {
+  // All chunks of the table are immutable, so only the changed values are stored as row versions.
+  const auto table = Hyrise::get().storage_manager.get_table(table_to_update_name);
+  const auto old_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto update = update_b(transaction_context, 7.5f);
+  EXPECT_FALSE(update->execute_failed());
+
+  // The transaction sees its own changes before it commits.
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(transaction_context),
+                            load_table("resources/test_data/tbl/int_float2_updated_0.tbl"));
+  transaction_context->commit();
+
+  EXPECT_EQ(table->row_count(), 4);
+  EXPECT_EQ(table->chunk_count(), 2);
+  ASSERT_TRUE(row_versions(ChunkID{0}));
+  EXPECT_EQ(row_versions(ChunkID{0})->row_count(), 2);
+  ASSERT_TRUE(row_versions(ChunkID{1}));
+  EXPECT_EQ(row_versions(ChunkID{1})->row_count(), 1);
+
+  const auto new_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(new_transaction_context),
+                            load_table("resources/test_data/tbl/int_float2_updated_0.tbl"));
+
+  // Transactions that started before the update still see the old values.
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(old_transaction_context),
+                            load_table("resources/test_data/tbl/int_float2.tbl"));
+}
+
+TEST_F(OperatorsUpdateTest, UpdateInPlaceRollback) {
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto update = update_b(transaction_context, 7.5f);
+  EXPECT_FALSE(update->execute_failed());
+  transaction_context->rollback(RollbackReason::User);
+
+  EXPECT_EQ(row_versions(ChunkID{0})->row_count(), 0);
+  EXPECT_EQ(row_versions(ChunkID{1})->row_count(), 0);
+
+  const auto new_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(new_transaction_context),
+                            load_table("resources/test_data/tbl/int_float2.tbl"));
+}
+
+TEST_F(OperatorsUpdateTest, UpdateInPlaceTwice) {
+  // The second version keeps the values of the first one.
+  const auto first_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto first_update = update_b(first_transaction_context, 1.5f);
+  EXPECT_FALSE(first_update->execute_failed());
+  first_transaction_context->commit();
+
+  const auto second_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto get_table = std::make_shared<GetTable>(table_to_update_name);
+  get_table->set_transaction_context(second_transaction_context);
+  const auto validate = std::make_shared<Validate>(get_table);
+  validate->set_transaction_context(second_transaction_context);
+  const auto where_scan = std::make_shared<TableScan>(validate, equals_(column_a, 123));
+  const auto updated_values_projection =
+      std::make_shared<Projection>(where_scan, expression_vector(add_(column_a, 1), column_b));
+  const auto update = std::make_shared<Update>(table_to_update_name, where_scan, updated_values_projection);
+  update->set_transaction_context(second_transaction_context);
+  execute_all({get_table, validate, where_scan, updated_values_projection, update});
+  EXPECT_FALSE(update->execute_failed());
+  second_transaction_context->commit();
+
+  const auto expected_table = std::make_shared<Table>(
+      TableColumnDefinitions{{"a", DataType::Int, false}, {"b", DataType::Float, false}}, TableType::Data);
+  expected_table->append({12345, 1.5f});
+  expected_table->append({12345, 1.5f});
+  expected_table->append({124, 1.5f});
+  expected_table->append({12, 350.7f});
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(transaction_context), expected_table);
+  EXPECT_EQ(Hyrise::get().storage_manager.get_table(table_to_update_name)->row_count(), 4);
+}
+
+TEST_F(OperatorsUpdateTest, ConcurrentUpdatesInPlaceConflict) {
+  const auto first_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto second_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+
+  const auto first_update = update_b(first_transaction_context, 1.5f);
+  EXPECT_FALSE(first_update->execute_failed());
+
+  // The rows were updated by a transaction that has not committed yet.
+  const auto second_update = update_b(second_transaction_context, 2.5f);
+  EXPECT_TRUE(second_update->execute_failed());
+  second_transaction_context->rollback(RollbackReason::Conflict);
+
+  // Once it has committed, transactions with an older snapshot cannot update the rows either.
+  const auto third_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  first_transaction_context->commit();
+  const auto third_update = update_b(third_transaction_context, 3.5f);
+  EXPECT_TRUE(third_update->execute_failed());
+  third_transaction_context->rollback(RollbackReason::Conflict);
+}
+
+TEST_F(OperatorsUpdateTest, DeleteAfterUpdateInPlaceFails) {
+  const auto delete_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  const auto get_table = std::make_shared<GetTable>(table_to_update_name);
+  get_table->set_transaction_context(delete_transaction_context);
+  const auto validate = std::make_shared<Validate>(get_table);
+  validate->set_transaction_context(delete_transaction_context);
+  execute_all({get_table, validate});
+
+  const auto update_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_FALSE(update_b(update_transaction_context, 1.5f)->execute_failed());
+  update_transaction_context->commit();
+
+  const auto delete_op = std::make_shared<Delete>(validate);
+  delete_op->set_transaction_context(delete_transaction_context);
+  delete_op->execute();
+  EXPECT_TRUE(delete_op->execute_failed());
+  delete_transaction_context->rollback(RollbackReason::Conflict);
+}
+
+TEST_F(OperatorsUpdateTest, UpdateMutableChunk) {
+  // Rows of mutable chunks are deleted and re-inserted.
+  const auto table = load_table("resources/test_data/tbl/int_float2.tbl", 10, FinalizeLastChunk::No);
+  Hyrise::get().storage_manager.drop_table(table_to_update_name);
+  Hyrise::get().storage_manager.add_table(table_to_update_name, table);
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_FALSE(update_b(transaction_context, 7.5f)->execute_failed());
+  transaction_context->commit();
+
+  EXPECT_EQ(table->row_count(), 7);
+  EXPECT_FALSE(table->get_chunk(ChunkID{0})->mvcc_data()->row_versions());
+
+  const auto new_transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  EXPECT_TABLE_EQ_UNORDERED(validated_table(new_transaction_context),
+                            load_table("resources/test_data/tbl/int_float2_updated_0.tbl"));
+}
+
 }  // namespace opossum
@@ -15,6 +15,8 @@
 #include "operators/table_scan.hpp"
 #include "operators/table_wrapper.hpp"
 #include "operators/validate.hpp"
+#include "storage/pos_lists/entire_chunk_pos_list.hpp"
+#include "storage/reference_segment.hpp"
 #include "storage/table.hpp"
 #include "types.hpp"
 
@@ -137,6 +139,121 @@ TEST_F(OperatorsValidateTest, ValidateAfterDelete) {
   t2_context->commit();
 }
 
+TEST_F(OperatorsValidateTest, ValidateFrozenChunks) {
+  EXPECT_TRUE(_test_table->get_chunk(ChunkID{0})->try_freeze_mvcc_data(CommitID{2}));
+  EXPECT_TRUE(_test_table->get_chunk(ChunkID{1})->try_freeze_mvcc_data(CommitID{2}));
+
+  auto context = std::make_shared<TransactionContext>(1u, 3u, AutoCommit::No);
+  auto validate = std::make_shared<Validate>(_table_wrapper);
+  validate->set_transaction_context(context);
+  validate->execute();
+  EXPECT_TABLE_EQ_UNORDERED(validate->get_output(),
+                            load_table("resources/test_data/tbl/validate_output_validated.tbl", 2u));
+
+  // Frozen chunks without invalid rows are entirely visible, even if the chunk shortcut cannot be used.
+  auto cache = Validate::EntirelyVisibleChunksCache{};
+  const auto visible_chunk = Validate::validate_chunk(_test_table, ChunkID{0}, 1u, 3u, false, cache);
+  ASSERT_TRUE(visible_chunk);
+  const auto& visible_segment = static_cast<const ReferenceSegment&>(*visible_chunk->get_segment(ColumnID{0}));
+  EXPECT_TRUE(std::dynamic_pointer_cast<const EntireChunkPosList>(visible_segment.pos_list()));
+
+  const auto filtered_chunk = Validate::validate_chunk(_test_table, ChunkID{1}, 1u, 3u, false, cache);
+  ASSERT_TRUE(filtered_chunk);
+  const auto& filtered_segment = static_cast<const ReferenceSegment&>(*filtered_chunk->get_segment(ColumnID{0}));
+  EXPECT_EQ(*filtered_segment.pos_list(), RowIDPosList({RowID{ChunkID{1}, ChunkOffset{1}}}));
+
+  // Rows locked after freezing are only invisible to the locking transaction.
+  const auto frozen_mvcc_data = _test_table->get_chunk(ChunkID{1})->mvcc_data();
+  ASSERT_TRUE(frozen_mvcc_data->compare_exchange_tid(ChunkOffset{1}, INVALID_TRANSACTION_ID, TransactionID{1}));
+  EXPECT_FALSE(Validate::validate_chunk(_test_table, ChunkID{1}, 1u, 3u, false, cache));
+  EXPECT_TRUE(Validate::validate_chunk(_test_table, ChunkID{1}, 2u, 3u, false, cache));
+}
+
+TEST_F(OperatorsValidateTest, VisibleRowsBitmap) {
+  // More than two blocks of 64 rows, with rows inserted, deleted, and locked at different commit ids
+  const auto row_count = ChunkOffset{150};
+  auto mvcc_data = MvccData{row_count + 10, 0};
+  for (auto chunk_offset = ChunkOffset{0}; chunk_offset < row_count; ++chunk_offset) {
+    mvcc_data.set_begin_cid(chunk_offset, chunk_offset % 7 == 0 ? MvccData::MAX_COMMIT_ID : chunk_offset % 5);
+    if (chunk_offset % 3 == 0) mvcc_data.set_end_cid(chunk_offset, 2 + chunk_offset % 4);
+    if (chunk_offset % 11 == 0) mvcc_data.set_tid(chunk_offset, TransactionID{chunk_offset % 2 + 1});
+  }
+
+  // INVALID_TRANSACTION_ID ignores the transaction ids of the rows, i.e., it behaves like an unknown transaction.
+  auto bitmap = std::vector<uint64_t>{};
+  for (const auto our_tid : {INVALID_TRANSACTION_ID, TransactionID{1}, TransactionID{2}}) {
+    const auto compared_tid = our_tid == INVALID_TRANSACTION_ID ? TransactionID{3} : our_tid;
+    for (auto snapshot_commit_id = CommitID{0}; snapshot_commit_id < 7; ++snapshot_commit_id) {
+      mvcc_data.visible_rows(our_tid, snapshot_commit_id, row_count, bitmap);
+      ASSERT_EQ(bitmap.size(), 3);
+      for (auto chunk_offset = ChunkOffset{0}; chunk_offset < 192; ++chunk_offset) {
+        const auto is_visible =
+            chunk_offset < row_count &&
+            Validate::is_row_visible(compared_tid, snapshot_commit_id, mvcc_data.get_tid(chunk_offset),
+                                     mvcc_data.get_begin_cid(chunk_offset), mvcc_data.get_end_cid(chunk_offset));
+        EXPECT_EQ((bitmap[chunk_offset / 64] >> (chunk_offset % 64)) & 1, is_visible ? 1u : 0u)
+            << "offset " << chunk_offset << ", snapshot " << snapshot_commit_id << ", tid " << our_tid;
+      }
+    }
+  }
+}
+
+TEST_F(OperatorsValidateTest, SharedVisibleRows) {
+  auto mvcc_data = MvccData{3, 0};
+  mvcc_data.set_begin_cid(1, 3);
+  mvcc_data.set_end_cid(2, 5);
+  mvcc_data.set_begin_cid(2, MvccData::MAX_COMMIT_ID);
+
+  // Row 0 is visible from commit id 0, row 1 from commit id 3. Row 2 is inserted by a pending transaction.
+  const auto visible_rows = mvcc_data.shared_visible_rows(3, 4, 6);
+  EXPECT_EQ(visible_rows->bitmap, std::vector<uint64_t>{0b011});
+  EXPECT_EQ(visible_rows->first_snapshot_commit_id, 3);
+  EXPECT_EQ(visible_rows->last_snapshot_commit_id, 4);
+
+  // Transactions with snapshots in the same range share the bitmap.
+  EXPECT_EQ(mvcc_data.cached_visible_rows(3, 3), visible_rows);
+  EXPECT_EQ(mvcc_data.shared_visible_rows(3, 3, 7), visible_rows);
+  EXPECT_FALSE(mvcc_data.cached_visible_rows(3, 2));
+  EXPECT_FALSE(mvcc_data.cached_visible_rows(3, 5));
+  EXPECT_FALSE(mvcc_data.cached_visible_rows(2, 4));
+
+  // The bitmap is not valid beyond the last commit id, as later commits might not have been written completely.
+  const auto later_visible_rows = mvcc_data.shared_visible_rows(3, 5, 5);
+  EXPECT_EQ(later_visible_rows->bitmap, std::vector<uint64_t>{0b011});
+  EXPECT_EQ(later_visible_rows->first_snapshot_commit_id, 5);
+  EXPECT_EQ(later_visible_rows->last_snapshot_commit_id, 5);
+  EXPECT_FALSE(mvcc_data.cached_visible_rows(3, 6));
+
+  // A new bitmap replaces the previous one.
+  EXPECT_FALSE(mvcc_data.cached_visible_rows(3, 4));
+}
+
+TEST_F(OperatorsValidateTest, ValidateSortedReferenceSegmentWithMultipleChunks) {
+  // Rows of the same chunk are checked together. With a shared bitmap, the result must not change.
+  const auto pos_list = std::make_shared<RowIDPosList>();
+  pos_list->emplace_back(RowID{ChunkID{0}, 0u});
+  pos_list->emplace_back(RowID{ChunkID{0}, 1u});
+  pos_list->emplace_back(RowID{ChunkID{1}, 0u});
+  pos_list->emplace_back(RowID{ChunkID{1}, 1u});
+
+  auto segments = Segments{};
+  for (auto column_id = ColumnID{0}; column_id < _test_table->column_count(); ++column_id) {
+    segments.emplace_back(std::make_shared<ReferenceSegment>(_test_table, column_id, pos_list));
+  }
+  const auto reference_table = std::make_shared<Table>(_test_table->column_definitions(), TableType::References);
+  reference_table->append_chunk(segments);
+
+  const auto chunk = _test_table->get_chunk(ChunkID{1});
+  chunk->mvcc_data()->shared_visible_rows(chunk->size(), 3u, 3u);
+
+  auto cache = Validate::EntirelyVisibleChunksCache{};
+  const auto validated_chunk = Validate::validate_chunk(reference_table, ChunkID{0}, 1u, 3u, true, cache);
+  ASSERT_TRUE(validated_chunk);
+  const auto& validated_segment = static_cast<const ReferenceSegment&>(*validated_chunk->get_segment(ColumnID{0}));
+  EXPECT_EQ(*validated_segment.pos_list(),
+            RowIDPosList({RowID{ChunkID{0}, 0u}, RowID{ChunkID{0}, 1u}, RowID{ChunkID{1}, 1u}}));
+}
+
 TEST_F(OperatorsValidateTest, ChunkEntirelyVisibleThrowsOnRefChunk) {
   if (!HYRISE_DEBUG) GTEST_SKIP();
 
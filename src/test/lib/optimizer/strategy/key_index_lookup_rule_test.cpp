@@ -0,0 +1,150 @@
+#include <memory>
+
+#include "expression/expression_functional.hpp"
+#include "logical_query_plan/lqp_utils.hpp"
+#include "logical_query_plan/predicate_node.hpp"
+#include "logical_query_plan/projection_node.hpp"
+#include "logical_query_plan/stored_table_node.hpp"
+#include "logical_query_plan/union_node.hpp"
+#include "logical_query_plan/validate_node.hpp"
+#include "optimizer/strategy/key_index_lookup_rule.hpp"
+#include "strategy_base_test.hpp"
+
+using namespace opossum::expression_functional;  // NOLINT
+
+namespace opossum {
+
+class KeyIndexLookupRuleTest : public StrategyBaseTest {
+ public:
+  void SetUp() override {
+    const auto table = load_table("resources/test_data/tbl/int_int_float.tbl", 2);
+    table->add_soft_key_constraint({{ColumnID{0}, ColumnID{2}}, KeyConstraintType::PRIMARY_KEY});
+    table->create_key_index({ColumnID{2}, ColumnID{0}});
+    Hyrise::get().storage_manager.add_table("int_int_float", table);
+    Hyrise::get().storage_manager.add_table("int_int_float_without_index",
+                                            load_table("resources/test_data/tbl/int_int_float.tbl", 2));
+
+    rule = std::make_shared<KeyIndexLookupRule>();
+    node = StoredTableNode::make("int_int_float");
+    a = node->get_column("a");
+    b = node->get_column("b");
+    c = node->get_column("c");
+  }
+
+  std::shared_ptr<KeyIndexLookupRule> rule;
+  std::shared_ptr<StoredTableNode> node;
+  std::shared_ptr<LQPColumnExpression> a, b, c;
+};
+
+TEST_F(KeyIndexLookupRuleTest, ReplacesKeyPredicates) {
+  // clang-format off
+  const auto input_lqp =
+  ProjectionNode::make(expression_vector(b),
+    PredicateNode::make(equals_(a, 9),
+      PredicateNode::make(greater_than_(b, 5),
+        ValidateNode::make(
+          PredicateNode::make(equals_(11.5f, c),
+            node)))));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  // The predicates are ordered like the columns of the key index.
+  const auto lookup_node = PredicateNode::make(and_(equals_(c, 11.5f), equals_(a, 9)));
+
+  // clang-format off
+  const auto expected_lqp =
+  ProjectionNode::make(expression_vector(b),
+    PredicateNode::make(greater_than_(b, 5),
+      ValidateNode::make(
+        lookup_node)));
+  // clang-format on
+  lookup_node->set_left_input(node);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+
+  const auto actual_lookup_node =
+      std::dynamic_pointer_cast<PredicateNode>(actual_lqp->left_input()->left_input()->left_input());
+  ASSERT_TRUE(actual_lookup_node);
+  EXPECT_EQ(actual_lookup_node->scan_type, ScanType::KeyIndexLookup);
+}
+
+TEST_F(KeyIndexLookupRuleTest, CorrelatedParameters) {
+  const auto parameter = correlated_parameter_(ParameterID{0}, a);
+
+  // clang-format off
+  const auto input_lqp =
+  PredicateNode::make(equals_(a, parameter),
+    PredicateNode::make(equals_(c, 11.5f),
+      node));
+  // clang-format on
+
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  const auto expected_lqp = PredicateNode::make(and_(equals_(c, 11.5f), equals_(a, parameter)), node);
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+  EXPECT_EQ(std::static_pointer_cast<PredicateNode>(actual_lqp)->scan_type, ScanType::KeyIndexLookup);
+}
+
+TEST_F(KeyIndexLookupRuleTest, IncompleteKey) {
+  // clang-format off
+  const auto input_lqp =
+  PredicateNode::make(equals_(a, 9),
+    PredicateNode::make(less_than_(c, 11.5f),
+      node));
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+  EXPECT_EQ(std::static_pointer_cast<PredicateNode>(actual_lqp)->scan_type, ScanType::TableScan);
+}
+
+TEST_F(KeyIndexLookupRuleTest, ColumnComparison) {
+  // clang-format off
+  const auto input_lqp =
+  PredicateNode::make(equals_(a, b),
+    PredicateNode::make(equals_(c, 11.5f),
+      node));
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(KeyIndexLookupRuleTest, NoKeyIndex) {
+  const auto node_without_index = StoredTableNode::make("int_int_float_without_index");
+
+  // clang-format off
+  const auto input_lqp =
+  PredicateNode::make(equals_(node_without_index->get_column("a"), 9),
+    PredicateNode::make(equals_(node_without_index->get_column("c"), 11.5f),
+      node_without_index));
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+TEST_F(KeyIndexLookupRuleTest, StoredTableNodeWithMultipleOutputs) {
+  // clang-format off
+  const auto input_lqp =
+  UnionNode::make(SetOperationMode::Positions,
+    PredicateNode::make(equals_(a, 9),
+      PredicateNode::make(equals_(c, 11.5f),
+        node)),
+    node);
+  // clang-format on
+
+  const auto expected_lqp = input_lqp->deep_copy();
+  const auto actual_lqp = apply_rule(rule, input_lqp);
+
+  EXPECT_LQP_EQ(actual_lqp, expected_lqp);
+}
+
+}  // namespace opossum
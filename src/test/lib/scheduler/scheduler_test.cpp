@@ -13,6 +13,8 @@
 #include "scheduler/job_task.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
 #include "scheduler/operator_task.hpp"
+#include "scheduler/task_queue.hpp"
+#include "scheduler/work_stealing_scheduler.hpp"
 
 using namespace opossum::expression_functional;  // NOLINT
 
@@ -245,6 +247,60 @@ TEST_F(SchedulerTest, MultipleOperators) {
   EXPECT_TABLE_EQ_UNORDERED(ts->get_output(), expected_result);
 }
 
+TEST_F(SchedulerTest, GroupingByPreferredNode) {
+  // Tasks with different preferred NUMA nodes must not end up in the same chain, as the chain is executed by a single
+  // worker.
+  if (std::thread::hardware_concurrency() < 2) GTEST_SKIP();
+  Hyrise::get().topology.use_fake_numa_topology(2, 1);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  constexpr auto TASK_COUNT = 50;
+  for (auto task_id = 0; task_id < TASK_COUNT; ++task_id) {
+    tasks.emplace_back(std::make_shared<JobTask>([] {}));
+    tasks.back()->set_preferred_node_id(NodeID{static_cast<NodeID::base_type>(task_id % 2)});
+  }
+  Hyrise::get().scheduler()->schedule_and_wait_for_tasks(tasks);
+
+  for (const auto& task : tasks) {
+    for (const auto& successor : task->successors()) {
+      EXPECT_EQ(successor->preferred_node_id(), task->preferred_node_id());
+    }
+  }
+
+  // Every task with a preferred node was counted as either local or remote, depending on whether it was stolen.
+  const auto& scheduler = Hyrise::get().scheduler();
+  EXPECT_EQ(scheduler->numa_local_task_count() + scheduler->numa_remote_task_count(), TASK_COUNT);
+
+  scheduler->finish();
+}
+
+TEST_F(SchedulerTest, PreferredNode) {
+  if (std::thread::hardware_concurrency() < 2) GTEST_SKIP();
+  Hyrise::get().topology.use_fake_numa_topology(2, 1);
+  Hyrise::get().set_scheduler(std::make_shared<NodeQueueScheduler>());
+
+  // The task is put into the queue of its preferred node. As long as it is not stolen, it is executed there.
+  auto executing_node_id = INVALID_NODE_ID;
+  const auto task = std::make_shared<JobTask>(
+      [&executing_node_id] { executing_node_id = Worker::get_this_thread_worker()->queue()->node_id(); });
+  task->set_preferred_node_id(NodeID{1});
+  task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{task});
+
+  const auto& scheduler = Hyrise::get().scheduler();
+  EXPECT_EQ(scheduler->numa_local_task_count() + scheduler->numa_remote_task_count(), 1);
+  EXPECT_EQ(scheduler->numa_local_task_count(), executing_node_id == NodeID{1} ? 1 : 0);
+
+  // Preferred nodes that do not exist in the topology are ignored.
+  const auto other_task = std::make_shared<JobTask>([] {});
+  other_task->set_preferred_node_id(NodeID{5});
+  other_task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{other_task});
+
+  scheduler->finish();
+}
+
 TEST_F(SchedulerTest, VerifyTaskQueueSetup) {
   if (std::thread::hardware_concurrency() < 4) {
     // If the machine has less than 4 cores, the calls to use_non_numa_topology()
@@ -290,4 +346,86 @@ TEST_F(SchedulerTest, SingleWorkerGuaranteeProgress) {
   Hyrise::get().scheduler()->finish();
 }
 
+TEST_F(SchedulerTest, WorkStealingSchedulerBasicTest) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<WorkStealingScheduler>());
+
+  std::atomic_uint counter{0};
+
+  increment_counter_in_subtasks(counter);
+
+  Hyrise::get().scheduler()->finish();
+
+  ASSERT_EQ(counter, 30u);
+
+  Hyrise::get().set_scheduler(std::make_shared<ImmediateExecutionScheduler>());
+}
+
+TEST_F(SchedulerTest, WorkStealingSchedulerDependencies) {
+  Hyrise::get().topology.use_fake_numa_topology(8, 4);
+  Hyrise::get().set_scheduler(std::make_shared<WorkStealingScheduler>());
+
+  std::atomic_uint linear_counter{0u};
+  std::atomic_uint multiple_counter{0u};
+  std::atomic_uint diamond_counter{0u};
+
+  stress_linear_dependencies(linear_counter);
+  stress_multiple_dependencies(multiple_counter);
+  stress_diamond_dependencies(diamond_counter);
+
+  Hyrise::get().scheduler()->finish();
+
+  EXPECT_EQ(linear_counter, 3u);
+  EXPECT_EQ(multiple_counter, 4u);
+  EXPECT_EQ(diamond_counter, 7u);
+}
+
+TEST_F(SchedulerTest, WorkStealingSchedulerNestedJobs) {
+  // Jobs spawned by a worker end up in its deque and have to be stolen by the other workers (also on remote nodes).
+  Hyrise::get().topology.use_fake_numa_topology(8, 2);
+  Hyrise::get().set_scheduler(std::make_shared<WorkStealingScheduler>());
+
+  constexpr auto JOB_COUNT = 100u;
+  std::atomic_uint counter{0u};
+
+  auto task = std::make_shared<JobTask>([&]() {
+    auto jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+    for (auto job_id = 0u; job_id < JOB_COUNT; ++job_id) {
+      jobs.emplace_back(std::make_shared<JobTask>([&]() {
+        auto inner_jobs = std::vector<std::shared_ptr<AbstractTask>>{};
+        for (auto inner_job_id = 0u; inner_job_id < 10u; ++inner_job_id) {
+          inner_jobs.emplace_back(std::make_shared<JobTask>([&]() { ++counter; }));
+        }
+        Hyrise::get().scheduler()->schedule_and_wait_for_tasks(inner_jobs);
+      }));
+    }
+    Hyrise::get().scheduler()->schedule_and_wait_for_tasks(jobs);
+  });
+
+  task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{task});
+  Hyrise::get().scheduler()->finish();
+
+  EXPECT_EQ(counter, JOB_COUNT * 10u);
+}
+
+TEST_F(SchedulerTest, WorkStealingSchedulerSingleWorkerGuaranteeProgress) {
+  Hyrise::get().topology.use_default_topology(1);
+  Hyrise::get().set_scheduler(std::make_shared<WorkStealingScheduler>());
+
+  auto task_done = false;
+  auto task = std::make_shared<JobTask>([&task_done]() {
+    auto subtask = std::make_shared<JobTask>([&task_done]() { task_done = true; });
+
+    subtask->schedule();
+    Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{subtask});
+  });
+
+  task->schedule();
+  Hyrise::get().scheduler()->wait_for_tasks(std::vector<std::shared_ptr<AbstractTask>>{task});
+  EXPECT_TRUE(task_done);
+
+  Hyrise::get().scheduler()->finish();
+}
+
 }  // namespace opossum
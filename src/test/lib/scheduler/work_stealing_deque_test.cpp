@@ -0,0 +1,137 @@
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "scheduler/job_task.hpp"
+#include "scheduler/work_stealing_deque.hpp"
+
+namespace opossum {
+
+class WorkStealingDequeTest : public BaseTest {
+ protected:
+  std::shared_ptr<AbstractTask> make_task() { return std::make_shared<JobTask>([]() {}); }
+};
+
+TEST_F(WorkStealingDequeTest, EmptyDeque) {
+  auto deque = WorkStealingDeque{};
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(deque.size(), 0);
+  EXPECT_EQ(deque.pop(), nullptr);
+  EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST_F(WorkStealingDequeTest, PopIsLifoStealIsFifo) {
+  auto deque = WorkStealingDeque{};
+  const auto task_a = make_task();
+  const auto task_b = make_task();
+  const auto task_c = make_task();
+
+  deque.push(task_a);
+  deque.push(task_b);
+  deque.push(task_c);
+  EXPECT_EQ(deque.size(), 3);
+
+  EXPECT_EQ(deque.pop(), task_c);
+  EXPECT_EQ(deque.steal(), task_a);
+  EXPECT_EQ(deque.pop(), task_b);
+  EXPECT_TRUE(deque.empty());
+  EXPECT_EQ(deque.pop(), nullptr);
+  EXPECT_EQ(deque.steal(), nullptr);
+}
+
+TEST_F(WorkStealingDequeTest, Grow) {
+  auto deque = WorkStealingDeque{4};
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  for (auto task_id = 0; task_id < 100; ++task_id) {
+    tasks.emplace_back(make_task());
+    deque.push(tasks.back());
+  }
+  EXPECT_EQ(deque.size(), 100);
+
+  for (auto task_id = 0; task_id < 50; ++task_id) {
+    EXPECT_EQ(deque.steal(), tasks[task_id]);
+  }
+  for (auto task_id = 99; task_id >= 50; --task_id) {
+    EXPECT_EQ(deque.pop(), tasks[task_id]);
+  }
+  EXPECT_TRUE(deque.empty());
+}
+
+TEST_F(WorkStealingDequeTest, ReleasesRemainingTasks) {
+  const auto task = make_task();
+  {
+    auto deque = WorkStealingDeque{};
+    deque.push(task);
+    EXPECT_EQ(task.use_count(), 2);
+  }
+  EXPECT_EQ(task.use_count(), 1);
+}
+
+TEST_F(WorkStealingDequeTest, ConcurrentPopAndSteal) {
+  // The owner pushes and pops while several thieves steal. Every task must be taken exactly once.
+  constexpr auto TASK_COUNT = 20'000;
+  constexpr auto THIEF_COUNT = 4;
+
+  auto deque = WorkStealingDeque{16};
+  auto tasks = std::vector<std::shared_ptr<AbstractTask>>{};
+  auto task_ids = std::unordered_map<AbstractTask*, size_t>{};
+  for (auto task_id = 0; task_id < TASK_COUNT; ++task_id) {
+    tasks.emplace_back(make_task());
+    task_ids.emplace(tasks.back().get(), task_id);
+  }
+
+  auto taken = std::vector<std::atomic_uint>(TASK_COUNT);
+  auto done = std::atomic_bool{false};
+  auto taken_count = std::atomic_uint{0};
+
+  const auto mark_taken = [&](const std::shared_ptr<AbstractTask>& task) {
+    const auto task_id_iter = task_ids.find(task.get());
+    ASSERT_NE(task_id_iter, task_ids.end());
+    ++taken[task_id_iter->second];
+    ++taken_count;
+  };
+
+  auto thieves = std::vector<std::thread>{};
+  for (auto thief_id = 0; thief_id < THIEF_COUNT; ++thief_id) {
+    thieves.emplace_back([&]() {
+      while (!done) {
+        const auto task = deque.steal();
+        if (task) mark_taken(task);
+      }
+    });
+  }
+
+  for (auto task_id = 0; task_id < TASK_COUNT; ++task_id) {
+    deque.push(tasks[task_id]);
+    if (task_id % 3 == 0) {
+      const auto task = deque.pop();
+      if (task) mark_taken(task);
+    }
+  }
+
+  while (true) {
+    const auto task = deque.pop();
+    if (!task) break;
+    mark_taken(task);
+  }
+
+  // The deque might appear empty to the owner while a thief is about to complete its steal.
+  while (taken_count < TASK_COUNT) {
+    std::this_thread::yield();
+  }
+
+  done = true;
+  for (auto& thief : thieves) {
+    thief.join();
+  }
+
+  for (auto task_id = 0; task_id < TASK_COUNT; ++task_id) {
+    EXPECT_EQ(taken[task_id], 1);
+  }
+}
+
+}  // namespace opossum
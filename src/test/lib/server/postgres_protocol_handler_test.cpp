@@ -249,6 +249,7 @@ TEST_F(PostgresProtocolHandlerTest, ReadBindPacket) {
   EXPECT_EQ(statement_information.portal, portal);
   EXPECT_EQ(statement_information.statement_name, statement_name);
   EXPECT_EQ(statement_information.parameters, std::vector<AllTypeVariant>{"test"});
+  EXPECT_EQ(statement_information.result_format_codes, std::vector<PostgresFormatCode>{PostgresFormatCode::Text});
 }
 
 TEST_F(PostgresProtocolHandlerTest, ReadExecutePacket) {
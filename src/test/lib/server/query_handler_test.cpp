@@ -34,7 +34,7 @@ TEST_F(QueryHandlerTest, CreatePreparedPlan) {
 
 TEST_F(QueryHandlerTest, BindParameters) {
   QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a = ?");
-  const auto specification = PreparedStatementDetails{"test_statement", "", {12345}};
+  const auto specification = PreparedStatementDetails{"test_statement", "", {12345}, {}};
 
   const auto bound_plan = QueryHandler::bind_prepared_plan(specification);
   EXPECT_EQ(bound_plan->type(), OperatorType::Validate);
@@ -50,7 +50,7 @@ TEST_F(QueryHandlerTest, BindParameters) {
 
 TEST_F(QueryHandlerTest, ExecutePreparedStatement) {
   QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a > ?");
-  const auto specification = PreparedStatementDetails{"test_statement", "", {123}};
+  const auto specification = PreparedStatementDetails{"test_statement", "", {123}, {}};
   const auto pqp = QueryHandler::bind_prepared_plan(specification);
 
   auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
@@ -61,6 +61,35 @@ TEST_F(QueryHandlerTest, ExecutePreparedStatement) {
   EXPECT_EQ(result_table->column_count(), 2u);
 }
 
+TEST_F(QueryHandlerTest, BindOptimizedPreparedPlan) {
+  QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a > ?");
+  auto optimized_prepared_plans = OptimizedPreparedPlans{};
+
+  const auto pqp_1 = QueryHandler::bind_prepared_plan({"test_statement", "", {123}, {}}, optimized_prepared_plans);
+  ASSERT_EQ(optimized_prepared_plans.size(), 1u);
+  const auto optimized_lqp = optimized_prepared_plans["test_statement"].optimized_lqp;
+  ASSERT_TRUE(optimized_lqp);
+  EXPECT_TRUE(optimized_prepared_plans["test_statement"].has_placeholder_predicates);
+
+  // The optimized plan is reused
+  const auto pqp_2 = QueryHandler::bind_prepared_plan({"test_statement", "", {1234}, {}}, optimized_prepared_plans);
+  EXPECT_EQ(optimized_prepared_plans["test_statement"].optimized_lqp, optimized_lqp);
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::Yes);
+  pqp_1->set_transaction_context_recursively(transaction_context);
+  pqp_2->set_transaction_context_recursively(transaction_context);
+  const auto result_tables = QueryHandler::execute_prepared_plans({pqp_1, pqp_2});
+  ASSERT_EQ(result_tables.size(), 2u);
+  EXPECT_EQ(result_tables[0]->row_count(), 2u);
+  EXPECT_EQ(result_tables[1]->row_count(), 1u);
+
+  // A redefined statement is optimized again
+  Hyrise::get().storage_manager.drop_prepared_plan("test_statement");
+  QueryHandler::setup_prepared_plan("test_statement", "SELECT * FROM table_a WHERE a <= ?");
+  QueryHandler::bind_prepared_plan({"test_statement", "", {123}, {}}, optimized_prepared_plans);
+  EXPECT_NE(optimized_prepared_plans["test_statement"].optimized_lqp, optimized_lqp);
+}
+
 TEST_F(QueryHandlerTest, CorrectlyInvalidateStatements) {
   QueryHandler::setup_prepared_plan("", "SELECT * FROM table_a WHERE a > ?");
   const auto old_plan = Hyrise::get().storage_manager.get_prepared_plan("");
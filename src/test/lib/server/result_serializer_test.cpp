@@ -43,6 +43,117 @@ TEST_F(ResultSerializerTest, QueryResponse) {
   EXPECT_EQ(std::count(file_content.begin(), file_content.end(), 'D'), _test_table->row_count());
 }
 
+TEST_F(ResultSerializerTest, RowDescriptionFormatCodes) {
+  ResultSerializer::send_table_description(_test_table, _protocol_handler, {PostgresFormatCode::Binary});
+  _protocol_handler->force_flush();
+  const std::string file_content = _mocked_socket->read();
+
+  // Skip the message type, the length, and the column count. Each field description ends with its format code.
+  auto start = sizeof(PostgresMessageType) + sizeof(uint32_t) + sizeof(uint16_t);
+  for (ColumnID column_id{0}; column_id < _test_table->column_count(); column_id++) {
+    start += _test_table->column_name(column_id).size() + 1u + 3 * sizeof(uint32_t) + 2 * sizeof(uint16_t);
+    EXPECT_EQ(NetworkConversionHelper::get_small_int(file_content.cbegin() + start), 1);
+    start += sizeof(uint16_t);
+  }
+  EXPECT_EQ(start, file_content.size());
+}
+
+TEST_F(ResultSerializerTest, StreamedQueryResponseMatchesSerializedChunks) {
+  // More chunks than are serialized ahead
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                             ChunkOffset{2});
+  for (auto value = int32_t{0}; value < 40; ++value) {
+    table->append({value});
+  }
+  ASSERT_GT(table->chunk_count(), ResultSerializer::MAX_BUFFERED_CHUNK_COUNT);
+
+  ResultSerializer::send_query_response(table, _protocol_handler, {PostgresFormatCode::Binary});
+  _protocol_handler->force_flush();
+
+  auto serialized_chunks = std::string{};
+  const auto format_codes = ResultSerializer::column_format_codes({PostgresFormatCode::Binary}, table->column_count());
+  for (auto chunk_id = ChunkID{0}; chunk_id < table->chunk_count(); ++chunk_id) {
+    const auto data_rows = ResultSerializer::serialize_chunk(table->get_chunk(chunk_id), format_codes);
+    serialized_chunks.append(data_rows.begin(), data_rows.end());
+  }
+  EXPECT_EQ(_mocked_socket->read(), serialized_chunks);
+}
+
+TEST_F(ResultSerializerTest, SerializeChunkAsText) {
+  // Row 104|null|104|null|104|null|104|null|104|null
+  const auto format_codes = ResultSerializer::column_format_codes({}, _test_table->column_count());
+  const auto data_rows = ResultSerializer::serialize_chunk(_test_table->get_chunk(ChunkID{2}), format_codes);
+  const auto file_content = std::string(data_rows.begin(), data_rows.end());
+
+  EXPECT_EQ(static_cast<PostgresMessageType>(file_content.front()), PostgresMessageType::DataRow);
+  const auto message_length = NetworkConversionHelper::get_message_length(file_content.cbegin() + 1);
+  EXPECT_EQ(message_length, sizeof(uint32_t) + sizeof(uint16_t) + 10 * sizeof(uint32_t) + 5 * 3);
+  EXPECT_EQ(NetworkConversionHelper::get_small_int(file_content.cbegin() + 5), 10);
+
+  auto start = sizeof(PostgresMessageType) + sizeof(uint32_t) + sizeof(uint16_t);
+  for (auto column_id = ColumnID{0}; column_id < 10; column_id += 2) {
+    EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + start), 3);
+    EXPECT_EQ(file_content.substr(start + sizeof(uint32_t), 3), "104");
+    start += sizeof(uint32_t) + 3;
+    EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + start), -1);
+    start += sizeof(uint32_t);
+  }
+  EXPECT_EQ(static_cast<PostgresMessageType>(file_content[start]), PostgresMessageType::DataRow);
+}
+
+TEST_F(ResultSerializerTest, SerializeChunkAsBinary) {
+  // Row 100|100|100|100|100|100|100|100|100|100, only the string columns are sent as text
+  const auto format_codes = ResultSerializer::column_format_codes(
+      {PostgresFormatCode::Binary, PostgresFormatCode::Binary, PostgresFormatCode::Binary, PostgresFormatCode::Binary,
+       PostgresFormatCode::Binary, PostgresFormatCode::Binary, PostgresFormatCode::Binary, PostgresFormatCode::Text,
+       PostgresFormatCode::Text, PostgresFormatCode::Binary},
+      _test_table->column_count());
+  const auto data_rows = ResultSerializer::serialize_chunk(_test_table->get_chunk(ChunkID{0}), format_codes);
+  const auto file_content = std::string(data_rows.begin(), data_rows.end());
+
+  auto start = sizeof(PostgresMessageType) + sizeof(uint32_t) + sizeof(uint16_t);
+  const auto read_value = [&](const auto expected_size) {
+    EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + start), expected_size);
+    start += sizeof(uint32_t);
+    auto value = uint64_t{0};
+    for (auto byte_id = size_t{0}; byte_id < expected_size; ++byte_id) {
+      value = (value << 8) | static_cast<unsigned char>(file_content[start + byte_id]);
+    }
+    start += expected_size;
+    return value;
+  };
+
+  EXPECT_EQ(read_value(sizeof(int32_t)), 100);
+  EXPECT_EQ(read_value(sizeof(int32_t)), 100);
+  EXPECT_EQ(read_value(sizeof(int64_t)), 100);
+  EXPECT_EQ(read_value(sizeof(int64_t)), 100);
+  EXPECT_EQ(read_value(sizeof(float)), std::bit_cast<uint32_t>(100.0f));
+  EXPECT_EQ(read_value(sizeof(float)), std::bit_cast<uint32_t>(100.0f));
+  EXPECT_EQ(read_value(sizeof(double)), std::bit_cast<uint64_t>(100.0));
+  // Text format
+  EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + start), 3);
+  EXPECT_EQ(file_content.substr(start + sizeof(uint32_t), 3), "100");
+  start += sizeof(uint32_t) + 3;
+  // Strings are the same in both formats
+  for (auto column_id = 0; column_id < 2; ++column_id) {
+    EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + start), 3);
+    EXPECT_EQ(file_content.substr(start + sizeof(uint32_t), 3), "100");
+    start += sizeof(uint32_t) + 3;
+  }
+  EXPECT_EQ(NetworkConversionHelper::get_message_length(file_content.cbegin() + 1), start - 1);
+}
+
+TEST_F(ResultSerializerTest, ColumnFormatCodes) {
+  const auto text = PostgresFormatCode::Text;
+  const auto binary = PostgresFormatCode::Binary;
+  EXPECT_EQ(ResultSerializer::column_format_codes({}, ColumnCount{2}), std::vector<PostgresFormatCode>(2, text));
+  EXPECT_EQ(ResultSerializer::column_format_codes({binary}, ColumnCount{3}),
+            std::vector<PostgresFormatCode>(3, binary));
+  EXPECT_EQ(ResultSerializer::column_format_codes({binary, text}, ColumnCount{2}),
+            (std::vector<PostgresFormatCode>{binary, text}));
+  EXPECT_THROW(ResultSerializer::column_format_codes({binary, text}, ColumnCount{3}), InvalidInputException);
+}
+
 TEST_F(ResultSerializerTest, CommandCompleteMessage) {
   EXPECT_EQ(ResultSerializer::build_command_complete_message(OperatorType::Insert, 1), "INSERT 0 1");
   EXPECT_EQ(ResultSerializer::build_command_complete_message(OperatorType::Update, 1), "UPDATE -1");
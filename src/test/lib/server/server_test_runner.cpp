@@ -498,4 +498,99 @@ TEST_F(ServerTestRunner, TestTransactionConflicts) {
   EXPECT_EQ(final_sum - initial_sum, successful_increments);
 }
 
+// Runs a selection of the tests above against the asynchronous server mode
+class AsyncServerTestRunner : public ServerTestRunner {
+ protected:
+  AsyncServerTestRunner() {
+    _server = std::make_unique<Server>(boost::asio::ip::address(), 0, SendExecutionInfo::No, PlanCacheType::GDFS,
+                                       ServerMode::Async, 2);
+  }
+};
+
+TEST_F(AsyncServerTestRunner, TestSimpleSelect) {
+  pqxx::connection connection{_connection_string};
+  pqxx::nontransaction transaction{connection};
+
+  const auto result = transaction.exec("SELECT * FROM table_a;");
+  EXPECT_EQ(result.size(), _table_a->row_count());
+
+  // Results that exceed MessageStream::OUTPUT_HANDLER_THRESHOLD are sent in parts
+  const auto large_result = transaction.exec(
+      "SELECT t1.a FROM table_a t1, table_a t2, table_a t3, table_a t4, table_a t5, table_a t6, table_a t7, "
+      "table_a t8, table_a t9");
+  EXPECT_EQ(large_result.size(), 19'683u);
+}
+
+TEST_F(AsyncServerTestRunner, TestInvalidStatement) {
+  pqxx::connection connection{_connection_string};
+  pqxx::nontransaction transaction{connection};
+
+  EXPECT_THROW(transaction.exec("SELECT * FROM;"), pqxx::sql_error);
+  EXPECT_THROW(transaction.exec("SELECT * FROM non_existent;"), pqxx::sql_error);
+
+  const auto result = transaction.exec("SELECT * FROM table_a;");
+  EXPECT_EQ(result.size(), _table_a->row_count());
+}
+
+TEST_F(AsyncServerTestRunner, TestPreparedStatement) {
+  pqxx::connection connection{_connection_string};
+  pqxx::nontransaction transaction{connection};
+
+  const std::string prepared_name = "statement1";
+  connection.prepare(prepared_name, "SELECT * FROM table_a WHERE a > ?");
+
+  const auto result1 = transaction.exec_prepared(prepared_name, 1234u);
+  EXPECT_EQ(result1.size(), 1u);
+  const auto result2 = transaction.exec_prepared(prepared_name, 123);
+  EXPECT_EQ(result2.size(), 2u);
+}
+
+TEST_F(AsyncServerTestRunner, TestTransactionCommit) {
+  pqxx::connection connection{_connection_string};
+  pqxx::connection verification_connection{_connection_string};
+
+  pqxx::transaction transaction{connection};
+  transaction.exec("INSERT INTO table_a (a, b) VALUES (1, 2);");
+
+  {
+    pqxx::transaction verification_transaction{verification_connection};
+    const auto verification_result = verification_transaction.exec("SELECT * FROM table_a;");
+    EXPECT_EQ(verification_result.size(), 3);
+  }
+
+  transaction.commit();
+
+  {
+    pqxx::transaction verification_transaction{verification_connection};
+    const auto verification_result = verification_transaction.exec("SELECT * FROM table_a;");
+    EXPECT_EQ(verification_result.size(), 4);
+  }
+}
+
+TEST_F(AsyncServerTestRunner, TestParallelConnections) {
+  // Many more clients than I/O threads: Open all connections first, then send the queries.
+  const auto connection_count = 200u;
+  auto connections = std::vector<std::unique_ptr<pqxx::connection>>{};
+  for (auto connection_id = 0u; connection_id < connection_count; ++connection_id) {
+    connections.emplace_back(std::make_unique<pqxx::connection>(_connection_string));
+  }
+
+  const auto expected_num_rows = _table_a->row_count();
+  auto thread_futures = std::vector<std::future<void>>{};
+  for (auto& connection : connections) {
+    thread_futures.emplace_back(std::async(std::launch::async, [&]() {
+      pqxx::nontransaction transaction{*connection};
+      const auto result = transaction.exec("SELECT * FROM table_a;");
+      EXPECT_EQ(result.size(), expected_num_rows);
+    }));
+  }
+
+  for (auto& thread_future : thread_futures) {
+    if (thread_future.wait_for(std::chrono::seconds(150)) == std::future_status::timeout) {
+      ASSERT_TRUE(false) << "At least one thread got stuck.";
+    }
+    thread_future.get();
+  }
+}
+
 }  // namespace opossum
@@ -0,0 +1,162 @@
+#include "base_test.hpp"
+
+#include "server/message_stream.hpp"
+#include "server/session.hpp"
+
+namespace opossum {
+
+// Runs a session on an in-memory stream. This allows sending a pipeline of messages at once and checking that the
+// responses are only sent once the client requests them.
+class SessionTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    const auto& table_a = load_table("resources/test_data/tbl/int_float.tbl", 2);
+    Hyrise::get().storage_manager.add_table("table_a", table_a);
+
+    _stream = std::make_shared<MessageStream>();
+    _session = std::make_shared<Session<MessageStream>>(_stream, SendExecutionInfo::No);
+
+    const auto startup_body = std::string{"user\0hyrise\0\0", 13};
+    const auto startup_packet =
+        _int32(static_cast<uint32_t>(2 * sizeof(uint32_t) + startup_body.size())) + _int32(196608) + startup_body;
+    _stream->append_input(startup_packet.data(), startup_packet.size());
+    _session->establish_connection();
+    _stream->take_output();
+
+    _handle_messages(_parse("select", "SELECT * FROM table_a WHERE a > ?") +
+                     _parse("insert", "INSERT INTO table_a VALUES (55555, 1.0)") + _sync);
+  }
+
+  static std::string _int16(const uint16_t value) {
+    const auto network_value = htons(value);
+    return std::string(reinterpret_cast<const char*>(&network_value), sizeof(network_value));
+  }
+
+  static std::string _int32(const uint32_t value) {
+    const auto network_value = htonl(value);
+    return std::string(reinterpret_cast<const char*>(&network_value), sizeof(network_value));
+  }
+
+  static std::string _message(const char type, const std::string& body) {
+    return type + _int32(static_cast<uint32_t>(sizeof(uint32_t) + body.size())) + body;
+  }
+
+  static std::string _parse(const std::string& statement_name, const std::string& query) {
+    return _message('P', statement_name + '\0' + query + '\0' + _int16(0));
+  }
+
+  // Bind the statement with text parameters to the unnamed portal and execute it
+  static std::string _bind_and_execute(const std::string& statement_name, const std::vector<std::string>& parameters) {
+    const auto parameter_count = static_cast<uint16_t>(parameters.size());
+    auto bind_body = std::string{"\0", 1} + statement_name + '\0' + _int16(0) + _int16(parameter_count);
+    for (const auto& parameter : parameters) {
+      bind_body += _int32(static_cast<uint32_t>(parameter.size())) + parameter;
+    }
+    bind_body += _int16(0);
+    return _message('B', bind_body) + _message('E', std::string{"\0", 1} + _int32(0));
+  }
+
+  std::string _handle_messages(const std::string& messages) {
+    _stream->append_input(messages.data(), messages.size());
+    while (_stream->unread_input_size() > 0) {
+      _session->handle_request();
+    }
+    return _stream->take_output();
+  }
+
+  // Returns the type and the body of each message
+  static std::vector<std::pair<char, std::string>> _split_messages(const std::string& output) {
+    auto messages = std::vector<std::pair<char, std::string>>{};
+    auto position = size_t{0};
+    while (position < output.size()) {
+      auto network_length = uint32_t{0};
+      std::memcpy(&network_length, output.data() + position + 1, sizeof(network_length));
+      const auto body_length = ntohl(network_length) - sizeof(uint32_t);
+      messages.emplace_back(output[position], output.substr(position + 1 + sizeof(uint32_t), body_length));
+      position += 1 + sizeof(uint32_t) + body_length;
+    }
+    return messages;
+  }
+
+  static std::vector<std::string> _command_complete_messages(const std::string& output) {
+    auto command_complete_messages = std::vector<std::string>{};
+    for (const auto& [type, body] : _split_messages(output)) {
+      if (type == 'C') command_complete_messages.emplace_back(body.c_str());
+    }
+    return command_complete_messages;
+  }
+
+  std::shared_ptr<MessageStream> _stream;
+  std::shared_ptr<Session<MessageStream>> _session;
+  const std::string _sync = _message('S', "");
+  const std::string _flush = _message('H', "");
+};
+
+TEST_F(SessionTest, PipelinedExecutions) {
+  // Nothing is sent before the Sync message. Statements that modify data are executed right away.
+  const auto pipeline = _bind_and_execute("select", {"1234"}) + _bind_and_execute("select", {"123"}) +
+                        _bind_and_execute("insert", {}) + _bind_and_execute("select", {"1234"});
+  EXPECT_TRUE(_handle_messages(pipeline).empty());
+  EXPECT_EQ(Hyrise::get().storage_manager.get_table("table_a")->row_count(), 4u);
+
+  // The SELECT after the INSERT sees the inserted row.
+  const auto output = _handle_messages(_sync);
+  EXPECT_EQ(_command_complete_messages(output),
+            (std::vector<std::string>{"SELECT 1", "SELECT 2", "INSERT 0 1", "SELECT 2"}));
+
+  // The responses are sent in the order of the requests.
+  auto message_types = std::string{};
+  for (const auto& [type, body] : _split_messages(output)) {
+    message_types += type;
+  }
+  EXPECT_EQ(message_types, "2TDC2TDDC2nC2TDDCZ");
+}
+
+TEST_F(SessionTest, ParseAfterCreateTable) {
+  // The table is created before the following statement is parsed.
+  const auto pipeline = _parse("create", "CREATE TABLE table_b (a INT)") + _bind_and_execute("create", {}) +
+                        _parse("select_b", "SELECT * FROM table_b") + _bind_and_execute("select_b", {}) + _sync;
+  const auto output = _handle_messages(pipeline);
+  EXPECT_EQ(_command_complete_messages(output), (std::vector<std::string>{"SELECT 0", "SELECT 0"}));
+  EXPECT_TRUE(Hyrise::get().storage_manager.has_table("table_b"));
+}
+
+TEST_F(SessionTest, Flush) {
+  const auto output = _handle_messages(_bind_and_execute("select", {"123"}) + _flush);
+  EXPECT_EQ(_command_complete_messages(output), std::vector<std::string>{"SELECT 2"});
+  EXPECT_NE(_split_messages(output).back().first, 'Z');
+
+  EXPECT_EQ(_split_messages(_handle_messages(_sync)).back().first, 'Z');
+}
+
+TEST_F(SessionTest, ErrorDropsPendingExecutions) {
+  const auto output = _handle_messages(_bind_and_execute("select", {"123"}) + _bind_and_execute("unknown", {}) +
+                                       _bind_and_execute("select", {"1234"}) + _sync);
+  const auto messages = _split_messages(output);
+
+  // The results of the executions before the error are sent before the error.
+  EXPECT_EQ(_command_complete_messages(output), std::vector<std::string>{"SELECT 2"});
+  ASSERT_GE(messages.size(), 2u);
+  EXPECT_EQ(messages[messages.size() - 2].first, 'E');
+  EXPECT_EQ(messages.back().first, 'Z');
+}
+
+TEST_F(SessionTest, ErrorRollsBackPipeline) {
+  const auto output = _handle_messages(_bind_and_execute("insert", {}) + _bind_and_execute("unknown", {}) + _sync);
+  EXPECT_EQ(_command_complete_messages(output), std::vector<std::string>{"INSERT 0 1"});
+  EXPECT_EQ(_split_messages(output).back().first, 'Z');
+
+  // Like the implicit transaction of PostgreSQL, the transaction of the failed pipeline is rolled back.
+  EXPECT_EQ(_command_complete_messages(_handle_messages(_bind_and_execute("select", {"1234"}) + _sync)),
+            std::vector<std::string>{"SELECT 1"});
+}
+
+TEST_F(SessionTest, SimpleQueryAfterPendingExecution) {
+  // The pending execution is answered before the simple query.
+  const auto query = std::string{"SELECT * FROM table_a"};
+  const auto output = _handle_messages(_bind_and_execute("select", {"123"}) + _message('Q', query + '\0'));
+  EXPECT_EQ(_command_complete_messages(output), (std::vector<std::string>{"SELECT 2", "SELECT 3"}));
+  EXPECT_EQ(_split_messages(output).back().first, 'Z');
+}
+
+}  // namespace opossum
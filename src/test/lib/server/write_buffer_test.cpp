@@ -74,4 +74,17 @@ TEST_F(WriteBufferTest, WriteLargeString) {
   EXPECT_EQ(_mocked_socket->read(), original_content);
 }
 
+TEST_F(WriteBufferTest, WriteBytes) {
+  const auto bytes = std::vector<char>{'a', '\0', 'b'};
+  _write_buffer->put_bytes(bytes.data(), bytes.size());
+  _write_buffer->flush();
+  EXPECT_EQ(_mocked_socket->read(), std::string(bytes.begin(), bytes.end()));
+
+  // More bytes than fit into the buffer
+  const auto large_bytes = std::vector<char>(2 * SERVER_BUFFER_SIZE + 1, 'c');
+  _write_buffer->put_bytes(large_bytes.data(), large_bytes.size());
+  _write_buffer->flush();
+  EXPECT_EQ(_mocked_socket->read(), std::string(bytes.begin(), bytes.end()) + std::string(large_bytes.size(), 'c'));
+}
+
 }  // namespace opossum
@@ -0,0 +1,58 @@
+#include "base_test.hpp"
+
+#include "sql/sql_literal_parameterizer.hpp"
+
+namespace opossum {
+
+class SQLLiteralParameterizerTest : public BaseTest {};
+
+TEST_F(SQLLiteralParameterizerTest, ComparisonOperands) {
+  const auto parameterized_sql =
+      parameterize_sql_literals("SELECT * FROM t WHERE a = 5 AND t.b <> 'x' AND c >= -3.5 ORDER BY a LIMIT 10;");
+  ASSERT_TRUE(parameterized_sql);
+  EXPECT_EQ(parameterized_sql->sql, "SELECT * FROM t WHERE a = ? AND t.b <> ? AND c >= ? ORDER BY a LIMIT 10;");
+  ASSERT_EQ(parameterized_sql->values.size(), 3u);
+  EXPECT_EQ(parameterized_sql->values[0], AllTypeVariant{int32_t{5}});
+  EXPECT_EQ(parameterized_sql->values[1], AllTypeVariant{pmr_string{"x"}});
+  EXPECT_EQ(parameterized_sql->values[2], AllTypeVariant{-3.5});
+}
+
+TEST_F(SQLLiteralParameterizerTest, UpdateAndInsert) {
+  const auto update = parameterize_sql_literals("UPDATE t SET a = 1, b = 'y' WHERE c = 10000000000");
+  ASSERT_TRUE(update);
+  EXPECT_EQ(update->sql, "UPDATE t SET a = ?, b = ? WHERE c = ?");
+  ASSERT_EQ(update->values.size(), 3u);
+  EXPECT_EQ(update->values[2], AllTypeVariant{int64_t{10'000'000'000}});
+
+  // NULL and expressions remain in the statement.
+  const auto insert = parameterize_sql_literals("INSERT INTO t (a, b, c, d) VALUES (1, 'a', NULL, 3 + 4)");
+  ASSERT_TRUE(insert);
+  EXPECT_EQ(insert->sql, "INSERT INTO t (a, b, c, d) VALUES (?, ?, NULL, 3 + 4)");
+  EXPECT_EQ(insert->values, (std::vector<AllTypeVariant>{int32_t{1}, pmr_string{"a"}}));
+}
+
+TEST_F(SQLLiteralParameterizerTest, KeepsOtherLiterals) {
+  // Literals that are not the complete operand of a comparison
+  EXPECT_FALSE(parameterize_sql_literals("SELECT * FROM t WHERE a IN (1, 2) LIMIT 10"));
+  EXPECT_FALSE(parameterize_sql_literals("SELECT * FROM t WHERE a = 5 + b"));
+  EXPECT_FALSE(parameterize_sql_literals("SELECT * FROM t WHERE a BETWEEN 1 AND 5"));
+  EXPECT_FALSE(parameterize_sql_literals("SELECT CASE WHEN a = 1 THEN 2 END FROM t WHERE d < DATE '1995-01-01'"));
+
+  // Literals that are not parameterized to keep the tokenizer simple
+  EXPECT_FALSE(parameterize_sql_literals("SELECT * FROM t WHERE a = 'it''s' AND b = 1e5"));
+
+  const auto parameterized_sql = parameterize_sql_literals("SELECT * FROM t WHERE a = 99999999999999999999 AND b = 1");
+  ASSERT_TRUE(parameterized_sql);
+  EXPECT_EQ(parameterized_sql->sql, "SELECT * FROM t WHERE a = 99999999999999999999 AND b = ?");
+}
+
+TEST_F(SQLLiteralParameterizerTest, UnsupportedStatements) {
+  EXPECT_FALSE(parameterize_sql_literals("SELECT * FROM t WHERE a = ?"));
+  EXPECT_FALSE(parameterize_sql_literals("SELECT * FROM t WHERE a = 5 -- comment"));
+  EXPECT_FALSE(parameterize_sql_literals("SELECT * FROM t WHERE a = 'unterminated"));
+  EXPECT_FALSE(parameterize_sql_literals("CREATE TABLE t (a INT)"));
+  EXPECT_FALSE(parameterize_sql_literals("PREPARE p FROM 'SELECT * FROM t WHERE a = 5'"));
+  EXPECT_FALSE(parameterize_sql_literals(""));
+}
+
+}  // namespace opossum
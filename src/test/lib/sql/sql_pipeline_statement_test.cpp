@@ -630,6 +630,64 @@ TEST_F(SQLPipelineStatementTest, CacheQueryPlan) {
   EXPECT_TRUE(_lqp_cache->has(_select_query_a));
 }
 
+TEST_F(SQLPipelineStatementTest, PipelinedExecutionBypassesPhysicalPlanCache) {
+  const auto sql = std::string{"SELECT * FROM table_a WHERE a > 1000"};
+  auto sql_pipeline = SQLPipelineBuilder{sql}.with_pqp_cache(_pqp_cache).create_pipeline();
+  sql_pipeline.get_result_table();
+  EXPECT_TRUE(_pqp_cache->has(sql));
+
+  // The cached plan contains no PipelinedScan, so it is not used for pipelined execution.
+  auto pipelined_sql_pipeline = SQLPipelineBuilder{sql}
+                                    .with_pqp_cache(_pqp_cache)
+                                    .with_pipelined_execution(UsePipelinedExecution::Yes)
+                                    .create_pipeline();
+  auto statement = get_sql_pipeline_statements(pipelined_sql_pipeline).at(0);
+  const auto [status, table] = statement->get_result_table();
+  EXPECT_EQ(status, SQLPipelineStatus::Success);
+  EXPECT_FALSE(statement->metrics()->query_plan_cache_hit);
+
+  _pqp_cache->clear();
+  auto second_pipelined_sql_pipeline = SQLPipelineBuilder{sql}
+                                           .with_pqp_cache(_pqp_cache)
+                                           .with_pipelined_execution(UsePipelinedExecution::Yes)
+                                           .create_pipeline();
+  second_pipelined_sql_pipeline.get_result_table();
+  EXPECT_FALSE(_pqp_cache->has(sql));
+}
+
+TEST_F(SQLPipelineStatementTest, CacheParameterizedQueryPlan) {
+  const auto execute = [&](const std::string& sql) {
+    auto sql_pipeline = SQLPipelineBuilder{sql}.with_lqp_cache(_lqp_cache).create_pipeline();
+    auto statement = get_sql_pipeline_statements(sql_pipeline).at(0);
+    const auto [status, table] = statement->get_result_table();
+    EXPECT_EQ(status, SQLPipelineStatus::Success);
+    return std::make_pair(table, statement->metrics()->parameterized_plan_cache_hit);
+  };
+
+  const auto [first_table, first_cache_hit] = execute("SELECT * FROM table_a WHERE a = 12345 AND b > 400.5");
+  EXPECT_FALSE(first_cache_hit);
+
+  const auto [second_table, second_cache_hit] = execute("SELECT * FROM table_a WHERE a = 123 AND b > 400");
+  EXPECT_TRUE(second_cache_hit);
+
+  // Both statements share the plan that is cached for the parameterized statement.
+  EXPECT_EQ(_lqp_cache->size(), 1u);
+  EXPECT_TRUE(_lqp_cache->has("SELECT * FROM table_a WHERE a = ? AND b > ?"));
+
+  auto expected_first_result = std::make_shared<Table>(_int_float_column_definitions, TableType::Data);
+  expected_first_result->append({12345, 458.7f});
+  EXPECT_TABLE_EQ_UNORDERED(first_table, expected_first_result);
+
+  auto expected_second_result = std::make_shared<Table>(_int_float_column_definitions, TableType::Data);
+  expected_second_result->append({123, 456.7f});
+  EXPECT_TABLE_EQ_UNORDERED(second_table, expected_second_result);
+
+  // Values are bound to the cached plan before chunks are pruned.
+  const auto [third_table, third_cache_hit] = execute("SELECT * FROM table_a WHERE a = 1 AND b > 400");
+  EXPECT_TRUE(third_cache_hit);
+  EXPECT_EQ(third_table->row_count(), 0u);
+}
+
 TEST_F(SQLPipelineStatementTest, CopySubselectFromCache) {
   const auto subquery_query = "SELECT * FROM table_int WHERE a = (SELECT MAX(b) FROM table_int)";
 
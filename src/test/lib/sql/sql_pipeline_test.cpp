@@ -7,10 +7,14 @@
 #include "SQLParser.h"
 #include "SQLParserResult.h"
 
+#include "expression/expression_utils.hpp"
+#include "expression/pqp_subquery_expression.hpp"
 #include "hyrise.hpp"
 #include "logical_query_plan/join_node.hpp"
 #include "operators/abstract_join_operator.hpp"
+#include "operators/pqp_utils.hpp"
 #include "operators/print.hpp"
+#include "operators/projection.hpp"
 #include "operators/validate.hpp"
 #include "scheduler/job_task.hpp"
 #include "scheduler/node_queue_scheduler.hpp"
@@ -695,4 +699,52 @@ TEST_F(SQLPipelineTest, GetResultTableNoReexecuteOnConflict) {
   EXPECT_EQ(_table_a->row_count(), 5);
 }
 
+TEST_F(SQLPipelineTest, MemoryBudget) {
+  auto sql_pipeline = SQLPipelineBuilder{_join_query}.with_memory_budget(10).create_pipeline();
+  const auto [pipeline_status, table] = sql_pipeline.get_result_table();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+  EXPECT_TABLE_EQ_UNORDERED(table, _join_result);
+
+  const auto& memory_budget_resource = sql_pipeline.get_physical_plans().at(0)->memory_budget_resource();
+  ASSERT_TRUE(memory_budget_resource);
+  EXPECT_EQ(memory_budget_resource->budget(), 10);
+  EXPECT_GT(memory_budget_resource->spilled_bytes(), 0);
+
+  // Without a budget, the operators do not track their memory consumption.
+  auto unbudgeted_sql_pipeline = SQLPipelineBuilder{_join_query}.create_pipeline();
+  EXPECT_FALSE(unbudgeted_sql_pipeline.get_physical_plans().at(0)->memory_budget_resource());
+}
+
+TEST_F(SQLPipelineTest, MemoryBudgetOfCachedPlanAndSubqueries) {
+  const auto sql = std::string{"SELECT a, (SELECT MAX(b) FROM table_b) FROM table_a"};
+  auto sql_pipeline =
+      SQLPipelineBuilder{sql}.with_pqp_cache(_pqp_cache).with_memory_budget(1'000'000).create_pipeline();
+  const auto [pipeline_status, table] = sql_pipeline.get_result_table();
+  EXPECT_EQ(pipeline_status, SQLPipelineStatus::Success);
+
+  // The subquery plans allocate from the budget of the query.
+  const auto& physical_plan = sql_pipeline.get_physical_plans().at(0);
+  const auto& memory_budget_resource = physical_plan->memory_budget_resource();
+  ASSERT_TRUE(memory_budget_resource);
+  auto subquery_count = size_t{0};
+  visit_pqp(physical_plan, [&](const auto& op) {
+    if (const auto projection = std::dynamic_pointer_cast<Projection>(op)) {
+      for (const auto& expression : projection->expressions) {
+        for (const auto& subquery_expression : find_pqp_subquery_expressions(expression)) {
+          EXPECT_EQ(subquery_expression->pqp->memory_budget_resource(), memory_budget_resource);
+          ++subquery_count;
+        }
+      }
+    }
+    return PQPVisitation::VisitInputs;
+  });
+  EXPECT_GT(subquery_count, 0u);
+
+  // The budget is not attached to the cached plan.
+  ASSERT_EQ(_pqp_cache->size(), 1u);
+  const auto cached_plan = _pqp_cache->snapshot().begin()->second.value;
+  EXPECT_NE(cached_plan, physical_plan);
+  EXPECT_FALSE(cached_plan->memory_budget_resource());
+}
+
 }  // namespace opossum
@@ -109,4 +109,22 @@ TEST_F(QueryPlanCacheTest, CachedPQPFrequencyCount) {
   EXPECT_EQ(1, query_frequency(Q1));
 }
 
+TEST_F(QueryPlanCacheTest, UnparameterizableSQLSet) {
+  auto unparameterizable_sql = UnparameterizableSQLSet{2};
+  unparameterizable_sql.insert("SELECT * FROM table_a WHERE a = ?");
+  unparameterizable_sql.insert("SELECT * FROM table_b WHERE a = ?");
+  EXPECT_TRUE(unparameterizable_sql.contains("SELECT * FROM table_a WHERE a = ?"));
+  EXPECT_FALSE(unparameterizable_sql.contains("SELECT * FROM table_a WHERE b = ?"));
+  EXPECT_EQ(unparameterizable_sql.size(), 2u);
+
+  // Exceeding the capacity clears the set.
+  unparameterizable_sql.insert("SELECT * FROM table_a WHERE b = ?");
+  EXPECT_EQ(unparameterizable_sql.size(), 1u);
+  EXPECT_FALSE(unparameterizable_sql.contains("SELECT * FROM table_a WHERE a = ?"));
+  EXPECT_TRUE(unparameterizable_sql.contains("SELECT * FROM table_a WHERE b = ?"));
+
+  unparameterizable_sql.clear();
+  EXPECT_EQ(unparameterizable_sql.size(), 0u);
+}
+
 }  // namespace opossum
@@ -90,6 +90,60 @@ TEST_F(StorageChunkTest, FinalizeSetsMaxBeginCid) {
   EXPECT_EQ(mvcc_data_chunk->max_begin_cid, 3);
 }
 
+TEST_F(StorageChunkTest, FreezeMvccData) {
+  auto mvcc_data = std::make_shared<MvccData>(3, 0);
+  mvcc_data->set_begin_cid(0, 1);
+  mvcc_data->set_begin_cid(1, 2);
+  mvcc_data->set_begin_cid(2, 3);
+  mvcc_data->set_end_cid(1, 4);
+
+  // Committed deletes keep the TID of the deleting transaction.
+  mvcc_data->set_tid(1, TransactionID{6});
+
+  chunk = std::make_shared<Chunk>(Segments({vs_int, vs_str}), mvcc_data);
+  EXPECT_THROW(chunk->try_freeze_mvcc_data(CommitID{4}), std::logic_error);
+  chunk->finalize();
+
+  // Row 1 was invalidated after the visibility threshold.
+  EXPECT_FALSE(chunk->try_freeze_mvcc_data(CommitID{3}));
+  EXPECT_EQ(mvcc_data->get_tid(0), INVALID_TRANSACTION_ID);
+
+  // Row 2 is locked by a transaction.
+  mvcc_data->set_tid(2, TransactionID{7});
+  EXPECT_FALSE(chunk->try_freeze_mvcc_data(CommitID{4}));
+  EXPECT_EQ(mvcc_data->get_tid(0), INVALID_TRANSACTION_ID);
+  EXPECT_EQ(mvcc_data->get_tid(1), TransactionID{6});
+  mvcc_data->set_tid(2, INVALID_TRANSACTION_ID);
+
+  EXPECT_TRUE(chunk->try_freeze_mvcc_data(CommitID{4}));
+  const auto frozen_mvcc_data = chunk->mvcc_data();
+  ASSERT_NE(frozen_mvcc_data, mvcc_data);
+  EXPECT_TRUE(frozen_mvcc_data->is_frozen());
+  EXPECT_FALSE(frozen_mvcc_data->has_changes_since_freeze());
+  EXPECT_EQ(frozen_mvcc_data->max_begin_cid, 3);
+  EXPECT_EQ(frozen_mvcc_data->frozen_invalid_rows(), std::vector<uint64_t>{0b010});
+  EXPECT_EQ(frozen_mvcc_data->get_begin_cid(0), 3);
+  EXPECT_EQ(frozen_mvcc_data->get_end_cid(0), MvccData::MAX_COMMIT_ID);
+  EXPECT_EQ(frozen_mvcc_data->get_end_cid(1), 4);
+  EXPECT_LT(frozen_mvcc_data->visibility_memory_usage(), mvcc_data->visibility_memory_usage());
+  EXPECT_EQ(mvcc_data->get_tid(1), MvccData::FROZEN_TRANSACTION_ID);
+
+  // Transactions that still hold the old MVCC data cannot lock its rows anymore.
+  EXPECT_FALSE(mvcc_data->compare_exchange_tid(0, INVALID_TRANSACTION_ID, TransactionID{8}));
+  EXPECT_FALSE(chunk->try_freeze_mvcc_data(CommitID{4}));
+
+  // Rows that are deleted after freezing are tracked individually.
+  EXPECT_TRUE(frozen_mvcc_data->compare_exchange_tid(2, INVALID_TRANSACTION_ID, TransactionID{8}));
+  EXPECT_TRUE(frozen_mvcc_data->has_changes_since_freeze());
+  EXPECT_FALSE(frozen_mvcc_data->compare_exchange_tid(2, INVALID_TRANSACTION_ID, TransactionID{9}));
+  EXPECT_EQ(frozen_mvcc_data->get_tid(2), TransactionID{8});
+  frozen_mvcc_data->set_end_cid(2, 5);
+  frozen_mvcc_data->set_tid(2, INVALID_TRANSACTION_ID);
+  EXPECT_EQ(frozen_mvcc_data->get_tid(2), INVALID_TRANSACTION_ID);
+  EXPECT_EQ(frozen_mvcc_data->get_end_cid(2), 5);
+  EXPECT_EQ(frozen_mvcc_data->get_end_cid(0), MvccData::MAX_COMMIT_ID);
+}
+
 TEST_F(StorageChunkTest, AddIndexByColumnID) {
   chunk = std::make_shared<Chunk>(Segments({ds_int, ds_str}));
   auto index_int = chunk->create_index<GroupKeyIndex>(std::vector<ColumnID>{ColumnID{0}});
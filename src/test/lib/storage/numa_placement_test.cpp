@@ -0,0 +1,114 @@
+#include <memory>
+#include <thread>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "memory/numa_memory_resource.hpp"
+#include "operators/table_scan.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/numa_placement.hpp"
+#include "storage/reference_segment.hpp"
+#include "storage/table.hpp"
+
+namespace opossum {
+
+class NumaPlacementTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    if (std::thread::hardware_concurrency() < 2) {
+      // The fake NUMA topology has at most as many nodes as the machine has cores.
+      GTEST_SKIP();
+    }
+    Hyrise::get().topology.use_fake_numa_topology(2, 1);
+
+    _table = load_table("resources/test_data/tbl/int_float4.tbl", 1);
+    _expected_table = load_table("resources/test_data/tbl/int_float4.tbl", 1);
+  }
+
+  std::shared_ptr<Table> _table;
+  std::shared_ptr<Table> _expected_table;
+};
+
+TEST_F(NumaPlacementTest, MemoryResources) {
+  const auto& topology = Hyrise::get().topology;
+  ASSERT_EQ(topology.nodes().size(), 2);
+
+  for (auto node_id = NodeID{0}; node_id < 2; ++node_id) {
+    auto* const memory_resource = topology.get_memory_resource(node_id);
+    EXPECT_EQ(memory_resource->node_id(), node_id);
+    EXPECT_TRUE(memory_resource->is_fake_numa());
+    EXPECT_FALSE(memory_resource->allocates_on_node());
+  }
+
+  auto* const memory_resource = topology.get_memory_resource(NodeID{1});
+  auto* const pointer = memory_resource->allocate(100, 8);
+  EXPECT_EQ(memory_resource->allocated_bytes(), 100);
+  memory_resource->deallocate(pointer, 100, 8);
+  EXPECT_EQ(memory_resource->allocated_bytes(), 0);
+
+  EXPECT_THROW(topology.get_memory_resource(NodeID{2}), std::logic_error);
+}
+
+TEST_F(NumaPlacementTest, RoundRobin) {
+  ASSERT_EQ(_table->chunk_count(), 7);
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    EXPECT_EQ(_table->get_chunk(chunk_id)->node_id(), INVALID_NODE_ID);
+  }
+
+  place_chunks_on_numa_nodes(_table, NumaPlacementPolicy::RoundRobin);
+
+  for (auto chunk_id = ChunkID{0}; chunk_id < _table->chunk_count(); ++chunk_id) {
+    EXPECT_EQ(_table->get_chunk(chunk_id)->node_id(), NodeID{chunk_id % 2});
+    EXPECT_EQ(preferred_numa_node_id(*_table, chunk_id), NodeID{chunk_id % 2});
+  }
+  EXPECT_GT(Hyrise::get().topology.get_memory_resource(NodeID{0})->allocated_bytes(), 0);
+  EXPECT_GT(Hyrise::get().topology.get_memory_resource(NodeID{1})->allocated_bytes(), 0);
+  EXPECT_TABLE_EQ_ORDERED(_table, _expected_table);
+}
+
+TEST_F(NumaPlacementTest, Hotness) {
+  // Chunk 3 is accessed much more often than the other chunks. It gets a node of its own.
+  using AccessType = SegmentAccessCounter::AccessType;
+  _table->get_chunk(ChunkID{3})->get_segment(ColumnID{0})->access_counter[AccessType::Sequential] = 100;
+  _table->get_chunk(ChunkID{5})->get_segment(ColumnID{1})->access_counter[AccessType::Random] = 1;
+
+  place_chunks_on_numa_nodes(_table, NumaPlacementPolicy::Hotness);
+
+  EXPECT_EQ(_table->get_chunk(ChunkID{3})->node_id(), NodeID{0});
+  EXPECT_EQ(_table->get_chunk(ChunkID{5})->node_id(), NodeID{1});
+  for (const auto chunk_id : {ChunkID{0}, ChunkID{1}, ChunkID{2}, ChunkID{4}, ChunkID{6}}) {
+    EXPECT_EQ(_table->get_chunk(chunk_id)->node_id(), NodeID{1});
+  }
+  EXPECT_TABLE_EQ_ORDERED(_table, _expected_table);
+}
+
+TEST_F(NumaPlacementTest, SkipsMutableChunks) {
+  const auto table = load_table("resources/test_data/tbl/int_float4.tbl", 4, FinalizeLastChunk::No);
+  ASSERT_EQ(table->chunk_count(), 2);
+
+  place_chunks_on_numa_nodes(table, NumaPlacementPolicy::RoundRobin);
+
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->node_id(), NodeID{0});
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->node_id(), INVALID_NODE_ID);
+}
+
+TEST_F(NumaPlacementTest, PreferredNodeOfReferenceTable) {
+  place_chunks_on_numa_nodes(_table, NumaPlacementPolicy::RoundRobin);
+
+  const auto table_wrapper = std::make_shared<TableWrapper>(_table);
+  table_wrapper->execute();
+  const auto table_scan = create_table_scan(table_wrapper, ColumnID{0}, PredicateCondition::GreaterThan, 0);
+  table_scan->execute();
+
+  // The output of the scan references a single input chunk per output chunk.
+  const auto& output_table = table_scan->get_output();
+  ASSERT_GT(output_table->chunk_count(), 0);
+  for (auto chunk_id = ChunkID{0}; chunk_id < output_table->chunk_count(); ++chunk_id) {
+    const auto segment = output_table->get_chunk(chunk_id)->get_segment(ColumnID{0});
+    const auto referenced_chunk_id = static_cast<const ReferenceSegment&>(*segment).pos_list()->common_chunk_id();
+    EXPECT_EQ(preferred_numa_node_id(*output_table, chunk_id), NodeID{referenced_chunk_id % 2});
+  }
+}
+
+}  // namespace opossum
@@ -0,0 +1,178 @@
+#include <memory>
+#include <utility>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "hyrise.hpp"
+#include "operators/table_wrapper.hpp"
+#include "statistics/attribute_statistics.hpp"
+#include "statistics/statistics_objects/range_filter.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/dictionary_segment.hpp"
+#include "storage/mvcc_data.hpp"
+#include "storage/row_versions.hpp"
+#include "storage/table.hpp"
+#include "storage/value_segment.hpp"
+
+namespace opossum {
+
+class RowVersionsTest : public BaseTest {
+ protected:
+  static std::shared_ptr<RowVersion> committed_version(const CommitID commit_id, const ColumnID column_id,
+                                                       const AllTypeVariant& value) {
+    const auto version = std::make_shared<RowVersion>(
+        INVALID_TRANSACTION_ID, std::vector<std::pair<ColumnID, AllTypeVariant>>{{column_id, value}});
+    version->begin_cid = commit_id;
+    return version;
+  }
+
+  RowVersions row_versions;
+};
+
+TEST_F(RowVersionsTest, AddAndRemoveVersions) {
+  EXPECT_EQ(row_versions.newest_version(ChunkOffset{1}), nullptr);
+
+  const auto first_version = committed_version(CommitID{5}, ColumnID{0}, 1);
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{1}, nullptr, first_version));
+  EXPECT_EQ(row_versions.newest_version(ChunkOffset{1}), first_version);
+
+  // Another version was added in the meantime.
+  const auto second_version = std::make_shared<RowVersion>(
+      TransactionID{7}, std::vector<std::pair<ColumnID, AllTypeVariant>>{{ColumnID{0}, 2}});
+  EXPECT_FALSE(row_versions.add_version(ChunkOffset{1}, nullptr, second_version));
+  EXPECT_FALSE(row_versions.add_version(ChunkOffset{2}, first_version, second_version));
+  EXPECT_EQ(row_versions.row_count(), 1);
+
+  EXPECT_TRUE(row_versions.add_version(ChunkOffset{1}, first_version, second_version));
+  EXPECT_EQ(row_versions.newest_version(ChunkOffset{1}), second_version);
+  EXPECT_EQ(second_version->previous, first_version);
+
+  row_versions.remove_version(ChunkOffset{1}, second_version);
+  EXPECT_EQ(row_versions.newest_version(ChunkOffset{1}), first_version);
+  EXPECT_EQ(row_versions.row_count(), 1);
+}
+
+TEST_F(RowVersionsTest, VisibleVersions) {
+  const auto first_version = committed_version(CommitID{5}, ColumnID{0}, 1);
+  const auto second_version = std::make_shared<RowVersion>(
+      TransactionID{7}, std::vector<std::pair<ColumnID, AllTypeVariant>>{{ColumnID{0}, 2}});
+  const auto other_row_version = committed_version(CommitID{3}, ColumnID{1}, 3.5f);
+  row_versions.add_version(ChunkOffset{1}, nullptr, first_version);
+  row_versions.add_version(ChunkOffset{1}, first_version, second_version);
+  row_versions.add_version(ChunkOffset{0}, nullptr, other_row_version);
+
+  EXPECT_TRUE(row_versions.visible_versions(TransactionID{3}, CommitID{2}).empty());
+
+  auto expected_versions = RowVersions::VersionList{{ChunkOffset{0}, other_row_version}};
+  EXPECT_EQ(row_versions.visible_versions(TransactionID{3}, CommitID{4}), expected_versions);
+
+  expected_versions.emplace_back(ChunkOffset{1}, first_version);
+  EXPECT_EQ(row_versions.visible_versions(TransactionID{3}, CommitID{5}), expected_versions);
+
+  // The updating transaction sees its own version.
+  expected_versions.back().second = second_version;
+  EXPECT_EQ(row_versions.visible_versions(TransactionID{7}, CommitID{5}), expected_versions);
+
+  second_version->begin_cid = CommitID{6};
+  EXPECT_EQ(row_versions.visible_versions(TransactionID{3}, CommitID{6}), expected_versions);
+
+  EXPECT_EQ(RowVersions::changed_column_ids(expected_versions), std::vector<ColumnID>({ColumnID{0}, ColumnID{1}}));
+}
+
+TEST_F(RowVersionsTest, RemoveMergedVersions) {
+  const auto first_version = committed_version(CommitID{5}, ColumnID{0}, 1);
+  const auto second_version = committed_version(CommitID{8}, ColumnID{0}, 2);
+  row_versions.add_version(ChunkOffset{1}, nullptr, first_version);
+  row_versions.add_version(ChunkOffset{1}, first_version, second_version);
+
+  const auto mergeable_versions = row_versions.mergeable_versions(CommitID{6});
+  EXPECT_EQ(mergeable_versions, RowVersions::VersionList({{ChunkOffset{1}, first_version}}));
+  row_versions.mark_merged(mergeable_versions, CommitID{9});
+  EXPECT_TRUE(row_versions.mergeable_versions(CommitID{6}).empty());
+
+  // A transaction with snapshot commit id 9 might have read the segments before the version was merged.
+  row_versions.remove_merged_versions(CommitID{9});
+  EXPECT_EQ(second_version->previous, first_version);
+
+  row_versions.remove_merged_versions(CommitID{10});
+  EXPECT_EQ(second_version->previous, nullptr);
+  EXPECT_EQ(row_versions.newest_version(ChunkOffset{1}), second_version);
+
+  row_versions.mark_merged(row_versions.mergeable_versions(CommitID{8}), CommitID{10});
+  row_versions.remove_merged_versions(std::nullopt);
+  EXPECT_EQ(row_versions.row_count(), 0);
+}
+
+TEST_F(RowVersionsTest, ApplyRowVersions) {
+  const auto segment = std::make_shared<ValueSegment<int32_t>>(pmr_vector<int32_t>{1, 2, 3});
+  const auto versions =
+      RowVersions::VersionList{{ChunkOffset{0}, committed_version(CommitID{1}, ColumnID{1}, 4)},
+                               {ChunkOffset{1}, committed_version(CommitID{1}, ColumnID{0}, 5)},
+                               {ChunkOffset{2}, committed_version(CommitID{1}, ColumnID{0}, NULL_VALUE)},
+                               {ChunkOffset{3}, committed_version(CommitID{1}, ColumnID{0}, 6)}};
+
+  // Only the versions of column 0 that belong to rows of the segment are applied.
+  const auto result =
+      std::dynamic_pointer_cast<ValueSegment<int32_t>>(apply_row_versions(*segment, ColumnID{0}, true, versions));
+  ASSERT_TRUE(result);
+  ASSERT_EQ(result->size(), 3);
+  EXPECT_EQ((*result)[ChunkOffset{0}], AllTypeVariant{1});
+  EXPECT_EQ((*result)[ChunkOffset{1}], AllTypeVariant{5});
+  EXPECT_TRUE(variant_is_null((*result)[ChunkOffset{2}]));
+}
+
+TEST_F(RowVersionsTest, MergeRowVersions) {
+  const auto table = load_table("resources/test_data/tbl/int_float.tbl", 3);
+  ChunkEncoder::encode_all_chunks(table, SegmentEncodingSpec{EncodingType::Dictionary});
+  const auto chunk = table->get_chunk(ChunkID{0});
+  const auto unchanged_segment = chunk->get_segment(ColumnID{0});
+
+  const auto last_commit_id = Hyrise::get().transaction_manager.last_commit_id();
+  const auto row_versions = chunk->mvcc_data()->get_or_create_row_versions();
+  row_versions->add_version(ChunkOffset{1}, nullptr, committed_version(last_commit_id, ColumnID{1}, 1.5f));
+
+  // The version is not visible to this transaction.
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  row_versions->add_version(ChunkOffset{2}, nullptr, committed_version(last_commit_id + 1, ColumnID{1}, 2.5f));
+
+  EXPECT_EQ(merge_row_versions(*table, ChunkID{0}), 1);
+  EXPECT_EQ(chunk->get_segment(ColumnID{0}), unchanged_segment);
+  const auto merged_segment = chunk->get_segment(ColumnID{1});
+  EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<float>>(merged_segment));
+  EXPECT_EQ((*merged_segment)[ChunkOffset{0}], AllTypeVariant{458.7f});
+  EXPECT_EQ((*merged_segment)[ChunkOffset{1}], AllTypeVariant{1.5f});
+  EXPECT_EQ((*merged_segment)[ChunkOffset{2}], AllTypeVariant{457.7f});
+
+  // Nothing is left to merge while the transaction is active. Afterwards, the merged version is removed.
+  EXPECT_EQ(merge_row_versions(*table, ChunkID{0}), 0);
+  EXPECT_EQ(row_versions->row_count(), 2);
+  transaction_context->rollback(RollbackReason::User);
+  Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)->commit();
+  EXPECT_EQ(merge_row_versions(*table, ChunkID{0}), 1);
+  EXPECT_EQ((*chunk->get_segment(ColumnID{1}))[ChunkOffset{2}], AllTypeVariant{2.5f});
+  EXPECT_EQ(row_versions->row_count(), 1);
+
+  // The pruning statistics contain the merged values.
+  const auto& pruning_statistics = chunk->pruning_statistics();
+  ASSERT_TRUE(pruning_statistics);
+  const auto float_statistics = std::dynamic_pointer_cast<AttributeStatistics<float>>(pruning_statistics->at(1));
+  ASSERT_TRUE(float_statistics && float_statistics->range_filter);
+  EXPECT_EQ(float_statistics->range_filter->ranges.front().first, 1.5f);
+
+  // Once all merged versions are removed, the chunk has no versions anymore and GetTable can prune it again.
+  Hyrise::get().default_pqp_cache = std::make_shared<SQLPhysicalPlanCache>();
+  Hyrise::get().default_pqp_cache->set("SELECT * FROM int_float", std::make_shared<TableWrapper>(table));
+  Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)->commit();
+  EXPECT_EQ(merge_row_versions(*table, ChunkID{0}), 0);
+  EXPECT_TRUE(row_versions->is_retired());
+  EXPECT_FALSE(chunk->mvcc_data()->row_versions());
+  EXPECT_EQ(Hyrise::get().default_pqp_cache->size(), 0);
+
+  // Retired versions cannot be used anymore. New versions are created instead.
+  const auto version = committed_version(last_commit_id, ColumnID{1}, 3.5f);
+  EXPECT_FALSE(row_versions->add_version(ChunkOffset{0}, nullptr, version));
+  EXPECT_NE(chunk->mvcc_data()->get_or_create_row_versions(), row_versions);
+}
+
+}  // namespace opossum
@@ -0,0 +1,142 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "concurrency/transaction_context.hpp"
+#include "hyrise.hpp"
+#include "operators/insert.hpp"
+#include "operators/table_wrapper.hpp"
+#include "storage/table.hpp"
+#include "storage/table_key_index.hpp"
+
+namespace opossum {
+
+class TableKeyIndexTest : public BaseTest {
+ protected:
+  void SetUp() override {
+    table = load_table("resources/test_data/tbl/int_int_float.tbl", 2);
+    Hyrise::get().storage_manager.add_table("int_int_float", table);
+
+    table->add_soft_key_constraint({{ColumnID{0}, ColumnID{2}}, KeyConstraintType::PRIMARY_KEY});
+    table->add_soft_key_constraint({{ColumnID{0}}, KeyConstraintType::UNIQUE});
+  }
+
+  void insert(const std::vector<AllTypeVariant>& row, const bool commit = true) {
+    const auto values = std::make_shared<Table>(table->column_definitions(), TableType::Data);
+    values->append(row);
+    const auto table_wrapper = std::make_shared<TableWrapper>(values);
+    table_wrapper->execute();
+
+    const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    const auto insert = std::make_shared<Insert>("int_int_float", table_wrapper);
+    insert->set_transaction_context(transaction_context);
+    insert->execute();
+
+    if (commit) {
+      transaction_context->commit();
+    } else {
+      transaction_context->rollback(RollbackReason::User);
+    }
+  }
+
+  std::shared_ptr<Table> table;
+};
+
+TEST_F(TableKeyIndexTest, Lookup) {
+  table->create_key_index({ColumnID{0}, ColumnID{2}});
+  ASSERT_EQ(table->key_indexes().size(), 1);
+  const auto& key_index = *table->key_indexes()[0];
+
+  EXPECT_EQ(key_index.column_ids(), std::vector<ColumnID>({ColumnID{0}, ColumnID{2}}));
+  EXPECT_EQ(key_index.row_count(), 4);
+  EXPECT_GT(key_index.memory_usage(), 0);
+
+  EXPECT_EQ(key_index.lookup({9, 11.5f}), std::vector<RowID>({RowID{ChunkID{0}, ChunkOffset{0}}}));
+  EXPECT_EQ(key_index.lookup({9, 9.5f}), std::vector<RowID>({RowID{ChunkID{1}, ChunkOffset{1}}}));
+  EXPECT_TRUE(key_index.lookup({9, 10.5f}).empty());
+  EXPECT_TRUE(key_index.lookup({12, 11.5f}).empty());
+}
+
+TEST_F(TableKeyIndexTest, LookupCastsValues) {
+  table->create_key_index({ColumnID{0}, ColumnID{2}});
+  const auto& key_index = *table->key_indexes()[0];
+
+  EXPECT_EQ(key_index.lookup({int64_t{10}, 10.5}), std::vector<RowID>({RowID{ChunkID{0}, ChunkOffset{1}}}));
+
+  // Values that cannot be represented by the column's data type and NULLs do not match any row.
+  EXPECT_TRUE(key_index.lookup({10.1f, 10.5f}).empty());
+  EXPECT_TRUE(key_index.lookup({pmr_string{"10"}, 10.5f}).empty());
+  EXPECT_TRUE(key_index.lookup({NULL_VALUE, 10.5f}).empty());
+
+  EXPECT_THROW(key_index.lookup({10}), std::logic_error);
+}
+
+TEST_F(TableKeyIndexTest, DuplicateKeys) {
+  // Key constraints are not enforced, so the index has to handle duplicates as well.
+  table->create_key_index({ColumnID{0}});
+  const auto& key_index = *table->key_indexes()[0];
+
+  EXPECT_EQ(key_index.lookup({9}),
+            std::vector<RowID>({RowID{ChunkID{0}, ChunkOffset{0}}, RowID{ChunkID{1}, ChunkOffset{1}}}));
+  EXPECT_EQ(key_index.lookup({11}), std::vector<RowID>({RowID{ChunkID{1}, ChunkOffset{0}}}));
+}
+
+TEST_F(TableKeyIndexTest, CreateKeyIndexRequiresConstraint) {
+  EXPECT_THROW(table->create_key_index({ColumnID{1}}), std::logic_error);
+  EXPECT_THROW(table->create_key_index({ColumnID{0}, ColumnID{0}}), std::logic_error);
+
+  // The column order of the index does not need to match the constraint, but an index can only be created once.
+  table->create_key_index({ColumnID{2}, ColumnID{0}});
+  EXPECT_THROW(table->create_key_index({ColumnID{2}, ColumnID{0}}), std::logic_error);
+  EXPECT_EQ(table->key_indexes().size(), 1);
+}
+
+TEST_F(TableKeyIndexTest, InsertMaintainsIndex) {
+  table->create_key_index({ColumnID{0}, ColumnID{2}});
+  const auto& key_index = *table->key_indexes()[0];
+
+  insert({12, 10, 1.5f});
+  insert({13, 10, 2.5f});
+
+  EXPECT_EQ(key_index.row_count(), 6);
+  EXPECT_EQ(key_index.lookup({12, 1.5f}), std::vector<RowID>({RowID{ChunkID{2}, ChunkOffset{0}}}));
+  EXPECT_EQ(key_index.lookup({13, 2.5f}), std::vector<RowID>({RowID{ChunkID{2}, ChunkOffset{1}}}));
+}
+
+TEST_F(TableKeyIndexTest, RemovesInvisibleRows) {
+  table->create_key_index({ColumnID{0}, ColumnID{2}});
+  const auto& key_index = *table->key_indexes()[0];
+
+  // Uncommitted and rolled back rows are returned by lookups, the Validate operator filters them out.
+  insert({12, 10, 1.5f}, false);
+  EXPECT_EQ(key_index.row_count(), 5);
+  EXPECT_EQ(key_index.lookup({12, 1.5f}), std::vector<RowID>({RowID{ChunkID{2}, ChunkOffset{0}}}));
+
+  // Adding the key again removes the rolled back row from the index, as no transaction can see it.
+  insert({12, 10, 1.5f});
+  EXPECT_EQ(key_index.row_count(), 5);
+  EXPECT_EQ(key_index.lookup({12, 1.5f}), std::vector<RowID>({RowID{ChunkID{2}, ChunkOffset{1}}}));
+}
+
+TEST_F(TableKeyIndexTest, NullsAreNotIndexed) {
+  const auto nullable_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, true}},
+                                                      TableType::Data, 2, UseMvcc::Yes);
+  nullable_table->append({1});
+  nullable_table->append({NULL_VALUE});
+  nullable_table->add_soft_key_constraint({{ColumnID{0}}, KeyConstraintType::UNIQUE});
+  nullable_table->create_key_index({ColumnID{0}});
+
+  const auto& key_index = *nullable_table->key_indexes()[0];
+  EXPECT_EQ(key_index.row_count(), 1);
+  EXPECT_EQ(key_index.lookup({1}), std::vector<RowID>({RowID{ChunkID{0}, ChunkOffset{0}}}));
+}
+
+TEST_F(TableKeyIndexTest, MemoryUsage) {
+  const auto memory_usage = table->memory_usage(MemoryUsageCalculationMode::Sampled);
+  table->create_key_index({ColumnID{0}, ColumnID{2}});
+  EXPECT_EQ(table->memory_usage(MemoryUsageCalculationMode::Sampled),
+            memory_usage + table->key_indexes()[0]->memory_usage());
+}
+
+}  // namespace opossum
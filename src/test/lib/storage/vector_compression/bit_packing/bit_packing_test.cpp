@@ -0,0 +1,141 @@
+#include <memory>
+#include <vector>
+
+#include "base_test.hpp"
+
+#include "storage/vector_compression/bit_packing/bit_packing_compressor.hpp"
+#include "storage/vector_compression/bit_packing/bit_packing_vector.hpp"
+#include "storage/vector_compression/vector_compression.hpp"
+#include "types.hpp"
+
+namespace opossum {
+
+class BitPackingTest : public BaseTest, public ::testing::WithParamInterface<uint8_t> {
+ protected:
+  void SetUp() override {
+    _bit_size = GetParam();
+    _min = static_cast<uint32_t>(1ul << (_bit_size - 1u));
+    _max = static_cast<uint32_t>((1ul << _bit_size) - 1u);
+  }
+
+  pmr_vector<uint32_t> generate_sequence(const size_t count) {
+    auto sequence = pmr_vector<uint32_t>(count);
+    auto value = _min;
+    for (auto& elem : sequence) {
+      elem = value;
+
+      value += 1u;
+      if (value > _max) value = _min;
+    }
+
+    return sequence;
+  }
+
+  std::unique_ptr<const BaseCompressedVector> compress(const pmr_vector<uint32_t>& vector) {
+    auto compressor = BitPackingCompressor{};
+    auto compressed_vector = compressor.compress(vector, vector.get_allocator());
+    EXPECT_EQ(compressed_vector->size(), vector.size());
+
+    return compressed_vector;
+  }
+
+  uint8_t _bit_size;
+  uint32_t _min;
+  uint32_t _max;
+};
+
+auto bit_packing_test_formatter = [](const ::testing::TestParamInfo<uint8_t> info) {
+  return std::to_string(static_cast<uint32_t>(info.param));
+};
+
+INSTANTIATE_TEST_SUITE_P(BitSizes, BitPackingTest, ::testing::Range(uint8_t{1}, uint8_t{33}),
+                         bit_packing_test_formatter);
+
+TEST_P(BitPackingTest, UsesMinimalBitWidth) {
+  const auto sequence = generate_sequence(420);
+  const auto compressed_sequence_base = compress(sequence);
+  const auto* compressed_sequence = dynamic_cast<const BitPackingVector*>(compressed_sequence_base.get());
+  ASSERT_NE(compressed_sequence, nullptr);
+
+  EXPECT_EQ(compressed_sequence->bit_width(), _bit_size);
+  // 420 values occupy two blocks of 256 values each
+  EXPECT_EQ(compressed_sequence->data_size(), 2 * BitPackingDecompressor::BLOCK_SIZE * _bit_size / 8);
+}
+
+TEST_P(BitPackingTest, DecompressSequenceUsingIterators) {
+  const auto sequence = generate_sequence(420);
+  const auto compressed_sequence_base = compress(sequence);
+  const auto* compressed_sequence = dynamic_cast<const BitPackingVector*>(compressed_sequence_base.get());
+  ASSERT_NE(compressed_sequence, nullptr);
+
+  auto seq_it = sequence.cbegin();
+  auto compressed_seq_it = compressed_sequence->cbegin();
+  const auto compressed_seq_end = compressed_sequence->cend();
+  for (; compressed_seq_it != compressed_seq_end; seq_it++, compressed_seq_it++) {
+    EXPECT_EQ(*seq_it, *compressed_seq_it);
+  }
+  EXPECT_EQ(seq_it, sequence.cend());
+
+  // Random access across block bounds
+  compressed_seq_it = compressed_sequence->cbegin() + 300;
+  EXPECT_EQ(*compressed_seq_it, sequence[300]);
+  compressed_seq_it -= 299;
+  EXPECT_EQ(*compressed_seq_it, sequence[1]);
+}
+
+TEST_P(BitPackingTest, DecompressSequenceUsingDecompressor) {
+  const auto sequence = generate_sequence(420);
+  const auto compressed_sequence = compress(sequence);
+
+  auto decompressor = compressed_sequence->create_base_decompressor();
+  ASSERT_EQ(decompressor->size(), sequence.size());
+
+  // Access the values backwards, as the decompressor does not depend on the access order.
+  for (auto index = sequence.size(); index > 0; --index) {
+    EXPECT_EQ(sequence[index - 1], decompressor->get(index - 1));
+  }
+}
+
+TEST_P(BitPackingTest, CompressEmptySequence) {
+  const auto sequence = generate_sequence(0);
+  const auto compressed_sequence_base = compress(sequence);
+
+  ASSERT_EQ(compressed_sequence_base->size(), 0u);
+  ASSERT_EQ(compressed_sequence_base->data_size(), 0u);
+
+  const auto* compressed_sequence = dynamic_cast<const BitPackingVector*>(compressed_sequence_base.get());
+  ASSERT_NE(compressed_sequence, nullptr);
+
+  auto decompressor = compressed_sequence->create_base_decompressor();
+  ASSERT_EQ(decompressor->size(), 0u);
+
+  auto bitmap = std::vector<uint64_t>{};
+  compressed_sequence->match_range(0, _max, bitmap);
+  EXPECT_TRUE(bitmap.empty());
+}
+
+TEST_P(BitPackingTest, MatchRange) {
+  const auto sequence = generate_sequence(1'000);
+  const auto compressed_sequence_base = compress(sequence);
+  const auto* compressed_sequence = dynamic_cast<const BitPackingVector*>(compressed_sequence_base.get());
+  ASSERT_NE(compressed_sequence, nullptr);
+
+  const auto ranges = std::vector<std::pair<uint32_t, uint32_t>>{
+      {0, 0}, {0, _min}, {_min, _min + 1}, {_min, _max}, {_max, _max + 1}, {0, _max + 1}, {_min + 5, _min + 17}};
+
+  auto bitmap = std::vector<uint64_t>{};
+  for (const auto& [begin, end] : ranges) {
+    // Ranges beyond the largest 32-bit value cannot be expressed.
+    if (end < begin) continue;
+
+    compressed_sequence->match_range(begin, end, bitmap);
+    ASSERT_EQ(bitmap.size(), 16u);
+
+    for (auto index = size_t{0}; index < bitmap.size() * 64; ++index) {
+      const auto expected = index < sequence.size() && sequence[index] >= begin && sequence[index] < end;
+      EXPECT_EQ((bitmap[index / 64] >> (index % 64)) & 1, expected ? 1u : 0u) << "index " << index;
+    }
+  }
+}
+
+}  // namespace opossum
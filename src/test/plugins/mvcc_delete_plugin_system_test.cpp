@@ -8,10 +8,10 @@
 #include "../../plugins/mvcc_delete_plugin.hpp"
 #include "expression/expression_functional.hpp"
 #include "operators/aggregate_hash.hpp"
+#include "operators/delete.hpp"
 #include "operators/get_table.hpp"
 #include "operators/insert.hpp"
 #include "operators/table_scan.hpp"
-#include "operators/update.hpp"
 #include "operators/validate.hpp"
 #include "storage/chunk.hpp"
 #include "storage/table.hpp"
@@ -58,8 +58,8 @@ class MvccDeletePluginSystemTest : public BaseTest {
 
  protected:
   /**
-   * Updates a single row to make it invalid in its chunk. Data modification is not involved, so the row gets reinserted
-   * at the end of the table.
+   * Deletes and re-inserts a single row to make it invalid in its chunk. Data modification is not involved, so the row
+   * gets reinserted at the end of the table.
    * - Updates start at position 220 (INITIAL_UPDATE_OFFSET), so the first chunk stays untouched.
    * - Updates stop just before the end of Chunk 3 (at position 598), so that it is "fresh" and not cleaned up.
    */
@@ -80,18 +80,23 @@ class MvccDeletePluginSystemTest : public BaseTest {
     const auto where = std::make_shared<TableScan>(validate, expr);
     where->set_transaction_context(transaction_context);
 
-    const auto update = std::make_shared<Update>(_t_name_test, where, where);
-    update->set_transaction_context(transaction_context);
+    // The Update operator would not write the row, as its values do not change. Thus, delete and re-insert it.
+    const auto delete_op = std::make_shared<Delete>(where);
+    delete_op->set_transaction_context(transaction_context);
 
     gt->execute();
     validate->execute();
     where->execute();
-    update->execute();
+    delete_op->execute();
 
-    if (update->execute_failed()) {
+    if (delete_op->execute_failed()) {
       // Collided with the plugin rewriting a chunk
       transaction_context->rollback(RollbackReason::Conflict);
     } else {
+      const auto insert = std::make_shared<Insert>(_t_name_test, where);
+      insert->set_transaction_context(transaction_context);
+      insert->execute();
+
       transaction_context->commit();
       _counter++;
     }
@@ -10,11 +10,14 @@
 #include "concurrency/transaction_manager.hpp"
 #include "expression/expression_functional.hpp"
 #include "expression/pqp_column_expression.hpp"
+#include "operators/delete.hpp"
 #include "operators/get_table.hpp"
+#include "operators/insert.hpp"
 #include "operators/projection.hpp"
 #include "operators/table_scan.hpp"
-#include "operators/update.hpp"
 #include "operators/validate.hpp"
+#include "storage/chunk_encoder.hpp"
+#include "storage/dictionary_segment.hpp"
 #include "storage/storage_manager.hpp"
 #include "storage/table.hpp"
 #include "utils/load_table.hpp"
@@ -47,13 +50,16 @@ class MvccDeletePluginTest : public BaseTest {
     validate_table->never_clear_output();
     validate_table->execute();
 
-    // Update
+    // Delete and re-insert the rows. The Update operator would update them in place instead of invalidating them.
     auto update_expressions = expression_vector(add_(_column_a, 1));
     auto updated_values_projection = std::make_shared<Projection>(validate_table, update_expressions);
     updated_values_projection->execute();
-    auto update_table = std::make_shared<Update>(_table_name, validate_table, updated_values_projection);
-    update_table->set_transaction_context(transaction_context);
-    update_table->execute();
+    auto delete_table = std::make_shared<Delete>(validate_table);
+    delete_table->set_transaction_context(transaction_context);
+    delete_table->execute();
+    auto insert_table = std::make_shared<Insert>(_table_name, updated_values_projection);
+    insert_table->set_transaction_context(transaction_context);
+    insert_table->execute();
 
     transaction_context->commit();
   }
@@ -65,6 +71,17 @@ class MvccDeletePluginTest : public BaseTest {
                                   std::shared_ptr<TransactionContext> transaction_context) {
     return MvccDeletePlugin::_try_logical_delete(table_name, chunk_id, transaction_context);
   }
+  static bool _try_logical_delete(const std::string& table_name, const std::vector<ChunkID>& chunk_ids) {
+    auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+    return MvccDeletePlugin::_try_logical_delete(table_name, chunk_ids, transaction_context);
+  }
+  static std::vector<std::vector<ChunkID>> _select_compaction_groups(const Table& table) {
+    return MvccDeletePlugin::_select_compaction_groups(table);
+  }
+  static size_t _freeze_mvcc_data(Table& table) { return MvccDeletePlugin::_freeze_mvcc_data(table); }
+  static std::chrono::milliseconds _logical_delete_delay(const double invalidated_rows_ratio, const bool compacted) {
+    return MvccDeletePlugin::_logical_delete_delay(invalidated_rows_ratio, compacted);
+  }
   static void _delete_chunk_physically(const std::string& table_name, ChunkID chunk_id) {
     MvccDeletePlugin::_delete_chunk_physically(Hyrise::get().storage_manager.get_table(table_name), chunk_id);
   }
@@ -209,4 +226,163 @@ TEST_F(MvccDeletePluginTest, PhysicalDelete) {
   EXPECT_TRUE(table->get_chunk(chunk_to_delete_id) == nullptr);
 }
 
+/**
+ * This test checks that several partially invalidated chunks are compacted together. Their visible rows are moved to
+ * the end of the table, and the chunk that the rows fill up is encoded like the chunks they came from.
+ */
+TEST_F(MvccDeletePluginTest, CompactPartiallyInvalidatedChunks) {
+  const auto table_name = std::string{"compactionTestTable"};
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                             ChunkOffset{4}, UseMvcc::Yes);
+  for (auto value = int32_t{0}; value < 12; ++value) {
+    table->append({value});
+  }
+  ChunkEncoder::encode_chunks(table, {ChunkID{0}, ChunkID{1}}, SegmentEncodingSpec{EncodingType::Dictionary});
+  Hyrise::get().storage_manager.add_table(table_name, table);
+
+  // --- Expected: 0, 1, _, _ | _, _, 6, 7 | 8, 9, 10, 11
+  auto pipeline = SQLPipelineBuilder{"DELETE FROM " + table_name + " WHERE a = 2 OR a = 3 OR a = 4 OR a = 5"}
+                      .create_pipeline();
+  EXPECT_EQ(pipeline.get_result_table().first, SQLPipelineStatus::Success);
+
+  // Recently invalidated chunks are not compacted yet
+  EXPECT_TRUE(_select_compaction_groups(*table).empty());
+  for (auto commit_index = CommitID{0}; commit_index < MvccDeletePlugin::DELETE_THRESHOLD_LAST_COMMIT; ++commit_index) {
+    Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)->commit();
+  }
+
+  // The visible rows of the first two chunks fit into one chunk. The last chunk is still used for insertions.
+  const auto groups = _select_compaction_groups(*table);
+  ASSERT_EQ(groups.size(), 1);
+  EXPECT_EQ(groups[0], std::vector<ChunkID>({ChunkID{0}, ChunkID{1}}));
+
+  EXPECT_TRUE(_try_logical_delete(table_name, groups[0]));
+  EXPECT_TRUE(table->get_chunk(ChunkID{0})->get_cleanup_commit_id());
+  EXPECT_TRUE(table->get_chunk(ChunkID{1})->get_cleanup_commit_id());
+
+  // --- Expected: _, _, _, _ | _, _, _, _ | 8, 9, 10, 11 | 0, 1, 6, 7
+  ASSERT_EQ(table->chunk_count(), 4);
+  EXPECT_EQ(table->get_chunk(ChunkID{3})->size(), 4);
+  EXPECT_EQ(_get_int_value_from_table(table, ChunkID{3}, ColumnID{0}, ChunkOffset{2}), 6);
+
+  // The full chunk before the new last chunk was finalized and encoded
+  const auto encoded_chunk = table->get_chunk(ChunkID{2});
+  EXPECT_FALSE(encoded_chunk->is_mutable());
+  EXPECT_TRUE(std::dynamic_pointer_cast<const DictionarySegment<int32_t>>(encoded_chunk->get_segment(ColumnID{0})));
+
+  // Chunks that only need to be moved by themselves have to be mostly invalidated
+  EXPECT_TRUE(_select_compaction_groups(*table).empty());
+
+  auto verification_pipeline = SQLPipelineBuilder{"SELECT * FROM " + table_name}.create_pipeline();
+  EXPECT_EQ(verification_pipeline.get_result_table().second->row_count(), 8);
+}
+
+/**
+ * Once the rows of immutable chunks have not been modified for a while, their MVCC data is frozen. Rows can still be
+ * deleted afterwards.
+ */
+TEST_F(MvccDeletePluginTest, FreezeMvccData) {
+  const auto table_name = std::string{"freezeTestTable"};
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                             ChunkOffset{4}, UseMvcc::Yes);
+  for (auto value = int32_t{0}; value < 12; ++value) {
+    table->append({value});
+  }
+  Hyrise::get().storage_manager.add_table(table_name, table);
+
+  auto pipeline = SQLPipelineBuilder{"DELETE FROM " + table_name + " WHERE a = 2"}.create_pipeline();
+  EXPECT_EQ(pipeline.get_result_table().first, SQLPipelineStatus::Success);
+
+  // Recently modified chunks are not frozen yet
+  EXPECT_EQ(_freeze_mvcc_data(*table), 0);
+  for (auto commit_index = CommitID{0}; commit_index < MvccDeletePlugin::DELETE_THRESHOLD_LAST_COMMIT; ++commit_index) {
+    Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)->commit();
+  }
+
+  // The last chunk is still mutable
+  EXPECT_EQ(_freeze_mvcc_data(*table), 2);
+  EXPECT_EQ(_freeze_mvcc_data(*table), 0);
+  const auto frozen_mvcc_data = table->get_chunk(ChunkID{0})->mvcc_data();
+  EXPECT_TRUE(frozen_mvcc_data->is_frozen());
+  EXPECT_EQ(frozen_mvcc_data->frozen_invalid_rows(), std::vector<uint64_t>{0b0100});
+  EXPECT_TRUE(table->get_chunk(ChunkID{1})->mvcc_data()->frozen_invalid_rows().empty());
+  EXPECT_FALSE(table->get_chunk(ChunkID{2})->mvcc_data()->is_frozen());
+
+  auto delete_pipeline = SQLPipelineBuilder{"DELETE FROM " + table_name + " WHERE a = 1 OR a = 5"}.create_pipeline();
+  EXPECT_EQ(delete_pipeline.get_result_table().first, SQLPipelineStatus::Success);
+  EXPECT_TRUE(frozen_mvcc_data->has_changes_since_freeze());
+
+  auto verification_pipeline = SQLPipelineBuilder{"SELECT * FROM " + table_name + " WHERE a < 8"}.create_pipeline();
+  const auto expected_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}},
+                                                      TableType::Data);
+  for (const auto value : {0, 3, 4, 6, 7}) {
+    expected_table->append({value});
+  }
+  EXPECT_TABLE_EQ_UNORDERED(verification_pipeline.get_result_table().second, expected_table);
+}
+
+TEST_F(MvccDeletePluginTest, FreezeMvccDataWithPendingDelete) {
+  const auto table_name = std::string{"freezeTestTable"};
+  const auto table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}}, TableType::Data,
+                                             ChunkOffset{4}, UseMvcc::Yes);
+  for (auto value = int32_t{0}; value < 12; ++value) {
+    table->append({value});
+  }
+  Hyrise::get().storage_manager.add_table(table_name, table);
+
+  // Committed deletes keep the TID of the deleting transaction.
+  auto pipeline = SQLPipelineBuilder{"DELETE FROM " + table_name + " WHERE a = 1"}.create_pipeline();
+  EXPECT_EQ(pipeline.get_result_table().first, SQLPipelineStatus::Success);
+  const auto deleting_tid = table->get_chunk(ChunkID{0})->mvcc_data()->get_tid(1);
+  EXPECT_NE(deleting_tid, INVALID_TRANSACTION_ID);
+
+  const auto transaction_context = Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No);
+  auto pending_pipeline = SQLPipelineBuilder{"DELETE FROM " + table_name + " WHERE a = 6"}
+                              .with_transaction_context(transaction_context)
+                              .create_pipeline();
+  EXPECT_EQ(pending_pipeline.get_result_table().first, SQLPipelineStatus::Success);
+
+  for (auto commit_index = CommitID{0}; commit_index < MvccDeletePlugin::DELETE_THRESHOLD_LAST_COMMIT; ++commit_index) {
+    Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)->commit();
+  }
+
+  // The second chunk has a row that is locked by an active transaction. Its lock is kept.
+  const auto first_mvcc_data = table->get_chunk(ChunkID{0})->mvcc_data();
+  const auto second_mvcc_data = table->get_chunk(ChunkID{1})->mvcc_data();
+  EXPECT_EQ(_freeze_mvcc_data(*table), 1);
+  EXPECT_EQ(first_mvcc_data->get_tid(1), MvccData::FROZEN_TRANSACTION_ID);
+  EXPECT_EQ(table->get_chunk(ChunkID{0})->mvcc_data()->frozen_invalid_rows(), std::vector<uint64_t>{0b0010});
+  EXPECT_FALSE(table->get_chunk(ChunkID{1})->mvcc_data()->is_frozen());
+  EXPECT_EQ(second_mvcc_data->get_tid(0), INVALID_TRANSACTION_ID);
+  EXPECT_EQ(second_mvcc_data->get_tid(2), transaction_context->transaction_id());
+
+  transaction_context->commit();
+  for (auto commit_index = CommitID{0}; commit_index < MvccDeletePlugin::DELETE_THRESHOLD_LAST_COMMIT; ++commit_index) {
+    Hyrise::get().transaction_manager.new_transaction_context(AutoCommit::No)->commit();
+  }
+
+  EXPECT_EQ(_freeze_mvcc_data(*table), 1);
+  EXPECT_EQ(table->get_chunk(ChunkID{1})->mvcc_data()->frozen_invalid_rows(), std::vector<uint64_t>{0b0100});
+
+  auto verification_pipeline = SQLPipelineBuilder{"SELECT * FROM " + table_name + " WHERE a < 8"}.create_pipeline();
+  const auto expected_table = std::make_shared<Table>(TableColumnDefinitions{{"a", DataType::Int, false}},
+                                                      TableType::Data);
+  for (const auto value : {0, 2, 3, 4, 5, 7}) {
+    expected_table->append({value});
+  }
+  EXPECT_TABLE_EQ_UNORDERED(verification_pipeline.get_result_table().second, expected_table);
+}
+
+TEST_F(MvccDeletePluginTest, LogicalDeleteDelay) {
+  EXPECT_EQ(_logical_delete_delay(0.0, false), MvccDeletePlugin::IDLE_DELAY_LOGICAL_DELETE);
+  EXPECT_EQ(_logical_delete_delay(0.0, true), MvccDeletePlugin::MIN_IDLE_DELAY_LOGICAL_DELETE);
+  EXPECT_EQ(_logical_delete_delay(MvccDeletePlugin::COMPACTION_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS, false),
+            MvccDeletePlugin::MIN_IDLE_DELAY_LOGICAL_DELETE);
+
+  const auto half_threshold = MvccDeletePlugin::COMPACTION_THRESHOLD_PERCENTAGE_INVALIDATED_ROWS / 2;
+  const auto delay = _logical_delete_delay(half_threshold, false);
+  EXPECT_GT(delay, MvccDeletePlugin::MIN_IDLE_DELAY_LOGICAL_DELETE);
+  EXPECT_LT(delay, MvccDeletePlugin::IDLE_DELAY_LOGICAL_DELETE);
+}
+
 }  // namespace opossum